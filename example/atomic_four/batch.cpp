@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin atomic_four_batch.cpp}
+
+Atomic Functions With Batch Callbacks: Example and Test
+#######################################################
+
+Function
+********
+This example demonstrates using :ref:`atomic_four_batch-name`
+for the logistic function
+:math:`g : \B{R} \rightarrow \B{R}` defined by
+
+.. math::
+
+   g(x) = \frac{1}{ 1 + \exp( - x ) }
+
+Its derivative is :math:`g^{(1)} (x) = g(x) [ 1 - g(x) ]` .
+
+f(x)
+****
+The function :math:`f : \B{R}^n \rightarrow \B{R}^n` is defined by
+:math:`f_j (x) = g[ g( x_j ) ]` .
+There are :math:`2 n` uses of the atomic function in the recording of
+:math:`f` and they form two levels; i.e.,
+the :math:`g( x_j )` and the :math:`g[ g( x_j ) ]` .
+Thus zero order forward mode, and first order reverse mode,
+each evaluate two batches of :math:`n` uses.
+
+Define Atomic Function
+**********************
+{xrst_literal
+   // BEGIN_DEFINE_ATOMIC_FUNCTION
+   // END_DEFINE_ATOMIC_FUNCTION
+}
+
+Use Atomic Function
+*******************
+{xrst_literal
+   // BEGIN_USE_ATOMIC_FUNCTION
+   // END_USE_ATOMIC_FUNCTION
+}
+
+{xrst_end atomic_four_batch.cpp}
+*/
+# include <cppad/cppad.hpp>
+
+// BEGIN_DEFINE_ATOMIC_FUNCTION
+// empty namespace
+namespace {
+   class atomic_logistic : public CppAD::atomic_four<double> {
+   public:
+      // number of batches, and number of uses, for each batch callback
+      size_t n_forward_batch, n_forward_use;
+      size_t n_reverse_batch, n_reverse_use;
+      //
+      atomic_logistic(const std::string& name) :
+      CppAD::atomic_four<double>(name)
+      {  n_forward_batch = 0;
+         n_forward_use   = 0;
+         n_reverse_batch = 0;
+         n_reverse_use   = 0;
+      }
+   private:
+      // g(x)
+      static double g(double x)
+      {  return 1.0 / ( 1.0 + std::exp(-x) ); }
+      //
+      // for_type
+      bool for_type(
+         size_t                                     call_id     ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+      {  assert( call_id == 0 );
+         assert( type_x.size() == 1 );
+         assert( type_y.size() == 1 );
+         type_y[0] = type_x[0];
+         return true;
+      }
+      //
+      // forward
+      bool forward(
+         size_t                             call_id     ,
+         const CppAD::vector<bool>&         select_y    ,
+         size_t                             order_low   ,
+         size_t                             order_up    ,
+         const CppAD::vector<double>&       tx          ,
+         CppAD::vector<double>&             ty          ) override
+      {  assert( call_id == 0 );
+         bool ok = order_up <= 1;
+         if( ! ok )
+            return ok;
+         double y = g( tx[0] );
+         if( order_low <= 0 )
+            ty[0] = y;
+         if( order_up >= 1 )
+            ty[1] = y * (1.0 - y) * tx[1];
+         return ok;
+      }
+      //
+      // reverse
+      bool reverse(
+         size_t                              call_id     ,
+         const CppAD::vector<bool>&          select_x    ,
+         size_t                              order_up    ,
+         const CppAD::vector<double>&        tx          ,
+         const CppAD::vector<double>&        ty          ,
+         CppAD::vector<double>&              px          ,
+         const CppAD::vector<double>&        py          ) override
+      {  assert( call_id == 0 );
+         bool ok = order_up == 0;
+         if( ! ok )
+            return ok;
+         px[0] = ty[0] * (1.0 - ty[0]) * py[0];
+         return ok;
+      }
+      //
+      bool forward_batch(
+         size_t                       call_id     ,
+         size_t                       n_call      ,
+         const CppAD::vector<bool>&   select_y    ,
+         size_t                       order_low   ,
+         size_t                       order_up    ,
+         const CppAD::vector<double>& taylor_x    ,
+         CppAD::vector<double>&       taylor_y    ) override
+      {  assert( call_id == 0 );
+         assert( order_low == 0 && order_up == 0 );
+         if( n_call == 0 )
+            return true;
+         ++n_forward_batch;
+         n_forward_use += n_call;
+         //
+         // n = m = 1 and q = 1 so there is one value per use
+         for(size_t k = 0; k < n_call; ++k)
+            taylor_y[k] = g( taylor_x[k] );
+         return true;
+      }
+      bool reverse_batch(
+         size_t                       call_id     ,
+         size_t                       n_call      ,
+         const CppAD::vector<bool>&   select_x    ,
+         size_t                       order_up    ,
+         const CppAD::vector<double>& taylor_x    ,
+         const CppAD::vector<double>& taylor_y    ,
+         CppAD::vector<double>&       partial_x   ,
+         const CppAD::vector<double>& partial_y   ) override
+      {  assert( call_id == 0 );
+         if( n_call == 0 )
+            return true;
+         if( order_up != 0 )
+            return false;
+         ++n_reverse_batch;
+         n_reverse_use += n_call;
+         //
+         for(size_t k = 0; k < n_call; ++k)
+         {  double y  = taylor_y[k];
+            partial_x[k] = y * (1.0 - y) * partial_y[k];
+         }
+         return true;
+      }
+   };
+}
+// END_DEFINE_ATOMIC_FUNCTION
+
+// BEGIN_USE_ATOMIC_FUNCTION
+bool batch(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // afun
+   atomic_logistic afun("atomic_logistic");
+   //
+   // n
+   size_t n = 10;
+   //
+   // ax
+   CPPAD_TESTVECTOR( CppAD::AD<double> ) ax(n), ay(n), au(1), av(1);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = 0.0;
+   CppAD::Independent(ax);
+   //
+   // ay
+   for(size_t j = 0; j < n; ++j)
+   {  au[0] = ax[j];
+      afun(au, av);
+      afun(av, au);
+      ay[j] = au[0];
+   }
+   //
+   // f
+   // (this constructor uses zero order forward mode)
+   CppAD::ADFun<double> f(ax, ay);
+   ok &= afun.n_forward_batch == 2;
+   afun.n_forward_batch = 0;
+   afun.n_forward_use   = 0;
+   //
+   // x, y
+   CPPAD_TESTVECTOR(double) x(n), y(n);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j) - double(n) / 2.0;
+   y = f.Forward(0, x);
+   //
+   // ok
+   // zero order forward used two batches, each with n uses
+   ok &= afun.n_forward_batch == 2;
+   ok &= afun.n_forward_use   == 2 * n;
+   for(size_t j = 0; j < n; ++j)
+   {  double g_x   = 1.0 / ( 1.0 + std::exp( - x[j] ) );
+      double check = 1.0 / ( 1.0 + std::exp( - g_x ) );
+      ok &= CppAD::NearEqual(y[j], check, eps, eps);
+   }
+   //
+   // dw
+   CPPAD_TESTVECTOR(double) w(n), dw(n);
+   for(size_t i = 0; i < n; ++i)
+      w[i] = 1.0;
+   dw = f.Reverse(1, w);
+   //
+   // ok
+   // first order reverse used two batches, each with n uses
+   ok &= afun.n_reverse_batch == 2;
+   ok &= afun.n_reverse_use   == 2 * n;
+   for(size_t j = 0; j < n; ++j)
+   {  double g_x   = 1.0 / ( 1.0 + std::exp( - x[j] ) );
+      double g_g_x = 1.0 / ( 1.0 + std::exp( - g_x ) );
+      double check = g_g_x * (1.0 - g_g_x) * g_x * (1.0 - g_x);
+      ok &= CppAD::NearEqual(dw[j], check, eps, eps);
+   }
+   //
+   // ok
+   // first order forward does not use the batch callbacks
+   CPPAD_TESTVECTOR(double) dx(n), dy(n);
+   for(size_t j = 0; j < n; ++j)
+      dx[j] = 1.0;
+   dy  = f.Forward(1, dx);
+   ok &= afun.n_forward_batch == 2;
+   for(size_t j = 0; j < n; ++j)
+      ok &= CppAD::NearEqual(dy[j], dw[j], eps, eps);
+   //
+   return ok;
+}
+// END_USE_ATOMIC_FUNCTION
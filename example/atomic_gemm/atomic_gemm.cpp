@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+// CPPAD_HAS_* defines
+# include <cppad/configure.hpp>
+
+// system include files used for I/O
+# include <iostream>
+
+// C style asserts
+# include <cassert>
+
+// for thread_alloc
+# include <cppad/utility/thread_alloc.hpp>
+
+// test runner
+# include <cppad/utility/test_boolofvoid.hpp>
+
+// external complied tests
+extern bool forward(void);
+extern bool get_started(void);
+extern bool reverse(void);
+extern bool sparsity(void);
+
+// main program that runs all the tests
+int main(void)
+{  std::string group = "example/atomic_gemm";
+   size_t      width = 20;
+   CppAD::test_boolofvoid Run(group, width);
+
+   // This line is used by test_one.sh
+
+   // external compiled tests
+   Run( forward,             "forward"        );
+   Run( get_started,         "get_started"    );
+   Run( reverse,             "reverse"        );
+   Run( sparsity,            "sparsity"       );
+   //
+   // check for memory leak
+   bool memory_ok = CppAD::thread_alloc::free_all();
+   // print summary at end
+   bool ok = Run.summary(memory_ok);
+   //
+   return static_cast<int>( ! ok );
+}
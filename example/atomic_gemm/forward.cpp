@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_gemm_forward.cpp}
+
+Atomic Matrix Multiply Forward Mode: Example and Test
+#####################################################
+
+Purpose
+*******
+This example compares forward mode of orders zero through three,
+for the product *C* = *A* * *B* , with the same calculation
+recorded using scalar ``AD`` < ``double`` > operations.
+The elements of *A* are dynamic parameters and the elements of *B*
+are variables.
+The dimensions are large enough so that *A* is partitioned into more than
+one block by the kernel.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_gemm_forward.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool forward(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, vector
+   using CppAD::AD;
+   using CppAD::vector;
+   //
+   // gemm
+   CppAD::atomic_gemm<double> gemm("gemm");
+   //
+   // n_left, n_middle, n_right, call_id
+   size_t n_left = 67, n_middle = 259, n_right = 3;
+   size_t call_id = gemm.set(n_left, n_middle, n_right);
+   //
+   // np, nx, m
+   size_t np = n_left * n_middle;
+   size_t nx = n_middle * n_right;
+   size_t m  = n_left * n_right;
+   //
+   // p, x
+   vector<double> p(np), x(nx);
+   for(size_t j = 0; j < np; ++j)
+      p[j] = double( (j * 7) % 11 ) / 11.0 - 0.5;
+   for(size_t j = 0; j < nx; ++j)
+      x[j] = double( (j * 5) % 13 ) / 13.0 - 0.5;
+   //
+   // f, g
+   // f uses gemm and g uses scalar operations; both compute
+   // y = A * B where A = p and B = x
+   vector< AD<double> > ap(np), ax(nx), au(np + nx), ay(m);
+   CppAD::ADFun<double> f, g;
+   for(size_t i_fun = 0; i_fun < 2; ++i_fun)
+   {  for(size_t j = 0; j < np; ++j)
+         ap[j] = p[j];
+      for(size_t j = 0; j < nx; ++j)
+         ax[j] = x[j];
+      CppAD::Independent(ax, ap);
+      if( i_fun == 0 )
+      {  for(size_t j = 0; j < np; ++j)
+            au[j] = ap[j];
+         for(size_t j = 0; j < nx; ++j)
+            au[np + j] = ax[j];
+         gemm(call_id, au, ay);
+         f.Dependent(ax, ay);
+      }
+      else
+      {  for(size_t i = 0; i < n_left; ++i)
+         {  for(size_t j = 0; j < n_right; ++j)
+            {  AD<double> sum = 0.0;
+               for(size_t k = 0; k < n_middle; ++k)
+                  sum += ap[i * n_middle + k] * ax[k * n_right + j];
+               ay[i * n_right + j] = sum;
+            }
+         }
+         g.Dependent(ax, ay);
+      }
+   }
+   //
+   // ok
+   // new values for the dynamic parameters
+   for(size_t j = 0; j < np; ++j)
+      p[j] = double( (j * 3) % 7 ) / 7.0 - 0.5;
+   f.new_dynamic(p);
+   g.new_dynamic(p);
+   for(size_t order = 0; order < 4; ++order)
+   {  vector<double> xq(nx);
+      for(size_t j = 0; j < nx; ++j)
+         xq[j] = double( (j + order) % 5 ) / 5.0;
+      vector<double> yf = f.Forward(order, xq);
+      vector<double> yg = g.Forward(order, xq);
+      for(size_t i = 0; i < m; ++i)
+         ok &= CppAD::NearEqual(yf[i], yg[i], eps, eps);
+   }
+   //
+   // ok
+   // multiple orders at once
+   size_t q = 3;
+   vector<double> xq(nx * q);
+   for(size_t j = 0; j < nx; ++j)
+   {  for(size_t k = 0; k < q; ++k)
+         xq[j * q + k] = double( (j + 2 * k) % 7 ) / 7.0;
+   }
+   vector<double> yf = f.Forward(q - 1, xq);
+   vector<double> yg = g.Forward(q - 1, xq);
+   for(size_t i = 0; i < m * q; ++i)
+      ok &= CppAD::NearEqual(yf[i], yg[i], eps, eps);
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_gemm_get_started.cpp}
+
+Getting Started with Atomic Matrix Multiply: Example and Test
+#############################################################
+
+Purpose
+*******
+Record the product of a 2 by 3 matrix *A* and a 3 by 2 matrix *B*
+as one atomic operation, and compute its value and Jacobian.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_gemm_get_started.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool get_started(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, vector
+   using CppAD::AD;
+   using CppAD::vector;
+   //
+   // gemm
+   CppAD::atomic_gemm<double> gemm("gemm");
+   //
+   // n_left, n_middle, n_right, call_id
+   size_t n_left = 2, n_middle = 3, n_right = 2;
+   size_t call_id = gemm.set(n_left, n_middle, n_right);
+   //
+   // n, m
+   size_t n = n_middle * (n_left + n_right);
+   size_t m = n_left * n_right;
+   //
+   // f
+   // y = f(x) = A * B where x = [ A , B ]
+   vector< AD<double> > ax(n), ay(m);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = AD<double>(j + 1);
+   CppAD::Independent(ax);
+   gemm(call_id, ax, ay);
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // ok
+   // the product is one atomic operation (no scalar multiplies)
+   ok &= f.size_var() < n + m + 4;
+   //
+   // x, y
+   vector<double> x(n), y(m);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j + 2);
+   y = f.Forward(0, x);
+   //
+   // ok
+   size_t offset = n_left * n_middle;
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  double check = 0.0;
+         for(size_t k = 0; k < n_middle; ++k)
+            check += x[i * n_middle + k] * x[offset + k * n_right + j];
+         ok &= CppAD::NearEqual(y[i * n_right + j], check, eps, eps);
+      }
+   }
+   //
+   // J
+   vector<double> J = f.Jacobian(x);
+   //
+   // ok
+   // partial of C(i,j) w.r.t A(i,k) is B(k,j)
+   // partial of C(i,j) w.r.t B(k,j) is A(i,k)
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  size_t ij = i * n_right + j;
+         for(size_t k = 0; k < n_middle; ++k)
+         {  size_t ik = i * n_middle + k;
+            size_t kj = offset + k * n_right + j;
+            ok &= CppAD::NearEqual(J[ij * n + ik], x[kj], eps, eps);
+            ok &= CppAD::NearEqual(J[ij * n + kj], x[ik], eps, eps);
+         }
+      }
+   }
+   //
+   // ok
+   size_t nl, nm, nr;
+   gemm.get(call_id, nl, nm, nr);
+   ok &= nl == n_left && nm == n_middle && nr == n_right;
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_gemm_reverse.cpp}
+
+Atomic Matrix Multiply Reverse Mode: Example and Test
+#####################################################
+
+Purpose
+*******
+This example compares second order reverse mode,
+for a function that uses :ref:`atomic_gemm-name` ,
+with the same calculation recorded using scalar
+``AD`` < ``double`` > operations.
+It also uses :ref:`base2ad-name` to record the gradient of the function,
+which records the reverse mode products as calls to the atomic function.
+The function is
+
+.. math::
+
+   f(x) = ( P P ) ( A B )
+
+where the elements of *P* are dynamic parameters
+and the elements of *A* and *B* are the independent variables.
+The product :math:`P P` is a dynamic parameter calculation.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_gemm_reverse.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   // C = A * B using scalar operations
+   template <class Scalar>
+   void scalar_mat_mul(
+      size_t n_left, size_t n_middle, size_t n_right,
+      const CppAD::vector<Scalar>& a ,
+      const CppAD::vector<Scalar>& b ,
+      CppAD::vector<Scalar>&       c )
+   {  for(size_t i = 0; i < n_left; ++i)
+      {  for(size_t j = 0; j < n_right; ++j)
+         {  Scalar sum = 0.0;
+            for(size_t k = 0; k < n_middle; ++k)
+               sum += a[i * n_middle + k] * b[k * n_right + j];
+            c[i * n_right + j] = sum;
+         }
+      }
+   }
+}
+
+bool reverse(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, vector
+   using CppAD::AD;
+   using CppAD::vector;
+   //
+   // gemm
+   CppAD::atomic_gemm<double> gemm("gemm");
+   //
+   // n_left, n_middle, n_right
+   // n_right is large enough so that B is partitioned into more than
+   // one block by the kernel.
+   size_t n_left = 3, n_middle = 5, n_right = 260;
+   //
+   // na, nb, nx, np, m
+   size_t na = n_left * n_middle;
+   size_t nb = n_middle * n_right;
+   size_t nx = na + nb;
+   size_t np = n_left * n_left;
+   size_t m  = n_left * n_right;
+   //
+   // p, x
+   vector<double> p(np), x(nx);
+   for(size_t j = 0; j < np; ++j)
+      p[j] = double( (j * 3) % 5 ) / 5.0 - 0.5;
+   for(size_t j = 0; j < nx; ++j)
+      x[j] = double( (j * 5) % 13 ) / 13.0 - 0.5;
+   //
+   // f, g
+   // f uses gemm and g uses scalar operations
+   CppAD::ADFun<double> f, g;
+   for(size_t i_fun = 0; i_fun < 2; ++i_fun)
+   {  vector< AD<double> > ap(np), ax(nx);
+      for(size_t j = 0; j < np; ++j)
+         ap[j] = p[j];
+      for(size_t j = 0; j < nx; ++j)
+         ax[j] = x[j];
+      CppAD::Independent(ax, ap);
+      vector< AD<double> > aa(na), ab(nb), ac(m), aq(np), ay(m);
+      for(size_t j = 0; j < na; ++j)
+         aa[j] = ax[j];
+      for(size_t j = 0; j < nb; ++j)
+         ab[j] = ax[na + j];
+      if( i_fun == 0 )
+      {  // aq = P * P
+         vector< AD<double> > au(2 * np);
+         for(size_t j = 0; j < np; ++j)
+            au[j] = au[np + j] = ap[j];
+         gemm( gemm.set(n_left, n_left, n_left), au, aq);
+         //
+         // ac = A * B
+         gemm( gemm.set(n_left, n_middle, n_right), ax, ac);
+         //
+         // ay = aq * ac
+         vector< AD<double> > av(np + m);
+         for(size_t j = 0; j < np; ++j)
+            av[j] = aq[j];
+         for(size_t j = 0; j < m; ++j)
+            av[np + j] = ac[j];
+         gemm( gemm.set(n_left, n_left, n_right), av, ay);
+         f.Dependent(ax, ay);
+      }
+      else
+      {  scalar_mat_mul(n_left, n_left, n_left, ap, ap, aq);
+         scalar_mat_mul(n_left, n_middle, n_right, aa, ab, ac);
+         scalar_mat_mul(n_left, n_left, n_right, aq, ac, ay);
+         g.Dependent(ax, ay);
+      }
+   }
+   //
+   // dx, w
+   vector<double> dx(nx), w(m);
+   for(size_t j = 0; j < nx; ++j)
+      dx[j] = double( j % 3 ) - 1.0;
+   for(size_t i = 0; i < m; ++i)
+      w[i] = double( i % 4 ) / 4.0;
+   //
+   // ok
+   // second order reverse using new values for the dynamic parameters
+   for(size_t j = 0; j < np; ++j)
+      p[j] = double( (j * 2) % 7 ) / 7.0 - 0.5;
+   f.new_dynamic(p);
+   g.new_dynamic(p);
+   f.Forward(0, x);
+   g.Forward(0, x);
+   f.Forward(1, dx);
+   g.Forward(1, dx);
+   vector<double> dwf = f.Reverse(2, w);
+   vector<double> dwg = g.Reverse(2, w);
+   for(size_t j = 0; j < 2 * nx; ++j)
+      ok &= CppAD::NearEqual(dwf[j], dwg[j], eps, eps);
+   //
+   // h
+   // h(x) is the gradient of w^T f(x) recorded using base2ad
+   CppAD::ADFun< AD<double>, double > af = f.base2ad();
+   CppAD::ADFun<double> h;
+   {  vector< AD<double> > ap(np), ax(nx), aw(m), adw(nx);
+      for(size_t j = 0; j < np; ++j)
+         ap[j] = p[j];
+      for(size_t j = 0; j < nx; ++j)
+         ax[j] = x[j];
+      for(size_t i = 0; i < m; ++i)
+         aw[i] = w[i];
+      CppAD::Independent(ax, ap);
+      af.new_dynamic(ap);
+      af.Forward(0, ax);
+      adw = af.Reverse(1, aw);
+      h.Dependent(ax, adw);
+   }
+   //
+   // ok
+   // h(x) is the gradient and h'(x) * dx is the Hessian times dx
+   h.new_dynamic(p);
+   vector<double> dh  = h.Forward(0, x);
+   vector<double> ddh = h.Forward(1, dx);
+   for(size_t j = 0; j < nx; ++j)
+   {  ok &= CppAD::NearEqual(dh[j],  dwg[j * 2 + 0], eps, eps);
+      ok &= CppAD::NearEqual(ddh[j], dwg[j * 2 + 1], eps, eps);
+   }
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_gemm_sparsity.cpp}
+
+Atomic Matrix Multiply Sparsity Patterns: Example and Test
+##########################################################
+
+Purpose
+*******
+This example computes Jacobian and Hessian sparsity patterns,
+and optimizes a recording, for a function that uses
+:ref:`atomic_gemm-name` .
+The matrices *A* and *B* are 2 by 3 and 3 by 2.
+The element *A* (0,1) is the constant zero and the other elements of
+*A* and *B* are variables.
+Hence *C* (0, *j* ) does not depend on *B* (1, *j* ).
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_gemm_sparsity.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool sparsity(void)
+{  // ok
+   bool ok = true;
+   //
+   // AD, vector, sparsity
+   using CppAD::AD;
+   using CppAD::vector;
+   typedef CppAD::sparse_rc< vector<size_t> > sparsity;
+   //
+   // gemm
+   CppAD::atomic_gemm<double> gemm("gemm");
+   //
+   // n_left, n_middle, n_right, call_id
+   size_t n_left = 2, n_middle = 3, n_right = 2;
+   size_t call_id = gemm.set(n_left, n_middle, n_right);
+   //
+   // n, m, offset
+   size_t n      = n_middle * (n_left + n_right);
+   size_t m      = n_left * n_right;
+   size_t offset = n_left * n_middle;
+   //
+   // zero_ik
+   // index in x of the element of A that is the constant zero
+   size_t zero_ik = 0 * n_middle + 1;
+   //
+   // f
+   // x = [ A , B ] except that x[zero_ik] is not used
+   vector< AD<double> > ax(n), au(n), ay(m);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = AD<double>(j + 1);
+   CppAD::Independent(ax);
+   for(size_t j = 0; j < n; ++j)
+      au[j] = ax[j];
+   au[zero_ik] = 0.0;
+   gemm(call_id, au, ay);
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // pattern_in
+   sparsity pattern_in(n, n, n);
+   for(size_t j = 0; j < n; ++j)
+      pattern_in.set(j, j, j);
+   //
+   // jac_pattern
+   bool transpose     = false;
+   bool dependency    = false;
+   bool internal_bool = false;
+   sparsity jac_pattern;
+   f.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, jac_pattern
+   );
+   //
+   // ok
+   // C(i,j) depends on A(i,k) and B(k,j) except for the zero term
+   vector<bool> check(m * n);
+   for(size_t ij = 0; ij < m * n; ++ij)
+      check[ij] = false;
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  size_t ij = i * n_right + j;
+         for(size_t k = 0; k < n_middle; ++k)
+         {  size_t ik = i * n_middle + k;
+            size_t kj = offset + k * n_right + j;
+            if( ik != zero_ik )
+            {  check[ij * n + ik] = true;
+               check[ij * n + kj] = true;
+            }
+         }
+      }
+   }
+   ok &= jac_pattern.nnz() < m * n;
+   vector<size_t> row_major = jac_pattern.row_major();
+   size_t ell = 0;
+   for(size_t ij = 0; ij < m * n; ++ij) if( check[ij] )
+   {  size_t k = row_major[ell++];
+      ok &= jac_pattern.row()[k] * n + jac_pattern.col()[k] == ij;
+   }
+   ok &= ell == jac_pattern.nnz();
+   //
+   // hes_pattern
+   vector<bool> select_domain(n), select_range(m);
+   for(size_t j = 0; j < n; ++j)
+      select_domain[j] = true;
+   for(size_t i = 0; i < m; ++i)
+      select_range[i] = true;
+   sparsity hes_pattern;
+   f.for_hes_sparsity(
+      select_domain, select_range, internal_bool, hes_pattern
+   );
+   //
+   // ok
+   // the only non-zero second partials are between A(i,k) and B(k,j)
+   check.resize(n * n);
+   for(size_t ij = 0; ij < n * n; ++ij)
+      check[ij] = false;
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  for(size_t k = 0; k < n_middle; ++k)
+         {  size_t ik = i * n_middle + k;
+            size_t kj = offset + k * n_right + j;
+            if( ik != zero_ik )
+            {  check[ik * n + kj] = true;
+               check[kj * n + ik] = true;
+            }
+         }
+      }
+   }
+   row_major = hes_pattern.row_major();
+   ell       = 0;
+   for(size_t ij = 0; ij < n * n; ++ij) if( check[ij] )
+   {  size_t k = row_major[ell++];
+      ok &= hes_pattern.row()[k] * n + hes_pattern.col()[k] == ij;
+   }
+   ok &= ell == hes_pattern.nnz();
+   //
+   // g
+   // g(x) = C(0,0) where the arguments to gemm are cos(x)
+   CppAD::Independent(ax);
+   for(size_t j = 0; j < n; ++j)
+      au[j] = cos( ax[j] );
+   au[zero_ik] = 0.0;
+   gemm(call_id, au, ay);
+   vector< AD<double> > az(1);
+   az[0] = ay[0];
+   CppAD::ADFun<double> g(ax, az);
+   //
+   // x, z_before
+   vector<double> x(n);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j) / double(n);
+   vector<double> z_before = g.Forward(0, x);
+   //
+   // ok
+   // C(0,0) only depends on A(0,0), A(0,2), B(0,0), B(2,0) so
+   // optimize removes the other cos operations (there are n - 1 of them)
+   size_t size_before = g.size_var();
+   g.optimize();
+   size_t size_after = g.size_var();
+   ok &= size_after + (n - 1) - 4 <= size_before;
+   vector<double> z_after = g.Forward(0, x);
+   ok &= CppAD::NearEqual(z_before[0], z_after[0], 1e-14, 1e-14);
+   //
+   return ok;
+}
+// END C++
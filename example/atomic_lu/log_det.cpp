@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_lu_log_det.cpp}
+
+Atomic Log Determinant: Example and Test
+########################################
+
+Purpose
+*******
+This example compares forward mode, second order reverse mode,
+and the Hessian, for a function that uses
+the :ref:`atomic_lu@Log Determinant` version of :ref:`atomic_lu-name` ,
+with the same calculation recorded using scalar
+``AD`` < ``double`` > operations.
+The matrix *A* is 4 by 4 and has a negative determinant.
+It also shows that :ref:`optimize-name` removes the calculation of the
+atomic function when neither of its results is used.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_lu_log_det.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   // y = [ log | det(A) | , sign( det(A) ) ] using Gaussian elimination
+   // without pivoting
+   template <class Scalar>
+   void scalar_log_det(
+      size_t n,
+      const CppAD::vector<Scalar>& x ,
+      CppAD::vector<Scalar>&       y )
+   {  CppAD::vector<Scalar> a(x);
+      for(size_t k = 0; k < n; ++k)
+      {  for(size_t i = k + 1; i < n; ++i)
+         {  Scalar ell = a[i * n + k] / a[k * n + k];
+            for(size_t p = k + 1; p < n; ++p)
+               a[i * n + p] -= ell * a[k * n + p];
+         }
+      }
+      y[0] = 0.0;
+      y[1] = 1.0;
+      for(size_t k = 0; k < n; ++k)
+      {  y[0] += log( abs( a[k * n + k] ) );
+         y[1] *= sign( a[k * n + k] );
+      }
+   }
+}
+
+bool log_det(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, vector
+   using CppAD::AD;
+   using CppAD::vector;
+   //
+   // lu
+   CppAD::atomic_lu<double> lu("lu");
+   //
+   // n, call_id
+   size_t n = 4;
+   size_t call_id = lu.set_log_det(n);
+   //
+   // nx
+   size_t nx = n * n;
+   //
+   // x
+   double a[] = {
+      1.0, 2.0, 0.0, 1.0,
+      4.0, 1.0, 2.0, 0.0,
+      0.0, 1.0, 3.0, 1.0,
+      1.0, 0.0, 1.0, 2.0
+   };
+   vector<double> x(nx);
+   for(size_t ik = 0; ik < nx; ++ik)
+      x[ik] = a[ik];
+   //
+   // f, g
+   vector< AD<double> > ax(nx), ay(2);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = x[j];
+   CppAD::Independent(ax);
+   lu(call_id, ax, ay);
+   CppAD::ADFun<double> f(ax, ay);
+   CppAD::Independent(ax);
+   scalar_log_det(n, ax, ay);
+   CppAD::ADFun<double> g(ax, ay);
+   //
+   // ok
+   // forward orders zero, one, two, and three
+   vector<double> x_k(nx), y_f, y_g;
+   for(size_t k = 0; k < 4; ++k)
+   {  if( k == 0 )
+         x_k = x;
+      else for(size_t j = 0; j < nx; ++j)
+         x_k[j] = double(j + k) / double(nx);
+      y_f = f.Forward(k, x_k);
+      y_g = g.Forward(k, x_k);
+      for(size_t i = 0; i < 2; ++i)
+         ok &= CppAD::NearEqual(y_f[i], y_g[i], eps, eps);
+   }
+   //
+   // ok
+   // the determinant is negative
+   y_f = f.Forward(0, x);
+   ok &= y_f[1] == -1.0;
+   //
+   // ok
+   // reverse mode for orders zero, one, two, and three
+   vector<double> w(2 * 4), dw_f, dw_g;
+   for(size_t ell = 0; ell < 2 * 4; ++ell)
+      w[ell] = double(ell + 1);
+   for(size_t k = 1; k < 4; ++k)
+   {  for(size_t j = 0; j < nx; ++j)
+         x_k[j] = double(j + k) / double(nx);
+      f.Forward(k, x_k);
+      g.Forward(k, x_k);
+   }
+   dw_f = f.Reverse(4, w);
+   dw_g = g.Reverse(4, w);
+   for(size_t ell = 0; ell < nx * 4; ++ell)
+      ok &= CppAD::NearEqual(dw_f[ell], dw_g[ell], eps, eps);
+   //
+   // ok
+   // Hessian of the log determinant
+   vector<double> hes_f = f.Hessian(x, 0);
+   vector<double> hes_g = g.Hessian(x, 0);
+   for(size_t ell = 0; ell < nx * nx; ++ell)
+      ok &= CppAD::NearEqual(hes_f[ell], hes_g[ell], eps, eps);
+   //
+   // h
+   // h(x) = x[0] * x[1] and the atomic function results are not used
+   CppAD::Independent(ax);
+   lu(call_id, ax, ay);
+   vector< AD<double> > az(1);
+   az[0] = ax[0] * ax[1];
+   CppAD::ADFun<double> h(ax, az);
+   //
+   // ok
+   // optimize removes the atomic function call
+   size_t size_before = h.size_var();
+   h.optimize();
+   ok &= h.size_var() < size_before;
+   vector<double> z = h.Forward(0, x);
+   ok &= z[0] == x[0] * x[1];
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_lu_solve.cpp}
+
+Atomic Linear Solve: Example and Test
+#####################################
+
+Purpose
+*******
+This example compares forward mode, second order reverse mode,
+and the Jacobian sparsity pattern, for a function that uses
+the :ref:`atomic_lu@Linear Solve` version of :ref:`atomic_lu-name` ,
+with the same calculation recorded using scalar
+``AD`` < ``double`` > operations.
+The matrix *A* is 3 by 3 and requires a row exchange
+when it is factored with partial pivoting.
+The matrix *B* is 3 by 2.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_lu_solve.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   // X = A^{-1} * B using Gaussian elimination without pivoting
+   template <class Scalar>
+   void scalar_solve(
+      size_t n, size_t m,
+      const CppAD::vector<Scalar>& x ,
+      CppAD::vector<Scalar>&       y )
+   {  CppAD::vector<Scalar> a(n * n), b(n * m);
+      for(size_t ik = 0; ik < n * n; ++ik)
+         a[ik] = x[ik];
+      for(size_t kj = 0; kj < n * m; ++kj)
+         b[kj] = x[n * n + kj];
+      for(size_t k = 0; k < n; ++k)
+      {  for(size_t i = k + 1; i < n; ++i)
+         {  Scalar ell = a[i * n + k] / a[k * n + k];
+            for(size_t p = k + 1; p < n; ++p)
+               a[i * n + p] -= ell * a[k * n + p];
+            for(size_t j = 0; j < m; ++j)
+               b[i * m + j] -= ell * b[k * m + j];
+         }
+      }
+      size_t i = n;
+      while( i > 0 )
+      {  --i;
+         for(size_t j = 0; j < m; ++j)
+         {  Scalar sum = b[i * m + j];
+            for(size_t p = i + 1; p < n; ++p)
+               sum -= a[i * n + p] * y[p * m + j];
+            y[i * m + j] = sum / a[i * n + i];
+         }
+      }
+   }
+}
+
+bool solve(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // AD, vector, sparsity
+   using CppAD::AD;
+   using CppAD::vector;
+   typedef CppAD::sparse_rc< vector<size_t> > sparsity;
+   //
+   // lu
+   CppAD::atomic_lu<double> lu("lu");
+   //
+   // n, m, call_id
+   size_t n = 3, m = 2;
+   size_t call_id = lu.set_solve(n, m);
+   //
+   // nx, ny
+   size_t nx = n * (n + m);
+   size_t ny = n * m;
+   //
+   // x
+   // abs( A(0,0) ) < abs( A(1,0) ) so partial pivoting exchanges rows
+   double a[] = {
+      0.5, 2.0, 1.0,
+      3.0, 1.0, 2.0,
+      1.0, 1.0, 4.0
+   };
+   vector<double> x(nx);
+   for(size_t ik = 0; ik < n * n; ++ik)
+      x[ik] = a[ik];
+   for(size_t kj = 0; kj < n * m; ++kj)
+      x[n * n + kj] = double(kj + 1);
+   //
+   // f, g
+   vector< AD<double> > ax(nx), ay(ny);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = x[j];
+   CppAD::Independent(ax);
+   lu(call_id, ax, ay);
+   CppAD::ADFun<double> f(ax, ay);
+   CppAD::Independent(ax);
+   scalar_solve(n, m, ax, ay);
+   CppAD::ADFun<double> g(ax, ay);
+   //
+   // ok
+   // forward orders zero, one, and two
+   vector<double> x_k(nx), y_f, y_g;
+   for(size_t k = 0; k < 3; ++k)
+   {  if( k == 0 )
+         x_k = x;
+      else for(size_t j = 0; j < nx; ++j)
+         x_k[j] = double(j + k) / double(nx);
+      y_f = f.Forward(k, x_k);
+      y_g = g.Forward(k, x_k);
+      for(size_t i = 0; i < ny; ++i)
+         ok &= CppAD::NearEqual(y_f[i], y_g[i], eps, eps);
+   }
+   //
+   // ok
+   // reverse mode for orders zero, one, and two
+   vector<double> w(ny * 3), dw_f, dw_g;
+   for(size_t ell = 0; ell < ny * 3; ++ell)
+      w[ell] = double(ell + 1) / double(ny);
+   dw_f = f.Reverse(3, w);
+   dw_g = g.Reverse(3, w);
+   for(size_t ell = 0; ell < nx * 3; ++ell)
+      ok &= CppAD::NearEqual(dw_f[ell], dw_g[ell], eps, eps);
+   //
+   // h
+   // column one of B is identically zero and so is column one of X
+   CppAD::Independent(ax);
+   vector< AD<double> > au(nx);
+   for(size_t j = 0; j < nx; ++j)
+      au[j] = ax[j];
+   for(size_t k = 0; k < n; ++k)
+      au[n * n + k * m + 1] = 0.0;
+   lu(call_id, au, ay);
+   for(size_t i = 0; i < n; ++i)
+      ok &= CppAD::Parameter( ay[i * m + 1] );
+   CppAD::ADFun<double> h(ax, ay);
+   //
+   // jac_pattern
+   sparsity pattern_in(nx, nx, nx);
+   for(size_t j = 0; j < nx; ++j)
+      pattern_in.set(j, j, j);
+   bool transpose     = false;
+   bool dependency    = false;
+   bool internal_bool = false;
+   sparsity jac_pattern;
+   h.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, jac_pattern
+   );
+   //
+   // ok
+   // X(i,0) depends on A and B(:,0)
+   vector<bool> check(ny * nx);
+   for(size_t ij = 0; ij < ny * nx; ++ij)
+      check[ij] = false;
+   for(size_t i = 0; i < n; ++i)
+   {  size_t ij = i * m + 0;
+      for(size_t ik = 0; ik < n * n; ++ik)
+         check[ij * nx + ik] = true;
+      for(size_t k = 0; k < n; ++k)
+         check[ij * nx + n * n + k * m + 0] = true;
+   }
+   vector<size_t> row_major = jac_pattern.row_major();
+   size_t ell = 0;
+   for(size_t ij = 0; ij < ny * nx; ++ij) if( check[ij] )
+   {  size_t k = row_major[ell++];
+      ok &= jac_pattern.row()[k] * nx + jac_pattern.col()[k] == ij;
+   }
+   ok &= ell == jac_pattern.nnz();
+   //
+   return ok;
+}
+// END C++
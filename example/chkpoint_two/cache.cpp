@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin chkpoint_two_cache.cpp}
+
+Caching Checkpoint Forward Mode Results: Example and Test
+########################################################
+
+Purpose
+*******
+This example demonstrates using :ref:`chkpoint_two_cache-name`
+so that reverse mode does not recompute the forward mode results
+for a :ref:`chkpoint_two-name` function.
+
+g(x)
+****
+For this example, the checkpoint function
+:math:`g : \B{R}^2 \rightarrow \B{R}^2` is defined by
+
+.. math::
+
+   g(x)
+   =
+   \left( \begin{array}{c}
+      x_0 \cdot x_1 \\
+      \sin( x_0 ) + c( x_1 )
+   \end{array} \right)
+
+where :math:`c(x)` is a :ref:`discrete-name` function that is always zero.
+It is used to count the number of times zero order forward mode
+is evaluated for :math:`g(x)`.
+
+f(x)
+****
+The function :math:`f(x) : \B{R}^2 \rightarrow \B{R}^2`
+is defined by :math:`f(x) = g(x) + g( x + 1 )`
+where :math:`x + 1` adds one to each component of :math:`x` .
+Thus there are two uses of the checkpoint function in the recording of
+:math:`f(x)` .
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end chkpoint_two_cache.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+namespace {
+   // number of times count_eval is called
+   size_t count_eval_ = 0;
+   //
+   // count_eval
+   double count_eval(const double& x)
+   {  ++count_eval_;
+      return 0.0;
+   }
+   CPPAD_DISCRETE_FUNCTION(double, count_eval)
+}
+bool cache(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * CppAD::numeric_limits<double>::epsilon();
+   //
+   // record the function g(x)
+   size_t n = 2, m = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(m), az(m), ax_plus(n);
+   for(size_t j = 0; j < n; j++)
+      ax[j] = double(j + 1);
+   CppAD::Independent(ax);
+   ay[0] = ax[0] * ax[1];
+   ay[1] = sin( ax[0] ) + count_eval( ax[1] );
+   CppAD::ADFun<double> g_fun(ax, ay);
+   //
+   // make a checkpoint version of g
+   std::string name             = "g(x)";
+   bool        internal_bool    = true;
+   bool        use_hes_sparsity = false;
+   bool        use_base2ad      = false;
+   bool        use_in_parallel  = false;
+   CppAD::chkpoint_two<double> g_chk(g_fun, name,
+      internal_bool, use_hes_sparsity, use_base2ad, use_in_parallel
+   );
+   //
+   // record f(x) = g(x) + g(x + 1)
+   CppAD::Independent(ax);
+   for(size_t j = 0; j < n; ++j)
+      ax_plus[j] = ax[j] + 1.0;
+   g_chk(ax, ay);
+   g_chk(ax_plus, az);
+   for(size_t i = 0; i < m; ++i)
+      ay[i] = ay[i] + az[i];
+   CppAD::ADFun<double> f_fun(ax, ay);
+   //
+   // x, w, dw
+   CPPAD_TESTVECTOR(double) x(n), w(m), dw(n);
+   x[0] = 0.5;
+   x[1] = 1.5;
+   w[0] = 1.0;
+   w[1] = 2.0;
+   //
+   // check: derivative of w^T f(x)
+   CPPAD_TESTVECTOR(double) check(n);
+   check[0] = w[0] * ( x[1] + (x[1] + 1.0) )
+            + w[1] * ( cos(x[0]) + cos(x[0] + 1.0) );
+   check[1] = w[0] * ( x[0] + (x[0] + 1.0) );
+   //
+   // default: reverse mode recomputes g(x) for each use of g_chk
+   count_eval_ = 0;
+   f_fun.Forward(0, x);
+   dw = f_fun.Reverse(1, w);
+   ok &= count_eval_ == 4;
+   for(size_t j = 0; j < n; ++j)
+      ok &= NearEqual(dw[j], check[j], eps99, eps99);
+   //
+   // cache the results for both uses of g_chk
+   size_t max_entry = 2;
+   size_t max_bytes = 100000;
+   g_chk.cache(max_entry, max_bytes);
+   count_eval_ = 0;
+   f_fun.Forward(0, x);
+   dw = f_fun.Reverse(1, w);
+   ok &= count_eval_ == 2;
+   for(size_t j = 0; j < n; ++j)
+      ok &= NearEqual(dw[j], check[j], eps99, eps99);
+   //
+   // cache the results for one use of g_chk (the last one)
+   max_entry = 1;
+   g_chk.cache(max_entry, max_bytes);
+   count_eval_ = 0;
+   f_fun.Forward(0, x);
+   dw = f_fun.Reverse(1, w);
+   ok &= count_eval_ == 3;
+   for(size_t j = 0; j < n; ++j)
+      ok &= NearEqual(dw[j], check[j], eps99, eps99);
+   //
+   // restore the memory minimal behavior
+   max_entry = 0;
+   max_bytes = 0;
+   g_chk.cache(max_entry, max_bytes);
+   count_eval_ = 0;
+   f_fun.Forward(0, x);
+   dw = f_fun.Reverse(1, w);
+   ok &= count_eval_ == 4;
+   for(size_t j = 0; j < n; ++j)
+      ok &= NearEqual(dw[j], check[j], eps99, eps99);
+   //
+   return ok;
+}
+// END C++
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // CPPAD_HAS_* defines
@@ -20,6 +20,7 @@
 
 // external complied tests
 extern bool base2ad(void);
+extern bool cache(void);
 extern bool compare(void);
 extern bool dynamic(void);
 extern bool get_started(void);
@@ -35,6 +36,7 @@ int main(void)
 
    // external compiled tests
    Run( base2ad,             "base2ad"        );
+   Run( cache,               "cache"          );
    Run( compare,             "compare"        );
    Run( dynamic,             "dynamic"        );
    Run( get_started,         "get_started"    );
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -66,6 +66,7 @@ bool number_skip(void)
    // after optimize, check amount of optimization
    ok &= f.size_var() == n_var - 1;
    ok &= f.number_skip() == 1;
+   ok &= f.number_skip_op() == 1;
 
    return ok;
 }
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -201,7 +201,7 @@ namespace {
    // Vector with information for all threads
    // (uses pointers instead of values to avoid false sharing)
    // allocated by multi_atomic_two_setup, freed by multi_atomic_two_takedown
-   work_one_t* work_all_[CPPAD_MAX_NUM_THREADS];
+   work_one_t* work_all_[CPPAD_THREAD_LIMIT];
 }
 // END COMMON C++
 /*
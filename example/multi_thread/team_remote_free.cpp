@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin team_remote_free.cpp}
+
+Returning Memory Allocated by a Different Thread: Example and Test
+##################################################################
+
+Purpose
+*******
+This is a stress test of returning :ref:`thread_alloc-name` memory
+using a different thread than the one that allocated it; see
+:ref:`ta_return_memory@Thread` .
+Each thread creates ``CppAD::vector`` objects (the producer)
+and the next thread checks and deletes them (the consumer).
+At the same time, each thread allocates and frees its own temporary
+vectors so that its remote free queue is processed while other
+threads are adding to it.
+
+Source Code
+***********
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end team_remote_free.cpp}
+------------------------------------------------------------------------------
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include "team_thread.hpp"
+# define NUMBER_THREADS  4
+# define NUMBER_ROUNDS   20
+# define NUMBER_VECTORS  200
+
+namespace {
+   using CppAD::thread_alloc;
+   //
+   // structure with information for one thread
+   typedef struct {
+      // vectors created by this thread and deleted by the next thread
+      CppAD::vector<double> mailbox[NUMBER_VECTORS];
+      // false if an error occurs, true otherwise (worker output)
+      bool ok;
+   } work_one_t;
+   //
+   // vector with information for all threads
+   // (use pointers instead of values to avoid false sharing)
+   work_one_t* work_all_[NUMBER_THREADS];
+   //
+   // round_ is the current round of the test
+   size_t round_ = 0;
+   //
+   // value for element j of vector k created by thread in this round
+   double value(size_t thread, size_t k, size_t j)
+   {  return double(thread) + double(k) / 10. + double(round_ + j) / 100.;
+   }
+   // size of vector k created by thread in this round
+   size_t length(size_t thread, size_t k)
+   {  return 1 + (thread + 7 * k + 13 * round_) % 500;
+   }
+   // --------------------------------------------------------------------
+   // producer: create the vectors for this thread
+   void produce(void)
+   {  size_t thread = thread_alloc::thread_num();
+      work_one_t* work = work_all_[thread];
+      for(size_t k = 0; k < NUMBER_VECTORS; ++k)
+      {  size_t n = length(thread, k);
+         work->mailbox[k].resize(n);
+         for(size_t j = 0; j < n; ++j)
+            work->mailbox[k][j] = value(thread, k, j);
+      }
+   }
+   // consumer: check and delete the vectors created by the next thread
+   void consume(void)
+   {  size_t thread = thread_alloc::thread_num();
+      size_t other  = (thread + 1) % NUMBER_THREADS;
+      work_one_t* work = work_all_[other];
+      bool ok = work_all_[thread]->ok;
+      for(size_t k = 0; k < NUMBER_VECTORS; ++k)
+      {  size_t n = length(other, k);
+         ok &= work->mailbox[k].size() == n;
+         for(size_t j = 0; j < n; ++j)
+            ok &= work->mailbox[k][j] == value(other, k, j);
+         //
+         // memory for this vector is returned to the other thread
+         work->mailbox[k].clear();
+         //
+         // memory allocated by this thread; this processes memory that
+         // other threads have returned for this thread
+         CppAD::vector<double> temp(n);
+         for(size_t j = 0; j < n; ++j)
+            temp[j] = double(j);
+         ok &= temp[n-1] == double(n-1);
+      }
+      work_all_[thread]->ok = ok;
+   }
+}
+
+// This test routine is only called by the master thread (thread_num = 0).
+bool team_remote_free(void)
+{  bool ok = true;
+   size_t num_threads = NUMBER_THREADS;
+   //
+   // Check that no memory is in use or avialable at start
+   // (using thread_alloc in sequential mode)
+   size_t thread_num;
+   for(thread_num = 0; thread_num < num_threads; thread_num++)
+   {  ok &= thread_alloc::inuse(thread_num) == 0;
+      ok &= thread_alloc::available(thread_num) == 0;
+   }
+   //
+   // initialize work_all_
+   // (use new so the vectors in work_all_ are constructed)
+   for(thread_num = 0; thread_num < num_threads; thread_num++)
+   {  work_all_[thread_num]     = new work_one_t;
+      work_all_[thread_num]->ok = true;
+   }
+   //
+   ok &= team_create(num_threads);
+   for(round_ = 0; round_ < NUMBER_ROUNDS; ++round_)
+   {  ok &= team_work(produce);
+      ok &= team_work(consume);
+   }
+   ok &= team_destroy();
+   //
+   // go down so that free memrory for other threads before memory for master
+   thread_num = num_threads;
+   while(thread_num--)
+   {  // check that this thread was ok with the work it did
+      ok &= work_all_[thread_num]->ok;
+      //
+      // all of the vectors have been deleted by the next thread
+      for(size_t k = 0; k < NUMBER_VECTORS; ++k)
+         ok &= work_all_[thread_num]->mailbox[k].capacity() == 0;
+      delete work_all_[thread_num];
+      //
+      // check that there is no longer any memory inuse by this thread
+      // (this processes the memory returned by the other thread)
+      ok &= thread_alloc::inuse(thread_num) == 0;
+      //
+      // return all memory being held for future use by this thread
+      thread_alloc::free_available(thread_num);
+   }
+   return ok;
+}
+// END C++
@@ -0,0 +1,10 @@
+# ifndef CPPAD_EXAMPLE_MULTI_THREAD_TEAM_REMOTE_FREE_HPP
+# define CPPAD_EXAMPLE_MULTI_THREAD_TEAM_REMOTE_FREE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+extern bool team_remote_free(void);
+
+# endif
@@ -1,7 +1,7 @@
 #! /bin/sh -e
 # SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 # SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-# SPDX-FileContributor: 2003-22 Bradley M. Bell
+# SPDX-FileContributor: 2003-24 Bradley M. Bell
 # ----------------------------------------------------------------------------
 # script used by */makefile.am to run a default case for all the the tests
 # --------------------------------------------------------------------------
@@ -88,5 +88,9 @@ do
       echo
       echo_eval ./$program team_example
       echo
+      echo_eval ./$program team_remote_free
+      echo
+      echo_eval ./$program thread_pool
+      echo
    fi
 done
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin thread_pool.cpp}
+
+Using the CppAD Thread Pool: Example and Test
+#############################################
+
+Purpose
+*******
+This example uses a :ref:`thread_pool-name` to compute the Jacobian of a
+function at many points.
+Each thread in the pool uses its own copy of the ``ADFun`` object.
+It also uses the pool to compute a sparsity pattern with
+:ref:`for_jac_sparsity<for_jac_sparsity@num_thread>` .
+Note that this example does not use the
+:ref:`team_thread.hpp-name` routines.
+
+Source Code
+***********
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end thread_pool.cpp}
+------------------------------------------------------------------------------
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# define NUMBER_THREADS  4
+
+namespace {
+   using CppAD::thread_alloc;
+   using CppAD::AD;
+   //
+   typedef CPPAD_TESTVECTOR(double)       d_vector;
+   typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+   //
+   // job that computes the Jacobian at one point
+   class jacobian_job {
+   public:
+      // one function object for each thread
+      std::vector< CppAD::ADFun<double> >* fun_;
+      // x_all[j] is the point for job j
+      std::vector<d_vector>* x_all_;
+      // jac_all[j] is the Jacobian for job j
+      std::vector<d_vector>* jac_all_;
+      // count[j] is the number of times job j was executed
+      std::vector<size_t>* count_;
+      //
+      void operator()(size_t j)
+      {  size_t thread = thread_alloc::thread_num();
+         CppAD::ADFun<double>& f = (*fun_)[thread];
+         (*jac_all_)[j] = f.Jacobian( (*x_all_)[j] );
+         ++(*count_)[j];
+      }
+   };
+}
+
+bool thread_pool(void)
+{  bool ok = true;
+   size_t n = 3;
+   size_t m = 2;
+   {  // create the pool; this calls parallel_setup and parallel_ad<double>
+      CppAD::thread_pool pool(NUMBER_THREADS);
+      ok &= pool.num_threads() == NUMBER_THREADS;
+      ok &= thread_alloc::num_threads() == NUMBER_THREADS;
+      ok &= ! thread_alloc::in_parallel();
+      //
+      // f(x) = [ x_0 * x_1 , sin(x_1) * x_2 ]
+      a_vector ax(n), ay(m);
+      for(size_t i = 0; i < n; ++i)
+         ax[i] = 1.0;
+      CppAD::Independent(ax);
+      ay[0] = ax[0] * ax[1];
+      ay[1] = sin( ax[1] ) * ax[2];
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // fun: a copy of f for each thread
+      std::vector< CppAD::ADFun<double> > fun(NUMBER_THREADS);
+      for(size_t thread = 0; thread < NUMBER_THREADS; ++thread)
+         fun[thread] = f;
+      //
+      // x_all, jac_all, count
+      size_t n_job = 100;
+      std::vector<d_vector> x_all(n_job), jac_all(n_job);
+      std::vector<size_t>   count(n_job, 0);
+      for(size_t j = 0; j < n_job; ++j)
+      {  x_all[j].resize(n);
+         for(size_t i = 0; i < n; ++i)
+            x_all[j][i] = double(j + i) / double(n_job);
+      }
+      //
+      // compute the Jacobians using the pool
+      jacobian_job job;
+      job.fun_     = &fun;
+      job.x_all_   = &x_all;
+      job.jac_all_ = &jac_all;
+      job.count_   = &count;
+      pool.run(n_job, job);
+      //
+      // check the results
+      double eps = 10. * std::numeric_limits<double>::epsilon();
+      for(size_t j = 0; j < n_job; ++j)
+      {  ok &= count[j] == 1;
+         const d_vector& x( x_all[j] );
+         const d_vector& jac( jac_all[j] );
+         ok &= jac.size() == m * n;
+         ok &= CppAD::NearEqual(jac[0 * n + 0], x[1], eps, eps);
+         ok &= CppAD::NearEqual(jac[0 * n + 1], x[0], eps, eps);
+         ok &= jac[0 * n + 2] == 0.0;
+         ok &= jac[1 * n + 0] == 0.0;
+         ok &= CppAD::NearEqual(jac[1 * n + 1], cos(x[1]) * x[2], eps, eps);
+         ok &= CppAD::NearEqual(jac[1 * n + 2], sin(x[1]), eps, eps);
+      }
+      //
+      // for_jac_sparsity using the threads in the pool
+      typedef CPPAD_TESTVECTOR(size_t) s_vector;
+      CppAD::sparse_rc<s_vector> pattern_in(n, n, n), pattern_out;
+      for(size_t k = 0; k < n; ++k)
+         pattern_in.set(k, k, k);
+      bool transpose     = false;
+      bool dependency    = false;
+      bool internal_bool = false;
+      size_t num_thread  = NUMBER_THREADS;
+      f.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_out,
+         num_thread
+      );
+      ok &= pattern_out.nnz() == 4;
+      //
+      // The objects above are destroyed before the pool (in reverse order
+      // of construction), so their memory has been returned when the pool
+      // destructor frees the available memory for each thread.
+   }
+   // the pool has returned thread_alloc to a single thread
+   ok &= thread_alloc::num_threads() == 1;
+   //
+   return ok;
+}
+// END C++
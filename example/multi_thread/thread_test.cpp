@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -53,6 +53,8 @@ you can execute the following commands:
 | ./ *program* ``a11c``
 | ./ *program* ``simple_ad``
 | ./ *program* ``team_example``
+| ./ *program* ``team_remote_free``
+| ./ *program* ``thread_pool``
 | ./ *program* ``harmonic`` *test_time* *max_threads* *mega_sum*
 | ./ *program* ``atomic_two`` *test_time* *max_threads* *num_solve*
 | ./ *program* ``atomic_three`` *test_time* *max_threads* *num_solve*
@@ -71,6 +73,7 @@ as the *test_case* below.
    example/multi_thread/bthread/simple_ad_bthread.cpp
    example/multi_thread/pthread/simple_ad_pthread.cpp
    example/multi_thread/team_example.cpp
+   example/multi_thread/team_remote_free.cpp
    example/multi_thread/harmonic.xrst
    example/multi_thread/multi_atomic_three.xrst
    example/multi_thread/multi_chkpoint_two.xrst
@@ -106,6 +109,20 @@ The *test_case* ``team_example`` runs the
 This case demonstrates simple multi-threading with algorithmic differentiation
 and using a :ref:`team of threads<team_thread.hpp-name>` .
 
+team_remote_free
+****************
+The *test_case* ``team_remote_free`` runs the
+:ref:`team_remote_free.cpp-name` example.
+This case is a stress test for returning memory using a different
+thread than the one that allocated it.
+
+thread_pool
+***********
+The *test_case* ``thread_pool`` runs the
+:ref:`thread_pool.cpp-name` example.
+This case uses a :ref:`thread_pool-name` instead of the
+threading system for *program* .
+
 test_time
 *********
 All of the other cases include the *test_time* argument.
@@ -233,6 +250,8 @@ Source
 # include <ctime>
 # include "team_thread.hpp"
 # include "team_example.hpp"
+# include "team_remote_free.hpp"
+# include "thread_pool.hpp"
 # include "harmonic.hpp"
 # include "multi_atomic_two.hpp"
 # include "multi_atomic_three.hpp"
@@ -279,6 +298,8 @@ int main(int argc, char *argv[])
    "./<program> a11c\n"
    "./<program> simple_ad\n"
    "./<program> team_example\n"
+   "./<program> team_remote_free\n"
+   "./<program> thread_pool\n"
    "./<program> harmonic     test_time max_threads mega_sum\n"
    "./<program> atomic_two   test_time max_threads num_solve\n"
    "./<program> atomic_three test_time max_threads num_solve\n"
@@ -322,13 +343,16 @@ int main(int argc, char *argv[])
    bool run_a11c         = std::strcmp(test_name, "a11c")             == 0;
    bool run_simple_ad    = std::strcmp(test_name, "simple_ad")        == 0;
    bool run_team_example = std::strcmp(test_name, "team_example")     == 0;
+   bool run_remote_free  = std::strcmp(test_name, "team_remote_free") == 0;
+   bool run_thread_pool  = std::strcmp(test_name, "thread_pool")      == 0;
    bool run_harmonic     = std::strcmp(test_name, "harmonic")         == 0;
    bool run_atomic_two   = std::strcmp(test_name, "atomic_two")       == 0;
    bool run_atomic_three = std::strcmp(test_name, "atomic_three")     == 0;
    bool run_chkpoint_one = std::strcmp(test_name, "chkpoint_one")     == 0;
    bool run_chkpoint_two = std::strcmp(test_name, "chkpoint_two")     == 0;
    bool run_multi_newton = std::strcmp(test_name, "multi_newton")     == 0;
-   if( run_a11c || run_simple_ad || run_team_example )
+   if( run_a11c || run_simple_ad || run_team_example || run_remote_free
+   || run_thread_pool )
       ok = (argc == 2);
    else if( run_harmonic
    || run_atomic_two
@@ -344,13 +368,18 @@ int main(int argc, char *argv[])
       std::cerr << usage << endl;
       exit(1);
    }
-   if( run_a11c || run_simple_ad || run_team_example )
+   if( run_a11c || run_simple_ad || run_team_example || run_remote_free
+   || run_thread_pool )
    {  if( run_a11c )
          ok        = a11c();
       else if( run_simple_ad )
          ok        = simple_ad();
-      else
+      else if( run_team_example )
          ok        = team_example();
+      else if( run_remote_free )
+         ok        = team_remote_free();
+      else
+         ok        = thread_pool();
       if( thread_alloc::free_all() )
          cout << "free_all      = true;"  << endl;
       else
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin freeze_dynamic.cpp}
+
+Freeze Dynamic Parameters: Example and Test
+###########################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end freeze_dynamic.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   template <class Scalar> Scalar fun(const Scalar& x, const Scalar& p)
+   {  // expensive branch
+      Scalar big   = sin(x) + cos(x) + exp(x) + log(x);
+      //
+      // cheap branch
+      Scalar small = x * (p * p);
+      //
+      return CppAD::CondExpLt(p, Scalar(1.0), big, small);
+   }
+}
+bool freeze_dynamic(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+   // independent dynamic parameters
+   CPPAD_TESTVECTOR(AD<double>) ap(2);
+   ap[0] = 2.0;
+   ap[1] = 3.0;
+
+   // independent variables
+   CPPAD_TESTVECTOR(AD<double>) ax(1);
+   ax[0] = 0.5;
+
+   // record f(x; p)
+   size_t abort_op_index = 0;
+   bool   record_compare = false;
+   CppAD::Independent(ax, abort_op_index, record_compare, ap);
+   CPPAD_TESTVECTOR(AD<double>) ay(2);
+   ay[0] = fun(ax[0], ap[0]);
+   ay[1] = ap[1] * ax[0];
+   CppAD::ADFun<double> f(ax, ay);
+   f.optimize();
+   //
+   // size_dyn_par, size_var before freezing p[0]
+   size_t size_dyn_par = f.size_dyn_par();
+   size_t size_var     = f.size_var();
+
+   // freeze p[0] at the value 2.0 so the cheap branch is always selected
+   CPPAD_TESTVECTOR(bool) frozen(2);
+   frozen[0] = true;
+   frozen[1] = false;
+   f.freeze_dynamic(frozen);
+
+   // p[0] * p[0] is no longer a dynamic parameter
+   ok &= size_dyn_par == 3;
+   ok &= f.size_dyn_par() == 2;
+   ok &= f.size_dyn_ind() == 2;
+
+   // the variables in the expensive branch have been removed; i.e.,
+   // the remaining variables are the phantom variable, x, x * 4, p[1] * x
+   ok &= size_var == 12;
+   ok &= f.size_var() == 4;
+
+   // change p[1] (the new value for p[0] is ignored)
+   CPPAD_TESTVECTOR(double) p(2), x(1), y(2);
+   p[0] = 0.0;
+   p[1] = 4.0;
+   f.new_dynamic(p);
+   x[0] = 0.25;
+   y    = f.Forward(0, x);
+   ok  &= NearEqual(y[0], fun(x[0], 2.0), eps10, eps10);
+   ok  &= NearEqual(y[1], p[1] * x[0], eps10, eps10);
+
+   return ok;
+}
+// END C++
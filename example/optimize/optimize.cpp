@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 // system include files used for I/O
 # include <iostream>
@@ -19,6 +19,7 @@ extern bool compare_op(void);
 extern bool conditional_skip(void);
 extern bool cumulative_sum(void);
 extern bool forward_active(void);
+extern bool freeze_dynamic(void);
 extern bool nest_conditional(void);
 extern bool print_for(void);
 extern bool reverse_active(void);
@@ -37,6 +38,7 @@ int main(void)
    Run( cumulative_sum,      "cumulative_sum"     );
    Run( conditional_skip,    "conditional_skip"   );
    Run( forward_active,      "forward_active"     );
+   Run( freeze_dynamic,      "freeze_dynamic"     );
    Run( nest_conditional,    "nest_conditional"   );
    Run( print_for,           "print_for"          );
    Run( reverse_active,      "reverse_active"     );
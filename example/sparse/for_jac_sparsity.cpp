@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -82,6 +82,15 @@ bool for_jac_sparsity(void)
       ok &= (f.size_forward_bool() == 0);
    }
    //
+   // same calculation using one thread for each column of R
+   size_t num_thread = 2;
+   sparsity pattern_thread;
+   f.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, pattern_thread,
+      num_thread
+   );
+   ok &= pattern_thread == pattern_out;
+   //
    // note that the transpose of the identity is the identity
    transpose     = true;
    internal_bool = true;
@@ -106,6 +115,15 @@ bool for_jac_sparsity(void)
       ok &= (f.size_forward_set() == 0);
       ok &= (f.size_forward_bool() > 0);
    }
+   //
+   // same calculation using one thread for each column of R
+   f.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, pattern_thread,
+      num_thread
+   );
+   ok &= pattern_thread == pattern_out;
+   ok &= (f.size_forward_set() == 0);
+   ok &= (f.size_forward_bool() > 0);
    return ok;
 }
 // END C++
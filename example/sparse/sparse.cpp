@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // CPPAD_HAS_* defines
@@ -37,7 +37,10 @@ extern bool rev_jac_sparsity(void);
 extern bool rev_sparse_hes(void);
 extern bool sparse2eigen(void);
 extern bool sparse_hes(void);
+extern bool sparse_hes_edge(void);
 extern bool sparse_hessian(void);
+extern bool sparse_jac_bidir(void);
+extern bool sparse_jac_tangent(void);
 extern bool sparse_jac_for(void);
 extern bool sparse_jac_rev(void);
 extern bool sparse_jacobian(void);
@@ -72,7 +75,10 @@ int main(void)
    Run( rev_jac_sparsity,          "rev_jac_sparsity" );
    Run( rev_sparse_hes,            "rev_sparse_hes" );
    Run( sparse_hes,                "sparse_hes" );
+   Run( sparse_hes_edge,           "sparse_hes_edge" );
    Run( sparse_hessian,            "sparse_hessian" );
+   Run( sparse_jac_bidir,          "sparse_jac_bidir" );
+   Run( sparse_jac_tangent,        "sparse_jac_tangent" );
    Run( sparse_jac_for,            "sparse_jac_for" );
    Run( sparse_jac_rev,            "sparse_jac_rev" );
    Run( sparse_jacobian,           "sparse_jacobian" );
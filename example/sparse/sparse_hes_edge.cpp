@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_hes_edge.cpp}
+
+Computing Sparse Hessian Using Edge Pushing: Example and Test
+#############################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end sparse_hes_edge.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool sparse_hes_edge(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   using CppAD::sparse_rcv;
+   //
+   typedef CPPAD_TESTVECTOR(AD<double>) a_vector;
+   typedef CPPAD_TESTVECTOR(double)     d_vector;
+   typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+   //
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // domain space vector
+   size_t n = 6;
+   a_vector  a_x(n);
+   for(size_t j = 0; j < n; j++)
+      a_x[j] = AD<double> (j + 1);
+   //
+   // declare independent variables and starting recording
+   CppAD::Independent(a_x);
+   //
+   // range space vector
+   size_t m = 3;
+   a_vector  a_y(m);
+   a_y[0]  = a_x[0] * a_x[1] + sin( a_x[2] ) + a_x[3] * a_x[3];
+   a_y[1]  = exp( a_x[0] ) / a_x[4] + pow( a_x[1], a_x[2] );
+   AD<double> zero(0.0);
+   a_y[2]  = CondExpGt(a_x[5], zero, a_x[5] * a_x[5], a_x[0] * a_x[5]);
+   //
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(a_x, a_y);
+   //
+   // x, w
+   d_vector x(n), w(m);
+   for(size_t j = 0; j < n; j++)
+      x[j] = double(j + 1) / double(n);
+   for(size_t i = 0; i < m; i++)
+      w[i] = double(i + 1);
+   //
+   // hes
+   sparse_rcv<s_vector, d_vector> hes;
+   f.sparse_hes_edge(x, w, hes);
+   ok &= hes.nr() == n;
+   ok &= hes.nc() == n;
+   //
+   // dense Hessian used to check the values
+   d_vector check = f.Hessian(x, w);
+   //
+   // the entries in hes are in row major order
+   const s_vector& row( hes.row() );
+   const s_vector& col( hes.col() );
+   const d_vector& val( hes.val() );
+   s_vector row_major = hes.pat().row_major();
+   CppAD::vector<bool> found(n * n);
+   for(size_t k = 0; k < n * n; ++k)
+      found[k] = false;
+   for(size_t k = 0; k < hes.nnz(); k++)
+   {  ok &= row_major[k] == k;
+      size_t i = row[k];
+      size_t j = col[k];
+      ok &= NearEqual(val[k], check[i * n + j], eps, eps);
+      found[i * n + j] = true;
+   }
+   //
+   // The pattern is the structural non-zeros for this value of x:
+   // (0,1), (1,0), (2,2), (3,3), (0,0), (0,4), (4,0), (4,4),
+   // (1,1), (1,2), (2,1), (5,5)
+   ok &= hes.nnz() == 12;
+   ok &= found[0 * n + 1] && found[1 * n + 0];
+   ok &= found[2 * n + 2] && found[3 * n + 3] && found[5 * n + 5];
+   ok &= found[0 * n + 4] && found[4 * n + 0] && found[4 * n + 4];
+   ok &= found[1 * n + 2] && found[2 * n + 1] && found[1 * n + 1];
+   ok &= ! found[0 * n + 5];
+   for(size_t k = 0; k < n * n; ++k)
+      if( ! found[k] )
+         ok &= check[k] == 0.0;
+   //
+   // The other branch of the conditional expression
+   x[5] = -1.0;
+   f.sparse_hes_edge(x, w, hes);
+   check = f.Hessian(x, w);
+   ok &= hes.nnz() == 13;
+   for(size_t k = 0; k < hes.nnz(); k++)
+   {  size_t i = hes.row()[k];
+      size_t j = hes.col()[k];
+      ok &= NearEqual(hes.val()[k], check[i * n + j], eps, eps);
+      ok &= (i != 5) || (j == 0);
+   }
+   //
+   return ok;
+}
+// END C++
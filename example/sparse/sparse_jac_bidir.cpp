@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_jac_bidir.cpp}
+
+Computing Sparse Jacobian Using Forward and Reverse Mode: Example and Test
+##########################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end sparse_jac_bidir.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool sparse_jac_bidir(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   using CppAD::sparse_rc;
+   using CppAD::sparse_rcv;
+   //
+   typedef CPPAD_TESTVECTOR(AD<double>) a_vector;
+   typedef CPPAD_TESTVECTOR(double)     d_vector;
+   typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+   //
+   // domain space vector
+   size_t n = 6;
+   a_vector  a_x(n);
+   for(size_t j = 0; j < n; j++)
+      a_x[j] = AD<double> (0);
+   //
+   // declare independent variables and starting recording
+   CppAD::Independent(a_x);
+   //
+   // The first row and the first column of the Jacobian are dense
+   size_t m = n;
+   a_vector  a_y(m);
+   a_y[0] = 0.0;
+   for(size_t j = 0; j < n; j++)
+      a_y[0] += a_x[j];
+   for(size_t i = 1; i < m; i++)
+      a_y[i] = a_x[0] * a_x[i];
+   //
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(a_x, a_y);
+   //
+   // new value for the independent variable vector
+   d_vector x(n);
+   for(size_t j = 0; j < n; j++)
+      x[j] = double(j + 1);
+   /*
+          [ 1    1    1   ...  1   ]
+          [ x_1  x_0  0   ...  0   ]
+   J(x) = [ x_2  0    x_0 ...  0   ]
+          [ ...                    ]
+          [ x_5  0    0   ...  x_0 ]
+   */
+   //
+   // n by n identity matrix sparsity
+   sparse_rc<s_vector> pattern_in(n, n, n);
+   for(size_t k = 0; k < n; k++)
+      pattern_in.set(k, k, k);
+   //
+   // sparsity for J(x)
+   bool transpose     = false;
+   bool dependency    = false;
+   bool internal_bool = false;
+   sparse_rc<s_vector> pattern_jac;
+   f.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, pattern_jac
+   );
+   //
+   // Forward mode and reverse mode each require n colors
+   std::string coloring = "cppad";
+   sparse_rcv<s_vector, d_vector> subset( pattern_jac );
+   CppAD::sparse_jac_work work_rev;
+   size_t n_color = f.sparse_jac_rev(x, subset, pattern_jac, coloring, work_rev);
+   ok &= n_color == m;
+   //
+   // Using both forward and reverse mode only requires three colors;
+   // one for the first row, one for the first column, and one for the rest.
+   CppAD::sparse_jac_bidir_work work;
+   size_t group_max = 1;
+   n_color = f.sparse_jac_bidir(
+      group_max, x, subset, pattern_jac, coloring, work
+   );
+   ok &= n_color == 3;
+   ok &= work.rev_index.size() == n;
+   ok &= work.for_index.size() == 2 * (m - 1);
+   //
+   // check result
+   const s_vector& row( subset.row() );
+   const s_vector& col( subset.col() );
+   const d_vector& val( subset.val() );
+   ok &= subset.nnz() == n + 2 * (m - 1);
+   for(size_t k = 0; k < subset.nnz(); k++)
+   {  size_t i = row[k];
+      size_t j = col[k];
+      double check;
+      if( i == 0 )
+         check = 1.0;
+      else if( j == 0 )
+         check = x[i];
+      else
+         check = x[0];
+      ok &= NearEqual(val[k], check, 1e-10, 1e-10);
+   }
+   //
+   // reuse work with a different x
+   for(size_t j = 0; j < n; j++)
+      x[j] = double(n - j);
+   n_color = f.sparse_jac_bidir(
+      group_max, x, subset, pattern_jac, coloring, work
+   );
+   ok &= n_color == 3;
+   for(size_t k = 0; k < subset.nnz(); k++)
+   {  size_t i = row[k];
+      size_t j = col[k];
+      double check;
+      if( i == 0 )
+         check = 1.0;
+      else if( j == 0 )
+         check = x[i];
+      else
+         check = x[0];
+      ok &= NearEqual(val[k], check, 1e-10, 1e-10);
+   }
+   //
+   return ok;
+}
+// END C++
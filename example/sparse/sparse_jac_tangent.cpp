@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_jac_tangent.cpp}
+
+Computing Sparse Jacobian Using Sparse Tangent Vectors: Example and Test
+#######################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end sparse_jac_tangent.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool sparse_jac_tangent(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   using CppAD::sparse_rcv;
+   //
+   typedef CPPAD_TESTVECTOR(AD<double>) a_vector;
+   typedef CPPAD_TESTVECTOR(double)     d_vector;
+   typedef CPPAD_TESTVECTOR(size_t)     s_vector;
+   //
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // domain space vector
+   size_t n = 4;
+   a_vector  a_x(n);
+   for(size_t j = 0; j < n; j++)
+      a_x[j] = AD<double> (j + 1);
+   //
+   // declare independent variables and starting recording
+   CppAD::Independent(a_x);
+   //
+   // range space vector
+   size_t m = 3;
+   a_vector  a_y(m);
+   a_y[0] = a_x[0] * a_x[1];
+   a_y[1] = sin( a_x[2] ) + a_x[0] + a_x[0];
+   AD<double> zero(0.0);
+   a_y[2] = CondExpGt(a_x[3], zero, exp( a_x[3] ), a_x[1] / a_x[2] );
+   //
+   // create f: x -> y and stop tape recording
+   CppAD::ADFun<double> f(a_x, a_y);
+   //
+   // Jacobian at x where x[3] > 0
+   d_vector x(n);
+   for(size_t j = 0; j < n; j++)
+      x[j] = double(j + 1);
+   sparse_rcv<s_vector, d_vector> jac;
+   f.sparse_jac_tangent(x, jac);
+   ok &= jac.nr() == m;
+   ok &= jac.nc() == n;
+   //
+   // the sparsity pattern is
+   // [ x x 0 0 ]
+   // [ x 0 x 0 ]
+   // [ 0 0 0 x ]
+   ok &= jac.nnz() == 5;
+   s_vector row_major = jac.pat().row_major();
+   d_vector check = f.Jacobian(x);
+   for(size_t k = 0; k < jac.nnz(); ++k)
+   {  ok &= row_major[k] == k;
+      size_t i = jac.row()[k];
+      size_t j = jac.col()[k];
+      ok &= NearEqual(jac.val()[k], check[i * n + j], eps, eps);
+   }
+   ok &= jac.row()[4] == 2 && jac.col()[4] == 3;
+   //
+   // Jacobian at x where x[3] < 0, the pattern for the last row changes
+   // [ 0 x x 0 ]
+   x[3] = -1.0;
+   f.sparse_jac_tangent(x, jac);
+   ok &= jac.nnz() == 6;
+   check = f.Jacobian(x);
+   for(size_t k = 0; k < jac.nnz(); ++k)
+   {  size_t i = jac.row()[k];
+      size_t j = jac.col()[k];
+      ok &= NearEqual(jac.val()[k], check[i * n + j], eps, eps);
+   }
+   ok &= jac.row()[4] == 2 && jac.col()[4] == 1;
+   ok &= jac.row()[5] == 2 && jac.col()[5] == 2;
+   //
+   return ok;
+}
+// END C++
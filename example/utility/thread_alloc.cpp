@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -197,6 +197,103 @@ bool check_alignment(void)
 }
 
 
+bool large_allocate(void)
+{  bool ok = true;
+   using CppAD::thread_alloc;
+   size_t thread = thread_alloc::thread_num();
+   //
+   // allocations with capacity greater than or equal 16 megabytes are large
+   size_t large_bytes = 16 * 1024 * 1024;
+   //
+   // check that the capacity for min_bytes is the smallest one possible;
+   // i.e., the capacity for the previous capacity plus one is larger
+   size_t min_bytes = 1;
+   size_t cap_bytes, cap_bytes_old = 0;
+   while( min_bytes <= large_bytes )
+   {  void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+      thread_alloc::return_memory(v_ptr);
+      ok &= min_bytes <= cap_bytes;
+      ok &= cap_bytes_old < min_bytes;
+      cap_bytes_old = cap_bytes;
+      min_bytes     = cap_bytes + 1;
+   }
+   thread_alloc::free_available(thread);
+   //
+   // do not hold any large allocations
+   bool huge_page = false;
+   thread_alloc::large_memory(0, huge_page);
+   void* v_ptr = thread_alloc::get_memory(large_bytes, cap_bytes);
+   char* c_ptr = reinterpret_cast<char*>(v_ptr);
+   c_ptr[0] = 'a';
+   c_ptr[cap_bytes-1] = 'b';
+   ok &= c_ptr[0] == 'a';
+   thread_alloc::return_memory(v_ptr);
+   ok &= thread_alloc::available(thread) == 0;
+   //
+   // hold at most one large allocation and request huge pages
+   huge_page = true;
+   thread_alloc::large_memory(cap_bytes, huge_page);
+   void* v_ptr_1 = thread_alloc::get_memory(large_bytes, cap_bytes);
+   void* v_ptr_2 = thread_alloc::get_memory(large_bytes, cap_bytes);
+   thread_alloc::return_memory(v_ptr_1);
+   thread_alloc::return_memory(v_ptr_2);
+   ok &= thread_alloc::available(thread) == cap_bytes;
+   //
+   // this allocation comes from the available pool
+   v_ptr = thread_alloc::get_memory(large_bytes, cap_bytes);
+   ok &= thread_alloc::available(thread) == 0;
+   thread_alloc::return_memory(v_ptr);
+   thread_alloc::free_available(thread);
+   //
+   // return to the default settings
+   huge_page = false;
+   thread_alloc::large_memory(4 * large_bytes, huge_page);
+   //
+   return ok;
+}
+
+bool check_stats(void)
+{  bool ok = true;
+   using CppAD::thread_alloc;
+   size_t thread = thread_alloc::thread_num();
+   //
+   // start with no memory available and reset the statistics
+   thread_alloc::free_available(thread);
+   thread_alloc::stats_reset(thread);
+   //
+   // two allocations in use at the same time, then re-use one of them
+   size_t min_bytes = 100;
+   size_t cap_bytes;
+   void* v_ptr_1 = thread_alloc::get_memory(min_bytes, cap_bytes);
+   void* v_ptr_2 = thread_alloc::get_memory(min_bytes, cap_bytes);
+   thread_alloc::return_memory(v_ptr_1);
+   v_ptr_1       = thread_alloc::get_memory(min_bytes, cap_bytes);
+   thread_alloc::return_memory(v_ptr_1);
+   thread_alloc::return_memory(v_ptr_2);
+   //
+   // statistics for this capacity
+   thread_alloc::stats_thread snapshot;
+   thread_alloc::stats(thread, snapshot);
+   size_t c_index = 0;
+   while( snapshot.capacity[c_index].capacity != cap_bytes )
+      ++c_index;
+   const thread_alloc::stats_capacity& stats( snapshot.capacity[c_index] );
+# if CPPAD_THREAD_ALLOC_STATS
+   ok &= stats.n_get       == 3;
+   ok &= stats.n_hit       == 1;
+   ok &= stats.n_return    == 3;
+   ok &= stats.n_peak      == 2;
+   ok &= stats.n_available == 2;
+   ok &= snapshot.peak_inuse >= 2 * cap_bytes;
+# else
+   // the counters are zero when thread_alloc statistics are not enabled
+   ok &= stats.n_get == 0 && stats.n_peak == 0 && snapshot.peak_inuse == 0;
+# endif
+   //
+   thread_alloc::free_available(thread);
+   return ok;
+}
+
 bool thread_alloc(void)
 {  bool ok  = true;
    using CppAD::thread_alloc;
@@ -221,6 +318,12 @@ bool thread_alloc(void)
    // check alignment
    ok &= check_alignment();
 
+   // large allocations
+   ok &= large_allocate();
+
+   // allocation statistics
+   ok &= check_stats();
+
    // return allocator to its default mode
    thread_alloc::hold_memory(false);
    return ok;
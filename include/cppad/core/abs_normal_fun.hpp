@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ABS_NORMAL_FUN_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin abs_normal_fun}
@@ -591,6 +591,23 @@ void ADFun<Base,RecBase>::abs_normal_fun(ADFun& g, ADFun& a) const
          f2g_var[i_var] = rec.PutOp(op);
          break;
          // ---------------------------------------------------
+         // Fused multiply add, arg[2] a parameter or variable, one result
+         case FmavvpOp:
+         case FmavvvOp:
+         CPPAD_ASSERT_NARG_NRES(op, 3, 1);
+         CPPAD_ASSERT_UNKNOWN( size_t( f2g_var[ arg[0] ] ) < num_var );
+         CPPAD_ASSERT_UNKNOWN( size_t( f2g_var[ arg[1] ] ) < num_var );
+         new_arg[0] = f2g_var[ arg[0] ];
+         new_arg[1] = f2g_var[ arg[1] ];
+         new_arg[2] = arg[2]; // parameter
+         if( op == FmavvvOp )
+         {  CPPAD_ASSERT_UNKNOWN( size_t( f2g_var[ arg[2] ] ) < num_var );
+            new_arg[2] = f2g_var[ arg[2] ];
+         }
+         rec.PutArg( new_arg[0], new_arg[1], new_arg[2] );
+         f2g_var[i_var] = rec.PutOp(op);
+         break;
+         // ---------------------------------------------------
          // Binary operators, left index, right variable, one result
          case DisOp:
          CPPAD_ASSERT_UNKNOWN( size_t( f2g_var[ arg[1] ] ) < num_var );
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_AD_FUN_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin ADFun}
@@ -23,6 +23,7 @@ Contents
 {xrst_toc_table
    include/cppad/core/ad_fun.xrst
    include/cppad/core/optimize.hpp
+   include/cppad/core/freeze_dynamic.hpp
    include/cppad/core/fun_check.hpp
    include/cppad/core/check_for_nan.hpp
    include/cppad/core/to_csrc.hpp
@@ -65,9 +66,16 @@ private:
    /// Did the previous optimzation exceed the collision limit
    bool exceed_collision_limit_;
 
+   /// Number of operators replaced by a match during previous optimization
+   size_t optimize_match_count_;
+
    /// Has this ADFun object been optmized
    bool has_been_optimized_;
 
+   /// Options, in sorted order and without incremental, used by the
+   /// previous optimization (only meaningful when has_been_optimized_)
+   std::string optimize_options_;
+
    /// Check for nan's and report message to user (default value is true).
    bool check_for_nan_;
 
@@ -85,6 +93,10 @@ private:
    //// that corresponded to the number changing from count-1 to count.
    size_t compare_change_op_index_;
 
+   /// number of operators that were skipped, because of conditional
+   /// skip operators, during the previous forward mode sweep
+   size_t num_skip_op_;
+
    /// number of orders stored in taylor_
    size_t num_order_taylor_;
 
@@ -447,6 +459,26 @@ public:
       sparse_jac_work&                     work
    );
 
+   // compute sparse Jacobian using forward and reverse mode
+   // (doxygen in cppad/core/sparse_jac_bidir.hpp)
+   template <class SizeVector, class BaseVector>
+   size_t sparse_jac_bidir(
+      size_t                               group_max ,
+      const BaseVector&                    x         ,
+      sparse_rcv<SizeVector, BaseVector>&  subset    ,
+      const sparse_rc<SizeVector>&         pattern   ,
+      const std::string&                   coloring  ,
+      sparse_jac_bidir_work&               work
+   );
+
+   // compute sparse Jacobian using sparse tangent vectors
+   // (doxygen in cppad/core/sparse_jac_tangent.hpp)
+   template <class SizeVector, class BaseVector>
+   void sparse_jac_tangent(
+      const BaseVector&                    x        ,
+      sparse_rcv<SizeVector, BaseVector>&  jac
+   );
+
    // compute sparse Hessian
    // (doxygen in cppad/core/sparse_hes.hpp)
    template <class SizeVector, class BaseVector>
@@ -459,6 +491,15 @@ public:
       sparse_hes_work&                     work
    );
 
+   // compute sparse Hessian using edge pushing
+   // (doxygen in cppad/core/sparse_hes_edge.hpp)
+   template <class SizeVector, class BaseVector>
+   void sparse_hes_edge(
+      const BaseVector&                    x        ,
+      const BaseVector&                    w        ,
+      sparse_rcv<SizeVector, BaseVector>&  hes
+   );
+
    // compute sparsity pattern using subgraphs
    // (doxygen in cppad/core/subgraph_sparsity.hpp)
    template <class BoolVector, class SizeVector>
@@ -478,7 +519,8 @@ public:
       bool                         transpose        ,
       bool                         dependency       ,
       bool                         internal_bool    ,
-      sparse_rc<SizeVector>&       pattern_out
+      sparse_rc<SizeVector>&       pattern_out      ,
+      size_t                       num_thread = 1
    );
 
    // reverse mode Jacobian sparsity pattern
@@ -570,6 +612,10 @@ public:
    bool exceed_collision_limit(void) const
    {  return exceed_collision_limit_; }
 
+   /// number of operators replaced by a match during previous optimization
+   size_t optimize_match_count(void) const
+   {  return optimize_match_count_; }
+
    /// amount of memory used for boolean Jacobain sparsity pattern
    size_t size_forward_bool(void) const
    {  return for_jac_sparse_pack_.memory(); }
@@ -658,6 +704,10 @@ public:
    /// number of variables in conditional expressions that can be skipped
    size_t number_skip(void);
 
+   /// number of operators skipped during the previous forward sweep
+   size_t number_skip_op(void) const
+   {  return num_skip_op_; }
+
    /// number of independent variables
    size_t Domain(void) const
    {  return ind_taddr_.size(); }
@@ -796,6 +846,13 @@ public:
    // (see doxygen documentation in optimize.hpp)
    void optimize( const std::string& options = "" );
 
+   // Replace dynamic parameters by constants and optimize
+   // (see doxygen documentation in freeze_dynamic.hpp)
+   template <class BoolVector>
+   void freeze_dynamic(
+      const BoolVector& frozen, const std::string& options = ""
+   );
+
    // create abs-normal representation of the function f(x)
    void abs_normal_fun( ADFun& g, ADFun& a ) const;
 
@@ -861,11 +918,14 @@ public:
 # include <cppad/local/sweep/rev_jac.hpp>
 # include <cppad/local/sweep/rev_hes.hpp>
 # include <cppad/local/sweep/for_hes.hpp>
+# include <cppad/local/sweep/hes_edge.hpp>
+# include <cppad/local/sweep/jac_tangent.hpp>
 # include <cppad/core/graph/from_graph.hpp>
 # include <cppad/core/graph/to_graph.hpp>
 
 // user interfaces
 # include <cppad/core/parallel_ad.hpp>
+# include <cppad/core/thread_pool.hpp>
 # include <cppad/core/independent/independent.hpp>
 # include <cppad/core/dependent.hpp>
 # include <cppad/core/fun_construct.hpp>
@@ -876,6 +936,7 @@ public:
 # include <cppad/core/fun_check.hpp>
 # include <cppad/core/omp_max_thread.hpp>
 # include <cppad/core/optimize.hpp>
+# include <cppad/core/freeze_dynamic.hpp>
 # include <cppad/core/abs_normal_fun.hpp>
 # include <cppad/core/graph/from_json.hpp>
 # include <cppad/core/graph/to_json.hpp>
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_AD_VALUED_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -39,6 +39,8 @@ Contents
 # include <cppad/core/atomic/three/atomic.hpp>
 # include <cppad/core/atomic/four/atomic.hpp>
 # include <cppad/core/chkpoint_two/chkpoint_two.hpp>
+# include <cppad/core/atomic_gemm/atomic_gemm.hpp>
+# include <cppad/core/atomic_lu/atomic_lu.hpp>
 # include <cppad/core/atomic/two/atomic.hpp>
 # include <cppad/core/atomic/one/atomic.hpp>
 # include <cppad/core/chkpoint_one/chkpoint_one.hpp>
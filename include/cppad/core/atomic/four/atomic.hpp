@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_FOUR_ATOMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_four_define}
@@ -51,6 +51,12 @@ Callbacks
 | *ok* = *afun* . ``rev_depend`` ( *call_id* ,
 | |tab| *ident_zero_x* , *depend_x* , *depend_y*
 | )
+| *ok* = *afun* . ``forward_batch`` ( *call_id* , *n_call* ,
+| |tab| *select_y* , *order_low* , *order_up* , *taylor_x* , *taylor_y*
+| )
+| *ok* = *afun* . ``reverse_batch`` ( *call_id* , *n_call* ,
+| |tab| *select_x* , *order_up* , *taylor_x* , *taylor_y* , *partial_x* , *partial_y*
+| )
 
 See Also
 ********
@@ -115,6 +121,7 @@ Contents
    include/cppad/core/atomic/four/jac_sparsity.hpp
    include/cppad/core/atomic/four/hes_sparsity.hpp
    include/cppad/core/atomic/four/rev_depend.hpp
+   include/cppad/core/atomic/four/batch.hpp
 }
 
 {xrst_end atomic_four_define}
@@ -132,6 +139,7 @@ Contents
 
 // needed before one can use in_parallel
 # include <cppad/utility/thread_alloc.hpp>
+# include <cppad/local/thread_table.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -169,7 +177,8 @@ private:
    // Use pointers, to avoid false sharing between threads.
    // Not using: vector<work_struct*> work_;
    // so that deprecated atomic examples do not result in a memory leak.
-   work_struct* work_[CPPAD_MAX_NUM_THREADS];
+   // (initialized to null by its constructor)
+   local::thread_table<work_struct*> work_;
    // -----------------------------------------------------
 public:
    //
@@ -329,6 +338,28 @@ public:
       vector<bool>&                depend_x    ,
       const vector<bool>&          depend_y
    );
+   // ------------------------------------------------------------------------
+   // forward_batch
+   virtual bool forward_batch(
+      size_t                       call_id     ,
+      size_t                       n_call      ,
+      const vector<bool>&          select_y    ,
+      size_t                       order_low   ,
+      size_t                       order_up    ,
+      const vector<Base>&          taylor_x    ,
+      vector<Base>&                taylor_y
+   );
+   // reverse_batch
+   virtual bool reverse_batch(
+      size_t                       call_id     ,
+      size_t                       n_call      ,
+      const vector<bool>&          select_x    ,
+      size_t                       order_up    ,
+      const vector<Base>&          taylor_x    ,
+      const vector<Base>&          taylor_y    ,
+      vector<Base>&                partial_x   ,
+      const vector<Base>&          partial_y
+   );
    // =====================================================================
    // Not in User API
    // =====================================================================
@@ -355,7 +386,7 @@ public:
       CPPAD_ASSERT_UNKNOWN( type == 4 );
       //
       // free temporary work memory
-      for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+      for(size_t thread = 0; thread < work_.size(); thread++)
          free_work(thread);
    }
    /// allocates work_ for a specified thread
@@ -428,5 +459,6 @@ public:
 # include <cppad/core/atomic/four/reverse.hpp>
 # include <cppad/core/atomic/four/jac_sparsity.hpp>
 # include <cppad/core/atomic/four/hes_sparsity.hpp>
+# include <cppad/core/atomic/four/batch.hpp>
 
 # endif
@@ -0,0 +1,186 @@
+# ifndef CPPAD_CORE_ATOMIC_FOUR_BATCH_HPP
+# define CPPAD_CORE_ATOMIC_FOUR_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_four_batch}
+
+Atomic Function Batch Forward and Reverse Mode
+##############################################
+
+Syntax
+******
+
+| *ok* = *afun* . ``forward_batch`` (
+| |tab| *call_id* , *n_call* , *select_y* ,
+| |tab| *order_low* , *order_up* , *taylor_x* , *taylor_y*
+| )
+| *ok* = *afun* . ``reverse_batch`` (
+| |tab| *call_id* , *n_call* , *select_x* ,
+| |tab| *order_up* , *taylor_x* , *taylor_y* , *partial_x* , *partial_y*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE_FORWARD
+   // END_PROTOTYPE_FORWARD
+}
+{xrst_literal
+   // BEGIN_PROTOTYPE_REVERSE
+   // END_PROTOTYPE_REVERSE
+}
+
+Purpose
+*******
+If an atomic function is used many times in the recording of a function
+*f* , for example as a kernel that is applied to each element of a vector,
+evaluating *f* results in a separate
+:ref:`forward<atomic_four_forward-name>` or
+:ref:`reverse<atomic_four_reverse-name>` callback for each use.
+The batch callbacks receive many uses in one call,
+so that *afun* can process them together; e.g.,
+using vector instructions or a matrix library.
+
+Usage
+*****
+These callbacks are optional.
+If they are not defined by the
+:ref:`atomic_four_ctor@atomic_user` class,
+the ``forward`` and ``reverse`` callbacks are used for each call.
+The batch callbacks are used by *f* . ``Forward`` ,
+when it computes zero order Taylor coefficients,
+and by *f* . ``Reverse`` , where *f* has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+They are not used by the :ref:`base2ad-name` version of *f*
+or by higher order forward mode.
+
+Calls
+*****
+The uses of *afun* in the recording of *f* that have the same
+:ref:`atomic_four_call@call_id` ,
+the same domain size *n* , and the same range size *m* ,
+are grouped together.
+A use waits until its results are needed (forward mode)
+or the partials for its arguments are needed (reverse mode).
+When a batch must be evaluated, other uses that are ready are added to it;
+i.e., the uses are grouped by levels of the dependency graph
+between uses of atomic functions.
+One use in a batch does not depend on the results of another use
+in the same batch.
+The order of the uses in a batch is not specified.
+
+call_id
+*******
+This is the :ref:`atomic_four_call@call_id`
+for all the uses in this batch.
+
+n_call
+******
+This is the number of uses in this batch.
+If it is zero, the other arguments are empty and
+the batch callback must return *ok* equal to true.
+CppAD uses this case to determine if the batch callback is defined.
+
+select_y
+********
+The size of *select_y* is *n_call* * *m* .
+For *k* = 0 , ... , *n_call* ``-1`` ,
+the elements *select_y* [ *k* * *m* + *i* ] for *i* = 0 , ... , *m* ``-1``
+are the :ref:`atomic_four_forward@select_y` for the *k*-th use.
+
+select_x
+********
+The size of *select_x* is *n_call* * *n* .
+The elements for the *k*-th use start at index *k* * *n* ; see
+:ref:`atomic_four_reverse@select_x` .
+
+order_low, order_up
+*******************
+These are the same for all the uses in a batch; see
+:ref:`atomic_four_forward@order_low` and
+:ref:`atomic_four_forward@order_up` .
+The ``forward_batch`` callback is only used with *order_up* zero.
+
+q
+=
+We use the notation *q* = *order_up* + 1 below.
+
+taylor_x
+********
+The size of *taylor_x* is *n_call* * *n* * *q* .
+The elements for the *k*-th use start at index *k* * *n* * *q*
+and are the same as :ref:`atomic_four_forward@taylor_x`
+would be for this use.
+
+taylor_y
+********
+The size of *taylor_y* is *n_call* * *m* * *q* .
+The elements for the *k*-th use start at index *k* * *m* * *q*
+and are the same as :ref:`atomic_four_forward@taylor_y`
+would be for this use.
+
+partial_x
+*********
+The size of *partial_x* is *n_call* * *n* * *q* .
+The elements for the *k*-th use start at index *k* * *n* * *q*
+and are the same as :ref:`atomic_four_reverse@partial_x`
+would be for this use.
+
+partial_y
+*********
+The size of *partial_y* is *n_call* * *m* * *q* .
+The elements for the *k*-th use start at index *k* * *m* * *q*
+and are the same as :ref:`atomic_four_reverse@partial_y`
+would be for this use.
+
+ok
+**
+If this calculation succeeded, *ok* is true.
+Otherwise, it is false.
+The default implementation returns false (for all values of *n_call* ).
+
+Example
+*******
+The file :ref:`atomic_four_batch.cpp-name` contains an example and test
+that uses these callbacks.
+
+{xrst_end atomic_four_batch}
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE_FORWARD
+template <class Base>
+bool atomic_four<Base>::forward_batch(
+   size_t                       call_id     ,
+   size_t                       n_call      ,
+   const vector<bool>&          select_y    ,
+   size_t                       order_low   ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   vector<Base>&                taylor_y    )
+// END_PROTOTYPE_FORWARD
+{  return false; }
+
+// BEGIN_PROTOTYPE_REVERSE
+template <class Base>
+bool atomic_four<Base>::reverse_batch(
+   size_t                       call_id     ,
+   size_t                       n_call      ,
+   const vector<bool>&          select_x    ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   const vector<Base>&          taylor_y    ,
+   vector<Base>&                partial_x   ,
+   const vector<Base>&          partial_y   )
+// END_PROTOTYPE_REVERSE
+{  return false; }
+
+} // END_CPPAD_NAMESPACE
+# endif
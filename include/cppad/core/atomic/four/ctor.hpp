@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_FOUR_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_four_ctor}
@@ -127,10 +127,6 @@ atomic_four<Base>::atomic_four(const std::string& name )
    index_  = local::atomic_index<Base>(
       set_null, index, type, &copy_name, copy_this
    );
-   //
-   // work_
-   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-      work_[thread] = nullptr;
 }
 
 } // END_CPPAD_NAMESPACE
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_THREE_ATOMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_three_define}
@@ -206,6 +206,7 @@ Contents
 
 // needed before one can use in_parallel
 # include <cppad/utility/thread_alloc.hpp>
+# include <cppad/local/thread_table.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -243,7 +244,8 @@ private:
    // Use pointers, to avoid false sharing between threads.
    // Not using: vector<work_struct*> work_;
    // so that deprecated atomic examples do not result in a memory leak.
-   work_struct* work_[CPPAD_MAX_NUM_THREADS];
+   // (initialized to null by its constructor)
+   local::thread_table<work_struct*> work_;
    // -----------------------------------------------------
 public:
    //
@@ -406,7 +408,7 @@ public:
       CPPAD_ASSERT_UNKNOWN( type == 3 );
       //
       // free temporary work memory
-      for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+      for(size_t thread = 0; thread < work_.size(); thread++)
          free_work(thread);
    }
    /// allocates work_ for a specified thread
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_THREE_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_three_ctor}
@@ -147,9 +147,6 @@ atomic_three<Base>::atomic_three(const std::string& name )
    index_  = local::atomic_index<Base>(
       set_null, index, type, &copy_name, copy_this
    );
-   // initialize work pointers as null;
-   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-      work_[thread] = nullptr;
 }
 
 } // END_CPPAD_NAMESPACE
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_TWO_CLEAR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_two_clear app}
@@ -73,7 +73,7 @@ void atomic_base<Base>::clear(void)
       if( type == 2 )
       {  atomic_base* op = reinterpret_cast<atomic_base*>(v_ptr);
          if( op != nullptr )
-         {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+         {  for(size_t thread = 0; thread < op->work_.size(); thread++)
                op->free_work(thread);
          }
       }
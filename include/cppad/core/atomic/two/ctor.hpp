@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_TWO_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_two_ctor app}
@@ -156,9 +156,6 @@ sparsity_( sparsity               )
    index_  = local::atomic_index<Base>(
       set_null, index, type, &copy_name, copy_this
    );
-   // initialize work pointers as null;
-   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-      work_[thread] = nullptr;
 }
 
 } // END_CPPAD_NAMESPACE
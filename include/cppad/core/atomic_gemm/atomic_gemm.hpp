@@ -0,0 +1,305 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_ATOMIC_GEMM_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_ATOMIC_GEMM_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_gemm}
+{xrst_spell
+   gemm
+}
+
+Atomic Matrix Multiply
+######################
+
+Syntax
+******
+| ``atomic_gemm`` < *Base* > *gemm* ( *name* )
+| *call_id* = *gemm* . ``set`` ( *n_left* , *n_middle* , *n_right* )
+| *gemm* . ``get`` ( *call_id* , *n_left* , *n_middle* , *n_right* )
+| *gemm* ( *call_id* , *ax* , *ay* )
+
+Purpose
+*******
+Construct an atomic operation that computes the matrix product
+*C* = *A* * *B* .
+Recording a dense matrix product using ``AD`` < *Base* > operations
+creates order *n_left* * *n_middle* * *n_right* scalar operations.
+Using *gemm* instead records one atomic operation and evaluates the
+product, and its derivatives, using a cache blocked kernel.
+
+Base
+****
+The type *Base* specifies the base type for AD operations;
+i.e., *gemm* can be used during the recording of
+``AD`` < *Base* > operations.
+It can also be used during the recording of
+``AD< AD<`` *Base* > > operations created using :ref:`base2ad-name` .
+
+name
+****
+This is the :ref:`atomic_four_ctor@atomic_four@name` for this
+atomic function.
+
+n_left
+******
+This is the row dimension of the matrices *A* and *C* .
+This is an argument (return value) for the ``set`` (``get`` ) routine.
+
+n_middle
+********
+This is the column dimension of the matrix *A*
+and row dimension of the matrix *B* .
+This is an argument (return value) for the ``set`` (``get`` ) routine.
+
+n_right
+*******
+This is the column dimension of the matrices *B* and *C* .
+This is an argument (return value) for the ``set`` (``get`` ) routine.
+
+call_id
+*******
+This is a return value (argument) for the ``set`` (``get`` ) routine.
+Calling ``set`` with the same dimensions returns the same *call_id* .
+The table that maps *call_id* to the dimensions is shared by all the
+threads, so a *call_id* returned by ``set`` in one thread can be
+used by any other thread.
+
+ax
+**
+This is a simple vector with elements of type ``AD`` < *Base* >.
+Its size must be
+
+   *n* = *n_left* * *n_middle* + *n_middle* * *n_right*
+
+The matrix *A* is stored in row major order at the beginning of
+*ax* ; i.e. its ( *i* , *k* ) element is
+
+   *A* ( *i* , *k* ) = *ax* [ *i* * *n_middle* + *k* ]
+
+The matrix *B* is stored in row major order at the end of
+*ax* ; i.e. its ( *k* , *j* ) element is
+
+   *B* ( *k* , *j* ) = *ax* [ *n_left* * *n_middle* + *k* * *n_right* + *j* ]
+
+The elements of *ax* may be variables, dynamic parameters,
+or constant parameters.
+
+ay
+**
+This is a simple vector with elements of type ``AD`` < *Base* >.
+Its size must be *m* = *n_left* * *n_right* and its input value
+does not matter.
+Upon return, the matrix *C* is stored in row major order in *ay* ;
+i.e. its ( *i* , *j* ) element is
+
+   *C* ( *i* , *j* ) = *ay* [ *i* * *n_right* + *j* ]
+
+Derivatives
+***********
+Forward and reverse mode are implemented for all orders.
+For :math:`k = 0 , 1 , \ldots`, the *k*-th order Taylor coefficient
+:math:`C^{(k)}` is given by
+
+.. math::
+
+   C^{(k)} = \sum_{\ell = 0}^{k} A^{(\ell)} B^{(k-\ell)}
+
+Reverse mode eliminates :math:`C^{(k)}` as follows:
+for :math:`\ell = 0, \ldots , k`,
+
+.. math::
+
+   \bar{A}^{(\ell)}  = \bar{A}^{(\ell)} + \bar{C}^{(k)} [ B^{(k-\ell)} ] ^\R{T}
+
+.. math::
+
+   \bar{B}^{(k-\ell)} =  \bar{B}^{(k-\ell)} + [ A^{(\ell)} ]^\R{T} \bar{C}^{(k)}
+
+Each of these products is evaluated by the kernel below without forming
+the transposes.
+Products for which one of the factors is identically zero
+(for example, the higher order coefficients of a matrix that is a parameter)
+are skipped.
+
+Sparsity
+********
+The Jacobian sparsity, Hessian sparsity, and reverse dependency
+calculations use the fact that *C* ( *i* , *j* ) only depends on
+row *i* of *A* and column *j* of *B* .
+They also use the fact that a product with an argument that is an
+identically zero constant parameter is identically zero.
+
+Kernel
+******
+The matrix products are computed by partitioning the matrices into blocks,
+copying each block of *A* and *B* into contiguous memory,
+and accumulating the product of the blocks four rows at a time.
+The block sizes are chosen so that a block of *B* fits in the level two
+cache and the rows of *C* that are being accumulated fit in the
+level one cache.
+The inner loop has unit stride and no dependencies between iterations,
+so it is vectorized by the compiler for types like ``double``
+(when optimization is enabled).
+
+Parallel Mode
+*************
+The only *gemm* data that changes after it is constructed is the
+table of dimensions, and it is protected by a mutex.
+Hence *gemm* can be used by multiple threads at the same time
+(once :ref:`parallel_setup<ta_parallel_setup-name>` has been called).
+
+Contents
+********
+{xrst_toc_table
+   example/atomic_gemm/get_started.cpp
+   example/atomic_gemm/forward.cpp
+   example/atomic_gemm/reverse.cpp
+   example/atomic_gemm/sparsity.cpp
+}
+
+{xrst_end atomic_gemm}
+*/
+# include <array>
+# include <map>
+# include <mutex>
+# include <vector>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_gemm.hpp
+Atomic matrix multiply.
+*/
+
+/*!
+Atomic matrix multiply C = A * B.
+
+\tparam Base
+is the base type for the AD operations that use this atomic function.
+*/
+template <class Base>
+class atomic_gemm : public atomic_four<Base> {
+public:
+   /// constructor
+   atomic_gemm(const std::string& name) : atomic_four<Base>(name)
+   { }
+   //
+   // set
+   size_t set(size_t n_left, size_t n_middle, size_t n_right);
+   //
+   // get
+   void get(
+      size_t call_id, size_t& n_left, size_t& n_middle, size_t& n_right
+   ) const;
+private:
+   /// dimensions ( n_left, n_middle, n_right ) for one call_id
+   typedef std::array<size_t, 3> dim_type;
+   //
+   /// dim_vec_[call_id] is the dimensions corresponding to call_id
+   std::vector<dim_type> dim_vec_;
+   //
+   /// dim_map_[dim] is the call_id corresponding to dimensions dim
+   std::map<dim_type, size_t> dim_map_;
+   //
+   /// mutex that protects dim_vec_ and dim_map_
+   mutable std::mutex dim_mutex_;
+   //
+   // zero_order
+   static void zero_order(
+      size_t                 n_row      ,
+      size_t                 n_col      ,
+      size_t                 q          ,
+      const Base*            taylor     ,
+      vector<bool>&          zero
+   );
+   // -----------------------------------------------------------------------
+   // atomic_four virtual functions
+   // -----------------------------------------------------------------------
+   // for_type
+   bool for_type(
+      size_t                        call_id     ,
+      const vector<ad_type_enum>&   type_x      ,
+      vector<ad_type_enum>&         type_y
+   ) override;
+   //
+   // Base forward
+   bool forward(
+      size_t                        call_id     ,
+      const vector<bool>&           select_y    ,
+      size_t                        order_low   ,
+      size_t                        order_up    ,
+      const vector<Base>&           taylor_x    ,
+      vector<Base>&                 taylor_y
+   ) override;
+   //
+   // AD<Base> forward
+   bool forward(
+      size_t                        call_id     ,
+      const vector<bool>&           select_y    ,
+      size_t                        order_low   ,
+      size_t                        order_up    ,
+      const vector< AD<Base> >&     ataylor_x   ,
+      vector< AD<Base> >&           ataylor_y
+   ) override;
+   //
+   // Base reverse
+   bool reverse(
+      size_t                        call_id     ,
+      const vector<bool>&           select_x    ,
+      size_t                        order_up    ,
+      const vector<Base>&           taylor_x    ,
+      const vector<Base>&           taylor_y    ,
+      vector<Base>&                 partial_x   ,
+      const vector<Base>&           partial_y
+   ) override;
+   //
+   // AD<Base> reverse
+   bool reverse(
+      size_t                        call_id     ,
+      const vector<bool>&           select_x    ,
+      size_t                        order_up    ,
+      const vector< AD<Base> >&     ataylor_x   ,
+      const vector< AD<Base> >&     ataylor_y   ,
+      vector< AD<Base> >&           apartial_x  ,
+      const vector< AD<Base> >&     apartial_y
+   ) override;
+   //
+   // jac_sparsity
+   bool jac_sparsity(
+      size_t                        call_id      ,
+      bool                          dependency   ,
+      const vector<bool>&           ident_zero_x ,
+      const vector<bool>&           select_x     ,
+      const vector<bool>&           select_y     ,
+      sparse_rc< vector<size_t> >&  pattern_out
+   ) override;
+   //
+   // hes_sparsity
+   bool hes_sparsity(
+      size_t                        call_id      ,
+      const vector<bool>&           ident_zero_x ,
+      const vector<bool>&           select_x     ,
+      const vector<bool>&           select_y     ,
+      sparse_rc< vector<size_t> >&  pattern_out
+   ) override;
+   //
+   // rev_depend
+   bool rev_depend(
+      size_t                        call_id      ,
+      const vector<bool>&           ident_zero_x ,
+      vector<bool>&                 depend_x     ,
+      const vector<bool>&           depend_y
+   ) override;
+};
+
+} // END_CPPAD_NAMESPACE
+
+# include <cppad/core/atomic_gemm/kernel.hpp>
+# include <cppad/core/atomic_gemm/set_get.hpp>
+# include <cppad/core/atomic_gemm/for_type.hpp>
+# include <cppad/core/atomic_gemm/forward.hpp>
+# include <cppad/core/atomic_gemm/reverse.hpp>
+# include <cppad/core/atomic_gemm/sparsity.hpp>
+
+# endif
@@ -0,0 +1,68 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_FOR_TYPE_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_FOR_TYPE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_gemm/for_type.hpp
+Atomic matrix multiply type calculation.
+*/
+
+/*!
+Link from atomic_gemm to type calculation
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param type_x [in]
+specifies which components of x are
+constants, dynamics, and variables
+
+\param type_y [out]
+specifies which components of y are
+constants, dynamics, and variables.
+A product with an identically zero factor is treated as identically zero.
+*/
+template <class Base>
+bool atomic_gemm<Base>::for_type(
+   size_t                        call_id     ,
+   const vector<ad_type_enum>&   type_x      ,
+   vector<ad_type_enum>&         type_y      )
+{  //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   CPPAD_ASSERT_UNKNOWN(
+      type_x.size() == n_middle * (n_left + n_right)
+   );
+   CPPAD_ASSERT_UNKNOWN( type_y.size() == n_left * n_right );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // type_y
+   for(size_t ij = 0; ij < n_left * n_right; ++ij)
+      type_y[ij] = identical_zero_enum;
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t k = 0; k < n_middle; ++k)
+      {  ad_type_enum type_ik = type_x[i * n_middle + k];
+         if( type_ik != identical_zero_enum )
+         {  for(size_t j = 0; j < n_right; ++j)
+            {  ad_type_enum type_kj = type_x[offset + k * n_right + j];
+               if( type_kj != identical_zero_enum )
+               {  ad_type_enum& type_ij = type_y[i * n_right + j];
+                  type_ij = std::max(type_ij, type_ik);
+                  type_ij = std::max(type_ij, type_kj);
+               }
+            }
+         }
+      }
+   }
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,162 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_FORWARD_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_FORWARD_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_gemm/forward.hpp
+Atomic matrix multiply forward mode.
+*/
+
+/*!
+Link from atomic_gemm to Base forward mode
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param select_y [in]
+which components of taylor_y are needed (not used).
+
+\param order_low [in]
+lowest order for this forward mode calculation.
+
+\param order_up [in]
+highest order for this forward mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x for this calculation.
+
+\param taylor_y [out]
+Taylor coefficients corresponding to y for this calculation.
+For k = order_low , ... , order_up ,
+C^k = sum_{ell=0}^k A^ell * B^{k-ell}.
+*/
+template <class Base>
+bool atomic_gemm<Base>::forward(
+   size_t                        call_id     ,
+   const vector<bool>&           select_y    ,
+   size_t                        order_low   ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   vector<Base>&                 taylor_y    )
+{  //
+   // q
+   size_t q = order_up + 1;
+   //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   CPPAD_ASSERT_UNKNOWN(
+      taylor_x.size() == n_middle * (n_left + n_right) * q
+   );
+   CPPAD_ASSERT_UNKNOWN( taylor_y.size() == n_left * n_right * q );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // a, b, c
+   const Base* a = taylor_x.data();
+   const Base* b = taylor_x.data() + offset * q;
+   Base*       c = taylor_y.data();
+   //
+   // zero_a, zero_b
+   vector<bool> zero_a, zero_b;
+   zero_order(n_left,   n_middle, q, a, zero_a);
+   zero_order(n_middle, n_right,  q, b, zero_b);
+   //
+   // work
+   vector<Base> work;
+   //
+   for(size_t k = order_low; k < q; ++k)
+   {  // C^k = 0
+      for(size_t ij = 0; ij < n_left * n_right; ++ij)
+         c[ij * q + k] = Base(0);
+      //
+      // C^k += A^ell * B^{k-ell}
+      for(size_t ell = 0; ell <= k; ++ell)
+      {  if( ! ( zero_a[ell] || zero_b[k - ell] ) ) local::gemm_kernel(
+            n_left, n_middle, n_right,
+            a + ell,       n_middle * q, q,
+            b + (k - ell), n_right  * q, q,
+            c + k,         n_right  * q, q,
+            work
+         );
+      }
+   }
+   return true;
+}
+
+/*!
+Link from atomic_gemm to AD<Base> forward mode
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param select_y [in]
+which components of ataylor_y are needed (not used).
+
+\param order_low [in]
+lowest order for this forward mode calculation.
+
+\param order_up [in]
+highest order for this forward mode calculation.
+
+\param ataylor_x [in]
+Taylor coefficients corresponding to x for this calculation.
+
+\param ataylor_y [out]
+Taylor coefficients corresponding to y for this calculation.
+Each of the products A^ell * B^{k-ell} is recorded as a call to
+this atomic function.
+*/
+template <class Base>
+bool atomic_gemm<Base>::forward(
+   size_t                        call_id     ,
+   const vector<bool>&           select_y    ,
+   size_t                        order_low   ,
+   size_t                        order_up    ,
+   const vector< AD<Base> >&     ataylor_x   ,
+   vector< AD<Base> >&           ataylor_y   )
+{  //
+   // q
+   size_t q = order_up + 1;
+   //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   CPPAD_ASSERT_UNKNOWN(
+      ataylor_x.size() == n_middle * (n_left + n_right) * q
+   );
+   CPPAD_ASSERT_UNKNOWN( ataylor_y.size() == n_left * n_right * q );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // ax, ay
+   vector< AD<Base> > ax( n_middle * (n_left + n_right) );
+   vector< AD<Base> > ay( n_left * n_right );
+   //
+   for(size_t k = order_low; k < q; ++k)
+   {  // C^k = 0
+      for(size_t ij = 0; ij < n_left * n_right; ++ij)
+         ataylor_y[ij * q + k] = AD<Base>(0);
+      //
+      // C^k += A^ell * B^{k-ell}
+      for(size_t ell = 0; ell <= k; ++ell)
+      {  for(size_t ik = 0; ik < offset; ++ik)
+            ax[ik] = ataylor_x[ik * q + ell];
+         for(size_t kj = 0; kj < n_middle * n_right; ++kj)
+            ax[offset + kj] = ataylor_x[(offset + kj) * q + (k - ell)];
+         (*this)(call_id, ax, ay);
+         for(size_t ij = 0; ij < n_left * n_right; ++ij)
+            ataylor_y[ij * q + k] += ay[ij];
+      }
+   }
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,220 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_KERNEL_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_KERNEL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <algorithm>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file atomic_gemm/kernel.hpp
+Cache blocked matrix multiply kernel used by atomic_gemm.
+*/
+
+/// number of rows of A in a block (must be a multiple of four)
+static constexpr size_t gemm_block_left   = 64;
+/// number of columns of A (rows of B) in a block
+static constexpr size_t gemm_block_middle = 256;
+/// number of columns of B in a block
+static constexpr size_t gemm_block_right  = 256;
+
+/*!
+Multiply four rows of a packed block of A times a packed block of B.
+
+\param n_middle [in]
+is the number of columns in the block of A and rows in the block of B.
+
+\param n_right [in]
+is the number of columns in the block of B and C.
+
+\param a [in]
+the ( i , k ) element of the block of A is a[ i * n_middle + k ]
+for i = 0, 1, 2, 3.
+
+\param b [in]
+the ( k , j ) element of the block of B is b[ k * n_right + j ].
+
+\param c [in,out]
+the ( i , j ) element of the block of C is c[ i * n_right + j ]
+for i = 0, 1, 2, 3.
+On output, it is its input value plus the product of the blocks.
+*/
+template <class Base>
+inline void gemm_micro4(
+   size_t       n_middle ,
+   size_t       n_right  ,
+   const Base*  a        ,
+   const Base*  b        ,
+   Base*        c        )
+{  const Base* a0 = a;
+   const Base* a1 = a0 + n_middle;
+   const Base* a2 = a1 + n_middle;
+   const Base* a3 = a2 + n_middle;
+   Base*       c0 = c;
+   Base*       c1 = c0 + n_right;
+   Base*       c2 = c1 + n_right;
+   Base*       c3 = c2 + n_right;
+   for(size_t k = 0; k < n_middle; ++k)
+   {  const Base  x0  = a0[k];
+      const Base  x1  = a1[k];
+      const Base  x2  = a2[k];
+      const Base  x3  = a3[k];
+      const Base* b_k = b + k * n_right;
+      for(size_t j = 0; j < n_right; ++j)
+      {  const Base b_kj = b_k[j];
+         c0[j] += x0 * b_kj;
+         c1[j] += x1 * b_kj;
+         c2[j] += x2 * b_kj;
+         c3[j] += x3 * b_kj;
+      }
+   }
+}
+
+/*!
+Cache blocked matrix multiply and accumulate, C += A * B, with strides.
+
+\param n_left [in]
+is the number of rows in A and C.
+
+\param n_middle [in]
+is the number of columns in A and rows in B.
+
+\param n_right [in]
+is the number of columns in B and C.
+
+\param a [in]
+the ( i , k ) element of A is a[ i * a_row + k * a_col ].
+
+\param a_row [in]
+is the stride between rows of A.
+
+\param a_col [in]
+is the stride between columns of A.
+
+\param b [in]
+the ( k , j ) element of B is b[ k * b_row + j * b_col ].
+
+\param b_row [in]
+is the stride between rows of B.
+
+\param b_col [in]
+is the stride between columns of B.
+
+\param c [in,out]
+the ( i , j ) element of C is c[ i * c_row + j * c_col ].
+On output, it is its input value plus A * B.
+
+\param c_row [in]
+is the stride between rows of C.
+
+\param c_col [in]
+is the stride between columns of C.
+
+\param work [in,out]
+is work space. Its input value does not matter and it is only resized
+when its capacity is not large enough. Re-using the same vector for
+multiple calls avoids memory allocation.
+
+\par Strides
+Transposed matrices, and matrices that are columns of a Taylor coefficient
+array, are multiplied without being copied by choosing the strides.
+
+\par Method
+The matrices are partitioned into blocks with at most
+gemm_block_left rows of A, gemm_block_middle columns of A,
+and gemm_block_right columns of B.
+Each block of A and B is copied into contiguous memory
+(this is where the strides are used).
+The product of the blocks is accumulated in a contiguous block of C,
+four rows at a time, using a unit stride inner loop;
+see gemm_micro4.
+*/
+template <class Base>
+void gemm_kernel(
+   size_t        n_left   ,
+   size_t        n_middle ,
+   size_t        n_right  ,
+   const Base*   a        ,
+   size_t        a_row    ,
+   size_t        a_col    ,
+   const Base*   b        ,
+   size_t        b_row    ,
+   size_t        b_col    ,
+   Base*         c        ,
+   size_t        c_row    ,
+   size_t        c_col    ,
+   vector<Base>& work     )
+{  if( n_left == 0 || n_middle == 0 || n_right == 0 )
+      return;
+   //
+   // block_left, block_middle, block_right
+   size_t block_left   = std::min(n_left,   gemm_block_left);
+   size_t block_middle = std::min(n_middle, gemm_block_middle);
+   size_t block_right  = std::min(n_right,  gemm_block_right);
+   //
+   // round block_left up to a multiple of four
+   size_t block_left4  = 4 * ( (block_left + 3) / 4 );
+   //
+   // work = [ a_pack, b_pack, c_pack ]
+   size_t a_size = block_left4  * block_middle;
+   size_t b_size = block_middle * block_right;
+   size_t c_size = block_left4  * block_right;
+   work.resize( a_size + b_size + c_size );
+   Base* a_pack  = work.data();
+   Base* b_pack  = a_pack + a_size;
+   Base* c_pack  = b_pack + b_size;
+   //
+   for(size_t j_start = 0; j_start < n_right; j_start += block_right)
+   {  size_t nj = std::min(block_right, n_right - j_start);
+      for(size_t k_start = 0; k_start < n_middle; k_start += block_middle)
+      {  size_t nk = std::min(block_middle, n_middle - k_start);
+         //
+         // b_pack = B( k_start : k_start + nk , j_start : j_start + nj )
+         for(size_t k = 0; k < nk; ++k)
+         {  const Base* b_k = b + (k_start + k) * b_row + j_start * b_col;
+            Base*       p_k = b_pack + k * nj;
+            for(size_t j = 0; j < nj; ++j)
+               p_k[j] = b_k[j * b_col];
+         }
+         for(size_t i_start = 0; i_start < n_left; i_start += block_left)
+         {  size_t ni  = std::min(block_left, n_left - i_start);
+            size_t ni4 = 4 * ( (ni + 3) / 4 );
+            //
+            // a_pack = A( i_start : i_start + ni , k_start : k_start + nk )
+            // with zero rows added so the number of rows is ni4
+            for(size_t i = 0; i < ni4; ++i)
+            {  Base* p_i = a_pack + i * nk;
+               if( i < ni )
+               {  const Base* a_i = a + (i_start + i) * a_row + k_start * a_col;
+                  for(size_t k = 0; k < nk; ++k)
+                     p_i[k] = a_i[k * a_col];
+               }
+               else
+               {  for(size_t k = 0; k < nk; ++k)
+                     p_i[k] = Base(0);
+               }
+            }
+            //
+            // c_pack = a_pack * b_pack
+            for(size_t ij = 0; ij < ni4 * nj; ++ij)
+               c_pack[ij] = Base(0);
+            for(size_t i = 0; i < ni4; i += 4)
+               gemm_micro4(nk, nj, a_pack + i * nk, b_pack, c_pack + i * nj);
+            //
+            // C( i_start : i_start + ni , j_start : j_start + nj ) += c_pack
+            for(size_t i = 0; i < ni; ++i)
+            {  Base*       c_i = c + (i_start + i) * c_row + j_start * c_col;
+               const Base* p_i = c_pack + i * nj;
+               for(size_t j = 0; j < nj; ++j)
+                  c_i[j * c_col] += p_i[j];
+            }
+         }
+      }
+   }
+   return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
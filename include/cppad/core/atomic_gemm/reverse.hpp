@@ -0,0 +1,244 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_REVERSE_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_REVERSE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_gemm/reverse.hpp
+Atomic matrix multiply reverse mode.
+*/
+
+/*!
+Link from atomic_gemm to Base reverse mode
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param select_x [in]
+which components of partial_x are needed.
+If none of the components corresponding to A (B) are needed,
+the partials with respect to A (B) are not computed (are zero).
+
+\param order_up [in]
+highest order for this reverse mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x for this calculation.
+
+\param taylor_y [in]
+Taylor coefficients corresponding to y for this calculation (not used).
+
+\param partial_x [out]
+Partials with respect to the Taylor coefficients for x.
+For k = order_up , ... , 0 and ell = 0 , ... , k ,
+bar{A}^ell     += bar{C}^k * [ B^{k-ell} ]^T and
+bar{B}^{k-ell} += [ A^ell ]^T * bar{C}^k.
+The transposes are not formed; see the strides in local::gemm_kernel.
+
+\param partial_y [in]
+Partials with respect to the Taylor coefficients for y.
+*/
+template <class Base>
+bool atomic_gemm<Base>::reverse(
+   size_t                        call_id     ,
+   const vector<bool>&           select_x    ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   const vector<Base>&           taylor_y    ,
+   vector<Base>&                 partial_x   ,
+   const vector<Base>&           partial_y   )
+{  //
+   // q
+   size_t q = order_up + 1;
+   //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   CPPAD_ASSERT_UNKNOWN(
+      taylor_x.size() == n_middle * (n_left + n_right) * q
+   );
+   CPPAD_ASSERT_UNKNOWN( partial_x.size() == taylor_x.size() );
+   CPPAD_ASSERT_UNKNOWN( partial_y.size() == n_left * n_right * q );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // need_a, need_b
+   bool need_a = false;
+   for(size_t ik = 0; ik < offset; ++ik)
+      need_a |= select_x[ik];
+   bool need_b = false;
+   for(size_t kj = 0; kj < n_middle * n_right; ++kj)
+      need_b |= select_x[offset + kj];
+   //
+   // partial_x
+   for(size_t i = 0; i < partial_x.size(); ++i)
+      partial_x[i] = Base(0);
+   //
+   // a, b, c, bar_a, bar_b, bar_c
+   const Base* a     = taylor_x.data();
+   const Base* b     = taylor_x.data() + offset * q;
+   const Base* bar_c = partial_y.data();
+   Base*       bar_a = partial_x.data();
+   Base*       bar_b = partial_x.data() + offset * q;
+   //
+   // zero_a, zero_b, zero_c
+   vector<bool> zero_a, zero_b, zero_c;
+   zero_order(n_left,   n_middle, q, a,     zero_a);
+   zero_order(n_middle, n_right,  q, b,     zero_b);
+   zero_order(n_left,   n_right,  q, bar_c, zero_c);
+   //
+   // work
+   vector<Base> work;
+   //
+   size_t k = q;
+   while( k > 0 )
+   {  --k;
+      if( ! zero_c[k] ) for(size_t ell = 0; ell <= k; ++ell)
+      {  //
+         // bar{A}^ell += bar{C}^k * [ B^{k-ell} ]^T
+         if( need_a && ! zero_b[k - ell] ) local::gemm_kernel(
+            n_left, n_right, n_middle,
+            bar_c + k,       n_right * q,  q,
+            b + (k - ell),   q,            n_right * q,
+            bar_a + ell,     n_middle * q, q,
+            work
+         );
+         //
+         // bar{B}^{k-ell} += [ A^ell ]^T * bar{C}^k
+         if( need_b && ! zero_a[ell] ) local::gemm_kernel(
+            n_middle, n_left, n_right,
+            a + ell,         q,            n_middle * q,
+            bar_c + k,       n_right * q,  q,
+            bar_b + (k-ell), n_right * q,  q,
+            work
+         );
+      }
+   }
+   return true;
+}
+
+/*!
+Link from atomic_gemm to AD<Base> reverse mode
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param select_x [in]
+which components of apartial_x are needed.
+
+\param order_up [in]
+highest order for this reverse mode calculation.
+
+\param ataylor_x [in]
+Taylor coefficients corresponding to x for this calculation.
+
+\param ataylor_y [in]
+Taylor coefficients corresponding to y for this calculation (not used).
+
+\param apartial_x [out]
+Partials with respect to the Taylor coefficients for x.
+The products are recorded as calls to this atomic function with
+the transposed matrices.
+
+\param apartial_y [in]
+Partials with respect to the Taylor coefficients for y.
+*/
+template <class Base>
+bool atomic_gemm<Base>::reverse(
+   size_t                        call_id     ,
+   const vector<bool>&           select_x    ,
+   size_t                        order_up    ,
+   const vector< AD<Base> >&     ataylor_x   ,
+   const vector< AD<Base> >&     ataylor_y   ,
+   vector< AD<Base> >&           apartial_x  ,
+   const vector< AD<Base> >&     apartial_y  )
+{  //
+   // q
+   size_t q = order_up + 1;
+   //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   CPPAD_ASSERT_UNKNOWN(
+      ataylor_x.size() == n_middle * (n_left + n_right) * q
+   );
+   CPPAD_ASSERT_UNKNOWN( apartial_x.size() == ataylor_x.size() );
+   CPPAD_ASSERT_UNKNOWN( apartial_y.size() == n_left * n_right * q );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // need_a, need_b
+   bool need_a = false;
+   for(size_t ik = 0; ik < offset; ++ik)
+      need_a |= select_x[ik];
+   bool need_b = false;
+   for(size_t kj = 0; kj < n_middle * n_right; ++kj)
+      need_b |= select_x[offset + kj];
+   //
+   // call_a, call_b
+   // bar{A} = bar{C} * B^T is n_left by n_middle
+   // bar{B} = A^T * bar{C} is n_middle by n_right
+   size_t call_a = set(n_left, n_right, n_middle);
+   size_t call_b = set(n_middle, n_left, n_right);
+   //
+   // apartial_x
+   for(size_t i = 0; i < apartial_x.size(); ++i)
+      apartial_x[i] = AD<Base>(0);
+   //
+   // au, av
+   vector< AD<Base> > au, av;
+   //
+   size_t k = q;
+   while( k > 0 )
+   {  --k;
+      for(size_t ell = 0; ell <= k; ++ell)
+      {  //
+         // bar{A}^ell += bar{C}^k * [ B^{k-ell} ]^T
+         if( need_a )
+         {  au.resize( n_right * (n_left + n_middle) );
+            av.resize( n_left * n_middle );
+            size_t u_offset = n_left * n_right;
+            for(size_t ij = 0; ij < n_left * n_right; ++ij)
+               au[ij] = apartial_y[ij * q + k];
+            for(size_t kk = 0; kk < n_middle; ++kk)
+            {  for(size_t j = 0; j < n_right; ++j)
+               {  size_t kj = kk * n_right + j;
+                  size_t jk = j * n_middle + kk;
+                  au[u_offset + jk] = ataylor_x[(offset + kj) * q + (k - ell)];
+               }
+            }
+            (*this)(call_a, au, av);
+            for(size_t ik = 0; ik < offset; ++ik)
+               apartial_x[ik * q + ell] += av[ik];
+         }
+         //
+         // bar{B}^{k-ell} += [ A^ell ]^T * bar{C}^k
+         if( need_b )
+         {  au.resize( n_left * (n_middle + n_right) );
+            av.resize( n_middle * n_right );
+            size_t u_offset = n_middle * n_left;
+            for(size_t i = 0; i < n_left; ++i)
+            {  for(size_t kk = 0; kk < n_middle; ++kk)
+               {  size_t ik = i * n_middle + kk;
+                  size_t ki = kk * n_left + i;
+                  au[ki] = ataylor_x[ik * q + ell];
+               }
+            }
+            for(size_t ij = 0; ij < n_left * n_right; ++ij)
+               au[u_offset + ij] = apartial_y[ij * q + k];
+            (*this)(call_b, au, av);
+            for(size_t kj = 0; kj < n_middle * n_right; ++kj)
+               apartial_x[(offset + kj) * q + (k - ell)] += av[kj];
+         }
+      }
+   }
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
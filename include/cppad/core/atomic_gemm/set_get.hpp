@@ -0,0 +1,116 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_SET_GET_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_SET_GET_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_gemm/set_get.hpp
+Map between matrix dimensions and call_id for atomic_gemm.
+*/
+
+/*!
+Determine the call_id corresponding to the dimensions of a matrix product.
+
+\param n_left [in]
+is the row dimension of A and C.
+
+\param n_middle [in]
+is the column dimension of A and row dimension of B.
+
+\param n_right [in]
+is the column dimension of B and C.
+
+\return
+is the call_id corresponding to these dimensions.
+If these dimensions have been used before, the previous call_id is returned.
+Otherwise, the dimensions are added to the table.
+*/
+template <class Base>
+size_t atomic_gemm<Base>::set(
+   size_t n_left, size_t n_middle, size_t n_right
+)
+{  dim_type dim = {{ n_left, n_middle, n_right }};
+   std::lock_guard<std::mutex> lock(dim_mutex_);
+   typename std::map<dim_type, size_t>::const_iterator itr;
+   itr = dim_map_.find(dim);
+   if( itr != dim_map_.end() )
+      return itr->second;
+   size_t call_id = dim_vec_.size();
+   dim_vec_.push_back(dim);
+   dim_map_[dim] = call_id;
+   return call_id;
+}
+
+/*!
+Determine the dimensions of a matrix product corresponding to a call_id.
+
+\param call_id [in]
+is a value returned by set.
+
+\param n_left [out]
+is the row dimension of A and C.
+
+\param n_middle [out]
+is the column dimension of A and row dimension of B.
+
+\param n_right [out]
+is the column dimension of B and C.
+*/
+template <class Base>
+void atomic_gemm<Base>::get(
+   size_t call_id, size_t& n_left, size_t& n_middle, size_t& n_right
+) const
+{  std::lock_guard<std::mutex> lock(dim_mutex_);
+   CPPAD_ASSERT_KNOWN( call_id < dim_vec_.size(),
+      "atomic_gemm: call_id was not returned by set for this object"
+   );
+   const dim_type& dim = dim_vec_[call_id];
+   n_left   = dim[0];
+   n_middle = dim[1];
+   n_right  = dim[2];
+   return;
+}
+
+/*!
+Determine which orders of the Taylor coefficients for a matrix are zero.
+
+\param n_row [in]
+is the number of rows in the matrix.
+
+\param n_col [in]
+is the number of columns in the matrix.
+
+\param q [in]
+is the number of Taylor coefficient orders.
+
+\param taylor [in]
+the order ell coefficient for the ( i , j ) element of the matrix is
+taylor[ (i * n_col + j) * q + ell ].
+
+\param zero [out]
+The input size of this vector does not matter.
+Upon return, it has size q and zero[ell] is true if all the
+order ell coefficients are zero.
+*/
+template <class Base>
+void atomic_gemm<Base>::zero_order(
+   size_t           n_row      ,
+   size_t           n_col      ,
+   size_t           q          ,
+   const Base*      taylor     ,
+   vector<bool>&    zero       )
+{  zero.resize(q);
+   for(size_t ell = 0; ell < q; ++ell)
+      zero[ell] = true;
+   for(size_t ij = 0; ij < n_row * n_col; ++ij)
+   {  for(size_t ell = 0; ell < q; ++ell)
+         zero[ell] &= IdenticalZero( taylor[ij * q + ell] );
+   }
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,192 @@
+# ifndef CPPAD_CORE_ATOMIC_GEMM_SPARSITY_HPP
+# define CPPAD_CORE_ATOMIC_GEMM_SPARSITY_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_gemm/sparsity.hpp
+Atomic matrix multiply sparsity and dependency calculations.
+*/
+
+/*!
+Link from atomic_gemm to Jacobian sparsity calculations
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param dependency [in]
+is this a dependency or sparsity calculation (they are the same
+for this function).
+
+\param ident_zero_x [in]
+which components of x are identically zero constant parameters.
+The partial of C(i,j) w.r.t. A(i,k) is B(k,j) and hence it is
+not included if B(k,j) is identically zero (and vice versa).
+
+\param select_x [in]
+which domain components to include in the pattern.
+
+\param select_y [in]
+which range components to include in the pattern.
+
+\param pattern_out [out]
+is the sparsity pattern for Jacobian of y(x) restricted to
+the selected components.
+*/
+template <class Base>
+bool atomic_gemm<Base>::jac_sparsity(
+   size_t                        call_id      ,
+   bool                          dependency   ,
+   const vector<bool>&           ident_zero_x ,
+   const vector<bool>&           select_x     ,
+   const vector<bool>&           select_y     ,
+   sparse_rc< vector<size_t> >&  pattern_out  )
+{  //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   //
+   // n, m
+   size_t n = select_x.size();
+   size_t m = select_y.size();
+   CPPAD_ASSERT_UNKNOWN( n == n_middle * (n_left + n_right) );
+   CPPAD_ASSERT_UNKNOWN( m == n_left * n_right );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // pattern_out
+   // each ( ij , ik ) and ( ij , kj ) pair occurs at most once in this loop
+   pattern_out.resize(m, n, 0);
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  size_t ij = i * n_right + j;               // C(i,j) = y[ij]
+         if( select_y[ij] ) for(size_t k = 0; k < n_middle; ++k)
+         {  size_t ik = i * n_middle + k;          // A(i,k) = x[ik]
+            size_t kj = offset + k * n_right + j;  // B(k,j) = x[kj]
+            if( select_x[ik] && ! ident_zero_x[kj] )
+               pattern_out.push_back(ij, ik);
+            if( select_x[kj] && ! ident_zero_x[ik] )
+               pattern_out.push_back(ij, kj);
+         }
+      }
+   }
+   return true;
+}
+
+/*!
+Link from atomic_gemm to Hessian sparsity calculations
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param ident_zero_x [in]
+which components of x are identically zero constant parameters (not used
+because the only non-zero second partials are between A and B).
+
+\param select_x [in]
+which domain components to include in the pattern.
+
+\param select_y [in]
+which range components to include in the pattern.
+
+\param pattern_out [out]
+is the sparsity pattern for the Hessian of
+sum_{ij} select_y[ij] * y[ij](x) restricted to the selected components.
+*/
+template <class Base>
+bool atomic_gemm<Base>::hes_sparsity(
+   size_t                        call_id      ,
+   const vector<bool>&           ident_zero_x ,
+   const vector<bool>&           select_x     ,
+   const vector<bool>&           select_y     ,
+   sparse_rc< vector<size_t> >&  pattern_out  )
+{  //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   //
+   // n
+   size_t n = select_x.size();
+   CPPAD_ASSERT_UNKNOWN( n == n_middle * (n_left + n_right) );
+   CPPAD_ASSERT_UNKNOWN( select_y.size() == n_left * n_right );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // pattern_out
+   // each ( ik , kj ) pair occurs at most once in this loop
+   pattern_out.resize(n, n, 0);
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  size_t ij = i * n_right + j;               // C(i,j) = y[ij]
+         if( select_y[ij] ) for(size_t k = 0; k < n_middle; ++k)
+         {  size_t ik = i * n_middle + k;          // A(i,k) = x[ik]
+            size_t kj = offset + k * n_right + j;  // B(k,j) = x[kj]
+            if( select_x[ik] && select_x[kj] )
+            {  pattern_out.push_back(ik, kj);
+               pattern_out.push_back(kj, ik);
+            }
+         }
+      }
+   }
+   return true;
+}
+
+/*!
+Link from atomic_gemm to reverse dependency calculations
+
+\param call_id [in]
+encodes the dimensions of this matrix product.
+
+\param ident_zero_x [in]
+which components of x are identically zero constant parameters.
+C(i,j) does not depend on A(i,k) if B(k,j) is identically zero
+(and vice versa).
+
+\param depend_x [out]
+which components of x affect the value of the selected components of y.
+
+\param depend_y [in]
+which components of y are selected.
+*/
+template <class Base>
+bool atomic_gemm<Base>::rev_depend(
+   size_t                        call_id      ,
+   const vector<bool>&           ident_zero_x ,
+   vector<bool>&                 depend_x     ,
+   const vector<bool>&           depend_y     )
+{  //
+   // n_left, n_middle, n_right
+   size_t n_left, n_middle, n_right;
+   get(call_id, n_left, n_middle, n_right);
+   CPPAD_ASSERT_UNKNOWN( depend_x.size() == n_middle * (n_left + n_right) );
+   CPPAD_ASSERT_UNKNOWN( depend_y.size() == n_left * n_right );
+   //
+   // offset
+   size_t offset = n_left * n_middle;
+   //
+   // depend_x
+   for(size_t i = 0; i < depend_x.size(); ++i)
+      depend_x[i] = false;
+   for(size_t i = 0; i < n_left; ++i)
+   {  for(size_t j = 0; j < n_right; ++j)
+      {  size_t ij = i * n_right + j;
+         if( depend_y[ij] ) for(size_t k = 0; k < n_middle; ++k)
+         {  size_t ik = i * n_middle + k;
+            size_t kj = offset + k * n_right + j;
+            if( ! ( ident_zero_x[ik] || ident_zero_x[kj] ) )
+            {  depend_x[ik] = true;
+               depend_x[kj] = true;
+            }
+         }
+      }
+   }
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
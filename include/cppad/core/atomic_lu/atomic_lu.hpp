@@ -0,0 +1,423 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_ATOMIC_LU_HPP
+# define CPPAD_CORE_ATOMIC_LU_ATOMIC_LU_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_lu}
+{xrst_spell
+   lu
+}
+
+Atomic Linear Solve and Log Determinant
+#######################################
+
+Syntax
+******
+| ``atomic_lu`` < *Base* > *lu* ( *name* )
+| *call_id* = *lu* . ``set_solve`` ( *n* , *m* )
+| *call_id* = *lu* . ``set_log_det`` ( *n* )
+| *lu* . ``get`` ( *call_id* , *n* , *m* )
+| *lu* ( *call_id* , *ax* , *ay* )
+
+Purpose
+*******
+Recording the LU factorization of an *n* by *n* matrix using
+``AD`` < *Base* > operations, as is done by :ref:`LuSolve-name`
+and :ref:`det_by_lu-name` ,
+creates order :math:`n^3` scalar operations and the reverse mode sweep
+is just as long.
+The *lu* object records a linear solve, or a log determinant,
+as one atomic operation.
+It factors the matrix once, using partial pivoting,
+and uses the factorization for forward mode of all orders and
+for reverse mode (where it solves with the transpose of the matrix).
+
+Base
+****
+The type *Base* specifies the base type for AD operations;
+i.e., *lu* can be used during the recording of
+``AD`` < *Base* > operations.
+The :ref:`base2ad-name` version of a function that uses *lu*
+cannot be used for forward or reverse mode.
+
+name
+****
+This is the :ref:`atomic_four_ctor@atomic_four@name` for this
+atomic function.
+
+n
+*
+This is the number of rows and columns in the matrix *A* .
+This is an argument (return value) for the ``set`` (``get`` ) routines.
+
+m
+*
+This is the number of columns in the right hand side matrix *B*
+for a linear solve.
+This is an argument (return value) for ``set_solve`` (``get`` ).
+If *call_id* corresponds to a log determinant,
+the return value of *m* from ``get`` is zero.
+
+call_id
+*******
+This is a return value (argument) for the ``set`` (``get`` ) routines.
+Calling ``set_solve`` , or ``set_log_det`` , with the same dimensions
+returns the same *call_id* .
+The table that maps *call_id* to the dimensions is shared by all the
+threads, so a *call_id* returned by one thread can be
+used by any other thread.
+
+Linear Solve
+************
+If *call_id* corresponds to ``set_solve`` ,
+*lu* computes the solution *X* of the equation *A* * *X* = *B* .
+
+ax
+==
+The size of this vector is *n* * *n* + *n* * *m* .
+The matrices *A* and *B* are stored in row major order in *ax* :
+
+   *A* ( *i* , *k* ) = *ax* [ *i* * *n* + *k* ]
+
+   *B* ( *k* , *j* ) = *ax* [ *n* * *n* + *k* * *m* + *j* ]
+
+ay
+==
+The size of this vector is *n* * *m* and its input value does not matter.
+Upon return, the matrix *X* is stored in row major order in *ay* :
+
+   *X* ( *i* , *j* ) = *ay* [ *i* * *m* + *j* ]
+
+Log Determinant
+***************
+If *call_id* corresponds to ``set_log_det`` ,
+*lu* computes the logarithm of the absolute value of the determinant of *A*
+and the sign of the determinant of *A* .
+
+ax
+==
+The size of this vector is *n* * *n* and *A* is stored in row major order;
+i.e., *A* ( *i* , *k* ) = *ax* [ *i* * *n* + *k* ] .
+
+ay
+==
+The size of this vector is two and its input value does not matter.
+Upon return, *ay* [0] is :math:`\log | \det (A) |`
+and *ay* [1] is the sign of :math:`\det(A)`; i.e., minus one, zero, or one.
+The derivative of *ay* [1] with respect to *A* is zero and
+the determinant of *A* is *ay* [1] * ``exp`` ( *ay* [0] ) .
+
+Factorization
+*************
+Each thread has a cache that holds the factorization for the most
+recent values of *A* .
+Forward mode of order zero computes the factorization, and
+higher order forward mode and reverse mode use the factorization
+that is in the cache (if the order zero value of *A* has not changed).
+A linear solve and a log determinant with the same *A*
+(for example, in the same recording) also share the factorization.
+
+Derivatives
+***********
+
+Linear Solve
+============
+For :math:`k = 1, 2, \ldots` ,
+the order *k* Taylor coefficient for *X* is given by
+
+.. math::
+
+   X^{(k)} = [ A^{(0)} ]^{-1} \left(
+      B^{(k)} - \sum_{\ell=1}^k A^{(\ell)} X^{(k-\ell)}
+   \right)
+
+Reverse mode, for order *k* , computes
+:math:`W = [ A^{(0)} ]^{-\R{T}} \bar{X}^{(k)}`
+using the factorization, and then
+
+.. math::
+
+   \bar{B}^{(k)} = \bar{B}^{(k)} + W
+
+.. math::
+
+   \bar{A}^{(\ell)} = \bar{A}^{(\ell)} - W [ X^{(k-\ell)} ]^\R{T}
+   \; , \;
+   \bar{X}^{(k-\ell)} = \bar{X}^{(k-\ell)} - [ A^{(\ell)} ]^\R{T} W
+
+where the update to :math:`\bar{X}^{(k-\ell)}` is only for
+:math:`\ell \geq 1` .
+
+Log Determinant
+===============
+Define :math:`M^{(\ell)} = [ A^{(0)} ]^{-1} A^{(\ell)}`
+and let :math:`N^{(k)}` be the Taylor coefficients of the inverse of
+:math:`M(t)` ; i.e. :math:`N^{(0)} = I` and
+:math:`N^{(k)} = - \sum_{\ell=1}^k M^{(\ell)} N^{(k-\ell)}` .
+For :math:`k = 1, 2, \ldots` , the order *k* Taylor coefficient
+for :math:`L(t) = \log | \det [ A(t) ] |` is given by
+
+.. math::
+
+   L^{(k)} = \frac{1}{k} \sum_{j=0}^{k-1}
+      (j+1) \R{tr} \left[ N^{(k-1-j)} M^{(j+1)} \right]
+
+Reverse mode is the adjoint of these calculations.
+
+Sparsity
+********
+Column *j* of *X* depends on all of *A* and column *j* of *B* .
+If all the elements of column *j* of *B* are identically zero,
+column *j* of *X* is identically zero.
+The log determinant depends on all of *A* .
+
+Contents
+********
+{xrst_toc_table
+   example/atomic_lu/solve.cpp
+   example/atomic_lu/log_det.cpp
+}
+
+{xrst_end atomic_lu}
+*/
+# include <array>
+# include <map>
+# include <mutex>
+# include <vector>
+# include <cppad/local/thread_table.hpp>
+# include <cppad/core/atomic_gemm/kernel.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu.hpp
+Atomic linear solve and log determinant.
+*/
+
+/*!
+Atomic linear solve and log determinant using an LU factorization.
+
+\tparam Base
+is the base type for the AD operations that use this atomic function.
+*/
+template <class Base>
+class atomic_lu : public atomic_four<Base> {
+public:
+   /// constructor
+   atomic_lu(const std::string& name) : atomic_four<Base>(name)
+   { }
+   //
+   // destructor
+   ~atomic_lu(void);
+   //
+   // set_solve
+   size_t set_solve(size_t n, size_t m);
+   //
+   // set_log_det
+   size_t set_log_det(size_t n);
+   //
+   // get
+   void get(size_t call_id, size_t& n, size_t& m) const;
+private:
+   // ------------------------------------------------------------------------
+   // call_id table
+   // ------------------------------------------------------------------------
+   /// dimensions ( n, m ) for one call_id (m is zero for log determinant)
+   typedef std::array<size_t, 2> dim_type;
+   //
+   /// dim_vec_[call_id] is the dimensions corresponding to call_id
+   std::vector<dim_type> dim_vec_;
+   //
+   /// dim_map_[dim] is the call_id corresponding to dimensions dim
+   std::map<dim_type, size_t> dim_map_;
+   //
+   /// mutex that protects dim_vec_ and dim_map_
+   mutable std::mutex dim_mutex_;
+   //
+   // set
+   size_t set(size_t n, size_t m);
+   // ------------------------------------------------------------------------
+   // factorization cache
+   // ------------------------------------------------------------------------
+   /// LU factorization of one matrix
+   struct factor_struct {
+      /// number of rows and columns in the matrix (zero if not in use)
+      size_t         n_;
+      //
+      /// value of the matrix that was factored (row major order)
+      vector<Base>   a_;
+      //
+      /// The LU factorization of the matrix with its rows permuted.
+      /// The diagonal of L is one and is not stored.
+      vector<Base>   lu_;
+      //
+      /// row i of the permuted matrix is row perm_[i] of the matrix
+      vector<size_t> perm_;
+      //
+      /// log of the absolute value of the determinant
+      Base           log_det_;
+      //
+      /// sign of the determinant
+      Base           sign_det_;
+      //
+      /// value of cache_struct::counter_ the last time this entry was used
+      size_t         last_use_;
+      //
+      /// constructor
+      factor_struct(void) : n_(0), last_use_(0)
+      { }
+   };
+   /// factorizations for one thread
+   struct cache_struct {
+      /// the entries in the cache
+      factor_struct  entry_[4];
+      //
+      /// incremented each time the cache is used
+      size_t         counter_;
+      //
+      /// constructor
+      cache_struct(void) : counter_(0)
+      { }
+   };
+   /// use pointers and allocate memory to avoid false sharing
+   /// (initialized to null by its constructor)
+   local::thread_table<cache_struct*> cache_;
+   //
+   // factor
+   const factor_struct& factor(size_t n, size_t q, const Base* taylor_a);
+   //
+   // solve
+   static void solve(
+      const factor_struct&   fac        ,
+      bool                   transpose  ,
+      size_t                 m          ,
+      Base*                  r
+   );
+   //
+   // zero_order
+   static void zero_order(
+      size_t                 n_element  ,
+      size_t                 q          ,
+      const Base*            taylor     ,
+      vector<bool>&          zero
+   );
+   //
+   // forward_solve
+   void forward_solve(
+      size_t                 n          ,
+      size_t                 m          ,
+      size_t                 order_low  ,
+      size_t                 order_up   ,
+      const vector<Base>&    taylor_x   ,
+      vector<Base>&          taylor_y
+   );
+   //
+   // forward_log_det
+   void forward_log_det(
+      size_t                 n          ,
+      size_t                 order_low  ,
+      size_t                 order_up   ,
+      const vector<Base>&    taylor_x   ,
+      vector<Base>&          taylor_y
+   );
+   //
+   // log_det_mn
+   void log_det_mn(
+      const factor_struct&   fac        ,
+      size_t                 q          ,
+      const Base*            taylor_a   ,
+      vector<Base>&          mat_m      ,
+      vector<Base>&          mat_n      ,
+      vector<Base>&          work
+   );
+   //
+   // reverse_solve
+   void reverse_solve(
+      size_t                 n          ,
+      size_t                 m          ,
+      const vector<bool>&    select_x   ,
+      size_t                 order_up   ,
+      const vector<Base>&    taylor_x   ,
+      const vector<Base>&    taylor_y   ,
+      vector<Base>&          partial_x  ,
+      const vector<Base>&    partial_y
+   );
+   //
+   // reverse_log_det
+   void reverse_log_det(
+      size_t                 n          ,
+      size_t                 order_up   ,
+      const vector<Base>&    taylor_x   ,
+      vector<Base>&          partial_x  ,
+      const vector<Base>&    partial_y
+   );
+   // -----------------------------------------------------------------------
+   // atomic_four virtual functions
+   // -----------------------------------------------------------------------
+   // for_type
+   bool for_type(
+      size_t                        call_id     ,
+      const vector<ad_type_enum>&   type_x      ,
+      vector<ad_type_enum>&         type_y
+   ) override;
+   //
+   // forward
+   bool forward(
+      size_t                        call_id     ,
+      const vector<bool>&           select_y    ,
+      size_t                        order_low   ,
+      size_t                        order_up    ,
+      const vector<Base>&           taylor_x    ,
+      vector<Base>&                 taylor_y
+   ) override;
+   //
+   // reverse
+   bool reverse(
+      size_t                        call_id     ,
+      const vector<bool>&           select_x    ,
+      size_t                        order_up    ,
+      const vector<Base>&           taylor_x    ,
+      const vector<Base>&           taylor_y    ,
+      vector<Base>&                 partial_x   ,
+      const vector<Base>&           partial_y
+   ) override;
+   //
+   // jac_sparsity
+   bool jac_sparsity(
+      size_t                        call_id      ,
+      bool                          dependency   ,
+      const vector<bool>&           ident_zero_x ,
+      const vector<bool>&           select_x     ,
+      const vector<bool>&           select_y     ,
+      sparse_rc< vector<size_t> >&  pattern_out
+   ) override;
+   //
+   // hes_sparsity
+   bool hes_sparsity(
+      size_t                        call_id      ,
+      const vector<bool>&           ident_zero_x ,
+      const vector<bool>&           select_x     ,
+      const vector<bool>&           select_y     ,
+      sparse_rc< vector<size_t> >&  pattern_out
+   ) override;
+   //
+   // rev_depend
+   bool rev_depend(
+      size_t                        call_id      ,
+      const vector<bool>&           ident_zero_x ,
+      vector<bool>&                 depend_x     ,
+      const vector<bool>&           depend_y
+   ) override;
+};
+
+} // END_CPPAD_NAMESPACE
+
+# include <cppad/core/atomic_lu/set_get.hpp>
+# include <cppad/core/atomic_lu/factor.hpp>
+# include <cppad/core/atomic_lu/for_type.hpp>
+# include <cppad/core/atomic_lu/forward.hpp>
+# include <cppad/core/atomic_lu/reverse.hpp>
+# include <cppad/core/atomic_lu/sparsity.hpp>
+
+# endif
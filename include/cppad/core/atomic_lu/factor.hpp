@@ -0,0 +1,304 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_FACTOR_HPP
+# define CPPAD_CORE_ATOMIC_LU_FACTOR_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu/factor.hpp
+Factorization cache and solves for atomic_lu.
+*/
+
+/// destructor (frees the factorization cache for every thread)
+template <class Base>
+atomic_lu<Base>::~atomic_lu(void)
+{
+# ifndef NDEBUG
+   if( thread_alloc::in_parallel() )
+   {  std::string msg = atomic_four<Base>::atomic_name();
+      msg += ": atomic_lu destructor called in parallel mode.";
+      CPPAD_ASSERT_KNOWN(false, msg.c_str() );
+   }
+# endif
+   for(size_t thread = 0; thread < cache_.size(); ++thread)
+   {  cache_struct** ptr = cache_.find(thread);
+      if( ptr != nullptr && *ptr != nullptr )
+      {  // call destructor
+         (*ptr)->~cache_struct();
+         // return raw memory to available pool for this thread
+         void* v_ptr = reinterpret_cast<void*>(*ptr);
+         thread_alloc::return_memory(v_ptr);
+         *ptr = nullptr;
+      }
+   }
+}
+
+/*!
+Get the LU factorization of the order zero value of a matrix.
+
+\param n [in]
+is the number of rows and columns in the matrix.
+
+\param q [in]
+is the number of Taylor coefficient orders in taylor_a.
+
+\param taylor_a [in]
+the order zero value of the ( i , k ) element of the matrix is
+taylor_a[ (i * n + k) * q ].
+
+\return
+is the factorization of this matrix.
+If the cache for this thread has a factorization for the same value of
+the matrix, it is returned. Otherwise the least recently used entry
+in the cache is replaced by the factorization of this matrix.
+The return value is valid until the next call to factor by this thread.
+
+\par Method
+The factorization uses partial pivoting, i.e., row exchanges.
+If a pivot is zero, the matrix is singular,
+the log determinant is minus infinity, and the sign is zero.
+*/
+template <class Base>
+const typename atomic_lu<Base>::factor_struct& atomic_lu<Base>::factor(
+   size_t n, size_t q, const Base* taylor_a
+)
+{  //
+   // cache
+   size_t thread = thread_alloc::thread_num();
+   if( cache_[thread] == nullptr )
+   {  // allocate raw memory
+      size_t min_bytes = sizeof(cache_struct);
+      size_t num_bytes;
+      void* v_ptr = thread_alloc::get_memory(min_bytes, num_bytes);
+      // convert to cache_struct*
+      cache_[thread] = reinterpret_cast<cache_struct*>(v_ptr);
+      // call cache_struct constructor
+      new( cache_[thread] ) cache_struct;
+   }
+   cache_struct& cache = *cache_[thread];
+   ++cache.counter_;
+   //
+   // n_entry
+   size_t n_entry = sizeof(cache.entry_) / sizeof(cache.entry_[0]);
+   //
+   // check for this matrix in the cache
+   for(size_t i_entry = 0; i_entry < n_entry; ++i_entry)
+   {  factor_struct& fac = cache.entry_[i_entry];
+      bool match = fac.n_ == n;
+      for(size_t ik = 0; ik < n * n && match; ++ik)
+         match = fac.a_[ik] == taylor_a[ik * q];
+      if( match )
+      {  fac.last_use_ = cache.counter_;
+         return fac;
+      }
+   }
+   //
+   // fac
+   // least recently used entry
+   size_t i_lru = 0;
+   for(size_t i_entry = 1; i_entry < n_entry; ++i_entry)
+   {  if( cache.entry_[i_entry].last_use_ < cache.entry_[i_lru].last_use_ )
+         i_lru = i_entry;
+   }
+   factor_struct& fac = cache.entry_[i_lru];
+   fac.n_        = n;
+   fac.last_use_ = cache.counter_;
+   //
+   // fac.a_, fac.lu_, fac.perm_
+   fac.a_.resize(n * n);
+   fac.lu_.resize(n * n);
+   fac.perm_.resize(n);
+   for(size_t ik = 0; ik < n * n; ++ik)
+      fac.a_[ik] = fac.lu_[ik] = taylor_a[ik * q];
+   for(size_t i = 0; i < n; ++i)
+      fac.perm_[i] = i;
+   //
+   // lu
+   Base* lu = fac.lu_.data();
+   //
+   // sign_det
+   Base sign_det = Base(1);
+   for(size_t k = 0; k < n; ++k)
+   {  // p = row with largest absolute value in column k
+      size_t p = k;
+      for(size_t i = k + 1; i < n; ++i)
+      {  if( ! abs_geq(lu[p * n + k], lu[i * n + k]) )
+            p = i;
+      }
+      if( p != k )
+      {  // exchange rows p and k
+         for(size_t j = 0; j < n; ++j)
+            std::swap(lu[p * n + j], lu[k * n + j]);
+         std::swap(fac.perm_[p], fac.perm_[k]);
+         sign_det = - sign_det;
+      }
+      const Base pivot = lu[k * n + k];
+      if( IdenticalZero(pivot) )
+         sign_det = Base(0);
+      else
+      {  // eliminate column k below the diagonal
+         const Base* lu_k = lu + k * n;
+         for(size_t i = k + 1; i < n; ++i)
+         {  Base* lu_i = lu + i * n;
+            Base  ell  = lu_i[k] / pivot;
+            lu_i[k]    = ell;
+            for(size_t j = k + 1; j < n; ++j)
+               lu_i[j] -= ell * lu_k[j];
+         }
+      }
+   }
+   //
+   // fac.log_det_, fac.sign_det_
+   Base log_det = Base(0);
+   for(size_t k = 0; k < n; ++k)
+   {  const Base& u_kk = lu[k * n + k];
+      log_det  += log( abs(u_kk) );
+      sign_det *= sign(u_kk);
+   }
+   fac.log_det_  = log_det;
+   fac.sign_det_ = sign_det;
+   //
+   return fac;
+}
+
+/*!
+Solve a linear equation using a factorization.
+
+\param fac [in]
+is the factorization of the matrix A.
+
+\param transpose [in]
+If true, solve A^T * X = R, otherwise solve A * X = R.
+
+\param m [in]
+is the number of columns in R.
+
+\param r [in,out]
+is an n by m matrix in row major order where n = fac.n_.
+On input, it is the right hand side R and upon return it is the solution X.
+*/
+template <class Base>
+void atomic_lu<Base>::solve(
+   const factor_struct&   fac        ,
+   bool                   transpose  ,
+   size_t                 m          ,
+   Base*                  r          )
+{  size_t n        = fac.n_;
+   const Base* lu  = fac.lu_.data();
+   //
+   // z
+   vector<Base> z(n * m);
+   if( ! transpose )
+   {  // z = P * R
+      for(size_t i = 0; i < n; ++i)
+      {  const Base* r_i = r + fac.perm_[i] * m;
+         for(size_t j = 0; j < m; ++j)
+            z[i * m + j] = r_i[j];
+      }
+      // z = L^{-1} * z
+      for(size_t i = 1; i < n; ++i)
+      {  Base* z_i = z.data() + i * m;
+         for(size_t k = 0; k < i; ++k)
+         {  const Base  ell = lu[i * n + k];
+            const Base* z_k = z.data() + k * m;
+            for(size_t j = 0; j < m; ++j)
+               z_i[j] -= ell * z_k[j];
+         }
+      }
+      // z = U^{-1} * z
+      size_t i = n;
+      while( i > 0 )
+      {  --i;
+         Base* z_i = z.data() + i * m;
+         for(size_t k = i + 1; k < n; ++k)
+         {  const Base  u_ik = lu[i * n + k];
+            const Base* z_k  = z.data() + k * m;
+            for(size_t j = 0; j < m; ++j)
+               z_i[j] -= u_ik * z_k[j];
+         }
+         const Base u_ii = lu[i * n + i];
+         for(size_t j = 0; j < m; ++j)
+            z_i[j] /= u_ii;
+      }
+      // X = z
+      for(size_t ij = 0; ij < n * m; ++ij)
+         r[ij] = z[ij];
+   }
+   else
+   {  // A^T = U^T * L^T * P
+      for(size_t ij = 0; ij < n * m; ++ij)
+         z[ij] = r[ij];
+      //
+      // z = U^{-T} * z
+      for(size_t i = 0; i < n; ++i)
+      {  Base* z_i = z.data() + i * m;
+         const Base u_ii = lu[i * n + i];
+         for(size_t j = 0; j < m; ++j)
+            z_i[j] /= u_ii;
+         for(size_t k = i + 1; k < n; ++k)
+         {  const Base u_ik = lu[i * n + k];
+            Base*      z_k  = z.data() + k * m;
+            for(size_t j = 0; j < m; ++j)
+               z_k[j] -= u_ik * z_i[j];
+         }
+      }
+      // z = L^{-T} * z
+      size_t i = n;
+      while( i > 0 )
+      {  --i;
+         const Base* z_i = z.data() + i * m;
+         for(size_t k = 0; k < i; ++k)
+         {  const Base ell = lu[i * n + k];
+            Base*      z_k = z.data() + k * m;
+            for(size_t j = 0; j < m; ++j)
+               z_k[j] -= ell * z_i[j];
+         }
+      }
+      // X = P^T * z
+      for(size_t i_row = 0; i_row < n; ++i_row)
+      {  Base* r_i = r + fac.perm_[i_row] * m;
+         for(size_t j = 0; j < m; ++j)
+            r_i[j] = z[i_row * m + j];
+      }
+   }
+   return;
+}
+
+/*!
+Determine which orders of the Taylor coefficients for a matrix are zero.
+
+\param n_element [in]
+is the number of elements in the matrix.
+
+\param q [in]
+is the number of Taylor coefficient orders.
+
+\param taylor [in]
+the order ell coefficient for element ij of the matrix is
+taylor[ ij * q + ell ].
+
+\param zero [out]
+The input size of this vector does not matter.
+Upon return, it has size q and zero[ell] is true if all the
+order ell coefficients are zero.
+*/
+template <class Base>
+void atomic_lu<Base>::zero_order(
+   size_t           n_element  ,
+   size_t           q          ,
+   const Base*      taylor     ,
+   vector<bool>&    zero       )
+{  zero.resize(q);
+   for(size_t ell = 0; ell < q; ++ell)
+      zero[ell] = true;
+   for(size_t ij = 0; ij < n_element; ++ij)
+   {  for(size_t ell = 0; ell < q; ++ell)
+         zero[ell] &= IdenticalZero( taylor[ij * q + ell] );
+   }
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
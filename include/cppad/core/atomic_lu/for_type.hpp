@@ -0,0 +1,76 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_FOR_TYPE_HPP
+# define CPPAD_CORE_ATOMIC_LU_FOR_TYPE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu/for_type.hpp
+Atomic linear solve and log determinant type calculation.
+*/
+
+/*!
+Link from atomic_lu to type calculation
+
+\param call_id [in]
+encodes the dimensions for this call.
+
+\param type_x [in]
+specifies which components of x are
+constants, dynamics, and variables
+
+\param type_y [out]
+specifies which components of y are
+constants, dynamics, and variables.
+For a linear solve, column j of X is identically zero if column j of B
+is identically zero.
+The log determinant and its sign are never identically zero.
+*/
+template <class Base>
+bool atomic_lu<Base>::for_type(
+   size_t                        call_id     ,
+   const vector<ad_type_enum>&   type_x      ,
+   vector<ad_type_enum>&         type_y      )
+{  //
+   // n, m
+   size_t n, m;
+   get(call_id, n, m);
+   //
+   // type_a
+   ad_type_enum type_a = constant_enum;
+   for(size_t ik = 0; ik < n * n; ++ik)
+      type_a = std::max(type_a, type_x[ik]);
+   //
+   if( m == 0 )
+   {  // log determinant
+      CPPAD_ASSERT_UNKNOWN( type_x.size() == n * n );
+      CPPAD_ASSERT_UNKNOWN( type_y.size() == 2 );
+      type_y[0] = type_a;
+      type_y[1] = type_a;
+      return true;
+   }
+   // linear solve
+   CPPAD_ASSERT_UNKNOWN( type_x.size() == n * (n + m) );
+   CPPAD_ASSERT_UNKNOWN( type_y.size() == n * m );
+   //
+   // offset
+   size_t offset = n * n;
+   //
+   // type_y
+   for(size_t j = 0; j < m; ++j)
+   {  // type_j
+      ad_type_enum type_j = identical_zero_enum;
+      for(size_t k = 0; k < n; ++k)
+         type_j = std::max(type_j, type_x[offset + k * m + j]);
+      if( type_j != identical_zero_enum )
+         type_j = std::max(type_j, type_a);
+      for(size_t i = 0; i < n; ++i)
+         type_y[i * m + j] = type_j;
+   }
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,286 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_FORWARD_HPP
+# define CPPAD_CORE_ATOMIC_LU_FORWARD_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu/forward.hpp
+Atomic linear solve and log determinant forward mode.
+*/
+
+/*!
+Forward mode for a linear solve.
+
+\param n [in]
+is the number of rows and columns in A.
+
+\param m [in]
+is the number of columns in B.
+
+\param order_low [in]
+lowest order for this forward mode calculation.
+
+\param order_up [in]
+highest order for this forward mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x = [ A , B ].
+
+\param taylor_y [in,out]
+Taylor coefficients corresponding to y = X.
+The orders less than order_low are inputs.
+For k = order_low , ... , order_up ,
+X^k = [ A^0 ]^{-1} * ( B^k - sum_{ell=1}^k A^ell * X^{k-ell} ).
+*/
+template <class Base>
+void atomic_lu<Base>::forward_solve(
+   size_t                        n           ,
+   size_t                        m           ,
+   size_t                        order_low   ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   vector<Base>&                 taylor_y    )
+{  //
+   // q
+   size_t q = order_up + 1;
+   CPPAD_ASSERT_UNKNOWN( taylor_x.size() == n * (n + m) * q );
+   CPPAD_ASSERT_UNKNOWN( taylor_y.size() == n * m * q );
+   //
+   // a, b, x
+   const Base* a = taylor_x.data();
+   const Base* b = taylor_x.data() + n * n * q;
+   Base*       x = taylor_y.data();
+   //
+   // fac
+   const factor_struct& fac = factor(n, q, a);
+   //
+   // zero_a
+   vector<bool> zero_a;
+   zero_order(n * n, q, a, zero_a);
+   //
+   // r, sum, work
+   vector<Base> r(n * m), sum(n * m), work;
+   //
+   for(size_t k = order_low; k < q; ++k)
+   {  // sum = sum_{ell=1}^k A^ell * X^{k-ell}
+      for(size_t ij = 0; ij < n * m; ++ij)
+         sum[ij] = Base(0);
+      for(size_t ell = 1; ell <= k; ++ell)
+      {  if( ! zero_a[ell] ) local::gemm_kernel(
+            n, n, m,
+            a + ell,       n * q, q,
+            x + (k - ell), m * q, q,
+            sum.data(),    m,     1,
+            work
+         );
+      }
+      // r = B^k - sum
+      for(size_t ij = 0; ij < n * m; ++ij)
+         r[ij] = b[ij * q + k] - sum[ij];
+      //
+      // X^k = [ A^0 ]^{-1} * r
+      solve(fac, false, m, r.data());
+      for(size_t ij = 0; ij < n * m; ++ij)
+         x[ij * q + k] = r[ij];
+   }
+   return;
+}
+
+/*!
+Compute the matrices M and N used by the log determinant derivatives.
+
+\param fac [in]
+is the factorization of A^0.
+
+\param q [in]
+is the number of Taylor coefficient orders in taylor_a.
+
+\param taylor_a [in]
+the order ell coefficient for the ( i , k ) element of A is
+taylor_a[ (i * n + k) * q + ell ] where n = fac.n_.
+
+\param mat_m [out]
+The input size of this vector does not matter.
+Upon return, it has size q * n * n and for ell = 1 , ... , q-1 ,
+M^ell = [ A^0 ]^{-1} * A^ell is stored in row major order starting at
+mat_m[ ell * n * n ]. The M^0 entries are not used.
+
+\param mat_n [out]
+The input size of this vector does not matter.
+Upon return, it has size q * n * n and for k = 0 , ... , q-1 ,
+N^k is stored in row major order starting at mat_n[ k * n * n ] where
+N^0 = I and N^k = - sum_{ell=1}^k M^ell * N^{k-ell}.
+
+\param work [in,out]
+is work space used by local::gemm_kernel.
+*/
+template <class Base>
+void atomic_lu<Base>::log_det_mn(
+   const factor_struct&          fac         ,
+   size_t                        q           ,
+   const Base*                   taylor_a    ,
+   vector<Base>&                 mat_m       ,
+   vector<Base>&                 mat_n       ,
+   vector<Base>&                 work        )
+{  //
+   // n, nn
+   size_t n  = fac.n_;
+   size_t nn = n * n;
+   //
+   // zero_a
+   vector<bool> zero_a;
+   zero_order(nn, q, taylor_a, zero_a);
+   //
+   // mat_m
+   mat_m.resize(q * nn);
+   for(size_t ell = 1; ell < q; ++ell)
+   {  Base* m_ell = mat_m.data() + ell * nn;
+      for(size_t ik = 0; ik < nn; ++ik)
+         m_ell[ik] = taylor_a[ik * q + ell];
+      if( ! zero_a[ell] )
+         solve(fac, false, n, m_ell);
+   }
+   //
+   // mat_n
+   mat_n.resize(q * nn);
+   for(size_t ik = 0; ik < q * nn; ++ik)
+      mat_n[ik] = Base(0);
+   for(size_t i = 0; i < n; ++i)
+      mat_n[i * n + i] = Base(1);
+   for(size_t k = 1; k < q; ++k)
+   {  Base* n_k = mat_n.data() + k * nn;
+      for(size_t ell = 1; ell <= k; ++ell) if( ! zero_a[ell] )
+      {  local::gemm_kernel(
+            n, n, n,
+            mat_m.data() + ell * nn,       n, 1,
+            mat_n.data() + (k - ell) * nn, n, 1,
+            n_k,                           n, 1,
+            work
+         );
+      }
+      for(size_t ik = 0; ik < nn; ++ik)
+         n_k[ik] = - n_k[ik];
+   }
+   return;
+}
+
+/*!
+Forward mode for a log determinant.
+
+\param n [in]
+is the number of rows and columns in A.
+
+\param order_low [in]
+lowest order for this forward mode calculation.
+
+\param order_up [in]
+highest order for this forward mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x = A.
+
+\param taylor_y [out]
+Taylor coefficients corresponding to y = [ L , S ] where
+L is the log of the absolute value of the determinant and S is its sign.
+For k >= 1, S^k is zero and
+L^k = (1/k) sum_{j=0}^{k-1} (j+1) tr( N^{k-1-j} * M^{j+1} );
+see log_det_mn.
+*/
+template <class Base>
+void atomic_lu<Base>::forward_log_det(
+   size_t                        n           ,
+   size_t                        order_low   ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   vector<Base>&                 taylor_y    )
+{  //
+   // q, nn
+   size_t q  = order_up + 1;
+   size_t nn = n * n;
+   CPPAD_ASSERT_UNKNOWN( taylor_x.size() == nn * q );
+   CPPAD_ASSERT_UNKNOWN( taylor_y.size() == 2 * q );
+   //
+   // a
+   const Base* a = taylor_x.data();
+   //
+   // fac
+   const factor_struct& fac = factor(n, q, a);
+   //
+   // taylor_y: order zero
+   if( order_low == 0 )
+   {  taylor_y[0 * q + 0] = fac.log_det_;
+      taylor_y[1 * q + 0] = fac.sign_det_;
+   }
+   if( order_up == 0 )
+      return;
+   //
+   // mat_m, mat_n
+   vector<Base> mat_m, mat_n, work;
+   log_det_mn(fac, q, a, mat_m, mat_n, work);
+   //
+   // taylor_y: orders one and higher
+   for(size_t k = std::max(order_low, size_t(1)); k < q; ++k)
+   {  Base sum = Base(0);
+      for(size_t j = 0; j < k; ++j)
+      {  const Base* n_kj = mat_n.data() + (k - 1 - j) * nn;
+         const Base* m_j  = mat_m.data() + (j + 1) * nn;
+         // trace = tr( N^{k-1-j} * M^{j+1} )
+         Base trace = Base(0);
+         for(size_t i = 0; i < n; ++i)
+         {  for(size_t p = 0; p < n; ++p)
+               trace += n_kj[i * n + p] * m_j[p * n + i];
+         }
+         sum += Base(double(j + 1)) * trace;
+      }
+      taylor_y[0 * q + k] = sum / Base(double(k));
+      taylor_y[1 * q + k] = Base(0);
+   }
+   return;
+}
+
+/*!
+Link from atomic_lu to Base forward mode
+
+\param call_id [in]
+encodes the dimensions for this call.
+
+\param select_y [in]
+which components of taylor_y are needed (not used).
+
+\param order_low [in]
+lowest order for this forward mode calculation.
+
+\param order_up [in]
+highest order for this forward mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x for this calculation.
+
+\param taylor_y [out]
+Taylor coefficients corresponding to y for this calculation.
+*/
+template <class Base>
+bool atomic_lu<Base>::forward(
+   size_t                        call_id     ,
+   const vector<bool>&           select_y    ,
+   size_t                        order_low   ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   vector<Base>&                 taylor_y    )
+{  //
+   // n, m
+   size_t n, m;
+   get(call_id, n, m);
+   //
+   if( m == 0 )
+      forward_log_det(n, order_low, order_up, taylor_x, taylor_y);
+   else
+      forward_solve(n, m, order_low, order_up, taylor_x, taylor_y);
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,344 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_REVERSE_HPP
+# define CPPAD_CORE_ATOMIC_LU_REVERSE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu/reverse.hpp
+Atomic linear solve and log determinant reverse mode.
+*/
+
+/*!
+Reverse mode for a linear solve.
+
+\param n [in]
+is the number of rows and columns in A.
+
+\param m [in]
+is the number of columns in B.
+
+\param select_x [in]
+which components of partial_x are needed.
+If none of the components corresponding to A (B) are needed,
+the partials with respect to A (B) are not computed (are zero).
+
+\param order_up [in]
+highest order for this reverse mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x = [ A , B ].
+
+\param taylor_y [in]
+Taylor coefficients corresponding to y = X.
+
+\param partial_x [out]
+Partials with respect to the Taylor coefficients for x.
+For k = order_up , ... , 0 , W = [ A^0 ]^{-T} * bar{X}^k ,
+bar{B}^k += W and for ell = 0 , ... , k ,
+bar{A}^ell -= W * [ X^{k-ell} ]^T ,
+bar{X}^{k-ell} -= [ A^ell ]^T * W (ell >= 1).
+
+\param partial_y [in]
+Partials with respect to the Taylor coefficients for y.
+*/
+template <class Base>
+void atomic_lu<Base>::reverse_solve(
+   size_t                        n           ,
+   size_t                        m           ,
+   const vector<bool>&           select_x    ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   const vector<Base>&           taylor_y    ,
+   vector<Base>&                 partial_x   ,
+   const vector<Base>&           partial_y   )
+{  //
+   // q, nn, nm
+   size_t q  = order_up + 1;
+   size_t nn = n * n;
+   size_t nm = n * m;
+   CPPAD_ASSERT_UNKNOWN( taylor_x.size() == (nn + nm) * q );
+   CPPAD_ASSERT_UNKNOWN( partial_x.size() == taylor_x.size() );
+   CPPAD_ASSERT_UNKNOWN( partial_y.size() == nm * q );
+   //
+   // need_a, need_b
+   bool need_a = false;
+   for(size_t ik = 0; ik < nn; ++ik)
+      need_a |= select_x[ik];
+   bool need_b = false;
+   for(size_t kj = 0; kj < nm; ++kj)
+      need_b |= select_x[nn + kj];
+   //
+   // partial_x
+   for(size_t i = 0; i < partial_x.size(); ++i)
+      partial_x[i] = Base(0);
+   if( ! (need_a || need_b) )
+      return;
+   //
+   // a, x, bar_a, bar_b
+   const Base* a     = taylor_x.data();
+   const Base* x     = taylor_y.data();
+   Base*       bar_a = partial_x.data();
+   Base*       bar_b = partial_x.data() + nn * q;
+   //
+   // fac
+   const factor_struct& fac = factor(n, q, a);
+   //
+   // zero_a
+   vector<bool> zero_a;
+   zero_order(nn, q, a, zero_a);
+   //
+   // bar_x
+   // bar{X}^k is stored in row major order starting at bar_x[k * nm]
+   vector<Base> bar_x(q * nm);
+   for(size_t ij = 0; ij < nm; ++ij)
+   {  for(size_t k = 0; k < q; ++k)
+         bar_x[k * nm + ij] = partial_y[ij * q + k];
+   }
+   //
+   // w, work
+   vector<Base> w(nm), work;
+   //
+   size_t k = q;
+   while( k > 0 )
+   {  --k;
+      //
+      // w = bar{X}^k
+      bool zero_w = true;
+      for(size_t ij = 0; ij < nm; ++ij)
+      {  w[ij]   = bar_x[k * nm + ij];
+         zero_w &= IdenticalZero( w[ij] );
+      }
+      if( ! zero_w )
+      {  //
+         // w = [ A^0 ]^{-T} * bar{X}^k
+         solve(fac, true, m, w.data());
+         //
+         // bar{B}^k += w
+         if( need_b )
+         {  for(size_t ij = 0; ij < nm; ++ij)
+               bar_b[ij * q + k] += w[ij];
+         }
+         //
+         // w = - [ A^0 ]^{-T} * bar{X}^k
+         for(size_t ij = 0; ij < nm; ++ij)
+            w[ij] = - w[ij];
+         //
+         for(size_t ell = 0; ell <= k; ++ell)
+         {  //
+            // bar{A}^ell += w * [ X^{k-ell} ]^T
+            if( need_a ) local::gemm_kernel(
+               n, m, n,
+               w.data(),      m,     1,
+               x + (k - ell), q,     m * q,
+               bar_a + ell,   n * q, q,
+               work
+            );
+            //
+            // bar{X}^{k-ell} += [ A^ell ]^T * w
+            if( ell > 0 && ! zero_a[ell] ) local::gemm_kernel(
+               n, n, m,
+               a + ell,                     q, n * q,
+               w.data(),                    m, 1,
+               bar_x.data() + (k - ell) * nm, m, 1,
+               work
+            );
+         }
+      }
+   }
+   return;
+}
+
+/*!
+Reverse mode for a log determinant.
+
+\param n [in]
+is the number of rows and columns in A.
+
+\param order_up [in]
+highest order for this reverse mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x = A.
+
+\param partial_x [out]
+Partials with respect to the Taylor coefficients for x.
+This is the adjoint of the calculations in forward_log_det and log_det_mn.
+
+\param partial_y [in]
+Partials with respect to the Taylor coefficients for y = [ L , S ].
+The partials with respect to S are not used because the derivative of S
+is zero.
+*/
+template <class Base>
+void atomic_lu<Base>::reverse_log_det(
+   size_t                        n           ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   vector<Base>&                 partial_x   ,
+   const vector<Base>&           partial_y   )
+{  //
+   // q, nn
+   size_t q  = order_up + 1;
+   size_t nn = n * n;
+   CPPAD_ASSERT_UNKNOWN( taylor_x.size() == nn * q );
+   CPPAD_ASSERT_UNKNOWN( partial_x.size() == nn * q );
+   CPPAD_ASSERT_UNKNOWN( partial_y.size() == 2 * q );
+   //
+   // partial_x
+   for(size_t i = 0; i < partial_x.size(); ++i)
+      partial_x[i] = Base(0);
+   //
+   // a, bar_a, bar_l
+   const Base* a     = taylor_x.data();
+   Base*       bar_a = partial_x.data();
+   const Base* bar_l = partial_y.data();
+   //
+   // fac
+   const factor_struct& fac = factor(n, q, a);
+   //
+   // g, work
+   vector<Base> g(nn), work;
+   //
+   // bar{A}^0 += bar{L}^0 * [ A^0 ]^{-T}
+   if( ! IdenticalZero( bar_l[0] ) )
+   {  for(size_t ik = 0; ik < nn; ++ik)
+         g[ik] = Base(0);
+      for(size_t i = 0; i < n; ++i)
+         g[i * n + i] = Base(1);
+      solve(fac, true, n, g.data());
+      for(size_t ik = 0; ik < nn; ++ik)
+         bar_a[ik * q] += bar_l[0] * g[ik];
+   }
+   if( q == 1 )
+      return;
+   //
+   // mat_m, mat_n
+   vector<Base> mat_m, mat_n;
+   log_det_mn(fac, q, a, mat_m, mat_n, work);
+   //
+   // bar_m, bar_n
+   vector<Base> bar_m(q * nn), bar_n(q * nn);
+   for(size_t ik = 0; ik < q * nn; ++ik)
+   {  bar_m[ik] = Base(0);
+      bar_n[ik] = Base(0);
+   }
+   //
+   // adjoint of L^k = (1/k) sum_{j=0}^{k-1} (j+1) tr( N^{k-1-j} * M^{j+1} )
+   for(size_t k = 1; k < q; ++k) if( ! IdenticalZero( bar_l[k] ) )
+   {  Base c = bar_l[k] / Base(double(k));
+      for(size_t j = 0; j < k; ++j)
+      {  Base coef = c * Base(double(j + 1));
+         const Base* n_kj     = mat_n.data() + (k - 1 - j) * nn;
+         const Base* m_j      = mat_m.data() + (j + 1) * nn;
+         Base*       bar_n_kj = bar_n.data() + (k - 1 - j) * nn;
+         Base*       bar_m_j  = bar_m.data() + (j + 1) * nn;
+         for(size_t i = 0; i < n; ++i)
+         {  for(size_t p = 0; p < n; ++p)
+            {  bar_n_kj[i * n + p] += coef * m_j[p * n + i];
+               bar_m_j[p * n + i]  += coef * n_kj[i * n + p];
+            }
+         }
+      }
+   }
+   //
+   // adjoint of N^k = - sum_{ell=1}^k M^ell * N^{k-ell}
+   for(size_t k = q - 1; k > 0; --k)
+   {  // g = - bar{N}^k
+      for(size_t ik = 0; ik < nn; ++ik)
+         g[ik] = - bar_n[k * nn + ik];
+      for(size_t ell = 1; ell <= k; ++ell)
+      {  // bar{M}^ell += g * [ N^{k-ell} ]^T
+         local::gemm_kernel(
+            n, n, n,
+            g.data(),                      n, 1,
+            mat_n.data() + (k - ell) * nn, 1, n,
+            bar_m.data() + ell * nn,       n, 1,
+            work
+         );
+         // bar{N}^{k-ell} += [ M^ell ]^T * g
+         local::gemm_kernel(
+            n, n, n,
+            mat_m.data() + ell * nn,       1, n,
+            g.data(),                      n, 1,
+            bar_n.data() + (k - ell) * nn, n, 1,
+            work
+         );
+      }
+   }
+   //
+   // adjoint of M^ell = [ A^0 ]^{-1} * A^ell
+   for(size_t ell = 1; ell < q; ++ell)
+   {  // g = [ A^0 ]^{-T} * bar{M}^ell
+      for(size_t ik = 0; ik < nn; ++ik)
+         g[ik] = bar_m[ell * nn + ik];
+      solve(fac, true, n, g.data());
+      //
+      // bar{A}^ell += g
+      for(size_t ik = 0; ik < nn; ++ik)
+         bar_a[ik * q + ell] += g[ik];
+      //
+      // bar{A}^0 -= g * [ M^ell ]^T
+      for(size_t ik = 0; ik < nn; ++ik)
+         g[ik] = - g[ik];
+      local::gemm_kernel(
+         n, n, n,
+         g.data(),                n,     1,
+         mat_m.data() + ell * nn, 1,     n,
+         bar_a,                   n * q, q,
+         work
+      );
+   }
+   return;
+}
+
+/*!
+Link from atomic_lu to Base reverse mode
+
+\param call_id [in]
+encodes the dimensions for this call.
+
+\param select_x [in]
+which components of partial_x are needed.
+
+\param order_up [in]
+highest order for this reverse mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients corresponding to x for this calculation.
+
+\param taylor_y [in]
+Taylor coefficients corresponding to y for this calculation.
+
+\param partial_x [out]
+Partials with respect to the Taylor coefficients for x.
+
+\param partial_y [in]
+Partials with respect to the Taylor coefficients for y.
+*/
+template <class Base>
+bool atomic_lu<Base>::reverse(
+   size_t                        call_id     ,
+   const vector<bool>&           select_x    ,
+   size_t                        order_up    ,
+   const vector<Base>&           taylor_x    ,
+   const vector<Base>&           taylor_y    ,
+   vector<Base>&                 partial_x   ,
+   const vector<Base>&           partial_y   )
+{  //
+   // n, m
+   size_t n, m;
+   get(call_id, n, m);
+   //
+   if( m == 0 )
+      reverse_log_det(n, order_up, taylor_x, partial_x, partial_y);
+   else reverse_solve(
+      n, m, select_x, order_up, taylor_x, taylor_y, partial_x, partial_y
+   );
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,84 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_SET_GET_HPP
+# define CPPAD_CORE_ATOMIC_LU_SET_GET_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu/set_get.hpp
+Map between dimensions and call_id for atomic_lu.
+*/
+
+/*!
+Determine the call_id corresponding to dimensions.
+
+\param n [in]
+is the number of rows and columns in A.
+
+\param m [in]
+is the number of columns in B for a linear solve,
+or zero for a log determinant.
+
+\return
+is the call_id corresponding to these dimensions.
+If these dimensions have been used before, the previous call_id is returned.
+Otherwise, the dimensions are added to the table.
+*/
+template <class Base>
+size_t atomic_lu<Base>::set(size_t n, size_t m)
+{  dim_type dim = {{ n, m }};
+   std::lock_guard<std::mutex> lock(dim_mutex_);
+   typename std::map<dim_type, size_t>::const_iterator itr;
+   itr = dim_map_.find(dim);
+   if( itr != dim_map_.end() )
+      return itr->second;
+   size_t call_id = dim_vec_.size();
+   dim_vec_.push_back(dim);
+   dim_map_[dim] = call_id;
+   return call_id;
+}
+
+/// call_id for the linear solve A * X = B where A is n by n and B is n by m
+template <class Base>
+size_t atomic_lu<Base>::set_solve(size_t n, size_t m)
+{  CPPAD_ASSERT_KNOWN( m > 0,
+      "atomic_lu::set_solve: the number of columns in B is zero"
+   );
+   return set(n, m);
+}
+
+/// call_id for the log determinant of A where A is n by n
+template <class Base>
+size_t atomic_lu<Base>::set_log_det(size_t n)
+{  return set(n, 0);
+}
+
+/*!
+Determine the dimensions corresponding to a call_id.
+
+\param call_id [in]
+is a value returned by set_solve or set_log_det.
+
+\param n [out]
+is the number of rows and columns in A.
+
+\param m [out]
+is the number of columns in B for a linear solve,
+or zero for a log determinant.
+*/
+template <class Base>
+void atomic_lu<Base>::get(size_t call_id, size_t& n, size_t& m) const
+{  std::lock_guard<std::mutex> lock(dim_mutex_);
+   CPPAD_ASSERT_KNOWN( call_id < dim_vec_.size(),
+      "atomic_lu: call_id was not returned by set for this object"
+   );
+   const dim_type& dim = dim_vec_[call_id];
+   n = dim[0];
+   m = dim[1];
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
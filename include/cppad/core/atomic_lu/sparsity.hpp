@@ -0,0 +1,245 @@
+# ifndef CPPAD_CORE_ATOMIC_LU_SPARSITY_HPP
+# define CPPAD_CORE_ATOMIC_LU_SPARSITY_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file atomic_lu/sparsity.hpp
+Atomic linear solve and log determinant sparsity and dependency calculations.
+*/
+
+/*!
+Link from atomic_lu to Jacobian sparsity calculations
+
+\param call_id [in]
+encodes the dimensions for this call.
+
+\param dependency [in]
+is this a dependency or sparsity calculation.
+The sign of the determinant has a zero derivative,
+but its value depends on A.
+
+\param ident_zero_x [in]
+which components of x are identically zero constant parameters.
+If column j of B is identically zero, so is column j of X.
+
+\param select_x [in]
+which domain components to include in the pattern.
+
+\param select_y [in]
+which range components to include in the pattern.
+
+\param pattern_out [out]
+is the sparsity pattern for Jacobian of y(x) restricted to
+the selected components.
+*/
+template <class Base>
+bool atomic_lu<Base>::jac_sparsity(
+   size_t                        call_id      ,
+   bool                          dependency   ,
+   const vector<bool>&           ident_zero_x ,
+   const vector<bool>&           select_x     ,
+   const vector<bool>&           select_y     ,
+   sparse_rc< vector<size_t> >&  pattern_out  )
+{  //
+   // n, m
+   size_t n, m;
+   get(call_id, n, m);
+   //
+   // nn, nx, ny
+   size_t nn = n * n;
+   size_t nx = select_x.size();
+   size_t ny = select_y.size();
+   //
+   pattern_out.resize(ny, nx, 0);
+   if( m == 0 )
+   {  // log determinant
+      CPPAD_ASSERT_UNKNOWN( nx == nn && ny == 2 );
+      for(size_t i = 0; i < 2; ++i)
+      {  if( select_y[i] && (i == 0 || dependency) )
+         {  for(size_t ik = 0; ik < nn; ++ik) if( select_x[ik] )
+               pattern_out.push_back(i, ik);
+         }
+      }
+      return true;
+   }
+   // linear solve
+   CPPAD_ASSERT_UNKNOWN( nx == n * (n + m) && ny == n * m );
+   for(size_t j = 0; j < m; ++j)
+   {  // zero_j
+      bool zero_j = true;
+      for(size_t k = 0; k < n; ++k)
+         zero_j &= ident_zero_x[nn + k * m + j];
+      if( ! zero_j ) for(size_t i = 0; i < n; ++i)
+      {  size_t ij = i * m + j;                   // X(i,j) = y[ij]
+         if( select_y[ij] )
+         {  for(size_t ik = 0; ik < nn; ++ik)     // A(i,k) = x[ik]
+            {  if( select_x[ik] )
+                  pattern_out.push_back(ij, ik);
+            }
+            for(size_t k = 0; k < n; ++k)
+            {  size_t kj = nn + k * m + j;        // B(k,j) = x[kj]
+               if( select_x[kj] )
+                  pattern_out.push_back(ij, kj);
+            }
+         }
+      }
+   }
+   return true;
+}
+
+/*!
+Link from atomic_lu to Hessian sparsity calculations
+
+\param call_id [in]
+encodes the dimensions for this call.
+
+\param ident_zero_x [in]
+which components of x are identically zero constant parameters.
+If column j of B is identically zero, so is column j of X.
+
+\param select_x [in]
+which domain components to include in the pattern.
+
+\param select_y [in]
+which range components to include in the pattern.
+
+\param pattern_out [out]
+is the sparsity pattern for the Hessian of
+sum_i select_y[i] * y[i](x) restricted to the selected components.
+The solution X is non-linear in A and bi-linear in A and B.
+The log determinant is non-linear in A.
+*/
+template <class Base>
+bool atomic_lu<Base>::hes_sparsity(
+   size_t                        call_id      ,
+   const vector<bool>&           ident_zero_x ,
+   const vector<bool>&           select_x     ,
+   const vector<bool>&           select_y     ,
+   sparse_rc< vector<size_t> >&  pattern_out  )
+{  //
+   // n, m
+   size_t n, m;
+   get(call_id, n, m);
+   //
+   // nn, nx
+   size_t nn = n * n;
+   size_t nx = select_x.size();
+   //
+   // select_a
+   // is the Hessian with respect to A non-zero
+   bool select_a = false;
+   //
+   // select_col
+   // is the Hessian of sum_i select_y[i * m + j] * X(i,j) non-zero
+   vector<bool> select_col(m);
+   //
+   if( m == 0 )
+   {  // log determinant
+      CPPAD_ASSERT_UNKNOWN( nx == nn && select_y.size() == 2 );
+      select_a = select_y[0];
+   }
+   else
+   {  // linear solve
+      CPPAD_ASSERT_UNKNOWN( nx == n * (n + m) && select_y.size() == n * m );
+      for(size_t j = 0; j < m; ++j)
+      {  bool zero_j = true;
+         for(size_t k = 0; k < n; ++k)
+            zero_j &= ident_zero_x[nn + k * m + j];
+         select_col[j] = false;
+         if( ! zero_j ) for(size_t i = 0; i < n; ++i)
+            select_col[j] |= select_y[i * m + j];
+         select_a |= select_col[j];
+      }
+   }
+   //
+   // pattern_out
+   // each pair occurs at most once in these loops
+   pattern_out.resize(nx, nx, 0);
+   if( select_a )
+   {  for(size_t ik = 0; ik < nn; ++ik) if( select_x[ik] )
+      {  for(size_t pq = 0; pq < nn; ++pq) if( select_x[pq] )
+            pattern_out.push_back(ik, pq);
+      }
+   }
+   for(size_t j = 0; j < m; ++j) if( select_col[j] )
+   {  for(size_t k = 0; k < n; ++k)
+      {  size_t kj = nn + k * m + j;
+         if( select_x[kj] ) for(size_t ik = 0; ik < nn; ++ik)
+         {  if( select_x[ik] )
+            {  pattern_out.push_back(ik, kj);
+               pattern_out.push_back(kj, ik);
+            }
+         }
+      }
+   }
+   return true;
+}
+
+/*!
+Link from atomic_lu to reverse dependency calculations
+
+\param call_id [in]
+encodes the dimensions for this call.
+
+\param ident_zero_x [in]
+which components of x are identically zero constant parameters.
+If column j of B is identically zero, so is column j of X.
+
+\param depend_x [out]
+which components of x affect the value of the selected components of y.
+
+\param depend_y [in]
+which components of y are selected.
+*/
+template <class Base>
+bool atomic_lu<Base>::rev_depend(
+   size_t                        call_id      ,
+   const vector<bool>&           ident_zero_x ,
+   vector<bool>&                 depend_x     ,
+   const vector<bool>&           depend_y     )
+{  //
+   // n, m
+   size_t n, m;
+   get(call_id, n, m);
+   //
+   // nn
+   size_t nn = n * n;
+   //
+   // depend_x
+   for(size_t i = 0; i < depend_x.size(); ++i)
+      depend_x[i] = false;
+   //
+   if( m == 0 )
+   {  // log determinant
+      CPPAD_ASSERT_UNKNOWN( depend_x.size() == nn && depend_y.size() == 2 );
+      bool depend_a = depend_y[0] || depend_y[1];
+      for(size_t ik = 0; ik < nn; ++ik)
+         depend_x[ik] = depend_a;
+      return true;
+   }
+   // linear solve
+   CPPAD_ASSERT_UNKNOWN( depend_x.size() == n * (n + m) );
+   CPPAD_ASSERT_UNKNOWN( depend_y.size() == n * m );
+   bool depend_a = false;
+   for(size_t j = 0; j < m; ++j)
+   {  bool zero_j = true;
+      for(size_t k = 0; k < n; ++k)
+         zero_j &= ident_zero_x[nn + k * m + j];
+      bool depend_j = false;
+      if( ! zero_j ) for(size_t i = 0; i < n; ++i)
+         depend_j |= depend_y[i * m + j];
+      for(size_t k = 0; k < n; ++k)
+         depend_x[nn + k * m + j] = depend_j;
+      depend_a |= depend_j;
+   }
+   for(size_t ik = 0; ik < nn; ++ik)
+      depend_x[ik] = depend_a;
+   return true;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
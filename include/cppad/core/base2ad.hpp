@@ -2,7 +2,7 @@
 # define CPPAD_CORE_BASE2AD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin base2ad}
@@ -77,10 +77,14 @@ ADFun< AD<Base>, RecBase > ADFun<Base,RecBase>::base2ad(void) const
    fun.has_been_optimized_        = has_been_optimized_;
    fun.check_for_nan_             = check_for_nan_;
    //
+   // string values
+   fun.optimize_options_          = optimize_options_;
+   //
    // size_t values
    fun.compare_change_count_      = compare_change_count_;
    fun.compare_change_number_     = compare_change_number_;
    fun.compare_change_op_index_   = compare_change_op_index_;
+   fun.num_skip_op_               = num_skip_op_;
    CPPAD_ASSERT_UNKNOWN( fun.num_order_taylor_ == 0 ) ;
    CPPAD_ASSERT_UNKNOWN( fun.cap_order_taylor_ == 0 );
    CPPAD_ASSERT_UNKNOWN( fun.num_direction_taylor_ == 0 );
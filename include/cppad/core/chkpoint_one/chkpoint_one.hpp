@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_ONE_CHKPOINT_ONE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/sparse/list_setvec.hpp>
 # include <cppad/local/sparse/pack_setvec.hpp>
@@ -283,7 +283,8 @@ private:
    member_struct const_member_;
 
    /// use pointers and allocate memory to avoid false sharing
-   member_struct* member_[CPPAD_MAX_NUM_THREADS];
+   /// (initialized to null by its constructor)
+   local::thread_table<member_struct*> member_;
    //
    /// allocate member_ for this thread
    void allocate_member(size_t thread)
@@ -407,7 +408,7 @@ public:
          CPPAD_ASSERT_KNOWN(false, msg.c_str() );
       }
 # endif
-      for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+      for(size_t thread = 0; thread < member_.size(); ++thread)
          free_member(thread);
    }
    // ------------------------------------------------------------------------
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_ONE_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
@@ -25,9 +25,6 @@ checkpoint<Base>::checkpoint(
       CPPAD_ASSERT_KNOWN(false, msg.c_str() );
    }
 # endif
-   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
-      member_[thread] = nullptr;
-   //
    CheckSimpleVector< CppAD::AD<Base> , ADVector>();
    //
    // make a copy of ax because Independent modifies AD information
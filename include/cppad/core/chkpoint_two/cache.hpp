@@ -0,0 +1,325 @@
+# ifndef CPPAD_CORE_CHKPOINT_TWO_CACHE_HPP
+# define CPPAD_CORE_CHKPOINT_TWO_CACHE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin chkpoint_two_cache}
+{xrst_spell
+   chk
+}
+
+Caching Forward Mode Results in Checkpoint Functions
+####################################################
+
+Syntax
+******
+*chk_fun* . ``cache`` ( *max_entry* , *max_bytes* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+During a reverse mode sweep, each use of *chk_fun* in the recording
+needs the forward mode results for the corresponding argument values.
+By default, these results are recomputed because only the most
+recent forward mode results are stored in *chk_fun* ; see
+:ref:`chkpoint_two@Repeating Forward` .
+The ``cache`` member function specifies that the forward mode results
+for the most recent argument values should be saved so that a
+forward sweep, followed by a reverse sweep, evaluates *g* ( *x* )
+only once for each use of *chk_fun* .
+The cache also makes it possible to compute the next order Taylor
+coefficients for an argument value without recomputing the lower orders.
+
+chk_fun
+*******
+This object must have been created using the
+:ref:`chkpoint_two<chkpoint_two_ctor@chk_fun>` constructor.
+
+max_entry
+*********
+This is the maximum number of argument values
+for which forward mode results are saved.
+If the cache is full, the results that were least recently used
+are removed to make room for new results.
+If *max_entry* is zero, no forward mode results are saved.
+This is the default and uses the least memory.
+
+max_bytes
+*********
+This is the maximum number of bytes used to save forward mode results.
+The number of bytes for one argument value is approximately
+
+   ( *g* . ``size_var`` () + *n* + *m* ) * ( *q* + 1 ) * ``sizeof`` ( *Base* )
+
+where *g* is the function :ref:`chkpoint_two_ctor@fun` ,
+*n* is its domain size, *m* is its range size,
+and *q* is the highest order Taylor coefficient being computed.
+Results that would require more than *max_bytes* are not saved.
+If *max_bytes* is zero, no forward mode results are saved.
+
+AD Operations
+*************
+The cache is only used for ``Base`` forward and reverse mode;
+i.e., not when *chk_fun* is used in a
+:ref:`base2ad-name` version of a function.
+
+Multi-Threading
+***************
+This routine cannot be called in :ref:`parallel<ta_in_parallel-name>` mode.
+If *chk_fun* is used in parallel mode, each thread has a separate cache
+and the limits *max_entry* and *max_bytes* apply to each thread.
+
+Memory
+******
+Each call to ``cache`` frees the memory for the cache of all the threads.
+In addition, calling :ref:`chkpoint_two_dynamic-name`
+removes all the results in the cache for the current thread.
+
+Example
+*******
+The file :ref:`chkpoint_two_cache.cpp-name` contains an example and test
+of this operation.
+
+{xrst_toc_hidden
+   example/chkpoint_two/cache.cpp
+}
+
+{xrst_end chkpoint_two_cache}
+*/
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file chkpoint_two/cache.hpp
+Cache forward mode results in a checkpoint function.
+*/
+
+/*!
+Set the limits for the forward mode cache (and free the current cache).
+
+\param max_entry
+is the maximum number of entries in the cache for each thread.
+
+\param max_bytes
+is the maximum number of bytes in the cache for each thread.
+*/
+// BEGIN_PROTOTYPE
+template <class Base>
+void chkpoint_two<Base>::cache(size_t max_entry, size_t max_bytes)
+// END_PROTOTYPE
+{  CPPAD_ASSERT_KNOWN(
+      ! thread_alloc::in_parallel() ,
+      "chkpoint_two: cache cannot be called in parallel mode."
+   );
+   cache_.entry_.clear();
+   cache_.n_byte_ = 0;
+   for(size_t thread = 0; thread < member_.size(); ++thread)
+   {  member_struct** ptr = member_.find(thread);
+      if( ptr != nullptr && *ptr != nullptr )
+      {  (*ptr)->cache_.entry_.clear();
+         (*ptr)->cache_.n_byte_ = 0;
+      }
+   }
+   cache_max_entry_ = max_entry;
+   cache_max_bytes_ = max_bytes;
+}
+/*!
+Remove the least recently used entries until there is room for more bytes.
+
+\param cache
+is the cache for the current thread.
+
+\param n_byte
+is the number of bytes that are being added to the cache.
+
+\param keep
+If this is nullptr, a new entry is being added to the cache and there must
+also be room for one more entry.
+Otherwise, the bytes are being added to this entry and it is not removed.
+
+\return
+is true if there is room for the new bytes (and entry).
+*/
+template <class Base>
+bool chkpoint_two<Base>::cache_make_room(
+   cache_struct&      cache    ,
+   size_t             n_byte   ,
+   const cache_entry* keep     )
+{  if( cache_max_bytes_ < n_byte )
+      return false;
+   //
+   size_t n_entry = 0;
+   for(size_t i = 0; i < cache.entry_.size(); ++i)
+      if( cache.entry_[i].n_byte_ != 0 )
+         ++n_entry;
+   //
+   while( cache_max_bytes_ - n_byte < cache.n_byte_ ||
+      ( keep == nullptr && cache_max_entry_ <= n_entry ) )
+   {  // least recently used entry that is not keep
+      cache_entry* lru = nullptr;
+      for(size_t i = 0; i < cache.entry_.size(); ++i)
+      {  cache_entry* entry = &cache.entry_[i];
+         if( entry->n_byte_ != 0 && entry != keep )
+         {  if( lru == nullptr || entry->last_use_ < lru->last_use_ )
+               lru = entry;
+         }
+      }
+      if( lru == nullptr )
+         return false;
+      //
+      // remove lru
+      cache.n_byte_ -= lru->n_byte_;
+      lru->n_byte_   = 0;
+      lru->g_.capacity_order(0);
+      lru->taylor_x_.clear();
+      lru->taylor_y_.clear();
+      --n_entry;
+   }
+   return true;
+}
+/*!
+Compute forward mode results using the cache.
+
+\param g_ptr
+is the function object for the current thread.
+If the results cannot be saved in the cache, they are computed
+using this object.
+
+\param cache
+is the cache for the current thread.
+
+\param order_up
+is the highest order Taylor coefficient being computed.
+
+\param taylor_x
+is the x Taylor coefficients for orders zero through order_up.
+
+\param taylor_y [out]
+is the y Taylor coefficients for orders zero through order_up.
+
+\return
+is the function object that contains the corresponding Taylor coefficients
+(either a copy of g_ in the cache or g_ptr).
+*/
+template <class Base>
+ADFun<Base>* chkpoint_two<Base>::cache_forward(
+   ADFun<Base>*         g_ptr      ,
+   cache_struct&        cache      ,
+   size_t               order_up   ,
+   const vector<Base>&  taylor_x   ,
+   vector<Base>&        taylor_y   )
+{  size_t n = g_ptr->Domain();
+   size_t m = g_ptr->Range();
+   CPPAD_ASSERT_UNKNOWN( taylor_x.size() == n * (order_up + 1) );
+   //
+   // cache is not being used
+   if( cache_max_entry_ == 0 || cache_max_bytes_ == 0 )
+   {  taylor_y = g_ptr->Forward(order_up, taylor_x);
+      return g_ptr;
+   }
+   if( cache.entry_.size() == 0 )
+      cache.entry_.resize(cache_max_entry_);
+   ++cache.counter_;
+   //
+   // number of bytes for an entry with this order
+   size_t n_var  = g_ptr->size_var();
+   size_t n_byte = (n_var + n + m) * (order_up + 1) * sizeof(Base);
+   //
+   // match: entry with the most orders that agrees with taylor_x
+   cache_entry* match = nullptr;
+   size_t       match_order = 0;
+   for(size_t i = 0; i < cache.entry_.size(); ++i)
+   {  cache_entry& entry( cache.entry_[i] );
+      if( entry.n_byte_ != 0 )
+      {  size_t q      = std::min(entry.order_up_, order_up);
+         size_t stride = entry.order_up_ + 1;
+         bool   equal  = true;
+         for(size_t j = 0; j < n && equal; ++j)
+         {  for(size_t k = 0; k <= q && equal; ++k)
+               equal = entry.taylor_x_[j * stride + k]
+                  == taylor_x[j * (order_up + 1) + k];
+         }
+         if( equal && ( match == nullptr || match_order < q ) )
+         {  match       = &entry;
+            match_order = q;
+         }
+      }
+   }
+   //
+   // case where the results are in the cache
+   if( match != nullptr && match_order == order_up )
+   {  size_t stride = match->order_up_ + 1;
+      taylor_y.resize( m * (order_up + 1) );
+      for(size_t i = 0; i < m; ++i)
+         for(size_t k = 0; k <= order_up; ++k)
+            taylor_y[i * (order_up + 1) + k] =
+               match->taylor_y_[i * stride + k];
+      match->last_use_ = cache.counter_;
+      return &(match->g_);
+   }
+   //
+   // case where higher orders are added to an entry
+   if( match != nullptr )
+   {  CPPAD_ASSERT_UNKNOWN( match->order_up_ < order_up );
+      if( ! cache_make_room(cache, n_byte - match->n_byte_, match) )
+         match = nullptr;
+   }
+   if( match != nullptr )
+   {  size_t stride = match->order_up_ + 1;
+      vector<Base> x_p(n), y_p(m);
+      taylor_y.resize( m * (order_up + 1) );
+      for(size_t i = 0; i < m; ++i)
+         for(size_t k = 0; k <= match->order_up_; ++k)
+            taylor_y[i * (order_up + 1) + k] =
+               match->taylor_y_[i * stride + k];
+      for(size_t p = match->order_up_ + 1; p <= order_up; ++p)
+      {  for(size_t j = 0; j < n; ++j)
+            x_p[j] = taylor_x[j * (order_up + 1) + p];
+         y_p = match->g_.Forward(p, x_p);
+         for(size_t i = 0; i < m; ++i)
+            taylor_y[i * (order_up + 1) + p] = y_p[i];
+      }
+      cache.n_byte_     += n_byte - match->n_byte_;
+      match->n_byte_     = n_byte;
+      match->order_up_   = order_up;
+      match->taylor_x_   = taylor_x;
+      match->taylor_y_   = taylor_y;
+      match->last_use_   = cache.counter_;
+      return &(match->g_);
+   }
+   //
+   // case where the results cannot be saved
+   if( ! cache_make_room(cache, n_byte, nullptr) )
+   {  taylor_y = g_ptr->Forward(order_up, taylor_x);
+      return g_ptr;
+   }
+   //
+   // case where a new entry is added to the cache
+   cache_entry* entry = nullptr;
+   for(size_t i = 0; i < cache.entry_.size() && entry == nullptr; ++i)
+      if( cache.entry_[i].n_byte_ == 0 )
+         entry = &cache.entry_[i];
+   CPPAD_ASSERT_UNKNOWN( entry != nullptr );
+   if( entry->g_.size_var() == 0 )
+   {  // only the recording is needed in the copy of g_ptr
+      entry->g_ = *g_ptr;
+      entry->g_.capacity_order(0);
+   }
+   taylor_y = entry->g_.Forward(order_up, taylor_x);
+   cache.n_byte_    += n_byte;
+   entry->n_byte_    = n_byte;
+   entry->order_up_  = order_up;
+   entry->taylor_x_  = taylor_x;
+   entry->taylor_y_  = taylor_y;
+   entry->last_use_  = cache.counter_;
+   return &(entry->g_);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
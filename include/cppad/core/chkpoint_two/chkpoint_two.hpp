@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_CHKPOINT_TWO_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
@@ -38,6 +38,10 @@ new_dynamic
 ===========
 *chk_fun* . ``new_dynamic`` ( *dynamic* )
 
+cache
+=====
+*chk_fun* . ``cache`` ( *max_entry* , *max_bytes* )
+
 Reduce Memory
 *************
 You can reduce the size of the tape and memory required for AD
@@ -60,6 +64,9 @@ because the same checkpoint function may be used repeatedly
 with different arguments during a single forward mode operation.
 Thus, forward mode results are computed for each use of *chk_fun*
 in a forward mode sweep.
+In addition, reverse mode recomputes the forward mode results for
+each use of *chk_fun* unless they are saved using
+:ref:`chkpoint_two_cache-name` .
 
 Operation Sequence
 ******************
@@ -93,6 +100,7 @@ Contents
    include/cppad/core/chkpoint_two/ctor.hpp
    include/cppad/core/chkpoint_two/chk_fun.xrst
    include/cppad/core/chkpoint_two/dynamic.hpp
+   include/cppad/core/chkpoint_two/cache.hpp
    example/chkpoint_two/get_started.cpp
    example/chkpoint_two/compare.cpp
    example/chkpoint_two/base2ad.cpp
@@ -135,10 +143,79 @@ private:
    /// If use_in_parallel_, this is constant after the constructor.
    ADFun< AD<Base>, Base>  ag_;
    // ------------------------------------------------------------------------
+   // forward mode cache
+   // ------------------------------------------------------------------------
+   /// maximum number of entries in the cache for each thread
+   size_t cache_max_entry_;
+   //
+   /// maximum number of bytes in the cache for each thread
+   size_t cache_max_bytes_;
+   //
+   /// forward mode results for one argument value
+   struct cache_entry {
+      /// copy of g_ that holds the Taylor coefficients for this entry
+      /// (the recording is shared with g_)
+      ADFun<Base>    g_;
+      //
+      /// x Taylor coefficients for this entry, orders 0 through order_up_
+      vector<Base>   taylor_x_;
+      //
+      /// y Taylor coefficients for this entry, orders 0 through order_up_
+      vector<Base>   taylor_y_;
+      //
+      /// highest order Taylor coefficient in this entry
+      size_t         order_up_;
+      //
+      /// number of bytes for this entry (zero if the entry is not in use)
+      size_t         n_byte_;
+      //
+      /// value of cache_struct::counter_ the last time this entry was used
+      size_t         last_use_;
+      //
+      /// constructor
+      cache_entry(void) : order_up_(0), n_byte_(0), last_use_(0)
+      { }
+   };
+   /// forward mode results for one thread
+   struct cache_struct {
+      /// the entries; size is zero or cache_max_entry_
+      vector<cache_entry> entry_;
+      //
+      /// total number of bytes in the entries that are in use
+      size_t              n_byte_;
+      //
+      /// incremented each time the cache is used
+      size_t              counter_;
+      //
+      /// constructor
+      cache_struct(void) : n_byte_(0), counter_(0)
+      { }
+   };
+   /// cache used when use_in_parallel_ is false
+   cache_struct cache_;
+   //
+   // cache_make_room
+   bool cache_make_room(
+      cache_struct&      cache    ,
+      size_t             n_byte   ,
+      const cache_entry* keep
+   );
+   //
+   // cache_forward
+   ADFun<Base>* cache_forward(
+      ADFun<Base>*         g_ptr      ,
+      cache_struct&        cache      ,
+      size_t               order_up   ,
+      const vector<Base>&  taylor_x   ,
+      vector<Base>&        taylor_y
+   );
+   // ------------------------------------------------------------------------
    // member_
    // ------------------------------------------------------------------------
    /// If use_in_parallel_ is true, must have a separate copy member data
-   /// that is not constant.
+   /// that is not constant. The operation sequence in these copies is shared
+   /// with g_ and ag_ (see player_shared). Only the values of the dynamic
+   /// parameters and the Taylor coefficients are separate for each thread.
    struct member_struct {
       //
       /// function corresponding to this checkpoint object
@@ -147,10 +224,12 @@ private:
       /// AD version of this function object
       ADFun< AD<Base>, Base >     ag_;
       //
+      /// forward mode cache for this thread
+      cache_struct                cache_;
    };
    /// use pointers and allocate memory to avoid false sharing
-   /// (initialized to null by constructor)
-   member_struct* member_[CPPAD_MAX_NUM_THREADS];
+   /// (initialized to null by its constructor)
+   local::thread_table<member_struct*> member_;
    //
    // ------------------------------------------------------------------------
    /// allocate member_ for this thread
@@ -166,7 +245,8 @@ private:
          // call member_struct constructor
          new( member_[thread] ) member_struct;
          //
-         // The thread has a copy of corresponding information.
+         // The thread has a copy of corresponding information
+         // (the recordings are shared, not copied).
          member_[thread]->g_  = g_;
          member_[thread]->ag_ = ag_;
       }
@@ -288,7 +368,9 @@ public:
    use_base2ad_      ( other.use_base2ad_ ) ,
    use_in_parallel_  ( other.use_in_parallel_ ) ,
    jac_sparsity_     ( other.jac_sparsity_ ) ,
-   hes_sparsity_     ( other.hes_sparsity_ )
+   hes_sparsity_     ( other.hes_sparsity_ ) ,
+   cache_max_entry_  ( other.cache_max_entry_ ) ,
+   cache_max_bytes_  ( other.cache_max_bytes_ )
    {  g_  = other.g_;
       ag_ = other.ag_;
    }
@@ -296,12 +378,16 @@ public:
    // new_dynamic
    template <class BaseVector>
    void new_dynamic(const BaseVector& dynamic);
+   //
+   // cache
+   void cache(size_t max_entry, size_t max_bytes);
 };
 
 } // END_CPPAD_NAMESPACE
 
 # include <cppad/core/chkpoint_two/ctor.hpp>
 # include <cppad/core/chkpoint_two/dynamic.hpp>
+# include <cppad/core/chkpoint_two/cache.hpp>
 # include <cppad/core/chkpoint_two/for_type.hpp>
 # include <cppad/core/chkpoint_two/forward.hpp>
 # include <cppad/core/chkpoint_two/reverse.hpp>
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin chkpoint_two_ctor}
@@ -130,15 +130,13 @@ atomic_three<Base>(name)              ,
 internal_bool_( internal_bool )       ,
 use_hes_sparsity_( use_hes_sparsity ) ,
 use_base2ad_ ( use_base2ad )          ,
-use_in_parallel_ ( use_in_parallel )
+use_in_parallel_ ( use_in_parallel )  ,
+cache_max_entry_ ( 0 )                ,
+cache_max_bytes_ ( 0 )
 {  CPPAD_ASSERT_KNOWN(
       ! thread_alloc::in_parallel() ,
       "chkpoint_two: constructor cannot be called in parallel mode."
    );
-   // initialize member pointers as null;
-   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
-      member_[thread] = nullptr;
-   //
    // g_
    g_ = fun;
    //
@@ -207,6 +205,15 @@ use_in_parallel_ ( use_in_parallel )
       g_.size_forward_bool(0);
    else
       g_.size_forward_set(0);
+   //
+   // If use_in_parallel, g_ and ag_ are only used as the source for the
+   // copies in member_. Free their Taylor coefficients so the copies
+   // only contain the recording (which they share with g_ and ag_).
+   if( use_in_parallel )
+   {  g_.capacity_order(0);
+      if( use_base2ad )
+         ag_.capacity_order(0);
+   }
 }
 /// destructor
 template <class Base>
@@ -219,7 +226,7 @@ chkpoint_two<Base>::~chkpoint_two(void)
       CPPAD_ASSERT_KNOWN(false, msg.c_str() );
    }
 # endif
-   for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+   for(size_t thread = 0; thread < member_.size(); ++thread)
       free_member(thread);
    }
 } // END_CPPAD_NAMESPACE
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_DYNAMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin chkpoint_two_dynamic}
@@ -58,6 +58,11 @@ there is a separate copy of *fun* for each thread.
 In this case, only the dynamic parameters in the copy for the current
 :ref:`thread number<ta_thread_num-name>` are changed.
 
+Cache
+*****
+The forward mode results in the :ref:`chkpoint_two_cache-name`
+for the current thread are removed.
+
 {xrst_end chkpoint_two_dynamic}
 */
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
@@ -82,11 +87,13 @@ template <class Base>
 template <class BaseVector>
 void chkpoint_two<Base>::new_dynamic(const BaseVector& dynamic)
 // END_PROTOTYPE
-{  ADFun<Base>* g_ptr = &g_;
+{  ADFun<Base>*  g_ptr     = &g_;
+   cache_struct* cache_ptr = &cache_;
    if( use_in_parallel_ )
    {  size_t thread = thread_alloc::thread_num();
       allocate_member(thread);
-      g_ptr = &(member_[thread]->g_);
+      g_ptr     = &(member_[thread]->g_);
+      cache_ptr = &(member_[thread]->cache_);
    }
 # ifndef NDEBUG
    else if( thread_alloc::in_parallel() )
@@ -96,6 +103,21 @@ void chkpoint_two<Base>::new_dynamic(const BaseVector& dynamic)
    }
 # endif
    g_ptr->new_dynamic(dynamic);
+   //
+   // remove the results in the cache (they used the previous dynamic
+   // parameters) and change the dynamic parameters in its copies of g
+   for(size_t i = 0; i < cache_ptr->entry_.size(); ++i)
+   {  cache_entry& entry( cache_ptr->entry_[i] );
+      if( entry.n_byte_ != 0 )
+      {  entry.n_byte_ = 0;
+         entry.g_.capacity_order(0);
+         entry.taylor_x_.clear();
+         entry.taylor_y_.clear();
+      }
+      if( entry.g_.size_var() != 0 )
+         entry.g_.new_dynamic(dynamic);
+   }
+   cache_ptr->n_byte_ = 0;
 }
 
 } // END_CPPAD_NAMESPACE
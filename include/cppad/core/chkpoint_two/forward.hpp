@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_FORWARD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -44,11 +44,13 @@ bool chkpoint_two<Base>::forward(
    size_t                       order_up    ,
    const vector<Base>&          taylor_x    ,
    vector<Base>&                taylor_y    )
-{  ADFun<Base>* g_ptr = &g_;
+{  ADFun<Base>*  g_ptr     = &g_;
+   cache_struct* cache_ptr = &cache_;
    if( use_in_parallel_ )
    {  size_t thread = thread_alloc::thread_num();
       allocate_member(thread);
-      g_ptr = &(member_[thread]->g_);
+      g_ptr     = &(member_[thread]->g_);
+      cache_ptr = &(member_[thread]->cache_);
    }
 # ifndef NDEBUG
    else if( thread_alloc::in_parallel() )
@@ -58,7 +60,7 @@ bool chkpoint_two<Base>::forward(
    }
 # endif
    // compute forward mode results for all values and orders
-   taylor_y = g_ptr->Forward(order_up, taylor_x);
+   cache_forward(g_ptr, *cache_ptr, order_up, taylor_x, taylor_y);
    //
    return true;
 }
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_REVERSE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -45,11 +45,13 @@ bool chkpoint_two<Base>::reverse(
    vector<Base>&               partial_x     ,
    const vector<Base>&         partial_y     )
 
-{  ADFun<Base>* g_ptr = &g_;
+{  ADFun<Base>*  g_ptr     = &g_;
+   cache_struct* cache_ptr = &cache_;
    if( use_in_parallel_ )
    {  size_t thread = thread_alloc::thread_num();
       allocate_member(thread);
-      g_ptr = &(member_[thread]->g_);
+      g_ptr     = &(member_[thread]->g_);
+      cache_ptr = &(member_[thread]->cache_);
    }
 # ifndef NDEBUG
    else if( thread_alloc::in_parallel() )
@@ -59,16 +61,17 @@ bool chkpoint_two<Base>::reverse(
    }
 # endif
    // compute forward mode Taylor coefficient orders 0 through order_up
-# ifdef NDEBUG
-   g_ptr->Forward(order_up, taylor_x);
-# else
-   vector<Base> check = g_ptr->Forward(order_up, taylor_x);
+   // (f_ptr is the function that contains these coefficients)
+   vector<Base> check;
+   ADFun<Base>* f_ptr =
+      cache_forward(g_ptr, *cache_ptr, order_up, taylor_x, check);
+# ifndef NDEBUG
    CPPAD_ASSERT_UNKNOWN( taylor_y.size() == check.size() )
    for(size_t i = 0; i < taylor_y.size(); ++i)
       CPPAD_ASSERT_UNKNOWN( taylor_y[i] == check[i] );
 # endif
    // now can run reverse mode
-   partial_x = g_ptr->Reverse(order_up+1, partial_y);
+   partial_x = f_ptr->Reverse(order_up+1, partial_y);
    //
    return true;
 }
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CON_DYN_VAR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 ---------------------------------------------------------------------------
@@ -96,7 +96,7 @@ namespace CppAD {
       if( x.tape_id_ == 0 )
          return true;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
    }
    //
@@ -106,7 +106,7 @@ namespace CppAD {
       if( x.tape_id_ == 0 )
          return true;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
    }
    // -----------------------------------------------------------------------
@@ -117,7 +117,7 @@ namespace CppAD {
       if( (x.tape_id_ == 0) | (x.ad_type_ != dynamic_enum) )
          return false;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
    }
    //
@@ -127,7 +127,7 @@ namespace CppAD {
       if( (x.tape_id_ == 0) | (x.ad_type_ != dynamic_enum) )
          return false;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
    }
    // -----------------------------------------------------------------------
@@ -138,7 +138,7 @@ namespace CppAD {
       if( (x.tape_id_ == 0) | (x.ad_type_ == dynamic_enum) )
          return true;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
    }
    //
@@ -148,7 +148,7 @@ namespace CppAD {
       if( (x.tape_id_ == 0) | (x.ad_type_ == dynamic_enum) )
          return true;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ != *AD<Base>::tape_id_ptr(thread);
    }
    // -----------------------------------------------------------------------
@@ -159,7 +159,7 @@ namespace CppAD {
       if( (x.tape_id_ == 0) | (x.ad_type_ != variable_enum) )
          return false;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
    }
    //
@@ -169,7 +169,7 @@ namespace CppAD {
       if( (x.tape_id_ == 0) | (x.ad_type_ != variable_enum) )
          return false;
       //
-      size_t thread = size_t(x.tape_id_ % CPPAD_MAX_NUM_THREADS);
+      size_t thread = size_t(x.tape_id_ % CPPAD_THREAD_LIMIT);
       return x.tape_id_ == *AD<Base>::tape_id_ptr(thread);
    }
 }
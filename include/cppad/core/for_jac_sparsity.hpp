@@ -2,7 +2,7 @@
 # define CPPAD_CORE_FOR_JAC_SPARSITY_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin for_jac_sparsity}
@@ -16,6 +16,10 @@ Syntax
 | *f* . ``for_jac_sparsity`` (
 | |tab| *pattern_in* , *transpose* , *dependency* , *internal_bool* , *pattern_out*
 | )
+| *f* . ``for_jac_sparsity`` (
+| |tab| *pattern_in* , *transpose* , *dependency* , *internal_bool* , *pattern_out* ,
+| |tab| *num_thread*
+| )
 
 Purpose
 *******
@@ -147,6 +151,36 @@ If *dependency* is true, *pattern_out* is a
 :ref:`dependency.cpp@Dependency Pattern`
 instead of sparsity pattern.
 
+num_thread
+**********
+This argument has prototype
+
+   ``size_t`` *num_thread*
+
+If it is not present, its value is one.
+If *num_thread* is greater than one,
+the columns of :math:`R` are split into *num_thread* blocks
+(or fewer if :math:`\ell` is less than *num_thread* ).
+The sparsity pattern corresponding to each block is computed
+by a separate ``std::thread`` and then the results are merged into
+*pattern_out* and the sparsity patterns stored in *f* .
+The columns of :math:`R` are independent, so the result is the same
+as when *num_thread* is one.
+
+#. The threads are started and joined during this call.
+   While they are running, :ref:`thread_alloc-name` is in
+   :ref:`parallel mode<ta_in_parallel-name>` .
+#. If the user has set up multi-threading using
+   :ref:`ta_parallel_setup-name` ; i.e.,
+   :ref:`thread_alloc::num_threads()<ta_num_threads-name>` is not one,
+   the computation is done using only the current thread.
+#. The value *num_thread* must be less than or equal
+   :ref:`multi_thread@CPPAD_THREAD_LIMIT` .
+#. If *f* contains :ref:`atomic functions<atomic-name>` ,
+   their Jacobian sparsity calculations must support parallel execution.
+#. On some systems, a program that uses this option must be linked with
+   the system thread library; e.g., using the ``-pthread`` flag.
+
 Sparsity for Entire Jacobian
 ****************************
 Suppose that
@@ -163,12 +197,14 @@ Example
 The file
 :ref:`for_jac_sparsity.cpp-name`
 contains an example and test of this operation.
+It also checks that using *num_thread* equal to two gives the same result.
 
 {xrst_end for_jac_sparsity}
 -----------------------------------------------------------------------------
 */
 # include <cppad/core/ad_fun.hpp>
 # include <cppad/local/sparse/internal.hpp>
+# include <cppad/local/sweep/for_jac_block.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 
@@ -208,6 +244,11 @@ the return value is a sparsity pattern for J(x) ( J(x)^T ) where
 \f]
 Here F is the function corresponding to the operation sequence
 and x is any argument value.
+
+\param num_thread
+is the maximum number of threads used for the calculation.
+If it is greater than one, the columns of R are split into blocks
+that are computed by separate threads.
 */
 template <class Base, class RecBase>
 template <class SizeVector>
@@ -216,7 +257,8 @@ void ADFun<Base,RecBase>::for_jac_sparsity(
    bool                         transpose        ,
    bool                         dependency       ,
    bool                         internal_bool    ,
-   sparse_rc<SizeVector>&       pattern_out      )
+   sparse_rc<SizeVector>&       pattern_out      ,
+   size_t                       num_thread       )
 {
    // used to identify the RecBase type in calls to sweeps
    RecBase not_used_rec_base(0.0);
@@ -235,9 +277,65 @@ void ADFun<Base,RecBase>::for_jac_sparsity(
       "for_jac_sparsity: number rows in R "
       "is not equal number of independent variables."
    );
+   CPPAD_ASSERT_KNOWN(
+      num_thread <= CPPAD_THREAD_LIMIT ,
+      "for_jac_sparsity: num_thread is greater than CPPAD_THREAD_LIMIT"
+   );
+   //
+   // num_block
+   size_t num_block = std::min(num_thread, ell);
+   if( ! local::std_thread_team::available() )
+      num_block = 1;
+   //
    bool zero_empty  = true;
    bool input_empty = true;
-   if( internal_bool )
+   if( internal_bool && num_block > 1 )
+   {  // allocate memory for bool sparsity calculation
+      for_jac_sparse_pack_.resize(num_var_tape_, ell);
+      for_jac_sparse_set_.resize(0, 0);
+      //
+      // compute sparsity for all variables, one block of columns per thread
+      local::sweep::for_jac_block<addr_t>(
+         &play_,
+         dependency,
+         n,
+         num_var_tape_,
+         transpose,
+         ind_taddr_,
+         pattern_in,
+         num_block,
+         for_jac_sparse_pack_,
+         not_used_rec_base
+      );
+      // set the output pattern
+      local::sparse::get_internal_pattern(
+         transpose, dep_taddr_, for_jac_sparse_pack_, pattern_out
+      );
+   }
+   else if( num_block > 1 )
+   {  // allocate memory for set sparsity calculation
+      for_jac_sparse_set_.resize(num_var_tape_, ell);
+      for_jac_sparse_pack_.resize(0, 0);
+      //
+      // compute sparsity for all variables, one block of columns per thread
+      local::sweep::for_jac_block<addr_t>(
+         &play_,
+         dependency,
+         n,
+         num_var_tape_,
+         transpose,
+         ind_taddr_,
+         pattern_in,
+         num_block,
+         for_jac_sparse_set_,
+         not_used_rec_base
+      );
+      // get the ouput pattern
+      local::sparse::get_internal_pattern(
+         transpose, dep_taddr_, for_jac_sparse_set_, pattern_out
+      );
+   }
+   else if( internal_bool )
    {  // allocate memory for bool sparsity calculation
       // (sparsity pattern is emtpy after a resize)
       for_jac_sparse_pack_.resize(num_var_tape_, ell);
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_FORWARD_FORWARD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // documened after Forward but included here so easy to see
@@ -189,7 +189,7 @@ BaseVector ADFun<Base,RecBase>::Forward(
    {
       local::sweep::forward0(&play_, s, true,
          n, num_var_tape_, C,
-         taylor_.data(), cskip_op_.data(), load_op2var_,
+         taylor_.data(), cskip_op_.data(), num_skip_op_, load_op2var_,
          compare_change_count_,
          compare_change_number_,
          compare_change_op_index_,
@@ -199,7 +199,7 @@ BaseVector ADFun<Base,RecBase>::Forward(
    else
    {  local::sweep::forward1(&play_, s, true, p, q,
          n, num_var_tape_, C,
-         taylor_.data(), cskip_op_.data(), load_op2var_,
+         taylor_.data(), cskip_op_.data(), num_skip_op_, load_op2var_,
          compare_change_count_,
          compare_change_number_,
          compare_change_op_index_,
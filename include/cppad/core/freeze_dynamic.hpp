@@ -0,0 +1,191 @@
+# ifndef CPPAD_CORE_FREEZE_DYNAMIC_HPP
+# define CPPAD_CORE_FREEZE_DYNAMIC_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin freeze_dynamic}
+
+Freeze Dynamic Parameters at Their Current Values
+#################################################
+
+Syntax
+******
+| *f* . ``freeze_dynamic`` ( *frozen* )
+| *f* . ``freeze_dynamic`` ( *frozen* , *options* )
+
+Purpose
+*******
+Sometimes a :ref:`dynamic parameter<glossary@Parameter@Dynamic>`
+does not change for the lifetime of an application.
+This routine replaces the selected independent dynamic parameters by
+constants equal to their current values,
+and then :ref:`optimizes<optimize-name>` *f* .
+The dependent dynamic parameters that only depend on frozen
+dynamic parameters and constants also become constants
+and are removed from the dynamic parameter operation sequence.
+In addition, the optimization folds the constants into the operators
+that use them; e.g., a :ref:`CondExp-name` whose comparison only depends
+on constants is replaced by the branch that it selects,
+and the variables only used by the other branch are removed from *f* .
+This is faster than recording *f* again with the frozen values
+as constants.
+
+f
+*
+The object *f* has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+frozen
+******
+This argument has prototype
+
+   ``const`` *BoolVector* & *frozen*
+
+and its size is equal to :ref:`f.size_dyn_ind()<fun_property@size_dyn_ind>` .
+If *frozen* [ *j* ] is true, the *j*-th independent dynamic parameter
+is replaced by a constant equal to its value in the previous call to
+:ref:`new_dynamic-name` (or its value during the recording of *f*
+if ``new_dynamic`` has not been called).
+
+options
+*******
+This argument has prototype
+
+   ``const std::string&`` *options*
+
+and is the same as the *options* argument to :ref:`optimize-name` .
+The ``val_graph`` option is not supported by this routine.
+The default value for *options* is the empty string.
+
+Independent Dynamic Parameters
+******************************
+The number of independent dynamic parameters, and their order,
+are not changed by this routine.
+Hence the size of the vector passed to ``new_dynamic`` is the same as before
+and the values in that vector corresponding to frozen dynamic parameters
+are ignored.
+
+BoolVector
+**********
+The type *BoolVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``bool`` .
+
+Taylor Coefficients
+*******************
+Any Taylor coefficients in the function object are lost; i.e.,
+:ref:`f.size_order()<size_order-name>` after this operation is zero.
+
+Example
+*******
+{xrst_toc_hidden
+   example/optimize/freeze_dynamic.cpp
+}
+The file
+:ref:`freeze_dynamic.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end freeze_dynamic}
+-----------------------------------------------------------------------------
+*/
+# include <cppad/core/optimize.hpp>
+/*!
+\file freeze_dynamic.hpp
+Replace selected dynamic parameters by constants and optimize.
+*/
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+Replace selected dynamic parameters by constants and optimize.
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type
+Base.
+
+\tparam BoolVector
+is a simple vector with elements of type bool.
+
+\param frozen
+has size equal to the number of independent dynamic parameters.
+If frozen[j] is true, the j-th independent dynamic parameter is
+replaced by a constant equal to its current value.
+
+\param options
+is the options argument passed to optimize.
+*/
+template <class Base, class RecBase>
+template <class BoolVector>
+void ADFun<Base,RecBase>::freeze_dynamic(
+   const BoolVector&  frozen  ,
+   const std::string& options )
+{  //
+   // check BoolVector is Simple Vector class with bool elements
+   CheckSimpleVector<bool, BoolVector>();
+   //
+   // n_ind_dyn
+   size_t n_ind_dyn = play_.num_dynamic_ind();
+   CPPAD_ASSERT_KNOWN(
+      size_t( frozen.size() ) == n_ind_dyn,
+      "f.freeze_dynamic: frozen.size() is not equal f.size_dyn_ind()"
+   );
+   CPPAD_ASSERT_KNOWN(
+      options.find("val_graph") == std::string::npos,
+      "f.freeze_dynamic: the val_graph option is not supported"
+   );
+   //
+   // frozen_pod
+   local::pod_vector<bool> frozen_pod(n_ind_dyn);
+   for(size_t j = 0; j < n_ind_dyn; ++j)
+      frozen_pod[j] = frozen[j];
+   //
+   // n_ind_var
+   size_t n_ind_var = ind_taddr_.size();
+   //
+   // rec
+   // a recording where the uses of the frozen dynamic parameters,
+   // and the dynamic parameters that only depend on them, are constants
+   local::recorder<Base> rec;
+   switch( play_.address_type() )
+   {
+      case local::play::unsigned_short_enum:
+      local::optimize::optimize_run<unsigned short>(
+         options, n_ind_var, frozen_pod, dep_taddr_, &play_, &rec
+      );
+      break;
+
+      case local::play::unsigned_int_enum:
+      local::optimize::optimize_run<unsigned int>(
+         options, n_ind_var, frozen_pod, dep_taddr_, &play_, &rec
+      );
+      break;
+
+      case local::play::size_t_enum:
+      local::optimize::optimize_run<size_t>(
+         options, n_ind_var, frozen_pod, dep_taddr_, &play_, &rec
+      );
+      break;
+
+      default:
+      CPPAD_ASSERT_UNKNOWN(false);
+   }
+   play_.get_recording(rec, n_ind_var);
+   num_var_tape_ = play_.num_var_rec();
+   //
+   // The Taylor coefficients do not correspond to the new recording
+   taylor_.clear();
+   num_order_taylor_ = 0;
+   cap_order_taylor_ = 0;
+   //
+   // The optimization above treats the new constants as dynamic parameters.
+   // Optimizing again folds them into the operators that use them.
+   has_been_optimized_ = false;
+   optimize(options);
+   //
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
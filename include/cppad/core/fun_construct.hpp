@@ -2,7 +2,7 @@
 # define CPPAD_CORE_FUN_CONSTRUCT_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin fun_construct}
@@ -247,11 +247,13 @@ template <class Base, class RecBase>
 ADFun<Base,RecBase>::ADFun(void) :
 function_name_(""),
 exceed_collision_limit_(false),
+optimize_match_count_(0),
 has_been_optimized_(false),
 check_for_nan_(true) ,
 compare_change_count_(0),
 compare_change_number_(0),
 compare_change_op_index_(0),
+num_skip_op_(0),
 num_order_taylor_(0),
 cap_order_taylor_(0),
 num_direction_taylor_(0),
@@ -294,6 +296,7 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
    //
    // string objects
    function_name_             = f.function_name_;
+   optimize_options_          = f.optimize_options_;
    //
    // bool objects
    exceed_collision_limit_    = f.exceed_collision_limit_;
@@ -301,9 +304,11 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
    check_for_nan_             = f.check_for_nan_;
    //
    // size_t objects
+   optimize_match_count_      = f.optimize_match_count_;
    compare_change_count_      = f.compare_change_count_;
    compare_change_number_     = f.compare_change_number_;
    compare_change_op_index_   = f.compare_change_op_index_;
+   num_skip_op_               = f.num_skip_op_;
    num_order_taylor_          = f.num_order_taylor_;
    cap_order_taylor_          = f.cap_order_taylor_;
    num_direction_taylor_      = f.num_direction_taylor_;
@@ -338,6 +343,7 @@ void ADFun<Base,RecBase>::swap(ADFun& f)
 {
    // string objects
    function_name_.swap( f.function_name_ );
+   optimize_options_.swap( f.optimize_options_ );
    //
    // bool objects
    std::swap( exceed_collision_limit_    , f.exceed_collision_limit_);
@@ -345,9 +351,11 @@ void ADFun<Base,RecBase>::swap(ADFun& f)
    std::swap( check_for_nan_             , f.check_for_nan_);
    //
    // size_t objects
+   std::swap( optimize_match_count_      , f.optimize_match_count_);
    std::swap( compare_change_count_      , f.compare_change_count_);
    std::swap( compare_change_number_     , f.compare_change_number_);
    std::swap( compare_change_op_index_   , f.compare_change_op_index_);
+   std::swap( num_skip_op_               , f.num_skip_op_);
    std::swap( num_order_taylor_          , f.num_order_taylor_);
    std::swap( cap_order_taylor_          , f.cap_order_taylor_);
    std::swap( num_direction_taylor_      , f.num_direction_taylor_);
@@ -460,6 +468,7 @@ ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y)
 
    // This function has not yet been optimized
    exceed_collision_limit_    = false;
+   optimize_match_count_      = 0;
 
    // ad_fun.hpp member values not set by dependent
    check_for_nan_       = true;
@@ -486,7 +495,7 @@ ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y)
    CPPAD_ASSERT_UNKNOWN( load_op2var_.size()  == play_.num_var_load_rec() );
    local::sweep::forward0(&play_, std::cout, false,
       n, num_var_tape_, cap_order_taylor_, taylor_.data(),
-      cskip_op_.data(), load_op2var_,
+      cskip_op_.data(), num_skip_op_, load_op2var_,
       compare_change_count_,
       compare_change_number_,
       compare_change_op_index_,
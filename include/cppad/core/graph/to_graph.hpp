@@ -3,7 +3,7 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/core/ad_fun.hpp>
@@ -911,6 +911,29 @@ void CppAD::ADFun<Base,RecBase>::to_graph(
          }
          break;
 
+         // --------------------------------------------------------------
+         // FmavvpOp, FmavvvOp
+         case local::FmavvpOp:
+         case local::FmavvvOp:
+         {  // previous_node + 1 = arg[0] * arg[1]
+            graph_obj.operator_vec_push_back( mul_graph_op );
+            graph_obj.operator_arg_push_back( var2node[ arg[0] ] );
+            graph_obj.operator_arg_push_back( var2node[ arg[1] ] );
+            //
+            // previous_node + 2 = arg[0] * arg[1] + arg[2]
+            graph_obj.operator_vec_push_back( add_graph_op );
+            graph_obj.operator_arg_push_back( previous_node + 1 );
+            if( var_op == local::FmavvvOp )
+               graph_obj.operator_arg_push_back( var2node[ arg[2] ] );
+            else
+               graph_obj.operator_arg_push_back( par2node[ arg[2] ] );
+            //
+            // var2node, previous_node
+            var2node[i_var] = previous_node + 2;
+            previous_node  += 2;
+         }
+         break;
+
          // --------------------------------------------------------------
          // CSumOp
          case local::CSumOp:
@@ -1013,6 +1036,47 @@ void CppAD::ADFun<Base,RecBase>::to_graph(
          itr.correct_before_increment();
          break;
 
+         // --------------------------------------------------------------
+         // WSumOp
+         case local::WSumOp:
+         {  // sum_node: node for the sum of the terms so far
+            size_t sum_node = 0;
+            for(addr_t i = 4; i < arg[3]; i += 2)
+            {  // previous_node + 1 = i-th term without its sign
+               graph_obj.operator_vec_push_back( mul_graph_op );
+               if( i < arg[1] )
+                  graph_obj.operator_arg_push_back( par2node[ arg[i] ] );
+               else
+                  graph_obj.operator_arg_push_back( var2node[ arg[i] ] );
+               graph_obj.operator_arg_push_back( var2node[ arg[i+1] ] );
+               ++previous_node;
+               //
+               // sum_node, previous_node
+               bool add = i < arg[0] || (arg[1] <= i && i < arg[2]);
+               if( sum_node == 0 )
+               {  if( ! add )
+                  {  graph_obj.operator_vec_push_back( neg_graph_op );
+                     graph_obj.operator_arg_push_back( previous_node );
+                     ++previous_node;
+                  }
+               }
+               else
+               {  if( add )
+                     graph_obj.operator_vec_push_back( add_graph_op );
+                  else
+                     graph_obj.operator_vec_push_back( sub_graph_op );
+                  graph_obj.operator_arg_push_back( sum_node );
+                  graph_obj.operator_arg_push_back( previous_node );
+                  ++previous_node;
+               }
+               sum_node = previous_node;
+            }
+            CPPAD_ASSERT_UNKNOWN( sum_node > 0 );
+            var2node[i_var] = sum_node;
+         }
+         itr.correct_before_increment();
+         break;
+
          // --------------------------------------------------------------
          case local::DisOp:
          {  // discrete function index
@@ -2,18 +2,19 @@
 # define CPPAD_CORE_NUM_SKIP_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
 {xrst_begin number_skip}
 
-Number of Variables that Can be Skipped
-#######################################
+Number of Variables and Operators that Can be Skipped
+#####################################################
 
 Syntax
 ******
-*n* = *f* . ``number_skip`` ()
+| *n* = *f* . ``number_skip`` ()
+| *n_op* = *f* . ``number_skip_op`` ()
 
 See Also
 ========
@@ -36,6 +37,19 @@ is the number of variables that the optimizer has determined can be skipped
 (given the independent variable values specified by the previous call to
 :ref:`f.Forward<Forward-name>` for order zero).
 
+n_op
+****
+The return value *n_op* has type ``size_t``
+and is the number of operators that were skipped during the previous call to
+:ref:`f.Forward<Forward-name>` (for one direction).
+All the operators in an :ref:`atomic function<atomic-name>` call are
+counted when the call is skipped.
+This value is computed during the forward sweep and
+can be used to measure the benefit of the conditional skip operators; see
+:ref:`optimize@options@conditional_skip_cost=value` .
+It is zero if :ref:`f.Forward<Forward-name>` has not been called since
+*f* was recorded or optimized.
+
 f
 *
 The object *f* has prototype
@@ -92,7 +106,8 @@ size_t ADFun<Base,RecBase>::number_skip(void)
          size_t num_op = atom_m + atom_n + 1;
          for(size_t i = 0; i < num_op; i++)
          {  CPPAD_ASSERT_UNKNOWN(
-               op != local::CSkipOp && op != local::CSumOp
+               op != local::CSkipOp && op != local::CSumOp &&
+               op != local::WSumOp
             );
             (++itr).op_info(op, arg, i_var);
             if( skip_call )
@@ -104,7 +119,9 @@ size_t ADFun<Base,RecBase>::number_skip(void)
       {  if( cskip_op_[ itr.op_index() ] )
             num_var_skip += NumRes(op);
          //
-         if( (op == local::CSkipOp) | (op == local::CSumOp) )
+         bool correct = op == local::CSkipOp;
+         correct     |= op == local::CSumOp || op == local::WSumOp;
+         if( correct )
             itr.correct_before_increment();
       }
    }
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_OPTIMIZE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # define CPPAD_CORE_OPTIMIZE_PRINT_RESULT 0
@@ -23,6 +23,7 @@ Syntax
 | *f* . ``optimize`` ()
 | *f* . ``optimize`` ( *options* )
 | *flag* = *f* . ``exceed_collision_limit`` ()
+| *n_match* = *f* . ``optimize_match_count`` ()
 
 Purpose
 *******
@@ -62,6 +63,29 @@ If conditional skip operations are generated,
 it may save a significant amount of time when
 using *f* for :ref:`forward-name` or :ref:`reverse-name` mode calculations;
 see :ref:`number_skip-name` .
+Conditional expressions that have the same comparison operator and operands
+share one conditional skip operator.
+Hence the operators that are only used by the true (false) cases of
+these expressions are skipped when the comparison is false (true).
+
+conditional_skip_cost=value
+===========================
+If this sub-string appears,
+where *value* is a sequence of decimal digits,
+a conditional skip operator is only generated when the estimated cost of the
+operators that it can skip is at least *value* times the cost of the
+conditional skip operator.
+The unit of cost is an addition, the cost of a conditional skip operator
+is two plus the number of operators that it can skip, and
+the cost of the other operators is estimated by
+:ref:`optimize_op_cost-name` ; e.g., ``sin`` has cost six.
+This avoids the overhead of conditional skip operators when the
+cases of a conditional expression are cheap to evaluate.
+The value must be greater than zero.
+If this option does not appear, a conditional skip operator is generated
+whenever there is an operator that it can skip.
+This option has no effect when ``no_conditional_skip`` is present
+and it is not used when ``val_graph`` is present.
 
 no_compare_op
 =============
@@ -85,16 +109,54 @@ If this sub-string appears,
 no cumulative sum operations will be generated during the optimization; see
 :ref:`optimize_cumulative_sum.cpp-name` .
 
+multiply_add_op
+===============
+If this sub-string appears, a multiplication of two variables
+whose result is only used by an addition is fused with the addition; i.e.,
+*a* * *b* + *c* is recorded as one operator with one result variable
+instead of two.
+This reduces the number of variables, and the memory traffic,
+for polynomial evaluations; e.g., Horner's method.
+The fused operator computes *a* * *b* + *c* using two operations,
+so the function values do not change.
+This option is not used when ``val_graph`` is present.
+
+weighted_sum_op
+===============
+If this sub-string appears, the multiplications that are terms in a
+cumulative summation, and whose results are only used by the summation,
+are recorded as one weighted summation operator; i.e.,
+*p_0* * *x_0* + ... + *u_0* * *v_0* + ... is recorded as
+one operator with one result variable,
+where each *p_i* is a parameter and each *x_i* , *u_i* , *v_i* is a variable.
+This reduces the number of variables for linear algebra expressions
+such as inner products.
+This option has no effect when ``no_cumulative_sum_op`` is present
+and it is not used when ``val_graph`` is present.
+
 collision_limit=value
 =====================
-If this substring appears,
-where *value* is a sequence of decimal digits,
-the optimizer's hash code collision limit will be set to *value* .
-When the collision limit is reached, the expressions with that hash code
-are removed and a new lists of expressions with that has code is started.
-The larger *value* , the more identical expressions the optimizer
-can recognize, but the slower the optimizer may run.
-The default for *value* is ``10`` .
+This option is no longer used.
+The optimizer's table of expressions grows with the size of the tape,
+so there is no limit on the number of expressions with the same hash code
+and no identical expressions are missed because of hash code collisions.
+This option is still accepted (and ignored) so that existing
+*options* strings continue to work.
+
+incremental
+===========
+If this sub-string appears,
+and the operation sequence for *f* has not changed since it was optimized
+with equivalent *options* , this call to ``optimize`` returns without
+doing any analysis of the operation sequence.
+Two *options* are equivalent if they contain the same sub-strings,
+in any order, not counting ``incremental`` .
+Only recording a new operation sequence changes it; e.g.,
+:ref:`new_dynamic-name` and :ref:`forward-name` do not.
+This avoids the time to optimize again when a function is optimized
+each time its dynamic parameters change.
+If the operation sequence has changed, or the *options* are not
+equivalent, *f* is optimized as if ``incremental`` were not present.
 
 val_graph
 =========
@@ -110,8 +172,11 @@ This is a new (experimental) CppAD operation sequence optimizer.
    when the :ref:`speed_main@Global Options@onetape` option is present.
    For some of the :ref:`speed-name` test case
    the val_graph optimized tape is significantly faster.
-#. The val_graph optimizer take much longer to run.
-   This is probably due to the conversion to and from a val_graph.
+#. The val_graph optimizer takes longer to run.
+   The :ref:`speed_main@Global Options@optimize_time` speed option
+   reports the time spent optimizing separately from the evaluation time,
+   and the time spent in each of the val_graph optimizer passes,
+   including the conversion to and from a val_graph.
 
 no_conditional_skip
 -------------------
@@ -124,6 +189,44 @@ If the sub-string ``val_graph`` is present, the ``collision_limit=value``
 sub-string must **not** appear.
 Currently, there is no collision limit for the new optimizer.
 
+num_thread=value
+----------------
+If this substring appears,
+where *value* is a sequence of decimal digits,
+the val_graph optimizer uses *value* threads to find equivalent operators;
+see :ref:`val_tape_renumber@num_thread` .
+The optimized function is the same for all values of *value* .
+The default for *value* is ``1`` .
+This option is only used when ``val_graph`` is present.
+
+simplify
+--------
+If this sub-string appears,
+the val_graph optimizer applies the exact algebraic simplifications;
+e.g., it replaces *x* * 1 by *x* ;
+see :ref:`val_tape_simplify-name` .
+The result of the optimized function is the same for all argument values
+(the sign of a zero result may change).
+This option is only used when ``val_graph`` is present.
+
+simplify_all
+------------
+If this sub-string appears, it is the same as ``simplify``
+except that all of the simplifications are applied; e.g.,
+*x* - *x* is replaced by zero and
+``pow`` ( *x* , 2 ) is replaced by *x* * *x* .
+These may change the result for some argument values, e.g., infinity,
+or change the rounding of the result.
+This option is only used when ``val_graph`` is present.
+
+Conditional Expressions
+***********************
+If both of the operands compared by a :ref:`CondExp-name` are constant
+parameters, the optimized function only uses the branch that is selected
+by the comparison.
+This can be used to remove branches that depend on dynamic parameters
+that do not change; see :ref:`freeze_dynamic-name` .
+
 Re-Optimize
 ***********
 Before 2019-06-28, optimizing twice was not supported and would fail
@@ -131,6 +234,8 @@ if cumulative sum operators were present after the first optimization.
 This is now supported but it is not expected to have much benefit.
 If you find a case where it does have a benefit, please inform the CppAD
 developers of this.
+The ``incremental`` option can be used to skip optimizing again
+when the operation sequence has not changed.
 
 Efficiency
 **********
@@ -204,9 +309,20 @@ related to *f* . ``optimize`` () .
 
 exceed_collision_limit
 **********************
-If the return value *flag* is true (false),
-the previous call to *f* . ``optimize`` exceed the
+The return value *flag* is always false because there is no longer a
 :ref:`collision_limit<optimize@options@collision_limit=value>` .
+This function is still provided so that existing code continues to work.
+
+optimize_match_count
+********************
+The return value *n_match* has type ``size_t`` .
+It is the number of operators that the previous call to *f* . ``optimize``
+replaced by an identical previous operator; i.e.,
+the number of common subexpressions it eliminated.
+It is zero if *f* has not been optimized, if the ``val_graph``
+option was present during the previous optimization,
+or if the previous optimization was skipped because of the
+``incremental`` option.
 
 Examples
 ********
@@ -237,6 +353,7 @@ Examples
 {xrst_end optimize}
 -----------------------------------------------------------------------------
 */
+# include <algorithm>
 # include <cppad/local/optimize/optimize_run.hpp>
 /*!
 \file optimize.hpp
@@ -270,7 +387,40 @@ when compare_change is not used.
 */
 template <class Base, class RecBase>
 void ADFun<Base,RecBase>::optimize(const std::string& options)
-{
+{  //
+   // incremental, canonical
+   // canonical is the options, not including incremental, in sorted order
+   bool incremental = false;
+   std::string canonical;
+   {  std::vector<std::string> token;
+      size_t index = 0;
+      while( index < options.size() )
+      {  while( index < options.size() && options[index] == ' ' )
+            ++index;
+         std::string option;
+         while( index < options.size() && options[index] != ' ' )
+            option += options[index++];
+         if( option == "incremental" )
+            incremental = true;
+         else if( option != "" )
+            token.push_back(option);
+      }
+      std::sort(token.begin(), token.end());
+      for(size_t i = 0; i < token.size(); ++i)
+      {  if( i > 0 )
+            canonical += ' ';
+         canonical += token[i];
+      }
+   }
+   //
+   // incremental
+   // The operation sequence has not changed since it was optimized with
+   // equivalent options, so there is nothing to do.
+   if( incremental && has_been_optimized_ && canonical == optimize_options_ )
+   {  exceed_collision_limit_ = false;
+      optimize_match_count_   = 0;
+      return;
+   }
 # if CPPAD_CORE_OPTIMIZE_PRINT_RESULT
    // size of operation sequence before optimizatiton
    size_t size_op_before = size_op();
@@ -327,38 +477,45 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
    if( val_graph )
    {  val_optimize(options);
       exceed_collision_limit_ = false;
+      optimize_match_count_   = 0;
    }
    else
    {
       // place to store the optimized version of the recording
       local::recorder<Base> rec;
 
+      // none of the independent dynamic parameters are frozen
+      local::pod_vector<bool> frozen( play_.num_dynamic_ind() );
+      for(size_t j = 0; j < frozen.size(); ++j)
+         frozen[j] = false;
+
       // create the optimized recording
-      size_t exceed = false;
+      size_t n_match = 0;
       switch( play_.address_type() )
       {
          case local::play::unsigned_short_enum:
-         exceed = local::optimize::optimize_run<unsigned short>(
-            options, n_ind_var, dep_taddr_, &play_, &rec
+         n_match = local::optimize::optimize_run<unsigned short>(
+            options, n_ind_var, frozen, dep_taddr_, &play_, &rec
          );
          break;
 
          case local::play::unsigned_int_enum:
-         exceed = local::optimize::optimize_run<unsigned int>(
-            options, n_ind_var, dep_taddr_, &play_, &rec
+         n_match = local::optimize::optimize_run<unsigned int>(
+            options, n_ind_var, frozen, dep_taddr_, &play_, &rec
          );
          break;
 
          case local::play::size_t_enum:
-         exceed = local::optimize::optimize_run<size_t>(
-            options, n_ind_var, dep_taddr_, &play_, &rec
+         n_match = local::optimize::optimize_run<size_t>(
+            options, n_ind_var, frozen, dep_taddr_, &play_, &rec
          );
          break;
 
          default:
          CPPAD_ASSERT_UNKNOWN(false);
       }
-      exceed_collision_limit_ = exceed;
+      exceed_collision_limit_ = false;
+      optimize_match_count_   = n_match;
 
       // now replace the recording
       play_.get_recording(rec, n_ind_var);
@@ -369,6 +526,7 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
 
    // set flag so this function knows it has been optimized
    has_been_optimized_ = true;
+   optimize_options_   = canonical;
 
    // free memory allocated for sparse Jacobian calculation
    // (the results are no longer valid)
@@ -380,6 +538,9 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
    num_order_taylor_     = 0;
    cap_order_taylor_     = 0;
 
+   // no forward sweep has been done with the new operation sequence
+   num_skip_op_          = 0;
+
    // resize and initilaize conditional skip vector
    // (must use player size because it now has the recoreder information)
    cskip_op_.resize( play_.num_op_rec() );
@@ -417,6 +578,7 @@ void ADFun<Base,RecBase>::optimize(const std::string& options)
       // Erase memory that this calculation was done so NDEBUG gives
       // same final state for this object (from users perspective)
       num_order_taylor_     = 0;
+      num_skip_op_          = 0;
    }
 # endif
 # if CPPAD_CORE_OPTIMIZE_PRINT_RESULT
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_SPARSE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 //
@@ -19,7 +19,10 @@
 # include <cppad/core/rev_sparse_hes.hpp>
 //
 # include <cppad/core/sparse_jac.hpp>
+# include <cppad/core/sparse_jac_bidir.hpp>
+# include <cppad/core/sparse_jac_tangent.hpp>
 # include <cppad/core/sparse_hes.hpp>
+# include <cppad/core/sparse_hes_edge.hpp>
 //
 # include <cppad/core/sparse_jacobian.hpp>
 # include <cppad/core/sparse_hessian.hpp>
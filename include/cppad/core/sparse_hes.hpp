@@ -2,7 +2,7 @@
 # define CPPAD_CORE_SPARSE_HES_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -149,6 +149,30 @@ This is the same as the sparse Jacobian
 :ref:`sparse_jac@coloring@cppad` method
 which does not take advantage of symmetry.
 
+cppad.general.order
+===================
+If *order* is ``largest_first`` , ``smallest_last`` or
+``incidence_degree`` , this is the same as the corresponding
+:ref:`sparse_jac@coloring` method; e.g.,
+``cppad.general.smallest_last`` is the same as
+:ref:`sparse_jac@coloring@cppad.smallest_last` .
+
+cppad.star
+==========
+This is a star coloring; i.e., every path with four vertices in the
+graph corresponding to the Hessian uses at least three colors.
+Each requested entry is computed directly from one sweep.
+The columns are colored in smallest last order.
+
+cppad.acyclic
+=============
+This is an acyclic coloring; i.e., every cycle in the graph
+corresponding to the Hessian uses at least three colors.
+This usually requires fewer colors than a star coloring,
+but the requested entries are computed by substitution; i.e.,
+some entries are computed by subtracting other entries from a sweep result.
+The columns are colored in smallest last order.
+
 colpack.symmetric
 =================
 If :ref:`colpack_prefix-name` was specified on the
@@ -189,6 +213,22 @@ for *f* and the sparsity pattern in *subset* are the same.
 If either of these values change, use *work* . ``clear`` () to
 empty this structure.
 
+Coloring Quality
+================
+The field *work* . ``color_lower_bound`` has type ``size_t`` .
+It is zero when *work* is empty.
+After a call that computes the coloring, it is a lower bound
+for the number of colors (sweeps) required by the
+coloring method for this *subset* .
+For the ``general`` methods it is the maximum number of entries in
+*subset* that are in the same row.
+For the other methods, it is one plus the number of
+off diagonal entries (counting a symmetric pair once)
+divided by the number of rows that appear (rounded up);
+i.e., the bound for an acyclic coloring.
+Comparing it with :ref:`sparse_hes@n_sweep` gives a measure of the quality
+of the coloring.
+
 n_sweep
 *******
 The return value *n_sweep* has prototype
@@ -239,6 +279,8 @@ It returns ``true`` , for success, and ``false`` otherwise.
 # include <cppad/local/sparse/internal.hpp>
 # include <cppad/local/color_general.hpp>
 # include <cppad/local/color_symmetric.hpp>
+# include <cppad/local/color_star.hpp>
+# include <cppad/local/color_acyclic.hpp>
 
 /*!
 \file sparse_hes.hpp
@@ -260,9 +302,18 @@ class sparse_hes_work {
       CppAD::vector<size_t> order;
       /// results of the coloring algorithm
       CppAD::vector<size_t> color;
+      /// substitution plan for the acyclic coloring algorithm
+      /// (these are empty for the other coloring algorithms)
+      CppAD::vector<size_t> subs_row;
+      CppAD::vector<size_t> subs_color;
+      CppAD::vector<size_t> subs_start;
+      CppAD::vector<size_t> subs_index;
+      CppAD::vector<size_t> subs_step;
+      /// lower bound for the number of colors (zero when work is empty)
+      size_t color_lower_bound;
 
       /// constructor
-      sparse_hes_work(void)
+      sparse_hes_work(void) : color_lower_bound(0)
       { }
       /// inform CppAD that this information needs to be recomputed
       void clear(void)
@@ -271,6 +322,12 @@ class sparse_hes_work {
          col.clear();
          order.clear();
          color.clear();
+         subs_row.clear();
+         subs_color.clear();
+         subs_start.clear();
+         subs_index.clear();
+         subs_step.clear();
+         color_lower_bound = 0;
       }
 };
 // ----------------------------------------------------------------------------
@@ -307,7 +364,9 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad.symmetric, cppad.general, colpack.symmetic,
+This must be cppad.symmetric, cppad.general, cppad.general.order
+(where order is largest_first, smallest_last, or incidence_degree),
+cppad.star, cppad.acyclic, colpack.general, colpack.symmetic,
 or colpack.star.
 
 \param work
@@ -353,6 +412,11 @@ size_t ADFun<Base,RecBase>::sparse_hes(
    vector<size_t>& col(work.col);
    vector<size_t>& color(work.color);
    vector<size_t>& order(work.order);
+   vector<size_t>& subs_row(work.subs_row);
+   vector<size_t>& subs_color(work.subs_color);
+   vector<size_t>& subs_start(work.subs_start);
+   vector<size_t>& subs_index(work.subs_index);
+   vector<size_t>& subs_step(work.subs_step);
    //
    // subset information
    const SizeVector& subset_row( subset.row() );
@@ -433,10 +497,23 @@ size_t ADFun<Base,RecBase>::sparse_hes(
       // execute coloring algorithm
       // (we are using transpose because coloring groups rows, not columns)
       color.resize(n);
-      if( coloring == "cppad.general" )
-         local::color_general_cppad(internal_pattern, col, row, color);
+      local::color_order_enum order_type;
+      bool general = coloring == "colpack.general";
+      if( local::color_order_name(coloring, "cppad.general", order_type) )
+      {  general = true;
+         local::color_general_cppad(
+            internal_pattern, col, row, color, order_type
+         );
+      }
       else if( coloring == "cppad.symmetric" )
          local::color_symmetric_cppad(internal_pattern, col, row, color);
+      else if( coloring == "cppad.star" )
+         local::color_star_cppad(internal_pattern, col, row, color);
+      else if( coloring == "cppad.acyclic" )
+      {  local::color_acyclic_cppad(internal_pattern, col, row, color,
+            subs_row, subs_color, subs_start, subs_index, subs_step
+         );
+      }
       else if( coloring == "colpack.general" )
       {
 # if CPPAD_HAS_COLPACK
@@ -470,11 +547,30 @@ size_t ADFun<Base,RecBase>::sparse_hes(
       );
       //
       // put sorting indices in color order
-      SizeVector key(K);
-      order.resize(K);
-      for(size_t k = 0; k < K; k++)
-         key[k] = color[ col[k] ];
-      index_sort(key, order);
+      if( subs_start.size() == 0 )
+      {  SizeVector key(K);
+         order.resize(K);
+         for(size_t k = 0; k < K; k++)
+            key[k] = color[ col[k] ];
+         index_sort(key, order);
+      }
+      else
+      {  // order for the substitution steps
+         size_t n_step = subs_row.size();
+         SizeVector key(n_step);
+         order.resize(n_step);
+         for(size_t s = 0; s < n_step; ++s)
+            key[s] = subs_color[s];
+         index_sort(key, order);
+      }
+      //
+      // coloring quality
+      if( general )
+         work.color_lower_bound = local::color_general_lower_bound(n, row);
+      else
+      {  work.color_lower_bound =
+            local::color_symmetric_lower_bound(n, row, col);
+      }
    }
    // Base versions of zero and one
    Base one(1.0);
@@ -494,6 +590,40 @@ size_t ADFun<Base,RecBase>::sparse_hes(
    // return values for calls to second order reverse
    BaseVector ddw(2 * n);
    //
+   if( subs_start.size() > 0 )
+   {  // acyclic coloring: evaluate the sum for each substitution step
+      size_t n_step = subs_row.size();
+      vector<Base> value(n_step);
+      size_t s_k = 0;
+      for(size_t ell = 0; ell < n_color; ell++)
+      if( s_k < n_step && subs_color[ order[s_k] ] == ell )
+      {  for(size_t j = 0; j < n; j++)
+         {  dx[j] = zero;
+            if( color[j] == ell )
+               dx[j] = one;
+         }
+         Forward(1, dx);
+         ddw = Reverse(2, w);
+         while( s_k < n_step && subs_color[ order[s_k] ] == ell )
+         {  size_t s = order[s_k++];
+            value[s]  = ddw[ subs_row[s] * 2 + 1 ];
+         }
+      }
+      CPPAD_ASSERT_UNKNOWN( s_k == n_step );
+      //
+      // substitution
+      for(size_t s = 0; s < n_step; ++s)
+      {  for(size_t ell = subs_start[s]; ell < subs_start[s+1]; ++ell)
+         {  CPPAD_ASSERT_UNKNOWN( subs_index[ell] < s );
+            value[s] -= value[ subs_index[ell] ];
+         }
+      }
+      for(size_t k = 0; k < K; k++)
+         subset.set(k, value[ subs_step[k] ] );
+      //
+      return n_color;
+   }
+   //
    // loop over colors
    size_t k = 0;
    for(size_t ell = 0; ell < n_color; ell++)
@@ -0,0 +1,243 @@
+# ifndef CPPAD_CORE_SPARSE_HES_EDGE_HPP
+# define CPPAD_CORE_SPARSE_HES_EDGE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_hes_edge}
+{xrst_spell
+   nr
+}
+
+Computing Sparse Hessians Using Edge Pushing
+############################################
+
+Syntax
+******
+*f* . ``sparse_hes_edge`` ( *x* , *w* , *hes* )
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+function corresponding to *f* and
+
+.. math::
+
+   H(x) = \dpow{2}{x} \sum_{i=0}^{m-1} w_i F_i (x)
+
+This routine computes both the sparsity pattern and the values of
+:math:`H(x)` using one zero order forward sweep and one
+second order reverse sweep (the edge pushing algorithm).
+It does not require a sparsity pattern or a coloring of the Hessian;
+see :ref:`sparse_hes-name` for a method that uses a coloring.
+This can be faster than ``sparse_hes`` when the coloring requires
+many colors, or when the Hessian is only needed once for each
+sparsity pattern.
+
+SizeVector
+**********
+The type *SizeVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``size_t`` .
+
+BaseVector
+**********
+The type *BaseVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+f
+*
+This object has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+Note that the Taylor coefficients stored in *f* are affected
+by this operation; see
+:ref:`sparse_hes_edge@Uses Forward` below.
+
+Restrictions
+============
+The operation sequence for *f* cannot contain
+:ref:`VecAD-name` operations or :ref:`atomic<atomic_three-name>`
+function calls.
+The other operations (including :ref:`CondExp-name` , :ref:`Discrete-name`
+and :ref:`PrintFor-name` operations) are supported.
+
+x
+*
+This argument has prototype
+
+   ``const`` *BaseVector* & *x*
+
+and its size is *n* .
+It specifies the point at which to evaluate the Hessian
+:math:`H(x)`.
+
+w
+*
+This argument has prototype
+
+   ``const`` *BaseVector* & *w*
+
+and its size is *m* .
+It specifies the weight for each of the components of :math:`F(x)`;
+i.e. :math:`w_i` is the weight for :math:`F_i (x)`.
+The components of :math:`F(x)` that have weight zero
+do not affect the sparsity pattern returned in *hes* .
+
+hes
+***
+This argument has prototype
+
+   ``sparse_rcv`` < *SizeVector* , *BaseVector* >& *hes*
+
+Its input value does not matter.
+Upon return, *hes* . ``nr`` () == *n* and *hes* . ``nc`` () == *n* .
+It contains the possibly non-zero entries of :math:`H(x)` ,
+both above and below the diagonal, in
+:ref:`row major order<sparse_rc@row_major>` .
+The pattern depends on *x* only through the
+:ref:`conditional expressions<CondExp-name>` in *f* .
+
+Uses Forward
+************
+After a call to ``sparse_hes_edge`` ,
+the zero order coefficients correspond to
+
+   *f* . ``Forward`` (0, *x* )
+
+All the other forward mode coefficients are unspecified.
+
+Example
+*******
+{xrst_toc_hidden
+   example/sparse/sparse_hes_edge.cpp
+}
+The file :ref:`sparse_hes_edge.cpp-name`
+is an example and test of ``sparse_hes_edge`` .
+It returns ``true`` , if it succeeds, and ``false`` otherwise.
+
+{xrst_end sparse_hes_edge}
+*/
+# include <cppad/core/sparse_hes.hpp>
+
+/*!
+\file sparse_hes_edge.hpp
+Sparse Hessian calculation using the edge pushing algorithm.
+*/
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+Calculate sparse Hessians using edge pushing.
+
+\tparam Base
+the base type for the recording that is stored in this ADFun<Base object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param w
+a vector of length m, the number of dependent variables in f
+(this ADFun object).
+
+\param hes
+the input value does not matter.
+On output, it is the sparsity pattern and values for the Hessian of
+w^T f(x) in row major order (both the lower and upper triangle are included).
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+void ADFun<Base,RecBase>::sparse_hes_edge(
+   const BaseVector&                    x    ,
+   const BaseVector&                    w    ,
+   sparse_rcv<SizeVector, BaseVector>&  hes  )
+{  size_t n = Domain();
+   size_t m = Range();
+   //
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n,
+      "sparse_hes_edge: x.size() not equal domain dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( w.size() ) == m,
+      "sparse_hes_edge: w.size() not equal range dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      play_.num_var_vecad_rec() == 0,
+      "sparse_hes_edge: f contains VecAD operations"
+   );
+   //
+   // Taylor coefficients of order zero
+   Forward(0, x);
+   //
+   // adjoint, adj_nz
+   CppAD::vector<Base> adjoint(num_var_tape_);
+   CppAD::vector<bool> adj_nz(num_var_tape_);
+   for(size_t i = 0; i < num_var_tape_; ++i)
+   {  adjoint[i] = Base(0.0);
+      adj_nz[i]  = false;
+   }
+   for(size_t i = 0; i < m; ++i)
+   {  if( ! dep_parameter_[i] && ! IdenticalZero( w[i] ) )
+      {  size_t i_var    = size_t( dep_taddr_[i] );
+         adjoint[i_var] += w[i];
+         adj_nz[i_var]   = true;
+      }
+   }
+   //
+   // matrix
+   local::sweep::hes_edge_matrix<Base> matrix(num_var_tape_);
+   local::sweep::hes_edge<addr_t>(
+      &play_,
+      cap_order_taylor_,
+      taylor_.data(),
+      cskip_op_.data(),
+      adjoint,
+      adj_nz,
+      matrix,
+      RecBase()
+   );
+   //
+   // nnz
+   size_t nnz = 0;
+   for(size_t j = 0; j < n; ++j)
+   {  size_t j_var = size_t( ind_taddr_[j] );
+      nnz += matrix.row(j_var).size();
+   }
+   //
+   // hes
+   // independent variable j is variable j + 1 on the tape
+   sparse_rc<SizeVector> pattern(n, n, nnz);
+   BaseVector            val(nnz);
+   size_t k = 0;
+   for(size_t r = 0; r < n; ++r)
+   {  size_t r_var = size_t( ind_taddr_[r] );
+      CPPAD_ASSERT_UNKNOWN( r_var == r + 1 );
+      typename local::sweep::hes_edge_matrix<Base>::row_type::const_iterator
+         itr;
+      for(itr = matrix.row(r_var).begin(); itr != matrix.row(r_var).end(); ++itr)
+      {  CPPAD_ASSERT_UNKNOWN( 0 < itr->first && itr->first <= n );
+         pattern.set(k, r, itr->first - 1);
+         val[k] = itr->second;
+         ++k;
+      }
+   }
+   CPPAD_ASSERT_UNKNOWN( k == nnz );
+   hes = sparse_rcv<SizeVector, BaseVector>(pattern);
+   for(k = 0; k < nnz; ++k)
+      hes.set(k, val[k]);
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
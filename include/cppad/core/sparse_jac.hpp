@@ -2,7 +2,7 @@
 # define CPPAD_CORE_SPARSE_JAC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -143,6 +143,27 @@ after the *work* constructor or *work* . ``clear`` () .
 cppad
 =====
 This uses a general purpose coloring algorithm written for Cppad.
+The rows (reverse) or columns (forward) are colored in index order.
+
+cppad.largest_first
+===================
+This is the same as ``cppad`` except that the rows (columns)
+are colored in decreasing order of their degree; i.e., the number
+of other rows (columns) they conflict with.
+
+cppad.smallest_last
+===================
+This is the same as ``cppad`` except that the rows (columns)
+are colored in smallest last order; i.e., the row (column) with the
+smallest degree is colored last, it is removed from the conflict graph,
+and this is repeated for the rows (columns) that remain.
+This often results in fewer colors than the other orderings.
+
+cppad.incidence_degree
+======================
+This is the same as ``cppad`` except that the next row (column)
+colored is the one with the most conflicts with the rows (columns)
+that have already been colored.
 
 colpack
 =======
@@ -170,6 +191,17 @@ for *f* and the sparsity pattern in *subset* are the same.
 If any of these values change, use *work* . ``clear`` () to
 empty this structure.
 
+Coloring Quality
+================
+The field *work* . ``color_lower_bound`` has type ``size_t`` .
+It is zero when *work* is empty.
+After a call that computes the coloring, it is a lower bound
+for the number of colors that any coloring method could use for this
+*subset* ; i.e., the maximum number of entries in *subset*
+that are in the same row (forward) or the same column (reverse).
+Comparing it with :ref:`sparse_jac@n_color` gives a measure of the quality
+of the coloring.
+
 n_color
 *******
 The return value *n_color* has prototype
@@ -232,15 +264,18 @@ class sparse_jac_work {
       CppAD::vector<size_t> order;
       /// results of the coloring algorithm
       CppAD::vector<size_t> color;
+      /// lower bound for the number of colors (zero when work is empty)
+      size_t color_lower_bound;
       //
       /// constructor
-      sparse_jac_work(void)
+      sparse_jac_work(void) : color_lower_bound(0)
       { }
       /// reset work to empty.
       /// This informs CppAD that color and order need to be recomputed
       void clear(void)
       {  order.clear();
          color.clear();
+         color_lower_bound = 0;
       }
 };
 // ----------------------------------------------------------------------------
@@ -277,7 +312,8 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, cppad.largest_first, cppad.smallest_last,
+cppad.incidence_degree, or colpack.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -360,8 +396,11 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
       // execute coloring algorithm
       // (we are using transpose because coloring groups rows, not columns).
       color.resize(n);
-      if( coloring == "cppad" )
-         local::color_general_cppad(pattern_transpose, col, row, color);
+      local::color_order_enum order_type;
+      if( local::color_order_name(coloring, "cppad", order_type) )
+         local::color_general_cppad(
+            pattern_transpose, col, row, color, order_type
+         );
       else if( coloring == "colpack" )
       {
 # if CPPAD_HAS_COLPACK
@@ -385,6 +424,9 @@ size_t ADFun<Base,RecBase>::sparse_jac_for(
       for(size_t k = 0; k < K; k++)
          key[k] = color[ col[k] ];
       index_sort(key, order);
+      //
+      // coloring quality
+      work.color_lower_bound = local::color_general_lower_bound(m, row);
    }
    // Base versions of zero and one
    Base one(1.0);
@@ -471,7 +513,8 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, cppad.largest_first, cppad.smallest_last,
+cppad.incidence_degree, or colpack.
 
 \param work
 this structure must be empty, or contain the information stored
@@ -552,8 +595,11 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
       //
       // execute coloring algorithm
       color.resize(m);
-      if( coloring == "cppad" )
-         local::color_general_cppad(internal_pattern, row, col, color);
+      local::color_order_enum order_type;
+      if( local::color_order_name(coloring, "cppad", order_type) )
+         local::color_general_cppad(
+            internal_pattern, row, col, color, order_type
+         );
       else if( coloring == "colpack" )
       {
 # if CPPAD_HAS_COLPACK
@@ -577,6 +623,9 @@ size_t ADFun<Base,RecBase>::sparse_jac_rev(
       for(size_t k = 0; k < K; k++)
          key[k] = color[ row[k] ];
       index_sort(key, order);
+      //
+      // coloring quality
+      work.color_lower_bound = local::color_general_lower_bound(n, col);
    }
    // Base versions of zero and one
    Base one(1.0);
@@ -0,0 +1,271 @@
+# ifndef CPPAD_CORE_SPARSE_JAC_BIDIR_HPP
+# define CPPAD_CORE_SPARSE_JAC_BIDIR_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_jac_bidir}
+{xrst_spell
+   bicoloring
+   nr
+}
+
+Computing Sparse Jacobians Using Forward and Reverse Mode
+#########################################################
+
+Syntax
+******
+
+| *n_color* = *f* . ``sparse_jac_bidir`` (
+| |tab| *group_max* , *x* , *subset* , *pattern* , *coloring* , *work*
+| )
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+function corresponding to *f* and
+
+.. math::
+
+   J(x) = F^{(1)} (x)
+
+Jacobians with a few dense rows require close to *m* colors
+when using :ref:`sparse_jac@sparse_jac_rev` and
+Jacobians with a few dense columns require close to *n* colors
+when using :ref:`sparse_jac@sparse_jac_for` .
+If a Jacobian has both dense rows and dense columns,
+both of these methods are expensive.
+This routine computes a bicoloring; i.e.,
+the entries in the dense rows are computed using reverse mode,
+the entries in the dense columns are computed using forward mode,
+and the other entries are computed using the direction that
+requires fewer colors.
+
+group_max, x, subset, pattern
+*****************************
+These arguments have the same meaning as for
+:ref:`sparse_jac@sparse_jac_for` .
+The values in *subset* are computed using both forward and reverse mode.
+
+coloring
+********
+This has the same meaning as for :ref:`sparse_jac@coloring` .
+It is used for both the forward and reverse mode colorings.
+
+work
+****
+This argument has prototype
+
+   ``sparse_jac_bidir_work&`` *work*
+
+We refer to its initial value,
+and its value after *work* . ``clear`` () , as empty.
+If it is empty, information is stored in *work* .
+This can be used to reduce computation when
+a future call is for the same object *f* ,
+and the same subset of the Jacobian.
+If either of these values change, use *work* . ``clear`` () to
+empty this structure.
+
+forward, reverse
+================
+The fields *work* . ``forward`` and *work* . ``reverse`` have type
+``sparse_jac_work`` .
+They are the :ref:`sparse_jac@work` for the forward and reverse mode
+parts of the calculation.
+For example, *work* . ``forward.color_lower_bound`` is the
+:ref:`sparse_jac@work@Coloring Quality` lower bound for the forward part.
+
+n_color
+*******
+The return value *n_color* has prototype
+
+   ``size_t`` *n_color*
+
+It is the number of forward mode directions plus the number of
+reverse mode directions used to compute the requested Jacobian values.
+
+Uses Forward
+************
+After a call to ``sparse_jac_bidir`` ,
+the zero order coefficients correspond to
+
+   *f* . ``Forward`` (0, *x* )
+
+All the other forward mode coefficients are unspecified.
+
+Example
+*******
+{xrst_toc_hidden
+   example/sparse/sparse_jac_bidir.cpp
+}
+The file :ref:`sparse_jac_bidir.cpp-name`
+is an example and test of ``sparse_jac_bidir`` .
+It returns ``true`` , if it succeeds, and ``false`` otherwise.
+
+{xrst_end sparse_jac_bidir}
+*/
+# include <cppad/core/sparse_jac.hpp>
+# include <cppad/local/color_bidir.hpp>
+
+/*!
+\file sparse_jac_bidir.hpp
+Sparse Jacobian calculation using both forward and reverse mode.
+*/
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+Class used to hold information used by sparse_jac_bidir,
+so it does not need to be recomputed every time.
+*/
+class sparse_jac_bidir_work {
+   public:
+      /// indices in subset for the entries computed using forward mode
+      CppAD::vector<size_t> for_index;
+      /// indices in subset for the entries computed using reverse mode
+      CppAD::vector<size_t> rev_index;
+      /// work for the forward mode calculation
+      sparse_jac_work forward;
+      /// work for the reverse mode calculation
+      sparse_jac_work reverse;
+      //
+      /// constructor
+      sparse_jac_bidir_work(void)
+      { }
+      /// reset work to empty.
+      void clear(void)
+      {  for_index.clear();
+         rev_index.clear();
+         forward.clear();
+         reverse.clear();
+      }
+};
+// ----------------------------------------------------------------------------
+/*!
+Calculate sparse Jacobains using forward and reverse mode
+
+\tparam Base
+the base type for the recording that is stored in the ADFun object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param group_max
+specifies the maximum number of colors to group during
+a single forward sweep.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param subset
+specifices the subset of the sparsity pattern where the Jacobian is evaluated.
+subset.nr() == m,
+subset.nc() == n.
+
+\param pattern
+is a sparsity pattern for the Jacobian of f;
+pattern.nr() == m,
+pattern.nc() == n.
+
+\param coloring
+determines which coloring algorithm is used for each direction;
+see sparse_jac_for.
+
+\param work
+this structure must be empty, or contain the information stored
+by a previous call to sparse_jac_bidir.
+The previous call must be for the same ADFun object f
+and the same subset.
+
+\return
+This is the number of forward mode directions plus the number of reverse
+mode directions used to compute the Jacobian.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+size_t ADFun<Base,RecBase>::sparse_jac_bidir(
+   size_t                               group_max  ,
+   const BaseVector&                    x          ,
+   sparse_rcv<SizeVector, BaseVector>&  subset     ,
+   const sparse_rc<SizeVector>&         pattern    ,
+   const std::string&                   coloring   ,
+   sparse_jac_bidir_work&               work       )
+{  size_t m = Range();
+   size_t n = Domain();
+   size_t K = subset.nnz();
+   //
+   CPPAD_ASSERT_KNOWN(
+      subset.nr() == m,
+      "sparse_jac_bidir: subset.nr() not equal range dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      subset.nc() == n,
+      "sparse_jac_bidir: subset.nc() not equal domain dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      work.for_index.size() + work.rev_index.size() == 0 ||
+      work.for_index.size() + work.rev_index.size() == K,
+      "sparse_jac_bidir: work is non-empty and conditions have changed"
+   );
+   //
+   // row, col
+   const SizeVector& row( subset.row() );
+   const SizeVector& col( subset.col() );
+   //
+   // work.for_index, work.rev_index
+   if( work.for_index.size() + work.rev_index.size() == 0 )
+   {  CppAD::vector<bool> forward;
+      local::color_bidir_partition(m, n, row, col, forward);
+      for(size_t k = 0; k < K; ++k)
+      {  if( forward[k] )
+            work.for_index.push_back(k);
+         else
+            work.rev_index.push_back(k);
+      }
+   }
+   //
+   // n_color
+   size_t n_color = 0;
+   //
+   // forward mode
+   size_t K_for = work.for_index.size();
+   if( K_for > 0 || K == 0 )
+   {  sparse_rc<SizeVector> for_pattern(m, n, K_for);
+      for(size_t ell = 0; ell < K_for; ++ell)
+      {  size_t k = work.for_index[ell];
+         for_pattern.set(ell, row[k], col[k]);
+      }
+      sparse_rcv<SizeVector, BaseVector> for_subset(for_pattern);
+      n_color += sparse_jac_for(
+         group_max, x, for_subset, pattern, coloring, work.forward
+      );
+      for(size_t ell = 0; ell < K_for; ++ell)
+         subset.set(work.for_index[ell], for_subset.val()[ell]);
+   }
+   //
+   // reverse mode
+   size_t K_rev = work.rev_index.size();
+   if( K_rev > 0 )
+   {  sparse_rc<SizeVector> rev_pattern(m, n, K_rev);
+      for(size_t ell = 0; ell < K_rev; ++ell)
+      {  size_t k = work.rev_index[ell];
+         rev_pattern.set(ell, row[k], col[k]);
+      }
+      sparse_rcv<SizeVector, BaseVector> rev_subset(rev_pattern);
+      n_color += sparse_jac_rev(
+         x, rev_subset, pattern, coloring, work.reverse
+      );
+      for(size_t ell = 0; ell < K_rev; ++ell)
+         subset.set(work.rev_index[ell], rev_subset.val()[ell]);
+   }
+   return n_color;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,208 @@
+# ifndef CPPAD_CORE_SPARSE_JAC_TANGENT_HPP
+# define CPPAD_CORE_SPARSE_JAC_TANGENT_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_jac_tangent}
+{xrst_spell
+   nr
+}
+
+Computing Sparse Jacobians Using Sparse Tangent Vectors
+#######################################################
+
+Syntax
+******
+*f* . ``sparse_jac_tangent`` ( *x* , *jac* )
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+function corresponding to *f* and
+
+.. math::
+
+   J(x) = F^{(1)} (x)
+
+This routine computes both the sparsity pattern and the values of
+:math:`J(x)` using one zero order forward sweep and one forward sweep
+where the derivative of each variable, with respect to the independent
+variables, is represented by a sparse vector.
+It does not require a sparsity pattern or a coloring of the Jacobian;
+see :ref:`sparse_jac-name` for methods that use a coloring.
+This is useful when the sparsity pattern changes between evaluations;
+e.g., due to :ref:`conditional expressions<CondExp-name>` .
+The amount of work is proportional to the sum,
+over all the variables, of the number of independent variables
+that each variable depends on.
+
+SizeVector
+**********
+The type *SizeVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``size_t`` .
+
+BaseVector
+**********
+The type *BaseVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+f
+*
+This object has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+Note that the Taylor coefficients stored in *f* are affected
+by this operation; see
+:ref:`sparse_jac_tangent@Uses Forward` below.
+
+Restrictions
+============
+The operation sequence for *f* cannot contain
+:ref:`VecAD-name` operations or :ref:`atomic<atomic_three-name>`
+function calls.
+
+x
+*
+This argument has prototype
+
+   ``const`` *BaseVector* & *x*
+
+and its size is *n* .
+It specifies the point at which to evaluate the Jacobian
+:math:`J(x)`.
+
+jac
+***
+This argument has prototype
+
+   ``sparse_rcv`` < *SizeVector* , *BaseVector* >& *jac*
+
+Its input value does not matter.
+Upon return, *jac* . ``nr`` () == *m* and *jac* . ``nc`` () == *n* .
+It contains the possibly non-zero entries of :math:`J(x)` in
+:ref:`row major order<sparse_rc@row_major>` .
+Only the branch of a conditional expression that is selected by *x*
+is included in the sparsity pattern.
+
+Uses Forward
+************
+After a call to ``sparse_jac_tangent`` ,
+the zero order coefficients correspond to
+
+   *f* . ``Forward`` (0, *x* )
+
+All the other forward mode coefficients are unspecified.
+
+Example
+*******
+{xrst_toc_hidden
+   example/sparse/sparse_jac_tangent.cpp
+}
+The file :ref:`sparse_jac_tangent.cpp-name`
+is an example and test of ``sparse_jac_tangent`` .
+It returns ``true`` , if it succeeds, and ``false`` otherwise.
+
+{xrst_end sparse_jac_tangent}
+*/
+# include <cppad/core/sparse_jac.hpp>
+
+/*!
+\file sparse_jac_tangent.hpp
+Sparse Jacobian calculation using sparse tangent vectors.
+*/
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+Calculate sparse Jacobians using sparse tangent vectors.
+
+\tparam Base
+the base type for the recording that is stored in this ADFun<Base object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param jac
+the input value does not matter.
+On output, it is the sparsity pattern and values for the Jacobian of f(x)
+in row major order.
+*/
+template <class Base, class RecBase>
+template <class SizeVector, class BaseVector>
+void ADFun<Base,RecBase>::sparse_jac_tangent(
+   const BaseVector&                    x    ,
+   sparse_rcv<SizeVector, BaseVector>&  jac  )
+{  size_t n = Domain();
+   size_t m = Range();
+   //
+   CPPAD_ASSERT_KNOWN(
+      size_t( x.size() ) == n,
+      "sparse_jac_tangent: x.size() not equal domain dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      play_.num_var_vecad_rec() == 0,
+      "sparse_jac_tangent: f contains VecAD operations"
+   );
+   //
+   // Taylor coefficients of order zero
+   Forward(0, x);
+   //
+   // var_set, val_start, val
+   local::sparse::list_setvec   var_set;
+   local::pod_vector<size_t>    val_start;
+   local::pod_vector_maybe<Base> val;
+   local::sweep::jac_tangent<addr_t>(
+      n,
+      &play_,
+      cap_order_taylor_,
+      taylor_.data(),
+      cskip_op_.data(),
+      var_set,
+      val_start,
+      val,
+      RecBase()
+   );
+   //
+   // nnz
+   size_t nnz = 0;
+   for(size_t i = 0; i < m; ++i)
+   {  if( ! dep_parameter_[i] )
+         nnz += var_set.number_elements( size_t( dep_taddr_[i] ) );
+   }
+   //
+   // jac
+   sparse_rc<SizeVector> pattern(m, n, nnz);
+   BaseVector            jac_val(nnz);
+   size_t k = 0;
+   for(size_t i = 0; i < m; ++i) if( ! dep_parameter_[i] )
+   {  size_t i_var = size_t( dep_taddr_[i] );
+      size_t ell   = val_start[i_var];
+      local::sparse::list_setvec_const_iterator set_itr(var_set, i_var);
+      size_t j = *set_itr;
+      while( j < n )
+      {  pattern.set(k, i, j);
+         jac_val[k++] = val[ell++];
+         j = *(++set_itr);
+      }
+   }
+   CPPAD_ASSERT_UNKNOWN( k == nnz );
+   jac = sparse_rcv<SizeVector, BaseVector>(pattern);
+   for(k = 0; k < nnz; ++k)
+      jac.set(k, jac_val[k]);
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -2,10 +2,11 @@
 # define CPPAD_CORE_TAPE_LINK_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/define.hpp>
+# include <cppad/local/thread_table.hpp>
 # include <cppad/utility/thread_alloc.hpp>
 # include <cppad/core/cppad_assert.hpp>
 
@@ -39,11 +40,11 @@ is a pointer to the tape identifier for this thread and AD<Base> class.
 template <class Base>
 tape_id_t* AD<Base>::tape_id_ptr(size_t thread)
 {  CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-   static tape_id_t tape_id_table[CPPAD_MAX_NUM_THREADS];
+   static local::thread_table<tape_id_t> tape_id_table;
    CPPAD_ASSERT_UNKNOWN(
       (! thread_alloc::in_parallel()) || thread == thread_alloc::thread_num()
    );
-   return tape_id_table + thread;
+   return &tape_id_table[thread];
 }
 
 /*!
@@ -65,11 +66,11 @@ is a handle for the tape for this AD<Base> class and the specified thread.
 template <class Base>
 local::ADTape<Base>** AD<Base>::tape_handle(size_t thread)
 {  CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
-   static local::ADTape<Base>* tape_table[CPPAD_MAX_NUM_THREADS];
+   static local::thread_table< local::ADTape<Base>* > tape_table;
    CPPAD_ASSERT_UNKNOWN(
       (! thread_alloc::in_parallel()) || thread == thread_alloc::thread_num()
    );
-   return tape_table + thread;
+   return &tape_table[thread];
 }
 
 /*!
@@ -106,7 +107,7 @@ is the identifier for the tape that is currently recording
 AD<Base> operations for the current thread.
 It must hold that the current thread is
 \code
-   thread = size_t( tape_id % CPPAD_MAX_NUM_THREADS )
+   thread = size_t( tape_id % CPPAD_THREAD_LIMIT )
 \endcode
 and that there is a tape recording AD<Base> operations
 for this thread.
@@ -124,7 +125,7 @@ for the specified thread.
 */
 template <class Base>
 local::ADTape<Base>* AD<Base>::tape_ptr(tape_id_t tape_id)
-{  size_t thread = size_t( tape_id % CPPAD_MAX_NUM_THREADS );
+{  size_t thread = size_t( tape_id % CPPAD_THREAD_LIMIT );
    CPPAD_ASSERT_KNOWN(
       thread == thread_alloc::thread_num(),
       "Attempt to use an AD variable with two different threads."
@@ -159,7 +160,7 @@ for this thread when tape_manage is called.
 It is assumed that there is a tape recording AD<Base> operations
 for this thread when tape_manage is called.
 The value of <tt>*tape_id_ptr(thread)</tt> will be advanced by
- CPPAD_MAX_NUM_THREADS.
+ CPPAD_THREAD_LIMIT.
 
 
 \return
@@ -189,9 +190,9 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
       *tape_h = new local::ADTape<Base>();
 
       // if tape id is zero, initialize it so that
-      // thread == tape id % CPPAD_MAX_NUM_THREADS
+      // thread == tape id % CPPAD_THREAD_LIMIT
       if( *tape_id_p == 0 )
-      {  size_t new_tape_id = thread + CPPAD_MAX_NUM_THREADS;
+      {  size_t new_tape_id = thread + CPPAD_THREAD_LIMIT;
          CPPAD_ASSERT_KNOWN(
             size_t( std::numeric_limits<tape_id_t>::max() ) >= new_tape_id,
             "cppad_tape_id_type maximum value has been exceeded"
@@ -200,7 +201,7 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
       }
       // make sure tape_id value is valid for this thread
       CPPAD_ASSERT_UNKNOWN(
-         size_t( *tape_id_p % CPPAD_MAX_NUM_THREADS ) == thread
+         size_t( *tape_id_p % CPPAD_THREAD_LIMIT ) == thread
       );
       // set the tape_id for this tape
       (*tape_h)->id_ = *tape_id_p;
@@ -216,11 +217,11 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_enum job)
       // advance tape_id so that all AD<Base> variables become parameters
       CPPAD_ASSERT_KNOWN(
          std::numeric_limits<CPPAD_TAPE_ID_TYPE>::max()
-         - CPPAD_MAX_NUM_THREADS > *tape_id_p,
+         - CPPAD_THREAD_LIMIT > *tape_id_p,
          "To many different tapes given the type used for "
          "CPPAD_TAPE_ID_TYPE"
       );
-      *tape_id_p  += CPPAD_MAX_NUM_THREADS;
+      *tape_id_p  += CPPAD_THREAD_LIMIT;
    }
    // -----------------------------------------------------------------------
    return *tape_h;
@@ -235,7 +236,7 @@ is the base type corresponding to AD<Base> operations.
 \par thread
 The current thread must be given by
 \code
-   thread = this->tape_id_ % CPPAD_MAX_NUM_THREADS
+   thread = this->tape_id_ % CPPAD_THREAD_LIMIT
 \endcode
 
 \return
@@ -248,7 +249,7 @@ recording AD<Base> operations for this thread.
 template <class Base>
 local::ADTape<Base> *AD<Base>::tape_this(void) const
 {
-   size_t thread = size_t( tape_id_ % CPPAD_MAX_NUM_THREADS );
+   size_t thread = size_t( tape_id_ % CPPAD_THREAD_LIMIT );
    CPPAD_ASSERT_UNKNOWN( tape_id_ == *tape_id_ptr(thread) );
    CPPAD_ASSERT_UNKNOWN( *tape_handle(thread) != nullptr );
    return *tape_handle(thread);
@@ -0,0 +1,412 @@
+# ifndef CPPAD_CORE_THREAD_POOL_HPP
+# define CPPAD_CORE_THREAD_POOL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin thread_pool}
+{xrst_spell
+   pthread
+}
+
+A Built-in Thread Pool for CppAD
+################################
+
+Syntax
+******
+| ``thread_pool`` *pool* ( *num_threads* )
+| *pool* . ``num_threads`` ()
+| *pool* . ``template parallel_ad`` < *Base* >()
+| *pool* . ``run`` ( *n_job* , *job* )
+| *pool* . ``free_available`` ()
+
+Purpose
+*******
+Using CppAD with multiple threads requires calling
+:ref:`ta_parallel_setup-name` , :ref:`parallel_ad-name` ,
+and creating a team of threads; e.g., see :ref:`team_thread.hpp-name` .
+The ``thread_pool`` class does this setup using ``std::thread`` .
+It also provides a work stealing scheduler for independent jobs.
+While a pool exists, CppAD routines that can use multiple threads
+(for example the *num_thread* argument to
+:ref:`for_jac_sparsity<for_jac_sparsity@num_thread>` )
+run their work on the pool's threads instead of creating new threads.
+
+pool
+****
+The constructor for *pool* does the following:
+
+#. It calls :ref:`ta_parallel_setup-name` with *num_threads*
+   and routines that identify the threads in this pool.
+#. It calls :ref:`hold_memory(true)<ta_hold_memory-name>` .
+#. It calls :ref:`parallel_ad\<double\><parallel_ad-name>` .
+#. It starts *num_threads* - 1 threads that wait for jobs.
+   The thread that creates the pool is thread zero.
+
+The destructor for *pool* stops and joins the other threads,
+frees the memory that is :ref:`available<ta_available-name>`
+for each thread in the pool,
+calls ``hold_memory(false)`` , and returns ``thread_alloc``
+to its single thread setting.
+
+Restrictions
+============
+Only one pool can exist at a time.
+The pool must be created, and destroyed, in sequential execution mode
+by a thread that is not using :ref:`ta_parallel_setup-name`
+for some other team of threads.
+
+num_threads
+***********
+This argument to the constructor has prototype
+
+   ``size_t`` *num_threads*
+
+and is the number of threads in the pool (including thread zero).
+It must be greater than zero and less than or equal
+:ref:`multi_thread@CPPAD_THREAD_LIMIT` .
+The member function ``num_threads`` returns this value.
+
+parallel_ad
+***********
+The constructor calls ``parallel_ad<double>()`` .
+If you are using a different *Base* type with multiple threads,
+call *pool* . ``template parallel_ad`` < *Base* >() ,
+in sequential execution mode, before using ``AD`` < *Base* > objects
+in a job.
+
+run
+***
+This member function has prototype
+
+| |tab| ``template <class Job>``
+| |tab| ``void run(size_t`` *n_job* , *Job* & *job* )
+
+It must be called by thread zero in sequential execution mode.
+The syntax *job* ( *j* ) executes job number *j* ,
+for *j* = 0 , ... , *n_job* - 1 .
+Each job is executed exactly once and ``run`` returns after all
+of the jobs have been completed.
+During the jobs, execution is in parallel mode and
+:ref:`thread_alloc::thread_num()<ta_thread_num-name>` identifies the
+thread that is executing the job; e.g., it can be used to select
+an ``ADFun`` object that belongs to that thread.
+
+Work Stealing
+=============
+The jobs are initially split into contiguous ranges, one for each thread.
+When a thread has finished its range, it takes half of the remaining
+jobs from another thread's range.
+This balances the work when different jobs take different amounts of time.
+
+free_available
+**************
+This member function must be called in sequential execution mode.
+It calls :ref:`ta_free_available-name` for each of the threads in the pool.
+
+Example
+*******
+{xrst_toc_hidden
+   example/multi_thread/thread_pool.cpp
+}
+The file :ref:`thread_pool.cpp-name` is an example and test
+that uses a pool to evaluate Jacobians in parallel.
+
+{xrst_end thread_pool}
+*/
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <atomic>
+# include <vector>
+# include <cppad/utility/thread_alloc.hpp>
+# include <cppad/local/std_thread_team.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file thread_pool.hpp
+A pool of std::thread objects that is set up for use with CppAD.
+*/
+
+/*!
+A pool of threads, with a work stealing scheduler, that is set up for
+use with thread_alloc and AD<double>.
+*/
+class thread_pool {
+private:
+   /// range of jobs that have not yet been started by one thread
+   struct range_t {
+      /// protects begin and end
+      std::mutex mutex;
+      /// first job in this range
+      size_t     begin;
+      /// one past the last job in this range
+      size_t     end;
+   };
+   /// number of threads in this pool
+   const size_t              num_threads_;
+   /// the other threads in this pool (thread zero is not included)
+   std::vector<std::thread>  worker_;
+   /// remaining jobs for each thread in this pool
+   std::vector<range_t>      range_;
+   /// protects generation_, n_done_, stop_
+   std::mutex                mutex_;
+   /// used to signal the other threads that there is work or stop_ is true
+   std::condition_variable   work_cv_;
+   /// used to signal thread zero that the other threads are done
+   std::condition_variable   done_cv_;
+   /// incremented each time run is called
+   size_t                    generation_;
+   /// number of other threads that are done with the current generation
+   size_t                    n_done_;
+   /// should the other threads exit
+   bool                      stop_;
+   /// routine that executes one job for the current generation
+   void                    (*job_)(void* data, size_t j);
+   /// data passed to job_
+   void*                     data_;
+   // ------------------------------------------------------------------
+   /// pointer to the pool that currently exists (or nullptr)
+   static thread_pool*& current(void)
+   {  static thread_pool* pool = nullptr;
+      return pool;
+   }
+   /// thread number for the current thread (zero for the master thread)
+   static size_t& thread_number(void)
+   {  static thread_local size_t number = 0;
+      return number;
+   }
+   /// are the threads in the pool currently executing jobs
+   static std::atomic<bool>& running(void)
+   {  static std::atomic<bool> flag(false);
+      return flag;
+   }
+   /// in_parallel routine passed to thread_alloc::parallel_setup
+   static bool in_parallel(void)
+   {  return running().load(); }
+   /// thread_num routine passed to thread_alloc::parallel_setup
+   static size_t thread_num(void)
+   {  return thread_number(); }
+   // ------------------------------------------------------------------
+   /// calls job(j) where job has type Job and data points to job
+   template <class Job>
+   static void call_job(void* data, size_t j)
+   {  Job& job = *static_cast<Job*>(data);
+      job(j);
+   }
+   /// run routine passed to std_thread_team::set_pool
+   static void run_team(size_t n_job, void (*job)(void*, size_t), void* data)
+   {  CPPAD_ASSERT_UNKNOWN( current() != nullptr );
+      current()->run_void(n_job, job, data);
+   }
+   // ------------------------------------------------------------------
+   /*!
+   Get the next job for a thread.
+
+   \param thread [in]
+   is the thread that will execute the job.
+
+   \param j [out]
+   if the return value is true, j is the next job for this thread.
+
+   \return
+   is false if there are no more jobs in any of the ranges.
+   */
+   bool next_job(size_t thread, size_t& j)
+   {  // jobs in the range for this thread
+      {  range_t& range( range_[thread] );
+         std::lock_guard<std::mutex> lock(range.mutex);
+         if( range.begin < range.end )
+         {  j = range.begin++;
+            return true;
+         }
+      }
+      // steal half of the remaining jobs from another thread
+      for(size_t k = 1; k < num_threads_; ++k)
+      {  size_t other = (thread + k) % num_threads_;
+         size_t begin, end;
+         {  range_t& range( range_[other] );
+            std::lock_guard<std::mutex> lock(range.mutex);
+            if( range.begin == range.end )
+               continue;
+            end         = range.end;
+            begin       = range.begin + (range.end - range.begin) / 2;
+            range.end   = begin;
+         }
+         range_t& range( range_[thread] );
+         std::lock_guard<std::mutex> lock(range.mutex);
+         j           = begin;
+         range.begin = begin + 1;
+         range.end   = end;
+         return true;
+      }
+      return false;
+   }
+   /// execute jobs for the current generation until there are no more
+   void work(size_t thread)
+   {  size_t j;
+      while( next_job(thread, j) )
+         job_(data_, j);
+   }
+   /// main routine for the other threads in the pool
+   void worker(size_t thread)
+   {  thread_number() = thread;
+      size_t generation = 0;
+      while( true )
+      {  {  std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait( lock,
+               [&]{ return stop_ || generation_ != generation; }
+            );
+            if( stop_ )
+               return;
+            generation = generation_;
+         }
+         work(thread);
+         {  std::lock_guard<std::mutex> lock(mutex_);
+            ++n_done_;
+         }
+         done_cv_.notify_one();
+      }
+   }
+   /*!
+   Execute job(data, j) for j = 0, ..., n_job-1 using the pool.
+
+   \param n_job [in]
+   is the number of jobs.
+
+   \param job [in]
+   is the routine that executes one job.
+
+   \param data [in]
+   is passed to job.
+   */
+   void run_void(size_t n_job, void (*job)(void*, size_t), void* data)
+   {  CPPAD_ASSERT_KNOWN(
+         ! thread_alloc::in_parallel() && thread_number() == 0,
+         "thread_pool::run: not called by thread zero in sequential mode"
+      );
+      if( n_job == 0 )
+         return;
+      //
+      // range_
+      for(size_t thread = 0; thread < num_threads_; ++thread)
+      {  range_[thread].begin = (n_job * thread) / num_threads_;
+         range_[thread].end   = (n_job * (thread + 1)) / num_threads_;
+      }
+      //
+      // start the other threads on this generation
+      job_  = job;
+      data_ = data;
+      running().store(true);
+      {  std::lock_guard<std::mutex> lock(mutex_);
+         n_done_ = 0;
+         ++generation_;
+      }
+      work_cv_.notify_all();
+      //
+      // thread zero works on this generation
+      work(0);
+      //
+      // wait for the other threads to finish
+      {  std::unique_lock<std::mutex> lock(mutex_);
+         done_cv_.wait( lock, [&]{ return n_done_ + 1 == num_threads_; } );
+      }
+      running().store(false);
+   }
+public:
+   /*!
+   Create a thread pool and set up thread_alloc and AD<double> to use it.
+
+   \param num_threads [in]
+   is the number of threads in the pool (including the current thread).
+   */
+   thread_pool(size_t num_threads)
+   : num_threads_(num_threads)
+   , range_(num_threads)
+   , generation_(0)
+   , n_done_(0)
+   , stop_(false)
+   , job_(nullptr)
+   , data_(nullptr)
+   {  CPPAD_ASSERT_KNOWN(
+         0 < num_threads && num_threads <= CPPAD_THREAD_LIMIT,
+         "thread_pool: num_threads is zero or greater than "
+         "CPPAD_THREAD_LIMIT"
+      );
+      CPPAD_ASSERT_KNOWN( current() == nullptr,
+         "thread_pool: a thread pool already exists"
+      );
+      CPPAD_ASSERT_KNOWN(
+         thread_alloc::num_threads() == 1 && ! thread_alloc::in_parallel(),
+         "thread_pool: thread_alloc is already set up for multiple threads"
+      );
+      current()       = this;
+      thread_number() = 0;
+      //
+      // setup thread_alloc and AD<double> for use with this pool
+      thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+      thread_alloc::hold_memory(true);
+      CppAD::parallel_ad<double>();
+      //
+      // CppAD routines that use std_thread_team will use this pool
+      local::std_thread_team::set_pool(run_team);
+      //
+      // start the other threads
+      for(size_t thread = 1; thread < num_threads; ++thread)
+         worker_.push_back( std::thread(&thread_pool::worker, this, thread) );
+   }
+   /// stop the threads in the pool and return thread_alloc to one thread
+   ~thread_pool(void)
+   {  CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() );
+      {  std::lock_guard<std::mutex> lock(mutex_);
+         stop_ = true;
+      }
+      work_cv_.notify_all();
+      for(size_t i = 0; i < worker_.size(); ++i)
+         worker_[i].join();
+      //
+      free_available();
+      local::std_thread_team::set_pool(nullptr);
+      thread_alloc::hold_memory(false);
+      thread_alloc::parallel_setup(1, nullptr, nullptr);
+      current() = nullptr;
+   }
+   /// number of threads in this pool
+   size_t num_threads(void) const
+   {  return num_threads_; }
+   /// set up AD<Base> for use with this pool
+   template <class Base>
+   void parallel_ad(void)
+   {  CPPAD_ASSERT_KNOWN( ! thread_alloc::in_parallel(),
+         "thread_pool::parallel_ad: called in parallel mode"
+      );
+      CppAD::parallel_ad<Base>();
+   }
+   /*!
+   Execute a set of independent jobs using the threads in this pool.
+
+   \tparam Job
+   is a type such that job(j) executes job number j.
+
+   \param n_job [in]
+   is the number of jobs.
+
+   \param job [in]
+   job(j) is called exactly once for j = 0, ..., n_job-1.
+   */
+   template <class Job>
+   void run(size_t n_job, Job& job)
+   {  run_void(n_job, call_job<Job>, static_cast<void*>(&job) ); }
+   /// return the memory available for the threads in this pool to the system
+   void free_available(void)
+   {  CPPAD_ASSERT_KNOWN( ! thread_alloc::in_parallel(),
+         "thread_pool::free_available: called in parallel mode"
+      );
+      for(size_t thread = 0; thread < num_threads_; ++thread)
+         thread_alloc::free_available(thread);
+   }
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_UNDEF_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -47,9 +47,11 @@ that are used by the CppAD examples and tests.
 # undef CPPAD_HAS_GETTIMEOFDAY
 # undef CPPAD_HAS_IPOPT
 # undef CPPAD_HAS_MKSTEMP
+# undef CPPAD_HAS_MMAP
 # undef CPPAD_HAS_TMPNAM_S
 # undef CPPAD_INLINE_FRIEND_TEMPLATE_FUNCTION
 # undef CPPAD_IS_SAME_UNSIGNED_INT_SIZE_T
+# undef CPPAD_LARGE_MIN_BYTES
 # undef CPPAD_LIB_EXPORT
 # undef CPPAD_MAX_NUM_CAPACITY
 # undef CPPAD_MIN_DOUBLE_CAPACITY
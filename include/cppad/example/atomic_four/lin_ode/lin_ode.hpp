@@ -3,7 +3,7 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_four_lin_ode.hpp}
@@ -34,12 +34,12 @@ public:
    // ctor
    atomic_lin_ode(const std::string& name) :
    CppAD::atomic_four<Base>(name)
-   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+   {  for(size_t thread = 0; thread < CPPAD_THREAD_LIMIT; ++thread)
          work_[thread] = nullptr;
    }
    // destructor
    ~atomic_lin_ode(void)
-   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+   {  for(size_t thread = 0; thread < CPPAD_THREAD_LIMIT; ++thread)
       {  if( work_[thread] != nullptr  )
          {  // allocated in set member function
             delete work_[thread];
@@ -99,7 +99,7 @@ private:
    };
    //
    // Use pointers, to avoid false sharing between threads.
-   thread_struct* work_[CPPAD_MAX_NUM_THREADS];
+   thread_struct* work_[CPPAD_THREAD_LIMIT];
    //
    // extend_ode
    template <class Float>
@@ -3,7 +3,7 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_four_mat_mul.hpp}
@@ -30,12 +30,12 @@ public:
    // ctor
    atomic_mat_mul(const std::string& name) :
    CppAD::atomic_four<Base>(name)
-   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+   {  for(size_t thread = 0; thread < CPPAD_THREAD_LIMIT; ++thread)
          work_[thread] = nullptr;
    }
    // destructor
    ~atomic_mat_mul(void)
-   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+   {  for(size_t thread = 0; thread < CPPAD_THREAD_LIMIT; ++thread)
       {  if( work_[thread] != nullptr  )
          {  // allocated in set member function
             delete work_[thread];
@@ -60,7 +60,7 @@ private:
    typedef CppAD::vector<call_struct> call_vector;
    //
    // Use pointers, to avoid false sharing between threads.
-   call_vector* work_[CPPAD_MAX_NUM_THREADS];
+   call_vector* work_[CPPAD_THREAD_LIMIT];
    //
    // base_mat_mul
    static void base_mat_mul(
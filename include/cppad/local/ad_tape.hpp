@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_AD_TAPE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/define.hpp>
 
@@ -102,8 +102,8 @@ private:
    // private data
    /*!
    Unique identifier for this tape.  It is always greater than
-   CPPAD_MAX_NUM_THREADS, and different for every tape (even ones that have
-   been deleted). In addition, id_ % CPPAD_MAX_NUM_THREADS is the thread
+   CPPAD_THREAD_LIMIT, and different for every tape (even ones that have
+   been deleted). In addition, id_ % CPPAD_THREAD_LIMIT is the thread
    number for this tape. Set by Independent and effectively const
    */
    tape_id_t                    id_;
@@ -0,0 +1,323 @@
+# ifndef CPPAD_LOCAL_COLOR_ACYCLIC_HPP
+# define CPPAD_LOCAL_COLOR_ACYCLIC_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <map>
+# include <algorithm>
+# include <cppad/local/color_star.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_acyclic.hpp
+Acyclic coloring algorithm for a symmetric sparse matrix
+and the corresponding substitution plan.
+*/
+// --------------------------------------------------------------------------
+/*!
+Union find structure for the two colored forests of an acyclic coloring.
+
+The forest for colors (c, d) is identified by c * n_color + d where c < d.
+Only vertices that have been joined to another vertex are stored.
+*/
+class color_forest {
+private:
+   /// maps (forest, vertex) to the parent of vertex in the forest
+   std::map< std::pair<size_t, size_t> , size_t > parent_;
+public:
+   /// root of the tree in forest that contains vertex
+   size_t find(size_t forest, size_t vertex)
+   {  size_t root = vertex;
+      std::map< std::pair<size_t, size_t>, size_t >::iterator itr;
+      itr = parent_.find( std::make_pair(forest, root) );
+      while( itr != parent_.end() && itr->second != root )
+      {  root = itr->second;
+         itr  = parent_.find( std::make_pair(forest, root) );
+      }
+      // path compression
+      while( vertex != root )
+      {  itr    = parent_.find( std::make_pair(forest, vertex) );
+         vertex = itr->second;
+         itr->second = root;
+      }
+      return root;
+   }
+   /// join the trees in forest that contain u and v
+   void join(size_t forest, size_t u, size_t v)
+   {  size_t ru = find(forest, u);
+      size_t rv = find(forest, v);
+      if( ru != rv )
+      {  parent_[ std::make_pair(forest, ru) ] = rv;
+         parent_[ std::make_pair(forest, rv) ] = rv;
+      }
+   }
+};
+// --------------------------------------------------------------------------
+/*!
+CppAD acyclic coloring algorithm for determining which rows of a
+symmetric sparse matrix can be computed together.
+
+An acyclic coloring is a distance one coloring where every cycle uses
+at least three colors; i.e., the sub-graph induced by any two colors
+is a forest. The entries of the matrix are recovered by substitution;
+i.e., by peeling the leaves of each two colored tree.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+
+\param row, col [in]
+the entries (row[k], col[k]) are the entries that are needed.
+
+\param color [out]
+is a vector with size m.
+Upon return, it is a coloring for the rows of the sparse matrix.
+If color[i] == m, then i is not equal row[k] or col[k] for any k.
+
+\param subs_row, subs_color [out]
+For each substitution step s, the value for step s is
+the subs_row[s] component of the Hessian times the direction
+corresponding to color subs_color[s],
+minus the value for steps
+subs_index[ell] for ell = subs_start[s], ..., subs_start[s+1]-1.
+The steps subs_index[ell] come before step s.
+
+\param subs_start, subs_index [out]
+see subs_row above.
+
+\param subs_step [out]
+is a vector with the same size as row.
+The value for entry (row[k], col[k]) is the value for step subs_step[k].
+
+\param order_type [in]
+is the order in which the rows are colored; see color_order_enum.
+*/
+template <class SetVector>
+void color_acyclic_cppad(
+   const SetVector&              pattern                         ,
+   const CppAD::vector<size_t>&  row                             ,
+   const CppAD::vector<size_t>&  col                             ,
+   CppAD::vector<size_t>&        color                           ,
+   CppAD::vector<size_t>&        subs_row                        ,
+   CppAD::vector<size_t>&        subs_color                      ,
+   CppAD::vector<size_t>&        subs_start                      ,
+   CppAD::vector<size_t>&        subs_index                      ,
+   CppAD::vector<size_t>&        subs_step                       ,
+   color_order_enum              order_type = smallest_last_order )
+{  size_t m = pattern.n_set();
+   size_t K = row.size();
+   CPPAD_ASSERT_UNKNOWN( color.size() == m );
+   //
+   // appear, adj_start, adj_index, n_edge
+   CppAD::vector<bool>   appear;
+   CppAD::vector<size_t> adj_start, adj_index;
+   size_t n_edge;
+   color_adjacency(pattern, row, col, appear, adj_start, adj_index, n_edge);
+   //
+   // order2vertex
+   CppAD::vector<size_t> order2vertex;
+   color_adjacency_order(
+      appear, adj_start, adj_index, n_edge, order_type, order2vertex
+   );
+   //
+   // color
+   for(size_t i = 0; i < m; ++i)
+      color[i] = m;
+   //
+   // forbidden[c] == v if color c is used by a neighbor of v
+   CppAD::vector<size_t> forbidden(m + 1);
+   for(size_t c = 0; c <= m; ++c)
+      forbidden[c] = m;
+   //
+   // forest, n_color
+   color_forest forest;
+   size_t n_color = 0;
+   //
+   // neighbor: (color, vertex) for the colored neighbors of v
+   // root: roots for the neighbors with one color
+   CppAD::vector< std::pair<size_t, size_t> > neighbor;
+   CppAD::vector<size_t> root;
+   for(size_t o = 0; o < m; ++o) if( appear[ order2vertex[o] ] )
+   {  size_t v = order2vertex[o];
+      //
+      // neighbor, forbidden
+      neighbor.resize(0);
+      for(size_t ell = adj_start[v]; ell < adj_start[v+1]; ++ell)
+      {  size_t w = adj_index[ell];
+         if( color[w] < m )
+         {  neighbor.push_back( std::make_pair(color[w], w) );
+            forbidden[ color[w] ] = v;
+         }
+      }
+      std::sort(neighbor.data(), neighbor.data() + neighbor.size());
+      //
+      // c: smallest color that does not create a two colored cycle
+      size_t c = 0;
+      bool   ok = false;
+      while( ! ok )
+      {  ok = forbidden[c] != v;
+         size_t ell = 0;
+         while( ok && ell < neighbor.size() )
+         {  size_t d = neighbor[ell].first;
+            size_t f = std::min(c, d) * (m + 1) + std::max(c, d);
+            root.resize(0);
+            while( ell < neighbor.size() && neighbor[ell].first == d )
+               root.push_back( forest.find(f, neighbor[ell++].second) );
+            std::sort(root.data(), root.data() + root.size());
+            for(size_t q = 1; q < root.size(); ++q)
+               ok &= root[q-1] != root[q];
+         }
+         if( ! ok )
+            ++c;
+      }
+      CPPAD_ASSERT_UNKNOWN( c <= n_color );
+      color[v] = c;
+      n_color  = std::max(n_color, c + 1);
+      //
+      // join v to its neighbors in the corresponding forests
+      for(size_t ell = 0; ell < neighbor.size(); ++ell)
+      {  size_t d = neighbor[ell].first;
+         size_t f = std::min(c, d) * (m + 1) + std::max(c, d);
+         forest.join(f, v, neighbor[ell].second);
+      }
+   }
+   // ----------------------------------------------------------------------
+   // substitution plan
+   //
+   // adj_edge
+   // edge index corresponding to adj_index[ell] (same for both directions)
+   CppAD::vector<size_t> adj_edge( adj_index.size() );
+   size_t e = 0;
+   for(size_t i = 0; i < m; ++i)
+   {  for(size_t ell = adj_start[i]; ell < adj_start[i+1]; ++ell)
+      {  size_t j = adj_index[ell];
+         if( i < j )
+            adj_edge[ell] = e++;
+         else
+         {  const size_t* begin = adj_index.data() + adj_start[j];
+            const size_t* end   = adj_index.data() + adj_start[j+1];
+            size_t  pos   = size_t( std::lower_bound(begin, end, i) - begin );
+            adj_edge[ell] = adj_edge[ adj_start[j] + pos ];
+         }
+      }
+   }
+   CPPAD_ASSERT_UNKNOWN( e == n_edge );
+   //
+   // group_start, group_slot, group_vertex, group_color
+   // The group with index g corresponds to the neighbors of group_vertex[g]
+   // that have color group_color[g]. The slots for those neighbors are
+   // group_slot[q] for q = group_start[g], ..., group_start[g+1]-1.
+   CppAD::vector<size_t> group_start, group_slot, group_vertex, group_color;
+   // edge2group[2*e] and edge2group[2*e+1] are the groups that contain e
+   CppAD::vector<size_t> edge2group(2 * n_edge), edge2count(n_edge);
+   for(e = 0; e < n_edge; ++e)
+      edge2count[e] = 0;
+   for(size_t i = 0; i < m; ++i)
+   {  neighbor.resize(0);
+      for(size_t ell = adj_start[i]; ell < adj_start[i+1]; ++ell)
+         neighbor.push_back( std::make_pair(color[ adj_index[ell] ], ell) );
+      std::sort(neighbor.data(), neighbor.data() + neighbor.size());
+      for(size_t q = 0; q < neighbor.size(); ++q)
+      {  size_t d   = neighbor[q].first;
+         size_t ell = neighbor[q].second;
+         if( q == 0 || neighbor[q-1].first != d )
+         {  group_start.push_back( group_slot.size() );
+            group_vertex.push_back(i);
+            group_color.push_back(d);
+         }
+         e = adj_edge[ell];
+         edge2group[ 2 * e + edge2count[e]++ ] = group_vertex.size() - 1;
+         group_slot.push_back(ell);
+      }
+   }
+   size_t n_group = group_vertex.size();
+   group_start.push_back( group_slot.size() );
+   //
+   // edge2step, group_unresolved, queue
+   CppAD::vector<size_t> edge2step(n_edge), group_unresolved(n_group);
+   for(e = 0; e < n_edge; ++e)
+      edge2step[e] = n_edge;
+   CppAD::vector<size_t> queue;
+   for(size_t g = 0; g < n_group; ++g)
+   {  group_unresolved[g] = group_start[g+1] - group_start[g];
+      if( group_unresolved[g] == 1 )
+         queue.push_back(g);
+   }
+   //
+   // subs_row, subs_color, subs_start, subs_index
+   subs_row.resize(0);
+   subs_color.resize(0);
+   subs_start.resize(0);
+   subs_index.resize(0);
+   //
+   // peel the leaves of the two colored trees
+   size_t n_queue = 0;
+   while( n_queue < queue.size() )
+   {  size_t g = queue[n_queue++];
+      if( group_unresolved[g] == 1 )
+      {  // the value for the unresolved edge is the g-th group sum
+         // minus the value for the other edges in the group
+         size_t step = subs_row.size();
+         subs_row.push_back( group_vertex[g] );
+         subs_color.push_back( group_color[g] );
+         subs_start.push_back( subs_index.size() );
+         size_t unresolved = n_edge;
+         for(size_t q = group_start[g]; q < group_start[g+1]; ++q)
+         {  e = adj_edge[ group_slot[q] ];
+            if( edge2step[e] == n_edge )
+               unresolved = e;
+            else
+               subs_index.push_back( edge2step[e] );
+         }
+         CPPAD_ASSERT_UNKNOWN( unresolved < n_edge );
+         e            = unresolved;
+         edge2step[e] = step;
+         for(size_t p = 0; p < 2; ++p)
+         {  size_t h = edge2group[2 * e + p];
+            --group_unresolved[h];
+            if( group_unresolved[h] == 1 )
+               queue.push_back(h);
+         }
+      }
+   }
+# ifndef NDEBUG
+   for(e = 0; e < n_edge; ++e)
+      CPPAD_ASSERT_UNKNOWN( edge2step[e] < n_edge );
+# endif
+   //
+   // subs_step
+   subs_step.resize(K);
+   CppAD::vector<size_t> diag2step(m);
+   for(size_t i = 0; i < m; ++i)
+      diag2step[i] = m;
+   for(size_t k = 0; k < K; ++k)
+   {  size_t i = row[k];
+      size_t j = col[k];
+      if( i == j )
+      {  if( diag2step[i] == m )
+         {  diag2step[i] = subs_row.size();
+            subs_row.push_back(i);
+            subs_color.push_back( color[i] );
+            subs_start.push_back( subs_index.size() );
+         }
+         subs_step[k] = diag2step[i];
+      }
+      else
+      {  const size_t* begin = adj_index.data() + adj_start[i];
+         const size_t* end   = adj_index.data() + adj_start[i+1];
+         size_t  pos   = size_t( std::lower_bound(begin, end, j) - begin );
+         CPPAD_ASSERT_UNKNOWN( adj_index[ adj_start[i] + pos ] == j );
+         subs_step[k] = edge2step[ adj_edge[ adj_start[i] + pos ] ];
+      }
+   }
+   subs_start.push_back( subs_index.size() );
+   return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
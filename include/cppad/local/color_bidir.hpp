@@ -0,0 +1,186 @@
+# ifndef CPPAD_LOCAL_COLOR_BIDIR_HPP
+# define CPPAD_LOCAL_COLOR_BIDIR_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/color_order.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_bidir.hpp
+Partition the entries of a sparse Jacobian between forward and reverse mode.
+*/
+// --------------------------------------------------------------------------
+/*!
+Determine which entries of a sparse Jacobian are computed using forward
+mode and which are computed using reverse mode.
+
+Rows with many entries are removed and computed using reverse mode,
+columns with many entries are removed and computed using forward mode.
+The dense row or column with the most remaining entries is removed next.
+After t removals, the number of sweeps is estimated by
+t plus the minimum of the maximum remaining row and column counts.
+The t with the smallest estimate is used and the remaining entries
+are computed using the direction that corresponds to the minimum.
+This gives a bicoloring where the dense rows and dense columns
+do not force the other rows or columns to have different colors.
+
+\param m [in]
+is the number of rows in the Jacobian.
+
+\param n [in]
+is the number of columns in the Jacobian.
+
+\param row, col [in]
+the entries (row[k], col[k]), for k = 0, ..., K-1, are the entries
+of the Jacobian that are needed. There are no repeated entries.
+
+\param forward [out]
+is a vector of size K. On output, forward[k] is true (false) if entry k
+is computed using forward (reverse) mode.
+*/
+template <class SizeVector>
+void color_bidir_partition(
+   size_t                 m       ,
+   size_t                 n       ,
+   const SizeVector&      row     ,
+   const SizeVector&      col     ,
+   CppAD::vector<bool>&   forward )
+{  size_t K = size_t( row.size() );
+   CPPAD_ASSERT_UNKNOWN( size_t( col.size() ) == K );
+   forward.resize(K);
+   //
+   // r2k_start, r2k_index, c2k_start, c2k_index
+   // entries in each row and in each column
+   CppAD::vector<size_t> r2k_start(m + 1), c2k_start(n + 1);
+   for(size_t i = 0; i <= m; ++i)
+      r2k_start[i] = 0;
+   for(size_t j = 0; j <= n; ++j)
+      c2k_start[j] = 0;
+   for(size_t k = 0; k < K; ++k)
+   {  CPPAD_ASSERT_UNKNOWN( row[k] < m && col[k] < n );
+      ++r2k_start[ row[k] + 1 ];
+      ++c2k_start[ col[k] + 1 ];
+   }
+   size_t max_row = 0, max_col = 0;
+   for(size_t i = 0; i < m; ++i)
+   {  max_row = std::max(max_row, r2k_start[i+1]);
+      r2k_start[i+1] += r2k_start[i];
+   }
+   for(size_t j = 0; j < n; ++j)
+   {  max_col = std::max(max_col, c2k_start[j+1]);
+      c2k_start[j+1] += c2k_start[j];
+   }
+   CppAD::vector<size_t> r2k_index(K), c2k_index(K), r_next(m), c_next(n);
+   for(size_t i = 0; i < m; ++i)
+      r_next[i] = r2k_start[i];
+   for(size_t j = 0; j < n; ++j)
+      c_next[j] = c2k_start[j];
+   for(size_t k = 0; k < K; ++k)
+   {  r2k_index[ r_next[ row[k] ]++ ] = k;
+      c2k_index[ c_next[ col[k] ]++ ] = k;
+   }
+   //
+   // row_queue, col_queue
+   // key is number of entries that have not been removed
+   color_bucket row_queue(m, max_row + 1), col_queue(n, max_col + 1);
+   for(size_t i = 0; i < m; ++i)
+      row_queue.insert(i, r2k_start[i+1] - r2k_start[i]);
+   for(size_t j = 0; j < n; ++j)
+      col_queue.insert(j, c2k_start[j+1] - c2k_start[j]);
+   //
+   // removed
+   CppAD::vector<bool> removed(K);
+   for(size_t k = 0; k < K; ++k)
+      removed[k] = false;
+   //
+   // best_t, best_cost, best_forward
+   size_t best_t    = 0;
+   size_t best_cost = std::min(max_row, max_col);
+   bool best_forward = max_row <= max_col;
+   //
+   // sequence of removals:
+   // sequence[t] < m is a row, otherwise sequence[t] - m is a column
+   CppAD::vector<size_t> sequence;
+   //
+   size_t t = 0;
+   while( t < best_cost )
+   {  while( max_row > 0 && row_queue.head(max_row) == m )
+         --max_row;
+      while( max_col > 0 && col_queue.head(max_col) == n )
+         --max_col;
+      size_t cost = t + std::min(max_row, max_col);
+      if( cost < best_cost )
+      {  best_t       = t;
+         best_cost    = cost;
+         best_forward = max_row <= max_col;
+      }
+      if( max_row == 0 && max_col == 0 )
+         break;
+      if( max_row >= max_col )
+      {  // remove the row with the most entries (use reverse mode)
+         size_t i = row_queue.head(max_row);
+         row_queue.change(i, 0);
+         sequence.push_back(i);
+         for(size_t ell = r2k_start[i]; ell < r2k_start[i+1]; ++ell)
+         {  size_t k = r2k_index[ell];
+            if( ! removed[k] )
+            {  removed[k] = true;
+               size_t j   = col[k];
+               col_queue.change(j, col_queue.key(j) - 1);
+            }
+         }
+      }
+      else
+      {  // remove the column with the most entries (use forward mode)
+         size_t j = col_queue.head(max_col);
+         col_queue.change(j, 0);
+         sequence.push_back(m + j);
+         for(size_t ell = c2k_start[j]; ell < c2k_start[j+1]; ++ell)
+         {  size_t k = c2k_index[ell];
+            if( ! removed[k] )
+            {  removed[k] = true;
+               size_t i   = row[k];
+               row_queue.change(i, row_queue.key(i) - 1);
+            }
+         }
+      }
+      ++t;
+   }
+   //
+   // forward
+   // entries that are not removed during the first best_t removals
+   for(size_t k = 0; k < K; ++k)
+   {  removed[k] = false;
+      forward[k] = best_forward;
+   }
+   for(t = 0; t < best_t; ++t)
+   {  if( sequence[t] < m )
+      {  size_t i = sequence[t];
+         for(size_t ell = r2k_start[i]; ell < r2k_start[i+1]; ++ell)
+         {  size_t k = r2k_index[ell];
+            if( ! removed[k] )
+            {  removed[k] = true;
+               forward[k] = false;
+            }
+         }
+      }
+      else
+      {  size_t j = sequence[t] - m;
+         for(size_t ell = c2k_start[j]; ell < c2k_start[j+1]; ++ell)
+         {  size_t k = c2k_index[ell];
+            if( ! removed[k] )
+            {  removed[k] = true;
+               forward[k] = true;
+            }
+         }
+      }
+   }
+   return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -7,6 +7,7 @@
 
 # include <cppad/configure.hpp>
 # include <cppad/local/cppad_colpack.hpp>
+# include <cppad/local/color_order.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -60,13 +61,20 @@ It follows that neither of these pairs appear in the set of
 This routine tries to minimize, with respect to the choice of colors,
 the maximum, with respct to k, of <code>color[ row[k] ]</code>
 (not counting the indices k for which row[k] == m).
+
+\param order_type [in]
+is the order in which the rows are colored; see color_order_enum.
+The degree of a row is the number of other rows that
+have a non-zero entry in the same column
+(counting each column that is shared).
 */
 template <class SetVector, class SizeVector>
 void color_general_cppad(
-   const SetVector&        pattern ,
-   const SizeVector&       row     ,
-   const SizeVector&       col     ,
-   CppAD::vector<size_t>&  color   )
+   const SetVector&        pattern                   ,
+   const SizeVector&       row                       ,
+   const SizeVector&       col                       ,
+   CppAD::vector<size_t>&  color                     ,
+   color_order_enum        order_type = natural_order )
 {
    size_t K = row.size();
    size_t m = pattern.n_set();
@@ -119,11 +127,26 @@ void color_general_cppad(
    for(size_t j = 0; j < n; ++j)
       not_appear.process_post(j);
 
+   // order2row
+   CppAD::vector<size_t> order2row;
+   {  CppAD::vector<size_t> r2c_start, r2c_index, c2r_start, c2r_index;
+      color_csr(pattern, r2c_start, r2c_index, c2r_start, c2r_index);
+      color_order(m, r2c_start, r2c_index, c2r_start, c2r_index,
+         row_appear, order_type, order2row
+      );
+   }
+   //
+   // row2order
+   CppAD::vector<size_t> row2order(m);
+   for(size_t o = 0; o < m; ++o)
+      row2order[ order2row[o] ] = o;
+   //
    // initial coloring
    color.resize(m);
    size_t ell = 0;
-   for(size_t i = 0; i < m; i++)
-   {  if( row_appear[i] )
+   for(size_t o = 0; o < m; o++)
+   {  size_t i = order2row[o];
+      if( row_appear[i] )
          color[i] = ell++;
       else
          color[i] = m;
@@ -138,9 +161,10 @@ void color_general_cppad(
    row and col need to be computed.
    */
    CppAD::vector<bool> forbidden(m);
-   for(size_t i = 1; i < m; i++) // for each row that appears
-   if( color[i] < m )
-   {
+   for(size_t o = 1; o < m; o++) // for each row that appears (in order)
+   if( color[ order2row[o] ] < m )
+   {  size_t i = order2row[o];
+
       // initial all colors as ok for this row
       // (value of forbidden for ell > initial color[i] does not matter)
       for(ell = 0; ell <= color[i]; ell++)
@@ -157,8 +181,8 @@ void color_general_cppad(
          typename SetVector::const_iterator c2r_itr(c2r_appear, j);
          size_t r = *c2r_itr;
          while( r != c2r_appear.end() )
-         {  // if this is not the same row, forbid its color
-            if( (r < i) & (color[r] < m) )
+         {  // if this row has already been colored, forbid its color
+            if( (row2order[r] < o) & (color[r] < m) )
                forbidden[ color[r] ] = true;
             r = *(++c2r_itr);
          }
@@ -178,8 +202,8 @@ void color_general_cppad(
          typename SetVector::const_iterator not_itr(not_appear, j);
          size_t r = *not_itr;
          while( r != not_appear.end() )
-         {  // if this is not the same row, forbid its color
-            if( (r < i) & (color[r] < m) )
+         {  // if this row has already been colored, forbid its color
+            if( (row2order[r] < o) & (color[r] < m) )
                forbidden[ color[r] ] = true;
             r = *(++not_itr);
          }
@@ -0,0 +1,465 @@
+# ifndef CPPAD_LOCAL_COLOR_ORDER_HPP
+# define CPPAD_LOCAL_COLOR_ORDER_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <string>
+# include <utility>
+# include <algorithm>
+# include <cppad/utility/vector.hpp>
+# include <cppad/core/cppad_assert.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_order.hpp
+Vertex ordering heuristics used by the CppAD coloring algorithms.
+*/
+
+/*!
+Order in which vertices are colored by a greedy coloring algorithm.
+
+\li natural_order: vertices are colored in index order.
+\li largest_first_order: vertices are colored in decreasing degree order.
+\li smallest_last_order: the vertex with smallest degree, in the graph that
+remains, is removed and placed last; i.e., colored after the
+vertices that remain.
+\li incidence_degree_order: the next vertex colored is the one with
+the most connections to vertices that have already been ordered.
+*/
+enum color_order_enum {
+   natural_order,
+   largest_first_order,
+   smallest_last_order,
+   incidence_degree_order
+};
+
+/*!
+Convert the suffix of a coloring method name to an order.
+
+\param coloring
+is the coloring method name.
+
+\param prefix
+is the prefix for the coloring method; e.g., cppad.
+
+\param order_type
+if coloring is prefix, order_type is natural_order.
+If coloring is prefix.largest_first, prefix.smallest_last,
+or prefix.incidence_degree, order_type is the corresponding order.
+
+\return
+is true if coloring is one of the cases above and false otherwise.
+*/
+inline bool color_order_name(
+   const std::string& coloring   ,
+   const std::string& prefix     ,
+   color_order_enum&  order_type )
+{  if( coloring == prefix )
+   {  order_type = natural_order;
+      return true;
+   }
+   if( coloring == prefix + ".largest_first" )
+   {  order_type = largest_first_order;
+      return true;
+   }
+   if( coloring == prefix + ".smallest_last" )
+   {  order_type = smallest_last_order;
+      return true;
+   }
+   if( coloring == prefix + ".incidence_degree" )
+   {  order_type = incidence_degree_order;
+      return true;
+   }
+   return false;
+}
+
+/*!
+Compressed row representation of a vector of sets and its transpose.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\param pattern
+is the vector of sets.
+
+\param start, index
+on output, the elements of set i are index[k]
+for k = start[i], ... , start[i+1]-1.
+
+\param t_start, t_index
+on output, the sets that contain element j are t_index[k]
+for k = t_start[j], ... , t_start[j+1]-1.
+*/
+template <class SetVector>
+void color_csr(
+   const SetVector&        pattern ,
+   CppAD::vector<size_t>&  start   ,
+   CppAD::vector<size_t>&  index   ,
+   CppAD::vector<size_t>&  t_start ,
+   CppAD::vector<size_t>&  t_index )
+{  size_t n_set = pattern.n_set();
+   size_t end   = pattern.end();
+   //
+   // start, t_start
+   start.resize(n_set + 1);
+   t_start.resize(end + 1);
+   for(size_t j = 0; j <= end; ++j)
+      t_start[j] = 0;
+   start[0] = 0;
+   for(size_t i = 0; i < n_set; ++i)
+   {  start[i+1] = start[i];
+      typename SetVector::const_iterator itr(pattern, i);
+      size_t j = *itr;
+      while( j != end )
+      {  ++start[i+1];
+         ++t_start[j+1];
+         j = *(++itr);
+      }
+   }
+   for(size_t j = 0; j < end; ++j)
+      t_start[j+1] += t_start[j];
+   //
+   // index, t_index
+   size_t nnz = start[n_set];
+   index.resize(nnz);
+   t_index.resize(nnz);
+   CppAD::vector<size_t> t_next(end);
+   for(size_t j = 0; j < end; ++j)
+      t_next[j] = t_start[j];
+   for(size_t i = 0; i < n_set; ++i)
+   {  size_t k = start[i];
+      typename SetVector::const_iterator itr(pattern, i);
+      size_t j = *itr;
+      while( j != end )
+      {  index[k++]           = j;
+         t_index[t_next[j]++] = i;
+         j = *(++itr);
+      }
+   }
+}
+
+/*!
+Bucket priority queue for the non-negative integer degree of each vertex.
+
+Each vertex is in the bucket corresponding to its current key
+and the buckets are doubly linked lists, so changing a key is O(1).
+*/
+class color_bucket {
+private:
+   // number of vertices
+   size_t n_;
+   // head_[d] is first vertex with key d (n_ if empty)
+   CppAD::vector<size_t> head_;
+   // next_[v], prev_[v] are the next and previous vertices in list for v
+   CppAD::vector<size_t> next_;
+   CppAD::vector<size_t> prev_;
+   // key_[v] is the key for vertex v (n_key_ if v is not in the queue)
+   CppAD::vector<size_t> key_;
+   // number of possible keys
+   size_t n_key_;
+   //
+   void remove_list(size_t v)
+   {  size_t d = key_[v];
+      if( prev_[v] == n_ )
+         head_[d] = next_[v];
+      else
+         next_[ prev_[v] ] = next_[v];
+      if( next_[v] != n_ )
+         prev_[ next_[v] ] = prev_[v];
+   }
+   void insert_list(size_t v)
+   {  size_t d = key_[v];
+      prev_[v] = n_;
+      next_[v] = head_[d];
+      if( head_[d] != n_ )
+         prev_[ head_[d] ] = v;
+      head_[d] = v;
+   }
+public:
+   /// constructor: n vertices with keys less than n_key
+   color_bucket(size_t n, size_t n_key)
+   : n_(n), head_(n_key), next_(n), prev_(n), key_(n), n_key_(n_key)
+   {  for(size_t d = 0; d < n_key; ++d)
+         head_[d] = n;
+      for(size_t v = 0; v < n; ++v)
+         key_[v] = n_key;
+   }
+   /// is vertex v in the queue
+   bool in_queue(size_t v) const
+   {  return key_[v] < n_key_; }
+   /// key for a vertex in the queue
+   size_t key(size_t v) const
+   {  return key_[v]; }
+   /// first vertex with key d (n if there is none)
+   size_t head(size_t d) const
+   {  return head_[d]; }
+   /// add vertex v to the queue with key d
+   void insert(size_t v, size_t d)
+   {  CPPAD_ASSERT_UNKNOWN( ! in_queue(v) && d < n_key_ );
+      key_[v] = d;
+      insert_list(v);
+   }
+   /// remove vertex v from the queue
+   void remove(size_t v)
+   {  CPPAD_ASSERT_UNKNOWN( in_queue(v) );
+      remove_list(v);
+      key_[v] = n_key_;
+   }
+   /// change the key for vertex v to d
+   void change(size_t v, size_t d)
+   {  CPPAD_ASSERT_UNKNOWN( in_queue(v) && d < n_key_ );
+      remove_list(v);
+      key_[v] = d;
+      insert_list(v);
+   }
+};
+
+/*!
+Determine the order in which to color vertices.
+
+The graph is specified using a bipartite representation:
+two vertices are neighbors if they are both members of the same group.
+A vertex that shares more than one group with another vertex
+is counted once for each shared group. This is the distance two degree
+(used for general matrices) when the groups are the columns of the
+matrix and the vertices are its rows. It is the usual degree
+(used for symmetric matrices) when there is one group for each edge.
+
+\param n_vertex
+is the number of vertices.
+
+\param v2g_start, v2g_index
+the groups that vertex v is in are
+v2g_index[k] for k = v2g_start[v], ... , v2g_start[v+1]-1.
+
+\param g2v_start, g2v_index
+the vertices that are in group g are
+g2v_index[k] for k = g2v_start[g], ... , g2v_start[g+1]-1.
+
+\param appear
+appear[v] is true if vertex v is to be colored.
+Vertices that do not appear are ignored when computing degrees
+and placed at the end of the order.
+
+\param order_type
+is the ordering heuristic.
+
+\param order2vertex [out]
+is a vector of length n_vertex.
+On output, order2vertex[o] is the o-th vertex in the coloring order.
+*/
+inline void color_order(
+   size_t                        n_vertex     ,
+   const CppAD::vector<size_t>&  v2g_start    ,
+   const CppAD::vector<size_t>&  v2g_index    ,
+   const CppAD::vector<size_t>&  g2v_start    ,
+   const CppAD::vector<size_t>&  g2v_index    ,
+   const CppAD::vector<bool>&    appear       ,
+   color_order_enum              order_type   ,
+   CppAD::vector<size_t>&        order2vertex )
+{  CPPAD_ASSERT_UNKNOWN( v2g_start.size() == n_vertex + 1 );
+   CPPAD_ASSERT_UNKNOWN( appear.size() == n_vertex );
+   size_t n_group = g2v_start.size() - 1;
+   order2vertex.resize(n_vertex);
+   //
+   // n_appear
+   size_t n_appear = 0;
+   for(size_t v = 0; v < n_vertex; ++v)
+      if( appear[v] )
+         ++n_appear;
+   //
+   // vertices that do not appear go at the end
+   size_t o_end = n_vertex;
+   for(size_t v = n_vertex; v > 0; --v)
+      if( ! appear[v-1] )
+         order2vertex[--o_end] = v-1;
+   CPPAD_ASSERT_UNKNOWN( o_end == n_appear );
+   //
+   if( order_type == natural_order )
+   {  size_t o = 0;
+      for(size_t v = 0; v < n_vertex; ++v)
+         if( appear[v] )
+            order2vertex[o++] = v;
+      return;
+   }
+   //
+   // group_size
+   // number of vertices in each group that appear
+   CppAD::vector<size_t> group_size(n_group);
+   for(size_t g = 0; g < n_group; ++g)
+   {  group_size[g] = 0;
+      for(size_t k = g2v_start[g]; k < g2v_start[g+1]; ++k)
+         if( appear[ g2v_index[k] ] )
+            ++group_size[g];
+   }
+   //
+   // degree
+   size_t max_degree = 0;
+   CppAD::vector<size_t> degree(n_vertex);
+   for(size_t v = 0; v < n_vertex; ++v)
+   {  degree[v] = 0;
+      if( appear[v] )
+      {  for(size_t k = v2g_start[v]; k < v2g_start[v+1]; ++k)
+            degree[v] += group_size[ v2g_index[k] ] - 1;
+      }
+      max_degree = std::max(max_degree, degree[v]);
+   }
+   //
+   if( order_type == largest_first_order )
+   {  // counting sort by decreasing degree (stable with respect to index)
+      CppAD::vector<size_t> count(max_degree + 2);
+      for(size_t d = 0; d < max_degree + 2; ++d)
+         count[d] = 0;
+      for(size_t v = 0; v < n_vertex; ++v)
+         if( appear[v] )
+            ++count[ max_degree - degree[v] + 1 ];
+      for(size_t d = 1; d < max_degree + 2; ++d)
+         count[d] += count[d-1];
+      for(size_t v = 0; v < n_vertex; ++v)
+         if( appear[v] )
+            order2vertex[ count[ max_degree - degree[v] ]++ ] = v;
+      return;
+   }
+   //
+   // queue
+   color_bucket queue(n_vertex, max_degree + 1);
+   //
+   if( order_type == smallest_last_order )
+   {  for(size_t v = 0; v < n_vertex; ++v)
+         if( appear[v] )
+            queue.insert(v, degree[v]);
+      //
+      // min_degree is a lower bound for the smallest key in the queue
+      size_t min_degree = 0;
+      for(size_t o = n_appear; o > 0; --o)
+      {  while( queue.head(min_degree) == n_vertex )
+            ++min_degree;
+         size_t v = queue.head(min_degree);
+         queue.remove(v);
+         order2vertex[o-1] = v;
+         //
+         // remove v from the graph
+         for(size_t k = v2g_start[v]; k < v2g_start[v+1]; ++k)
+         {  size_t g = v2g_index[k];
+            for(size_t ell = g2v_start[g]; ell < g2v_start[g+1]; ++ell)
+            {  size_t u = g2v_index[ell];
+               if( u != v && queue.in_queue(u) )
+               {  size_t d = queue.key(u) - 1;
+                  queue.change(u, d);
+                  min_degree = std::min(min_degree, d);
+               }
+            }
+         }
+      }
+      return;
+   }
+   CPPAD_ASSERT_UNKNOWN( order_type == incidence_degree_order );
+   //
+   // incidence degree of each vertex starts at zero
+   for(size_t v = 0; v < n_vertex; ++v)
+      if( appear[v] )
+         queue.insert(v, 0);
+   //
+   // max_incidence is an upper bound for the largest key in the queue
+   size_t max_incidence = 0;
+   for(size_t o = 0; o < n_appear; ++o)
+   {  while( queue.head(max_incidence) == n_vertex )
+         --max_incidence;
+      size_t v = queue.head(max_incidence);
+      queue.remove(v);
+      order2vertex[o] = v;
+      //
+      // increment incidence for neighbors of v that are not yet ordered
+      for(size_t k = v2g_start[v]; k < v2g_start[v+1]; ++k)
+      {  size_t g = v2g_index[k];
+         for(size_t ell = g2v_start[g]; ell < g2v_start[g+1]; ++ell)
+         {  size_t u = g2v_index[ell];
+            if( u != v && queue.in_queue(u) )
+            {  size_t d = queue.key(u) + 1;
+               queue.change(u, d);
+               max_incidence = std::max(max_incidence, d);
+            }
+         }
+      }
+   }
+   return;
+}
+
+// --------------------------------------------------------------------------
+/*!
+Lower bound for the number of colors in a general (distance two) coloring.
+
+\param n_row
+is the number of rows in the matrix.
+
+\param row
+is the row index for each of the entries that are needed.
+The column indices for these entries are assumed to be distinct
+for each row; i.e., there are no repeated entries.
+Entries in the same row must be in different columns and hence
+the columns must have different colors.
+
+\return
+the maximum, with respect to i, of the number of needed entries in row i.
+*/
+template <class SizeVector>
+size_t color_general_lower_bound(size_t n_row, const SizeVector& row)
+{  CppAD::vector<size_t> count(n_row);
+   for(size_t i = 0; i < n_row; ++i)
+      count[i] = 0;
+   size_t bound = 0;
+   for(size_t k = 0; k < size_t( row.size() ); ++k)
+      bound = std::max(bound, ++count[ row[k] ]);
+   return bound;
+}
+/*!
+Lower bound for the number of colors in a symmetric coloring.
+
+The graph with an edge for each needed off diagonal entry is considered.
+If all its entries can be recovered, either directly or by substitution,
+every two colored sub-graph must be a forest. Hence the number of edges
+is less than or equal (n_color - 1) times the number of vertices.
+
+\param n
+is the number of rows (and columns) in the matrix.
+
+\param row, col
+are the row and column indices for the entries that are needed.
+
+\return
+the lower bound.
+*/
+template <class SizeVector>
+size_t color_symmetric_lower_bound(
+   size_t n, const SizeVector& row, const SizeVector& col)
+{  size_t K = size_t( row.size() );
+   if( K == 0 )
+      return 0;
+   CppAD::vector<bool> appear(n);
+   for(size_t i = 0; i < n; ++i)
+      appear[i] = false;
+   CppAD::vector< std::pair<size_t, size_t> > edge;
+   for(size_t k = 0; k < K; ++k)
+   {  appear[ row[k] ] = true;
+      appear[ col[k] ] = true;
+      if( row[k] != col[k] ) edge.push_back( std::make_pair(
+         std::min(row[k], col[k]), std::max(row[k], col[k])
+      ) );
+   }
+   std::sort(edge.data(), edge.data() + edge.size());
+   size_t n_edge = 0;
+   for(size_t ell = 0; ell < edge.size(); ++ell)
+      if( ell == 0 || edge[ell-1] != edge[ell] )
+         ++n_edge;
+   size_t n_vertex = 0;
+   for(size_t i = 0; i < n; ++i)
+      if( appear[i] )
+         ++n_vertex;
+   return 1 + (n_edge + n_vertex - 1) / n_vertex;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
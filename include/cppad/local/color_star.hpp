@@ -0,0 +1,326 @@
+# ifndef CPPAD_LOCAL_COLOR_STAR_HPP
+# define CPPAD_LOCAL_COLOR_STAR_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <algorithm>
+# include <cppad/local/color_order.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_star.hpp
+Star coloring algorithm for a symmetric sparse matrix.
+*/
+// --------------------------------------------------------------------------
+/*!
+Adjacency graph for the rows of a symmetric sparse matrix
+that are needed to compute a subset of its entries.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\param pattern [in]
+is the sparsity pattern for the matrix. This is symmetrized; i.e.,
+(i, j) is treated as non-zero if (i, j) or (j, i) is in pattern.
+
+\param row, col [in]
+the entries (row[k], col[k]) are the entries that are needed.
+
+\param appear [out]
+is a vector of length m.
+On output, appear[i] is true if i is equal to row[k] or col[k] for some k.
+
+\param adj_start, adj_index [out]
+the neighbors of vertex i are adj_index[ell]
+for ell = adj_start[i], ..., adj_start[i+1]-1 (in increasing order).
+Only vertices that appear have neighbors and
+only vertices that appear are neighbors.
+The diagonal is not included.
+
+\param n_edge [out]
+is the number of edges in the graph; i.e., half adj_index.size().
+*/
+template <class SetVector>
+void color_adjacency(
+   const SetVector&              pattern   ,
+   const CppAD::vector<size_t>&  row       ,
+   const CppAD::vector<size_t>&  col       ,
+   CppAD::vector<bool>&          appear    ,
+   CppAD::vector<size_t>&        adj_start ,
+   CppAD::vector<size_t>&        adj_index ,
+   size_t&                       n_edge    )
+{  size_t m = pattern.n_set();
+   size_t K = row.size();
+   CPPAD_ASSERT_UNKNOWN( m == pattern.end() );
+   CPPAD_ASSERT_UNKNOWN( col.size() == K );
+   //
+   // appear
+   appear.resize(m);
+   for(size_t i = 0; i < m; ++i)
+      appear[i] = false;
+   for(size_t k = 0; k < K; ++k)
+   {  CPPAD_ASSERT_UNKNOWN( pattern.is_element(row[k], col[k]) );
+      appear[ row[k] ] = true;
+      appear[ col[k] ] = true;
+   }
+   //
+   // r2c, c2r
+   CppAD::vector<size_t> r2c_start, r2c_index, c2r_start, c2r_index;
+   color_csr(pattern, r2c_start, r2c_index, c2r_start, c2r_index);
+   //
+   // adj_start, adj_index
+   adj_start.resize(m + 1);
+   adj_index.resize(0);
+   adj_start[0] = 0;
+   CppAD::vector<size_t> work;
+   for(size_t i = 0; i < m; ++i)
+   {  work.resize(0);
+      if( appear[i] )
+      {  for(size_t ell = r2c_start[i]; ell < r2c_start[i+1]; ++ell)
+         {  size_t j = r2c_index[ell];
+            if( j != i && appear[j] )
+               work.push_back(j);
+         }
+         for(size_t ell = c2r_start[i]; ell < c2r_start[i+1]; ++ell)
+         {  size_t j = c2r_index[ell];
+            if( j != i && appear[j] )
+               work.push_back(j);
+         }
+         std::sort(work.data(), work.data() + work.size());
+         size_t previous = m;
+         for(size_t ell = 0; ell < work.size(); ++ell)
+         {  if( work[ell] != previous )
+               adj_index.push_back( work[ell] );
+            previous = work[ell];
+         }
+      }
+      adj_start[i+1] = adj_index.size();
+   }
+   n_edge = adj_index.size() / 2;
+}
+// --------------------------------------------------------------------------
+/*!
+Coloring order for a symmetric adjacency graph.
+
+\param appear, adj_start, adj_index, n_edge [in]
+is the graph; see color_adjacency.
+
+\param order_type [in]
+is the ordering heuristic.
+
+\param order2vertex [out]
+is the order in which the vertices are colored.
+*/
+inline void color_adjacency_order(
+   const CppAD::vector<bool>&    appear       ,
+   const CppAD::vector<size_t>&  adj_start    ,
+   const CppAD::vector<size_t>&  adj_index    ,
+   size_t                        n_edge       ,
+   color_order_enum              order_type   ,
+   CppAD::vector<size_t>&        order2vertex )
+{  size_t m = appear.size();
+   //
+   // each edge is a group with two vertices
+   CppAD::vector<size_t> v2g_start(m + 1), v2g_index( adj_index.size() );
+   CppAD::vector<size_t> g2v_start(n_edge + 1), g2v_index(2 * n_edge);
+   size_t e = 0;
+   for(size_t i = 0; i < m; ++i)
+   {  v2g_start[i] = adj_start[i];
+      for(size_t ell = adj_start[i]; ell < adj_start[i+1]; ++ell)
+      {  size_t j = adj_index[ell];
+         if( i < j )
+         {  g2v_start[e]     = 2 * e;
+            g2v_index[2 * e] = i;
+            g2v_index[2*e+1] = j;
+            v2g_index[ell]   = e++;
+         }
+      }
+   }
+   v2g_start[m]      = adj_start[m];
+   g2v_start[n_edge] = 2 * n_edge;
+   CPPAD_ASSERT_UNKNOWN( e == n_edge );
+   //
+   // edge index for (i, j) with i > j
+   for(size_t i = 0; i < m; ++i)
+   {  for(size_t ell = adj_start[i]; ell < adj_start[i+1]; ++ell)
+      {  size_t j = adj_index[ell];
+         if( j < i )
+         {  const size_t* begin = adj_index.data() + adj_start[j];
+            const size_t* end   = adj_index.data() + adj_start[j+1];
+            size_t  pos   = size_t( std::lower_bound(begin, end, i) - begin );
+            v2g_index[ell] = v2g_index[ adj_start[j] + pos ];
+         }
+      }
+   }
+   color_order(m, v2g_start, v2g_index, g2v_start, g2v_index,
+      appear, order_type, order2vertex
+   );
+}
+// --------------------------------------------------------------------------
+/*!
+CppAD star coloring algorithm for determining which rows of a
+symmetric sparse matrix can be computed together.
+
+A star coloring is a distance one coloring where every path that
+has four vertices uses at least three colors.
+It follows that, for each non-zero (i, j), either color[j] is unique
+among the neighbors of i or color[i] is unique among the neighbors of j
+and hence (i, j) can be recovered directly.
+
+\tparam SetVector
+is a vector_of_sets class.
+
+\param pattern [in]
+Is a representation of the sparsity pattern for the matrix.
+
+\param row [in/out]
+is a vector specifying which row indices to compute.
+
+\param col [in/out]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+On output, some of row and column indices may have been swapped
+so the the color for row[k] can be used to compute entry
+(row[k], col[k]); see color_symmetric_cppad.
+
+\param color [out]
+is a vector with size m.
+Upon return, it is a coloring for the rows of the sparse matrix.
+If color[i] == m, then i is not equal row[k] for any k (on output).
+Each color less than m is used by some row[k].
+
+\param order_type [in]
+is the order in which the rows are colored; see color_order_enum.
+*/
+template <class SetVector>
+void color_star_cppad(
+   const SetVector&        pattern                         ,
+   CppAD::vector<size_t>&  row                             ,
+   CppAD::vector<size_t>&  col                             ,
+   CppAD::vector<size_t>&  color                           ,
+   color_order_enum        order_type = smallest_last_order )
+{  size_t m = pattern.n_set();
+   size_t K = row.size();
+   CPPAD_ASSERT_UNKNOWN( color.size() == m );
+   //
+   // appear, adj_start, adj_index, n_edge
+   CppAD::vector<bool>   appear;
+   CppAD::vector<size_t> adj_start, adj_index;
+   size_t n_edge;
+   color_adjacency(pattern, row, col, appear, adj_start, adj_index, n_edge);
+   //
+   // order2vertex
+   CppAD::vector<size_t> order2vertex;
+   color_adjacency_order(
+      appear, adj_start, adj_index, n_edge, order_type, order2vertex
+   );
+   //
+   // color
+   for(size_t i = 0; i < m; ++i)
+      color[i] = m;
+   //
+   // forbidden[c] == v if color c is forbidden for vertex v
+   CppAD::vector<size_t> forbidden(m + 1);
+   // count[c] number of neighbors of v with color c (if count_v[c] == v)
+   CppAD::vector<size_t> count(m + 1), count_v(m + 1);
+   for(size_t c = 0; c <= m; ++c)
+      forbidden[c] = count_v[c] = m;
+   //
+   for(size_t o = 0; o < m; ++o) if( appear[ order2vertex[o] ] )
+   {  size_t v = order2vertex[o];
+      //
+      // distance one neighbors
+      for(size_t ell = adj_start[v]; ell < adj_start[v+1]; ++ell)
+      {  size_t w  = adj_index[ell];
+         size_t cw = color[w];
+         if( cw < m )
+         {  forbidden[cw] = v;
+            if( count_v[cw] != v )
+            {  count_v[cw] = v;
+               count[cw]   = 0;
+            }
+            ++count[cw];
+         }
+      }
+      //
+      // paths with four vertices that contain v
+      for(size_t ell = adj_start[v]; ell < adj_start[v+1]; ++ell)
+      {  size_t w  = adj_index[ell];
+         size_t cw = color[w];
+         if( cw < m )
+         {  bool v_interior = count[cw] > 1;
+            for(size_t k = adj_start[w]; k < adj_start[w+1]; ++k)
+            {  size_t x  = adj_index[k];
+               size_t cx = color[x];
+               if( x != v && cx < m && forbidden[cx] != v )
+               {  // path u - v - w - x where color[u] == color[w]
+                  if( v_interior )
+                     forbidden[cx] = v;
+                  else
+                  {  // path v - w - x - y where color[y] == color[w]
+                     for(size_t q = adj_start[x]; q < adj_start[x+1]; ++q)
+                     {  size_t y = adj_index[q];
+                        if( y != w && color[y] == cw )
+                        {  forbidden[cx] = v;
+                           break;
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+      //
+      // pick the color with smallest index
+      size_t c = 0;
+      while( forbidden[c] == v )
+         ++c;
+      color[v] = c;
+   }
+   //
+   // determine which entries need to be reflected
+   for(size_t k = 0; k < K; ++k)
+   {  size_t i = row[k];
+      size_t j = col[k];
+      bool unique = true;
+      for(size_t ell = adj_start[j]; ell < adj_start[j+1]; ++ell)
+      {  size_t r = adj_index[ell];
+         if( r != i && color[r] == color[i] )
+            unique = false;
+      }
+      if( ! unique )
+      {  row[k] = j;
+         col[k] = i;
+      }
+   }
+   //
+   // Only the colors for row[k] are used to compute entries. Removing the
+   // other vertices from the directions does not change the recovered values
+   // and the colors that remain are renumbered so they are all used.
+   CppAD::vector<size_t> new_color(m + 1);
+   for(size_t c = 0; c <= m; ++c)
+      new_color[c] = m;
+   for(size_t k = 0; k < K; ++k)
+      new_color[ color[ row[k] ] ] = 0;
+   size_t n_color = 0;
+   for(size_t c = 0; c < m; ++c)
+      if( new_color[c] == 0 )
+         new_color[c] = n_color++;
+   for(size_t i = 0; i < m; ++i)
+      appear[i] = false;
+   for(size_t k = 0; k < K; ++k)
+      appear[ row[k] ] = true;
+   for(size_t i = 0; i < m; ++i)
+   {  if( appear[i] )
+         color[i] = new_color[ color[i] ];
+      else
+         color[i] = m;
+   }
+   return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_DECLARE_AD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/configure.hpp>
@@ -39,6 +39,7 @@ namespace CppAD {
    // classes
    class sparse_hes_work;
    class sparse_jac_work;
+   class sparse_jac_bidir_work;
    class sparse_jacobian_work;
    class sparse_hessian_work;
    template <class Base> class AD;
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OP_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // used by the sparse operators
@@ -29,6 +29,7 @@
 # include <cppad/local/op/erf_op.hpp>
 # include <cppad/local/op/exp_op.hpp>
 # include <cppad/local/op/expm1_op.hpp>
+# include <cppad/local/op/fma_op.hpp>
 # include <cppad/local/op/load_op.hpp>
 # include <cppad/local/op/log_op.hpp>
 # include <cppad/local/op/log1p_op.hpp>
@@ -47,6 +48,7 @@
 # include <cppad/local/op/store_op.hpp>
 # include <cppad/local/op/tan_op.hpp>
 # include <cppad/local/op/tanh_op.hpp>
+# include <cppad/local/op/wsum_op.hpp>
 # include <cppad/local/op/zmul_op.hpp>
 
 
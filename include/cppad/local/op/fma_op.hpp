@@ -0,0 +1,171 @@
+# ifndef CPPAD_LOCAL_OP_FMA_OP_HPP
+# define CPPAD_LOCAL_OP_FMA_OP_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file fma_op.hpp
+Forward and reverse mode calculations for z = a * b + c where a and b are
+variables and c is a parameter (FmavvpOp) or a variable (FmavvvOp).
+
+The arguments to these routines are the same as for the corresponding
+binary operator routines; e.g., forward_binary_op and reverse_binary_op,
+except that there is an extra argument op which is FmavvpOp or FmavvvOp.
+*/
+
+// See dev documentation: forward_binary_op
+template <class Base>
+void forward_fma_op(
+   size_t        p           ,
+   size_t        q           ,
+   OpCode        op          ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   Base*         taylor      )
+{
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( op == FmavvpOp || op == FmavvvOp );
+   CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+   CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+   CPPAD_ASSERT_UNKNOWN( q < cap_order );
+   CPPAD_ASSERT_UNKNOWN( p <= q );
+
+   // Taylor coefficients corresponding to arguments and result
+   Base* a = taylor + size_t(arg[0]) * cap_order;
+   Base* b = taylor + size_t(arg[1]) * cap_order;
+   Base* z = taylor + i_z    * cap_order;
+
+   for(size_t d = p; d <= q; d++)
+   {  z[d] = Base(0.0);
+      for(size_t k = 0; k <= d; k++)
+         z[d] += a[d-k] * b[k];
+   }
+   if( op == FmavvvOp )
+   {  Base* c = taylor + size_t(arg[2]) * cap_order;
+      for(size_t d = p; d <= q; d++)
+         z[d] += c[d];
+   }
+   else if( p == 0 )
+      z[0] += parameter[ arg[2] ];
+}
+
+// See dev documentation: forward_binary_op
+template <class Base>
+void forward_fma_op_dir(
+   size_t        q           ,
+   size_t        r           ,
+   OpCode        op          ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   Base*         taylor      )
+{
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( op == FmavvpOp || op == FmavvvOp );
+   CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+   CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+   CPPAD_ASSERT_UNKNOWN( 0 < q );
+   CPPAD_ASSERT_UNKNOWN( q < cap_order );
+
+   // Taylor coefficients corresponding to arguments and result
+   size_t num_taylor_per_var = (cap_order-1) * r + 1;
+   Base* a = taylor + size_t(arg[0]) * num_taylor_per_var;
+   Base* b = taylor + size_t(arg[1]) * num_taylor_per_var;
+   Base* z = taylor +    i_z * num_taylor_per_var;
+
+   for(size_t ell = 0; ell < r; ell++)
+   {  size_t m = (q-1)*r + ell + 1;
+      z[m] = a[0] * b[m] + a[m] * b[0];
+      for(size_t k = 1; k < q; k++)
+         z[m] += a[(q-k-1)*r + ell + 1] * b[(k-1)*r + ell + 1];
+   }
+   if( op == FmavvvOp )
+   {  Base* c = taylor + size_t(arg[2]) * num_taylor_per_var;
+      size_t m = (q-1) * r + 1;
+      for(size_t ell = 0; ell < r; ell++)
+         z[m+ell] += c[m+ell];
+   }
+}
+
+// See dev documentation: forward_binary_op
+template <class Base>
+void forward_fma_op_0(
+   OpCode        op          ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   Base*         taylor      )
+{
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( op == FmavvpOp || op == FmavvvOp );
+   CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+   CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+
+   // Taylor coefficients corresponding to arguments and result
+   Base* a = taylor + size_t(arg[0]) * cap_order;
+   Base* b = taylor + size_t(arg[1]) * cap_order;
+   Base* z = taylor + i_z    * cap_order;
+
+   if( op == FmavvvOp )
+      z[0] = a[0] * b[0] + taylor[ size_t(arg[2]) * cap_order ];
+   else
+      z[0] = a[0] * b[0] + parameter[ arg[2] ];
+}
+
+// See dev documentation: reverse_binary_op
+template <class Base>
+void reverse_fma_op(
+   size_t        d           ,
+   OpCode        op          ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   const Base*   taylor      ,
+   size_t        nc_partial  ,
+   Base*         partial     )
+{
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( op == FmavvpOp || op == FmavvvOp );
+   CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+   CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+   CPPAD_ASSERT_UNKNOWN( d < cap_order );
+   CPPAD_ASSERT_UNKNOWN( d < nc_partial );
+
+   // Arguments
+   const Base* a  = taylor + size_t(arg[0]) * cap_order;
+   const Base* b  = taylor + size_t(arg[1]) * cap_order;
+
+   // Partial derivatives corresponding to arguments and result
+   Base* pa = partial + size_t(arg[0]) * nc_partial;
+   Base* pb = partial + size_t(arg[1]) * nc_partial;
+   Base* pz = partial + i_z    * nc_partial;
+
+   // number of indices to access
+   size_t j = d + 1;
+   while(j)
+   {  --j;
+      for(size_t k = 0; k <= j; k++)
+      {
+         // must use azmul because pz[j] = 0 may mean that this
+         // component of the function was not selected.
+         pa[j-k] += azmul(pz[j], b[k]);
+         pb[k]   += azmul(pz[j], a[j-k]);
+      }
+   }
+   if( op == FmavvvOp )
+   {  Base* pc = partial + size_t(arg[2]) * nc_partial;
+      for(size_t i = 0; i <= d; ++i)
+         pc[i] += pz[i];
+   }
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
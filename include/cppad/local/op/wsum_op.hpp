@@ -0,0 +1,570 @@
+# ifndef CPPAD_LOCAL_OP_WSUM_OP_HPP
+# define CPPAD_LOCAL_OP_WSUM_OP_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file wsum_op.hpp
+Forward, reverse and sparsity calculations for weighted summation.
+
+This operation is
+\verbatim
+   z = p(0) * x(0) + ... + p(n1-1) * x(n1-1)
+     - p(n1) * x(n1) - ... - p(n2-1) * x(n2-1)
+     + u(0) * v(0) + ... + u(n3-1) * v(n3-1)
+     - u(n3) * v(n3) - ... - u(n4-1) * v(n4-1)
+\endverbatim
+where the p(i) are parameters and the x(i), u(i), v(i) are variables.
+The weights p(i) may be constant or dynamic parameters.
+
+The arguments for this operator are:
+
+-- arg[0]
+end in arg of addition parameter variable pairs.
+arg[4] , arg[5] correspond to p(0) , x(0) (if n1 > 0); i.e.,
+parameter[ arg[4] ] is p(0) and arg[5] is the variable index for x(0).
+
+-- arg[1]
+end in arg of subtraction parameter variable pairs.
+arg[ arg[0] ] , arg[ arg[0] + 1 ] correspond to p(n1) , x(n1) (if n2 > n1).
+
+-- arg[2]
+end in arg of addition variable variable pairs.
+arg[ arg[1] ] , arg[ arg[1] + 1 ] correspond to u(0) , v(0) (if n3 > 0).
+
+-- arg[3]
+end in arg of subtraction variable variable pairs.
+arg[ arg[2] ] , arg[ arg[2] + 1 ] correspond to u(n3) , v(n3) (if n4 > n3).
+
+-- arg[ arg[3] ]
+is equal to arg[3] so that the number of arguments, arg[3] + 1,
+can be determined when iterating in reverse.
+
+The loops below are over contiguous Taylor coefficients (or directions)
+for one term so that they can be vectorized by the compiler.
+*/
+
+/*!
+Compute forward mode Taylor coefficients for result of op = WSumOp.
+
+\param p
+lowest order of the Taylor coefficient that we are computing.
+
+\param q
+highest order of the Taylor coefficient that we are computing.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the row index in taylor corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param num_par
+is the number of parameters in parameter.
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\param cap_order
+number of colums in the matrix containing all the Taylor coefficients.
+
+\param taylor
+\b Input: the Taylor coefficients of order zero through q for
+the variables x(i), u(i), v(i).
+\n
+\b Input: taylor [ i_z * cap_order + k ]
+for k = 0 , ... , p-1,
+is the k-th order Taylor coefficient corresponding to z.
+\n
+\b Output: taylor [ i_z * cap_order + k ]
+for k = p , ... , q,
+is the k-th order Taylor coefficient corresponding to z.
+*/
+template <class Base>
+void forward_wsum_op(
+   size_t        p           ,
+   size_t        q           ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   size_t        num_par     ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   Base*         taylor      )
+{  Base zero(0);
+
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( NumRes(WSumOp) == 1 );
+   CPPAD_ASSERT_UNKNOWN( q < cap_order );
+   CPPAD_ASSERT_UNKNOWN( p <= q );
+   CPPAD_ASSERT_UNKNOWN( arg[arg[3]] == arg[3] );
+
+   // Taylor coefficients corresponding to result
+   Base* z = taylor + i_z * cap_order;
+   for(size_t k = p; k <= q; k++)
+      z[k] = zero;
+   //
+   // parameter variable pairs
+   for(size_t i = 4; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < num_par );
+      CPPAD_ASSERT_UNKNOWN( size_t(arg[i+1]) < i_z );
+      Base w = parameter[ arg[i] ];
+      if( i >= size_t(arg[0]) )
+         w = - w;
+      const Base* x = taylor + size_t(arg[i+1]) * cap_order;
+      for(size_t k = p; k <= q; k++)
+         z[k] += w * x[k];
+   }
+   //
+   // variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      CPPAD_ASSERT_UNKNOWN( size_t(arg[i+1]) < i_z );
+      const Base* u = taylor + size_t(arg[i])   * cap_order;
+      const Base* v = taylor + size_t(arg[i+1]) * cap_order;
+      if( i < size_t(arg[2]) )
+      {  for(size_t d = p; d <= q; d++)
+            for(size_t k = 0; k <= d; k++)
+               z[d] += u[d-k] * v[k];
+      }
+      else
+      {  for(size_t d = p; d <= q; d++)
+            for(size_t k = 0; k <= d; k++)
+               z[d] -= u[d-k] * v[k];
+      }
+   }
+}
+
+/*!
+Multiple direction forward mode Taylor coefficients for op = WSumOp.
+
+\param q
+order ot the Taylor coefficients that we are computing.
+
+\param r
+number of directions for Taylor coefficients that we are computing.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the row index in taylor corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param num_par
+is the number of parameters in parameter.
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\param cap_order
+number of colums in the matrix containing all the Taylor coefficients.
+
+\param taylor
+\b Input: taylor [ j * ((cap_order-1)*r + 1) + 0 ]
+is the zero order Taylor coefficient for variable index j and
+taylor [ j * ((cap_order-1)*r + 1) + (k-1)*r + ell + 1 ]
+is the k-th order Taylor coefficient for direction ell,
+k = 1 , ... , q, for the variables x(i), u(i), v(i).
+\n
+\b Output: taylor [ i_z*((cap_order-1)*r+1) + (q-1)*r + ell + 1 ]
+is the q-th order Taylor coefficient corresponding to z
+for direction ell = 0 , ... , r-1.
+*/
+template <class Base>
+void forward_wsum_op_dir(
+   size_t        q           ,
+   size_t        r           ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   size_t        num_par     ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   Base*         taylor      )
+{  Base zero(0);
+
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( NumRes(WSumOp) == 1 );
+   CPPAD_ASSERT_UNKNOWN( q < cap_order );
+   CPPAD_ASSERT_UNKNOWN( 0 < q );
+   CPPAD_ASSERT_UNKNOWN( arg[arg[3]] == arg[3] );
+
+   // Taylor coefficients corresponding to result
+   size_t num_taylor_per_var = (cap_order-1) * r + 1;
+   size_t m                  = (q-1)*r + 1;
+   Base* z = taylor + i_z * num_taylor_per_var;
+   for(size_t ell = 0; ell < r; ell++)
+      z[m+ell] = zero;
+   //
+   // parameter variable pairs
+   for(size_t i = 4; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < num_par );
+      CPPAD_ASSERT_UNKNOWN( size_t(arg[i+1]) < i_z );
+      Base w = parameter[ arg[i] ];
+      if( i >= size_t(arg[0]) )
+         w = - w;
+      const Base* x = taylor + size_t(arg[i+1]) * num_taylor_per_var;
+      for(size_t ell = 0; ell < r; ell++)
+         z[m+ell] += w * x[m+ell];
+   }
+   //
+   // variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      CPPAD_ASSERT_UNKNOWN( size_t(arg[i+1]) < i_z );
+      const Base* u = taylor + size_t(arg[i])   * num_taylor_per_var;
+      const Base* v = taylor + size_t(arg[i+1]) * num_taylor_per_var;
+      bool add = i < size_t(arg[2]);
+      for(size_t ell = 0; ell < r; ell++)
+      {  Base sum = u[0] * v[m+ell] + u[m+ell] * v[0];
+         for(size_t k = 1; k < q; k++)
+            sum += u[(q-k-1)*r + ell + 1] * v[(k-1)*r + ell + 1];
+         if( add )
+            z[m+ell] += sum;
+         else
+            z[m+ell] -= sum;
+      }
+   }
+}
+
+/*!
+Compute reverse mode partial derivatives for result of op = WSumOp.
+
+\param d
+order the highest order Taylor coefficient that we are computing
+the partial derivatives with respect to.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the row index in taylor corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param parameter
+is the parameter vector for this operation sequence.
+
+\param cap_order
+number of colums in the matrix containing all the Taylor coefficients.
+
+\param taylor
+contains the Taylor coefficients of order zero through d for
+the variables u(i), v(i).
+
+\param nc_partial
+number of colums in the matrix containing all the partial derivatives.
+
+\param partial
+\b Input: partial [ i_z * nc_partial + k ] for k = 0 , ... , d
+is the partial derivative of G(z, ...) with respect to the
+k-th order Taylor coefficient corresponding to z.
+\n
+\b Input: partial [ j * nc_partial + k ] for k = 0 , ... , d
+where j is the index for one of the variables x(i), u(i), v(i),
+is the partial derivative of G with respect to the
+k-th order Taylor coefficient corresponding to this variable.
+\n
+\b Output: partial [ j * nc_partial + k ] for k = 0 , ... , d
+where j is the index for one of the variables x(i), u(i), v(i),
+is the partial derivative of H with respect to the
+k-th order Taylor coefficient corresponding to this variable.
+*/
+template <class Base>
+void reverse_wsum_op(
+   size_t        d           ,
+   size_t        i_z         ,
+   const addr_t* arg         ,
+   const Base*   parameter   ,
+   size_t        cap_order   ,
+   const Base*   taylor      ,
+   size_t        nc_partial  ,
+   Base*         partial     )
+{
+   // check assumptions
+   CPPAD_ASSERT_UNKNOWN( NumRes(WSumOp) == 1 );
+   CPPAD_ASSERT_UNKNOWN( d < cap_order );
+   CPPAD_ASSERT_UNKNOWN( d < nc_partial );
+   CPPAD_ASSERT_UNKNOWN( arg[arg[3]] == arg[3] );
+
+   // partial derivative corresponding to result
+   const Base* pz = partial + i_z * nc_partial;
+   //
+   // parameter variable pairs
+   for(size_t i = 4; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i+1]) < i_z );
+      Base w = parameter[ arg[i] ];
+      if( i >= size_t(arg[0]) )
+         w = - w;
+      Base* px = partial + size_t(arg[i+1]) * nc_partial;
+      // must use azmul because pz[k] = 0 may mean that this
+      // component of the function was not selected.
+      for(size_t k = 0; k <= d; k++)
+         px[k] += azmul(pz[k], w);
+   }
+   //
+   // variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      CPPAD_ASSERT_UNKNOWN( size_t(arg[i+1]) < i_z );
+      const Base* u  = taylor  + size_t(arg[i])   * cap_order;
+      const Base* v  = taylor  + size_t(arg[i+1]) * cap_order;
+      Base*       pu = partial + size_t(arg[i])   * nc_partial;
+      Base*       pv = partial + size_t(arg[i+1]) * nc_partial;
+      if( i < size_t(arg[2]) )
+      {  for(size_t j = 0; j <= d; j++)
+         {  for(size_t k = 0; k <= j; k++)
+            {  pu[j-k] += azmul(pz[j], v[k]);
+               pv[k]   += azmul(pz[j], u[j-k]);
+            }
+         }
+      }
+      else
+      {  for(size_t j = 0; j <= d; j++)
+         {  for(size_t k = 0; k <= j; k++)
+            {  pu[j-k] -= azmul(pz[j], v[k]);
+               pv[k]   -= azmul(pz[j], u[j-k]);
+            }
+         }
+      }
+   }
+}
+
+/*!
+Forward mode Jacobian sparsity pattern for WSumOp operator.
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse::pack_setvec or sparse::list_setvec.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param sparsity
+\b Input: The set with index j in sparsity, where j is the index
+for one of the variables x(i), u(i), v(i), is the sparsity pattern for
+that variable.
+\n
+\b Output: The set with index i_z in sparsity
+is the sparsity bit pattern for z.
+*/
+template <class Vector_set>
+void forward_sparse_jacobian_wsum_op(
+   size_t           i_z         ,
+   const addr_t*    arg         ,
+   Vector_set&      sparsity    )
+{  sparsity.clear(i_z);
+   //
+   // variable in parameter variable pairs
+   for(size_t i = 5; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      sparsity.binary_union(i_z, i_z, size_t(arg[i]), sparsity);
+   }
+   // variables in variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); ++i)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      sparsity.binary_union(i_z, i_z, size_t(arg[i]), sparsity);
+   }
+}
+
+/*!
+Reverse mode Jacobian sparsity pattern for WSumOp operator.
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse::pack_setvec or sparse::list_setvec.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param sparsity
+The set with index j in sparsity, where j is the index
+for one of the variables x(i), u(i), v(i),
+identifies which of the dependent variables depend on this variable.
+On input, the sparsity patter corresponds to G,
+and on ouput it corresponds to H.
+*/
+template <class Vector_set>
+void reverse_sparse_jacobian_wsum_op(
+   size_t           i_z         ,
+   const addr_t*    arg         ,
+   Vector_set&      sparsity    )
+{  //
+   // variable in parameter variable pairs
+   for(size_t i = 5; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      sparsity.binary_union(size_t(arg[i]), size_t(arg[i]), i_z, sparsity);
+   }
+   // variables in variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); ++i)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      sparsity.binary_union(size_t(arg[i]), size_t(arg[i]), i_z, sparsity);
+   }
+}
+
+/*!
+Reverse mode Hessian sparsity pattern for WSumOp operator.
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse::pack_setvec or sparse::list_setvec.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param rev_jacobian
+rev_jacobian[i_z]
+is all false (true) if the Jabobian of G with respect to z must be zero
+(may be non-zero).
+For j the index of one of the variables x(i), u(i), v(i),
+rev_jacobian[j] is all false (true) if the Jacobian with respect to
+this variable is zero (may be non-zero).
+On input, it corresponds to the function G,
+and on output it corresponds to the function H.
+
+\param for_jac_sparsity
+The set with index j in for_jac_sparsity is the forward Jacobian
+sparsity pattern for the variable with index j.
+
+\param rev_hes_sparsity
+The set with index i_z in in rev_hes_sparsity
+is the Hessian sparsity pattern for the function G
+where one of the partials derivative is with respect to z.
+For j the index of one of the variables x(i), u(i), v(i),
+the set with index j in rev_hes_sparsity
+is the Hessian sparsity pattern
+where one of the partials derivative is with respect to this variable.
+On input, it corresponds to the function G,
+and on output it corresponds to the function H.
+*/
+template <class Vector_set>
+void reverse_sparse_hessian_wsum_op(
+   size_t              i_z                 ,
+   const addr_t*       arg                 ,
+   bool*               rev_jacobian        ,
+   const Vector_set&   for_jac_sparsity    ,
+   Vector_set&         rev_hes_sparsity    )
+{  //
+   // variable in parameter variable pairs
+   for(size_t i = 5; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      rev_hes_sparsity.binary_union(
+         size_t(arg[i]), size_t(arg[i]), i_z, rev_hes_sparsity
+      );
+      rev_jacobian[arg[i]] |= rev_jacobian[i_z];
+   }
+   // variables in variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+   {  size_t i_u = size_t(arg[i]);
+      size_t i_v = size_t(arg[i+1]);
+      CPPAD_ASSERT_UNKNOWN( i_u < i_z && i_v < i_z );
+      rev_hes_sparsity.binary_union(i_u, i_u, i_z, rev_hes_sparsity);
+      rev_hes_sparsity.binary_union(i_v, i_v, i_z, rev_hes_sparsity);
+      if( rev_jacobian[i_z] )
+      {  // new hessian sparsity terms between u and v
+         rev_hes_sparsity.binary_union(i_u, i_u, i_v, for_jac_sparsity);
+         rev_hes_sparsity.binary_union(i_v, i_v, i_u, for_jac_sparsity);
+         rev_jacobian[i_u] = true;
+         rev_jacobian[i_v] = true;
+      }
+   }
+}
+
+/*!
+Forward mode Hessian sparsity pattern for WSumOp operator.
+
+\tparam Vector_set
+is the type used for vectors of sets. It can be either
+sparse::pack_setvec or sparse::list_setvec.
+
+\param np1
+This is the number of independent variables plus one;
+i.e. size of x plus one.
+
+\param numvar
+This is the total number of variables in the tape.
+
+\param i_z
+variable index corresponding to the result for this operation;
+i.e. the index in sparsity corresponding to z.
+
+\param arg
+is the argument vector for this operator (see wsum_op.hpp).
+
+\param for_sparsity
+We have the conditions np1 = for_sparsity.end()
+and for_sparsity.n_set() = np1 + numvar.
+The set with index np1 + j is the forward Jacobian sparsity
+pattern for the variable with index j.
+On output, the set with index np1 + i_z is the Jacobian sparsity
+pattern for z.
+For i_x < np1, the set with index i_x is the forward Hessian sparsity
+pattern for the i_x-th independent variable (one based index).
+On output, these sets include the Hessian terms created by the
+variable variable pairs.
+*/
+template <class Vector_set>
+void forward_sparse_hessian_wsum_op(
+   size_t              np1           ,
+   size_t              numvar        ,
+   size_t              i_z           ,
+   const addr_t*       arg           ,
+   Vector_set&         for_sparsity  )
+{  CPPAD_ASSERT_UNKNOWN( for_sparsity.end() == np1 );
+   CPPAD_ASSERT_UNKNOWN( for_sparsity.n_set() == np1 + numvar );
+   CPPAD_ASSERT_UNKNOWN( i_z < numvar );
+   //
+   // Jacobian sparsity for z
+   for_sparsity.clear(np1 + i_z);
+   for(size_t i = 5; i < size_t(arg[1]); i += 2)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      for_sparsity.binary_union(
+         np1 + i_z, np1 + i_z, np1 + size_t(arg[i]), for_sparsity
+      );
+   }
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); ++i)
+   {  CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < i_z );
+      for_sparsity.binary_union(
+         np1 + i_z, np1 + i_z, np1 + size_t(arg[i]), for_sparsity
+      );
+   }
+   //
+   // Hessian terms for the variable variable pairs
+   for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+   {  size_t i_u = size_t(arg[i]);
+      size_t i_v = size_t(arg[i+1]);
+      //
+      // N(i_x) = N(i_x) union J(v) for i_x in J(u)
+      typename Vector_set::const_iterator itr_u(for_sparsity, np1 + i_u);
+      size_t i_x = *itr_u;
+      while( i_x < np1 )
+      {  for_sparsity.binary_union(i_x, i_x, np1 + i_v, for_sparsity);
+         i_x = *(++itr_u);
+      }
+      //
+      // N(i_x) = N(i_x) union J(u) for i_x in J(v)
+      typename Vector_set::const_iterator itr_v(for_sparsity, np1 + i_v);
+      i_x = *itr_v;
+      while( i_x < np1 )
+      {  for_sparsity.binary_union(i_x, i_x, np1 + i_u, for_sparsity);
+         i_x = *(++itr_v);
+      }
+   }
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OP_CODE_VAR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <string>
 # include <sstream>
@@ -21,6 +21,8 @@ namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 {xrst_begin op_code_var dev}
 {xrst_spell
    addpv
+   fmavvp
+   fmavvv
    funap
    funav
    funrp
@@ -309,6 +311,93 @@ Note that there are *n* +1 arguments to this operator
 and having this value at the end enable reverse model to know how far
 to back up to get to the start of this operation.
 
+{xrst_comment ------------------------------------------------------------- }
+Fused Multiply Add
+******************
+The fused multiply add operators
+FmavvpOp and FmavvvOp have one result variable
+*z* = *a* * *b* + *c* .
+They are only created by the :ref:`optimize-name` routine
+(see the multiply_add_op option).
+
+arg[0]
+======
+variable index corresponding to the first factor *a* .
+
+arg[1]
+======
+variable index corresponding to the second factor *b* .
+
+arg[2]
+======
+For the FmavvpOp operator, this is the parameter index for *c* .
+For the FmavvvOp operator, this is the variable index for *c* .
+
+{xrst_comment ------------------------------------------------------------- }
+WSumOp
+******
+Is a weighted summation operator which has one result variable
+*z* equal to a sum of products.
+Each product is either a parameter times a variable or
+a variable times a variable and is added or subtracted.
+This operator is only created by the :ref:`optimize-name` routine
+(see the weighted_sum_op option).
+
+arg[0]
+======
+argument index that flags the end of the addition
+parameter variable pairs,
+we use the notation *k* = *arg* [0] below.
+
+arg[1]
+======
+argument index that flags the end of the subtraction
+parameter variable pairs,
+we use the notation *ell* = *arg* [1] below.
+
+arg[2]
+======
+argument index that flags the end of the addition
+variable variable pairs,
+we use the notation *m* = *arg* [2] below.
+
+arg[3]
+======
+argument index that flags the end of the subtraction
+variable variable pairs,
+we use the notation *n* = *arg* [3] below.
+
+arg[4+2*i], arg[5+2*i]
+======================
+for *i* = 0, ..., ( *k* ``-4`` )/2 ``-1`` ,
+these are the parameter index and variable index
+for the *i*-th product that is added.
+
+arg[k+2*i], arg[k+1+2*i]
+========================
+for *i* = 0, ..., ( *ell* ``-`` *k* )/2 ``-1`` ,
+these are the parameter index and variable index
+for the *i*-th product that is subtracted.
+
+arg[ell+2*i], arg[ell+1+2*i]
+============================
+for *i* = 0, ..., ( *m* ``-`` *ell* )/2 ``-1`` ,
+these are the variable indices
+for the *i*-th variable product that is added.
+
+arg[m+2*i], arg[m+1+2*i]
+========================
+for *i* = 0, ..., ( *n* ``-`` *m* )/2 ``-1`` ,
+these are the variable indices
+for the *i*-th variable product that is subtracted.
+
+arg[n]
+======
+This is equal to *n* .
+As for the CSumOp operator, there are *n* +1 arguments to this operator
+and the value at the end enables reverse mode to back up to the start
+of this operation.
+
 {xrst_comment ------------------------------------------------------------- }
 DisOp
 *****
@@ -488,6 +577,8 @@ enum OpCode {
    ErfcOp,   // unary erfc
    ExpOp,    // unary exp
    Expm1Op,  // unary expm1
+   FmavvpOp, // variable * variable + parameter
+   FmavvvOp, // variable * variable + variable
    FunapOp,  // see AFun heading above
    FunavOp,  // ...
    FunrpOp,  // ...
@@ -529,6 +620,7 @@ enum OpCode {
    SubvvOp,  // ...
    TanOp,    // unary tan
    TanhOp,   // unary tanh
+   WSumOp,   // see its heading above
    ZmulpvOp, // binary azmul
    ZmulvpOp, // ...
    ZmulvvOp, // ...
@@ -598,6 +690,8 @@ inline size_t NumArg( OpCode op)
       /* ErfcOp   */ 3,
       /* ExpOp    */ 1,
       /* Expm1Op  */ 1,
+      /* FmavvpOp */ 3,
+      /* FmavvvOp */ 3,
       /* FunapOp  */ 1,
       /* FunavOp  */ 1,
       /* FunrpOp  */ 1,
@@ -639,6 +733,7 @@ inline size_t NumArg( OpCode op)
       /* SubvvOp  */ 2,
       /* TanOp    */ 1,
       /* TanhOp   */ 1,
+      /* WSumOp   */ 0,  // (has a variable number of arguments, not zero)
       /* ZmulpvOp */ 2,
       /* ZmulvpOp */ 2,
       /* ZmulvvOp */ 2,
@@ -719,6 +814,8 @@ inline size_t NumRes(OpCode op)
       /* ErfcOp   */ 5,
       /* ExpOp    */ 1,
       /* Expm1Op  */ 1,
+      /* FmavvpOp */ 1,
+      /* FmavvvOp */ 1,
       /* FunapOp  */ 0,
       /* FunavOp  */ 0,
       /* FunrpOp  */ 0,
@@ -760,6 +857,7 @@ inline size_t NumRes(OpCode op)
       /* SubvvOp  */ 1,
       /* TanOp    */ 2,
       /* TanhOp   */ 2,
+      /* WSumOp   */ 1,
       /* ZmulpvOp */ 1,
       /* ZmulvpOp */ 1,
       /* ZmulvvOp */ 1,
@@ -818,6 +916,8 @@ inline std::string OpName(OpCode op)
       "ErfcOp"  ,
       "ExpOp"   ,
       "Expm1Op" ,
+      "FmavvpOp",
+      "FmavvvOp",
       "FunapOp" ,
       "FunavOp" ,
       "FunrpOp" ,
@@ -859,6 +959,7 @@ inline std::string OpName(OpCode op)
       "SubvvOp" ,
       "TanOp"   ,
       "TanhOp"  ,
+      "WSumOp"  ,
       "ZmulpvOp",
       "ZmulvpOp",
       "ZmulvvOp",
@@ -1073,6 +1174,31 @@ void printOp(
              printOpField(os, " -d=", play->GetPar( size_t(arg[i]) ), ncol);
       break;
 
+      case WSumOp:
+      /*
+      arg[0] = end in arg of addition parameter variable pairs
+      arg[1] = end in arg of subtraction parameter variable pairs
+      arg[2] = end in arg of addition variable variable pairs
+      arg[3] = end in arg of subtraction variable variable pairs
+      arg[arg[3]] = arg[3]
+      */
+      CPPAD_ASSERT_UNKNOWN( arg[arg[3]] == arg[3] );
+      for(addr_t i = 4; i < arg[1]; i += 2)
+      {  if( i < arg[0] )
+            printOpField(os, " +p=", play->GetPar( size_t(arg[i]) ), ncol);
+         else
+            printOpField(os, " -p=", play->GetPar( size_t(arg[i]) ), ncol);
+         printOpField(os, " v=", arg[i+1], ncol);
+      }
+      for(addr_t i = arg[1]; i < arg[3]; i += 2)
+      {  if( i < arg[2] )
+            printOpField(os, " +v=", arg[i], ncol);
+         else
+            printOpField(os, " -v=", arg[i], ncol);
+         printOpField(os, " v=", arg[i+1], ncol);
+      }
+      break;
+
       case LdpOp:
       CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
       printOpField(os, "off=", arg[0], ncol);
@@ -1194,6 +1320,20 @@ void printOp(
       printOpField(os, "  p=", play->GetPar( size_t(arg[0]) ), ncol);
       break;
 
+      case FmavvpOp:
+      CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+      printOpField(os, " va=", arg[0], ncol);
+      printOpField(os, " vb=", arg[1], ncol);
+      printOpField(os, " pc=", play->GetPar( size_t(arg[2]) ), ncol);
+      break;
+
+      case FmavvvOp:
+      CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+      printOpField(os, " va=", arg[0], ncol);
+      printOpField(os, " vb=", arg[1], ncol);
+      printOpField(os, " vc=", arg[2], ncol);
+      break;
+
       case AFunOp:
       CPPAD_ASSERT_UNKNOWN( NumArg(op) == 4 );
       {
@@ -1331,7 +1471,7 @@ void printOpResult(
 Determines which arguments are variaibles for an operator.
 
 \param op
-is the operator. Note that CSkipOp and CSumOp are special cases
+is the operator. Note that CSkipOp, CSumOp, and WSumOp are special cases
 because the true number of arguments is not equal to NumArg(op)
 and the true number of arguments num_arg can be large.
 It may be more efficient to handle these cases separately
@@ -1344,7 +1484,8 @@ is the argument vector for this operator.
 If the input value of the elements in this vector do not matter.
 Upon return, resize has been used to set its size to the true number
 of arguments to this operator.
-If op != CSkipOp and op != CSumOp, is_variable.size() = NumArg(op).
+If op is not CSkipOp, CSumOp, or WSumOp,
+is_variable.size() = NumArg(op).
 The j-th argument for this operator is a
 variable index if and only if is_variable[j] is true. Note that the variable
 index 0, for the BeginOp, does not correspond to a real variable and false
@@ -1367,6 +1508,17 @@ In the case of CSumOp,
          is_variable[j] = true;
 \endcode
 and all the other is_variable values are false.
+
+\par WSumOp
+In the case of WSumOp,
+\code
+      is_variable.size() = arg[3]
+      for(size_t j = 5; j < arg[1]; j += 2)
+         is_variable[j] = true;
+      for(size_t j = arg[1]; j < arg[3]; ++j)
+         is_variable[j] = true;
+\endcode
+and all the other is_variable values are false.
 */
 template <class Addr>
 void arg_is_variable(
@@ -1487,6 +1639,20 @@ void arg_is_variable(
       is_variable[2] = false;
       break;
 
+      case FmavvpOp:
+      CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+      is_variable[0] = true;
+      is_variable[1] = true;
+      is_variable[2] = false;
+      break;
+
+      case FmavvvOp:
+      CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
+      is_variable[0] = true;
+      is_variable[1] = true;
+      is_variable[2] = true;
+      break;
+
       case LdvOp:
       case StvpOp:
       CPPAD_ASSERT_UNKNOWN( NumArg(op) == 3 );
@@ -1569,6 +1735,19 @@ void arg_is_variable(
          is_variable[i] = (5 <= i) & (i < size_t(arg[2]));
       break;
 
+      case WSumOp:
+      CPPAD_ASSERT_UNKNOWN( NumArg(op) == 0 )
+      //
+      // true number of arguments
+      num_arg = size_t(arg[3]);
+      //
+      is_variable.resize( num_arg );
+      for(size_t i = 0; i < size_t(arg[1]); ++i)
+         is_variable[i] = (5 <= i) & (i % 2 == 1);
+      for(size_t i = size_t(arg[1]); i < num_arg; ++i)
+         is_variable[i] = true;
+      break;
+
       case EqppOp:
       case LeppOp:
       case LtppOp:
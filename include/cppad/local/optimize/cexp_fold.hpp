@@ -0,0 +1,96 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_CEXP_FOLD_HPP
+# define CPPAD_LOCAL_OPTIMIZE_CEXP_FOLD_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/play/player.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_cexp_fold dev}
+
+Variable Selected by a Conditional Expression With Constant Comparison
+######################################################################
+
+Syntax
+******
+| *j_var* = ``cexp_fold`` ( *play* , *arg* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+If the *left* and *right* operands of a conditional expression
+are both constant parameters, the result of its comparison is known
+during the optimization and the conditional expression is equal to
+the branch that it selects.
+This happens, for example, after the dynamic parameters in the comparison
+have been frozen; see :ref:`freeze_dynamic-name` .
+This routine is used by both :ref:`optimize_get_op_usage-name` and
+:ref:`optimize_get_op_previous-name` so that they agree on which
+conditional expressions are folded.
+
+Base
+****
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+play
+****
+is the old operation sequence.
+
+arg
+***
+is the argument vector for a ``CExpOp`` operator in *play* .
+
+j_var
+*****
+If the comparison is between constant parameters and the branch it
+selects is a variable, *j_var* is the index of that variable.
+Otherwise *j_var* is zero and the conditional expression is not folded.
+
+{xrst_end optimize_cexp_fold}
+*/
+// BEGIN_PROTOTYPE
+template <class Base>
+size_t cexp_fold(const player<Base>* play, const addr_t* arg)
+// END_PROTOTYPE
+{  //
+   // left or right is a variable
+   if( arg[1] & 3 )
+      return 0;
+   //
+   // left or right is a dynamic parameter
+   const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+   if( dyn_par_is[ arg[2] ] || dyn_par_is[ arg[3] ] )
+      return 0;
+   //
+   // left, right
+   const Base& left  = play->GetPar( size_t( arg[2] ) );
+   const Base& right = play->GetPar( size_t( arg[3] ) );
+   if( ! ( IdenticalCon(left) && IdenticalCon(right) ) )
+      return 0;
+   //
+   // flag
+   Base flag = CondExpOp(
+      CompareOp( arg[0] ), left, right, Base(1), Base(0)
+   );
+   //
+   // j_var
+   if( IdenticalOne(flag) && (arg[1] & 4) )
+      return size_t( arg[4] );
+   if( IdenticalZero(flag) && (arg[1] & 8) )
+      return size_t( arg[5] );
+   return 0;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
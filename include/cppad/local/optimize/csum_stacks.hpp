@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_CSUM_STACKS_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <stack>
 # include <cppad/local/optimize/csum_op_info.hpp>
@@ -33,6 +33,18 @@ struct struct_csum_stacks {
 
    /// dynamic parameter indices to be subtracted
    std::stack<addr_t>                          sub_dyn;
+
+   /// old variable indices for parameter times variable to be added
+   std::stack<addr_t>                          add_pv;
+
+   /// old variable indices for parameter times variable to be subtracted
+   std::stack<addr_t>                          sub_pv;
+
+   /// old variable indices for variable times variable to be added
+   std::stack<addr_t>                          add_vv;
+
+   /// old variable indices for variable times variable to be subtracted
+   std::stack<addr_t>                          sub_vv;
 };
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_EXTRACT_OPTION_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*!
@@ -37,6 +37,7 @@ See :ref:`optimize@options`
 {xrst_end optimize_extract_option}
 */
 
+# include <cppad/configure.hpp>
 # include <cppad/core/cppad_assert.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -48,9 +49,16 @@ struct options_t {
    bool   compare_op;
    bool   conditional_skip;
    bool   cumulative_sum_op;
+   bool   incremental;
+   bool   multiply_add_op;
    bool   print_for_op;
+   bool   simplify;
+   bool   simplify_all;
    bool   val_graph;
+   bool   weighted_sum_op;
    size_t collision_limit;
+   size_t conditional_skip_cost;
+   size_t num_thread;
 };
 // END_OPTIONS_T
 // END_SORT_THIS_LINE_MINUS_3
@@ -64,9 +72,37 @@ inline options_t extract_option(const std::string& options)
       true,  // compare_op
       true,  // conditional_skip
       true,  // cumulative_sum_op
+      false, // incremental
+      false, // multiply_add_op
       true,  // print_for_op
+      false, // simplify
+      false, // simplify_all
       false, // val_graph
-      10     // collision_limit
+      false, // weighted_sum_op
+      10,    // collision_limit
+      0,     // conditional_skip_cost
+      1      // num_thread
+   };
+   //
+   // decimal_value
+   // value of the decimal digits that follow the = in option
+   auto decimal_value = [](std::string& option, size_t n_prefix) -> size_t
+   {  std::string value = option.substr(n_prefix, option.size());
+      bool value_ok = value.size() > 0;
+      for(size_t i = 0; i < value.size(); ++i)
+      {  value_ok &= '0' <= value[i];
+         value_ok &= value[i] <= '9';
+      }
+      if( ! value_ok )
+      {  option += " value is not a sequence of decimal digits";
+         CPPAD_ASSERT_KNOWN( false , option.c_str() );
+      }
+      size_t result = size_t( std::atoi( value.c_str() ) );
+      if( result < 1 )
+      {  option += " value must be greater than zero";
+         CPPAD_ASSERT_KNOWN( false , option.c_str() );
+      }
+      return result;
    };
    size_t index = 0;
    while( index < options.size() )
@@ -83,24 +119,30 @@ inline options_t extract_option(const std::string& options)
             result.conditional_skip = false;
          else if( option == "no_cumulative_sum_op" )
             result.cumulative_sum_op = false;
+         else if( option == "incremental" )
+            result.incremental = true;
+         else if( option == "multiply_add_op" )
+            result.multiply_add_op = true;
          else if( option == "no_print_for_op" )
             result.print_for_op = false;
+         else if( option == "simplify" )
+            result.simplify = true;
+         else if( option == "simplify_all" )
+         {  result.simplify     = true;
+            result.simplify_all = true;
+         }
          else if( option == "val_graph" )
             result.val_graph = true;
+         else if( option == "weighted_sum_op" )
+            result.weighted_sum_op = true;
          else if( option.substr(0, 16)  == "collision_limit=" )
-         {  std::string value = option.substr(16, option.size());
-            bool value_ok = value.size() > 0;
-            for(size_t i = 0; i < value.size(); ++i)
-            {  value_ok &= '0' <= value[i];
-               value_ok &= value[i] <= '9';
-            }
-            if( ! value_ok )
-            {  option += " value is not a sequence of decimal digits";
-               CPPAD_ASSERT_KNOWN( false , option.c_str() );
-            }
-            result.collision_limit = size_t( std::atoi( value.c_str() ) );
-            if( result.collision_limit < 1 )
-            {  option += " value must be greater than zero";
+            result.collision_limit = decimal_value(option, 16);
+         else if( option.substr(0, 22)  == "conditional_skip_cost=" )
+            result.conditional_skip_cost = decimal_value(option, 22);
+         else if( option.substr(0, 11)  == "num_thread=" )
+         {  result.num_thread = decimal_value(option, 11);
+            if( result.num_thread > CPPAD_THREAD_LIMIT )
+            {  option += " value is greater than CPPAD_THREAD_LIMIT";
                CPPAD_ASSERT_KNOWN( false , option.c_str() );
             }
          }
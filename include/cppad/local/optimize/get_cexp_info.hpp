@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_CEXP_INFO_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/optimize/match_op.hpp>
@@ -198,6 +198,8 @@ void get_cexp_info(
    {  size_t j_op = i_op;
       bool keep = op_usage[i_op] != usage_t(no_usage);
       keep     &= op_usage[i_op] != usage_t(csum_usage);
+      keep     &= op_usage[i_op] != usage_t(fma_usage);
+      keep     &= op_usage[i_op] != usage_t(wsum_usage);
       keep     &= op_previous[i_op] == 0;
       if( keep )
       {  sparse::list_setvec_const_iterator itr(cexp_set, i_op);
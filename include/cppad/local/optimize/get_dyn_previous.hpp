@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_DYN_PREVIOUS_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*!
 \file get_cexp_info.hpp
@@ -11,7 +11,7 @@ Create operator information tables
 
 # include <cppad/local/optimize/match_op.hpp>
 # include <cppad/local/optimize/usage.hpp>
-# include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/match_table.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize {
@@ -173,8 +173,7 @@ void get_dyn_previous(
    // ----------------------------------------------------------------------
    // compute dyn_previous
    // ----------------------------------------------------------------------
-   sparse::list_setvec  hash_table_dyn;
-   hash_table_dyn.resize(CPPAD_HASH_TABLE_SIZE, num_dynamic_par);
+   match_table  table_dyn;
    //
    // Initialize in dyn_par_arg
    // (independent dynamic parameters do not have any arguments)
@@ -218,10 +217,8 @@ void get_dyn_previous(
       // temporary used below and decaled here to reduce memory allocation
       pod_vector<addr_t> arg_match;
       //
-      // temporaries used below and decaled here to reduce indentation level
-      bool   match;
-      size_t code;
-      size_t count;
+      // temporary used below and decaled here to reduce indentation level
+      size_t k_dyn;
       //
       // check for a previous match for i_dyn
       if( par_usage[i_par] ) switch( op )
@@ -265,48 +262,13 @@ void get_dyn_previous(
                dyn_previous,
                arg_match
             );
-            opcode_t op_t  = opcode_t(op);
-            code           = optimize_hash_code(
-               op_t, num_arg, arg_match.data()
+            k_dyn = table_dyn.find_or_insert(
+               opcode_t(op), num_arg, arg_match.data(), i_dyn
             );
-            //
-            // iterator for the set with this hash code
-            sparse::list_setvec_const_iterator itr(hash_table_dyn, code);
-            //
-            // check for a match
-            count = 0;
-            match = false;
-            while( ! match && *itr != num_dynamic_par )
-            {  ++count;
-               //
-               // candidate for current dynamic parameter
-               size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               //
-               // argument offset for the candidate
-               addr_t k_arg   = dyn_arg_offset[k_dyn];
-               //
-               match  = op_t == dyn_par_op[k_dyn];
-               match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-               if( ! match )
-                  ++itr;
-            }
-            if( match )
-            {  size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+            if( k_dyn != i_dyn )
+            {  CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
                dyn_previous[i_dyn] = addr_t( k_dyn );
             }
-            else
-            {  CPPAD_ASSERT_UNKNOWN( count < 11 );
-               if( count == 10 )
-               {  // restart list for this hash code
-                  hash_table_dyn.clear(code);
-               }
-               // Add this entry to hash table.
-               // Not using post_element because we need to iterate for
-               // this code before adding another element for this code.
-               hash_table_dyn.add_element(code, i_dyn);
-            }
          }
          break;
 
@@ -320,7 +282,6 @@ void get_dyn_previous(
          case zmul_dyn:
          CPPAD_ASSERT_UNKNOWN( num_arg_dyn(op) == 2);
          CPPAD_ASSERT_UNKNOWN( dyn_par_is[i_par] );
-         match = false;
          {  size_t num_arg = 2;
             arg_match.resize(num_arg);
             dyn_arg_match(
@@ -333,82 +294,20 @@ void get_dyn_previous(
                dyn_previous,
                arg_match
             );
-            opcode_t op_t  = opcode_t(op);
-            code           = optimize_hash_code(
-               op_t, num_arg, arg_match.data()
-            );
-            //
-            // iterator for the set with this hash code
-            sparse::list_setvec_const_iterator itr(hash_table_dyn, code);
-            //
-            // check for a match
-            count = 0;
-            while( ! match && *itr != num_dynamic_par )
-            {  ++count;
-               //
-               // candidate for current dynamic parameter
-               size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               //
-               // argument offset for the candidate
-               addr_t k_arg   = dyn_arg_offset[k_dyn];
-               //
-               match  = op_t == dyn_par_op[k_dyn];
-               match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-               match &= arg_match[1] == dyn_par_arg[k_arg + 1];
-               if( ! match )
-                  ++itr;
+            if( (op == add_dyn) | (op == mul_dyn) )
+            {  // commutative so signature does not depend on argument order
+               if( arg_match[1] < arg_match[0] )
+                  std::swap( arg_match[0], arg_match[1] );
             }
-            if( match )
-            {  size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               dyn_previous[i_dyn] = addr_t( k_dyn );
-            }
-         }
-         if( (! match) & ( (op == add_dyn) | (op == mul_dyn) ) )
-         {  size_t num_arg = 2;
-            std::swap( arg_match[0], arg_match[1] );
-            opcode_t op_t    = opcode_t(op);
-            size_t code_swp  = optimize_hash_code(
-               op_t, num_arg, arg_match.data()
+            k_dyn = table_dyn.find_or_insert(
+               opcode_t(op), num_arg, arg_match.data(), i_dyn
             );
-            //
-            // iterator for the set with this hash code
-            sparse::list_setvec_const_iterator itr(hash_table_dyn, code_swp);
-            //
-            // check for a match
-            while( ! match && *itr != num_dynamic_par )
-            {  //
-               // candidate for current dynamic parameter
-               size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
-               //
-               // argument offset for the candidate
-               addr_t k_arg   = dyn_arg_offset[k_dyn];
-               //
-               match  = op_t == dyn_par_op[k_dyn];
-               match &= arg_match[0] == dyn_par_arg[k_arg + 0];
-               match &= arg_match[1] == dyn_par_arg[k_arg + 1];
-               if( ! match )
-                  ++itr;
-            }
-            if( match )
-            {  size_t  k_dyn  = *itr;
-               CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
+            if( k_dyn != i_dyn )
+            {  CPPAD_ASSERT_UNKNOWN( k_dyn < i_dyn );
                dyn_previous[i_dyn] = addr_t( k_dyn );
             }
          }
-         if( ! match )
-         {  CPPAD_ASSERT_UNKNOWN( count < 11 );
-            if( count == 10 )
-            {  // restart list for this hash code
-               hash_table_dyn.clear(code);
-            }
-            // Add the entry to hash table
-            // Not using post_element because we need to iterate for
-            // this code before adding another element for this code.
-            hash_table_dyn.add_element(code, i_dyn);
-         }
+         break;
 
          // --------------------------------------------------------------
          // skipping these cases for now
@@ -0,0 +1,153 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_FMA_USAGE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_FMA_USAGE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/optimize/get_n_use.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_get_fma_usage dev}
+{xrst_spell
+   addpv
+   addvv
+   mulvv
+}
+
+Determine Which Multiplications Are Fused With an Addition
+##########################################################
+
+Syntax
+******
+
+| ``get_fma_usage`` (
+| |tab| *random_itr* ,
+| |tab| *op_previous* ,
+| |tab| *n_use* ,
+| |tab| *op_usage*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+This routine is only called when the ``multiply_add_op``
+:ref:`optimize@options` is present.
+It must be called after :ref:`optimize_get_op_previous-name` so that
+the multiplications that are fused have been through
+common subexpression elimination; i.e.,
+fusing a multiplication never prevents it from being matched.
+
+random_itr
+**********
+is a random iterator for the old operation sequence.
+
+op_previous
+***********
+is the mapping from an operator index to a previous operator
+that is equivalent (zero if there is no such operator).
+
+n_use
+*****
+is the number of times each result is used in the new operation sequence;
+see :ref:`optimize_get_n_use-name` .
+
+op_usage
+********
+The size of this vector is the number of operators in the
+old operation sequence.
+On input, op_usage[i] is the usage for the i-th operator
+counting previous optimization.
+Upon return, some MulvvOp operators that had ``yes_usage``
+have ``fma_usage`` .
+Such a multiplication is not replaced by a previous operator,
+is used exactly once,
+by an AddpvOp or AddvvOp operator that has ``yes_usage`` ,
+is not replaced by a previous operator,
+and is not the top of a cumulative summation.
+In addition, at most one multiplication is fused with each addition.
+
+{xrst_end optimize_get_fma_usage}
+*/
+
+// BEGIN_PROTOTYPE
+template <class Addr>
+void get_fma_usage(
+   const play::const_random_iterator<Addr>&    random_itr          ,
+   const pod_vector<addr_t>&                   op_previous         ,
+   const pod_vector<unsigned char>&            n_use               ,
+   pod_vector<usage_t>&                        op_usage            )
+// END_PROTOTYPE
+{  //
+   // number of operators in the tape
+   const size_t num_op = random_itr.num_op();
+   CPPAD_ASSERT_UNKNOWN( op_previous.size() == num_op );
+   CPPAD_ASSERT_UNKNOWN( n_use.size() == num_op );
+   CPPAD_ASSERT_UNKNOWN( op_usage.size() == num_op );
+   //
+   // is_fma_mul
+   // is the j-th operator a multiplication that can be fused.
+   // The recording pass cannot follow op_previous (it shares memory with
+   // the new operator indices) so a replaced multiplication is not fused.
+   // Such a fusion is rarely possible because the replacing operator
+   // usually has a use of its own.
+   auto is_fma_mul = [&](size_t j_op) -> bool
+   {  bool result = random_itr.get_op(j_op) == MulvvOp;
+      result     &= op_usage[j_op] == usage_t(yes_usage);
+      result     &= op_previous[j_op] == 0;
+      result     &= n_use[j_op] == 1;
+      return result;
+   };
+   //
+   // op_usage
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+   {  //
+      // op, arg, i_var
+      OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      random_itr.op_info(i_op, op, arg, i_var);
+      //
+      bool candidate = op == AddpvOp || op == AddvvOp;
+      candidate     &= op_usage[i_op] == usage_t(yes_usage);
+      candidate     &= op_previous[i_op] == 0;
+      if( candidate )
+      {  //
+         // j_op
+         // operator indices for the variable arguments
+         size_t j_op[2];
+         size_t n_var = 0;
+         for(size_t k = 0; k < 2; ++k)
+         if( op == AddvvOp || k == 1 )
+            j_op[n_var++] = random_itr.var2op( size_t(arg[k]) );
+         //
+         // candidate
+         // this addition is not the top of a cumulative summation
+         for(size_t k = 0; k < n_var; ++k)
+            candidate &= op_usage[ j_op[k] ] != usage_t(csum_usage);
+         if( n_var == 2 )
+            candidate &= j_op[0] != j_op[1];
+         //
+         // op_usage
+         // fuse the first multiplication that qualifies
+         for(size_t k = 0; k < n_var; ++k)
+         {  if( candidate && is_fma_mul( j_op[k] ) )
+            {  op_usage[ j_op[k] ] = usage_t(fma_usage);
+               candidate = false;
+            }
+         }
+      }
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -0,0 +1,134 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_N_USE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_N_USE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/optimize/usage.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_get_n_use dev}
+
+Number of Times Each Result Is Used in the New Operation Sequence
+#################################################################
+
+Syntax
+******
+
+| ``get_n_use`` (
+| |tab| *random_itr* ,
+| |tab| *dep_taddr* ,
+| |tab| *op_previous* ,
+| |tab| *op_usage* ,
+| |tab| *n_use*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+This routine is used by the passes that remove an operator by
+absorbing it into the only operator that uses its result; see
+:ref:`optimize_get_fma_usage-name` and
+:ref:`optimize_get_wsum_usage-name` .
+It must be called after :ref:`optimize_get_op_previous-name` .
+
+random_itr
+**********
+is a random iterator for the old operation sequence.
+
+dep_taddr
+*********
+is a vector of indices for the dependent variables
+(where the reverse sweep starts).
+
+op_previous
+***********
+is the mapping from an operator index to a previous operator
+that is equivalent (zero if there is no such operator).
+
+op_usage
+********
+is the usage for each operator in the old operation sequence.
+
+n_use
+*****
+The input value of this vector does not matter.
+Upon return, its size is the number of operators in the old
+operation sequence and *n_use* [ *i_op* ] is the number of times the
+result of the *i_op*-th operator is used in the new operation sequence
+(saturated at two).
+A dependent variable is treated as being used twice.
+An operator that is replaced by a previous operator does not
+use its arguments.
+
+{xrst_end optimize_get_n_use}
+*/
+
+// BEGIN_PROTOTYPE
+template <class Addr>
+void get_n_use(
+   const play::const_random_iterator<Addr>&    random_itr          ,
+   const pod_vector<size_t>&                   dep_taddr           ,
+   const pod_vector<addr_t>&                   op_previous         ,
+   const pod_vector<usage_t>&                  op_usage            ,
+   pod_vector<unsigned char>&                  n_use               )
+// END_PROTOTYPE
+{  //
+   // number of operators in the tape
+   const size_t num_op = random_itr.num_op();
+   CPPAD_ASSERT_UNKNOWN( op_previous.size() == num_op );
+   CPPAD_ASSERT_UNKNOWN( op_usage.size() == num_op );
+   //
+   // n_use
+   n_use.resize(num_op);
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+      n_use[i_op] = 0;
+   for(size_t i = 0; i < dep_taddr.size(); ++i)
+   {  size_t i_op = random_itr.var2op(dep_taddr[i]);
+      if( op_previous[i_op] != 0 )
+         i_op = size_t( op_previous[i_op] );
+      n_use[i_op] = 2;
+   }
+   //
+   // is_variable
+   pod_vector<bool> is_variable;
+   //
+   // n_use
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+   {  //
+      // op, arg, i_var
+      OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      random_itr.op_info(i_op, op, arg, i_var);
+      //
+      // An operator that is replaced by a previous operator does not
+      // use its arguments. Atomic function arguments may be recorded
+      // even when they do not have yes_usage.
+      bool use_arg = op_previous[i_op] == 0;
+      use_arg     &= op_usage[i_op] != usage_t(no_usage) || op == FunavOp;
+      if( use_arg )
+      {  arg_is_variable(op, arg, is_variable);
+         for(size_t j = 0; j < is_variable.size(); ++j) if( is_variable[j] )
+         {  size_t j_op = random_itr.var2op( size_t(arg[j]) );
+            if( op_previous[j_op] != 0 )
+               j_op = size_t( op_previous[j_op] );
+            if( n_use[j_op] < 2 )
+               ++n_use[j_op];
+         }
+      }
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
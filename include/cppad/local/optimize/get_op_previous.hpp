@@ -2,9 +2,10 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_OP_PREVIOUS_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/optimize/match_op.hpp>
+# include <cppad/local/optimize/cexp_fold.hpp>
 # include <cppad/local/optimize/usage.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -21,8 +22,7 @@ Get Mapping From Op to Previous Op That is Equivalent
 Syntax
 ******
 
-| *exceed_collision_limit* = ``get_op_previous`` (
-| |tab| *collision_limit* ,
+| *n_match* = ``get_op_previous`` (
 | |tab| *play* ,
 | |tab| *random_itr* ,
 | |tab| *cexp_set* ,
@@ -42,11 +42,6 @@ Base
 base type for the operator; i.e., this operation was recorded
 using AD<Base> and computations by this routine are done using type Base.
 
-collision_limit
-***************
-is the maximum number of collisions (matches)
-allowed in the hash expression has table.
-
 play
 ****
 is the old operation sequence.
@@ -80,8 +75,11 @@ If j != 0:
 #. i-th operator has 0 < NumRes(op)
 #. i-th operator is not one of the following:
    {xrst_spell_off}
-   PriOp, ParOp, InvOp, EndOp, CexpOp, BeginOp.
+   PriOp, ParOp, InvOp, EndOp, BeginOp.
    {xrst_spell_on}
+#. If the i-th operator is a CExpOp, it has been folded by
+   :ref:`optimize_cexp_fold-name` and j is the operator that
+   computes the selected branch (or its replacement).
 #. i-th operator is not one of the load store operator:
    {xrst_spell_off}
    LtpvOp, LtvpOp, LtvvOp, StppOp, StpvOp, StvpOp, StvvOp.
@@ -100,26 +98,28 @@ the i-th operator in the operation sequence not counting previous
 optimization.
 On output, it is the usage counting previous operator optimization.
 
-exceed_collision_limit
-**********************
-If the *collision_limit* is exceeded (is not exceeded),
-the return value is true (false).
+n_match
+*******
+is the number of operators that have a previous match; i.e.,
+the number of indices *i* such that *op_previous* [ *i* ] != 0 ,
+not counting the conditional expressions that are folded.
+The previous matches are found using a :ref:`optimize_match_table-name`
+so there is no limit on the number of operators that have the same
+hash code.
 
 {xrst_end optimize_get_op_previous}
 */
 
 // BEGIN_PROTOTYPE
 template <class Addr, class Base>
-bool get_op_previous(
-   size_t                                      collision_limit     ,
+size_t get_op_previous(
    const player<Base>*                         play                ,
    const play::const_random_iterator<Addr>&    random_itr          ,
    sparse::list_setvec&                        cexp_set            ,
    pod_vector<addr_t>&                         op_previous         ,
    pod_vector<usage_t>&                        op_usage            )
 // END_PROTOTYPE
-{  bool exceed_collision_limit = false;
-   //
+{  //
    // number of operators in the tape
    const size_t num_op = random_itr.num_op();
    CPPAD_ASSERT_UNKNOWN( op_previous.size() == 0 );
@@ -135,8 +135,7 @@ bool get_op_previous(
    // ----------------------------------------------------------------------
    // compute op_previous
    // ----------------------------------------------------------------------
-   sparse::list_setvec  hash_table_op;
-   hash_table_op.resize(CPPAD_HASH_TABLE_SIZE, num_op);
+   match_table  table_op;
    //
    pod_vector<bool> work_bool;
    pod_vector<addr_t> work_addr_t;
@@ -149,10 +148,11 @@ bool get_op_previous(
          // ----------------------------------------------------------------
          // these operators never match pevious operators
          case BeginOp:
-         case CExpOp:
          case CSkipOp:
          case CSumOp:
          case EndOp:
+         case FmavvpOp:
+         case FmavvvOp:
          case InvOp:
          case LdpOp:
          case LdvOp:
@@ -162,6 +162,7 @@ bool get_op_previous(
          case StpvOp:
          case StvpOp:
          case StvvOp:
+         case WSumOp:
          case AFunOp:
          case FunapOp:
          case FunavOp:
@@ -169,6 +170,25 @@ bool get_op_previous(
          case FunrvOp:
          break;
 
+         // ----------------------------------------------------------------
+         // a conditional expression with a constant comparison is
+         // replaced by the branch that it selects
+         case CExpOp:
+         {  OpCode        op;
+            const addr_t* arg;
+            size_t        i_var;
+            random_itr.op_info(i_op, op, arg, i_var);
+            size_t j_var = cexp_fold(play, arg);
+            if( j_var != 0 )
+            {  size_t j_op = random_itr.var2op(j_var);
+               CPPAD_ASSERT_UNKNOWN( op_usage[j_op] == usage_t(yes_usage) );
+               if( op_previous[j_op] != 0 )
+                  j_op = size_t( op_previous[j_op] );
+               op_previous[i_op] = addr_t( j_op );
+            }
+         }
+         break;
+
          // ----------------------------------------------------------------
          // check for a previous match
          // BEGIN_SORT_THIS_LINE_PLUS_1
@@ -226,12 +246,11 @@ bool get_op_previous(
          case ZmulvpOp:
          case ZmulvvOp:
          // END_SORT_THIS_LINE_MINUS_1
-         exceed_collision_limit |= match_op(
-            collision_limit,
+         match_op(
             random_itr,
             op_previous,
             i_op,
-            hash_table_op,
+            table_op,
             work_bool,
             work_addr_t
          );
@@ -252,18 +271,8 @@ bool get_op_previous(
          break;
       }
    }
-   /* ---------------------------------------------------------------------
-   // Print out hash code usage summary
-   CppAD::vector<size_t> count(collision_limit + 1);
-   for(size_t i = 0; i <= collision_limit; ++i)
-      count[i] = 0;
-   for(size_t code = 0; code < CPPAD_HASH_TABLE_SIZE; ++code)
-   {  size_t size = hash_table_op.number_elements(code);
-      ++count[size];
-   }
-   std::cout << "count = " << count << "\n";
-   --------------------------------------------------------------------- */
-   return exceed_collision_limit;
+   CPPAD_ASSERT_UNKNOWN( table_op.n_match() < num_op );
+   return table_op.n_match();
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
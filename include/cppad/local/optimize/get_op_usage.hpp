@@ -2,9 +2,11 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_OP_USAGE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/optimize/cexp_info.hpp>
+# include <cppad/local/optimize/cexp_fold.hpp>
+# include <cppad/local/optimize/match_table.hpp>
 # include <cppad/local/optimize/usage.hpp>
 # include <cppad/local/sweep/call_atomic.hpp>
 
@@ -138,6 +140,106 @@ void op_inc_arg_usage(
    //
    return;
 }
+/*!
+{xrst_begin optimize_cexp_inc_arg_usage dev}
+{xrst_spell
+   cexp
+   csum
+}
+
+Increase Usage of a Conditional Expression Case and Propagate cexp_set
+######################################################################
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_CEXP_INC_ARG_USAGE
+   // END_CEXP_INC_ARG_USAGE
+}
+
+Purpose
+*******
+This is the same as :ref:`optimize_op_inc_arg_usage-name` where
+*i_result* is a conditional expression and *i_arg* is the operator
+for its if_true or if_false case.
+The case is only used when *i_result* is used and
+*element* is not satisfied.
+Hence *element* is included in the conditions
+for this use of *i_arg* .
+
+can_skip
+********
+If this is false, *element* is not used and this routine is the same as
+``op_inc_arg_usage`` .
+
+element
+*******
+is the conditional expression element, in *cexp_set* ,
+for which this case is not used.
+
+cexp_set
+********
+In the special case where cexp_set.n_set() is zero,
+or *can_skip* is false, cexp_set is not changed.
+Otherwise, the output value of set[i_arg] is the intersection of its
+input value (all elements if op_usage[i_arg] == usage_t(no_usage))
+and the union of set[i_result] and *element* .
+There may be postings waiting to be processed for set[i_arg]
+upon return.
+
+op_usage
+********
+This is the same as for ``op_inc_arg_usage`` except that
+if *element* is in the output value of set[i_arg] ,
+the output value of op_usage[i_arg] is usage_t(yes_usage);
+i.e., it is not part of a cumulative summation.
+
+{xrst_end optimize_cexp_inc_arg_usage}
+*/
+// BEGIN_CEXP_INC_ARG_USAGE
+template <class Base>
+void cexp_inc_arg_usage(
+   const player<Base>*         play           ,
+   bool                        check_csum     ,
+   bool                        can_skip       ,
+   size_t                      element        ,
+   size_t                      i_result       ,
+   size_t                      i_arg          ,
+   pod_vector<usage_t>&        op_usage       ,
+   sparse::list_setvec&        cexp_set       )
+// END_CEXP_INC_ARG_USAGE
+{  //
+   can_skip &= cexp_set.n_set() != 0;
+   if( ! can_skip )
+   {  op_inc_arg_usage(
+         play, check_csum, i_result, i_arg, op_usage, cexp_set
+      );
+      return;
+   }
+   //
+   // first_use
+   bool first_use = op_usage[i_arg] == usage_t(no_usage);
+   //
+   // keep_element
+   // set[i_arg] intersect ( set[i_result] union {element} ) contains
+   // element if and only if set[i_arg] contains element.
+   bool keep_element = first_use;
+   if( ! first_use )
+   {  cexp_set.process_post(i_arg);
+      keep_element = cexp_set.is_element(i_arg, element);
+   }
+   //
+   // set[i_arg] = set[i_arg] intersect set[i_result]
+   op_inc_arg_usage(
+      play, check_csum, i_result, i_arg, op_usage, cexp_set
+   );
+   //
+   if( keep_element )
+   {  cexp_set.post_element(i_arg, element);
+      op_usage[i_arg] = usage_t(yes_usage);
+   }
+   return;
+}
 
 /*!
 {xrst_begin optimize_get_op_usage dev}
@@ -224,6 +326,16 @@ If the comparison for the j-th conditional expression is equal to bool(k),
 the i-th operator can be skipped (is not used by any of the results).
 Note that j indexes the CExpOp operators in the operation sequence.
 
+Merged Comparisons
+==================
+Conditional expressions that have the same comparison operator
+and the same *left* and *right* operands have the same comparison result.
+The elements for all of these conditional expressions use the index j
+of the last one in the operation sequence that is used.
+Hence an operator that is only used by the true (false) cases of these
+conditional expressions can be skipped when the comparison is false (true),
+and only one conditional skip operator is needed for all of them.
+
 vecad_used
 **********
 The input size of this vector must be zero.
@@ -244,6 +356,8 @@ the first and second AFunOp have usage corresponding to the entire call.
 The arguments have the usage for particular parameter or variable.
 This usage is only for creating variables, not for creating
 dynamic parameters.
+If a conditional expression is folded by :ref:`optimize_cexp_fold-name` ,
+only the branch that it selects is used.
 
 {xrst_end optimize_get_op_usage}
 */
@@ -349,6 +463,12 @@ void get_op_usage(
    //
    if( num_set > 0 )
       cexp_set.resize(num_set, end_set);
+   //
+   // cexp_table
+   // maps the comparison for a conditional expression to the index of the
+   // last conditional expression in the operation sequence that is used and
+   // has the same comparison; see Merged Comparisons above.
+   match_table cexp_table;
    // -----------------------------------------------------------------------
    // initilaize operator usage for reverse dependency analysis.
    op_usage.resize( num_op );
@@ -465,6 +585,23 @@ void get_op_usage(
          }
          break; // --------------------------------------------
 
+         // Fused multiply add operators
+         case FmavvpOp:
+         case FmavvvOp:
+         CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
+         if( use_result != usage_t(no_usage) )
+         {  size_t n_var = 2;
+            if( op == FmavvvOp )
+               n_var = 3;
+            for(size_t i = 0; i < n_var; i++)
+            {  size_t j_op = random_itr.var2op(size_t(arg[i]));
+               op_inc_arg_usage(
+                  play, check_csum, i_op, j_op, op_usage, cexp_set
+               );
+            }
+         }
+         break; // --------------------------------------------
+
          // Conditional expression operators
          // arg[2], arg[3], arg[4], arg[5] are parameters or variables
          case CExpOp:
@@ -474,61 +611,75 @@ void get_op_usage(
             cexp2op[ cexp_index ] = addr_t(i_op);
          }
          if( use_result != usage_t(no_usage) )
-         {  CPPAD_ASSERT_UNKNOWN( NumArg(CExpOp) == 6 );
-            // propgate from result to left argument
-            if( arg[1] & 1 )
-            {  size_t j_op = random_itr.var2op(size_t(arg[2]));
+         {  // j_var
+            // is non-zero if the comparison is between constants
+            size_t j_var = cexp_fold(play, arg);
+            if( j_var != 0 )
+            {  // only the selected branch is used
+               size_t j_op = random_itr.var2op(j_var);
                op_inc_arg_usage(
                   play, check_csum, i_op, j_op, op_usage, cexp_set
                );
             }
-            // propgate from result to right argument
-            if( arg[1] & 2 )
-            {  size_t j_op = random_itr.var2op(size_t(arg[3]));
-               op_inc_arg_usage(
+            else
+            {  CPPAD_ASSERT_UNKNOWN( NumArg(CExpOp) == 6 );
+               // propgate from result to left argument
+               if( arg[1] & 1 )
+               {  size_t j_op = random_itr.var2op(size_t(arg[2]));
+                  op_inc_arg_usage(
                      play, check_csum, i_op, j_op, op_usage, cexp_set
-               );
-            }
-            // are if_true and if_false cases the same variable
-            bool same_variable = (arg[1] & 4) != 0;
-            same_variable     &= (arg[1] & 8) != 0;
-            same_variable     &= arg[4] == arg[5];
-            //
-            // if_true
-            if( arg[1] & 4 )
-            {  size_t j_op = random_itr.var2op(size_t(arg[4]));
-               bool can_skip = conditional_skip & (! same_variable);
-               can_skip     &= op_usage[j_op] == usage_t(no_usage);
-               op_inc_arg_usage(
-                  play, check_csum, i_op, j_op, op_usage, cexp_set
-               );
-               if( can_skip )
-               {  // j_op corresponds to the value used when the
+                  );
+               }
+               // propgate from result to right argument
+               if( arg[1] & 2 )
+               {  size_t j_op = random_itr.var2op(size_t(arg[3]));
+                  op_inc_arg_usage(
+                        play, check_csum, i_op, j_op, op_usage, cexp_set
+                  );
+               }
+               // are if_true and if_false cases the same variable
+               bool same_variable = (arg[1] & 4) != 0;
+               same_variable     &= (arg[1] & 8) != 0;
+               same_variable     &= arg[4] == arg[5];
+               //
+               // skip_index
+               // index used for the elements that this conditional
+               // expression adds to cexp_set
+               size_t skip_index = cexp_index;
+               if( conditional_skip )
+               {  addr_t key[3];
+                  key[0] = addr_t( 4 * size_t(arg[0]) + size_t(arg[1] & 3) );
+                  key[1] = arg[2];
+                  key[2] = arg[3];
+                  skip_index = cexp_table.find_or_insert(
+                     opcode_t(CExpOp), 3, key, cexp_index
+                  );
+               }
+               //
+               // if_true
+               if( arg[1] & 4 )
+               {  size_t j_op = random_itr.var2op(size_t(arg[4]));
+                  // j_op corresponds to the value used when the
                   // comparison result is true. It can be skipped when
                   // the comparison is false (0).
-                  size_t element = 2 * cexp_index + 0;
-                  cexp_set.post_element(j_op, element);
-                  //
-                  op_usage[j_op] = usage_t(yes_usage);
+                  size_t element = 2 * skip_index + 0;
+                  cexp_inc_arg_usage(
+                     play, check_csum, conditional_skip & (! same_variable),
+                     element, i_op, j_op, op_usage, cexp_set
+                  );
                }
-            }
-            //
-            // if_false
-            if( arg[1] & 8 )
-            {  size_t j_op = random_itr.var2op(size_t(arg[5]));
-               bool can_skip = conditional_skip & (! same_variable);
-               can_skip     &= op_usage[j_op] == usage_t(no_usage);
-               op_inc_arg_usage(
-                  play, check_csum, i_op, j_op, op_usage, cexp_set
-               );
-               if( can_skip )
-               {  // j_op corresponds to the value used when the
+               //
+               // if_false
+               if( arg[1] & 8 )
+               {  size_t j_op = random_itr.var2op(size_t(arg[5]));
+                  // j_op corresponds to the value used when the
                   // comparison result is false. It can be skipped when
-                  // the comparison is true (0).
-                  size_t element = 2 * cexp_index + 1;
-                  cexp_set.post_element(j_op, element);
-                  //
-                  op_usage[j_op] = usage_t(yes_usage);
+                  // the comparison is true (1).
+                  size_t element = 2 * skip_index + 1;
+                  cexp_inc_arg_usage(
+                     play, check_csum, conditional_skip & (! same_variable),
+                     element, i_op, j_op, op_usage, cexp_set
+                  );
                }
             }
          }
@@ -684,8 +835,31 @@ void get_op_usage(
          // ============================================================
          case CSumOp:
          CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
-         {
-            for(size_t i = 5; i < size_t(arg[2]); i++)
+         if( use_result != usage_t(no_usage) )
+         {  for(size_t i = 5; i < size_t(arg[2]); i++)
+            {  size_t j_op = random_itr.var2op(size_t(arg[i]));
+               op_inc_arg_usage(
+                  play, check_csum, i_op, j_op, op_usage, cexp_set
+               );
+            }
+         }
+         break;
+
+         // =============================================================
+         // weighted summation operator
+         // ============================================================
+         case WSumOp:
+         CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+         if( use_result != usage_t(no_usage) )
+         {  // variables in parameter variable pairs
+            for(size_t i = 5; i < size_t(arg[1]); i += 2)
+            {  size_t j_op = random_itr.var2op(size_t(arg[i]));
+               op_inc_arg_usage(
+                  play, check_csum, i_op, j_op, op_usage, cexp_set
+               );
+            }
+            // variables in variable variable pairs
+            for(size_t i = size_t(arg[1]); i < size_t(arg[3]); ++i)
             {  size_t j_op = random_itr.var2op(size_t(arg[i]));
                op_inc_arg_usage(
                   play, check_csum, i_op, j_op, op_usage, cexp_set
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_GET_PAR_USAGE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*!
 \file get_cexp_info.hpp
@@ -221,6 +221,7 @@ void get_par_usage(
          case EqvvOp:
          case ExpOp:
          case Expm1Op:
+         case FmavvvOp:
          case InvOp:
          case LdvOp:
          case LevvOp:
@@ -290,6 +291,7 @@ void get_par_usage(
          break;
 
          // cases where only third argument is a parameter
+         case FmavvpOp:
          case StvpOp:
          CPPAD_ASSERT_UNKNOWN( 3 <= NumArg(op) )
          par_usage[arg[2]] = true;
@@ -317,6 +319,12 @@ void get_par_usage(
          CPPAD_ASSERT_UNKNOWN( 5 == NumArg(op) )
          break;
 
+         // weighted summation, parameters in parameter variable pairs
+         case WSumOp:
+         for(size_t i = 4; i < size_t(arg[1]); i += 2)
+            par_usage[arg[i]] = true;
+         break;
+
          // --------------------------------------------------------------
          // atomic function calls
          case AFunOp:
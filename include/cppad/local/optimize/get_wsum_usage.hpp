@@ -0,0 +1,143 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_WSUM_USAGE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_WSUM_USAGE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/optimize/get_n_use.hpp>
+# include <cppad/local/optimize/get_op_usage.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_get_wsum_usage dev}
+{xrst_spell
+   mulpv
+   mulvv
+}
+
+Determine Which Multiplications Are Terms in a Weighted Summation
+#################################################################
+
+Syntax
+******
+
+| ``get_wsum_usage`` (
+| |tab| *random_itr* ,
+| |tab| *op_previous* ,
+| |tab| *n_use* ,
+| |tab| *op_usage*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+This routine is only called when the ``weighted_sum_op``
+:ref:`optimize@options` is present.
+It must be called after :ref:`optimize_get_op_previous-name` so that
+the multiplications that become terms in a weighted summation
+have been through common subexpression elimination.
+
+random_itr
+**********
+is a random iterator for the old operation sequence.
+
+op_previous
+***********
+is the mapping from an operator index to a previous operator
+that is equivalent (zero if there is no such operator).
+
+n_use
+*****
+is the number of times each result is used in the new operation sequence;
+see :ref:`optimize_get_n_use-name` .
+
+op_usage
+********
+The size of this vector is the number of operators in the
+old operation sequence.
+On input, op_usage[i] is the usage for the i-th operator
+counting previous optimization.
+Upon return, some MulpvOp and MulvvOp operators that had ``yes_usage``
+have ``wsum_usage`` .
+Such a multiplication is not replaced by a previous operator,
+is used exactly once,
+and that use is by an operator that is recorded as part of a
+cumulative summation; see :ref:`optimize_record_csum-name` .
+
+{xrst_end optimize_get_wsum_usage}
+*/
+
+// BEGIN_PROTOTYPE
+template <class Addr>
+void get_wsum_usage(
+   const play::const_random_iterator<Addr>&    random_itr          ,
+   const pod_vector<addr_t>&                   op_previous         ,
+   const pod_vector<unsigned char>&            n_use               ,
+   pod_vector<usage_t>&                        op_usage            )
+// END_PROTOTYPE
+{  //
+   // number of operators in the tape
+   const size_t num_op = random_itr.num_op();
+   CPPAD_ASSERT_UNKNOWN( op_previous.size() == num_op );
+   CPPAD_ASSERT_UNKNOWN( n_use.size() == num_op );
+   CPPAD_ASSERT_UNKNOWN( op_usage.size() == num_op );
+   //
+   // is_variable
+   pod_vector<bool> is_variable;
+   //
+   // op_usage
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+   {  //
+      // op, arg, i_var
+      OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      random_itr.op_info(i_op, op, arg, i_var);
+      //
+      // in_csum
+      // is this operator recorded as part of a cumulative summation
+      bool in_csum = op_usage[i_op] == usage_t(csum_usage);
+      if( op_usage[i_op] == usage_t(yes_usage) && op_previous[i_op] == 0 )
+      {  if( op == CSumOp )
+            in_csum = true;
+         else if( op_add_or_sub(op) )
+         {  // top of a cumulative summation
+            arg_is_variable(op, arg, is_variable);
+            for(size_t j = 0; j < 2; ++j) if( is_variable[j] )
+            {  size_t j_op = random_itr.var2op( size_t(arg[j]) );
+               in_csum    |= op_usage[j_op] == usage_t(csum_usage);
+            }
+         }
+      }
+      if( in_csum )
+      {  //
+         // op_usage
+         // The recording pass cannot follow op_previous (it shares memory
+         // with the new operator indices) so a replaced multiplication
+         // is not a term.
+         arg_is_variable(op, arg, is_variable);
+         for(size_t j = 0; j < is_variable.size(); ++j) if( is_variable[j] )
+         {  size_t j_op = random_itr.var2op( size_t(arg[j]) );
+            OpCode op_j = random_itr.get_op(j_op);
+            bool term   = op_j == MulpvOp || op_j == MulvvOp;
+            term       &= op_usage[j_op] == usage_t(yes_usage);
+            term       &= op_previous[j_op] == 0;
+            term       &= n_use[j_op] == 1;
+            if( term )
+               op_usage[j_op] = usage_t(wsum_usage);
+         }
+      }
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
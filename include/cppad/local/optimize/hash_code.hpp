@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_HASH_CODE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*!
 \file local/optimize/hash_code.hpp
@@ -27,7 +27,8 @@ is a vector of length num_arg
 containing the corresponding argument indices for this operator.
 
 \return
-is a hash code that is between zero and CPPAD_HASH_TABLE_SIZE - 1.
+is a hash code that uses all the bits in a size_t value.
+The caller reduces it to the size of its table; see match_table.
 */
 
 inline size_t optimize_hash_code(
@@ -35,14 +36,22 @@ inline size_t optimize_hash_code(
    size_t        num_arg ,
    const addr_t* arg     )
 {  CPPAD_ASSERT_UNKNOWN( num_arg < 4 );
-   size_t prime = 1;
-   size_t sum   = prime * size_t(op);
+   //
+   // half the number of bits in a size_t value
+   const size_t half = 4 * sizeof(size_t);
+   //
+   // multiplier for the golden ratio multiplicative hash
+   const size_t multiplier = size_t( 0x9E3779B97F4A7C15ull );
+   //
+   size_t code = size_t(op);
    for(size_t i = 0; i < num_arg; i++)
-   {  prime    = prime + 2;  // 3, 5, 7 in that order
-      sum += prime * size_t(arg[i]);
+   {  code  = (code ^ size_t(arg[i])) * multiplier;
+      code ^= code >> half;
    }
+   code *= multiplier;
+   code ^= code >> half;
    //
-   return sum % CPPAD_HASH_TABLE_SIZE;
+   return code;
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
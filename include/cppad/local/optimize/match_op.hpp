@@ -2,9 +2,9 @@
 # define CPPAD_LOCAL_OPTIMIZE_MATCH_OP_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
-# include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/match_table.hpp>
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
 /*
@@ -19,12 +19,11 @@ Search for a Previous Operator that Matches Current Operator
 Syntax
 ******
 
-| *exceed_collision_limit* = ``match_op`` (
-| |tab| ``collision_limit`` ,
+| ``match_op`` (
 | |tab| ``random_itr`` ,
 | |tab| ``op_previous`` ,
 | |tab| ``current`` ,
-| |tab| ``hash_tape_op`` ,
+| |tab| ``table_op`` ,
 | |tab| ``work_bool`` ,
 | |tab| ``work_addr_t``
 | )
@@ -43,11 +42,6 @@ and the argument has previous match,
 the previous match for the argument is used when checking for a match
 for the current operator.
 
-collision_limit
-***************
-is the maximum number of collisions (matches) allowed for one
-expression hash code value.
-
 random_itr
 **********
 is a random iterator for the old operation sequence.
@@ -80,19 +74,14 @@ erf
 The operators ``ErfOp`` and ``ErfcOp`` have
 three arguments, but only one true argument (the others are always the same).
 
-hash_table_op
-*************
-is assumed to be initialized as a vector of empty sets before the
+table_op
+********
+is a :ref:`optimize_match_table-name` that is empty before the
 first call to match_op (for a pass of the operation sequence).
-
-| |tab| *hash_table_op* . ``n_set`` () == ``CPPAD_HASH_TABLE_SIZE``
-| |tab| *hash_table_op* . ``end`` ()   == *op_previous* . ``size`` ()
-
-If *i_op* is an element of the j-th set,
-then the operation *op_previous* [ *i_op* ] has hash code j,
-and does not match any other element of the j-th set.
-An entry to j-th set for the current operator is added each time
-match_op is called and a match for the current operator is not found.
+Its entries are the signatures for the previous operators
+that do not have a match.
+The signature for the current operator is added to the table
+when a match for the current operator is not found.
 
 work_bool
 *********
@@ -106,21 +95,15 @@ work space that is used by match_op between calls to increase speed.
 Should be empty on first call for this forward pass of the operation
 sequence and not modified until forward pass is done
 
-exceed_collision_limit
-**********************
-If the *collision_limit* is exceeded (is not exceeded),
-the return value is true (false).
-
 {xrst_end optimize_match_op}
 */
 // BEGIN_PROTOTYPE
 template <class Addr>
-bool match_op(
-   size_t                                      collision_limit ,
+void match_op(
    const play::const_random_iterator<Addr>&    random_itr      ,
    pod_vector<addr_t>&                         op_previous     ,
    size_t                                      current         ,
-   sparse::list_setvec&                        hash_table_op   ,
+   match_table&                                table_op        ,
    pod_vector<bool>&                           work_bool       ,
    pod_vector<addr_t>&                         work_addr_t     )
 // END_PROTOTYPE
@@ -156,11 +139,6 @@ bool match_op(
       break;
    }
 # endif
-   // initialize return value
-   bool exceed_collision_limit = false;
-   // num_op
-   size_t num_op = random_itr.num_op();
-   //
    // num_var
    size_t num_var = random_itr.num_var();
    //
@@ -176,13 +154,9 @@ bool match_op(
    }
    //
    CPPAD_ASSERT_UNKNOWN( var2previous_var.size() == num_var );
-   CPPAD_ASSERT_UNKNOWN( num_op == op_previous.size() );
+   CPPAD_ASSERT_UNKNOWN( random_itr.num_op() == op_previous.size() );
    CPPAD_ASSERT_UNKNOWN( op_previous[current] == 0 );
-   CPPAD_ASSERT_UNKNOWN(
-      hash_table_op.n_set() == CPPAD_HASH_TABLE_SIZE
-   );
-   CPPAD_ASSERT_UNKNOWN( hash_table_op.end() == num_op );
-   CPPAD_ASSERT_UNKNOWN( current < num_op );
+   CPPAD_ASSERT_UNKNOWN( current < op_previous.size() );
    //
    // op, arg, i_var
    OpCode        op;
@@ -201,8 +175,8 @@ bool match_op(
    CPPAD_ASSERT_UNKNOWN( variable.size() == num_arg );
    //
    // If j-th argument to this operator is a variable, and a previous
-   // variable will be used in its place, use the previous variable for
-   // hash coding and matching.
+   // variable will be used in its place, use the previous variable in the
+   // signature for this operator.
    addr_t arg_match[] = {
       // Invalid value that will not be used. This initialization avoid
       // a wraning on some compilers
@@ -212,7 +186,7 @@ bool match_op(
    };
    if( (op == AddvvOp) | (op == MulvvOp ) )
    {  // in special case where operator is commutative and operands are variables,
-      // put lower index first so hash code does not depend on operator order
+      // put lower index first so signature does not depend on operator order
       CPPAD_ASSERT_UNKNOWN( num_arg == 2 );
       arg_match[0] = var2previous_var[ arg[0] ];
       arg_match[1] = var2previous_var[ arg[1] ];
@@ -224,76 +198,31 @@ bool match_op(
       if( variable[j] )
          arg_match[j] = var2previous_var[ arg[j] ];
    }
-
-   //
-   size_t code = optimize_hash_code(opcode_t(op), num_arg, arg_match);
    //
-   // iterator for the set with this hash code
-   sparse::list_setvec_const_iterator itr(hash_table_op, code);
+   // candidate
+   // If the signature for the current operator is not in the table,
+   // it is added and candidate is equal to current.
+   size_t candidate = table_op.find_or_insert(
+      opcode_t(op), num_arg, arg_match, current
+   );
+   if( candidate == current )
+      return;
    //
-   // check for a match
-   size_t count = 0;
-   while( *itr != num_op )
-   {  ++count;
-      //
-      // candidate previous for current operator
-      size_t  candidate  = *itr;
-      CPPAD_ASSERT_UNKNOWN( candidate < current );
-      CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
-      //
-      OpCode        op_c;
+   // There is no collision limit because the key for the table is the
+   // entire signature, so a matching signature is a match.
+   CPPAD_ASSERT_UNKNOWN( candidate < current );
+   CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
+   op_previous[current] = static_cast<addr_t>( candidate );
+   if( NumRes(op) > 0 )
+   {  OpCode        op_c;
       const addr_t* arg_c;
       size_t        i_var_c;
       random_itr.op_info(candidate, op_c, arg_c, i_var_c);
-      //
-      // check for a match
-      bool match = op == op_c;
-      size_t j   = 0;
-      while( match & (j < num_arg) )
-      {  if( variable[j] )
-            match &= arg_match[j] == var2previous_var[ arg_c[j] ];
-         else
-            match &= arg_match[j] == arg_c[j];
-         ++j;
-      }
-      if( (! match) & ( (op == AddvvOp) | (op == MulvvOp) ) )
-      {  // communative so check for reverse order match
-         match  = op == op_c;
-         //
-         // 2024-02-14:
-         // If op_c is not AddvvOp or MulvvOp, its arguments may not be
-         // variables and the code below could attempt to access
-         // var2previous_var out of range. See 2024@mm-dd@02-14.
-         if( match )
-         {  match &= arg_match[0] == var2previous_var[ arg_c[1] ];
-            match &= arg_match[1] == var2previous_var[ arg_c[0] ];
-         }
-      }
-      if( match )
-      {  op_previous[current] = static_cast<addr_t>( candidate );
-         if( NumRes(op) > 0 )
-         {  CPPAD_ASSERT_UNKNOWN( i_var_c < i_var );
-            var2previous_var[i_var] = addr_t( i_var_c );
-         }
-         return exceed_collision_limit;
-      }
-      ++itr;
+      CPPAD_ASSERT_UNKNOWN( op_c == op );
+      CPPAD_ASSERT_UNKNOWN( i_var_c < i_var );
+      var2previous_var[i_var] = addr_t( i_var_c );
    }
-
-   // see print (that is commented out) at bottom of get_op_previous.hpp
-   CPPAD_ASSERT_UNKNOWN( count <= collision_limit );
-   if( count == collision_limit )
-   {  // restart the list
-      hash_table_op.clear(code);
-      // limit has been exceeded
-      exceed_collision_limit = true;
-   }
-   // No match was found. Add this operator to the set for this hash code
-   // Not using post_element because we need to iterate for
-   // this code before adding another element for this code.
-   hash_table_op.add_element(code, current);
-   //
-   return exceed_collision_limit;
+   return;
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
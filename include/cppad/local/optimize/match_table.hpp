@@ -0,0 +1,201 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_MATCH_TABLE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_MATCH_TABLE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/optimize/hash_code.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_match_table dev}
+
+Table of Operators Keyed by Their Signature
+###########################################
+
+Syntax
+******
+| ``match_table`` *table*
+| *previous* = *table* . ``find_or_insert`` (
+| |tab| *op* , *num_arg* , *arg* , *index*
+| )
+| *n_match* = *table* . ``n_match`` ()
+| *n_entry* = *table* . ``n_entry`` ()
+
+Purpose
+*******
+This is an open addressing hash table used for
+common subexpression elimination during optimization.
+The key for an entry is the signature of an operator; i.e.,
+its operator code and its arguments.
+The table doubles in size whenever it becomes half full,
+so there is no limit on the number of operators with the same hash code
+and no matches are lost.
+
+op
+**
+is the operator code for this signature.
+It is an ``opcode_t`` value and must be less than the maximum ``addr_t``
+value.
+
+num_arg
+*******
+is the number of arguments in the signature; it must be less than four.
+Two signatures with the same *op* must have the same *num_arg* .
+
+arg
+***
+is a vector of length *num_arg* containing the arguments
+in the signature.
+For a commutative operator, the caller should put the arguments
+in a standard order so that the signature does not depend on the order.
+
+index
+*****
+is the value to store in the table if this signature is not
+already in the table.
+
+previous
+********
+If this signature is in the table, *previous* is the
+*index* value that was stored with it and the table is not changed.
+Otherwise, *index* is stored with this signature and
+*previous* is equal to *index* .
+
+n_match
+*******
+is the number of calls to ``find_or_insert`` that found
+a previous entry in the table.
+
+n_entry
+*******
+is the number of entries in the table.
+
+{xrst_end optimize_match_table}
+*/
+class match_table {
+private:
+   // number of entries in the table
+   size_t n_entry_;
+   //
+   // number of times a signature was found in the table
+   size_t n_match_;
+   //
+   // capacity of the table minus one (the capacity is a power of two)
+   size_t mask_;
+   //
+   // code_[slot] is the full hash code for the entry in this slot
+   pod_vector<size_t> code_;
+   //
+   // index_[slot] is the index for the entry in this slot
+   // (empty() if there is no entry in this slot)
+   pod_vector<size_t> index_;
+   //
+   // key_[4 * slot + k] is the operator (k == 0) or an argument (k > 0)
+   // for the entry in this slot
+   pod_vector<addr_t> key_;
+   //
+   // value of index_ for an empty slot
+   static size_t empty(void)
+   {  return std::numeric_limits<size_t>::max(); }
+   //
+   // allocate an empty table with the specified capacity
+   void allocate(size_t capacity)
+   {  CPPAD_ASSERT_UNKNOWN( (capacity & (capacity - 1)) == 0 );
+      mask_ = capacity - 1;
+      code_.resize(capacity);
+      index_.resize(capacity);
+      key_.resize(4 * capacity);
+      for(size_t slot = 0; slot < capacity; ++slot)
+         index_[slot] = empty();
+   }
+   //
+   // double the capacity of the table and re-insert its entries
+   void grow(void)
+   {  pod_vector<size_t> code, index;
+      pod_vector<addr_t> key;
+      code.swap(code_);
+      index.swap(index_);
+      key.swap(key_);
+      //
+      size_t capacity = 2 * (mask_ + 1);
+      allocate(capacity);
+      for(size_t old_slot = 0; old_slot < index.size(); ++old_slot)
+      if( index[old_slot] != empty() )
+      {  size_t slot = code[old_slot] & mask_;
+         while( index_[slot] != empty() )
+            slot = (slot + 1) & mask_;
+         code_[slot]  = code[old_slot];
+         index_[slot] = index[old_slot];
+         for(size_t k = 0; k < 4; ++k)
+            key_[4 * slot + k] = key[4 * old_slot + k];
+      }
+   }
+public:
+   // ctor
+   match_table(void)
+   : n_entry_(0), n_match_(0)
+   {  allocate(64); }
+   //
+   // n_match
+   size_t n_match(void) const
+   {  return n_match_; }
+   //
+   // n_entry
+   size_t n_entry(void) const
+   {  return n_entry_; }
+   //
+   // find_or_insert
+   size_t find_or_insert(
+      opcode_t      op      ,
+      size_t        num_arg ,
+      const addr_t* arg     ,
+      size_t        index   )
+   {  CPPAD_ASSERT_UNKNOWN( num_arg < 4 );
+      CPPAD_ASSERT_UNKNOWN( index != empty() );
+      CPPAD_ASSERT_UNKNOWN(
+         size_t(op) < size_t( std::numeric_limits<addr_t>::max() )
+      );
+      //
+      // key
+      addr_t key[4];
+      key[0] = addr_t(op);
+      for(size_t k = 1; k < 4; ++k)
+         key[k] = k <= num_arg ? arg[k-1] : addr_t(0);
+      //
+      // code
+      size_t code = optimize_hash_code(op, num_arg, arg);
+      //
+      // slot
+      size_t slot = code & mask_;
+      while( index_[slot] != empty() )
+      {  bool match = code_[slot] == code;
+         for(size_t k = 0; k < 4; ++k)
+            match &= key_[4 * slot + k] == key[k];
+         if( match )
+         {  ++n_match_;
+            return index_[slot];
+         }
+         slot = (slot + 1) & mask_;
+      }
+      //
+      // insert this signature in the empty slot
+      code_[slot]  = code;
+      index_[slot] = index;
+      for(size_t k = 0; k < 4; ++k)
+         key_[4 * slot + k] = key[k];
+      ++n_entry_;
+      //
+      // keep the table at most half full
+      if( 2 * n_entry_ > mask_ + 1 )
+         grow();
+      //
+      return index;
+   }
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -0,0 +1,131 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_OP_COST_HPP
+# define CPPAD_LOCAL_OPTIMIZE_OP_COST_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/op_code_var.hpp>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+/*
+{xrst_begin optimize_op_cost dev}
+
+Estimated Cost of Evaluating an Operator
+########################################
+
+Syntax
+******
+| *cost* = ``op_cost`` ( *op* , *arg* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+This is a rough model for the relative cost of evaluating an operator.
+It is used to decide if a conditional skip operator is profitable; see
+:ref:`optimize@options@conditional_skip_cost=value` .
+The unit of cost is the cost of an addition, which is also the cost of
+flagging one operator to be skipped.
+
+op
+**
+is the operator.
+
+arg
+***
+is the argument vector for this operator.
+It is only used for operators with a variable number of arguments.
+
+cost
+****
+is the estimated cost of evaluating the operator.
+It is greater than zero.
+
+{xrst_end optimize_op_cost}
+*/
+// BEGIN_PROTOTYPE
+template <class Addr>
+size_t op_cost(OpCode op, const Addr* arg)
+// END_PROTOTYPE
+{  size_t cost = 1;
+   switch( op )
+   {  //
+      // cumulative summation: one addition per term
+      case CSumOp:
+      CPPAD_ASSERT_UNKNOWN( 5 <= size_t(arg[4]) );
+      cost = size_t(arg[4]) - 5;
+      break;
+      //
+      // weighted summation: one multiply add per term and
+      // there are two arguments per term
+      case WSumOp:
+      CPPAD_ASSERT_UNKNOWN( 4 <= size_t(arg[3]) );
+      cost = size_t(arg[3]) - 4;
+      break;
+      //
+      // division, square root, fused multiply add
+      case DivpvOp:
+      case DivvpOp:
+      case DivvvOp:
+      case FmavvpOp:
+      case FmavvvOp:
+      case SqrtOp:
+      cost = 2;
+      break;
+      //
+      // exponential and logarithm
+      case DisOp:
+      case ExpOp:
+      case Expm1Op:
+      case Log1pOp:
+      case LogOp:
+      cost = 4;
+      break;
+      //
+      // functions that have an auxiliary result
+      case AcosOp:
+      case AcoshOp:
+      case AsinOp:
+      case AsinhOp:
+      case AtanOp:
+      case AtanhOp:
+      case CosOp:
+      case CoshOp:
+      case ErfOp:
+      case ErfcOp:
+      case SinOp:
+      case SinhOp:
+      case TanOp:
+      case TanhOp:
+      cost = 6;
+      break;
+      //
+      // power functions
+      case PowpvOp:
+      case PowvpOp:
+      case PowvvOp:
+      cost = 8;
+      break;
+      //
+      // the first or last operator in an atomic function call
+      case AFunOp:
+      cost = 10;
+      break;
+      //
+      default:
+      break;
+   }
+   if( cost == 0 )
+      cost = 1;
+   return cost;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
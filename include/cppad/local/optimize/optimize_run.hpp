@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_OPTIMIZE_RUN_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <stack>
@@ -12,14 +12,19 @@
 # include <cppad/local/optimize/get_par_usage.hpp>
 # include <cppad/local/optimize/get_dyn_previous.hpp>
 # include <cppad/local/optimize/get_op_previous.hpp>
+# include <cppad/local/optimize/get_n_use.hpp>
+# include <cppad/local/optimize/get_fma_usage.hpp>
+# include <cppad/local/optimize/get_wsum_usage.hpp>
 # include <cppad/local/optimize/get_cexp_info.hpp>
 # include <cppad/local/optimize/size_pair.hpp>
 # include <cppad/local/optimize/csum_stacks.hpp>
 # include <cppad/local/optimize/cexp_info.hpp>
+# include <cppad/local/optimize/op_cost.hpp>
 # include <cppad/local/optimize/record_pv.hpp>
 # include <cppad/local/optimize/record_vp.hpp>
 # include <cppad/local/optimize/record_vv.hpp>
 # include <cppad/local/optimize/record_csum.hpp>
+# include <cppad/local/optimize/record_fma.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
@@ -39,8 +44,8 @@ Convert a player object to an optimized recorder object
 Syntax
 ******
 
-| *exceed_collision_limit* = ``local::optimize::optimize_run`` (
-| |tab| ``options`` , ``n`` , ``dep_taddr`` , ``play`` , ``rec``
+| *n_match* = ``local::optimize::optimize_run`` (
+| |tab| ``options`` , ``n`` , ``frozen`` , ``dep_taddr`` , ``play`` , ``rec``
 | )
 
 Prototype
@@ -70,6 +75,13 @@ conditional skip operations will not be generated.
 This may make the optimize routine use significantly less memory
 and take significantly less time.
 
+conditional_skip_cost=value
+===========================
+If this sub-string appears, a conditional skip operation is only generated
+if the :ref:`optimize_op_cost-name` sum for the operators that it skips
+is greater than or equal *value* times two plus the number of
+operators that it skips.
+
 no_compare_op
 =============
 If this sub-string appears,
@@ -95,19 +107,28 @@ no cumulative sum operations will be generated during the optimization; see
 
 collision_limit=value
 =====================
-If this substring appears,
-where *value* is a sequence of decimal digits,
-the optimizer's hash code collision limit will be set to *value* .
-When the collision limit is exceeded, the expressions with that hash code
-are removed and a new lists of expressions with that has code is started.
-The larger *value* , the more identical expressions the optimizer
-can recognize, but the slower the optimizer may run.
-The default for *value* is ``10`` .
+This option is no longer used because
+there is no limit on the number of operators with the same hash code;
+see :ref:`optimize_match_table-name` .
+It is still accepted so that existing *options* strings work.
 
 n
 *
 is the number of independent variables on the tape.
 
+frozen
+******
+This vector has size equal to the number of independent dynamic parameters.
+If *frozen* [ *j* ] is true, the *j*-th independent dynamic parameter
+is still an independent dynamic parameter in *rec* ,
+but all of its uses are replaced by a constant equal to its current value.
+The same is done for a dependent dynamic parameter if all of its
+arguments are constants or are replaced by constants
+(dynamic parameters that are results of atomic functions are not replaced).
+The dynamic parameters replaced in this way are treated as dynamic by the
+analysis in this routine, so optimizing *rec* again is necessary to fold
+them into the operators that use them; see :ref:`freeze_dynamic-name` .
+
 dep_taddr
 *********
 On input this vector contains the indices for each of the dependent
@@ -128,10 +149,11 @@ it corresponds to directly after the default constructor.
 Upon return, it contains an optimized version of the
 operation sequence corresponding to *play* .
 
-exceed_collision_limit
-**********************
-If the *collision_limit* is exceeded (is not exceeded),
-the return value is true (false).
+n_match
+*******
+is the number of operators in *play* that were replaced by an
+equivalent previous operator; see
+:ref:`optimize_get_op_previous@n_match` .
 
 Contents
 ********
@@ -140,10 +162,16 @@ Contents
    include/cppad/local/optimize/cexp_info.hpp
    include/cppad/local/optimize/get_cexp_info.hpp
    include/cppad/local/optimize/get_op_usage.hpp
+   include/cppad/local/optimize/cexp_fold.hpp
    include/cppad/local/optimize/get_par_usage.hpp
    include/cppad/local/optimize/record_csum.hpp
+   include/cppad/local/optimize/match_table.hpp
    include/cppad/local/optimize/match_op.hpp
    include/cppad/local/optimize/get_op_previous.hpp
+   include/cppad/local/optimize/get_n_use.hpp
+   include/cppad/local/optimize/get_fma_usage.hpp
+   include/cppad/local/optimize/get_wsum_usage.hpp
+   include/cppad/local/optimize/op_cost.hpp
 }
 
 {xrst_end optimize_run}
@@ -151,15 +179,15 @@ Contents
 
 // BEGIN_PROTOTYPE
 template <class Addr, class Base>
-bool optimize_run(
+size_t optimize_run(
    const std::string&                         options    ,
    size_t                                     n          ,
+   const pod_vector<bool>&                    frozen     ,
    pod_vector<size_t>&                        dep_taddr  ,
    player<Base>*                              play       ,
    recorder<Base>*                            rec        )
 // END_PROTOTYPE
-{  bool exceed_collision_limit = false;
-   //
+{  //
    // check that recorder is empty
    CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
    //
@@ -168,14 +196,16 @@ bool optimize_run(
    local::play::const_random_iterator<Addr> random_itr =
       play->template get_random<Addr>();
    //
-   // compare_op, conditional_skip, cumulative_sum_op, print_for_op,
-   // collision_limit
-   options_t result         = extract_option(options);
-   bool compare_op          = result.compare_op;
-   bool conditional_skip    = result.conditional_skip;
+   // compare_op, conditional_skip, conditional_skip_cost,
+   // cumulative_sum_op, multiply_add_op, print_for_op, weighted_sum_op
+   options_t result             = extract_option(options);
+   bool compare_op              = result.compare_op;
+   bool conditional_skip        = result.conditional_skip;
+   size_t conditional_skip_cost = result.conditional_skip_cost;
    bool cumulative_sum_op   = result.cumulative_sum_op;
+   bool multiply_add_op     = result.multiply_add_op;
    bool print_for_op        = result.print_for_op;
-   size_t collision_limit   = result.collision_limit;
+   bool weighted_sum_op     = result.weighted_sum_op;
    CPPAD_ASSERT_UNKNOWN( result.val_graph == false );
    //
    // number of operators in the player
@@ -230,14 +260,33 @@ bool optimize_run(
       op_usage
    );
    pod_vector<addr_t>        op_previous;
-   exceed_collision_limit |= get_op_previous(
-      collision_limit,
+   size_t n_match = get_op_previous(
       play,
       random_itr,
       cexp_set,
       op_previous,
       op_usage
    );
+   pod_vector<unsigned char> n_use;
+   if( multiply_add_op || weighted_sum_op ) get_n_use(
+      random_itr,
+      dep_taddr,
+      op_previous,
+      op_usage,
+      n_use
+   );
+   if( multiply_add_op ) get_fma_usage(
+      random_itr,
+      op_previous,
+      n_use,
+      op_usage
+   );
+   if( weighted_sum_op ) get_wsum_usage(
+      random_itr,
+      op_previous,
+      n_use,
+      op_usage
+   );
    size_t num_cexp = cexp2op.size();
    CPPAD_ASSERT_UNKNOWN( conditional_skip || num_cexp == 0 );
    vector<struct_cexp_info>  cexp_info; // struct_cexp_info not POD
@@ -328,6 +377,37 @@ bool optimize_run(
    rec->set_abort_op_index(0);
    rec->set_record_compare( compare_op );
 
+   // par_frozen
+   // par_frozen[i_par] is true if the i-th parameter is a dynamic parameter
+   // that gets replaced by a constant; i.e., it is frozen or its arguments
+   // are constants or get replaced by constants.
+   CPPAD_ASSERT_UNKNOWN( frozen.size() == num_dynamic_ind );
+   pod_vector<bool> par_frozen(num_par);
+   for(size_t i_par = 0; i_par < num_par; ++i_par)
+      par_frozen[i_par] = false;
+   for(size_t j = 0; j < num_dynamic_ind; ++j)
+      par_frozen[ dyn_ind2par_ind[j] ] = frozen[j];
+   {  size_t i_arg = 0;
+      for(size_t i_dyn = num_dynamic_ind; i_dyn < num_dynamic_par; ++i_dyn)
+      {  op_code_dyn op = op_code_dyn( dyn_par_op[i_dyn] );
+         size_t n_arg   = num_arg_dyn(op);
+         if( op == atom_dyn )
+         {  size_t atom_n = size_t( dyn_par_arg[i_arg + 2] );
+            size_t atom_m = size_t( dyn_par_arg[i_arg + 3] );
+            n_arg         = 6 + atom_n + atom_m;
+         }
+         else if( op != result_dyn )
+         {  bool all_frozen = true;
+            for(size_t k = num_non_par_arg_dyn(op); k < n_arg; ++k)
+            {  size_t j_par = size_t( dyn_par_arg[i_arg + k] );
+               all_frozen  &= par_frozen[j_par] || ! dyn_par_is[j_par];
+            }
+            par_frozen[ dyn_ind2par_ind[i_dyn] ] = all_frozen;
+         }
+         i_arg += n_arg;
+      }
+   }
+   //
    // copy parameters with index 0
    CPPAD_ASSERT_UNKNOWN( ! dyn_par_is[0] && isnan( play->GetPar(0) ) );
    rec->put_con_par( play->GetPar(0) );
@@ -341,6 +421,12 @@ bool optimize_run(
       new_par[i_par] = i;
    }
 
+   // the uses of the independent dynamic parameters that are frozen
+   // are replaced by constants
+   for(size_t i_par = 1; i_par <= num_dynamic_ind; i_par++)
+   if( par_frozen[i_par] && par_usage[i_par] )
+      new_par[i_par] = rec->put_con_par( play->GetPar(i_par) );
+
    // set new_par for the constant parameters that are used
    for(size_t i_par = num_dynamic_ind + 1; i_par < num_par; ++i_par)
    if( ! dyn_par_is[i_par] )
@@ -443,6 +529,11 @@ bool optimize_run(
             rec->put_dyn_arg_vec( arg_vec );
          }
       }
+      else if( par_frozen[i_par] )
+      {  // this dynamic parameter gets replaced by a constant
+         if( par_usage[i_par] )
+            new_par[i_par] = rec->put_con_par( play->GetPar(i_par) );
+      }
       else if( par_usage[i_par] & (op != result_dyn) )
       {  size_t j_dyn = size_t( dyn_previous[i_dyn] );
          if( j_dyn != num_dynamic_par )
@@ -596,27 +687,49 @@ bool optimize_run(
       // is this new result the top of a cummulative summation
       bool top_csum;
       //
-      // determine if we should insert a conditional skip here
+      // is this new result a fused multiply add
+      bool fma;
+      //
+      // determine if we should insert conditional skips here
+      // (there may be more than one conditional skip at this point)
       bool skip  = conditional_skip;
-      if( skip )
-      {  skip      &= cskip_order_next < num_cexp;
-         skip      &= op != BeginOp;
-         skip      &= op != InvOp;
-         skip      &= atom_state == start_atom;
-         if( skip )
-         {  size_t j = cskip_order[cskip_order_next];
-            if( NumRes(op) > 0 )
-               skip &= size_t( cexp_info[j].max_left_right ) < i_var;
-            else
-               skip &= size_t( cexp_info[j].max_left_right ) <= i_var;
-         }
+      skip      &= op != BeginOp;
+      skip      &= op != InvOp;
+      skip      &= atom_state == start_atom;
+      while( skip && cskip_order_next < num_cexp )
+      {  size_t j = cskip_order[cskip_order_next];
+         if( NumRes(op) > 0 )
+            skip &= size_t( cexp_info[j].max_left_right ) < i_var;
+         else
+            skip &= size_t( cexp_info[j].max_left_right ) <= i_var;
          if( skip )
-         {  size_t j = cskip_order[cskip_order_next];
-            cskip_order_next++;
+         {  cskip_order_next++;
             size_t n_true   = skip_op_true.number_elements(j);
             size_t n_false  = skip_op_false.number_elements(j);
-            skip &= n_true > 0 || n_false > 0;
-            if( skip )
+            bool put_cskip  = n_true > 0 || n_false > 0;
+            if( put_cskip && conditional_skip_cost > 0 )
+            {  // check if the cost of the operators that can be skipped
+               // is large enough to make this conditional skip profitable
+               size_t cost_skip = 0;
+               OpCode        op_skip;
+               const addr_t* arg_skip;
+               size_t        var_skip;
+               sparse::list_setvec::const_iterator itr_true(skip_op_true, j);
+               while( *itr_true != skip_op_true.end() )
+               {  random_itr.op_info(*itr_true, op_skip, arg_skip, var_skip);
+                  cost_skip += op_cost(op_skip, arg_skip);
+                  ++itr_true;
+               }
+               sparse::list_setvec::const_iterator itr_false(skip_op_false, j);
+               while( *itr_false != skip_op_false.end() )
+               {  random_itr.op_info(*itr_false, op_skip, arg_skip, var_skip);
+                  cost_skip += op_cost(op_skip, arg_skip);
+                  ++itr_false;
+               }
+               size_t cost_cskip = 2 + n_true + n_false;
+               put_cskip = conditional_skip_cost * cost_cskip <= cost_skip;
+            }
+            if( put_cskip )
             {  CPPAD_ASSERT_UNKNOWN( NumRes(CSkipOp) == 0 );
                size_t n_arg   = 7 + size_t(n_true) + size_t(n_false);
                // reserve space for the arguments to this operator but
@@ -802,6 +915,22 @@ bool optimize_run(
             // abort rest of this case
             break;
          }
+         // check if this is a fused multiply add
+         if( op_usage[i_tmp] == usage_t(fma_usage) )
+         {  CPPAD_ASSERT_UNKNOWN( op == AddpvOp && previous == 0 );
+            size_pair = record_fma(
+               play                ,
+               random_itr          ,
+               op_usage            ,
+               new_par             ,
+               new_var             ,
+               i_op                ,
+               rec
+            );
+            new_op[i_op]  = addr_t( size_pair.i_op );
+            new_var[i_op] = addr_t( size_pair.i_var );
+            break;
+         }
          case DivpvOp:
          case MulpvOp:
          case PowpvOp:
@@ -848,6 +977,26 @@ bool optimize_run(
             // abort rest of this case
             break;
          }
+         // check if this is a fused multiply add
+         i_tmp     = random_itr.var2op(size_t(arg[0]));
+         fma       = op_usage[i_tmp] == usage_t(fma_usage);
+         i_tmp     = random_itr.var2op(size_t(arg[1]));
+         fma      |= op_usage[i_tmp] == usage_t(fma_usage);
+         if( fma )
+         {  CPPAD_ASSERT_UNKNOWN( op == AddvvOp && previous == 0 );
+            size_pair = record_fma(
+               play                ,
+               random_itr          ,
+               op_usage            ,
+               new_par             ,
+               new_var             ,
+               i_op                ,
+               rec
+            );
+            new_op[i_op]  = addr_t( size_pair.i_op );
+            new_var[i_op] = addr_t( size_pair.i_var );
+            break;
+         }
          case DivvvOp:
          case MulvvOp:
          case PowvvOp:
@@ -866,45 +1015,72 @@ bool optimize_run(
          }
          break;
          // ---------------------------------------------------
+         // Fused multiply add operators
+         case FmavvpOp:
+         case FmavvvOp:
+         if( previous == 0 )
+         {  //
+            size_pair = record_fma(
+               play                ,
+               random_itr          ,
+               op_usage            ,
+               new_par             ,
+               new_var             ,
+               i_op                ,
+               rec
+            );
+            new_op[i_op]  = addr_t( size_pair.i_op );
+            new_var[i_op] = addr_t( size_pair.i_var );
+         }
+         break;
+         // ---------------------------------------------------
          // Conditional expression operators
          case CExpOp:
-         CPPAD_ASSERT_UNKNOWN( previous == 0 );
          CPPAD_ASSERT_NARG_NRES(op, 6, 1);
-         new_arg[0] = arg[0];
-         new_arg[1] = arg[1];
-         mask = 1;
-         for(size_t i = 2; i < 6; i++)
-         {  if( arg[1] & mask )
-            {  new_arg[i] = new_var[ random_itr.var2op(size_t(arg[i])) ];
+         // previous != 0 when this conditional expression has been folded;
+         // see cexp_fold
+         if( previous == 0 )
+         {  new_arg[0] = arg[0];
+            new_arg[1] = arg[1];
+            mask = 1;
+            for(size_t i = 2; i < 6; i++)
+            {  if( arg[1] & mask )
+               {  new_arg[i] = new_var[ random_itr.var2op(size_t(arg[i])) ];
+                  CPPAD_ASSERT_UNKNOWN(
+                     size_t(new_arg[i]) < num_var
+                  );
+               }
+               else
+                  new_arg[i] = new_par[ arg[i] ];
+               mask = mask << 1;
+            }
+            rec->PutArg(
+               new_arg[0] ,
+               new_arg[1] ,
+               new_arg[2] ,
+               new_arg[3] ,
+               new_arg[4] ,
+               new_arg[5]
+            );
+            new_op[i_op]  = addr_t( rec->num_op_rec() );
+            new_var[i_op] = rec->PutOp(op);
+            //
+            // The new addresses for left and right are used during
+            // fill in the arguments for the CSkip operations. This does not
+            // affect max_left_right which is used during this sweep.
+            if( conditional_skip )
+            {  CPPAD_ASSERT_UNKNOWN( cexp_next < num_cexp );
                CPPAD_ASSERT_UNKNOWN(
-                  size_t(new_arg[i]) < num_var
+                  size_t( cexp_info[cexp_next].i_op ) == i_op
                );
+               cskip_new[ cexp_next ].left  = size_t( new_arg[2] );
+               cskip_new[ cexp_next ].right = size_t( new_arg[3] );
+               ++cexp_next;
             }
-            else
-               new_arg[i] = new_par[ arg[i] ];
-            mask = mask << 1;
          }
-         rec->PutArg(
-            new_arg[0] ,
-            new_arg[1] ,
-            new_arg[2] ,
-            new_arg[3] ,
-            new_arg[4] ,
-            new_arg[5]
-         );
-         new_op[i_op]  = addr_t( rec->num_op_rec() );
-         new_var[i_op] = rec->PutOp(op);
-         //
-         // The new addresses for left and right are used during
-         // fill in the arguments for the CSkip operations. This does not
-         // affect max_left_right which is used during this sweep.
-         if( conditional_skip )
-         {  CPPAD_ASSERT_UNKNOWN( cexp_next < num_cexp );
-            CPPAD_ASSERT_UNKNOWN(
-               size_t( cexp_info[cexp_next].i_op ) == i_op
-            );
-            cskip_new[ cexp_next ].left  = size_t( new_arg[2] );
-            cskip_new[ cexp_next ].right = size_t( new_arg[3] );
+         else if( conditional_skip )
+         {  // a folded conditional expression does not skip any operators
+            CPPAD_ASSERT_UNKNOWN( cexp_next < num_cexp );
             ++cexp_next;
          }
          break;
@@ -1276,6 +1452,34 @@ bool optimize_run(
          new_var[i_op] = addr_t( size_pair.i_var );
          break;
          // ---------------------------------------------------
+         case WSumOp:
+         // ---------------------------------------------------
+         CPPAD_ASSERT_UNKNOWN( previous == 0 );
+         //
+         // first four arguments do not change
+         for(size_t i = 0; i < 4; ++i)
+            rec->PutArg( arg[i] );
+         //
+         // parameter variable pairs
+         for(size_t i = 4; i < size_t(arg[1]); i += 2)
+         {  new_arg[0] = new_par[ arg[i] ];
+            new_arg[1] = new_var[ random_itr.var2op(size_t(arg[i+1])) ];
+            CPPAD_ASSERT_UNKNOWN( 0 < new_arg[1] );
+            rec->PutArg( new_arg[0], new_arg[1] );
+         }
+         //
+         // variable variable pairs
+         for(size_t i = size_t(arg[1]); i < size_t(arg[3]); ++i)
+         {  new_arg[0] = new_var[ random_itr.var2op(size_t(arg[i])) ];
+            CPPAD_ASSERT_UNKNOWN( 0 < new_arg[0] );
+            rec->PutArg( new_arg[0] );
+         }
+         rec->PutArg( arg[3] ); // arg[arg[3]] = arg[3]
+         //
+         new_op[i_op]  = addr_t( rec->num_op_rec() );
+         new_var[i_op] = rec->PutOp(WSumOp);
+         break;
+         // ---------------------------------------------------
 
          // all cases should be handled above
          default:
@@ -1342,7 +1546,7 @@ bool optimize_run(
 # endif
       }
    }
-   return exceed_collision_limit;
+   return n_match;
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
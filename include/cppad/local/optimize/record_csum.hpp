@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_RECORD_CSUM_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -13,6 +13,8 @@ namespace CppAD { namespace local { namespace optimize  {
 {xrst_spell
    addpv
    addvv
+   mulpv
+   mulvv
    subpv
    subvp
    subvv
@@ -55,6 +57,7 @@ the variable corresponding to the result for the current operator.
 We use the notation *i_op* = *random_itr* . ``var2op`` ( *current* ) .
 It follows that  NumRes( random_itr.get_op[i_op] ) > 0.
 If 0 < j_op < i_op, either op_usage[j_op] == usage_t(csum_usage),
+op_usage[j_op] == usage_t(wsum_usage),
 op_usage[j_op] = usage_t(no_usage), or new_var[j_op] != 0.
 
 rec
@@ -65,10 +68,19 @@ return
 ******
 is the operator and variable indices in the new operation sequence.
 
+Weighted Summation
+******************
+If an argument of the summation is the result of a MulpvOp or MulvvOp
+operator that has ``wsum_usage`` , the product is a term in a WSumOp
+operator that is recorded just before the CSumOp operator.
+The result of the WSumOp is one of the variables added by the CSumOp.
+If there are no other terms in the summation, the CSumOp is not recorded
+and the return value corresponds to the WSumOp.
+
 stack
 *****
 Is temporary work space. On input and output,
-stack.op_info, stack.add_var, and stack.sub_var, are all empty.
+all of the stacks in *stack* are empty.
 These stacks are passed in so that they are created once
 and then be reused with calls to ``record_csum`` .
 
@@ -117,6 +129,10 @@ struct_size_pair record_csum(
    CPPAD_ASSERT_UNKNOWN( stack.op_info.empty() );
    CPPAD_ASSERT_UNKNOWN( stack.add_var.empty() );
    CPPAD_ASSERT_UNKNOWN( stack.sub_var.empty() );
+   CPPAD_ASSERT_UNKNOWN( stack.add_pv.empty() );
+   CPPAD_ASSERT_UNKNOWN( stack.sub_pv.empty() );
+   CPPAD_ASSERT_UNKNOWN( stack.add_vv.empty() );
+   CPPAD_ASSERT_UNKNOWN( stack.sub_vv.empty() );
    //
    // this operator is not csum connected to some other result
    size_t i_op = random_itr.var2op(current);
@@ -190,6 +206,23 @@ struct_size_pair record_csum(
                   info.add = add;
                   stack.op_info.push( info );
                }
+               else if( op_usage[i_op] == usage_t(wsum_usage) )
+               {  // this product is a term in the weighted summation
+                  CPPAD_ASSERT_UNKNOWN( size_t( new_var[i_op]) == 0 );
+                  if( random_itr.get_op(i_op) == MulpvOp )
+                  {  if( add_var )
+                        stack.add_pv.push(arg[i]);
+                     else
+                        stack.sub_pv.push(arg[i]);
+                  }
+                  else
+                  {  CPPAD_ASSERT_UNKNOWN( random_itr.get_op(i_op) == MulvvOp );
+                     if( add_var )
+                        stack.add_vv.push(arg[i]);
+                     else
+                        stack.sub_vv.push(arg[i]);
+                  }
+               }
                else
                {  // there are no nodes below this one
                   CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < current );
@@ -210,10 +243,16 @@ struct_size_pair record_csum(
          bool   dny_add   = add;               // addition dynamics
          for(size_t j = 0; j < 2; ++j)
          {  for(size_t i = dyn_start; i < dyn_end; ++i)
-            {  // i-th argument is a dynamic parameter
+            {  // i-th argument was a dynamic parameter when this CSumOp
+               // was recorded; it may since have been frozen to a constant
                // (can't yet be a result, so no nodes below)
-               CPPAD_ASSERT_UNKNOWN( dyn_par_is[ arg[i] ] );
-               if( dny_add )
+               if( ! dyn_par_is[ arg[i] ] )
+               {  if( dny_add )
+                     sum_par += par[arg[i]];
+                  else
+                     sum_par -= par[arg[i]];
+               }
+               else if( dny_add )
                   stack.add_dyn.push(arg[i]);
                else
                   stack.sub_dyn.push(arg[i]);
@@ -291,6 +330,23 @@ struct_size_pair record_csum(
                   info.add = add;
                   stack.op_info.push( info );
                }
+               else if( op_usage[i_op] == usage_t(wsum_usage) )
+               {  // this product is a term in the weighted summation
+                  CPPAD_ASSERT_UNKNOWN( size_t( new_var[i_op]) == 0 );
+                  if( random_itr.get_op(i_op) == MulpvOp )
+                  {  if( add )
+                        stack.add_pv.push(arg[i]);
+                     else
+                        stack.sub_pv.push(arg[i]);
+                  }
+                  else
+                  {  CPPAD_ASSERT_UNKNOWN( random_itr.get_op(i_op) == MulvvOp );
+                     if( add )
+                        stack.add_vv.push(arg[i]);
+                     else
+                        stack.sub_vv.push(arg[i]);
+                  }
+               }
                else
                {  // there are no nodes below this one
                   CPPAD_ASSERT_UNKNOWN( size_t(arg[i]) < current );
@@ -305,6 +361,72 @@ struct_size_pair record_csum(
          // ---------------------------------------------------------------
       }
    }
+   // number of terms in the weighted summation
+   size_t n_add_pv = stack.add_pv.size();
+   size_t n_sub_pv = stack.sub_pv.size();
+   size_t n_add_vv = stack.add_vv.size();
+   size_t n_sub_vv = stack.sub_vv.size();
+   //
+   // wsum_var
+   // variable index in the new operation sequence for the weighted summation
+   addr_t wsum_var = 0;
+   if( n_add_pv + n_sub_pv + n_add_vv + n_sub_vv > 0 )
+   {  //
+      // first four arguments to weighted sum operator
+      size_t end = 4 + 2 * n_add_pv;
+      rec->PutArg( addr_t(end) );    // arg[0]: end for add pv pairs
+      end       += 2 * n_sub_pv;
+      rec->PutArg( addr_t(end) );    // arg[1]: end for sub pv pairs
+      end       += 2 * n_add_vv;
+      rec->PutArg( addr_t(end) );    // arg[2]: end for add vv pairs
+      end       += 2 * n_sub_vv;
+      rec->PutArg( addr_t(end) );    // arg[3]: end for sub vv pairs
+      //
+      // parameter variable and variable variable pairs
+      std::stack<addr_t>* term_stack[4] = {
+         &stack.add_pv, &stack.sub_pv, &stack.add_vv, &stack.sub_vv
+      };
+      for(size_t j = 0; j < 4; ++j)
+      {  while( ! term_stack[j]->empty() )
+         {  addr_t old_res = term_stack[j]->top();
+            term_stack[j]->pop();
+            //
+            // arguments to the multiplication
+            OpCode        mul_op;
+            const addr_t* mul_arg;
+            random_itr.op_info(
+               random_itr.var2op( size_t(old_res) ), mul_op, mul_arg, not_used
+            );
+            addr_t new_left;
+            if( mul_op == MulpvOp )
+               new_left = new_par[ mul_arg[0] ];
+            else
+            {  CPPAD_ASSERT_UNKNOWN( mul_op == MulvvOp );
+               new_left = new_var[ random_itr.var2op(size_t(mul_arg[0])) ];
+               CPPAD_ASSERT_UNKNOWN( 0 < new_left );
+            }
+            addr_t new_right =
+               new_var[ random_itr.var2op(size_t(mul_arg[1])) ];
+            CPPAD_ASSERT_UNKNOWN( 0 < new_right );
+            CPPAD_ASSERT_UNKNOWN( size_t(new_right) < current );
+            rec->PutArg(new_left, new_right);
+         }
+      }
+      rec->PutArg( addr_t(end) );    // arg[arg[3]] = arg[3]
+      //
+      // check if the weighted summation is the entire summation
+      bool only_wsum = stack.add_var.empty() && stack.sub_var.empty();
+      only_wsum     &= stack.add_dyn.empty() && stack.sub_dyn.empty();
+      only_wsum     &= IdenticalZero(sum_par);
+      if( only_wsum )
+      {  struct_size_pair ret;
+         ret.i_op  = rec->num_op_rec();
+         ret.i_var = size_t(rec->PutOp(WSumOp));
+         return ret;
+      }
+      wsum_var = rec->PutOp(WSumOp);
+   }
+   //
    // number of variables to add in this cummulative sum operator
    size_t n_add_var = stack.add_var.size();
 
@@ -321,6 +443,8 @@ struct_size_pair record_csum(
    addr_t new_arg = rec->put_con_par(sum_par);
    rec->PutArg(new_arg);            // arg[0]: initial sum
    size_t end   = n_add_var + 5;
+   if( wsum_var != 0 )
+      ++end;                        // weighted summation is added
    rec->PutArg( addr_t(end) );      // arg[1]: end for add variables
    end           += n_sub_var;
    rec->PutArg( addr_t(end) );      // arg[2]: end for sub variables
@@ -330,6 +454,8 @@ struct_size_pair record_csum(
    rec->PutArg( addr_t(end) );      // arg[4]: end for sub dynamics
 
    // addition variable arguments
+   if( wsum_var != 0 )
+      rec->PutArg(wsum_var);        // arg[5]
    for(size_t i = 0; i < n_add_var; i++)
    {  CPPAD_ASSERT_UNKNOWN( ! stack.add_var.empty() );
       addr_t old_arg = stack.add_var.top();
@@ -0,0 +1,131 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_RECORD_FMA_HPP
+# define CPPAD_LOCAL_OPTIMIZE_RECORD_FMA_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*!
+\file record_fma.hpp
+Record a fused multiply add operation; i.e., FmavvpOp or FmavvvOp.
+*/
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+/*!
+Record a fused multiply add operation; i.e., FmavvpOp or FmavvvOp.
+
+\param play
+player object corresponding to the old recroding.
+
+\param random_itr
+random iterator corresponding to the old recording.
+
+\param op_usage
+mapping from old operator index to how it is used.
+
+\param new_par
+mapping from old parameter index to parameter index in new recording.
+
+\param new_var
+mapping from old operator index to variable index in new recording.
+
+\param i_op
+is the index in the old operation sequence for this operator.
+It must be one of the following:
+AddpvOp, AddvvOp, FmavvpOp, FmavvvOp.
+If it is AddpvOp or AddvvOp, one of its variable arguments must be
+the result of a MulvvOp operator with fma_usage.
+This multiplication is fused with the addition.
+
+\param rec
+is the object that will record the new operations.
+
+\return
+is the operator and variable indices in the new operation sequence.
+*/
+template <class Addr, class Base>
+struct_size_pair record_fma(
+   const player<Base>*                                play           ,
+   const play::const_random_iterator<Addr>&           random_itr     ,
+   const pod_vector<usage_t>&                         op_usage       ,
+   const pod_vector<addr_t>&                          new_par        ,
+   const pod_vector<addr_t>&                          new_var        ,
+   size_t                                             i_op           ,
+   recorder<Base>*                                    rec            )
+{
+   // get_op_info
+   OpCode        op;
+   const addr_t* arg;
+   size_t        i_var;
+   random_itr.op_info(i_op, op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+   //
+   // new_op, mul_arg, c_arg
+   // mul_arg: old variable indices for the factors
+   // c_arg:   old index for the addend
+   OpCode        new_op  = op;
+   const addr_t* mul_arg = arg;
+   addr_t        c_arg   = 0;
+   switch(op)
+   {  case FmavvpOp:
+      case FmavvvOp:
+      c_arg = arg[2];
+      break;
+
+      case AddpvOp:
+      {  size_t j_op = random_itr.var2op( size_t(arg[1]) );
+         CPPAD_ASSERT_UNKNOWN( op_usage[j_op] == usage_t(fma_usage) );
+         CPPAD_ASSERT_UNKNOWN( random_itr.get_op(j_op) == MulvvOp );
+         size_t j_var;
+         random_itr.op_info(j_op, new_op, mul_arg, j_var);
+         new_op = FmavvpOp;
+         c_arg  = arg[0];
+      }
+      break;
+
+      case AddvvOp:
+      {  size_t k    = 0;
+         size_t j_op = random_itr.var2op( size_t(arg[0]) );
+         if( op_usage[j_op] != usage_t(fma_usage) )
+         {  k    = 1;
+            j_op = random_itr.var2op( size_t(arg[1]) );
+         }
+         CPPAD_ASSERT_UNKNOWN( op_usage[j_op] == usage_t(fma_usage) );
+         CPPAD_ASSERT_UNKNOWN( random_itr.get_op(j_op) == MulvvOp );
+         size_t j_var;
+         random_itr.op_info(j_op, new_op, mul_arg, j_var);
+         new_op = FmavvvOp;
+         c_arg  = arg[1 - k];
+      }
+      break;
+
+      default:
+      CPPAD_ASSERT_UNKNOWN(false);
+   }
+   CPPAD_ASSERT_UNKNOWN( size_t(mul_arg[0]) < i_var ); // DAG condition
+   CPPAD_ASSERT_UNKNOWN( size_t(mul_arg[1]) < i_var ); // DAG condition
+   //
+   addr_t new_arg[3];
+   new_arg[0]   = new_var[ random_itr.var2op(size_t(mul_arg[0])) ];
+   new_arg[1]   = new_var[ random_itr.var2op(size_t(mul_arg[1])) ];
+   if( new_op == FmavvpOp )
+      new_arg[2] = new_par[ c_arg ];
+   else
+      new_arg[2] = new_var[ random_itr.var2op(size_t(c_arg)) ];
+   rec->PutArg( new_arg[0], new_arg[1], new_arg[2] );
+   //
+   struct_size_pair ret;
+   ret.i_op  = rec->num_op_rec();
+   ret.i_var = size_t(rec->PutOp(new_op));
+   CPPAD_ASSERT_UNKNOWN( 0 < new_arg[0] && size_t(new_arg[0]) < ret.i_var );
+   CPPAD_ASSERT_UNKNOWN( 0 < new_arg[1] && size_t(new_arg[1]) < ret.i_var );
+   CPPAD_ASSERT_UNKNOWN(
+      new_op == FmavvpOp ||
+      (0 < new_arg[2] && size_t(new_arg[2]) < ret.i_var)
+   );
+   return ret;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+
+# endif
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_OPTIMIZE_USAGE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/define.hpp>
 
@@ -24,7 +24,23 @@ enum enum_usage {
    a dependent variable. Hence case it can be removed as part of a
    cumulative summation starting at its parent or above.
    */
-   csum_usage
+   csum_usage,
+
+   /*!
+   This operator is a multiplication of two variables, it is only used once,
+   and its parrent is an addition that is not part of a cumulative summation.
+   Furthermore, its result is not a dependent variable. Hence it can be
+   removed as part of a fused multiply add operator at its parent.
+   */
+   fma_usage,
+
+   /*!
+   This operator is a multiplication, it is only used once,
+   and its parrent is a summation operator that is recorded as part of a
+   cumulative summation. Furthermore, its result is not a dependent variable.
+   Hence it can be removed as a term in a weighted summation operator.
+   */
+   wsum_usage
 };
 
 
@@ -0,0 +1,283 @@
+# ifndef CPPAD_LOCAL_PLAY_ATOM_CALL_SETUP_HPP
+# define CPPAD_LOCAL_PLAY_ATOM_CALL_SETUP_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <algorithm>
+# include <cppad/local/op_code_var.hpp>
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+
+/*!
+\file atom_call_setup.hpp
+*/
+
+/*!
+Information about the atomic function calls in a recording.
+
+This is used to evaluate atomic function calls as batches; see
+sweep::atom_batch. We use k for the index of a call, in the order
+they appear in the recording, and num_call for the number of calls.
+An atomic call c is a producer for an atomic call k,
+and k is a consumer for c, if a result of c is an argument for k.
+*/
+struct atom_call_info {
+   /// op[k] is the operator index of the first AFunOp for the k-th call
+   /// (monotone increasing).
+   pod_vector<addr_t> op;
+   //
+   /// arg[k] is the index, in the argument vector,
+   /// of the first argument for the first AFunOp for the k-th call.
+   pod_vector<addr_t> arg;
+   //
+   /// var[k] is the variable index of the first variable result
+   /// for the k-th call (if it has a variable result).
+   pod_vector<addr_t> var;
+   //
+   /// first_use[k] is the index of the first operator that uses a result
+   /// of the k-th call. If there is no such operator, it is the index of
+   /// the EndOp operator.
+   pod_vector<addr_t> first_use;
+   //
+   /// last_def[k] is the largest operator index that defines a variable
+   /// argument for the k-th call. If the variable is a result of another
+   /// call, this is the index of the second AFunOp for that call.
+   /// If there are no variable arguments, it is zero.
+   pod_vector<addr_t> last_def;
+   //
+   /// forward_def[k] is the same as last_def[k] except that arguments that
+   /// are results of other calls are not included.
+   pod_vector<addr_t> forward_def;
+   //
+   /// reverse_use[k] is the same as first_use[k] except that uses by other
+   /// calls are not included.
+   pod_vector<addr_t> reverse_use;
+   //
+   /// The producers for the k-th call are
+   /// producer[ producer_start[k] ] , ... , producer[ producer_start[k+1] - 1 ]
+   pod_vector<addr_t> producer_start;
+   pod_vector<addr_t> producer;
+   //
+   /// The consumers for the k-th call are
+   /// consumer[ consumer_start[k] ] , ... , consumer[ consumer_start[k+1] - 1 ]
+   pod_vector<addr_t> consumer_start;
+   pod_vector<addr_t> consumer;
+   //
+   /// the calls sorted so that forward_def is monotone increasing
+   pod_vector<addr_t> forward_order;
+   //
+   /// the calls sorted so that reverse_use is monotone decreasing
+   pod_vector<addr_t> reverse_order;
+   //
+   /// Can calls be evaluated before they are reached during a sweep.
+   /// This is false when the recording has conditional skip operators
+   /// because a call that is evaluated early may be skipped later.
+   bool early;
+   //
+   /// number of calls
+   size_t num_call(void) const
+   {  return op.size(); }
+   //
+   /// number of bytes used by this information
+   size_t size_bytes(void) const
+   {  size_t n_addr = op.size() + arg.size() + var.size()
+         + first_use.size() + last_def.size()
+         + forward_def.size() + reverse_use.size()
+         + producer_start.size() + producer.size()
+         + consumer_start.size() + consumer.size()
+         + forward_order.size() + reverse_order.size();
+      return n_addr * sizeof(addr_t);
+   }
+};
+
+/*!
+Determine the atomic function call information for a recording.
+
+\param num_var
+num_var is the number of variables in this operation sequence.
+
+\param op_vec
+The mapping
+<code>op = OpCode[ op_vec[op_index] ]</code>
+maps from operator index op_index to the operator op.
+
+\param arg_vec
+is a vector of all the arguments for all the operators.
+
+\param info [out]
+The input value of this information does not matter.
+Upon return it is the information for the atomic calls in this
+operation sequence.
+*/
+inline void atom_call_setup(
+   size_t                                    num_var        ,
+   const pod_vector<opcode_t>&               op_vec         ,
+   const pod_vector<addr_t>&                 arg_vec        ,
+   atom_call_info&                           info           )
+{  info.op.resize(0);
+   info.arg.resize(0);
+   info.var.resize(0);
+   info.first_use.resize(0);
+   info.last_def.resize(0);
+   info.forward_def.resize(0);
+   info.reverse_use.resize(0);
+   info.producer_start.resize(0);
+   info.producer.resize(0);
+   info.consumer_start.resize(0);
+   info.consumer.resize(0);
+   info.forward_order.resize(0);
+   info.reverse_order.resize(0);
+   info.early = true;
+   //
+   // check for the case where there are no atomic function calls
+   size_t num_op = op_vec.size();
+   bool   found  = false;
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+   {  OpCode op = OpCode( op_vec[i_op] );
+      found    |= op == AFunOp;
+      if( op == CSkipOp )
+         info.early = false;
+   }
+   if( ! found )
+      return;
+   CPPAD_ASSERT_UNKNOWN( OpCode( op_vec[num_op - 1] ) == EndOp );
+   //
+   // var_def[i_var]: operator index that defines the variable i_var
+   pod_vector<addr_t> var_def(num_var);
+   //
+   // var_call[i_var]: one plus the index of the atomic call that has
+   // i_var as a result (zero if it is not an atomic function result)
+   pod_vector<addr_t> var_call(num_var);
+   for(size_t i_var = 0; i_var < num_var; ++i_var)
+      var_call[i_var] = 0;
+   //
+   // in_call, first_result
+   bool   in_call      = false;
+   size_t first_result = 0;
+   //
+   pod_vector<bool> is_variable;
+   size_t var_index = 0;
+   size_t arg_index = 0;
+   for(size_t i_op = 0; i_op < num_op; ++i_op)
+   {  OpCode        op     = OpCode( op_vec[i_op] );
+      const addr_t* op_arg = arg_vec.data() + arg_index;
+      //
+      // variable arguments for this operator
+      arg_is_variable(op, op_arg, is_variable);
+      for(size_t j = 0; j < is_variable.size(); ++j) if( is_variable[j] )
+      {  size_t i_arg = size_t( op_arg[j] );
+         size_t c     = size_t( var_call[i_arg] );
+         if( c > 0 )
+         {  // i_arg is a result of call c-1
+            if( size_t( info.first_use[c-1] ) > i_op )
+               info.first_use[c-1] = addr_t( i_op );
+            if( ! in_call && size_t( info.reverse_use[c-1] ) > i_op )
+               info.reverse_use[c-1] = addr_t( i_op );
+         }
+         if( in_call )
+         {  // i_arg is an argument for the current call
+            CPPAD_ASSERT_UNKNOWN( op == FunavOp );
+            size_t k = info.op.size() - 1;
+            if( info.last_def[k] < var_def[i_arg] )
+               info.last_def[k] = var_def[i_arg];
+            if( c > 0 )
+               info.producer.push_back( addr_t(c - 1) );
+            else if( info.forward_def[k] < var_def[i_arg] )
+               info.forward_def[k] = var_def[i_arg];
+         }
+      }
+      //
+      // results for this operator
+      for(size_t i = 0; i < NumRes(op); ++i)
+         var_def[var_index++] = addr_t( i_op );
+      //
+      if( op == AFunOp )
+      {  if( ! in_call )
+         {  // first AFunOp for this call
+            in_call      = true;
+            first_result = var_index;
+            info.op.push_back( addr_t( i_op ) );
+            info.arg.push_back( addr_t( arg_index ) );
+            info.var.push_back( addr_t( var_index ) );
+            info.first_use.push_back( addr_t( num_op - 1 ) );
+            info.reverse_use.push_back( addr_t( num_op - 1 ) );
+            info.last_def.push_back( 0 );
+            info.forward_def.push_back( 0 );
+            info.producer_start.push_back( addr_t( info.producer.size() ) );
+         }
+         else
+         {  // second AFunOp for this call
+            in_call  = false;
+            size_t k = info.op.size();
+            for(size_t i_var = first_result; i_var < var_index; ++i_var)
+            {  var_def[i_var]  = addr_t( i_op );
+               var_call[i_var] = addr_t( k );
+            }
+         }
+      }
+      //
+      // index of first argument for next operator
+      arg_index += NumArg(op);
+      if( op == CSumOp )
+         arg_index += size_t(op_arg[4] + 1);
+      if( op == WSumOp )
+         arg_index += size_t(op_arg[3] + 1);
+      if( op == CSkipOp )
+         arg_index += size_t(7 + op_arg[4] + op_arg[5]);
+   }
+   CPPAD_ASSERT_UNKNOWN( var_index == num_var );
+   CPPAD_ASSERT_UNKNOWN( ! in_call );
+   //
+   // num_call
+   size_t num_call = info.op.size();
+   info.producer_start.push_back( addr_t( info.producer.size() ) );
+   //
+   // consumer_start, consumer
+   info.consumer_start.resize(num_call + 1);
+   for(size_t k = 0; k <= num_call; ++k)
+      info.consumer_start[k] = 0;
+   for(size_t ell = 0; ell < info.producer.size(); ++ell)
+      ++info.consumer_start[ size_t( info.producer[ell] ) + 1 ];
+   for(size_t k = 0; k < num_call; ++k)
+      info.consumer_start[k+1] += info.consumer_start[k];
+   info.consumer.resize( info.producer.size() );
+   {  pod_vector<addr_t> next(num_call);
+      for(size_t k = 0; k < num_call; ++k)
+         next[k] = info.consumer_start[k];
+      for(size_t k = 0; k < num_call; ++k)
+      {  size_t start = size_t( info.producer_start[k] );
+         size_t end   = size_t( info.producer_start[k+1] );
+         for(size_t ell = start; ell < end; ++ell)
+         {  size_t c = size_t( info.producer[ell] );
+            info.consumer[ size_t( next[c]++ ) ] = addr_t( k );
+         }
+      }
+   }
+   //
+   // forward_order, reverse_order
+   info.forward_order.resize(num_call);
+   info.reverse_order.resize(num_call);
+   for(size_t k = 0; k < num_call; ++k)
+   {  info.forward_order[k] = addr_t( k );
+      info.reverse_order[k] = addr_t( k );
+   }
+   const pod_vector<addr_t>& forward_def( info.forward_def );
+   const pod_vector<addr_t>& reverse_use( info.reverse_use );
+   std::stable_sort(
+      info.forward_order.data(), info.forward_order.data() + num_call,
+      [&forward_def](addr_t left, addr_t right)
+      {  return forward_def[left] < forward_def[right]; }
+   );
+   std::stable_sort(
+      info.reverse_order.data(), info.reverse_order.data() + num_call,
+      [&reverse_use](addr_t left, addr_t right)
+      {  return reverse_use[left] > reverse_use[right]; }
+   );
+}
+
+} } } // BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
@@ -2,15 +2,17 @@
 # define CPPAD_LOCAL_PLAY_PLAYER_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/addr_enum.hpp>
 # include <cppad/local/play/sequential_iterator.hpp>
 # include <cppad/local/play/subgraph_iterator.hpp>
 # include <cppad/local/play/random_setup.hpp>
+# include <cppad/local/play/atom_call_setup.hpp>
 # include <cppad/local/atom_state.hpp>
 # include <cppad/local/is_pod.hpp>
+# include <memory>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -18,6 +20,56 @@ namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 File used to define the player class.
 */
 
+/*!
+The part of an operation sequence recording that does not change after
+it is moved from a recorder to a player.
+
+A copy of a player (and the corresponding base2ad player) shares this
+information with the original player. This reduces the memory used by copies
+of an ADFun object; e.g., one copy for each thread.
+Since this information is constant, different threads can use it at
+the same time.
+*/
+struct player_shared {
+   /// The operators in the recording.
+   pod_vector<opcode_t> op_vec_;
+
+   /// The operation argument indices in the recording
+   pod_vector<addr_t> arg_vec_;
+
+   /// Character strings ('\\0' terminated) in the recording.
+   pod_vector<char> text_vec_;
+
+   /// The VecAD indices in the recording.
+   pod_vector<addr_t> all_var_vecad_ind_;
+
+   /// Which elements of all_par_vec_ are dynamic parameters
+   /// (size equal number of parametrers)
+   pod_vector<bool> dyn_par_is_;
+
+   /// mapping from dynamic parameter index to parameter index
+   /// 1: size equal to number of dynamic parameters
+   /// 2: dyn_ind2par_ind_[j] < dyn_ind2par_ind_[j+1]
+   pod_vector<addr_t> dyn_ind2par_ind_;
+
+   /// operators for just the dynamic parameters
+   /// (size equal number of dynamic parameters)
+   pod_vector<opcode_t> dyn_par_op_;
+
+   /// arguments for the dynamic parameter operators
+   pod_vector<addr_t> dyn_par_arg_;
+
+   /// information about the atomic function calls
+   play::atom_call_info atom_call_;
+   //
+   /// an empty recording that is shared by all the empty players
+   static const std::shared_ptr<const player_shared>& empty(void)
+   {  static const std::shared_ptr<const player_shared> empty_shared =
+         std::make_shared<const player_shared>();
+      return empty_shared;
+   }
+};
+
 /*!
 Class used to store and play back an operation sequence recording.
 
@@ -46,38 +98,15 @@ private:
    /// Number of VecAD vectors in the recording
    size_t num_var_vecad_rec_;
 
-   /// The operators in the recording.
-   pod_vector<opcode_t> op_vec_;
-
-   /// The operation argument indices in the recording
-   pod_vector<addr_t> arg_vec_;
-
-   /// Character strings ('\\0' terminated) in the recording.
-   pod_vector<char> text_vec_;
-
-   /// The VecAD indices in the recording.
-   pod_vector<addr_t> all_var_vecad_ind_;
+   /// The part of the recording that is shared with copies of this player
+   /// (never nullptr).
+   std::shared_ptr<const player_shared> shared_;
 
    /// All of the parameters in the recording.
    /// Use pod_maybe because Base may not be plain old data.
+   /// This is not shared because new_dynamic changes its value.
    pod_vector_maybe<Base> all_par_vec_;
 
-   /// Which elements of all_par_vec_ are dynamic parameters
-   /// (size equal number of parametrers)
-   pod_vector<bool> dyn_par_is_;
-
-   /// mapping from dynamic parameter index to parameter index
-   /// 1: size equal to number of dynamic parameters
-   /// 2: dyn_ind2par_ind_[j] < dyn_ind2par_ind_[j+1]
-   pod_vector<addr_t> dyn_ind2par_ind_;
-
-   /// operators for just the dynamic parameters
-   /// (size equal number of dynamic parameters)
-   pod_vector<opcode_t> dyn_par_op_;
-
-   /// arguments for the dynamic parameter operators
-   pod_vector<addr_t> dyn_par_arg_;
-
    // ----------------------------------------------------------------------
    // Information needed to use member functions that begin with random_
    // and for using const_subgraph_iterator.
@@ -108,11 +137,13 @@ public:
    num_dynamic_ind_(0)  ,
    num_var_rec_(0)      ,
    num_var_load_rec_(0)  ,
-   num_var_vecad_rec_(0)
+   num_var_vecad_rec_(0) ,
+   shared_( player_shared::empty() )
    { }
    // move semantics constructor
    // (none of the default constructor values matter to the destructor)
    player(player& play)
+   : shared_( player_shared::empty() )
    {  swap(play);  }
    // =================================================================
    /// destructor
@@ -125,8 +156,8 @@ public:
       // required
       size_t required = 0;
       required = std::max(required, num_var_rec_   );  // number variables
-      required = std::max(required, op_vec_.size()  ); // number operators
-      required = std::max(required, arg_vec_.size() ); // number arguments
+      required = std::max(required, shared_->op_vec_.size()  ); // operators
+      required = std::max(required, shared_->arg_vec_.size() ); // arguments
       //
       // unsigned short
       if( required <= std::numeric_limits<unsigned short>::max() )
@@ -172,54 +203,68 @@ public:
       num_var_rec_        = rec.num_var_rec_;
       num_var_load_rec_   = rec.num_var_load_rec_;
 
+      // shared
+      // This player gets a new recording that is not shared with any other
+      // player. The recording is constant after this routine.
+      std::shared_ptr<player_shared> shared =
+         std::make_shared<player_shared>();
+      //
       // op_vec_
-      op_vec_.swap(rec.op_vec_);
-      CPPAD_ASSERT_UNKNOWN(op_vec_.size() < addr_t_max );
+      shared->op_vec_.swap(rec.op_vec_);
+      CPPAD_ASSERT_UNKNOWN(shared->op_vec_.size() < addr_t_max );
 
       // op_arg_vec_
-      arg_vec_.swap(rec.arg_vec_);
-      CPPAD_ASSERT_UNKNOWN(arg_vec_.size()    < addr_t_max );
+      shared->arg_vec_.swap(rec.arg_vec_);
+      CPPAD_ASSERT_UNKNOWN(shared->arg_vec_.size()    < addr_t_max );
 
       // all_par_vec_
       all_par_vec_.swap(rec.all_par_vec_);
       CPPAD_ASSERT_UNKNOWN(all_par_vec_.size() < addr_t_max );
 
       // dyn_par_is_, dyn_par_op_, dyn_par_arg_
-      dyn_par_is_.swap( rec.dyn_par_is_ );
-      dyn_par_op_.swap( rec.dyn_par_op_ );
-      dyn_par_arg_.swap( rec.dyn_par_arg_ );
-      CPPAD_ASSERT_UNKNOWN(dyn_par_arg_.size() < addr_t_max );
+      shared->dyn_par_is_.swap( rec.dyn_par_is_ );
+      shared->dyn_par_op_.swap( rec.dyn_par_op_ );
+      shared->dyn_par_arg_.swap( rec.dyn_par_arg_ );
+      CPPAD_ASSERT_UNKNOWN(shared->dyn_par_arg_.size() < addr_t_max );
 
       // text_rec_
-      text_vec_.swap(rec.text_vec_);
-      CPPAD_ASSERT_UNKNOWN(text_vec_.size() < addr_t_max );
+      shared->text_vec_.swap(rec.text_vec_);
+      CPPAD_ASSERT_UNKNOWN(shared->text_vec_.size() < addr_t_max );
 
       // all_var_vecad_ind_
-      all_var_vecad_ind_.swap(rec.all_var_vecad_ind_);
-      CPPAD_ASSERT_UNKNOWN(all_var_vecad_ind_.size() < addr_t_max );
+      shared->all_var_vecad_ind_.swap(rec.all_var_vecad_ind_);
+      CPPAD_ASSERT_UNKNOWN(shared->all_var_vecad_ind_.size() < addr_t_max );
 
       // num_var_vecad_rec_
       num_var_vecad_rec_ = 0;
       {  // all_var_vecad_ind_ contains size of each VecAD followed by
          // the parameter indices used to inialize it.
          size_t i = 0;
-         while( i < all_var_vecad_ind_.size() )
+         while( i < shared->all_var_vecad_ind_.size() )
          {  num_var_vecad_rec_++;
-            i += size_t( all_var_vecad_ind_[i] ) + 1;
+            i += size_t( shared->all_var_vecad_ind_[i] ) + 1;
          }
-         CPPAD_ASSERT_UNKNOWN( i == all_var_vecad_ind_.size() );
+         CPPAD_ASSERT_UNKNOWN( i == shared->all_var_vecad_ind_.size() );
       }
 
       // mapping from dynamic parameter index to parameter index
-      dyn_ind2par_ind_.resize( dyn_par_op_.size() );
+      shared->dyn_ind2par_ind_.resize( shared->dyn_par_op_.size() );
       size_t i_dyn = 0;
       for(size_t i_par = 0; i_par < all_par_vec_.size(); ++i_par)
-      {  if( dyn_par_is_[i_par] )
-         {  dyn_ind2par_ind_[i_dyn] = addr_t( i_par );
+      {  if( shared->dyn_par_is_[i_par] )
+         {  shared->dyn_ind2par_ind_[i_dyn] = addr_t( i_par );
             ++i_dyn;
          }
       }
-      CPPAD_ASSERT_UNKNOWN( i_dyn == dyn_ind2par_ind_.size() );
+      CPPAD_ASSERT_UNKNOWN( i_dyn == shared->dyn_ind2par_ind_.size() );
+      //
+      // atom_call_
+      play::atom_call_setup(
+         num_var_rec_, shared->op_vec_, shared->arg_vec_, shared->atom_call_
+      );
+      //
+      // shared_
+      shared_ = shared;
 
       // random access information
       clear_random();
@@ -349,6 +394,7 @@ public:
             case AddvvOp:
             case DivvvOp:
             case EqvvOp:
+            case FmavvpOp:
             case LevvOp:
             case LtvvOp:
             case MulvvOp:
@@ -360,6 +406,13 @@ public:
             CPPAD_ASSERT_UNKNOWN(op_arg[1] <= arg_var_bound );
             break;
 
+            // all three arguments are variables
+            case FmavvvOp:
+            CPPAD_ASSERT_UNKNOWN(op_arg[0] <= arg_var_bound );
+            CPPAD_ASSERT_UNKNOWN(op_arg[1] <= arg_var_bound );
+            CPPAD_ASSERT_UNKNOWN(op_arg[2] <= arg_var_bound );
+            break;
+
             // StpvOp
             case StpvOp:
             CPPAD_ASSERT_UNKNOWN(op_arg[2] <= arg_var_bound );
@@ -380,6 +433,17 @@ public:
             itr.correct_before_increment();
             break;
 
+            // WSumOp
+            case WSumOp:
+            {  CPPAD_ASSERT_UNKNOWN( 4 < op_arg[3] );
+               for(addr_t j = 5; j < op_arg[1]; j += 2)
+                  CPPAD_ASSERT_UNKNOWN(op_arg[j] <= arg_var_bound);
+               for(addr_t j = op_arg[1]; j < op_arg[3]; j++)
+                  CPPAD_ASSERT_UNKNOWN(op_arg[j] <= arg_var_bound);
+            }
+            itr.correct_before_increment();
+            break;
+
             // CExpOp
             case CExpOp:
             if( op_arg[1] & 1 )
@@ -441,31 +505,31 @@ public:
 # else
    void check_dynamic_dag(void) const
    {  // number of dynamic parameters
-      size_t num_dyn = dyn_par_op_.size();
+      size_t num_dyn = shared_->dyn_par_op_.size();
       //
       size_t i_arg = 0; // initialize dynamic parameter argument index
       for(size_t i_dyn = 0; i_dyn < num_dyn; ++i_dyn)
       {  // i_par is parameter index
-         addr_t i_par = dyn_ind2par_ind_[i_dyn];
-         CPPAD_ASSERT_UNKNOWN( dyn_par_is_[i_par] );
+         addr_t i_par = shared_->dyn_ind2par_ind_[i_dyn];
+         CPPAD_ASSERT_UNKNOWN( shared_->dyn_par_is_[i_par] );
          //
          // operator for this dynamic parameter
-         op_code_dyn op = op_code_dyn( dyn_par_op_[i_dyn] );
+         op_code_dyn op = op_code_dyn( shared_->dyn_par_op_[i_dyn] );
          //
          // number of arguments for this dynamic parameter
          size_t n_arg       = num_arg_dyn(op);
          if( op == atom_dyn )
-         {  size_t n = size_t( dyn_par_arg_[i_arg + 2] );
-            size_t m = size_t( dyn_par_arg_[i_arg + 3] );
+         {  size_t n = size_t( shared_->dyn_par_arg_[i_arg + 2] );
+            size_t m = size_t( shared_->dyn_par_arg_[i_arg + 3] );
             n_arg    = 6 + n + m;
             CPPAD_ASSERT_UNKNOWN(
-               n_arg == size_t( dyn_par_arg_[i_arg + 5 + n + m] )
+               n_arg == size_t( shared_->dyn_par_arg_[i_arg + 5 + n + m] )
             );
             for(size_t i = 5; i < n - 1; ++i)
-               CPPAD_ASSERT_UNKNOWN( dyn_par_arg_[i_arg + i] <  i_par );
+               CPPAD_ASSERT_UNKNOWN( shared_->dyn_par_arg_[i_arg + i] <  i_par );
 # ifndef NDEBUG
             for(size_t i = 5+n; i < 5+n+m; ++i)
-            {  addr_t j_par = dyn_par_arg_[i_arg + i];
+            {  addr_t j_par = shared_->dyn_par_arg_[i_arg + i];
                CPPAD_ASSERT_UNKNOWN( (j_par == 0) || (j_par >= i_par) );
             }
 # endif
@@ -473,7 +537,7 @@ public:
          else
          {  size_t num_non_par = num_non_par_arg_dyn(op);
             for(size_t i = num_non_par; i < n_arg; ++i)
-               CPPAD_ASSERT_UNKNOWN( dyn_par_arg_[i_arg + i] < i_par);
+               CPPAD_ASSERT_UNKNOWN( shared_->dyn_par_arg_[i_arg + i] < i_par);
          }
          //
          // next dynamic parameter
@@ -497,15 +561,10 @@ public:
       num_var_load_rec_   = play.num_var_load_rec_;
       num_var_vecad_rec_  = play.num_var_vecad_rec_;
       //
+      // shared_: the constant part of the recording is not copied
+      shared_             = play.shared_;
+      //
       // pod_vectors
-      op_vec_             = play.op_vec_;
-      arg_vec_            = play.arg_vec_;
-      text_vec_           = play.text_vec_;
-      all_var_vecad_ind_  = play.all_var_vecad_ind_;
-      dyn_par_is_         = play.dyn_par_is_;
-      dyn_ind2par_ind_    = play.dyn_ind2par_ind_;
-      dyn_par_op_         = play.dyn_par_op_;
-      dyn_par_arg_        = play.dyn_par_arg_;
       op2arg_vec_         = play.op2arg_vec_;
       op2var_vec_         = play.op2var_vec_;
       var2op_vec_         = play.var2op_vec_;
@@ -524,15 +583,10 @@ public:
       play.num_var_load_rec_   = num_var_load_rec_;
       play.num_var_vecad_rec_  = num_var_vecad_rec_;
       //
+      // shared_: the constant part of the recording does not depend on Base
+      play.shared_             = shared_;
+      //
       // pod_vectors
-      play.op_vec_             = op_vec_;
-      play.arg_vec_            = arg_vec_;
-      play.text_vec_           = text_vec_;
-      play.all_var_vecad_ind_  = all_var_vecad_ind_;
-      play.dyn_par_is_         = dyn_par_is_;
-      play.dyn_ind2par_ind_    = dyn_ind2par_ind_;
-      play.dyn_par_op_         = dyn_par_op_;
-      play.dyn_par_arg_        = dyn_par_arg_;
       play.op2arg_vec_         = op2arg_vec_;
       play.op2var_vec_         = op2var_vec_;
       play.var2op_vec_         = var2op_vec_;
@@ -554,15 +608,10 @@ public:
       std::swap(num_var_load_rec_,   other.num_var_load_rec_);
       std::swap(num_var_vecad_rec_,  other.num_var_vecad_rec_);
       //
+      // shared_
+      shared_.swap(other.shared_);
+      //
       // pod_vectors
-      op_vec_.swap(             other.op_vec_);
-      arg_vec_.swap(            other.arg_vec_);
-      text_vec_.swap(           other.text_vec_);
-      all_var_vecad_ind_.swap(  other.all_var_vecad_ind_);
-      dyn_par_is_.swap(         other.dyn_par_is_);
-      dyn_ind2par_ind_.swap(    other.dyn_ind2par_ind_);
-      dyn_par_op_.swap(         other.dyn_par_op_);
-      dyn_par_arg_.swap(        other.dyn_par_arg_);
       op2arg_vec_.swap(         other.op2arg_vec_);
       op2var_vec_.swap(         other.op2var_vec_);
       var2op_vec_.swap(         other.var2op_vec_);
@@ -579,11 +628,11 @@ public:
    template <class Addr>
    void setup_random(void)
    {  play::random_setup(
-         num_var_rec_                               ,
-         op_vec_                                    ,
-         arg_vec_                                   ,
-         op2arg_vec_.pod_vector_ptr<Addr>()         ,
-         op2var_vec_.pod_vector_ptr<Addr>()         ,
+         num_var_rec_                        ,
+         shared_->op_vec_                    ,
+         shared_->arg_vec_                   ,
+         op2arg_vec_.pod_vector_ptr<Addr>()  ,
+         op2var_vec_.pod_vector_ptr<Addr>()  ,
          var2op_vec_.pod_vector_ptr<Addr>()
       );
    }
@@ -609,16 +658,19 @@ public:
    // ================================================================
    /// const version of dynamic parameter flag
    const pod_vector<bool>& dyn_par_is(void) const
-   {  return dyn_par_is_; }
+   {  return shared_->dyn_par_is_; }
+   /// information about the atomic function calls
+   const play::atom_call_info& atom_call(void) const
+   {  return shared_->atom_call_; }
    /// const version of dynamic parameter index to parameter index
    const pod_vector<addr_t>& dyn_ind2par_ind(void) const
-   {  return dyn_ind2par_ind_; }
+   {  return shared_->dyn_ind2par_ind_; }
    /// const version of dynamic parameter operator
    const pod_vector<opcode_t>& dyn_par_op(void) const
-   {  return dyn_par_op_; }
+   {  return shared_->dyn_par_op_; }
    /// const version of dynamic parameter arguments
    const pod_vector<addr_t>& dyn_par_arg(void) const
-   {  return dyn_par_arg_; }
+   {  return shared_->dyn_par_arg_; }
    /*!
    \brief
    fetch an operator from the recording.
@@ -630,7 +682,7 @@ public:
    the index of the operator in recording
    */
    OpCode GetOp (size_t i) const
-   {  return OpCode(op_vec_[i]); }
+   {  return OpCode(shared_->op_vec_[i]); }
 
    /*!
    \brief
@@ -643,7 +695,20 @@ public:
    the index of the VecAD index in recording
    */
    size_t GetVecInd (size_t i) const
-   {  return size_t( all_var_vecad_ind_[i] ); }
+   {  return size_t( shared_->all_var_vecad_ind_[i] ); }
+
+   /*!
+   \brief
+   Fetch an operator argument from the recording.
+
+   \return
+   the i-th element of the vector of all the operator arguments.
+
+   \param i
+   the index of the argument in recording
+   */
+   addr_t GetArg (size_t i) const
+   {  return shared_->arg_vec_[i]; }
 
    /*!
    \brief
@@ -680,8 +745,8 @@ public:
    the index where the string begins.
    */
    const char *GetTxt(size_t i) const
-   {  CPPAD_ASSERT_UNKNOWN(i < text_vec_.size() );
-      return text_vec_.data() + i;
+   {  CPPAD_ASSERT_UNKNOWN(i < shared_->text_vec_.size() );
+      return shared_->text_vec_.data() + i;
    }
 
    /// Fetch number of independent dynamic parameters in the recording
@@ -690,11 +755,11 @@ public:
 
    /// Fetch number of dynamic parameters in the recording
    size_t num_dynamic_par(void) const
-   {  return dyn_par_op_.size(); }
+   {  return shared_->dyn_par_op_.size(); }
 
    /// Fetch number of dynamic parameters operator arguments in the recording
    size_t num_dynamic_arg(void) const
-   {  return dyn_par_arg_.size(); }
+   {  return shared_->dyn_par_arg_.size(); }
 
    /// Fetch number of variables in the recording.
    size_t num_var_rec(void) const
@@ -706,11 +771,11 @@ public:
 
    /// Fetch number of operators in the recording.
    size_t num_op_rec(void) const
-   {  return op_vec_.size(); }
+   {  return shared_->op_vec_.size(); }
 
    /// Fetch number of VecAD indices in the recording.
    size_t num_var_vecad_ind_rec(void) const
-   {  return all_var_vecad_ind_.size(); }
+   {  return shared_->all_var_vecad_ind_.size(); }
 
    /// Fetch number of VecAD vectors in the recording
    size_t num_var_vecad_rec(void) const
@@ -718,7 +783,7 @@ public:
 
    /// Fetch number of argument indices in the recording.
    size_t num_op_arg_rec(void) const
-   {  return arg_vec_.size(); }
+   {  return shared_->arg_vec_.size(); }
 
    /// Fetch number of parameters in the recording.
    size_t num_par_rec(void) const
@@ -726,27 +791,31 @@ public:
 
    /// Fetch number of characters (representing strings) in the recording.
    size_t num_text_rec(void) const
-   {  return text_vec_.size(); }
+   {  return shared_->text_vec_.size(); }
 
    /// A measure of amount of memory used to store
    /// the operation sequence, just lengths, not capacities.
    /// In user api as f.size_op_seq(); see the file fun_property.omh.
    size_t size_op_seq(void) const
    {  // check assumptions made by ad_fun<Base>::size_op_seq()
-      CPPAD_ASSERT_UNKNOWN( op_vec_.size() == num_op_rec() );
-      CPPAD_ASSERT_UNKNOWN( arg_vec_.size()    == num_op_arg_rec() );
-      CPPAD_ASSERT_UNKNOWN( all_par_vec_.size() == num_par_rec() );
-      CPPAD_ASSERT_UNKNOWN( text_vec_.size() == num_text_rec() );
-      CPPAD_ASSERT_UNKNOWN( all_var_vecad_ind_.size() == num_var_vecad_ind_rec() );
-      return op_vec_.size()        * sizeof(opcode_t)
-             + arg_vec_.size()       * sizeof(addr_t)
-             + all_par_vec_.size()   * sizeof(Base)
-             + dyn_par_is_.size()    * sizeof(bool)
-             + dyn_ind2par_ind_.size() * sizeof(addr_t)
-             + dyn_par_op_.size()    * sizeof(opcode_t)
-             + dyn_par_arg_.size()   * sizeof(addr_t)
-             + text_vec_.size()      * sizeof(char)
-             + all_var_vecad_ind_.size() * sizeof(addr_t)
+      const player_shared& shared( *shared_ );
+      CPPAD_ASSERT_UNKNOWN( shared.op_vec_.size()  == num_op_rec() );
+      CPPAD_ASSERT_UNKNOWN( shared.arg_vec_.size() == num_op_arg_rec() );
+      CPPAD_ASSERT_UNKNOWN( all_par_vec_.size()    == num_par_rec() );
+      CPPAD_ASSERT_UNKNOWN( shared.text_vec_.size() == num_text_rec() );
+      CPPAD_ASSERT_UNKNOWN(
+         shared.all_var_vecad_ind_.size() == num_var_vecad_ind_rec()
+      );
+      return shared.op_vec_.size()            * sizeof(opcode_t)
+             + shared.arg_vec_.size()           * sizeof(addr_t)
+             + all_par_vec_.size()              * sizeof(Base)
+             + shared.dyn_par_is_.size()        * sizeof(bool)
+             + shared.dyn_ind2par_ind_.size()   * sizeof(addr_t)
+             + shared.dyn_par_op_.size()        * sizeof(opcode_t)
+             + shared.dyn_par_arg_.size()       * sizeof(addr_t)
+             + shared.text_vec_.size()          * sizeof(char)
+             + shared.all_var_vecad_ind_.size() * sizeof(addr_t)
+             + shared.atom_call_.size_bytes()
       ;
    }
    /// A measure of amount of memory used for random access routine
@@ -794,15 +863,15 @@ public:
    {  size_t op_index = 0;
       size_t num_var  = num_var_rec_;
       return play::const_sequential_iterator(
-         num_var, &op_vec_, &arg_vec_, op_index
+         num_var, &shared_->op_vec_, &shared_->arg_vec_, op_index
       );
    }
    /// const sequential iterator end
    play::const_sequential_iterator end(void) const
-   {  size_t op_index = op_vec_.size() - 1;
+   {  size_t op_index = shared_->op_vec_.size() - 1;
       size_t num_var  = num_var_rec_;
       return play::const_sequential_iterator(
-         num_var, &op_vec_, &arg_vec_, op_index
+         num_var, &shared_->op_vec_, &shared_->arg_vec_, op_index
       );
    }
    // -----------------------------------------------------------------------
@@ -834,8 +903,8 @@ public:
    template <class Addr>
    play::const_random_iterator<Addr> get_random(void) const
    {  return play::const_random_iterator<Addr>(
-         op_vec_,
-         arg_vec_,
+         shared_->op_vec_,
+         shared_->arg_vec_,
          op2arg_vec_.pod_vector_ptr<Addr>(),
          op2var_vec_.pod_vector_ptr<Addr>(),
          var2op_vec_.pod_vector_ptr<Addr>()
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_PLAY_RANDOM_SETUP_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
@@ -117,6 +117,19 @@ void random_setup(
          arg_index += size_t(op_arg[4] + 1);
       }
       //
+      // WSumOp
+      if( op == WSumOp )
+      {  CPPAD_ASSERT_UNKNOWN( NumArg(WSumOp) == 0 );
+         //
+         // pointer to first argument for this operator
+         const addr_t* op_arg = arg_vec.data() + arg_index;
+         //
+         // The actual number of arugments for this operator is
+         // op_arg[3] + 1
+         // Correct index of first argument for next operator
+         arg_index += size_t(op_arg[3] + 1);
+      }
+      //
       // CSkip
       if( op == CSkipOp )
       {  CPPAD_ASSERT_UNKNOWN( NumArg(CSumOp) == 0 );
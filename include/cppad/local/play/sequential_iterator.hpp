@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_PLAY_SEQUENTIAL_ITERATOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
@@ -158,7 +158,7 @@ public:
    }
    /*!
    Correction applied before ++ operation when current operator
-   is CSumOp or CSkipOp.
+   is CSumOp, WSumOp, or CSkipOp.
    */
    void correct_before_increment(void)
    {  // number of arguments for this operator depends on argument data
@@ -171,6 +171,12 @@ public:
          arg_ += arg[4] + 1;
       }
       //
+      // WSumOp
+      else if( op_ == WSumOp )
+      {  // add actual number of arguments to arg_
+         arg_ += arg[3] + 1;
+      }
+      //
       // CSkip
       else
       {  CPPAD_ASSERT_UNKNOWN( op_ == CSkipOp );
@@ -203,7 +209,7 @@ public:
    }
    /*!
    Correction applied after -- operation when current operator
-   is CSumOp or CSkipOp.
+   is CSumOp, WSumOp, or CSkipOp.
 
    \param arg [out]
    corrected point to arguments for this operation.
@@ -226,6 +232,17 @@ public:
          CPPAD_ASSERT_UNKNOWN( arg[arg[4] ] == arg[4] );
       }
       //
+      // WSumOp
+      else if( op_ == WSumOp )
+      {  // index of arg[3]
+         addr_t arg_3 = *(arg_ - 1);
+         //
+         // corrected index of first argument to this operator
+         arg = arg_ -= arg_3 + 1;
+         //
+         CPPAD_ASSERT_UNKNOWN( arg[arg[3] ] == arg[3] );
+      }
+      //
       // CSkip
       else
       {  CPPAD_ASSERT_UNKNOWN( op_ == CSkipOp );
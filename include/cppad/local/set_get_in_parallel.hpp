@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SET_GET_IN_PARALLEL_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cassert>
@@ -34,7 +34,7 @@ If set is true, then parallel_new is becomes the most
 recent setting for this set_get_in_parallel.
 In this case, it is assumed that we are currently in sequential execution mode.
 */
-static bool set_get_in_parallel(
+inline bool set_get_in_parallel(
    bool (*in_parallel_new)(void) ,
    bool set = false           )
 {  static bool (*in_parallel_user)(void) = nullptr;
@@ -0,0 +1,182 @@
+# ifndef CPPAD_LOCAL_STD_THREAD_TEAM_HPP
+# define CPPAD_LOCAL_STD_THREAD_TEAM_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <thread>
+# include <vector>
+# include <cppad/utility/thread_alloc.hpp>
+# include <cppad/local/sparse/pack_setvec.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file std_thread_team.hpp
+A team of std::thread objects used by CppAD routines that split their
+work into independent pieces.
+*/
+
+/*!
+Run a fixed number of independent jobs using std::thread.
+
+The calling thread is thread number zero and executes job zero.
+The other jobs are executed by new threads that are joined before run
+returns. While the jobs are executing, thread_alloc is in parallel mode
+with thread_num() equal to the job number.
+
+If a CppAD::thread_pool exists, the jobs are instead executed by the
+threads in the pool; see set_pool.
+*/
+class std_thread_team {
+private:
+   /// thread number for the current thread (zero for the master thread)
+   static size_t& thread_number(void)
+   {  static thread_local size_t number = 0;
+      return number;
+   }
+   /// is a team currently running
+   static bool& running(void)
+   {  static bool flag = false;
+      return flag;
+   }
+   /// in_parallel routine passed to thread_alloc::parallel_setup
+   static bool in_parallel(void)
+   {  return running(); }
+   /// thread_num routine passed to thread_alloc::parallel_setup
+   static size_t thread_num(void)
+   {  return thread_number(); }
+public:
+   /// type of the routine that runs jobs using a thread pool
+   typedef void (*pool_run_t)(
+      size_t n_job, void (*job)(void* data, size_t j), void* data
+   );
+private:
+   /// routine that runs jobs using the current thread pool (or nullptr)
+   static pool_run_t& pool_run(void)
+   {  static pool_run_t run = nullptr;
+      return run;
+   }
+   /// calls job(j) where job has type Job and data points to job
+   template <class Job>
+   static void call_job(void* data, size_t j)
+   {  Job& job = *static_cast<Job*>(data);
+      job(j);
+   }
+public:
+   /*!
+   Set the thread pool that is used to run teams.
+
+   \param run
+   If run is nullptr, teams are run using new std::thread objects.
+   Otherwise, run(n_job, job, data) calls job(data, j) for
+   j = 0, ..., n_job-1 using the threads in a pool.
+   This is set by the CppAD::thread_pool constructor and destructor.
+   */
+   static void set_pool(pool_run_t run)
+   {  CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() );
+      pool_run() = run;
+   }
+   /*!
+   Can a team be run from the current execution context.
+
+   \return
+   is true if thread_alloc is in sequential mode and has not been
+   set up for multi-threading by the user (or it was set up by a
+   CppAD::thread_pool). Otherwise, the user is managing threads and a
+   std_thread_team cannot be used.
+   */
+   static bool available(void)
+   {  if( thread_alloc::in_parallel() )
+         return false;
+      return thread_alloc::num_threads() == 1 || pool_run() != nullptr;
+   }
+   /*!
+   Execute a team of jobs.
+
+   \tparam Job
+   is a type such that job(thread) executes the work for one thread.
+
+   \param num_threads
+   is the number of jobs (and threads) in the team.
+   This must be less than or equal CPPAD_THREAD_LIMIT.
+
+   \param job
+   job(thread) is called for thread = 0, ..., num_threads-1.
+   Memory allocated by thread_alloc during job(thread) belongs to thread
+   (to the pool thread that executes the job when there is a pool).
+   It can be returned by the master thread after run returns.
+   The routine free_available should be used to release the
+   corresponding memory once it is no longer in use.
+   */
+   template <class Job>
+   static void run(size_t num_threads, Job& job)
+   {  CPPAD_ASSERT_UNKNOWN( available() );
+      CPPAD_ASSERT_UNKNOWN( 0 < num_threads );
+      CPPAD_ASSERT_UNKNOWN( num_threads <= CPPAD_THREAD_LIMIT );
+      if( num_threads == 1 )
+      {  job(0);
+         return;
+      }
+      //
+      // initialize statics that may be used during parallel execution
+      // (see parallel_ad for the corresponding statics)
+      {  sparse::pack_setvec sp;
+         sp.resize(1, 1);
+         sp.add_element(0, 0);
+         sp.clear(0);
+         sp.is_element(0, 0);
+         sparse::pack_setvec::const_iterator itr(sp, 0);
+         ++itr;
+      }
+      //
+      // case where there is a thread pool
+      if( pool_run() != nullptr )
+      {  pool_run()(num_threads, call_job<Job>, static_cast<void*>(&job) );
+         return;
+      }
+      //
+      // setup thread_alloc for this team
+      thread_alloc::parallel_setup(num_threads, in_parallel, thread_num);
+      running() = true;
+      //
+      // start the other threads
+      std::vector<std::thread> team;
+      for(size_t thread = 1; thread < num_threads; ++thread)
+      {  team.push_back( std::thread( [&job, thread]()
+         {  thread_number() = thread;
+            job(thread);
+         } ) );
+      }
+      //
+      // master thread does job zero
+      job(0);
+      //
+      // wait for the other threads to finish
+      for(size_t i = 0; i < team.size(); ++i)
+         team[i].join();
+      //
+      // return to sequential execution mode
+      running() = false;
+      thread_alloc::parallel_setup(1, nullptr, nullptr);
+   }
+   /*!
+   Return memory held by the other threads in a team to the system.
+
+   \param num_threads
+   is the number of threads in the team; i.e., the value of num_threads
+   in the corresponding call to run.
+   */
+   static void free_available(size_t num_threads)
+   {  CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() );
+      //
+      // a thread pool holds its memory for the next team
+      if( pool_run() != nullptr )
+         return;
+      for(size_t thread = 1; thread < num_threads; ++thread)
+         thread_alloc::free_available(thread);
+   }
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -0,0 +1,861 @@
+# ifndef CPPAD_LOCAL_SWEEP_ATOM_BATCH_HPP
+# define CPPAD_LOCAL_SWEEP_ATOM_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/atomic_index.hpp>
+# include <cppad/core/atomic/four/atomic.hpp>
+
+// BEGIN_CPAPD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file atom_batch.hpp
+Evaluate atomic_four function calls as batches.
+
+A call that has a batch callback waits in a batch until its results
+are needed (forward mode) or its arguments are defined (reverse mode).
+When a batch must be evaluated, the calls that are ready, but have not yet
+been reached by the sweep, are first added to the batches. Thus the calls
+are grouped by levels of the atomic call dependency graph;
+see play::atom_call_info.
+*/
+
+/*!
+Get the atomic_four object that corresponds to an atomic index.
+
+\param atom_index
+is the index, in local::atomic_index, for this atomic function.
+
+\return
+If this is an atomic_four function that has not been deleted,
+the return value is a pointer to the object. Otherwise it is nullptr.
+*/
+template <class RecBase>
+atomic_four<RecBase>* atom_batch_object(size_t atom_index)
+{  bool         set_null = false;
+   size_t       type     = 0;
+   std::string* name_ptr = nullptr;
+   void*        v_ptr    = nullptr;
+   local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
+   if( type != 4 )
+      return nullptr;
+   return reinterpret_cast< atomic_four<RecBase>* >(v_ptr);
+}
+
+/*!
+Atomic function calls that are evaluated as batches during a sweep.
+
+\tparam Base
+is the type used for the sweep that is using this object.
+
+\tparam RecBase
+is the type used to record the atomic functions.
+Batches are only used when Base is the same as RecBase; see the
+specialization of this class below. In this general case,
+every call is evaluated when it is reached by the sweep.
+*/
+template <class Base, class RecBase>
+class atom_batch {
+public:
+   /// constructor
+   atom_batch(
+      const player<Base>* play, bool forward, bool early, size_t order_up
+   )
+   { }
+   /// is there a call waiting to be evaluated
+   bool empty(void) const
+   {  return true; }
+   /// operator index at which the waiting calls must be evaluated
+   size_t flush_op(void) const
+   {  return 0; }
+   /// index of the call that starts at an operator index
+   size_t call_index(size_t start_op)
+   {  return 0; }
+   /// is a call in a batch
+   bool batched(size_t k) const
+   {  return false; }
+   /// a call was evaluated by the sweep
+   void call_done(size_t k)
+   { }
+   /// delay a forward mode call (no calls are delayed in this case)
+   bool forward_defer(
+      size_t                      k          ,
+      size_t                      atom_index ,
+      size_t                      call_id    ,
+      const vector<bool>&         select_y   ,
+      const vector<Base>&         taylor_x   ,
+      const vector<size_t>&       index_y    )
+   {  return false; }
+   /// evaluate the delayed forward mode calls
+   void forward_flush(size_t i_op, size_t J, Base* taylor)
+   { }
+   /// delay a reverse mode call (no calls are delayed in this case)
+   bool reverse_defer(
+      size_t                      k          ,
+      size_t                      atom_index ,
+      size_t                      call_id    ,
+      const vector<bool>&         select_x   ,
+      const vector<Base>&         taylor_x   ,
+      const vector<Base>&         taylor_y   ,
+      const vector<Base>&         partial_y  ,
+      const vector<size_t>&       index_x    )
+   {  return false; }
+   /// evaluate the delayed reverse mode calls
+   void reverse_flush(
+      size_t i_op, size_t J, const Base* taylor, size_t K, Base* partial
+   )
+   { }
+};
+
+/*!
+Atomic function calls that are evaluated as batches
+for the case where Base is RecBase.
+*/
+template <class Base>
+class atom_batch<Base, Base> {
+private:
+   /// calls, with the same atomic function, call_id, n, and m,
+   /// that are evaluated together
+   struct batch_struct {
+      /// index of the atomic function in local::atomic_index
+      size_t         atom_index;
+      /// call_id for these calls
+      size_t         call_id;
+      /// number of arguments for each call
+      size_t         n;
+      /// number of results for each call
+      size_t         m;
+      /// number of calls in this batch
+      size_t         n_call;
+      /// operator index at which this batch must be evaluated
+      size_t         flush_op;
+      /// index of each call in play::atom_call_info
+      vector<size_t> call;
+      /// select_y (forward) or select_x (reverse) for all the calls
+      vector<bool>   select;
+      /// argument Taylor coefficients for all the calls
+      vector<Base>   taylor_x;
+      /// result Taylor coefficients for all the calls
+      vector<Base>   taylor_y;
+      /// partials w.r.t. the arguments for all the calls (reverse only)
+      vector<Base>   partial_x;
+      /// partials w.r.t. the results for all the calls (reverse only)
+      vector<Base>   partial_y;
+      /// result (forward) or argument (reverse) variable indices
+      vector<size_t> index;
+   };
+   /// player for the recording that is being swept
+   const player<Base>* play_;
+   //
+   /// information about the atomic calls in the recording
+   const play::atom_call_info& info_;
+   //
+   /// is this object used for forward or reverse mode
+   const bool forward_;
+   //
+   /// can calls be evaluated before they are reached by the sweep
+   const bool early_;
+   //
+   /// highest order Taylor coefficient for the calls
+   const size_t order_up_;
+   //
+   /// batch_[ell] for ell < n_batch_ are the batches that are in use
+   vector<batch_struct> batch_;
+   size_t               n_batch_;
+   //
+   /// number of calls that are waiting in a batch
+   size_t n_wait_;
+   //
+   /// operator index at which the next batch must be evaluated
+   size_t flush_op_;
+   //
+   /// index of the call that was most recently reached by the sweep
+   size_t call_;
+   //
+   /// state_[k] is 0 (not evaluated), 1 (in a batch), or 2 (evaluated)
+   /// for the k-th call
+   pod_vector<unsigned char> state_;
+   //
+   /// count_[k] is the number of producers (forward) or consumers
+   /// (reverse) for the k-th call that have not been evaluated
+   pod_vector<addr_t> count_;
+   //
+   /// position_[k] is true if all the operators that the k-th call
+   /// depends on, other than atomic calls, have been swept
+   pod_vector<bool> position_;
+   //
+   /// next index in forward_order (reverse_order) to check for position_
+   size_t order_;
+   //
+   /// calls that can be put in a batch before they are reached
+   vector<size_t> ready_;
+   //
+   /// implemented_[atom_index] is 0 (not known), 1 (batch callback is
+   /// implemented), or 2 (batch callback is not implemented)
+   pod_vector<unsigned char> implemented_;
+   //
+   /// is the batch callback implemented for an atomic function
+   bool implemented(size_t atom_index, size_t call_id)
+   {  if( implemented_.size() <= atom_index )
+      {  size_t old_size = implemented_.size();
+         implemented_.resize(atom_index + 1);
+         for(size_t i = old_size; i <= atom_index; ++i)
+            implemented_[i] = 0;
+      }
+      if( implemented_[atom_index] == 0 )
+      {  atomic_four<Base>* afun = atom_batch_object<Base>(atom_index);
+         bool ok = afun != nullptr;
+         if( ok )
+         {  vector<bool> select;
+            vector<Base> empty, not_used;
+            if( forward_ ) ok = afun->forward_batch(
+               call_id, 0, select, 0, 0, empty, not_used
+            );
+            else ok = afun->reverse_batch(
+               call_id, 0, select, 0, empty, empty, not_used, empty
+            );
+         }
+         implemented_[atom_index] = ok ? 1 : 2;
+      }
+      return implemented_[atom_index] == 1;
+   }
+   /// batch for an atomic function, call_id, n and m (create if necessary)
+   batch_struct& get_batch(
+      size_t atom_index, size_t call_id, size_t n, size_t m
+   )
+   {  for(size_t ell = 0; ell < n_batch_; ++ell)
+      {  batch_struct& batch( batch_[ell] );
+         if( batch.atom_index == atom_index && batch.call_id == call_id &&
+            batch.n == n && batch.m == m
+         )  return batch;
+      }
+      if( batch_.size() == n_batch_ )
+         batch_.push_back( batch_struct() );
+      batch_struct& batch( batch_[n_batch_++] );
+      batch.atom_index = atom_index;
+      batch.call_id    = call_id;
+      batch.n          = n;
+      batch.m          = m;
+      batch.n_call     = 0;
+      return batch;
+   }
+   /// set the state for the k-th call to evaluated and update the
+   /// calls that depend on it
+   void set_done(size_t k)
+   {  CPPAD_ASSERT_UNKNOWN( state_[k] != 2 );
+      state_[k] = 2;
+      const pod_vector<addr_t>& start( forward_ ?
+         info_.consumer_start : info_.producer_start
+      );
+      const pod_vector<addr_t>& other( forward_ ?
+         info_.consumer : info_.producer
+      );
+      for(size_t ell = size_t(start[k]); ell < size_t(start[k+1]); ++ell)
+      {  size_t c = size_t( other[ell] );
+         CPPAD_ASSERT_UNKNOWN( count_[c] > 0 );
+         if( --count_[c] == 0 && position_[c] && state_[c] == 0 )
+            ready_.push_back(c);
+      }
+   }
+   /// the k-th call is waiting in a batch
+   void set_wait(batch_struct& batch, size_t k)
+   {  CPPAD_ASSERT_UNKNOWN( state_[k] == 0 );
+      state_[k] = 1;
+      //
+      // flush_op: operator index at which this call must be evaluated
+      size_t flush_op = forward_ ?
+         size_t( info_.first_use[k] ) : size_t( info_.last_def[k] );
+      //
+      bool first = batch.n_call == 1;
+      if( forward_ )
+      {  if( first || flush_op < batch.flush_op )
+            batch.flush_op = flush_op;
+         if( n_wait_ == 0 || flush_op < flush_op_ )
+            flush_op_ = flush_op;
+      }
+      else
+      {  if( first || batch.flush_op < flush_op )
+            batch.flush_op = flush_op;
+         if( n_wait_ == 0 || flush_op_ < flush_op )
+            flush_op_ = flush_op;
+      }
+      ++n_wait_;
+   }
+   /// add a forward mode call to its batch
+   void forward_add(
+      size_t                      k          ,
+      size_t                      atom_index ,
+      size_t                      call_id    ,
+      const vector<bool>&         select_y   ,
+      const vector<Base>&         taylor_x   ,
+      const vector<size_t>&       index_y    )
+   {  size_t n = taylor_x.size();
+      size_t m = index_y.size();
+      batch_struct& batch = get_batch(atom_index, call_id, n, m);
+      //
+      size_t k_batch = batch.n_call++;
+      batch.call.resize(k_batch + 1);
+      batch.select.resize( (k_batch + 1) * m );
+      batch.index.resize( (k_batch + 1) * m );
+      batch.taylor_x.resize( (k_batch + 1) * n );
+      batch.call[k_batch] = k;
+      for(size_t i = 0; i < m; ++i)
+      {  batch.select[k_batch * m + i] = select_y[i];
+         batch.index[k_batch * m + i]  = index_y[i];
+      }
+      for(size_t j = 0; j < n; ++j)
+         batch.taylor_x[k_batch * n + j] = taylor_x[j];
+      set_wait(batch, k);
+   }
+   /// add a reverse mode call to its batch
+   void reverse_add(
+      size_t                      k          ,
+      size_t                      atom_index ,
+      size_t                      call_id    ,
+      const vector<bool>&         select_x   ,
+      const vector<Base>&         taylor_x   ,
+      const vector<Base>&         taylor_y   ,
+      const vector<Base>&         partial_y  ,
+      const vector<size_t>&       index_x    )
+   {  size_t q  = order_up_ + 1;
+      size_t n  = index_x.size();
+      size_t m  = taylor_y.size() / q;
+      batch_struct& batch = get_batch(atom_index, call_id, n, m);
+      //
+      size_t k_batch = batch.n_call++;
+      batch.call.resize(k_batch + 1);
+      batch.select.resize( (k_batch + 1) * n );
+      batch.index.resize( (k_batch + 1) * n );
+      batch.taylor_x.resize( (k_batch + 1) * n * q );
+      batch.taylor_y.resize( (k_batch + 1) * m * q );
+      batch.partial_y.resize( (k_batch + 1) * m * q );
+      batch.call[k_batch] = k;
+      for(size_t j = 0; j < n; ++j)
+      {  batch.select[k_batch * n + j] = select_x[j];
+         batch.index[k_batch * n + j]  = index_x[j];
+      }
+      for(size_t j = 0; j < n * q; ++j)
+         batch.taylor_x[k_batch * n * q + j] = taylor_x[j];
+      for(size_t i = 0; i < m * q; ++i)
+      {  batch.taylor_y[k_batch * m * q + i]  = taylor_y[i];
+         batch.partial_y[k_batch * m * q + i] = partial_y[i];
+      }
+      set_wait(batch, k);
+   }
+   /*!
+   Get the values that a call needs from the Taylor coefficient
+   and partial derivative matrices.
+
+   \param k
+   is the index of the call.
+
+   \param J
+   is the number of columns in the Taylor coefficient matrix.
+
+   \param taylor
+   is the Taylor coefficient matrix.
+
+   \param K
+   is the number of columns in the partial derivative matrix
+   (not used in forward mode).
+
+   \param partial
+   is the partial derivative matrix (nullptr in forward mode).
+
+   \param atom_index [out]
+   is the index, in local::atomic_index, for the call.
+
+   \param call_id [out]
+   is the call_id for the call.
+
+   \param select [out]
+   is select_y (forward) or select_x (reverse) for the call.
+
+   \param index [out]
+   is the variable index for each result (forward) or argument (reverse)
+   of the call (zero if it is not a variable).
+
+   The other arguments are set to the values for the call.
+   */
+   void gather(
+      size_t                      k          ,
+      size_t                      J          ,
+      const Base*                 taylor     ,
+      size_t                      K          ,
+      const Base*                 partial    ,
+      size_t&                     atom_index ,
+      size_t&                     call_id    ,
+      vector<bool>&               select     ,
+      vector<size_t>&             index      ,
+      vector<Base>&               taylor_x   ,
+      vector<Base>&               taylor_y   ,
+      vector<Base>&               partial_y  )
+   {  size_t q        = order_up_ + 1;
+      size_t start_op = size_t( info_.op[k] );
+      size_t i_arg    = size_t( info_.arg[k] );
+      size_t i_var    = size_t( info_.var[k] );
+      CPPAD_ASSERT_UNKNOWN( play_->GetOp(start_op) == AFunOp );
+      atom_index = size_t( play_->GetArg(i_arg + 0) );
+      call_id    = size_t( play_->GetArg(i_arg + 1) );
+      size_t n   = size_t( play_->GetArg(i_arg + 2) );
+      size_t m   = size_t( play_->GetArg(i_arg + 3) );
+      i_arg     += 4;
+      //
+      const Base* parameter = play_->GetPar();
+      taylor_x.resize(n * q);
+      if( forward_ )
+         index.resize(m);
+      else
+      {  index.resize(n);
+         taylor_y.resize(m * q);
+         partial_y.resize(m * q);
+      }
+      select.resize(index.size());
+      //
+      // arguments
+      for(size_t j = 0; j < n; ++j)
+      {  OpCode op    = play_->GetOp(start_op + 1 + j);
+         size_t x_ind = size_t( play_->GetArg(i_arg++) );
+         CPPAD_ASSERT_UNKNOWN( op == FunapOp || op == FunavOp );
+         if( op == FunavOp )
+         {  for(size_t ell = 0; ell < q; ++ell)
+               taylor_x[j * q + ell] = taylor[x_ind * J + ell];
+         }
+         else
+         {  taylor_x[j * q + 0] = parameter[x_ind];
+            for(size_t ell = 1; ell < q; ++ell)
+               taylor_x[j * q + ell] = Base(0.0);
+         }
+         if( ! forward_ )
+         {  index[j]  = op == FunavOp ? x_ind : 0;
+            select[j] = op == FunavOp;
+         }
+      }
+      //
+      // results
+      for(size_t i = 0; i < m; ++i)
+      {  OpCode op    = play_->GetOp(start_op + 1 + n + i);
+         size_t y_ind = 0;
+         CPPAD_ASSERT_UNKNOWN( op == FunrpOp || op == FunrvOp );
+         if( op == FunrvOp )
+            y_ind = i_var++;
+         if( forward_ )
+         {  index[i]  = y_ind;
+            select[i] = op == FunrvOp;
+         }
+         else if( op == FunrvOp )
+         {  for(size_t ell = 0; ell < q; ++ell)
+            {  taylor_y[i * q + ell]  = taylor[y_ind * J + ell];
+               partial_y[i * q + ell] = partial[y_ind * K + ell];
+            }
+         }
+         else
+         {  size_t y_par = size_t( play_->GetArg(i_arg++) );
+            taylor_y[i * q + 0]  = parameter[y_par];
+            partial_y[i * q + 0] = Base(0.0);
+            for(size_t ell = 1; ell < q; ++ell)
+            {  taylor_y[i * q + ell]  = Base(0.0);
+               partial_y[i * q + ell] = Base(0.0);
+            }
+         }
+      }
+   }
+   /*!
+   Evaluate the batches that must be evaluated at an operator index.
+
+   \param i_op
+   is the index of the next operator for the sweep.
+
+   \param J
+   is the number of columns in the Taylor coefficient matrix.
+
+   \param taylor
+   is the Taylor coefficient matrix (only used in forward mode).
+
+   \param K
+   is the number of columns in the partial derivative matrix.
+
+   \param partial
+   is the partial derivative matrix (only used in reverse mode).
+
+   \return
+   is true if any batches were evaluated.
+   */
+   bool evaluate(
+      size_t i_op, size_t J, Base* taylor, size_t K, Base* partial
+   )
+   {  size_t q       = order_up_ + 1;
+      size_t n_eval  = 0;
+      for(size_t ell = 0; ell < n_batch_; ++ell)
+      {  batch_struct& batch( batch_[ell] );
+         bool required = forward_ ?
+            batch.flush_op <= i_op : i_op <= batch.flush_op;
+         if( required )
+         {  size_t n_call = batch.n_call;
+            size_t n      = batch.n;
+            size_t m      = batch.m;
+            atomic_four<Base>* afun =
+               atom_batch_object<Base>(batch.atom_index);
+            if( forward_ )
+            {  batch.taylor_y.resize(n_call * m);
+               bool ok = afun->forward_batch(
+                  batch.call_id, n_call, batch.select, 0, 0,
+                  batch.taylor_x, batch.taylor_y
+               );
+               if( ! ok )
+               {  std::string msg = afun->atomic_name();
+                  msg += ": atomic forward_batch returned false";
+                  CPPAD_ASSERT_KNOWN(false, msg.c_str() );
+               }
+               for(size_t i = 0; i < n_call * m; ++i)
+                  if( batch.index[i] > 0 )
+                     taylor[ batch.index[i] * J + 0 ] = batch.taylor_y[i];
+            }
+            else
+            {  batch.partial_x.resize(n_call * n * q);
+               bool ok = afun->reverse_batch(
+                  batch.call_id, n_call, batch.select, order_up_,
+                  batch.taylor_x, batch.taylor_y,
+                  batch.partial_x, batch.partial_y
+               );
+               if( ! ok )
+               {  std::string msg = afun->atomic_name();
+                  msg += ": atomic reverse_batch returned false";
+                  CPPAD_ASSERT_KNOWN(false, msg.c_str() );
+               }
+               for(size_t j = 0; j < n_call * n; ++j)
+                  if( batch.index[j] > 0 )
+                  {  for(size_t ell_q = 0; ell_q < q; ++ell_q)
+                        partial[ batch.index[j] * K + ell_q ] +=
+                           batch.partial_x[j * q + ell_q];
+                  }
+            }
+            // move this batch to the end of the batches in use
+            std::swap( batch_[ell], batch_[n_batch_ - 1] );
+            --n_batch_;
+            --ell;
+            ++n_eval;
+         }
+      }
+      if( n_eval == 0 )
+         return false;
+      //
+      // The calls are set to done after all the batches are evaluated
+      // so that the calls that become ready are in the next level.
+      for(size_t ell = n_batch_; ell < n_batch_ + n_eval; ++ell)
+      {  batch_struct& batch( batch_[ell] );
+         CPPAD_ASSERT_UNKNOWN( batch.call.size() == batch.n_call );
+         n_wait_ -= batch.n_call;
+         for(size_t k_batch = 0; k_batch < batch.n_call; ++k_batch)
+            set_done( batch.call[k_batch] );
+         batch.n_call = 0;
+      }
+      //
+      // flush_op_
+      for(size_t ell = 0; ell < n_batch_; ++ell)
+      {  const batch_struct& batch( batch_[ell] );
+         if( ell == 0 )
+            flush_op_ = batch.flush_op;
+         else if( forward_ && batch.flush_op < flush_op_ )
+            flush_op_ = batch.flush_op;
+         else if( ! forward_ && flush_op_ < batch.flush_op )
+            flush_op_ = batch.flush_op;
+      }
+      return true;
+   }
+   /*!
+   Evaluate the batches that must be evaluated at an operator index.
+   The calls that are ready are added to the batches, level by level,
+   before the batches are evaluated.
+   */
+   void flush(
+      size_t      i_op       ,
+      size_t      J          ,
+      const Base* taylor_in  ,
+      Base*       taylor_out ,
+      size_t      K          ,
+      Base*       partial    )
+   {  if( ! early_ )
+      {  evaluate(i_op, J, taylor_out, K, partial);
+         ready_.resize(0);
+         return;
+      }
+      //
+      // position_
+      const pod_vector<addr_t>& order( forward_ ?
+         info_.forward_order : info_.reverse_order
+      );
+      while( order_ < order.size() )
+      {  size_t k  = size_t( order[order_] );
+         bool   ok = forward_ ?
+            size_t( info_.forward_def[k] ) < i_op :
+            i_op < size_t( info_.reverse_use[k] ) ;
+         if( ! ok )
+            break;
+         position_[k] = true;
+         if( count_[k] == 0 && state_[k] == 0 )
+            ready_.push_back(k);
+         ++order_;
+      }
+      //
+      // levels of calls that are ready
+      size_t         atom_index, call_id;
+      vector<bool>   select;
+      vector<size_t> index;
+      vector<Base>   taylor_x, taylor_y, partial_y;
+      vector<size_t> level;
+      bool more = true;
+      while( more )
+      {  level.swap(ready_);
+         ready_.resize(0);
+         for(size_t ell = 0; ell < level.size(); ++ell)
+         {  size_t k = level[ell];
+            if( state_[k] == 0 )
+            {  size_t i_arg  = size_t( info_.arg[k] );
+               atom_index    = size_t( play_->GetArg(i_arg + 0) );
+               call_id       = size_t( play_->GetArg(i_arg + 1) );
+               if( implemented(atom_index, call_id) )
+               {  gather(k, J, taylor_in, K, partial, atom_index, call_id,
+                     select, index, taylor_x, taylor_y, partial_y
+                  );
+                  if( forward_ ) forward_add(
+                     k, atom_index, call_id, select, taylor_x, index
+                  );
+                  else reverse_add(k, atom_index, call_id,
+                     select, taylor_x, taylor_y, partial_y, index
+                  );
+               }
+            }
+         }
+         more  = evaluate(i_op, J, taylor_out, K, partial);
+         more &= ready_.size() > 0;
+      }
+   }
+public:
+   /*!
+   constructor
+
+   \param play
+   is the player for the recording that is being swept.
+
+   \param forward
+   is true (false) if this object is used for a zero order forward
+   (reverse) sweep.
+
+   \param early
+   If this is true, calls are evaluated before they are reached
+   by the sweep (when they are ready). This can only be done for a
+   sweep that processes every operator in the recording.
+
+   \param order_up
+   is the highest order Taylor coefficient for this sweep.
+   */
+   atom_batch(
+      const player<Base>* play, bool forward, bool early, size_t order_up
+   )
+   : play_(play)
+   , info_( play->atom_call() )
+   , forward_(forward)
+   , early_(early && play->atom_call().early)
+   , order_up_(order_up)
+   , n_batch_(0)
+   , n_wait_(0)
+   , flush_op_(0)
+   , order_(0)
+   {  CPPAD_ASSERT_UNKNOWN( ! forward || order_up == 0 );
+      size_t num_call = info_.num_call();
+      call_ = forward ? 0 : num_call;
+      state_.resize(num_call);
+      count_.resize(num_call);
+      position_.resize(num_call);
+      const pod_vector<addr_t>& start( forward_ ?
+         info_.producer_start : info_.consumer_start
+      );
+      for(size_t k = 0; k < num_call; ++k)
+      {  state_[k]    = 0;
+         count_[k]    = start[k+1] - start[k];
+         position_[k] = false;
+      }
+   }
+   /// is there a call, that was reached by the sweep, waiting to be evaluated
+   bool empty(void) const
+   {  return n_wait_ == 0; }
+   /*!
+   operator index at which the waiting calls must be evaluated.
+   A forward sweep must evaluate them before the operator with this index
+   (or a greater index). A reverse sweep must evaluate them before the
+   operator with this index (or a smaller index).
+   */
+   size_t flush_op(void) const
+   {  return flush_op_; }
+   /*!
+   Index of a call.
+
+   \param start_op
+   is the operator index of the first AFunOp for the call.
+   The calls must be reached in the order of the sweep.
+
+   \return
+   is the index of the call in play::atom_call_info.
+   */
+   size_t call_index(size_t start_op)
+   {  if( forward_ )
+      {  while( size_t( info_.op[call_] ) < start_op )
+            ++call_;
+         CPPAD_ASSERT_UNKNOWN( size_t( info_.op[call_] ) == start_op );
+         return call_;
+      }
+      while( start_op < size_t( info_.op[call_ - 1] ) )
+         --call_;
+      CPPAD_ASSERT_UNKNOWN( size_t( info_.op[call_ - 1] ) == start_op );
+      return call_ - 1;
+   }
+   /// is the k-th call in a batch (it was put there before it was reached)
+   bool batched(size_t k) const
+   {  return state_[k] != 0; }
+   /// the k-th call was evaluated by the sweep
+   void call_done(size_t k)
+   {  set_done(k); }
+   /*!
+   Delay a zero order forward mode call.
+
+   \param k
+   is the index of this call in play::atom_call_info.
+
+   \param atom_index
+   is the index, in local::atomic_index, for this atomic function.
+
+   \param call_id
+   is the call_id for this call.
+
+   \param select_y
+   is the select_y vector for this call.
+
+   \param taylor_x
+   is the zero order Taylor coefficients for the arguments to this call.
+
+   \param index_y
+   is the variable index for each result of this call
+   (zero if the result is not a variable).
+
+   \return
+   is true if the call has been delayed. Otherwise, the batch callback
+   is not implemented and the call must be evaluated now.
+   */
+   bool forward_defer(
+      size_t                      k          ,
+      size_t                      atom_index ,
+      size_t                      call_id    ,
+      const vector<bool>&         select_y   ,
+      const vector<Base>&         taylor_x   ,
+      const vector<size_t>&       index_y    )
+   {  CPPAD_ASSERT_UNKNOWN( forward_ );
+      CPPAD_ASSERT_UNKNOWN( state_[k] == 0 );
+      if( ! implemented(atom_index, call_id) )
+         return false;
+      forward_add(k, atom_index, call_id, select_y, taylor_x, index_y);
+      return true;
+   }
+   /*!
+   Evaluate the zero order forward mode batches that have results
+   used by the next operator (and other batches that are ready).
+
+   \param i_op
+   is the index of the next operator for the sweep.
+   The operators with a smaller index have been swept.
+
+   \param J
+   is the number of columns in the Taylor coefficient matrix.
+
+   \param taylor
+   is the Taylor coefficient matrix. The zero order coefficients
+   for the results of the evaluated calls are set.
+   */
+   void forward_flush(size_t i_op, size_t J, Base* taylor)
+   {  CPPAD_ASSERT_UNKNOWN( forward_ );
+      flush(i_op, J, taylor, taylor, 0, nullptr);
+   }
+   /*!
+   Delay a reverse mode call.
+
+   \param k
+   is the index of this call in play::atom_call_info.
+
+   \param atom_index
+   is the index, in local::atomic_index, for this atomic function.
+
+   \param call_id
+   is the call_id for this call.
+
+   \param select_x
+   is the select_x vector for this call.
+
+   \param taylor_x
+   is the Taylor coefficients for the arguments to this call.
+
+   \param taylor_y
+   is the Taylor coefficients for the results of this call.
+
+   \param partial_y
+   is the partial derivatives w.r.t. the results of this call.
+
+   \param index_x
+   is the variable index for each argument of this call
+   (zero if the argument is not a variable).
+
+   \return
+   is true if the call has been delayed. Otherwise, the batch callback
+   is not implemented and the call must be evaluated now.
+   */
+   bool reverse_defer(
+      size_t                      k          ,
+      size_t                      atom_index ,
+      size_t                      call_id    ,
+      const vector<bool>&         select_x   ,
+      const vector<Base>&         taylor_x   ,
+      const vector<Base>&         taylor_y   ,
+      const vector<Base>&         partial_y  ,
+      const vector<size_t>&       index_x    )
+   {  CPPAD_ASSERT_UNKNOWN( ! forward_ );
+      CPPAD_ASSERT_UNKNOWN( state_[k] == 0 );
+      if( ! implemented(atom_index, call_id) )
+         return false;
+      reverse_add(k, atom_index, call_id,
+         select_x, taylor_x, taylor_y, partial_y, index_x
+      );
+      return true;
+   }
+   /*!
+   Evaluate the reverse mode batches that have arguments defined
+   by the next operator (and other batches that are ready).
+
+   \param i_op
+   is the index of the next operator for the sweep.
+   The operators with a larger index have been swept.
+
+   \param J
+   is the number of columns in the Taylor coefficient matrix.
+
+   \param taylor
+   is the Taylor coefficient matrix.
+
+   \param K
+   is the number of columns in the partial derivative matrix.
+
+   \param partial
+   is the partial derivative matrix. The partials for the evaluated calls
+   are added to the partials for their arguments.
+   */
+   void reverse_flush(
+      size_t i_op, size_t J, const Base* taylor, size_t K, Base* partial
+   )
+   {  CPPAD_ASSERT_UNKNOWN( ! forward_ );
+      flush(i_op, J, taylor, nullptr, K, partial);
+   }
+};
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
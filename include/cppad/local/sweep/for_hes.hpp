@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FOR_HES_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -255,6 +255,7 @@ void for_hes(
       include |= op == EndOp;
       include |= op == CSkipOp;
       include |= op == CSumOp;
+      include |= op == WSumOp;
       include |= op == AFunOp;
       include |= op == FunapOp;
       include |= op == FunavOp;
@@ -364,6 +365,26 @@ void for_hes(
          // -------------------------------------------------
 
          case CSumOp:
+         // only assign Jacobian term J(i_var)
+         if( rev_jac_sparse.is_element(i_var, 0) )
+         {  for_hes_sparse.clear(np1 + i_var);
+            for(size_t i = 5; i < size_t(arg[2]); ++i)
+            {  for_hes_sparse.binary_union(
+                  np1 + i_var, np1 + i_var, np1 + size_t(arg[i]),
+                  for_hes_sparse
+               );
+            }
+         }
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
+         case WSumOp:
+         if( rev_jac_sparse.is_element(i_var, 0) )
+         {  forward_sparse_hessian_wsum_op(
+               np1, numvar, i_var, arg, for_hes_sparse
+            );
+         }
          itr.correct_before_increment();
          break;
          // -------------------------------------------------
@@ -421,6 +442,23 @@ void for_hes(
          break;
          // -------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         CPPAD_ASSERT_NARG_NRES(op, 3, 1)
+         sparse::for_hes_mul_op(
+            np1, numvar, i_var, arg, for_hes_sparse
+         );
+         if( op == FmavvvOp )
+         {  for_hes_sparse.binary_union(
+               np1 + i_var          ,
+               np1 + i_var          ,
+               np1 + size_t(arg[2]) ,
+               for_hes_sparse
+            );
+         }
+         break;
+         // -------------------------------------------------
+
          case MulvvOp:
          CPPAD_ASSERT_NARG_NRES(op, 2, 1)
          sparse::for_hes_mul_op(
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FOR_JAC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <set>
@@ -263,6 +263,14 @@ void for_jac(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         forward_sparse_jacobian_wsum_op(
+            i_var, arg, var_sparsity
+         );
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
          case CExpOp:
          forward_sparse_jacobian_cond_op(
             dependency, i_var, arg, num_par, var_sparsity
@@ -356,6 +364,20 @@ void for_jac(
          break;
          // -------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         CPPAD_ASSERT_NARG_NRES(op, 3, 1);
+         sparse::for_jac_binary_op(
+            i_var, arg, var_sparsity
+         );
+         if( op == FmavvvOp )
+         {  var_sparsity.binary_union(
+               i_var, i_var, size_t(arg[2]), var_sparsity
+            );
+         }
+         break;
+         // -------------------------------------------------
+
          case InvOp:
          CPPAD_ASSERT_NARG_NRES(op, 0, 1);
          // sparsity pattern is already defined
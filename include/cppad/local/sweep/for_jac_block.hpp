@@ -0,0 +1,207 @@
+# ifndef CPPAD_LOCAL_SWEEP_FOR_JAC_BLOCK_HPP
+# define CPPAD_LOCAL_SWEEP_FOR_JAC_BLOCK_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <vector>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/std_thread_team.hpp>
+# include <cppad/local/sparse/internal.hpp>
+# include <cppad/local/sweep/for_jac.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/for_jac_block.hpp
+Compute Forward mode Jacobian sparsity patterns by blocks of columns.
+*/
+
+/*!
+Job executed by one thread during a call to for_jac_block.
+*/
+template <class Addr, class Base, class Vector_set, class SizeVector,
+   class RecBase>
+class for_jac_block_job {
+public:
+   // arguments that are the same for all blocks
+   const local::player<Base>*            play_;
+   bool                                  dependency_;
+   size_t                                n_;
+   size_t                                numvar_;
+   bool                                  transpose_;
+   const pod_vector<size_t>*             ind_taddr_;
+   const RecBase*                        not_used_rec_base_;
+   //
+   // block_pattern_[b] is the input sparsity pattern for block b
+   const std::vector< sparse_rc<SizeVector> >* block_pattern_;
+   //
+   // block_sparsity_[b] is the variable sparsity pattern for block b
+   std::vector<Vector_set>*              block_sparsity_;
+   //
+   // compute the sparsity for block b
+   void operator()(size_t b)
+   {  const sparse_rc<SizeVector>& pattern_in( (*block_pattern_)[b] );
+      Vector_set&                  sparsity( (*block_sparsity_)[b] );
+      size_t ell = pattern_in.nc();
+      if( transpose_ )
+         ell = pattern_in.nr();
+      //
+      // memory for this block is allocated by the thread that uses it
+      sparsity.resize(numvar_, ell);
+      bool zero_empty  = true;
+      bool input_empty = true;
+      sparse::set_internal_pattern(
+         zero_empty   ,
+         input_empty  ,
+         transpose_   ,
+         *ind_taddr_  ,
+         sparsity     ,
+         pattern_in
+      );
+      for_jac<Addr>(
+         play_, dependency_, n_, numvar_, sparsity, *not_used_rec_base_
+      );
+   }
+};
+
+/*!
+Forward Jacobian sparsity where the columns of R are split into blocks
+and each block is computed by a separate thread.
+
+\tparam Addr, Base, Vector_set, RecBase
+see the corresponding types in for_jac.
+
+\tparam SizeVector
+is the simple vector type used by pattern_in.
+
+\param play, dependency, n, numvar, not_used_rec_base
+see the corresponding arguments to for_jac.
+
+\param transpose
+if true (false) pattern_in is the sparsity pattern for R^T (R).
+
+\param ind_taddr
+mapping from independent variable index to variable index on the tape.
+
+\param pattern_in
+is the sparsity pattern for R or R^T.
+
+\param num_block
+is the number of blocks (and threads) to use.
+This must be greater than zero, less than or equal the number of columns
+in R, and less than or equal CPPAD_THREAD_LIMIT.
+In addition, std_thread_team::available() must be true.
+
+\param var_sparsity
+On input, var_sparsity.n_set() == numvar, var_sparsity.end()
+is the number of columns in R, and all the sets are empty.
+Upon return, var_sparsity is the same as if var_sparsity had been
+initialized using pattern_in and then for_jac had been called.
+*/
+template <class Addr, class Base, class Vector_set, class SizeVector,
+   class RecBase>
+void for_jac_block(
+   const local::player<Base>*    play              ,
+   bool                          dependency        ,
+   size_t                        n                 ,
+   size_t                        numvar            ,
+   bool                          transpose         ,
+   const pod_vector<size_t>&     ind_taddr         ,
+   const sparse_rc<SizeVector>&  pattern_in        ,
+   size_t                        num_block         ,
+   Vector_set&                   var_sparsity      ,
+   const RecBase&                not_used_rec_base )
+{  typedef typename Vector_set::const_iterator iterator;
+   CPPAD_ASSERT_UNKNOWN( var_sparsity.n_set() == numvar );
+   CPPAD_ASSERT_UNKNOWN( std_thread_team::available() );
+   //
+   // ell
+   size_t ell = var_sparsity.end();
+   CPPAD_ASSERT_UNKNOWN( 0 < num_block && num_block <= ell );
+   CPPAD_ASSERT_UNKNOWN( num_block <= CPPAD_THREAD_LIMIT );
+   //
+   // block_size, num_block
+   // column j of R is in block j / block_size
+   size_t block_size = (ell + num_block - 1) / num_block;
+   num_block         = (ell + block_size - 1) / block_size;
+   //
+   // block_nnz
+   const SizeVector& row( pattern_in.row() );
+   const SizeVector& col( pattern_in.col() );
+   size_t nnz = pattern_in.nnz();
+   std::vector<size_t> block_nnz(num_block, 0);
+   for(size_t k = 0; k < nnz; ++k)
+   {  size_t j = col[k];
+      if( transpose )
+         j = row[k];
+      ++block_nnz[ j / block_size ];
+   }
+   //
+   // block_pattern
+   std::vector< sparse_rc<SizeVector> > block_pattern(num_block);
+   for(size_t b = 0; b < num_block; ++b)
+   {  size_t ell_b = std::min(block_size, ell - b * block_size);
+      if( transpose )
+         block_pattern[b].resize(ell_b, n, block_nnz[b]);
+      else
+         block_pattern[b].resize(n, ell_b, block_nnz[b]);
+      block_nnz[b] = 0;
+   }
+   for(size_t k = 0; k < nnz; ++k)
+   {  size_t i = row[k];
+      size_t j = col[k];
+      if( transpose )
+      {  size_t b = i / block_size;
+         block_pattern[b].set(block_nnz[b]++, i - b * block_size, j);
+      }
+      else
+      {  size_t b = j / block_size;
+         block_pattern[b].set(block_nnz[b]++, i, j - b * block_size);
+      }
+   }
+   //
+   // block_sparsity
+   std::vector<Vector_set> block_sparsity(num_block);
+   //
+   // job
+   for_jac_block_job<Addr, Base, Vector_set, SizeVector, RecBase> job;
+   job.play_              = play;
+   job.dependency_        = dependency;
+   job.n_                 = n;
+   job.numvar_            = numvar;
+   job.transpose_         = transpose;
+   job.ind_taddr_         = &ind_taddr;
+   job.not_used_rec_base_ = &not_used_rec_base;
+   job.block_pattern_     = &block_pattern;
+   job.block_sparsity_    = &block_sparsity;
+   //
+   // compute the sparsity pattern for each block
+   std_thread_team::run(num_block, job);
+   //
+   // var_sparsity
+   for(size_t i = 0; i < numvar; ++i)
+   {  for(size_t b = 0; b < num_block; ++b)
+      {  size_t offset = b * block_size;
+         size_t end_b  = block_sparsity[b].end();
+         iterator itr(block_sparsity[b], i);
+         size_t j = *itr;
+         while( j < end_b )
+         {  var_sparsity.post_element(i, j + offset);
+            j = *(++itr);
+         }
+      }
+      var_sparsity.process_post(i);
+   }
+   //
+   // free memory that was allocated by the other threads
+   block_sparsity.clear();
+   std_thread_team::free_available(num_block);
+   //
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -2,11 +2,12 @@
 # define CPPAD_LOCAL_SWEEP_FORWARD0_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
 # include <cppad/local/sweep/call_atomic.hpp>
+# include <cppad/local/sweep/atom_batch.hpp>
 
 // BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
@@ -38,6 +39,7 @@ Syntax
 | |tab| *J* ,
 | |tab| *taylor* ,
 | |tab| *cskip_op* ,
+| |tab| *num_skip_op* ,
 | |tab| *load_op2var* ,
 | |tab| *compare_change_count* ,
 | |tab| *compare_change_number* ,
@@ -124,6 +126,13 @@ Upon return, if *cskip_op* [ *i* ] is true,
 the operator index *i* does not affect any of the dependent variable
 (given the value of the independent variables).
 
+num_skip_op
+***********
+The input value of this argument does not matter.
+Upon return, it is the number of operators that were skipped
+because of the *cskip_op* flags
+(all the operators in an atomic function call are counted).
+
 load_op2var
 ***********
 Is a vector with size *play* ``->num_var_load_rec`` () .
@@ -174,6 +183,7 @@ void forward0(
    size_t                     J,
    Base*                      taylor,
    bool*                      cskip_op,
+   size_t&                    num_skip_op,
    pod_vector<Addr>&          load_op2var,
    size_t                     compare_change_count,
    size_t&                    compare_change_number,
@@ -194,6 +204,9 @@ void forward0(
       compare_change_op_index = 0;
    }
 
+   // initialize the skipped operator counter
+   num_skip_op = 0;
+
    // If this includes a zero calculation, initialize this information
    pod_vector<bool>   vec_ad2isvar;
    pod_vector<size_t> vec_ad2index;
@@ -233,6 +246,10 @@ void forward0(
    // information defined by atomic function operators
    size_t atom_index=0, atom_id=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
    enum_atom_state atom_state = start_atom; // proper initialization
+   //
+   // atomic function calls that are evaluated as batches
+   bool early = true;
+   atom_batch<Base, RecBase> atom_wait(play, true, early, 0);
 
    // length of the parameter vector (used by CppAD assert macros)
    const size_t num_par = play->num_par_rec();
@@ -276,7 +293,8 @@ void forward0(
 
       // check if we are skipping this operation
       while( cskip_op[itr.op_index()] )
-      {  switch(op)
+      {  ++num_skip_op;
+         switch(op)
          {
             case AFunOp:
             {  // get information for this atomic function call
@@ -288,6 +306,7 @@ void forward0(
                // skip to the second AFunOp
                for(size_t i = 0; i < atom_m + atom_n + 1; ++i)
                   ++itr;
+               num_skip_op += atom_m + atom_n + 1;
 # ifndef NDEBUG
                itr.op_info(op, arg, i_var);
                CPPAD_ASSERT_UNKNOWN( op == AFunOp );
@@ -297,6 +316,7 @@ void forward0(
 
             case CSkipOp:
             case CSumOp:
+            case WSumOp:
             itr.correct_before_increment();
             break;
 
@@ -306,6 +326,10 @@ void forward0(
          (++itr).op_info(op, arg, i_var);
       }
 
+      // evaluate the atomic calls that have results used by this operator
+      if( ! atom_wait.empty() && atom_wait.flush_op() <= itr.op_index() )
+         atom_wait.forward_flush(itr.op_index(), J, taylor);
+
       // action to take depends on the case
       switch( op )
       {
@@ -406,6 +430,14 @@ void forward0(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         forward_wsum_op(
+            0, 0, i_var, arg, num_par, parameter, J, taylor
+         );
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
          case DisOp:
          forward_dis_op<RecBase>(p, q, r, i_var, arg, J, taylor);
          break;
@@ -486,6 +518,12 @@ void forward0(
          break;
          // -------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         forward_fma_op_0(op, i_var, arg, parameter, J, taylor);
+         break;
+         // -------------------------------------------------
+
          case InvOp:
          CPPAD_ASSERT_NARG_NRES(op, 0, 1);
          break;
@@ -846,14 +884,28 @@ void forward0(
             for(size_t i = 0; i < atom_m; ++i)
                atom_sy[i] = atom_iy[i] != 0;
             //
-            // call atomic function for this operation
-            call_atomic_forward<Base, RecBase>(
-               atom_par_x, atom_type_x, need_y, atom_sy,
-               order_low, order_up, atom_index, atom_id, atom_tx, atom_ty
+            // atom_call
+            size_t start_op  = itr.op_index() - atom_m - atom_n - 1;
+            size_t atom_call = atom_wait.call_index(start_op);
+            //
+            // check if this call is already in a batch,
+            // or if it can wait and be evaluated in a batch
+            flag = atom_wait.batched(atom_call);
+            if( ! flag ) flag = ! CPPAD_FORWARD0_TRACE &&
+               atom_wait.forward_defer(
+                  atom_call, atom_index, atom_id, atom_sy, atom_tx, atom_iy
             );
-            for(size_t i = 0; i < atom_m; ++i)
-               if( atom_iy[i] > 0 )
-                  taylor[ atom_iy[i] * J + 0 ] = atom_ty[i];
+            if( ! flag )
+            {  // call atomic function for this operation
+               call_atomic_forward<Base, RecBase>(
+                  atom_par_x, atom_type_x, need_y, atom_sy,
+                  order_low, order_up, atom_index, atom_id, atom_tx, atom_ty
+               );
+               for(size_t i = 0; i < atom_m; ++i)
+                  if( atom_iy[i] > 0 )
+                     taylor[ atom_iy[i] * J + 0 ] = atom_ty[i];
+               atom_wait.call_done(atom_call);
+            }
 # if CPPAD_FORWARD0_TRACE
             atom_trace = true;
 # endif
@@ -994,6 +1046,7 @@ void forward0(
    }
 # endif
    CPPAD_ASSERT_UNKNOWN( atom_state == start_atom );
+   CPPAD_ASSERT_UNKNOWN( atom_wait.empty() );
 
    return;
 }
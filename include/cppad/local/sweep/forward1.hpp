@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FORWARD1_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -80,6 +80,12 @@ does not affect any of the dependent variable
 In this case cskip_op is not modified and has the same meaning
 as its return value above.
 
+\param num_skip_op
+The input value of this argument does not matter.
+Upon return, it is the number of operators that were skipped
+because of the cskip_op flags
+(all the operators in an atomic function call are counted).
+
 \param load_op2var
 is a vector with size play->num_var_load_rec().
 \n
@@ -169,6 +175,7 @@ void forward1(
    const size_t               J,
    Base*                      taylor,
    bool*                      cskip_op,
+   size_t&                    num_skip_op,
    pod_vector<Addr>&          load_op2var,
    size_t                     compare_change_count,
    size_t&                    compare_change_number,
@@ -193,6 +200,9 @@ void forward1(
       compare_change_op_index = 0;
    }
 
+   // initialize the skipped operator counter
+   num_skip_op = 0;
+
    // If this includes a zero calculation, initialize this information
    pod_vector<bool>   vec_ad2isvar;
    pod_vector<size_t> vec_ad2index;
@@ -281,7 +291,8 @@ void forward1(
 
       // check if we are skipping this operation
       while( cskip_op[itr.op_index()] )
-      {  switch(op)
+      {  ++num_skip_op;
+         switch(op)
          {
             case AFunOp:
             {  // get information for this atomic function call
@@ -293,6 +304,7 @@ void forward1(
                // skip to the second AFunOp
                for(i = 0; i < atom_m + atom_n + 1; ++i)
                   ++itr;
+               num_skip_op += atom_m + atom_n + 1;
 # ifndef NDEBUG
                itr.op_info(op, arg, i_var);
                CPPAD_ASSERT_UNKNOWN( op == AFunOp );
@@ -302,6 +314,7 @@ void forward1(
 
             case CSkipOp:
             case CSumOp:
+            case WSumOp:
             itr.correct_before_increment();
             break;
 
@@ -411,6 +424,14 @@ void forward1(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         forward_wsum_op(
+            p, q, i_var, arg, num_par, parameter, J, taylor
+         );
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
          case DisOp:
          forward_dis_op<RecBase>(p, q, r, i_var, arg, J, taylor);
          break;
@@ -489,6 +510,12 @@ void forward1(
          break;
          // ---------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         forward_fma_op(p, q, op, i_var, arg, parameter, J, taylor);
+         break;
+         // -------------------------------------------------
+
          case InvOp:
          CPPAD_ASSERT_NARG_NRES(op, 0, 1);
          break;
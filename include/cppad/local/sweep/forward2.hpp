@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FORWARD2_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -212,6 +212,7 @@ void forward2(
 
             case CSkipOp:
             case CSumOp:
+            case WSumOp:
             itr.correct_before_increment();
             break;
 
@@ -318,6 +319,14 @@ void forward2(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         forward_wsum_op_dir(
+            q, r, i_var, arg, num_par, parameter, J, taylor
+         );
+         itr.correct_before_increment();
+         break;
+         // -------------------------------------------------
+
          case DisOp:
          forward_dis_op<RecBase>(p, q, r, i_var, arg, J, taylor);
          break;
@@ -363,6 +372,12 @@ void forward2(
          break;
          // -------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         forward_fma_op_dir(q, r, op, i_var, arg, parameter, J, taylor);
+         break;
+         // -------------------------------------------------
+
          case InvOp:
          CPPAD_ASSERT_NARG_NRES(op, 0, 1);
          break;
@@ -0,0 +1,277 @@
+# ifndef CPPAD_LOCAL_SWEEP_HES_EDGE_HPP
+# define CPPAD_LOCAL_SWEEP_HES_EDGE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <map>
+# include <cppad/local/sweep/op_partial.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/hes_edge.hpp
+Compute a sparse Hessian using the edge pushing algorithm.
+*/
+
+/*!
+Symmetric sparse matrix with one row for each variable on the tape.
+
+Each off diagonal entry is stored in both its row and its column so that
+the neighbors of a variable can be found without a search.
+*/
+template <class Base>
+class hes_edge_matrix {
+public:
+   /// the type used for one row of the matrix
+   typedef std::map<size_t, Base> row_type;
+private:
+   /// rows of the matrix
+   CppAD::vector<row_type> row_;
+public:
+   /// constructor
+   hes_edge_matrix(size_t n_row) : row_(n_row)
+   { }
+   /// row i of the matrix
+   row_type& row(size_t i)
+   {  return row_[i]; }
+   /// add value to entry (i, j) and (j, i); i.e., a structural non-zero
+   void add(size_t i, size_t j, const Base& value)
+   {  row_[i][j] += value;
+      if( i != j )
+         row_[j][i] += value;
+   }
+   /// remove row and column i and return row i
+   void remove(size_t i, row_type& row_i)
+   {  row_i.clear();
+      row_i.swap( row_[i] );
+      typename row_type::const_iterator itr;
+      for(itr = row_i.begin(); itr != row_i.end(); ++itr)
+         if( itr->first != i )
+            row_[itr->first].erase(i);
+   }
+};
+
+/*!
+Edge pushing reverse sweep that computes the Hessian of a weighted sum
+of the dependent variables with respect to the independent variables.
+
+For each operator z = phi(u) in reverse order, the row corresponding
+to z in the current Hessian W is pushed to its arguments using the first
+partials of phi, the second partials of phi times the adjoint of z are
+created, and then the adjoint of z is pushed to its arguments.
+This only requires zero order Taylor coefficients and one reverse sweep.
+
+\tparam Addr
+type used for addresses in the recording.
+
+\tparam Base
+this operation sequence was recorded using AD<Base>.
+
+\param play
+is the recording. The operations in the recording must be standard
+math functions, arithmetic operators, conditional expressions,
+cumulative sums, discrete functions, comparisons, and print operators;
+i.e., VecAD and atomic function operations are not supported.
+
+\param cap_order
+is the maximum number of orders that will fit in taylor.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables
+corresponding to the current independent variable values.
+
+\param cskip_op
+Is a vector with size play->num_op_rec().
+If cskip_op[i] is true, the operator index i in the recording
+does not affect any of the dependent variable.
+
+\param adjoint [in/out]
+On input, it is the weight for each variable; i.e., non-zero only for
+the dependent variables. On output, the values are not specified.
+
+\param adj_nz [in/out]
+On input, it is true for the variables that have a structurally non-zero
+weight. On output, the values are not specified.
+
+\param hes [in/out]
+On input, it is the zero matrix.
+On output, the rows corresponding to the independent variables contain the
+Hessian with respect to the independent variables. The other rows are empty.
+
+\param not_used_rec_base
+Specifies RecBase for this call.
+*/
+template <class Addr, class Base, class RecBase>
+void hes_edge(
+   const local::player<Base>* play              ,
+   size_t                     cap_order         ,
+   const Base*                taylor            ,
+   const bool*                cskip_op          ,
+   CppAD::vector<Base>&       adjoint           ,
+   CppAD::vector<bool>&       adj_nz            ,
+   hes_edge_matrix<Base>&     hes               ,
+   const RecBase&             not_used_rec_base )
+{  //
+   // parameter
+   const Base* parameter = play->GetPar();
+   //
+   // zero, two
+   const Base zero(0.0), two(2.0);
+   //
+   // row_z
+   typename hes_edge_matrix<Base>::row_type row_z;
+   //
+   // u, a
+   // variable arguments and corresponding first partials for an operator
+   CppAD::vector<size_t> u;
+   CppAD::vector<Base>   a;
+   //
+   // skip the EndOp at the end of the recording
+   play::const_sequential_iterator itr = play->end();
+   OpCode        op;
+   size_t        i_var;
+   const Addr*   arg;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == EndOp );
+   while( op != BeginOp )
+   {  //
+      // next op
+      (--itr).op_info(op, arg, i_var);
+      //
+      // check if we are skipping this operation
+      size_t i_op = itr.op_index();
+      while( cskip_op[i_op] )
+      {  CPPAD_ASSERT_KNOWN( op != AFunOp,
+            "sparse_hes_edge: atomic functions are not supported"
+         );
+         if( op == CSumOp || op == CSkipOp || op == WSumOp )
+            itr.correct_after_decrement(arg);
+         (--itr).op_info(op, arg, i_var);
+         i_op = itr.op_index();
+      }
+      //
+      // arg
+      if( op == CSumOp || op == CSkipOp || op == WSumOp )
+         itr.correct_after_decrement(arg);
+      //
+      // u, a, h, h_nz
+      // h[0], h[1], h[2] are the second partials with respect to
+      // (u[0], u[0]), (u[0], u[1]), (u[1], u[1]).
+      // If n_u is three, op is FmavvvOp and h[1] is the only non-zero.
+      // If op is WSumOp, h is zero (see creating below).
+      Base h[3];
+      bool h_nz[3];
+      if( ! op_partial(
+         op, arg, i_var, cap_order, taylor, parameter, u, a, h, h_nz
+      ) )
+      {  CPPAD_ASSERT_KNOWN( false,
+            "sparse_hes_edge: tape contains a VecAD or atomic function "
+            "operation and these are not supported."
+         );
+      }
+      //
+      // check for case where there is nothing to do
+      size_t n_u = u.size();
+      // (the rows for the independent variables are the result)
+      if( n_u == 0 )
+      {  if( NumRes(op) > 0 && op != InvOp )
+            hes.remove(i_var, row_z);
+         continue;
+      }
+      //
+      // combine repeated arguments; e.g., x * x
+      if( n_u == 2 && u[0] == u[1] && op != WSumOp )
+      {  a[0]    = a[0] + a[1];
+         h[0]    = h[0] + two * h[1] + h[2];
+         h_nz[0] = h_nz[0] || h_nz[1] || h_nz[2];
+         n_u     = 1;
+         u.resize(1);
+         a.resize(1);
+      }
+      else if( (n_u > 2 && op != FmavvvOp) || op == WSumOp )
+      {  // linear operator or WSumOp, sort arguments and combine repeats
+         CPPAD_ASSERT_UNKNOWN( ! (h_nz[0] || h_nz[1] || h_nz[2]) );
+         std::map<size_t, Base> combine;
+         for(size_t k = 0; k < n_u; ++k)
+            combine[ u[k] ] += a[k];
+         u.resize(0);
+         a.resize(0);
+         typename std::map<size_t, Base>::const_iterator c_itr;
+         for(c_itr = combine.begin(); c_itr != combine.end(); ++c_itr)
+         {  u.push_back( c_itr->first );
+            a.push_back( c_itr->second );
+         }
+         n_u = u.size();
+      }
+      //
+      // row_z, w_zz
+      hes.remove(i_var, row_z);
+      bool w_zz_nz = row_z.find(i_var) != row_z.end();
+      Base w_zz    = zero;
+      if( w_zz_nz )
+         w_zz = row_z[i_var];
+      //
+      // pushing: off diagonal entries in row z
+      typename hes_edge_matrix<Base>::row_type::const_iterator r_itr;
+      for(r_itr = row_z.begin(); r_itr != row_z.end(); ++r_itr)
+      {  size_t p = r_itr->first;
+         if( p != i_var )
+         {  for(size_t j = 0; j < n_u; ++j)
+            {  if( u[j] == p )
+                  hes.add(p, p, two * a[j] * r_itr->second);
+               else
+                  hes.add(u[j], p, a[j] * r_itr->second);
+            }
+         }
+      }
+      //
+      // pushing: diagonal entry, creating: second partials times adjoint
+      Base adj_z    = adjoint[i_var];
+      bool adj_z_nz = adj_nz[i_var];
+      for(size_t j = 0; j < n_u; ++j)
+      {  for(size_t k = j; k < n_u; ++k)
+         {  // index in h
+            size_t jk = j + k;
+            bool   nz = w_zz_nz;
+            Base value = zero;
+            if( w_zz_nz )
+               value = a[j] * a[k] * w_zz;
+            if( adj_z_nz && jk < 3 && h_nz[jk] )
+            {  nz     = true;
+               value += adj_z * h[jk];
+            }
+            if( nz )
+               hes.add(u[j], u[k], value);
+         }
+      }
+      //
+      // creating: WSumOp second partials times adjoint
+      if( op == WSumOp && adj_z_nz )
+      {  for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+         {  size_t i_u = size_t(arg[i]);
+            size_t i_v = size_t(arg[i+1]);
+            Base value = adj_z;
+            if( i >= size_t(arg[2]) )
+               value = - value;
+            if( i_u == i_v )
+               value = two * value;
+            hes.add(i_u, i_v, value);
+         }
+      }
+      //
+      // adjoint
+      if( adj_z_nz )
+      {  for(size_t j = 0; j < n_u; ++j)
+         {  adjoint[ u[j] ] += a[j] * adj_z;
+            adj_nz[ u[j] ]   = true;
+         }
+      }
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -0,0 +1,206 @@
+# ifndef CPPAD_LOCAL_SWEEP_JAC_TANGENT_HPP
+# define CPPAD_LOCAL_SWEEP_JAC_TANGENT_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/sparse/list_setvec.hpp>
+# include <cppad/local/sweep/op_partial.hpp>
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/jac_tangent.hpp
+Compute a sparse Jacobian using forward mode with sparse tangent vectors.
+*/
+
+/*!
+Forward sweep that computes the derivative of every variable with respect
+to the independent variables as a sparse vector.
+
+The index part of the derivative for each variable is a set in var_set
+and the corresponding values are stored in val (in the same order as
+the elements of the set). For each operator z = phi(u),
+the set for z is the union of the sets for its variable arguments
+and the derivative of z is the sum of the partials of phi times the
+derivatives of its arguments. Conditional expressions only use the
+branch that is selected, so the sparsity pattern can change with the
+value of the independent variables.
+This only requires zero order Taylor coefficients and one forward sweep.
+
+\tparam Addr
+type used for addresses in the recording.
+
+\tparam Base
+this operation sequence was recorded using AD<Base>.
+
+\param n
+is the number of independent variables on the tape.
+
+\param play
+is the recording. The operations in the recording must be standard
+math functions, arithmetic operators, conditional expressions,
+cumulative sums, discrete functions, comparisons, and print operators;
+i.e., VecAD and atomic function operations are not supported.
+
+\param cap_order
+is the maximum number of orders that will fit in taylor.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables
+corresponding to the current independent variable values.
+
+\param cskip_op
+Is a vector with size play->num_op_rec().
+If cskip_op[i] is true, the operator index i in the recording
+does not affect any of the dependent variable.
+
+\param var_set [out]
+The input value does not matter. Upon return,
+var_set.n_set() is the number of variables in the recording,
+var_set.end() is n, and the set with index i is the sparsity pattern for
+the derivative of the variable with index i.
+
+\param val_start [out]
+The input value does not matter. Upon return, it has size equal to the
+number of variables in the recording and the values for the derivative
+of the variable with index i start at val[ val_start[i] ].
+
+\param val [out]
+The input value does not matter. Upon return it contains
+the derivative values for all the variables.
+
+\param not_used_rec_base
+Specifies RecBase for this call.
+*/
+template <class Addr, class Base, class RecBase>
+void jac_tangent(
+   size_t                        n                 ,
+   const local::player<Base>*    play              ,
+   size_t                        cap_order         ,
+   const Base*                   taylor            ,
+   const bool*                   cskip_op          ,
+   sparse::list_setvec&          var_set           ,
+   pod_vector<size_t>&           val_start         ,
+   pod_vector_maybe<Base>&       val               ,
+   const RecBase&                not_used_rec_base )
+{  //
+   // num_var
+   size_t num_var = play->num_var_rec();
+   //
+   // parameter
+   const Base* parameter = play->GetPar();
+   //
+   // var_set, val_start, val
+   var_set.resize(num_var, n);
+   val_start.resize(num_var);
+   val.resize(0);
+   for(size_t i = 0; i < num_var; ++i)
+      val_start[i] = 0;
+   //
+   // work
+   // dense accumulator for the derivative of one variable
+   pod_vector_maybe<Base> work(n);
+   for(size_t j = 0; j < n; ++j)
+      work[j] = Base(0.0);
+   //
+   // u, a, h, h_nz
+   CppAD::vector<size_t> u;
+   CppAD::vector<Base>   a;
+   Base                  h[3];
+   bool                  h_nz[3];
+   //
+   // skip the BeginOp at the beginning of the recording
+   play::const_sequential_iterator itr = play->begin();
+   OpCode        op;
+   size_t        i_var;
+   const Addr*   arg;
+   itr.op_info(op, arg, i_var);
+   CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+   bool more_operators = true;
+   while( more_operators )
+   {  //
+      // next op
+      (++itr).op_info(op, arg, i_var);
+      //
+      // check if we are skipping this operation
+      while( cskip_op[itr.op_index()] )
+      {  CPPAD_ASSERT_KNOWN( op != AFunOp,
+            "sparse_jac_tangent: atomic functions are not supported"
+         );
+         if( op == CSumOp || op == CSkipOp || op == WSumOp )
+            itr.correct_before_increment();
+         (++itr).op_info(op, arg, i_var);
+      }
+      //
+      // u, a
+      switch( op )
+      {  case EndOp:
+         more_operators = false;
+         u.resize(0);
+         break;
+
+         case InvOp:
+         // independent variable i_var - 1
+         CPPAD_ASSERT_UNKNOWN( 0 < i_var && i_var <= n );
+         var_set.add_element(i_var, i_var - 1);
+         val_start[i_var] = val.extend(1);
+         val[ val_start[i_var] ] = Base(1.0);
+         u.resize(0);
+         break;
+
+         default:
+         if( ! op_partial(
+            op, arg, i_var, cap_order, taylor, parameter, u, a, h, h_nz
+         ) )
+         {  CPPAD_ASSERT_KNOWN( false,
+               "sparse_jac_tangent: tape contains a VecAD or atomic function "
+               "operation and these are not supported."
+            );
+         }
+         if( op == CSumOp || op == CSkipOp || op == WSumOp )
+            itr.correct_before_increment();
+         break;
+      }
+      size_t n_u = u.size();
+      if( n_u > 0 )
+      {  //
+         // var_set: pattern for z
+         if( n_u == 1 )
+            var_set.assignment(i_var, u[0], var_set);
+         else
+         {  var_set.binary_union(i_var, u[0], u[1], var_set);
+            for(size_t k = 2; k < n_u; ++k)
+               var_set.binary_union(i_var, i_var, u[k], var_set);
+         }
+         //
+         // work: derivative of z
+         for(size_t k = 0; k < n_u; ++k)
+         {  sparse::list_setvec_const_iterator set_itr(var_set, u[k]);
+            size_t ell = val_start[ u[k] ];
+            size_t j   = *set_itr;
+            while( j < n )
+            {  work[j] += a[k] * val[ell++];
+               j = *(++set_itr);
+            }
+         }
+         //
+         // val_start, val
+         val_start[i_var] = val.size();
+         sparse::list_setvec_const_iterator set_itr(var_set, i_var);
+         size_t j = *set_itr;
+         while( j < n )
+         {  val.push_back( work[j] );
+            work[j] = Base(0.0);
+            j = *(++set_itr);
+         }
+      }
+   }
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
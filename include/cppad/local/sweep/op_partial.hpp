@@ -0,0 +1,508 @@
+# ifndef CPPAD_LOCAL_SWEEP_OP_PARTIAL_HPP
+# define CPPAD_LOCAL_SWEEP_OP_PARTIAL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+// BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+/*!
+\file sweep/op_partial.hpp
+First and second partials of one operator using zero order Taylor coefficients.
+*/
+
+/*!
+Compute the partials of the primary result of an operator with respect
+to its variable arguments.
+
+\tparam Addr
+type used for addresses in the recording.
+
+\tparam Base
+this operation sequence was recorded using AD<Base>.
+
+\param op [in]
+is the operator.
+
+\param arg [in]
+is the argument vector for this operator. If op is CSumOp or WSumOp,
+it must have been corrected; see correct_before_increment and
+correct_after_decrement.
+
+\param i_var [in]
+is the index of the primary result for this operator
+(not used if the operator does not have a result).
+
+\param cap_order [in]
+is the maximum number of orders that will fit in taylor.
+
+\param taylor [in]
+contains the zero order Taylor coefficients for the variables
+up to and including the results for this operator.
+
+\param parameter [in]
+is the parameter vector for this recording.
+
+\param u [out]
+is the variable arguments for this operator. If u.size() is zero,
+the result does not depend on any variables.
+If u.size() > 2 the operator is linear, FmavvvOp, or WSumOp.
+A variable may appear twice in u; e.g., x * x.
+If op is FmavvvOp and u.size() is three, the elements of u are distinct.
+
+\param a [out]
+has the same size as u and a[j] is the partial of the result
+with respect to u[j]. For conditional expressions, only the branch
+that is selected by the current Taylor coefficients is included in u.
+
+\param h [out]
+is a vector of size three.
+If u.size() is one, h[0] is the second partial with respect to u[0].
+If u.size() is two, h[0], h[1], h[2] are the second partials with respect to
+(u[0], u[0]), (u[0], u[1]), and (u[1], u[1]) respectively.
+If u.size() is three (op is FmavvvOp), h[1] is the second partial with
+respect to (u[0], u[1]) and all the other second partials are zero.
+If op is WSumOp, h is zero and the caller must use the variable variable
+pairs in arg for the second partials.
+
+\param h_nz [out]
+is a vector of size three that identifies which components of h
+are structurally non-zero.
+
+\return
+is false if this operator is not supported; i.e., it is a VecAD or
+atomic function operator. Otherwise it is true.
+*/
+template <class Addr, class Base>
+bool op_partial(
+   OpCode                     op        ,
+   const Addr*                arg       ,
+   size_t                     i_var     ,
+   size_t                     cap_order ,
+   const Base*                taylor    ,
+   const Base*                parameter ,
+   CppAD::vector<size_t>&     u         ,
+   CppAD::vector<Base>&       a         ,
+   Base*                      h         ,
+   bool*                      h_nz      )
+{  //
+   // zero, one, two
+   const Base zero(0.0), one(1.0), two(2.0);
+   //
+   // u, a, h, h_nz
+   u.resize(0);
+   a.resize(0);
+   for(size_t k = 0; k < 3; ++k)
+   {  h[k]    = zero;
+      h_nz[k] = false;
+   }
+   //
+   // x, y, z
+   // first argument, second argument, and result zero order values
+   Base x = zero, y = zero, z = zero;
+   if( NumRes(op) > 0 )
+      z = taylor[ i_var * cap_order ];
+   //
+   switch( op )
+   {  // ----------------------------------------------------------------
+      // operators that do not have a result or derivative
+      case BeginOp:
+      case EndOp:
+      case InvOp:
+      case DisOp:
+      case ParOp:
+      case SignOp:
+      case PriOp:
+      case EqppOp:
+      case EqpvOp:
+      case EqvvOp:
+      case LeppOp:
+      case LepvOp:
+      case LevpOp:
+      case LevvOp:
+      case LtppOp:
+      case LtpvOp:
+      case LtvpOp:
+      case LtvvOp:
+      case NeppOp:
+      case NepvOp:
+      case NevvOp:
+      case CSkipOp:
+      break;
+      // ----------------------------------------------------------------
+      // linear operators
+      case CSumOp:
+      for(size_t i = 5; i < size_t(arg[1]); ++i)
+      {  u.push_back( size_t(arg[i]) );
+         a.push_back( one );
+      }
+      for(size_t i = size_t(arg[1]); i < size_t(arg[2]); ++i)
+      {  u.push_back( size_t(arg[i]) );
+         a.push_back( - one );
+      }
+      break;
+
+      case WSumOp:
+      for(size_t i = 4; i < size_t(arg[1]); i += 2)
+      {  u.push_back( size_t(arg[i+1]) );
+         if( i < size_t(arg[0]) )
+            a.push_back( parameter[ arg[i] ] );
+         else
+            a.push_back( - parameter[ arg[i] ] );
+      }
+      for(size_t i = size_t(arg[1]); i < size_t(arg[3]); i += 2)
+      {  x = taylor[ size_t(arg[i])   * cap_order ];
+         y = taylor[ size_t(arg[i+1]) * cap_order ];
+         u.push_back( size_t(arg[i]) );
+         u.push_back( size_t(arg[i+1]) );
+         if( i < size_t(arg[2]) )
+         {  a.push_back( y );
+            a.push_back( x );
+         }
+         else
+         {  a.push_back( - y );
+            a.push_back( - x );
+         }
+      }
+      break;
+
+      case CExpOp:
+      {  Base left, right;
+         if( arg[1] & 1 )
+            left = taylor[ size_t(arg[2]) * cap_order ];
+         else
+            left = parameter[ arg[2] ];
+         if( arg[1] & 2 )
+            right = taylor[ size_t(arg[3]) * cap_order ];
+         else
+            right = parameter[ arg[3] ];
+         // only the branch that is selected is included in the pattern
+         Base flag = CondExpOp(CompareOp(arg[0]), left, right, one, zero);
+         if( flag == one && (arg[1] & 4) )
+         {  u.push_back( size_t(arg[4]) );
+            a.push_back( one );
+         }
+         if( flag == zero && (arg[1] & 8) )
+         {  u.push_back( size_t(arg[5]) );
+            a.push_back( one );
+         }
+      }
+      break;
+
+      case AddvvOp:
+      u.push_back( size_t(arg[0]) );
+      u.push_back( size_t(arg[1]) );
+      a.push_back( one );
+      a.push_back( one );
+      break;
+
+      case SubvvOp:
+      u.push_back( size_t(arg[0]) );
+      u.push_back( size_t(arg[1]) );
+      a.push_back( one );
+      a.push_back( - one );
+      break;
+
+      case AddpvOp:
+      u.push_back( size_t(arg[1]) );
+      a.push_back( one );
+      break;
+
+      case SubpvOp:
+      u.push_back( size_t(arg[1]) );
+      a.push_back( - one );
+      break;
+
+      case SubvpOp:
+      u.push_back( size_t(arg[0]) );
+      a.push_back( one );
+      break;
+
+      case NegOp:
+      u.push_back( size_t(arg[0]) );
+      a.push_back( - one );
+      break;
+
+      case AbsOp:
+      x = taylor[ size_t(arg[0]) * cap_order ];
+      u.push_back( size_t(arg[0]) );
+      a.push_back( sign(x) );
+      break;
+
+      case MulpvOp:
+      case ZmulpvOp:
+      u.push_back( size_t(arg[1]) );
+      a.push_back( parameter[ arg[0] ] );
+      break;
+
+      case DivvpOp:
+      u.push_back( size_t(arg[0]) );
+      a.push_back( one / parameter[ arg[1] ] );
+      break;
+
+      case ZmulvpOp:
+      u.push_back( size_t(arg[0]) );
+      a.push_back( parameter[ arg[1] ] );
+      break;
+      // ----------------------------------------------------------------
+      // binary operators that are not linear
+      case MulvvOp:
+      case ZmulvvOp:
+      x = taylor[ size_t(arg[0]) * cap_order ];
+      y = taylor[ size_t(arg[1]) * cap_order ];
+      u.push_back( size_t(arg[0]) );
+      u.push_back( size_t(arg[1]) );
+      a.push_back( y );
+      a.push_back( x );
+      h[1]    = one;
+      h_nz[1] = true;
+      break;
+
+      case FmavvpOp:
+      x = taylor[ size_t(arg[0]) * cap_order ];
+      y = taylor[ size_t(arg[1]) * cap_order ];
+      u.push_back( size_t(arg[0]) );
+      u.push_back( size_t(arg[1]) );
+      a.push_back( y );
+      a.push_back( x );
+      h[1]    = one;
+      h_nz[1] = true;
+      break;
+
+      case FmavvvOp:
+      x = taylor[ size_t(arg[0]) * cap_order ];
+      y = taylor[ size_t(arg[1]) * cap_order ];
+      if( arg[0] == arg[1] )
+      {  // z = x * x + c
+         u.push_back( size_t(arg[0]) );
+         a.push_back( two * x );
+         h[0]    = two;
+         h_nz[0] = true;
+         if( arg[2] == arg[0] )
+            a[0] += one;
+         else
+         {  u.push_back( size_t(arg[2]) );
+            a.push_back( one );
+         }
+      }
+      else
+      {  u.push_back( size_t(arg[0]) );
+         u.push_back( size_t(arg[1]) );
+         a.push_back( y );
+         a.push_back( x );
+         h[1]    = one;
+         h_nz[1] = true;
+         if( arg[2] == arg[0] )
+            a[0] += one;
+         else if( arg[2] == arg[1] )
+            a[1] += one;
+         else
+         {  u.push_back( size_t(arg[2]) );
+            a.push_back( one );
+         }
+      }
+      break;
+
+      case DivvvOp:
+      x = taylor[ size_t(arg[0]) * cap_order ];
+      y = taylor[ size_t(arg[1]) * cap_order ];
+      u.push_back( size_t(arg[0]) );
+      u.push_back( size_t(arg[1]) );
+      a.push_back( one / y );
+      a.push_back( - z / y );
+      h[1]    = - one / (y * y);
+      h[2]    = two * z / (y * y);
+      h_nz[1] = h_nz[2] = true;
+      break;
+
+      case DivpvOp:
+      y = taylor[ size_t(arg[1]) * cap_order ];
+      u.push_back( size_t(arg[1]) );
+      a.push_back( - z / y );
+      h[0]    = two * z / (y * y);
+      h_nz[0] = true;
+      break;
+
+      case PowvvOp:
+      {  x = taylor[ size_t(arg[0]) * cap_order ];
+         y = taylor[ size_t(arg[1]) * cap_order ];
+         Base log_x = log(x);
+         Base p1    = pow(x, y - one);
+         u.push_back( size_t(arg[0]) );
+         u.push_back( size_t(arg[1]) );
+         a.push_back( y * p1 );
+         a.push_back( z * log_x );
+         h[0]    = y * (y - one) * pow(x, y - two);
+         h[1]    = p1 * (one + y * log_x);
+         h[2]    = z * log_x * log_x;
+         h_nz[0] = h_nz[1] = h_nz[2] = true;
+      }
+      break;
+
+      case PowpvOp:
+      {  Base log_p = log( parameter[ arg[0] ] );
+         u.push_back( size_t(arg[1]) );
+         a.push_back( z * log_p );
+         h[0]    = z * log_p * log_p;
+         h_nz[0] = true;
+      }
+      break;
+
+      case PowvpOp:
+      {  x = taylor[ size_t(arg[0]) * cap_order ];
+         Base p = parameter[ arg[1] ];
+         u.push_back( size_t(arg[0]) );
+         a.push_back( p * pow(x, p - one) );
+         h[0]    = p * (p - one) * pow(x, p - two);
+         h_nz[0] = true;
+      }
+      break;
+      // ----------------------------------------------------------------
+      // unary operators that are not linear
+      case AcosOp:
+      case AcoshOp:
+      case AsinOp:
+      case AsinhOp:
+      case AtanOp:
+      case AtanhOp:
+      case CosOp:
+      case CoshOp:
+      case ErfOp:
+      case ErfcOp:
+      case ExpOp:
+      case Expm1Op:
+      case LogOp:
+      case Log1pOp:
+      case SinOp:
+      case SinhOp:
+      case SqrtOp:
+      case TanOp:
+      case TanhOp:
+      {  x = taylor[ size_t(arg[0]) * cap_order ];
+         Base d1 = zero, d2 = zero;
+         switch( op )
+         {  case AcosOp:
+            // d/dx acos(x) = - 1 / sqrt(1 - x * x)
+            y  = one - x * x;
+            d1 = - one / sqrt(y);
+            d2 = d1 * x / y;
+            break;
+
+            case AcoshOp:
+            // d/dx acosh(x) = 1 / sqrt(x * x - 1)
+            y  = x * x - one;
+            d1 = one / sqrt(y);
+            d2 = - d1 * x / y;
+            break;
+
+            case AsinOp:
+            // d/dx asin(x) = 1 / sqrt(1 - x * x)
+            y  = one - x * x;
+            d1 = one / sqrt(y);
+            d2 = d1 * x / y;
+            break;
+
+            case AsinhOp:
+            // d/dx asinh(x) = 1 / sqrt(1 + x * x)
+            y  = one + x * x;
+            d1 = one / sqrt(y);
+            d2 = - d1 * x / y;
+            break;
+
+            case AtanOp:
+            // d/dx atan(x) = 1 / (1 + x * x)
+            d1 = one / (one + x * x);
+            d2 = - two * x * d1 * d1;
+            break;
+
+            case AtanhOp:
+            // d/dx atanh(x) = 1 / (1 - x * x)
+            d1 = one / (one - x * x);
+            d2 = two * x * d1 * d1;
+            break;
+
+            case CosOp:
+            d1 = - sin(x);
+            d2 = - z;
+            break;
+
+            case CoshOp:
+            d1 = sinh(x);
+            d2 = z;
+            break;
+
+            case ErfOp:
+            case ErfcOp:
+            // arg[2] is the parameter 2 / sqrt(pi)
+            d1 = parameter[ arg[2] ] * exp( - x * x );
+            if( op == ErfcOp )
+               d1 = - d1;
+            d2 = - two * x * d1;
+            break;
+
+            case ExpOp:
+            d1 = d2 = z;
+            break;
+
+            case Expm1Op:
+            d1 = d2 = z + one;
+            break;
+
+            case LogOp:
+            d1 = one / x;
+            d2 = - d1 * d1;
+            break;
+
+            case Log1pOp:
+            d1 = one / (one + x);
+            d2 = - d1 * d1;
+            break;
+
+            case SinOp:
+            d1 = cos(x);
+            d2 = - z;
+            break;
+
+            case SinhOp:
+            d1 = cosh(x);
+            d2 = z;
+            break;
+
+            case SqrtOp:
+            d1 = one / (two * z);
+            d2 = - d1 / (two * x);
+            break;
+
+            case TanOp:
+            d1 = one + z * z;
+            d2 = two * z * d1;
+            break;
+
+            case TanhOp:
+            d1 = one - z * z;
+            d2 = - two * z * d1;
+            break;
+
+            default:
+            CPPAD_ASSERT_UNKNOWN(false);
+            break;
+         }
+         u.push_back( size_t(arg[0]) );
+         a.push_back( d1 );
+         h[0]    = d2;
+         h_nz[0] = true;
+      }
+      break;
+      // ----------------------------------------------------------------
+      // VecAD and atomic function operators
+      default:
+      return false;
+   }
+
+   return true;
+}
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
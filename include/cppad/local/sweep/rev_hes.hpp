@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_REV_HES_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -293,6 +293,14 @@ void rev_hes(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         itr.correct_after_decrement(arg);
+         reverse_sparse_hessian_wsum_op(
+            i_var, arg, RevJac, for_jac_sparse, rev_hes_sparse
+         );
+         break;
+         // -------------------------------------------------
+
          case CExpOp:
          reverse_sparse_hessian_cond_op(
             i_var, arg, num_par, RevJac, rev_hes_sparse
@@ -375,6 +383,22 @@ void rev_hes(
          break;
          // -------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         CPPAD_ASSERT_NARG_NRES(op, 3, 1)
+         if( op == FmavvvOp && RevJac[i_var] )
+         {  // the term c is linear in z = a * b + c
+            rev_hes_sparse.binary_union(
+               size_t(arg[2]), size_t(arg[2]), i_var, rev_hes_sparse
+            );
+            RevJac[ arg[2] ] = true;
+         }
+         sparse::rev_hes_mul_op(
+         i_var, arg, RevJac, for_jac_sparse, rev_hes_sparse
+         );
+         break;
+         // -------------------------------------------------
+
          case InvOp:
          CPPAD_ASSERT_NARG_NRES(op, 0, 1)
          // Z is already defined
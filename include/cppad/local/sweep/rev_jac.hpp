@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_REV_JAC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -308,6 +308,14 @@ void rev_jac(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         itr.correct_after_decrement(arg);
+         reverse_sparse_jacobian_wsum_op(
+            i_var, arg, var_sparsity
+         );
+         break;
+         // -------------------------------------------------
+
          case CExpOp:
          reverse_sparse_jacobian_cond_op(
             dependency, i_var, arg, num_par, var_sparsity
@@ -393,6 +401,20 @@ void rev_jac(
          break;
          // -------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         CPPAD_ASSERT_NARG_NRES(op, 3, 1);
+         sparse::rev_jac_binary_op(
+            i_var, arg, var_sparsity
+         );
+         if( op == FmavvvOp )
+         {  var_sparsity.binary_union(
+               size_t(arg[2]), size_t(arg[2]), i_var, var_sparsity
+            );
+         }
+         break;
+         // -------------------------------------------------
+
          case InvOp:
          CPPAD_ASSERT_NARG_NRES(op, 0, 1);
          break;
@@ -2,11 +2,13 @@
 # define CPPAD_LOCAL_SWEEP_REVERSE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 
 # include <cppad/local/play/atom_op_info.hpp>
+# include <type_traits>
+# include <cppad/local/sweep/atom_batch.hpp>
 
 // BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
@@ -203,6 +205,12 @@ void reverse(
    // information defined by atomic forward
    size_t atom_index=0, atom_old=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
    enum_atom_state atom_state = end_atom; // proper initialization
+   //
+   // atomic function calls that are evaluated as batches
+   // (calls can only be evaluated before they are reached when
+   // the sweep is not restricted to a subgraph)
+   bool early = std::is_same<Iterator, play::const_sequential_iterator>::value;
+   atom_batch<Base, RecBase> atom_wait(play, false, early, d);
 
    // A vector with unspecified contents declared here so that operator
    // routines do not need to re-allocate it
@@ -246,12 +254,24 @@ void reverse(
             }
             break;
 
+            // operators with a variable number of arguments
+            case CSkipOp:
+            case CSumOp:
+            case WSumOp:
+            play_itr.correct_after_decrement(arg);
+            break;
+
             default:
             break;
          }
          (--play_itr).op_info(op, arg, i_var);
          i_op = play_itr.op_index();
       }
+      //
+      // evaluate the atomic calls that have arguments defined by this
+      // operator (or an operator with a smaller index)
+      if( ! atom_wait.empty() && i_op <= atom_wait.flush_op() )
+         atom_wait.reverse_flush(i_op, J, Taylor, K, Partial);
 # if CPPAD_REVERSE_TRACE
       size_t       i_tmp  = i_var;
       const Base*  Z_tmp  = Taylor + i_var * J;
@@ -372,6 +392,14 @@ void reverse(
          break;
          // -------------------------------------------------
 
+         case WSumOp:
+         play_itr.correct_after_decrement(arg);
+         reverse_wsum_op(
+            d, i_var, arg, parameter, J, Taylor, K, Partial
+         );
+         break;
+         // -------------------------------------------------
+
          case CExpOp:
          reverse_cond_op(
             d,
@@ -461,6 +489,14 @@ void reverse(
          break;
          // --------------------------------------------------
 
+         case FmavvpOp:
+         case FmavvvOp:
+         reverse_fma_op(
+            d, op, i_var, arg, parameter, J, Taylor, K, Partial
+         );
+         break;
+         // --------------------------------------------------
+
          case InvOp:
          break;
          // --------------------------------------------------
@@ -675,23 +711,36 @@ void reverse(
             CPPAD_ASSERT_UNKNOWN( atom_j == 0  );
             atom_state = end_atom;
             //
-            // call atomic function for this operation
-            call_atomic_reverse<Base, RecBase>(
-               atom_par_x,
-               atom_type_x,
-               atom_sx,
-               atom_k,
-               atom_index,
-               atom_old,
-               atom_tx,
-               atom_ty,
-               atom_px,
-               atom_py
+            // atom_call
+            size_t atom_call = atom_wait.call_index(i_op);
+            //
+            // check if this call is already in a batch,
+            // or if it can wait and be evaluated in a batch
+            flag = atom_wait.batched(atom_call);
+            if( ! flag ) flag = ! CPPAD_REVERSE_TRACE &&
+               atom_wait.reverse_defer(atom_call, atom_index, atom_old,
+                  atom_sx, atom_tx, atom_ty, atom_py, atom_ix
             );
-            for(j = 0; j < atom_n; j++) if( atom_ix[j] > 0 )
-            {  for(ell = 0; ell < atom_k1; ell++)
-                  Partial[atom_ix[j] * K + ell] +=
-                     atom_px[j * atom_k1 + ell];
+            if( ! flag )
+            {  // call atomic function for this operation
+               call_atomic_reverse<Base, RecBase>(
+                  atom_par_x,
+                  atom_type_x,
+                  atom_sx,
+                  atom_k,
+                  atom_index,
+                  atom_old,
+                  atom_tx,
+                  atom_ty,
+                  atom_px,
+                  atom_py
+               );
+               for(j = 0; j < atom_n; j++) if( atom_ix[j] > 0 )
+               {  for(ell = 0; ell < atom_k1; ell++)
+                     Partial[atom_ix[j] * K + ell] +=
+                        atom_px[j * atom_k1 + ell];
+               }
+               atom_wait.call_done(atom_call);
             }
          }
          break;
@@ -805,6 +854,7 @@ void reverse(
          CPPAD_ASSERT_UNKNOWN(false);
       }
    }
+   CPPAD_ASSERT_UNKNOWN( atom_wait.empty() );
 # if CPPAD_REVERSE_TRACE
    std::cout << std::endl;
 # endif
@@ -0,0 +1,180 @@
+# ifndef CPPAD_LOCAL_THREAD_TABLE_HPP
+# define CPPAD_LOCAL_THREAD_TABLE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cstddef>
+# include <atomic>
+# include <cppad/configure.hpp>
+# include <cppad/core/cppad_assert.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file thread_table.hpp
+A table with one element for each thread.
+*/
+
+/*!
+A table with one element for each thread.
+
+\tparam Type
+is the type of the elements in the table. It must have a default
+constructor. When an element is created, it is value initialized;
+e.g., if Type is a pointer, its initial value is nullptr.
+
+\par CPPAD_DYNAMIC_THREADS
+If CPPAD_DYNAMIC_THREADS is false, the table is an array with
+CPPAD_MAX_NUM_THREADS elements.
+Otherwise, the elements are stored in chunks where chunk k has 2^k
+elements and holds the threads 2^k - 1 , ... , 2^(k+1) - 2.
+A chunk is allocated the first time one of its elements is accessed.
+Chunks are never moved or freed (until the table is destroyed),
+so different threads can access their elements without a lock.
+*/
+template <class Type>
+class thread_table {
+private:
+# if CPPAD_DYNAMIC_THREADS
+   static_assert(
+      CPPAD_THREAD_LIMIT < 65536, "thread_table: CPPAD_THREAD_LIMIT too large"
+   );
+   /// number of chunks that are needed for CPPAD_THREAD_LIMIT threads
+   static constexpr size_t n_chunk(void)
+   {  size_t k = 0;
+      while( (size_t(1) << k) - 1 < CPPAD_THREAD_LIMIT )
+         ++k;
+      return k;
+   }
+   /// chunk_[k] is the chunk with 2^k elements (or nullptr)
+   std::atomic<Type*> chunk_[ n_chunk() ];
+   /*!
+   Determine the chunk and offset for a thread.
+
+   \param thread [in]
+   is the thread number.
+
+   \param offset [out]
+   is the index of the thread's element within its chunk.
+
+   \return
+   is the index k of the chunk that contains the element for this thread.
+   */
+   static size_t chunk_index(size_t thread, size_t& offset)
+   {  size_t index = thread + 1;
+      size_t k     = 0;
+      size_t i     = index;
+      if( i >> 8 )
+      {  k += 8; i >>= 8; }
+      if( i >> 4 )
+      {  k += 4; i >>= 4; }
+      if( i >> 2 )
+      {  k += 2; i >>= 2; }
+      if( i >> 1 )
+         k += 1;
+      offset = index - (size_t(1) << k);
+      return k;
+   }
+# else
+   /// table of elements
+   Type data_[CPPAD_MAX_NUM_THREADS];
+# endif
+public:
+   /// default constructor
+   thread_table(void)
+# if CPPAD_DYNAMIC_THREADS
+   {  for(size_t k = 0; k < n_chunk(); ++k)
+         chunk_[k].store(nullptr, std::memory_order_relaxed);
+   }
+# else
+   : data_()
+   { }
+# endif
+   /// destructor
+   ~thread_table(void)
+   {
+# if CPPAD_DYNAMIC_THREADS
+      for(size_t k = 0; k < n_chunk(); ++k)
+         delete [] chunk_[k].load(std::memory_order_relaxed);
+# endif
+   }
+   /// a table cannot be copied
+   thread_table(const thread_table&) = delete;
+   /// a table cannot be assigned
+   thread_table& operator=(const thread_table&) = delete;
+   /*!
+   Access the element for a thread, creating it if necessary.
+
+   \param thread [in]
+   is the thread number (must be less than CPPAD_THREAD_LIMIT).
+   During parallel execution, different threads can use this operation
+   at the same time provided they use different values for thread.
+
+   \return
+   is a reference to the element for this thread.
+   */
+   Type& operator[](size_t thread)
+   {  CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT );
+# if CPPAD_DYNAMIC_THREADS
+      size_t offset;
+      size_t k    = chunk_index(thread, offset);
+      Type* chunk = chunk_[k].load(std::memory_order_acquire);
+      if( chunk == nullptr )
+      {  Type* new_chunk = new Type[ size_t(1) << k ]();
+         if( chunk_[k].compare_exchange_strong(
+            chunk, new_chunk, std::memory_order_acq_rel
+         ) )
+            chunk = new_chunk;
+         else
+            delete [] new_chunk;
+      }
+      return chunk[offset];
+# else
+      return data_[thread];
+# endif
+   }
+   /*!
+   Find the element for a thread without creating it.
+
+   \param thread [in]
+   is the thread number (must be less than CPPAD_THREAD_LIMIT).
+
+   \return
+   If the element for this thread has not yet been created, the return value
+   is nullptr. Otherwise it is a pointer to the element for this thread.
+   */
+   Type* find(size_t thread)
+   {  CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT );
+# if CPPAD_DYNAMIC_THREADS
+      size_t offset;
+      size_t k    = chunk_index(thread, offset);
+      Type* chunk = chunk_[k].load(std::memory_order_acquire);
+      if( chunk == nullptr )
+         return nullptr;
+      return chunk + offset;
+# else
+      return data_ + thread;
+# endif
+   }
+   /*!
+   Upper bound for the threads that have an element in the table.
+
+   \return
+   is one greater than the last thread for which the element may exist.
+   */
+   size_t size(void) const
+   {
+# if CPPAD_DYNAMIC_THREADS
+      size_t k = n_chunk();
+      while( k > 0 && chunk_[k-1].load(std::memory_order_acquire) == nullptr )
+         --k;
+      return (size_t(1) << k) - 1;
+# else
+      return CPPAD_MAX_NUM_THREADS;
+# endif
+   }
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
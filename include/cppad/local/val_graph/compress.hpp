@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_COMPRESS_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ---------------------------------------------------------------------------
 # include <cppad/local/val_graph/tape.hpp>
 # include <cppad/local/val_graph/rev_depend.hpp>
@@ -76,6 +76,9 @@ template <class Value>
 vectorBool tape_t<Value>::compress(void)
 // END_COMPRESS
 {
+   // timer
+   pass_timer_t timer( pass_time().compress );
+   //
 # if CPPAD_VAL_GRAPH_TAPE_TRACE
    // thread, initial_inuse
    size_t thread        = thread_alloc::thread_num();
@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_DEAD_CODE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ---------------------------------------------------------------------------
 # include <cppad/local/val_graph/tape.hpp>
 # include <cppad/local/val_graph/rev_depend.hpp>
@@ -99,6 +99,9 @@ vectorBool tape_t<Value>::dead_code(void)
    // Dead Code Elimination
    // https://en.wikipedia.org/wiki/Dead-code_elimination
    // -----------------------------------------------------------------------
+   // timer
+   pass_timer_t timer( pass_time().dead_code );
+   //
 # if CPPAD_VAL_GRAPH_TAPE_TRACE
    // thread, initial_inuse
    size_t thread        = thread_alloc::thread_num();
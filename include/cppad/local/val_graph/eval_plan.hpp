@@ -0,0 +1,494 @@
+# ifndef  CPPAD_LOCAL_VAL_GRAPH_EVAL_PLAN_HPP
+# define  CPPAD_LOCAL_VAL_GRAPH_EVAL_PLAN_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/local/val_graph/op_iterator.hpp>
+/*
+-------------------------------------------------------------------------------
+{xrst_begin val_eval_plan dev}
+{xrst_spell
+   devirtualized
+   xam
+}
+
+Batched Evaluation Plan for a Value Tape
+########################################
+
+Syntax
+******
+| ``eval_plan_t`` < *Value* > *plan* ( *tape* )
+| *plan* . ``eval`` ( *n_batch* , *val_mat* )
+| *plan* . ``eval`` ( *n_batch* , *val_mat* , *compare_false* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_CTOR
+   // END_CTOR
+}
+{xrst_literal
+   // BEGIN_EVAL
+   // END_EVAL
+}
+
+Purpose
+*******
+The :ref:`val_tape@eval` function for a tape
+calls the virtual function :ref:`val_base_op@eval` for every operator
+and evaluates the value vector for one set of independent values.
+The plan is built once for a tape and then evaluates the value vector
+for a batch of independent values during each pass through the operators:
+
+#. The operator kernels are selected, using the operator enum,
+   once per operator for the entire batch.
+   The unary, binary, constant, cumulative summation,
+   conditional expression, compare, and discrete operators are evaluated
+   without a virtual function call.
+#. The value vector indices for the arguments to each operator
+   are stored in one contiguous vector; i.e., the auxiliary arguments
+   and the :ref:`val_tape@op_enum_vec` are not accessed during evaluation.
+#. The values for the batch are stored so that the values
+   corresponding to one value index are contiguous in memory.
+   Hence the loop over the batch, for each operator, has unit stride.
+
+The other operators (call, print, and vector operators) are evaluated
+by their virtual eval function, one element of the batch at a time.
+
+tape
+****
+This is the tape that the plan evaluates.
+It is not copied and must not be modified or deleted while *plan* is in use.
+
+n_batch
+*******
+is the number of independent value vectors in the batch.
+
+val_mat
+*******
+This vector has size *n_val* * *n_batch*
+where *n_val* is :ref:`tape.n_val() <val_tape@n_val>` .
+For *i* = 0 , ... , *n_val* - 1 and *b* = 0 , ... , *n_batch* - 1 ,
+*val_mat* [ *i* * *n_batch* + *b* ]
+is the *i*-th element of the value vector for the *b*-th element
+of the batch.
+The first *n_ind* * *n_batch* elements,
+where *n_ind* is :ref:`tape.n_ind() <val_tape@n_ind>` ,
+are inputs.
+The rest of the elements are outputs.
+
+compare_false
+*************
+This argument is optional.
+If it is present, its size is *n_batch* and
+*compare_false* [ *b* ] is the :ref:`val_tape@eval@compare_false`
+counter for the *b*-th element of the batch.
+
+Threads
+*******
+The *plan* is not modified by ``eval`` ,
+so the same plan can be used by more than one thread at the same time
+(each thread with its own *val_mat* ).
+
+{xrst_toc_hidden
+   val_graph/eval_plan_xam.cpp
+}
+Example
+*******
+The file :ref:`eval_plan_xam.cpp <val_eval_plan_xam.cpp-name>` is an
+example and test of ``eval_plan_t`` .
+
+{xrst_end val_eval_plan}
+-------------------------------------------------------------------------------
+*/
+namespace CppAD { namespace local { namespace val_graph {
+
+// BEGIN_EVAL_PLAN_T
+template <class Value> class eval_plan_t {
+// END_EVAL_PLAN_T
+private:
+   //
+   // tape_
+   const tape_t<Value>* tape_;
+   //
+   // op_enum_vec_
+   // op_enum_vec_[i_op] is the enum value for the i-th operator
+   Vector<uint8_t>      op_enum_vec_;
+   //
+   // res_index_vec_
+   // res_index_vec_[i_op] is the index of the first result for the i-th
+   // operator (for every operator in the tape).
+   Vector<addr_t>       res_index_vec_;
+   //
+   // arg_start_vec_
+   // The arguments for the i-th operator are
+   // arg_vec_[ arg_start_vec_[i_op] ] , ... ,
+   // arg_vec_[ arg_start_vec_[i_op + 1] - 1 ] .
+   Vector<addr_t>       arg_start_vec_;
+   //
+   // arg_vec_
+   // con:   con_index
+   // unary: operand
+   // binary:left, right
+   // csum:  n_add, n_sub, add_1, ..., add_{n_add}, sub_1, ..., sub_{n_sub}
+   // cexp:  compare_enum, left, right, if_true, if_false
+   // comp:  compare_enum, left, right
+   // dis:   discrete_index, operand
+   // other: arg_index in tape arg_vec, n_res
+   Vector<addr_t>       arg_vec_;
+   //
+   // has_other_
+   // is there an operator that is evaluated using its virtual eval function
+   bool                 has_other_;
+public:
+   // BEGIN_CTOR
+   eval_plan_t(const tape_t<Value>& tape)
+   // END_CTOR
+   ;
+   //
+   // eval(n_batch, val_mat)
+   void eval(size_t n_batch, Vector<Value>& val_mat) const
+   {  Vector<size_t> compare_false(n_batch);
+      for(size_t b = 0; b < n_batch; ++b)
+         compare_false[b] = 0;
+      eval(n_batch, val_mat, compare_false);
+   }
+   // BEGIN_EVAL
+   // eval(n_batch, val_mat, compare_false)
+   void eval(
+      size_t           n_batch       ,
+      Vector<Value>&   val_mat       ,
+      Vector<size_t>&  compare_false ) const
+   // END_EVAL
+   ;
+};
+
+// eval_plan_t constructor
+template <class Value>
+eval_plan_t<Value>::eval_plan_t(const tape_t<Value>& tape)
+: tape_(&tape), has_other_(false)
+{  //
+   // n_op, tape_arg_vec
+   addr_t n_op                       = tape.n_op();
+   const Vector<addr_t>& tape_arg_vec = tape.arg_vec();
+   //
+   // op_enum_vec_, res_index_vec_, arg_start_vec_
+   op_enum_vec_   = tape.op_enum_vec();
+   res_index_vec_.resize(n_op);
+   arg_start_vec_.resize(n_op + 1);
+   arg_vec_.resize(0);
+   //
+   // op_itr
+   op_iterator<Value> op_itr(tape, 0);
+   for(addr_t i_op = 0; i_op < n_op; ++i_op)
+   {  //
+      // op_ptr, arg_index, res_index
+      const base_op_t<Value>* op_ptr    = op_itr.op_ptr();
+      addr_t                  arg_index = op_itr.arg_index();
+      addr_t                  res_index = op_itr.res_index();
+      op_enum_t               op_enum   = op_ptr->op_enum();
+      //
+      // res_index_vec_, arg_start_vec_
+      res_index_vec_[i_op] = res_index;
+      arg_start_vec_[i_op] = addr_t( arg_vec_.size() );
+      //
+      // arg_vec_
+      switch( op_enum )
+      {  //
+         case con_op_enum:
+         arg_vec_.push_back( tape_arg_vec[arg_index + 0] );
+         break;
+         //
+         case csum_op_enum:
+         {  addr_t n_add = tape_arg_vec[arg_index + 0];
+            addr_t n_sub = tape_arg_vec[arg_index + 1];
+            for(addr_t i = 0; i < 2 + n_add + n_sub; ++i)
+               arg_vec_.push_back( tape_arg_vec[arg_index + i] );
+         }
+         break;
+         //
+         case cexp_op_enum:
+         for(addr_t i = 0; i < 5; ++i)
+            arg_vec_.push_back( tape_arg_vec[arg_index + i] );
+         break;
+         //
+         case comp_op_enum:
+         for(addr_t i = 0; i < 3; ++i)
+            arg_vec_.push_back( tape_arg_vec[arg_index + i] );
+         break;
+         //
+         case dis_op_enum:
+         for(addr_t i = 0; i < 2; ++i)
+            arg_vec_.push_back( tape_arg_vec[arg_index + i] );
+         break;
+         //
+         default:
+         if( op_ptr->is_unary() )
+            arg_vec_.push_back( tape_arg_vec[arg_index + 0] );
+         else if( op_ptr->is_binary() )
+         {  arg_vec_.push_back( tape_arg_vec[arg_index + 0] );
+            arg_vec_.push_back( tape_arg_vec[arg_index + 1] );
+         }
+         else
+         {  has_other_ = true;
+            arg_vec_.push_back( arg_index );
+            arg_vec_.push_back( op_ptr->n_res(arg_index, tape_arg_vec) );
+         }
+         break;
+      }
+      ++op_itr;
+   }
+   arg_start_vec_[n_op] = addr_t( arg_vec_.size() );
+}
+
+// eval_plan_t::eval
+# define CPPAD_VAL_GRAPH_PLAN_UNARY(Name, Op) \
+   case Name##_op_enum: \
+   {  const Value* x = val + size_t( arg[0] ) * n_batch; \
+      for(size_t b = 0; b < n_batch; ++b) \
+         res[b] = Op( x[b] ); \
+   } \
+   break;
+# define CPPAD_VAL_GRAPH_PLAN_BINARY(Name, Op) \
+   case Name##_op_enum: \
+   {  const Value* left  = val + size_t( arg[0] ) * n_batch; \
+      const Value* right = val + size_t( arg[1] ) * n_batch; \
+      for(size_t b = 0; b < n_batch; ++b) \
+         res[b] = left[b] Op right[b]; \
+   } \
+   break;
+template <class Value>
+void eval_plan_t<Value>::eval(
+   size_t           n_batch       ,
+   Vector<Value>&   val_mat       ,
+   Vector<size_t>&  compare_false ) const
+{  //
+   // n_val, n_op
+   size_t n_val = size_t( tape_->n_val() );
+   addr_t n_op  = addr_t( op_enum_vec_.size() );
+   CPPAD_ASSERT_KNOWN(
+      val_mat.size() == n_val * n_batch,
+      "eval_plan: size of val_mat not equal to tape.n_val() * n_batch"
+   );
+   CPPAD_ASSERT_KNOWN(
+      compare_false.size() == n_batch,
+      "eval_plan: size of compare_false not equal to n_batch"
+   );
+   CPPAD_ASSERT_KNOWN( n_op == tape_->n_op(),
+      "eval_plan: the tape has changed since this plan was created"
+   );
+   if( n_batch == 0 )
+      return;
+   //
+   // val, con_vec
+   Value*               val     = val_mat.data();
+   const Vector<Value>& con_vec = tape_->con_vec();
+   //
+   // val_vec_vec, ind_vec_vec_vec, n_sync
+   // Operators that are evaluated using their virtual eval function use
+   // val_vec_vec[b] as the value vector for the b-th element of the batch.
+   // The values with index less than n_sync have been copied from val_mat
+   // to val_vec_vec (each value is copied at most once).
+   Vector< Vector<Value> >              val_vec_vec;
+   Vector< Vector< Vector<addr_t> > >   ind_vec_vec_vec;
+   size_t                               n_sync = 0;
+   if( has_other_ )
+   {  val_vec_vec.resize(n_batch);
+      ind_vec_vec_vec.resize(n_batch);
+      for(size_t b = 0; b < n_batch; ++b)
+         val_vec_vec[b].resize(n_val);
+   }
+   //
+   for(addr_t i_op = 0; i_op < n_op; ++i_op)
+   {  //
+      // op_enum, res, arg
+      op_enum_t     op_enum = op_enum_t( op_enum_vec_[i_op] );
+      size_t        res_index = size_t( res_index_vec_[i_op] );
+      Value*        res     = val + res_index * n_batch;
+      const addr_t* arg     = arg_vec_.data() + arg_start_vec_[i_op];
+      //
+      switch( op_enum )
+      {  // BEGIN_SORT_THIS_LINE_PLUS_1
+         CPPAD_VAL_GRAPH_PLAN_BINARY(add, +)
+         CPPAD_VAL_GRAPH_PLAN_BINARY(div, /)
+         CPPAD_VAL_GRAPH_PLAN_BINARY(mul, *)
+         CPPAD_VAL_GRAPH_PLAN_BINARY(sub, -)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(abs,   fabs)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(acos,  acos)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(acosh, acosh)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(asin,  asin)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(asinh, asinh)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(atan,  atan)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(atanh, atanh)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(cos,   cos)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(cosh,  cosh)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(erf,   erf)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(erfc,  erfc)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(exp,   exp)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(expm1, expm1)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(log,   log)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(log1p, log1p)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(neg,   -)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(sign,  sign)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(sin,   sin)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(sinh,  sinh)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(sqrt,  sqrt)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(tan,   tan)
+         CPPAD_VAL_GRAPH_PLAN_UNARY(tanh,  tanh)
+         // END_SORT_THIS_LINE_MINUS_1
+         //
+         // pow
+         case pow_op_enum:
+         {  const Value* left  = val + size_t( arg[0] ) * n_batch;
+            const Value* right = val + size_t( arg[1] ) * n_batch;
+            for(size_t b = 0; b < n_batch; ++b)
+               res[b] = pow( left[b], right[b] );
+         }
+         break;
+         //
+         // con
+         case con_op_enum:
+         {  const Value& con = con_vec[ arg[0] ];
+            for(size_t b = 0; b < n_batch; ++b)
+               res[b] = con;
+         }
+         break;
+         //
+         // csum
+         case csum_op_enum:
+         {  addr_t n_add = arg[0];
+            addr_t n_sub = arg[1];
+            for(size_t b = 0; b < n_batch; ++b)
+               res[b] = Value(0.0);
+            for(addr_t i = 0; i < n_add; ++i)
+            {  const Value* x = val + size_t( arg[2 + i] ) * n_batch;
+               for(size_t b = 0; b < n_batch; ++b)
+                  res[b] += x[b];
+            }
+            for(addr_t i = 0; i < n_sub; ++i)
+            {  const Value* x = val + size_t( arg[2 + n_add + i] ) * n_batch;
+               for(size_t b = 0; b < n_batch; ++b)
+                  res[b] -= x[b];
+            }
+         }
+         break;
+         //
+         // cexp
+         case cexp_op_enum:
+         {  compare_enum_t compare_enum = compare_enum_t( arg[0] );
+            const Value* left     = val + size_t( arg[1] ) * n_batch;
+            const Value* right    = val + size_t( arg[2] ) * n_batch;
+            const Value* if_true  = val + size_t( arg[3] ) * n_batch;
+            const Value* if_false = val + size_t( arg[4] ) * n_batch;
+            switch( compare_enum )
+            {  case compare_eq_enum:
+               for(size_t b = 0; b < n_batch; ++b) res[b] =
+                  CondExpEq(left[b], right[b], if_true[b], if_false[b]);
+               break;
+               //
+               case compare_lt_enum:
+               for(size_t b = 0; b < n_batch; ++b) res[b] =
+                  CondExpLt(left[b], right[b], if_true[b], if_false[b]);
+               break;
+               //
+               case compare_le_enum:
+               for(size_t b = 0; b < n_batch; ++b) res[b] =
+                  CondExpLe(left[b], right[b], if_true[b], if_false[b]);
+               break;
+               //
+               default:
+               CPPAD_ASSERT_UNKNOWN(false);
+               for(size_t b = 0; b < n_batch; ++b)
+                  res[b] = CppAD::numeric_limits<Value>::quiet_NaN();
+            }
+         }
+         break;
+         //
+         // comp
+         case comp_op_enum:
+         {  compare_enum_t compare_enum = compare_enum_t( arg[0] );
+            const Value* left     = val + size_t( arg[1] ) * n_batch;
+            const Value* right    = val + size_t( arg[2] ) * n_batch;
+            switch( compare_enum )
+            {  case compare_eq_enum:
+               for(size_t b = 0; b < n_batch; ++b)
+                  compare_false[b] += size_t( ! (left[b] == right[b]) );
+               break;
+               //
+               case compare_ne_enum:
+               for(size_t b = 0; b < n_batch; ++b)
+                  compare_false[b] += size_t( ! (left[b] != right[b]) );
+               break;
+               //
+               case compare_lt_enum:
+               for(size_t b = 0; b < n_batch; ++b)
+                  compare_false[b] += size_t( ! (left[b] < right[b]) );
+               break;
+               //
+               case compare_le_enum:
+               for(size_t b = 0; b < n_batch; ++b)
+                  compare_false[b] += size_t( ! (left[b] <= right[b]) );
+               break;
+               //
+               case compare_no_enum:
+               break;
+               //
+               default:
+               CPPAD_ASSERT_UNKNOWN(false);
+            }
+         }
+         break;
+         //
+         // dis
+         case dis_op_enum:
+         {  size_t discrete_index = size_t( arg[0] );
+            const Value* x = val + size_t( arg[1] ) * n_batch;
+            for(size_t b = 0; b < n_batch; ++b)
+               res[b] = discrete<Value>::eval(discrete_index, x[b]);
+         }
+         break;
+         //
+         // call, pri, vec, load, store
+         default:
+         {  const base_op_t<Value>* op_ptr = op_enum2class<Value>(op_enum);
+            addr_t arg_index = arg[0];
+            size_t n_res     = size_t( arg[1] );
+            //
+            // val_vec_vec, n_sync
+            CPPAD_ASSERT_UNKNOWN( n_sync <= res_index );
+            for(size_t b = 0; b < n_batch; ++b)
+            {  Vector<Value>& val_vec = val_vec_vec[b];
+               for(size_t i = n_sync; i < res_index; ++i)
+                  val_vec[i] = val[i * n_batch + b];
+            }
+            n_sync = res_index + n_res;
+            //
+            // base_op_t<Value>::eval
+            bool trace = false;
+            for(size_t b = 0; b < n_batch; ++b)
+            {  Vector<Value>& val_vec = val_vec_vec[b];
+               op_ptr->eval(
+                  tape_,
+                  trace,
+                  arg_index,
+                  addr_t( res_index ),
+                  val_vec,
+                  ind_vec_vec_vec[b],
+                  compare_false[b]
+               );
+               for(size_t i = 0; i < n_res; ++i)
+                  res[i * n_batch + b] = val_vec[res_index + i];
+            }
+         }
+         break;
+      }
+   }
+   return;
+}
+# undef CPPAD_VAL_GRAPH_PLAN_UNARY
+# undef CPPAD_VAL_GRAPH_PLAN_BINARY
+
+} } } // END_CPPAD_LOCAL_VAL_GRAPH_NAMESPACE
+
+# endif
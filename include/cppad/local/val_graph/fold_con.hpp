@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_FOLD_CON_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 /*
 -------------------------------------------------------------------------------
 {xrst_begin val_tape_fold_con dev}
@@ -76,6 +76,9 @@ template <class Value>
 void tape_t<Value>::fold_con(void)
 // END_FOLD_CON
 {
+   // timer
+   pass_timer_t timer( pass_time().fold_con );
+   //
 # if CPPAD_VAL_GRAPH_TAPE_TRACE
    // thread, initial_inuse
    size_t thread        = thread_alloc::thread_num();
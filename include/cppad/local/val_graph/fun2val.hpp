@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_FUN2VAL_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // --------------------------------------------------------------------------
 /*
 ------------------------------------------------------------------------------
@@ -80,6 +80,10 @@ void ADFun<Base, RecBase>::fun2val(
    local::val_graph::tape_t<Base>& val_tape  )
 // END_PROTOTYPE
 {  //
+   // timer
+   using local::val_graph::pass_timer_t;
+   pass_timer_t timer( local::val_graph::pass_time().fun2val );
+   //
    // Vector, addr_t, op_enum_t
    using local::val_graph::Vector;
    using local::val_graph::addr_t;
@@ -209,12 +213,25 @@ void ADFun<Base, RecBase>::fun2val(
    val_tape.set_ind( n_val_ind );
 # endif
    //
-   // val_tape, vec_info_vec
-   // Put dynamic vectors in val_tape and create vec_info_vec
-   struct vec_info_t { size_t size; size_t offset; };
-   Vector<vec_info_t> vec_info_vec;
+   // val_tape
+   // Each operator in play_ corresponds to at most one value operator
+   // (often with fewer arguments) and each parameter and VecAD element
+   // to at most one constant operator. Reserving this space avoids
+   // repeated re-allocation and copying while recording val_tape.
+   {  size_t n_vecad_ind = play_.num_var_vecad_ind_rec();
+      size_t n_op  = play_.num_op_rec() + n_dynamic + n_parameter;
+      size_t n_arg = play_.num_op_arg_rec() + play_.num_dynamic_arg();
+      n_op        += n_vecad_ind;
+      n_arg       += n_parameter + n_vecad_ind;
+      val_tape.reserve(n_op, n_arg, n_parameter + n_vecad_ind);
+   }
+   //
+   // val_tape, offset2vec
+   // Put dynamic vectors in val_tape and create offset2vec
+   Vector<addr_t> offset2vec( play_.num_var_vecad_ind_rec() );
    {  size_t n_vecad_ind = play_.num_var_vecad_ind_rec();
       size_t index         = 0;
+      addr_t n_vec         = 0;
       while(index < n_vecad_ind)
       {  size_t size         = play_.GetVecInd(index++);
          size_t offset       = index;
@@ -229,22 +246,16 @@ void ADFun<Base, RecBase>::fun2val(
          val_tape.record_vec_op(initial);
 # else
          addr_t which_vector = val_tape.record_vec_op(initial);
-         CPPAD_ASSERT_UNKNOWN( size_t(which_vector) == vec_info_vec.size() );
+         CPPAD_ASSERT_UNKNOWN( which_vector == n_vec );
 # endif
-         vec_info_t vec_info = {size, offset};
-         vec_info_vec.push_back( vec_info );
+         offset2vec[offset] = n_vec++;
       }
    }
    //
    // vec_offset2index
-   // mapping from vecad offset to index in vec_info_vec
-   auto vec_offset2index = [&vec_info_vec](addr_t offset)
-   {  addr_t index    = 0;
-      size_t offset_s = size_t(offset);
-      while( vec_info_vec[index].offset < offset_s )
-         ++index;
-      CPPAD_ASSERT_UNKNOWN( vec_info_vec[index].offset == offset_s );
-      return index;
+   // mapping from vecad offset to index of the corresponding vector
+   auto vec_offset2index = [&offset2vec](addr_t offset)
+   {  return offset2vec[offset];
    };
    //
    // par2val_index
@@ -255,8 +266,8 @@ void ADFun<Base, RecBase>::fun2val(
    for(addr_t i = 0; i < addr_t( n_dynamic_ind ); ++i)
       par2val_index[i + 1] = i;
    //
-   // val_op_arg, var_op_res, res_is_par;
-   Vector<addr_t> val_op_arg, var_op_res;
+   // val_op_arg, var_op_res, res_is_par, csum_add, csum_sub
+   Vector<addr_t> val_op_arg, var_op_res, csum_add, csum_sub;
    Vector<bool>   res_is_par;
    //
    // i_arg
@@ -647,6 +658,29 @@ void ADFun<Base, RecBase>::fun2val(
          case local::InvOp:
          break;
          //
+         // FmavvpOp, FmavvvOp
+         // a * b + c is converted to a multiply followed by an add
+         case local::FmavvpOp:
+         case local::FmavvvOp:
+         {  val_op_arg.resize(2);
+            val_op_arg[0] = var2val_index[ var_op_arg[0] ];
+            val_op_arg[1] = var2val_index[ var_op_arg[1] ];
+            addr_t product = val_tape.record_op(
+               local::val_graph::mul_op_enum, val_op_arg
+            );
+            //
+            val_op_arg[0] = product;
+            if( var_op == local::FmavvvOp )
+               val_op_arg[1] = var2val_index[ var_op_arg[2] ];
+            else
+               val_op_arg[1] = ensure_par2val_index( var_op_arg[2] );
+            val_index = val_tape.record_op(
+               local::val_graph::add_op_enum, val_op_arg
+            );
+            var2val_index[i_var] = val_index;
+         }
+         break;
+         //
          // DisOp
          case local::DisOp:
          {  // val_tape, var2val_index
@@ -753,30 +787,63 @@ void ADFun<Base, RecBase>::fun2val(
          // --------------------------------------------------------------
          case local::CSumOp:
          {  //
-            // add, sub
-            Vector<addr_t> add, sub;
+            // csum_add, csum_sub
+            // These vectors keep their capacity from one CSumOp to the next.
+            csum_add.resize(0);
+            csum_sub.resize(0);
             //
-            // add: constant term
-            add.push_back( ensure_par2val_index( var_op_arg[0] ) );
+            // csum_add: constant term
+            csum_add.push_back( ensure_par2val_index( var_op_arg[0] ) );
             //
-            // add: variables
+            // csum_add: variables
             for(addr_t i = 5; i < var_op_arg[1]; ++i)
-               add.push_back( var2val_index[ var_op_arg[i] ] );
+               csum_add.push_back( var2val_index[ var_op_arg[i] ] );
             //
-            // sub: variables
+            // csum_sub: variables
             for(addr_t i = var_op_arg[1]; i < var_op_arg[2]; ++i)
-               sub.push_back( var2val_index[ var_op_arg[i] ] );
+               csum_sub.push_back( var2val_index[ var_op_arg[i] ] );
             //
-            // add: dynamic parameters
+            // csum_add: dynamic parameters
             for(addr_t i = var_op_arg[2]; i < var_op_arg[3]; ++i)
-               add.push_back( ensure_par2val_index( var_op_arg[i] ) );
+               csum_add.push_back( ensure_par2val_index( var_op_arg[i] ) );
             //
-            // sub: dynamic parameters
+            // csum_sub: dynamic parameters
             for(addr_t i = var_op_arg[3]; i < var_op_arg[4]; ++i)
-               sub.push_back( ensure_par2val_index( var_op_arg[i] ) );
+               csum_sub.push_back( ensure_par2val_index( var_op_arg[i] ) );
+            //
+            // val_tape, var2val_index
+            var2val_index[i_var] = val_tape.record_csum_op(csum_add, csum_sub);
+         }
+         itr.correct_before_increment();
+         break;
+         // --------------------------------------------------------------
+         // WSumOp
+         // each term is converted to a multiply followed by one summation
+         case local::WSumOp:
+         {  //
+            // csum_add, csum_sub
+            csum_add.resize(0);
+            csum_sub.resize(0);
+            val_op_arg.resize(2);
+            for(addr_t i = 4; i < var_op_arg[3]; i += 2)
+            {  if( i < var_op_arg[1] )
+                  val_op_arg[0] = ensure_par2val_index( var_op_arg[i] );
+               else
+                  val_op_arg[0] = var2val_index[ var_op_arg[i] ];
+               val_op_arg[1] = var2val_index[ var_op_arg[i+1] ];
+               addr_t product = val_tape.record_op(
+                  local::val_graph::mul_op_enum, val_op_arg
+               );
+               bool add = i < var_op_arg[0];
+               add     |= var_op_arg[1] <= i && i < var_op_arg[2];
+               if( add )
+                  csum_add.push_back( product );
+               else
+                  csum_sub.push_back( product );
+            }
             //
             // val_tape, var2val_index
-            var2val_index[i_var] = val_tape.record_csum_op(add, sub);
+            var2val_index[i_var] = val_tape.record_csum_op(csum_add, csum_sub);
          }
          itr.correct_before_increment();
          break;
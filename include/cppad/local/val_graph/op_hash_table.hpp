@@ -2,11 +2,9 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_OP_HASH_TABLE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ---------------------------------------------------------------------------
-# include <cppad/local/sparse/size_setvec.hpp>
 # include <cppad/local/val_graph/tape.hpp>
-# include <cppad/local/is_pod.hpp>
 /*
 {xrst_begin val_op_hash_table dev}
 
@@ -39,6 +37,17 @@ n_hash_code
 This is the number of possible hash codes in the operator hash table
 *op_hash_table* .
 
+code
+****
+{xrst_literal
+   // BEGIN_CODE
+   // END_CODE
+}
+The return value *code* is the hash code for the *i_op* operator;
+see :ref:`val_op_hash_table@match_op@new_val_index` below.
+It is less than *n_hash_code* .
+Equivalent operators have the same hash code.
+
 match_op
 ********
 {xrst_literal
@@ -62,6 +71,12 @@ New value indices are the result of using previous operator matches.
 For arguments that are value indices,
 the new indices are used when checking to see if operators match.
 
+code
+====
+If this argument is present, it must be equal to
+*op_hash_table*.code( *i_op* , *new_val_index* ) .
+Otherwise, the hash code is computed by ``match_op`` .
+
 j_op
 ====
 The return value *j_op* is the lowest operator index that corresponds to a
@@ -69,6 +84,14 @@ match for *i_op* . If it is equal to *i_op* , then this operator has been placed
 in the hash table (for future matches).
 Otherwise *j_op* is less than *i_op* and its results are equivalent to *i_op*.
 
+Parallel Execution
+==================
+The table does not allocate memory after it is constructed.
+Different threads may call ``match_op`` at the same time
+provided that the corresponding hash codes are different
+and no thread modifies *new_val_index* at the value indices
+being used by the other threads.
+
 size_count
 **********
 {xrst_literal
@@ -82,18 +105,6 @@ A collision occurs when two operators that do not match have the same hash code.
 {xrst_end val_op_hash_table}
 */
 
-// Tell pod_vector class that each size_setvec<addr_t>::pair_s_type is
-// plain old data and hence the corresponding constructor need not be called.
-namespace CppAD { namespace local {
-# if ! CPPAD_IS_SAME_TAPE_ADDR_TYPE_SIZE_T
-   // This pair gets defined in list_setvec.hpp for the type size_t.
-   // Would be better to have conditional compile depending of if defined.
-   template <> inline bool
-   is_pod< sparse::size_setvec<addr_t>::pair_s_type > (void)
-   {  return true; }
-# endif
-} }
-
 namespace CppAD { namespace local { namespace val_graph {
 
 // hash_value
@@ -128,47 +139,19 @@ private:
    // op2arg_index_
    const Vector<addr_t>& op2arg_index_;
    //
-   // table
-   CppAD::local::sparse::size_setvec<addr_t> table_;
+   // first_op_
+   // first_op_[code] is the last operator placed in the table with this
+   // hash code (n_op if there is no such operator).
+   Vector<addr_t> first_op_;
    //
-   // hash_code
-   addr_t hash_code(
-      const base_op_t<Value>* op_ptr        ,
-      addr_t                  arg_index     ,
-      const Vector<addr_t>&   new_val_index )
-   {  //
-      // arg_vec, con_vec, op_enum
-      const Vector<addr_t>& arg_vec = tape_.arg_vec();
-      const Vector<Value>&  con_vec = tape_.con_vec();
-      op_enum_t             op_enum = op_ptr->op_enum();
-      //
-      size_t code;
-      if( op_enum == con_op_enum )
-         code = hash_value( con_vec[  arg_vec[arg_index] ] );
-      else
-      {  addr_t n_arg    = op_ptr->n_arg(arg_index, arg_vec);
-         addr_t n_before = op_ptr->n_before();
-         addr_t n_after  = op_ptr->n_after();
-         //
-         // code
-         code = 0;
-         //
-         // These are auxillary indices
-         for(addr_t i = 0; i < n_before; ++i)
-            code += size_t( arg_vec[arg_index + i] );
-         //
-         // These arguments are indices in the value vector, so check for a
-         // match with the lowest equivalent value vector index.
-         for(addr_t i = n_before; i < n_arg - n_after; ++i)
-            code += size_t( new_val_index[ arg_vec[arg_index + i] ] );
-         //
-         // These are auxillary indices
-         for(addr_t i = n_arg - n_after; i < n_arg ; ++i)
-            code += size_t( arg_vec[arg_index + i] );
-      }
-      code = code % size_t( table_.n_set() );
-      return addr_t( code );
-   }
+   // next_op_
+   // next_op_[i_op] is the operator placed in the table, with the same
+   // hash code as i_op, just before i_op (n_op if there is no such operator).
+   Vector<addr_t> next_op_;
+   //
+   // end_
+   // is the number of operators in the tape
+   addr_t end_;
 public:
    // -------------------------------------------------------------------------
    // BEGIN_OP_HASH_TABLE_T
@@ -179,10 +162,14 @@ public:
          addr_t                   n_hash_code  )
    // END_OP_HASH_TABLE_T
    : tape_( tape ), op2arg_index_(op2arg_index)
-   {  // table_
-      addr_t n_op = tape.n_op();
+   {  // end_
+      end_ = tape.n_op();
       //
-      table_.resize( n_hash_code, n_op );
+      // first_op_, next_op_
+      first_op_.resize( size_t(n_hash_code) );
+      next_op_.resize( size_t(end_) );
+      for(addr_t i = 0; i < n_hash_code; ++i)
+         first_op_[i] = end_;
    }
    // -------------------------------------------------------------------------
    // BEGIN_SIZE_COUNT
@@ -190,9 +177,11 @@ public:
    Vector<addr_t> size_count(void)
    // END_SIZE_COUNT
    {  Vector<addr_t> count;
-      addr_t n_set  = table_.n_set();
-      for(addr_t i = 0; i < n_set; ++i)
-      {  addr_t number_elements = table_.number_elements(i);
+      size_t n_set  = first_op_.size();
+      for(size_t i = 0; i < n_set; ++i)
+      {  addr_t number_elements = 0;
+         for(addr_t j_op = first_op_[i]; j_op != end_; j_op = next_op_[j_op])
+            ++number_elements;
          if( size_t( number_elements ) >= count.size() )
          {  size_t old_size = count.size();
             addr_t new_size = number_elements + 1;
@@ -205,11 +194,58 @@ public:
       return count;
    }
    // -------------------------------------------------------------------------
+   // BEGIN_CODE
+   // code = op_hash_table.code(i_op, new_val_index)
+   addr_t code(addr_t i_op, const Vector<addr_t>& new_val_index) const
+   // END_CODE
+   {  //
+      // arg_vec, con_vec, op_ptr, op_enum, arg_index
+      const Vector<addr_t>&   arg_vec   = tape_.arg_vec();
+      const Vector<Value>&    con_vec   = tape_.con_vec();
+      const base_op_t<Value>* op_ptr    = tape_.base_op_ptr(i_op);
+      op_enum_t               op_enum   = op_ptr->op_enum();
+      addr_t                  arg_index = op2arg_index_[i_op];
+      //
+      size_t code;
+      if( op_enum == con_op_enum )
+         code = hash_value( con_vec[  arg_vec[arg_index] ] );
+      else
+      {  addr_t n_arg    = op_ptr->n_arg(arg_index, arg_vec);
+         addr_t n_before = op_ptr->n_before();
+         addr_t n_after  = op_ptr->n_after();
+         //
+         // code
+         code = 0;
+         //
+         // These are auxillary indices
+         for(addr_t i = 0; i < n_before; ++i)
+            code += size_t( arg_vec[arg_index + i] );
+         //
+         // These arguments are indices in the value vector, so check for a
+         // match with the lowest equivalent value vector index.
+         for(addr_t i = n_before; i < n_arg - n_after; ++i)
+            code += size_t( new_val_index[ arg_vec[arg_index + i] ] );
+         //
+         // These are auxillary indices
+         for(addr_t i = n_arg - n_after; i < n_arg ; ++i)
+            code += size_t( arg_vec[arg_index + i] );
+      }
+      code = code % first_op_.size();
+      return addr_t( code );
+   }
+   // -------------------------------------------------------------------------
    // BEGIN_MATCH_OP
    // j_op = op_hash_table.match_op(i_op, new_val_index)
    addr_t match_op(addr_t i_op, const Vector<addr_t>& new_val_index)
    // END_MATCH_OP
-   {  assert( i_op < table_.end() );
+   {  return match_op(i_op, new_val_index, code(i_op, new_val_index) ); }
+   //
+   // j_op = op_hash_table.match_op(i_op, new_val_index, code)
+   addr_t match_op(
+      addr_t i_op, const Vector<addr_t>& new_val_index, addr_t code
+   )
+   {  assert( i_op < end_ );
+      CPPAD_ASSERT_UNKNOWN( code == this->code(i_op, new_val_index) );
       //
       // arg_vec, con_vec
       const Vector<addr_t>&    arg_vec     = tape_.arg_vec();
@@ -233,14 +269,12 @@ public:
          }
       }
       //
-      // code
-      addr_t code = hash_code(op_ptr, arg_index, new_val_index);
-      //
-      // itr
-      local::sparse::size_setvec_const_iterator<addr_t> itr(table_, code);
-      while( *itr != table_.end() )
+      // j_op
+      // Each operator in this list is not equivalent to any other operator
+      // in the list, so the order of the list does not affect the result.
+      addr_t j_op = first_op_[code];
+      while( j_op != end_ )
       {  // op_enum_j, arg_index_j
-         addr_t                  j_op = *itr;
          const base_op_t<Value>* op_ptr_j = tape_.base_op_ptr(j_op);
          op_enum_t op_enum_j   = op_ptr_j->op_enum();
          addr_t    arg_index_j = op2arg_index_[j_op];
@@ -285,10 +319,13 @@ public:
          if( match )
             return j_op;
          //
-         // itr
-         ++itr;
+         // j_op
+         j_op = next_op_[j_op];
       }
-      table_.add_element(code, i_op);
+      //
+      // first_op_, next_op_
+      next_op_[i_op]  = first_op_[code];
+      first_op_[code] = i_op;
       return i_op;
    }
 };
@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_OPTION_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ---------------------------------------------------------------------------
 # include <cppad/local/val_graph/tape.hpp>
 
@@ -33,6 +33,12 @@ If *name* is keep_print, *value* must be true or false .
 If it is false (true), :ref:`val_pri_op-name` operators will (will not)
 be removed during dead code optimization.
 
+simplify_all
+************
+If *name* is simplify_all, *value* must be true or false .
+If it is false (true), only the exact rules (all the rules)
+are used by the :ref:`val_tape_simplify-name` pass.
+
 {xrst_end val_tape_option}
 */
 // ---------------------------------------------------------------------------
@@ -43,6 +49,7 @@ void tape_t<Value>::initialize_option(void)
 {
    option_map_["keep_compare"] = "true";
    option_map_["keep_print"]   = "true";
+   option_map_["simplify_all"] = "false";
    //
    return;
 }
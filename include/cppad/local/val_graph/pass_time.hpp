@@ -0,0 +1,127 @@
+# ifndef  CPPAD_LOCAL_VAL_GRAPH_PASS_TIME_HPP
+# define  CPPAD_LOCAL_VAL_GRAPH_PASS_TIME_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <chrono>
+# include <cppad/utility/thread_alloc.hpp>
+# include <cppad/local/thread_table.hpp>
+/*
+------------------------------------------------------------------------------
+{xrst_begin val_pass_time dev}
+{xrst_spell
+   chrono
+   steady
+}
+
+Time Spent in the Value Graph Passes
+####################################
+
+Syntax
+******
+| ``pass_time_t&`` *pass_time* = ``pass_time`` ()
+| ``pass_timer_t`` *timer* ( *seconds* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PASS_TIME_T
+   // END_PASS_TIME_T
+}
+{xrst_literal
+   // BEGIN_PASS_TIME
+   // END_PASS_TIME
+}
+{xrst_literal
+   // BEGIN_PASS_TIMER_T
+   // END_PASS_TIMER_T
+}
+
+pass_time
+*********
+The return value is a reference to the total number of seconds
+that the current thread has spent in each of the following operations:
+
+.. csv-table::
+   :header-rows: 1
+
+   Field,      Operation
+   fun2val,    :ref:`fun2val <fun2val_graph-name>`
+   renumber,   :ref:`val_tape_renumber-name`
+   simplify,   :ref:`val_tape_simplify-name`
+   fold_con,   :ref:`val_tape_fold_con-name`
+   summation,  :ref:`val_summation-name`
+   dead_code,  :ref:`val_tape_dead_code-name`
+   compress,   :ref:`val_tape_compress-name`
+   val2fun,    :ref:`val2fun <val2fun_graph-name>`
+
+Each field starts at zero and is never reset by CppAD;
+i.e., it is the sum over all the calls by this thread.
+A caller that wants the time for a sequence of calls can
+set *pass_time* to ``pass_time_t()`` before the sequence
+and read the fields after the sequence.
+
+pass_timer_t
+************
+This object adds the wall clock time between its construction and
+its destruction to *seconds* .
+It uses ``std::chrono::steady_clock`` and not :ref:`elapsed_seconds-name`
+so that it can be used during parallel mode without first being
+called during sequential mode.
+
+{xrst_end val_pass_time}
+------------------------------------------------------------------------------
+*/
+namespace CppAD { namespace local { namespace val_graph {
+
+// BEGIN_PASS_TIME_T
+struct pass_time_t {
+   double fun2val;
+   double renumber;
+   double simplify;
+   double fold_con;
+   double summation;
+   double dead_code;
+   double compress;
+   double val2fun;
+   pass_time_t(void)
+   : fun2val(0.0)
+   , renumber(0.0)
+   , simplify(0.0)
+   , fold_con(0.0)
+   , summation(0.0)
+   , dead_code(0.0)
+   , compress(0.0)
+   , val2fun(0.0)
+   { }
+};
+// END_PASS_TIME_T
+
+// BEGIN_PASS_TIME
+inline pass_time_t& pass_time(void)
+// END_PASS_TIME
+{  static local::thread_table<pass_time_t> table;
+   return table[ thread_alloc::thread_num() ];
+}
+
+// BEGIN_PASS_TIMER_T
+class pass_timer_t {
+private:
+   double&                               seconds_;
+   std::chrono::steady_clock::time_point start_;
+public:
+   pass_timer_t(double& seconds)
+   : seconds_(seconds), start_( std::chrono::steady_clock::now() )
+   { }
+   ~pass_timer_t(void)
+   {  std::chrono::duration<double> difference =
+         std::chrono::steady_clock::now() - start_;
+      seconds_ += difference.count();
+   }
+};
+// END_PASS_TIMER_T
+
+} } } // END_CPPAD_LOCAL_VAL_GRAPH_NAMESPACE
+
+# endif
@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_RECORD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/val_graph/tape.hpp>
 # include <cppad/local/val_graph/op_enum2class.hpp>
@@ -93,6 +93,58 @@ addr_t tape_t<Value>::set_ind(addr_t n_ind)
 }
 /*
 -------------------------------------------------------------------------------
+{xrst_begin val_reserve dev}
+
+Reserve Memory for a Recording
+##############################
+
+reserve
+*******
+{xrst_literal
+   // BEGIN_RESERVE
+   // END_RESERVE
+}
+This can be called directly after :ref:`val_set_ind-name` .
+It ensures that the tape can hold
+*n_op* operators, *n_arg* operator arguments, and *n_con* value constants
+without any memory allocation for the corresponding vectors.
+This is an optimization that does not change the recording.
+It is useful when one knows an upper bound for the size of the recording;
+e.g., when converting another operation sequence to a value graph.
+
+{xrst_end val_reserve}
+*/
+// ----------------------------------------------------------------------------
+// BEGIN_RESERVE
+template <class Value>
+void tape_t<Value>::reserve(size_t n_op, size_t n_arg, size_t n_con)
+// END_RESERVE
+{  // The capacity of a CppAD::vector does not change when its size decreases
+   size_t size;
+   //
+   // op_enum_vec_
+   size = op_enum_vec_.size();
+   if( size < n_op )
+   {  op_enum_vec_.resize(n_op);
+      op_enum_vec_.resize(size);
+   }
+   //
+   // arg_vec_
+   size = arg_vec_.size();
+   if( size < n_arg )
+   {  arg_vec_.resize(n_arg);
+      arg_vec_.resize(size);
+   }
+   //
+   // con_vec_
+   size = con_vec_.size();
+   if( size < n_con )
+   {  con_vec_.resize(n_con);
+      con_vec_.resize(size);
+   }
+}
+/*
+-------------------------------------------------------------------------------
 {xrst_begin val_set_dep dev}
 
 Setting the Dependent Variables
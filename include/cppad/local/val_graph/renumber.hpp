@@ -2,9 +2,12 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_RENUMBER_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ---------------------------------------------------------------------------
+# include <algorithm>
 # include <cppad/local/val_graph/op_hash_table.hpp>
+# include <cppad/local/val_graph/enable_parallel.hpp>
+# include <cppad/local/std_thread_team.hpp>
 
 /*
 -------------------------------------------------------------------------------
@@ -33,6 +36,45 @@ results for the equivalent previous operator with lowest index.
 This creates an equivalent tape where replaced operators are not removed,
 but the are dead code in the new tape.
 
+num_thread
+**********
+This is the number of threads used to find equivalent operators.
+If it is not present, its value is one.
+It must be greater than zero and less than or equal
+:ref:`multi_thread@CPPAD_THREAD_LIMIT` .
+If *num_thread* is one, or the user has set up multi-threading
+(see :ref:`for_jac_sparsity@num_thread` ),
+the operators are processed sequentially in order.
+
+Levels
+======
+If *num_thread* is greater than one, the operators are grouped by level.
+An operator that does not use any results of other operators
+(for example a constant operator) is at level zero.
+The level of other operators is one plus the maximum level for the
+operators that compute its arguments.
+Equivalent operators have the same level,
+and operators at the same level do not depend on each other.
+Hence the levels are processed in order and the operators in a level
+can be processed in parallel.
+
+Parallel Matching
+=================
+The operators in a level that has at least *num_thread* times 1000 operators
+are processed using *num_thread* threads:
+
+#. Each thread computes the hash code for a contiguous part of the level.
+#. Each thread searches for matches, in the order of the operator indices,
+   for the operators whose hash code modulo *num_thread* is equal to
+   its thread number.
+   Thus each hash code is only used by one thread.
+
+The operators in smaller levels are processed sequentially.
+The result is the same as when *num_thread* is one.
+The threads are created using the same method as in
+:ref:`for_jac_sparsity@num_thread` ;
+i.e., a :ref:`thread_pool-name` is used when one exists.
+
 Compare Operators
 *****************
 If two or more compare operators are identical, the first will be kept as
@@ -55,11 +97,14 @@ Reference
 
 {xrst_toc_hidden
    val_graph/renumber_xam.cpp
+   val_graph/renumber_thread_xam.cpp
 }
 Example
 *******
 The file :ref:`renumber_xam.cpp <val_renumber_xam.cpp-name>` is an
 example and test of tape.renumber().
+The file :ref:`renumber_thread_xam.cpp <val_renumber_thread_xam.cpp-name>`
+is an example and test of tape.renumber( *num_thread* ).
 
 {xrst_end val_tape_renumber}
 -------------------------------------------------------------------------------
@@ -68,13 +113,20 @@ namespace CppAD { namespace local { namespace val_graph {
 
 // BEGIN_RENUMBER
 template <class Value>
-void tape_t<Value>::renumber(void)
+void tape_t<Value>::renumber(size_t num_thread)
 // END_RENUMBER
 {
    // -----------------------------------------------------------------------
    // SAS Global Value Renumbering
    // https://en.wikipedia.org/wiki/Value_numbering
    // -----------------------------------------------------------------------
+   // timer
+   pass_timer_t timer( pass_time().renumber );
+   //
+   CPPAD_ASSERT_KNOWN( 0 < num_thread && num_thread <= CPPAD_THREAD_LIMIT,
+      "val_graph renumber: num_thread is zero or greater than "
+      "CPPAD_THREAD_LIMIT"
+   );
 # if CPPAD_VAL_GRAPH_TAPE_TRACE
    // thread, initial_inuse
    size_t thread        = thread_alloc::thread_num();
@@ -101,9 +153,12 @@ void tape_t<Value>::renumber(void)
    for(addr_t i = 0; i < addr_t(n_val_); ++i)
       new_val_index[i] = i;
    //
-   // i_op
-   for(addr_t i_op = 0; i_op < n_op(); ++i_op)
-   {  //
+   // replace_op
+   // change the use of the i_op results to use of the j_op results.
+   // Only the thread that calls match_op for i_op calls replace_op for i_op.
+   auto replace_op = [&](addr_t i_op, addr_t j_op)
+   {  assert( j_op < i_op );
+      //
       // op_ptr
       const base_op_t<Value>* op_ptr   = base_op_ptr(i_op);
       //
@@ -111,29 +166,151 @@ void tape_t<Value>::renumber(void)
       addr_t arg_index_i = op2arg_index[i_op];
       addr_t res_index_i = op2res_index[i_op];
       //
-      // j_op
-      addr_t j_op = op_hash_table.match_op(i_op, new_val_index);
-      if( j_op != i_op )
-      {  assert( j_op < i_op );
-         //
-         // new_val_index
-         // mapping so that op_j results will be used instead of op_i results;
-         // i.e., op_i becomes dead code.
-         addr_t res_index_j = op2res_index[j_op];
-         addr_t n_res       = op_ptr->n_res(arg_index_i, arg_vec_);
-         if( n_res == 0 )
+      // new_val_index
+      // mapping so that op_j results will be used instead of op_i results;
+      // i.e., op_i becomes dead code.
+      addr_t res_index_j = op2res_index[j_op];
+      addr_t n_res       = op_ptr->n_res(arg_index_i, arg_vec_);
+      if( n_res == 0 )
+      {  //
+         // change the i_op operator to a no op
+         if( op_ptr->op_enum() == pri_op_enum )
+            arg_vec_[arg_index_i + 2] = this->n_ind();
+         else
+         {
+            CPPAD_ASSERT_UNKNOWN( op_ptr->op_enum() == comp_op_enum );
+            arg_vec_[arg_index_i + 0] = compare_no_enum;
+         }
+      }
+      else for(addr_t k = 0; k < n_res; ++k)
+         new_val_index[res_index_i + k] = res_index_j + k;
+   };
+   //
+   // n_job
+   size_t n_job = num_thread;
+   if( ! local::std_thread_team::available() )
+      n_job = 1;
+   //
+   if( n_job == 1 )
+   {  //
+      // i_op
+      for(addr_t i_op = 0; i_op < n_op(); ++i_op)
+      {  //
+         // j_op
+         addr_t j_op = op_hash_table.match_op(i_op, new_val_index);
+         if( j_op != i_op )
+            replace_op(i_op, j_op);
+      }
+   }
+   else
+   {  //
+      // op_level, n_level
+      // val_level[i] is zero if value i is independent and otherwise
+      // one plus the level of the operator that computes value i.
+      Vector<addr_t> op_level( n_op() );
+      addr_t         n_level = 0;
+      {  Vector<addr_t> val_level( n_val_ );
+         for(addr_t i = 0; i < n_ind_; ++i)
+            val_level[i] = 0;
+         for(addr_t i_op = 0; i_op < n_op(); ++i_op)
          {  //
-            // change the i_op operator to a no op
-            if( op_ptr->op_enum() == pri_op_enum )
-               arg_vec_[arg_index_i + 2] = this->n_ind();
-            else
-            {
-               CPPAD_ASSERT_UNKNOWN( op_ptr->op_enum() == comp_op_enum );
-               arg_vec_[arg_index_i + 0] = compare_no_enum;
+            // op_ptr, arg_index, n_arg, n_before, n_after
+            const base_op_t<Value>* op_ptr = base_op_ptr(i_op);
+            addr_t arg_index = op2arg_index[i_op];
+            addr_t n_arg     = op_ptr->n_arg(arg_index, arg_vec_);
+            addr_t n_before  = op_ptr->n_before();
+            addr_t n_after   = op_ptr->n_after();
+            //
+            // level
+            addr_t level = 0;
+            for(addr_t k = n_before; k < n_arg - n_after; ++k)
+               level = std::max(level, val_level[ arg_vec_[arg_index + k] ]);
+            //
+            // op_level, val_level, n_level
+            op_level[i_op]   = level;
+            addr_t res_index = op2res_index[i_op];
+            addr_t n_res     = op_ptr->n_res(arg_index, arg_vec_);
+            for(addr_t k = 0; k < n_res; ++k)
+               val_level[res_index + k] = level + 1;
+            n_level = std::max(n_level, level + 1);
+         }
+      }
+      //
+      // level_start, level_op
+      // The operators at level ell are level_op[k] for k = level_start[ell],
+      // ..., level_start[ell+1]-1 and they are in increasing order.
+      Vector<addr_t> level_start(n_level + 1), level_op( n_op() );
+      for(addr_t ell = 0; ell <= n_level; ++ell)
+         level_start[ell] = 0;
+      for(addr_t i_op = 0; i_op < n_op(); ++i_op)
+         ++level_start[ op_level[i_op] + 1 ];
+      for(addr_t ell = 0; ell < n_level; ++ell)
+         level_start[ell + 1] += level_start[ell];
+      for(addr_t i_op = 0; i_op < n_op(); ++i_op)
+      {  // op_level[i_op] is no longer needed and becomes the next position
+         // for its level.
+         addr_t ell        = op_level[i_op];
+         op_level[i_op]    = level_start[ell]++;
+         level_op[ op_level[i_op] ] = i_op;
+      }
+      for(addr_t ell = n_level; 0 < ell; --ell)
+         level_start[ell] = level_start[ell - 1];
+      level_start[0] = 0;
+      //
+      // op_per_job
+      // minimum number of operators per job for a level to be
+      // processed in parallel
+      size_t op_per_job = 1000;
+      //
+      // code_vec
+      Vector<addr_t> code_vec;
+      //
+      // enable_parallel
+      enable_parallel<Value>();
+      //
+      // ell
+      for(addr_t ell = 0; ell < n_level; ++ell)
+      {  //
+         // begin, end
+         size_t begin = size_t( level_start[ell] );
+         size_t end   = size_t( level_start[ell + 1] );
+         //
+         if( end - begin < n_job * op_per_job )
+         {  for(size_t k = begin; k < end; ++k)
+            {  addr_t i_op = level_op[k];
+               addr_t j_op = op_hash_table.match_op(i_op, new_val_index);
+               if( j_op != i_op )
+                  replace_op(i_op, j_op);
             }
          }
-         else for(addr_t k = 0; k < n_res; ++k)
-            new_val_index[res_index_i + k] = res_index_j + k;
+         else
+         {  //
+            // code_vec
+            code_vec.resize(end - begin);
+            auto code_job = [&](size_t job)
+            {  size_t k_begin = begin + (end - begin) * job / n_job;
+               size_t k_end   = begin + (end - begin) * (job + 1) / n_job;
+               for(size_t k = k_begin; k < k_end; ++k)
+                  code_vec[k - begin] =
+                     op_hash_table.code(level_op[k], new_val_index);
+            };
+            local::std_thread_team::run(n_job, code_job);
+            //
+            // new_val_index
+            auto match_job = [&](size_t job)
+            {  for(size_t k = begin; k < end; ++k)
+               {  addr_t code = code_vec[k - begin];
+                  if( size_t(code) % n_job == job )
+                  {  addr_t i_op = level_op[k];
+                     addr_t j_op =
+                        op_hash_table.match_op(i_op, new_val_index, code);
+                     if( j_op != i_op )
+                        replace_op(i_op, j_op);
+                  }
+               }
+            };
+            local::std_thread_team::run(n_job, match_job);
+         }
       }
    }
    //
@@ -0,0 +1,516 @@
+# ifndef  CPPAD_LOCAL_VAL_GRAPH_SIMPLIFY_HPP
+# define  CPPAD_LOCAL_VAL_GRAPH_SIMPLIFY_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
+// ---------------------------------------------------------------------------
+# include <cppad/local/val_graph/tape.hpp>
+/*
+-------------------------------------------------------------------------------
+{xrst_begin val_tape_simplify dev}
+{xrst_spell
+   dep
+   sqrt
+   xam
+}
+
+Algebraic Simplification
+########################
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_SIMPLIFY
+   // END_SIMPLIFY
+}
+
+Algorithm
+*********
+#. A forward pass is made through the operators and each one is
+   copied to a new tape.
+#. Before a unary or binary operator is copied,
+   the rules in the table below are checked in order.
+   The first rule that applies replaces the operator by a simpler
+   expression in the new tape.
+#. The rules use the new tape to determine if an argument is a constant,
+   or the result of a particular operator.
+   Hence simplifications cascade; e.g., ( *x* * 1 ) + 0 becomes *x* .
+#. Operators that are no longer used are not removed; i.e.,
+   they are dead code in the new tape.
+
+The :ref:`val_tape_renumber-name` pass should be run before this pass
+so that identical arguments have the same value index;
+e.g., so that *x* - *x* can be detected.
+
+simplify_all
+************
+see :ref:`val_tape_option@simplify_all` .
+If this option is false, only the rules that are exact are applied.
+An exact rule gives the same result for all argument values,
+including infinity and nan (the sign of a zero result may change).
+If this option is true, all of the rules are applied.
+The other rules may change the result for some argument values
+or change the rounding of the result.
+For example, the :ref:`AD\<Base\><mul-name>` operator already assumes
+that zero times a variable is zero.
+
+Rules
+*****
+In the table below, *x* is a value, *c* is a constant value,
+and the name of a rule is only used for tracing.
+
+.. csv-table::
+   :header-rows: 1
+
+   Name,        Exact, Operator,              Replacement
+   add_zero,    true,  *x* + 0 or 0 + *x*,    *x*
+   sub_zero,    true,  *x* - 0,               *x*
+   zero_sub,    true,  0 - *x*,               - *x*
+   mul_one,     true,  *x* * 1 or 1 * *x*,    *x*
+   div_one,     true,  *x* / 1,               *x*
+   pow_one,     true,  pow( *x* , 1 ),        *x*
+   neg_neg,     true,  - ( - *x* ),           *x*
+   mul_zero,    false, *x* * 0 or 0 * *x*,    0
+   sub_self,    false, *x* - *x*,             0
+   div_self,    false, *x* / *x*,             1
+   div_con,     false, *x* / *c* ,            *x* * ( 1 / *c* )
+   pow_con,     false, pow( *x* , *c* ),      see below
+   exp_log,     false, exp( log( *x* ) ),     *x*
+   log_exp,     false, log( exp( *x* ) ),     *x*
+
+div_con
+=======
+This rule is not applied when *c* is zero.
+
+pow_con
+=======
+This rule is applied when *c* is one of the following values:
+
+.. csv-table::
+   :header-rows: 1
+
+   *c*,  Replacement
+   0,    1
+   2,    *x* * *x*
+   3,    ( *x* * *x* ) * *x*
+   4,    ( *x* * *x* ) * ( *x* * *x* )
+   -1,   1 / *x*
+   0.5,  sqrt( *x* )
+
+Changes
+*******
+Only the following values, for this tape, are guaranteed to be same:
+#. The number of independent values :ref:`val_tape@n_ind` .
+#. The size of the dependent vector :ref:`dep_vec.size() <val_tape@dep_vec>` .
+#. The mapping from the independent to the dependent variables
+   (see simplify_all above).
+
+{xrst_toc_hidden
+   val_graph/simplify_xam.cpp
+}
+Example
+*******
+The file :ref:`simplify_xam.cpp <val_simplify_xam.cpp-name>` is an
+example and test of tape.simplify().
+
+{xrst_end val_tape_simplify}
+-------------------------------------------------------------------------------
+*/
+namespace CppAD { namespace local { namespace val_graph {
+
+// simplify_work_t
+// The new tape and information about its values that the rules use.
+template <class Value>
+class simplify_work_t {
+private:
+   //
+   // new_tape_
+   tape_t<Value>& new_tape_;
+   //
+   // val_op_
+   // val_op_[i] is the operator that computes value i in the new tape
+   // (number_op_enum for independent values).
+   Vector<uint8_t> val_op_;
+   //
+   // val_arg_
+   // val_arg_[i] is the index in new_tape_.arg_vec() of the first argument
+   // for the operator that computes value i.
+   Vector<addr_t> val_arg_;
+   //
+   // n_op_
+   // number of operators in the new tape that are in val_op_.
+   addr_t n_op_;
+   //
+   // n_arg_
+   // size of new_tape_.arg_vec() when there were n_op_ operators.
+   addr_t n_arg_;
+public:
+   // work(new_tape)
+   simplify_work_t(tape_t<Value>& new_tape)
+   : new_tape_(new_tape), n_op_(0), n_arg_(0)
+   {  for(addr_t i = 0; i < new_tape.n_ind(); ++i)
+      {  val_op_.push_back( uint8_t( number_op_enum ) );
+         val_arg_.push_back( 0 );
+      }
+      sync();
+   }
+   //
+   // sync()
+   // update val_op_ and val_arg_ after an operator is recorded
+   void sync(void)
+   {  op_enum_t op_enum = number_op_enum;
+      addr_t    arg_index = 0;
+      if( n_op_ < new_tape_.n_op() )
+      {  CPPAD_ASSERT_UNKNOWN( n_op_ + 1 == new_tape_.n_op() );
+         op_enum   = new_tape_.base_op_ptr(n_op_)->op_enum();
+         arg_index = n_arg_;
+         n_op_     = new_tape_.n_op();
+         n_arg_    = addr_t( new_tape_.arg_vec().size() );
+      }
+      while( val_op_.size() < size_t( new_tape_.n_val() ) )
+      {  val_op_.push_back( uint8_t( op_enum ) );
+         val_arg_.push_back( arg_index );
+      }
+   }
+   //
+   // op_enum = work.op_enum(val_index)
+   op_enum_t op_enum(addr_t val_index) const
+   {  return op_enum_t( val_op_[val_index] ); }
+   //
+   // arg = work.arg(val_index)
+   // first argument for the unary operator that computes val_index
+   addr_t arg(addr_t val_index) const
+   {  return new_tape_.arg_vec()[ val_arg_[val_index] ]; }
+   //
+   // is_con = work.is_con(val_index, value)
+   // is val_index a constant that is identically equal to value
+   bool is_con(addr_t val_index, const Value& value) const
+   {  if( op_enum_t( val_op_[val_index] ) != con_op_enum )
+         return false;
+      addr_t con_index = new_tape_.arg_vec()[ val_arg_[val_index] ];
+      return IdenticalEqualCon( new_tape_.con_vec()[con_index], value );
+   }
+   //
+   // is_con = work.is_con(val_index)
+   bool is_con(addr_t val_index) const
+   {  return op_enum_t( val_op_[val_index] ) == con_op_enum; }
+   //
+   // value = work.con(val_index)
+   const Value& con(addr_t val_index) const
+   {  CPPAD_ASSERT_UNKNOWN( is_con(val_index) );
+      addr_t con_index = new_tape_.arg_vec()[ val_arg_[val_index] ];
+      return new_tape_.con_vec()[con_index];
+   }
+   //
+   // res_index = work.record_con(value)
+   addr_t record_con(const Value& value)
+   {  addr_t res_index = new_tape_.record_con_op(value);
+      sync();
+      return res_index;
+   }
+   //
+   // res_index = work.record_op(op_enum, left, right)
+   addr_t record_op(op_enum_t op_enum, addr_t left, addr_t right)
+   {  Vector<addr_t> op_arg(2);
+      op_arg[0] = left;
+      op_arg[1] = right;
+      addr_t res_index = new_tape_.record_op(op_enum, op_arg);
+      sync();
+      return res_index;
+   }
+   //
+   // res_index = work.record_op(op_enum, arg)
+   addr_t record_op(op_enum_t op_enum, addr_t arg)
+   {  Vector<addr_t> op_arg(1);
+      op_arg[0] = arg;
+      addr_t res_index = new_tape_.record_op(op_enum, op_arg);
+      sync();
+      return res_index;
+   }
+};
+//
+// simplify_rule_t
+// If a rule applies to the operator with new argument indices arg,
+// it sets res to the new value index for the result and returns true.
+// Otherwise it returns false.
+template <class Value>
+struct simplify_rule_t {
+   const char* name;
+   op_enum_t   op_enum;
+   bool        exact;
+   bool (*apply)(simplify_work_t<Value>& work, const addr_t* arg, addr_t& res);
+};
+// ---------------------------------------------------------------------------
+// add_zero
+template <class Value> bool simplify_add_zero(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( work.is_con(arg[1], Value(0)) )
+      res = arg[0];
+   else if( work.is_con(arg[0], Value(0)) )
+      res = arg[1];
+   else
+      return false;
+   return true;
+}
+// sub_zero
+template <class Value> bool simplify_sub_zero(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( ! work.is_con(arg[1], Value(0)) )
+      return false;
+   res = arg[0];
+   return true;
+}
+// zero_sub
+template <class Value> bool simplify_zero_sub(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( ! work.is_con(arg[0], Value(0)) )
+      return false;
+   res = work.record_op(neg_op_enum, arg[1]);
+   return true;
+}
+// mul_one
+template <class Value> bool simplify_mul_one(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( work.is_con(arg[1], Value(1)) )
+      res = arg[0];
+   else if( work.is_con(arg[0], Value(1)) )
+      res = arg[1];
+   else
+      return false;
+   return true;
+}
+// div_one, pow_one
+template <class Value> bool simplify_right_one(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( ! work.is_con(arg[1], Value(1)) )
+      return false;
+   res = arg[0];
+   return true;
+}
+// neg_neg
+template <class Value> bool simplify_neg_neg(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( work.op_enum(arg[0]) != neg_op_enum )
+      return false;
+   res = work.arg(arg[0]);
+   return true;
+}
+// mul_zero
+template <class Value> bool simplify_mul_zero(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  bool zero = work.is_con(arg[0], Value(0));
+   zero     |= work.is_con(arg[1], Value(0));
+   if( ! zero )
+      return false;
+   res = work.record_con( Value(0) );
+   return true;
+}
+// sub_self
+template <class Value> bool simplify_sub_self(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( arg[0] != arg[1] )
+      return false;
+   res = work.record_con( Value(0) );
+   return true;
+}
+// div_self
+template <class Value> bool simplify_div_self(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( arg[0] != arg[1] )
+      return false;
+   res = work.record_con( Value(1) );
+   return true;
+}
+// div_con
+template <class Value> bool simplify_div_con(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( ! work.is_con(arg[1]) || work.is_con(arg[1], Value(0)) )
+      return false;
+   addr_t inverse = work.record_con( Value(1) / work.con(arg[1]) );
+   res            = work.record_op(mul_op_enum, arg[0], inverse);
+   return true;
+}
+// pow_con
+template <class Value> bool simplify_pow_con(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  addr_t x = arg[0];
+   if( work.is_con(arg[1], Value(0)) )
+      res = work.record_con( Value(1) );
+   else if( work.is_con(arg[1], Value(2)) )
+      res = work.record_op(mul_op_enum, x, x);
+   else if( work.is_con(arg[1], Value(3)) )
+   {  addr_t square = work.record_op(mul_op_enum, x, x);
+      res           = work.record_op(mul_op_enum, square, x);
+   }
+   else if( work.is_con(arg[1], Value(4)) )
+   {  addr_t square = work.record_op(mul_op_enum, x, x);
+      res           = work.record_op(mul_op_enum, square, square);
+   }
+   else if( work.is_con(arg[1], Value(-1)) )
+   {  addr_t one = work.record_con( Value(1) );
+      res        = work.record_op(div_op_enum, one, x);
+   }
+   else if( work.is_con(arg[1], Value(0.5)) )
+      res = work.record_op(sqrt_op_enum, x);
+   else
+      return false;
+   return true;
+}
+// exp_log, log_exp
+template <op_enum_t inverse_op_enum, class Value> bool simplify_inverse(
+   simplify_work_t<Value>& work, const addr_t* arg, addr_t& res)
+{  if( work.op_enum(arg[0]) != inverse_op_enum )
+      return false;
+   res = work.arg(arg[0]);
+   return true;
+}
+// ---------------------------------------------------------------------------
+// BEGIN_SIMPLIFY
+template <class Value>
+void tape_t<Value>::simplify(void)
+// END_SIMPLIFY
+{  // timer
+   pass_timer_t timer( pass_time().simplify );
+   //
+# if CPPAD_VAL_GRAPH_TAPE_TRACE
+   // thread, initial_inuse
+   size_t thread        = thread_alloc::thread_num();
+   size_t initial_inuse = thread_alloc::inuse(thread);
+# endif
+   //
+   // simplify_all
+   bool simplify_all = option_map_["simplify_all"] == "true";
+   //
+   // rule_table
+   const simplify_rule_t<Value> rule_table[] = {
+      { "add_zero", add_op_enum, true,  simplify_add_zero<Value>          },
+      { "sub_zero", sub_op_enum, true,  simplify_sub_zero<Value>          },
+      { "zero_sub", sub_op_enum, true,  simplify_zero_sub<Value>          },
+      { "mul_one",  mul_op_enum, true,  simplify_mul_one<Value>           },
+      { "div_one",  div_op_enum, true,  simplify_right_one<Value>         },
+      { "pow_one",  pow_op_enum, true,  simplify_right_one<Value>         },
+      { "neg_neg",  neg_op_enum, true,  simplify_neg_neg<Value>           },
+      { "mul_zero", mul_op_enum, false, simplify_mul_zero<Value>          },
+      { "sub_self", sub_op_enum, false, simplify_sub_self<Value>          },
+      { "div_self", div_op_enum, false, simplify_div_self<Value>          },
+      { "div_con",  div_op_enum, false, simplify_div_con<Value>           },
+      { "pow_con",  pow_op_enum, false, simplify_pow_con<Value>           },
+      { "exp_log",  exp_op_enum, false,
+         simplify_inverse<log_op_enum, Value>                             },
+      { "log_exp",  log_op_enum, false,
+         simplify_inverse<exp_op_enum, Value>                             }
+   };
+   size_t n_rule = sizeof(rule_table) / sizeof(rule_table[0]);
+   //
+   // rule_count
+   Vector<size_t> rule_count(n_rule);
+   for(size_t i_rule = 0; i_rule < n_rule; ++i_rule)
+      rule_count[i_rule] = 0;
+   //
+   // new_tape
+   tape_t new_tape;
+   new_tape.set_ind(n_ind_);
+   new_tape.reserve( size_t( n_op() ), arg_vec_.size(), con_vec_.size() );
+   //
+   // work
+   simplify_work_t<Value> work(new_tape);
+   //
+   // new_which_vec
+   Vector<addr_t> new_which_vec( vec_initial_.size() );
+   for(size_t i = 0; i < vec_initial_.size(); ++i)
+      new_which_vec[i] = addr_t( vec_initial_.size() );
+   //
+   // new_val_index
+   // include nan at index n_ind_ in val_vec
+   Vector<addr_t> new_val_index( n_val_ );
+   for(addr_t i = 0; i <= n_ind_; ++i)
+      new_val_index[i] = addr_t(i);
+   //
+   // val_use_case
+   // all of the values are copied to the new tape
+   Vector<addr_t> val_use_case( n_val_ );
+   for(addr_t i = 0; i < n_val_; ++i)
+      val_use_case[i] = 1;
+   //
+   // op_arg, record_work
+   addr_t         op_arg[2];
+   Vector<addr_t> record_work;
+   //
+   // op_itr
+   op_iterator<Value> op_itr(*this, 0);
+   //
+   // i_op
+   for(addr_t i_op = 1; i_op < n_op(); ++i_op)
+   {  //
+      // op_itr
+      ++op_itr; // skip nan at index zero
+      //
+      // op_ptr, arg_index, res_index
+      const base_op_t<Value>* op_ptr    = op_itr.op_ptr();
+      addr_t                  arg_index = op_itr.arg_index();
+      addr_t                  res_index = op_itr.res_index();
+      //
+      // op_enum, n_res
+      op_enum_t  op_enum   = op_ptr->op_enum();
+      addr_t     n_res     = op_ptr->n_res(arg_index, arg_vec_);
+      //
+      // new_res_index, simplified
+      addr_t new_res_index = 0;
+      bool   simplified    = false;
+      if( op_ptr->is_unary() || op_ptr->is_binary() )
+      {  op_arg[0] = new_val_index[ arg_vec_[arg_index + 0] ];
+         if( op_ptr->is_binary() )
+            op_arg[1] = new_val_index[ arg_vec_[arg_index + 1] ];
+         for(size_t i_rule = 0; i_rule < n_rule && ! simplified; ++i_rule)
+         {  const simplify_rule_t<Value>& rule = rule_table[i_rule];
+            if( rule.op_enum == op_enum && (rule.exact || simplify_all) )
+            {  simplified = rule.apply(work, op_arg, new_res_index);
+               if( simplified )
+                  ++rule_count[i_rule];
+            }
+         }
+      }
+      if( ! simplified )
+      {  new_res_index = record_new(
+            new_tape        ,
+            new_which_vec   ,
+            record_work     ,
+            new_val_index   ,
+            val_use_case    ,
+            op_ptr          ,
+            arg_index       ,
+            res_index
+         );
+         work.sync();
+      }
+      //
+      // new_val_index
+      for(addr_t k = 0; k < n_res; ++k)
+         new_val_index[ res_index + k ] = new_res_index + k;
+   }
+   //
+   // dep_vec
+   Vector<addr_t> dep_vec( dep_vec_.size() );
+   for(size_t k = 0; k < dep_vec_.size(); ++k)
+      dep_vec[k] = new_val_index[ dep_vec_[k] ];
+   new_tape.set_dep( dep_vec );
+   //
+   // swap
+   swap(new_tape);
+   //
+# if CPPAD_VAL_GRAPH_TAPE_TRACE
+   // rule_count
+   for(size_t i_rule = 0; i_rule < n_rule; ++i_rule)
+   {  std::cout << "simplify: " << rule_table[i_rule].name;
+      std::cout << " = " << rule_count[i_rule] << "\n";
+   }
+   // inuse
+   size_t final_inuse = thread_alloc::inuse(thread);
+   std::cout << "simplify:   inuse = " << final_inuse - initial_inuse << "\n";
+# endif
+   return;
+}
+
+} } } // END_CPPAD_LOCAL_VAL_GRAPH_NAMESPACE
+
+# endif
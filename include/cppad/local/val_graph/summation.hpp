@@ -2,10 +2,11 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_SUMMATION_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ---------------------------------------------------------------------------
 # include <cppad/local/val_graph/tape.hpp>
 # include <cppad/local/val_graph/rev_depend.hpp>
+# include <deque>
 namespace CppAD { namespace local { namespace val_graph {
 /*
 ------------------------------------------------------------------------------
@@ -172,6 +173,9 @@ template <class Value>
 void tape_t<Value>::summation(void)
 // END_SUMMATION
 {  //
+   // timer
+   pass_timer_t timer( pass_time().summation );
+   //
 # if CPPAD_VAL_GRAPH_TAPE_TRACE
    // thread, initial_inuse
    size_t thread        = thread_alloc::thread_num();
@@ -181,9 +185,43 @@ void tape_t<Value>::summation(void)
    // op_arg
    Vector<addr_t> op_arg;
    //
-   // csum_map
-   // information for all the cumulative summation operations
-   std::map<addr_t, csum_info_t> csum_map;
+   // csum_index, csum_info_vec
+   // If csum_index[i_op] is not invalid_index,
+   // csum_info_vec[ csum_index[i_op] ] is the information for the
+   // cumulative summation that will replace operator i_op.
+   // A deque is used so that references to its elements remain valid
+   // when it grows.
+   addr_t invalid_index = std::numeric_limits<addr_t>::max();
+   Vector<addr_t> csum_index( n_op() );
+   for(addr_t i_op = 0; i_op < n_op(); ++i_op)
+      csum_index[i_op] = invalid_index;
+   std::deque<csum_info_t> csum_info_vec;
+   //
+   // is_csum
+   auto is_csum = [&csum_index, invalid_index] (addr_t i_op)
+   {  return csum_index[i_op] != invalid_index;
+   };
+   //
+   // get_csum_info
+   // Information for operator i_op, create it if it does not exist.
+   auto get_csum_info = [&csum_index, &csum_info_vec, invalid_index]
+   (addr_t i_op) -> csum_info_t&
+   {  if( csum_index[i_op] == invalid_index )
+      {  csum_index[i_op] = addr_t( csum_info_vec.size() );
+         csum_info_vec.emplace_back();
+      }
+      return csum_info_vec[ size_t( csum_index[i_op] ) ];
+   };
+   //
+   // erase_csum_info
+   // Free the memory used by the information for operator i_op.
+   auto erase_csum_info = [&csum_index, &csum_info_vec, invalid_index]
+   (addr_t i_op)
+   {  csum_info_t& csum_info = csum_info_vec[ size_t( csum_index[i_op] ) ];
+      csum_info.add_list.clear();
+      csum_info.sub_list.clear();
+      csum_index[i_op] = invalid_index;
+   };
    //
    // sum_op
    auto sum_op = [] (op_enum_t op_enum)
@@ -260,10 +298,10 @@ void tape_t<Value>::summation(void)
          if( op_ptr_i->is_binary() )
             op_arg_equal_i = op_arg[0] == op_arg[1];
          //
-         // is_csum_i, csum_map[i_op]
-         bool is_csum_i  = 0 < csum_map.count(i_op);
+         // is_csum_i, csum_info_vec
+         bool is_csum_i  = is_csum(i_op);
          if( is_csum_i )
-         {  csum_info_t& csum_info_i = csum_map[i_op];
+         {  csum_info_t& csum_info_i = get_csum_info(i_op);
             switch(op_enum_i)
             {  //
                default:
@@ -304,8 +342,8 @@ void tape_t<Value>::summation(void)
          {  // i_op is a dependent variable or used more than once
             //
             if( is_csum_i )
-            {  replace_csum_op(res_index_i, i_op, csum_map[i_op]);
-               csum_map.erase( i_op );
+            {  replace_csum_op(res_index_i, i_op, get_csum_info(i_op));
+               erase_csum_info( i_op );
             }
          }
          else
@@ -323,14 +361,14 @@ void tape_t<Value>::summation(void)
             if( ! sum_j )
             {  // The only use of i_op is not a summation operator
                if( is_csum_i )
-               {  replace_csum_op(res_index_i, i_op,  csum_map[i_op]);
-                  csum_map.erase( i_op );
+               {  replace_csum_op(res_index_i, i_op, get_csum_info(i_op));
+                  erase_csum_info( i_op );
                }
             }
             else
             {  // The only use of i_op result is in a summation operator
                //
-               // csum_map[i_op]
+               // csum_info_vec
                if( ! is_csum_i )
                {  csum_info_t csum_info;
                   switch(op_enum_i)
@@ -359,11 +397,11 @@ void tape_t<Value>::summation(void)
                      }
                      break;
                   }
-                  csum_map[i_op] = csum_info;
+                  get_csum_info(i_op) = std::move(csum_info);
                }
                //
                // csum_info_i
-               csum_info_t& csum_info_i = csum_map[i_op];
+               csum_info_t& csum_info_i = get_csum_info(i_op);
                //
                // second_operand
                bool second_operand = false;
@@ -379,13 +417,8 @@ void tape_t<Value>::summation(void)
                   );
                }
                //
-               // is_csum_j
-               bool is_csum_j = 0 < csum_map.count(j_op);
-               //
-               // csum_map[j_op]
-               if( ! is_csum_j )
-                  csum_map[j_op] = csum_info_t();
-               csum_info_t& csum_info_j = csum_map[j_op];
+               // csum_info_j
+               csum_info_t& csum_info_j = get_csum_info(j_op);
                switch( op_enum_j )
                {  //
                   default:
@@ -2,12 +2,13 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_TAPE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/local/val_graph/op_iterator.hpp>
 # include <cppad/local/val_graph/op_enum2class.hpp>
 # include <cppad/local/val_graph/val_type.hpp>
 # include <cppad/local/val_graph/op_iterator.hpp>
+# include <cppad/local/val_graph/pass_time.hpp>
 
 # define CPPAD_VAL_GRAPH_TAPE_TRACE 0
 
@@ -171,6 +172,7 @@ Operations on Tape
 {xrst_toc_table
    include/cppad/local/val_graph/cumulative.hpp
    include/cppad/local/val_graph/dead_code.hpp
+   include/cppad/local/val_graph/eval_plan.hpp
    include/cppad/local/val_graph/fold_con.hpp
    include/cppad/local/val_graph/op2arg_index.hpp
    include/cppad/local/val_graph/op_hash_table.hpp
@@ -181,6 +183,7 @@ Operations on Tape
    include/cppad/local/val_graph/compress.hpp
    include/cppad/local/val_graph/renumber.hpp
    include/cppad/local/val_graph/rev_depend.hpp
+   include/cppad/local/val_graph/simplify.hpp
    include/cppad/local/val_graph/summation.hpp
 }
 {xrst_comment END_SORT_THIS_LINE_MINUS_2}
@@ -372,6 +375,9 @@ public :
    // set_ind
    addr_t set_ind(addr_t n_ind);
    //
+   // reserve
+   void reserve(size_t n_op, size_t n_arg, size_t n_con);
+   //
    // record_op
    addr_t record_op(op_enum_t op_enum, const Vector<addr_t>& op_arg);
    //
@@ -445,7 +451,10 @@ public :
    void fold_con(void);
    //
    // renumber
-   void renumber(void);
+   void renumber(size_t num_thread = 1);
+   //
+   // simplify
+   void simplify(void);
    //
    // rev_depend
    void rev_depend(
@@ -512,6 +521,7 @@ public :
 // BEGIN_SORT_THIS_LINE_PLUS_1
 # include <cppad/local/val_graph/cumulative.hpp>
 # include <cppad/local/val_graph/dead_code.hpp>
+# include <cppad/local/val_graph/eval_plan.hpp>
 # include <cppad/local/val_graph/fold_con.hpp>
 # include <cppad/local/val_graph/op2arg_index.hpp>
 # include <cppad/local/val_graph/op_hash_table.hpp>
@@ -520,6 +530,7 @@ public :
 # include <cppad/local/val_graph/record_new.hpp>
 # include <cppad/local/val_graph/compress.hpp>
 # include <cppad/local/val_graph/renumber.hpp>
+# include <cppad/local/val_graph/simplify.hpp>
 # include <cppad/local/val_graph/summation.hpp>
 // END_SORT_THIS_LINE_MINUS_1
 
@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_VAL2FUN_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // --------------------------------------------------------------------------
 /*
 {xrst_begin val2fun_graph dev}
@@ -135,6 +135,10 @@ void ADFun<Base, RecBase>::val2fun(
    const CppAD::vectorBool&                                use_val   )
 // END_PROTOTYPE
 {  //
+   // timer
+   using local::val_graph::pass_timer_t;
+   pass_timer_t timer( local::val_graph::pass_time().val2fun );
+   //
    // vector
    using CppAD::local::val_graph::Vector;
    //
@@ -956,6 +960,7 @@ void ADFun<Base, RecBase>::val2fun(
    compare_change_count_      = 1;
    compare_change_number_     = 0;
    compare_change_op_index_   = 0;
+   num_skip_op_               = 0;
    num_order_taylor_          = 0;
    cap_order_taylor_          = 0;
    num_direction_taylor_      = 0;
@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_VAL_OPTIMIZE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // --------------------------------------------------------------------------
 /*
 ------------------------------------------------------------------------------
@@ -38,11 +38,15 @@ template <class Base, class RecBase>
 void ADFun<Base, RecBase>::val_optimize(const std::string& options)
 // END_VAL_OPTIMIZE
 {  //
-   // compare_op, cumulative_sum_op, print_for_op,
+   // compare_op, cumulative_sum_op, print_for_op, simplify, simplify_all,
+   // num_thread
    local::optimize::options_t result = local::optimize::extract_option(options);
    bool compare_op          = result.compare_op;
    bool cumulative_sum_op   = result.cumulative_sum_op;
    bool print_for_op        = result.print_for_op;
+   bool simplify            = result.simplify;
+   bool simplify_all        = result.simplify_all;
+   size_t num_thread        = result.num_thread;
    //
    CPPAD_ASSERT_UNKNOWN( result.val_graph == true );
    CPPAD_ASSERT_KNOWN( result.conditional_skip == false,
@@ -80,7 +84,16 @@ void ADFun<Base, RecBase>::val_optimize(const std::string& options)
    val_tape.eval(trace, val_vec);
    */
    // val_tape: renumber
-   val_tape.renumber();
+   val_tape.renumber(num_thread);
+   //
+   // val_tape: simplify
+   if( simplify )
+   {  if( simplify_all )
+         val_tape.set_option("simplify_all", "true");
+      else
+         val_tape.set_option("simplify_all", "false");
+      val_tape.simplify();
+   }
    //
    // val_tape: fold_con();
    //
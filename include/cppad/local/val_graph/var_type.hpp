@@ -2,7 +2,7 @@
 # define  CPPAD_LOCAL_VAL_GRAPH_VAR_TYPE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 -------------------------------------------------------------------------------
@@ -64,6 +64,8 @@ inline void type_var_op(
       case CSumOp:
       case DisOp:
       case EndOp:
+      case FmavvpOp:
+      case FmavvvOp:
       case FunapOp:
       case FunavOp:
       case FunrpOp:
@@ -77,6 +79,7 @@ inline void type_var_op(
       case StpvOp:
       case StvpOp:
       case StvvOp:
+      case WSumOp:
       // END_SORT_THIS_LINE_MINUS_1
       is_unary   = false;
       is_binary  = false;
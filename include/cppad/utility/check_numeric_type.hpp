@@ -2,7 +2,7 @@
 # define CPPAD_UTILITY_CHECK_NUMERIC_TYPE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin CheckNumericType}
@@ -68,10 +68,8 @@ namespace CppAD {
 # else
    template <class NumericType>
    NumericType CheckNumericType(void)
-   {  // Section 3.6.2 of ISO/IEC 14882:1998(E) states: "The storage for
-      // objects with static storage duration (3.7.1) shall be zero-
-      // initialized (8.5) before any other initialization takes place."
-      static size_t count[CPPAD_MAX_NUM_THREADS];
+   {  // count[thread] is initialized as zero by the table constructor
+      static local::thread_table<size_t> count;
       size_t thread = thread_alloc::thread_num();
       if( count[thread] > 0  )
          return NumericType(0);
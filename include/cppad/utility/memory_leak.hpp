@@ -2,7 +2,7 @@
 # define CPPAD_UTILITY_MEMORY_LEAK_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin memory_leak app}
@@ -182,7 +182,7 @@ inline bool memory_leak(size_t add_static = 0)
       cout << "thread zero: available    = ";
       cout << num_bytes << endl;
    }
-   for(thread = 1; thread < CPPAD_MAX_NUM_THREADS; thread++)
+   for(thread = 1; thread < CPPAD_THREAD_LIMIT; thread++)
    {
       // check that no memory is currently in use for this thread
       num_bytes = thread_alloc::inuse(thread);
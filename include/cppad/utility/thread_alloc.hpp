@@ -2,13 +2,15 @@
 # define CPPAD_UTILITY_THREAD_ALLOC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <sstream>
 # include <limits>
 # include <memory>
 # include <cstdint>
+# include <atomic>
+# include <new>
 
 
 # ifdef _MSC_VER
@@ -21,6 +23,12 @@
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/define.hpp>
 # include <cppad/local/set_get_in_parallel.hpp>
+# include <cppad/local/thread_table.hpp>
+
+# if CPPAD_HAS_MMAP
+# include <sys/mman.h>
+# endif
+
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
 \file thread_alloc.hpp
@@ -40,6 +48,13 @@ Minimum number of double values that will fit in an allocation.
 */
 # define CPPAD_MIN_DOUBLE_CAPACITY 16
 
+/*!
+\def CPPAD_LARGE_MIN_BYTES
+Allocations with capacity greater than or equal this number of bytes
+are large; see thread_alloc::large_memory.
+*/
+# define CPPAD_LARGE_MIN_BYTES 16777216
+
 /*!
 \def CPPAD_TRACE_CAPACITY
 If NDEBUG is not defined, print all calls to get_memory and return_memory
@@ -82,6 +97,11 @@ private:
       size_t number;
       /// the different capacity values
       size_t value[CPPAD_MAX_NUM_CAPACITY];
+      /// start[b] is the first capacity index with value greater than
+      /// 2^(b-1); i.e., a starting point for min_bytes with b bits
+      size_t start[std::numeric_limits<size_t>::digits + 1];
+      /// index of the first large capacity; see CPPAD_LARGE_MIN_BYTES
+      size_t large_index;
       /// ctor
       capacity_t(void)
       {  // Cannot figure out how to call thread_alloc::in_parallel here.
@@ -98,6 +118,23 @@ private:
             capacity        = 3 * ( (capacity + 1) / 2 );
          }
          CPPAD_ASSERT_UNKNOWN( number > 0 );
+         //
+         // start
+         size_t n_bit = std::numeric_limits<size_t>::digits;
+         size_t c_index = 0;
+         start[0]       = 0;
+         for(size_t b = 1; b <= n_bit; ++b)
+         {  size_t half = size_t(1) << (b - 1);
+            while( c_index + 1 < number && value[c_index] <= half )
+               ++c_index;
+            start[b] = c_index;
+         }
+         //
+         // large_index
+         large_index = 0;
+         while( large_index < number &&
+            value[large_index] < CPPAD_LARGE_MIN_BYTES
+         )  ++large_index;
       }
    };
 
@@ -109,13 +146,16 @@ private:
       size_t             tc_index_;
       /// pointer to the next memory allocation with the same tc_index_
       void*              next_;
+      /// pointer to the next memory allocation in a remote free queue
+      void*              remote_next_;
       ///
       /// Calculated by include/cppad/CMakeLists.txt
       CPPAD_PADDING_BLOCK_T
       // -----------------------------------------------------------------
       /// make default constructor private. It is only used by constructor
       /// for `root arrays below.
-      block_t(void) : extra_(0), tc_index_(0), next_(nullptr)
+      block_t(void)
+      : extra_(0), tc_index_(0), next_(nullptr), remote_next_(nullptr)
       { }
    };
 
@@ -127,6 +167,35 @@ private:
       return &capacity;
    }
    // ---------------------------------------------------------------------
+public:
+   /// allocation statistics for one thread and capacity; see ta_stats
+   struct stats_capacity {
+      /// number of bytes in each allocation with this capacity
+      size_t capacity;
+      /// number of allocations with this capacity
+      size_t n_get;
+      /// number of allocations that used memory in the available pool
+      size_t n_hit;
+      /// number of allocations that have been returned
+      size_t n_return;
+      /// number of allocations currently in use
+      size_t n_inuse;
+      /// maximum value of n_inuse
+      size_t n_peak;
+      /// number of allocations currently in the available pool
+      size_t n_available;
+   };
+   /// allocation statistics for one thread; see ta_stats
+   struct stats_thread {
+      /// number of capacities in the capacity vector
+      size_t         number;
+      /// maximum number of bytes in use
+      size_t         peak_inuse;
+      /// statistics for each capacity
+      stats_capacity capacity[CPPAD_MAX_NUM_CAPACITY];
+   };
+private:
+   // ---------------------------------------------------------------------
    /// Structure of information for each thread
    struct thread_alloc_info {
       /// count of available bytes for this thread
@@ -142,8 +211,118 @@ private:
       this structure from the structure for the next thread.
       */
       block_t root_inuse_[CPPAD_MAX_NUM_CAPACITY];
+      /*!
+      Stack of memory allocations, for this thread, that were returned by
+      other threads in parallel mode and not yet processed by this thread.
+      The allocations are linked using block_t::remote_next_.
+      Other threads only push on this stack and this thread only removes
+      the entire stack so this is lock free (and does not have ABA problem).
+      */
+      std::atomic<void*> remote_free_;
+      /// count of available bytes that are in large allocations
+      size_t  count_large_available_;
+      /// maximum value of count_inuse_ (if CPPAD_THREAD_ALLOC_STATS)
+      size_t  peak_inuse_;
+      /// statistics for each capacity (if CPPAD_THREAD_ALLOC_STATS)
+      stats_capacity stats_[CPPAD_MAX_NUM_CAPACITY];
    };
    // ---------------------------------------------------------------------
+   /// settings that apply to large allocations; see large_memory
+   struct large_t {
+      /// maximum number of large available bytes held for each thread
+      size_t max_cache;
+      /// should transparent huge pages be requested for large allocations
+      bool   huge_page;
+   };
+   /*!
+   Get pointer to the settings for large allocations.
+
+   \return
+   is the current settings. Initially, max_cache is
+   4 * CPPAD_LARGE_MIN_BYTES and huge_page is false.
+   */
+   static large_t* large_info(void)
+   {  static large_t large = { 4 * CPPAD_LARGE_MIN_BYTES, false };
+      return &large;
+   }
+   // ---------------------------------------------------------------------
+   /*!
+   Number of bits necessary to represent a value.
+
+   \param x [in]
+   is the value we are representing.
+
+   \return
+   is the number of bits b such that x < 2^b and x >= 2^(b-1).
+   (If x is zero, the return value is zero.)
+   The number of operations does not depend on the value of x.
+   */
+   static size_t bit_length(size_t x)
+   {  size_t result = 0;
+      size_t shift  = std::numeric_limits<size_t>::digits / 2;
+      while( shift > 0 )
+      {  if( (x >> shift) != 0 )
+         {  x      >>= shift;
+            result  += shift;
+         }
+         shift /= 2;
+      }
+      CPPAD_ASSERT_UNKNOWN( x <= 1 );
+      return result + x;
+   }
+   // ---------------------------------------------------------------------
+   /*!
+   Get memory from the system for a new allocation.
+
+   \param c_index [in]
+   is the capacity index for this allocation.
+   If c_index is greater than or equal capacity_info()->large_index,
+   and CPPAD_HAS_MMAP is true, the memory is obtained using mmap.
+   Otherwise it is obtained using the system new operator.
+
+   \return
+   is the beginning of sizeof(block_t) + capacity bytes of memory.
+   */
+   static void* system_get(size_t c_index)
+   {  size_t n_bytes = sizeof(block_t) + capacity_info()->value[c_index];
+# if CPPAD_HAS_MMAP
+      if( c_index >= capacity_info()->large_index )
+      {  void* v_node = mmap(
+            nullptr, n_bytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+         );
+         if( v_node == MAP_FAILED )
+            throw std::bad_alloc();
+# ifdef MADV_HUGEPAGE
+         if( large_info()->huge_page )
+            madvise(v_node, n_bytes, MADV_HUGEPAGE);
+# endif
+         return v_node;
+      }
+# endif
+      return ::operator new(n_bytes);
+   }
+   /*!
+   Return memory, obtained using system_get, to the system.
+
+   \param v_node [in]
+   is the value returned by system_get.
+
+   \param c_index [in]
+   is the capacity index used in the call to system_get.
+   */
+   static void system_return(void* v_node, size_t c_index)
+   {
+# if CPPAD_HAS_MMAP
+      if( c_index >= capacity_info()->large_index )
+      {  size_t n_bytes = sizeof(block_t) + capacity_info()->value[c_index];
+         munmap(v_node, n_bytes);
+         return;
+      }
+# endif
+      ::operator delete(v_node);
+   }
+   // ---------------------------------------------------------------------
    /*!
    Set and Get hold available memory flag.
 
@@ -165,6 +344,34 @@ private:
    }
    // ---------------------------------------------------------------------
    /*!
+   Table containing the information pointer for each thread.
+
+   \return
+   is a reference to the table. The information pointer for a thread is
+   nullptr if it has not yet been allocated (or it has been cleared).
+   */
+   static local::thread_table<thread_alloc_info*>& info_table(void)
+   {  CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
+      static local::thread_table<thread_alloc_info*> all_info;
+      return all_info;
+   }
+   /*!
+   Does a thread have an information record.
+
+   \param thread [in]
+   Is the thread number for this information record.
+
+   \return
+   is true if thread_info(thread) would return an existing record; i.e.,
+   it would not need to allocate a new record.
+   This does not allocate any memory.
+   */
+   static bool has_info(size_t thread)
+   {  thread_alloc_info** info_ptr = info_table().find(thread);
+      return info_ptr != nullptr && *info_ptr != nullptr;
+   }
+   // ---------------------------------------------------------------------
+   /*!
    Get pointer to the information for this thread.
 
    \param thread [in]
@@ -191,12 +398,10 @@ private:
    static thread_alloc_info* thread_info(
       size_t             thread          ,
       bool               clear = false   )
-   {  static thread_alloc_info* all_info[CPPAD_MAX_NUM_THREADS];
-      static thread_alloc_info  zero_info;
-
-      CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
+   {  static thread_alloc_info  zero_info;
+      local::thread_table<thread_alloc_info*>& all_info = info_table();
 
-      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT );
 
       thread_alloc_info* info = all_info[thread];
       if( clear )
@@ -213,6 +418,7 @@ private:
                   info->root_available_[c].next_ == nullptr
                );
             }
+            CPPAD_ASSERT_UNKNOWN( info->remote_free_.load() == nullptr );
 # endif
             if( thread != 0 )
                ::operator delete( reinterpret_cast<void*>(info) );
@@ -237,11 +443,34 @@ private:
          }
          info->count_inuse_     = 0;
          info->count_available_ = 0;
+         info->remote_free_.store(nullptr, std::memory_order_relaxed);
+         info->count_large_available_ = 0;
+         stats_clear(info);
       }
       return info;
    }
    // -----------------------------------------------------------------------
    /*!
+   Set the allocation statistics for a thread to zero.
+
+   \param info [in,out]
+   is the information record for the thread.
+   */
+   static void stats_clear(thread_alloc_info* info)
+   {  info->peak_inuse_ = 0;
+      for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
+      {  stats_capacity& stats = info->stats_[c];
+         stats.capacity    = 0;
+         stats.n_get       = 0;
+         stats.n_hit       = 0;
+         stats.n_return    = 0;
+         stats.n_inuse     = 0;
+         stats.n_peak      = 0;
+         stats.n_available = 0;
+      }
+   }
+   // -----------------------------------------------------------------------
+   /*!
    Increase the number of bytes of memory that are currently in use; i.e.,
    that been obtained with get_memory and not yet returned.
 
@@ -267,6 +496,10 @@ private:
       CPPAD_ASSERT_UNKNOWN( result >= info->count_inuse_ );
 
       info->count_inuse_ = result;
+# if CPPAD_THREAD_ALLOC_STATS
+      if( info->peak_inuse_ < result )
+         info->peak_inuse_ = result;
+# endif
    }
    // -----------------------------------------------------------------------
    /*!
@@ -277,7 +510,7 @@ private:
    */
    static void inc_available(size_t inc, size_t thread)
    {
-      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT);
       CPPAD_ASSERT_UNKNOWN(
          thread == thread_num() || (! in_parallel())
       );
@@ -325,7 +558,7 @@ private:
    */
    static void dec_available(size_t dec, size_t thread)
    {
-      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT);
       CPPAD_ASSERT_UNKNOWN(
          thread == thread_num() || (! in_parallel())
       );
@@ -352,7 +585,7 @@ private:
    static size_t set_get_num_threads(size_t number_new)
    {  static size_t number_user = 1;
 
-      CPPAD_ASSERT_UNKNOWN( number_new <= CPPAD_MAX_NUM_THREADS );
+      CPPAD_ASSERT_UNKNOWN( number_new <= CPPAD_THREAD_LIMIT );
       CPPAD_ASSERT_UNKNOWN( ! in_parallel() || (number_new == 0) );
 
       // case where we are changing the number of threads
@@ -435,7 +668,8 @@ This argument has prototype
 
    ``size_t`` *num_threads*
 
-and must be greater than zero.
+and must be greater than zero and less than or equal
+:ref:`multi_thread@CPPAD_THREAD_LIMIT` .
 It specifies the number of threads that are sharing memory.
 The case *num_threads*  == 1 is a special case that is
 used to terminate a multi-threading environment.
@@ -520,7 +754,7 @@ contain examples and tests that use this function.
       }
 
       CPPAD_ASSERT_KNOWN(
-         num_threads <= CPPAD_MAX_NUM_THREADS ,
+         num_threads <= CPPAD_THREAD_LIMIT ,
          "parallel_setup: num_threads is too large"
       );
       CPPAD_ASSERT_KNOWN(
@@ -720,6 +954,11 @@ This allocation should be faster if the following conditions hold:
 #. The current *min_bytes* is between
    the previous *min_bytes* and previous *cap_bytes* .
 
+The time to determine the capacity for a request does not depend on
+*min_bytes* .
+If *cap_bytes* is large, the memory may come directly from the system;
+see :ref:`ta_large_memory-name` .
+
 Alignment
 *********
 We call a memory allocation aligned if the address is a multiple
@@ -766,7 +1005,11 @@ Example
       using std::endl;
 
       // determine the capacity for this request
-      size_t c_index   = 0;
+      // (at most two values are between 2^(b-1) and 2^b so this is order one)
+      size_t b         = 0;
+      if( min_bytes > 0 )
+         b = bit_length(min_bytes - 1);
+      size_t c_index   = capacity_info()->start[b];
       const size_t* capacity_vec = capacity_info()->value;
       while( capacity_vec[c_index] < min_bytes )
       {  ++c_index;
@@ -779,6 +1022,9 @@ Example
       size_t tc_index          = thread * num_cap + c_index;
       thread_alloc_info* info  = thread_info(thread);
 
+      // memory returned to this thread by other threads
+      remote_drain(thread);
+
 # ifndef NDEBUG
       // trace allocation
       static bool first_trace = true;
@@ -826,6 +1072,17 @@ Example
          // adjust counts
          inc_inuse(cap_bytes, thread);
          dec_available(cap_bytes, thread);
+         if( c_index >= capacity_info()->large_index )
+            info->count_large_available_ -= cap_bytes;
+# if CPPAD_THREAD_ALLOC_STATS
+         {  stats_capacity& stats = info->stats_[c_index];
+            ++stats.n_get;
+            ++stats.n_hit;
+            --stats.n_available;
+            if( stats.n_peak < ++stats.n_inuse )
+               stats.n_peak = stats.n_inuse;
+         }
+# endif
 
 # ifndef NDEBUG
          // check that pointers and doubles are aligned
@@ -840,7 +1097,7 @@ Example
       // Create a new node with thread_alloc information at front.
       // This uses the system allocator, which is thread safe, but slower,
       // because the thread might wait for a lock on the allocator.
-      v_node          = ::operator new(sizeof(block_t) + cap_bytes);
+      v_node          = system_get(c_index);
       CPPAD_ASSERT_UNKNOWN( v_node != nullptr );
       node            = reinterpret_cast<block_t*>(v_node);
       node->tc_index_ = tc_index;
@@ -861,6 +1118,13 @@ Example
 
       // adjust counts
       inc_inuse(cap_bytes, thread);
+# if CPPAD_THREAD_ALLOC_STATS
+      {  stats_capacity& stats = info->stats_[c_index];
+         ++stats.n_get;
+         if( stats.n_peak < ++stats.n_inuse )
+            stats.n_peak = stats.n_inuse;
+      }
+# endif
 
       return v_ptr;
    }
@@ -895,10 +1159,20 @@ obtained by a previous call to
 
 Thread
 ******
-Either the :ref:`current thread<ta_thread_num-name>` must be the same as during
+The memory can be returned by any thread.
+If the :ref:`current thread<ta_thread_num-name>` is not the same as during
 the corresponding call to :ref:`get_memory<ta_get_memory-name>` ,
-or the current execution mode must be sequential
-(not :ref:`parallel<ta_in_parallel-name>` ).
+and the current execution mode is :ref:`parallel<ta_in_parallel-name>` ,
+the memory is placed in a lock free queue for the thread that allocated it.
+That thread processes its queue during its next call to ``get_memory`` ,
+:ref:`ta_inuse-name` , :ref:`ta_available-name` , or
+:ref:`ta_free_available-name` .
+(The queue for each thread is also processed by these routines
+in sequential execution mode.)
+Until then, the memory is included in the :ref:`ta_inuse-name` amount
+for the thread that allocated it.
+This enables producer consumer pipelines where one thread creates
+``CppAD::vector`` objects and another thread uses and deletes them.
 
 NDEBUG
 ******
@@ -924,28 +1198,49 @@ Example
    After this call, this pointer will available (and not in use).
 
    \par
-   We must either be in sequential (not parallel) execution mode,
-   or the current thread must be the same as for the corresponding call
-   to get_memory.
+   If we are in parallel mode and the current thread is not the same
+   as for the corresponding call to get_memory, the memory is pushed on the
+   remote free stack for the thread that allocated it.
    */
    static void return_memory(void* v_ptr)
    {  size_t num_cap   = capacity_info()->number;
 
       block_t* node    = reinterpret_cast<block_t*>(v_ptr) - 1;
+      size_t tc_index  = node->tc_index_;
+      size_t thread    = tc_index / num_cap;
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT );
+
+      // check for memory that belongs to a different thread
+      if( in_parallel() && thread != thread_num() )
+      {  remote_push(node, thread);
+         return;
+      }
+      return_node(node);
+   }
+// ----------------------------------------------------------------------------
+private:
+   /*!
+   Return a memory allocation to the thread that allocated it.
+
+   \param node [in]
+   is the block_t at the beginning of the memory allocation.
+   This must be in use and the current thread must be the thread that
+   allocated it, or we must be in sequential execution mode.
+   */
+   static void return_node(block_t* node)
+   {  size_t num_cap   = capacity_info()->number;
+
       size_t tc_index  = node->tc_index_;
       size_t thread    = tc_index / num_cap;
       size_t c_index   = tc_index % num_cap;
       size_t capacity  = capacity_info()->value[c_index];
-
-      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
-      CPPAD_ASSERT_KNOWN(
-         thread == thread_num() || (! in_parallel()),
-         "Attempt to return memory for a different thread "
-         "while in parallel mode"
+      CPPAD_ASSERT_UNKNOWN(
+         thread == thread_num() || (! in_parallel())
       );
 
       thread_alloc_info* info = thread_info(thread);
 # ifndef NDEBUG
+      void* v_ptr = reinterpret_cast<void*>(node + 1);
 # if ! CPPAD_DEBUG_AND_RELEASE
       // remove node from inuse list
       void* v_node         = reinterpret_cast<void*>(node);
@@ -983,10 +1278,20 @@ Example
 # endif
       // capacity bytes are removed from the inuse pool
       dec_inuse(capacity, thread);
+# if CPPAD_THREAD_ALLOC_STATS
+      ++info->stats_[c_index].n_return;
+      --info->stats_[c_index].n_inuse;
+# endif
 
       // check for case where we just return the memory to the system
-      if( ! set_get_hold_memory(false) )
-      {  ::operator delete( reinterpret_cast<void*>(node) );
+      bool large = c_index >= capacity_info()->large_index;
+      bool hold  = set_get_hold_memory(false);
+      if( hold && large )
+      {  size_t max_cache = large_info()->max_cache;
+         hold = info->count_large_available_ + capacity <= max_cache;
+      }
+      if( ! hold )
+      {  system_return( reinterpret_cast<void*>(node), c_index );
          return;
       }
 
@@ -997,7 +1302,57 @@ Example
 
       // capacity bytes are added to the available pool
       inc_available(capacity, thread);
+      if( large )
+         info->count_large_available_ += capacity;
+# if CPPAD_THREAD_ALLOC_STATS
+      ++info->stats_[c_index].n_available;
+# endif
    }
+   /*!
+   Push a memory allocation on the remote free stack for its thread.
+
+   \param node [in]
+   is the block_t at the beginning of the memory allocation.
+   This must be in use and we must be in parallel mode.
+
+   \param thread [in]
+   is the thread that allocated this memory (not the current thread).
+   The memory is returned by this thread the next time it calls get_memory,
+   or when it is processed in sequential mode.
+   */
+   static void remote_push(block_t* node, size_t thread)
+   {  thread_alloc_info* info = thread_info(thread);
+      void* v_node = reinterpret_cast<void*>(node);
+      void* head   = info->remote_free_.load(std::memory_order_relaxed);
+      do
+      {  node->remote_next_ = head;
+      }
+      while( ! info->remote_free_.compare_exchange_weak(
+         head, v_node, std::memory_order_release, std::memory_order_relaxed
+      ) );
+   }
+   /*!
+   Return the memory allocations that other threads have pushed on the
+   remote free stack for a thread.
+
+   \param thread [in]
+   is the thread we are processing the remote free stack for.
+   This must be the current thread or we must be in sequential execution mode.
+   */
+   static void remote_drain(size_t thread)
+   {  thread_alloc_info* info = thread_info(thread);
+      if( info->remote_free_.load(std::memory_order_relaxed) == nullptr )
+         return;
+      void* v_node =
+         info->remote_free_.exchange(nullptr, std::memory_order_acquire);
+      while( v_node != nullptr )
+      {  block_t* node = reinterpret_cast<block_t*>(v_node);
+         v_node        = node->remote_next_;
+         return_node(node);
+      }
+   }
+// ----------------------------------------------------------------------------
+public:
 /* -----------------------------------------------------------------------
 {xrst_begin ta_free_available}
 {xrst_spell
@@ -1052,8 +1407,8 @@ Example
    */
    static void free_available(size_t thread)
    {  CPPAD_ASSERT_KNOWN(
-         thread < CPPAD_MAX_NUM_THREADS,
-         "Attempt to free memory for a thread >= CPPAD_MAX_NUM_THREADS"
+         thread < CPPAD_THREAD_LIMIT,
+         "Attempt to free memory for a thread >= CPPAD_THREAD_LIMIT"
       );
       CPPAD_ASSERT_KNOWN(
          thread == thread_num() || (! in_parallel()),
@@ -1062,8 +1417,9 @@ Example
       );
 
       size_t num_cap = capacity_info()->number;
-      if( num_cap == 0 )
+      if( num_cap == 0 || ! has_info(thread) )
          return;
+      remote_drain(thread);
       const size_t*     capacity_vec  = capacity_info()->value;
       size_t c_index;
       thread_alloc_info* info = thread_info(thread);
@@ -1074,13 +1430,15 @@ Example
          while( v_ptr != nullptr )
          {  block_t* node = reinterpret_cast<block_t*>(v_ptr);
             void* next    = node->next_;
-            ::operator delete(v_ptr);
+            system_return(v_ptr, c_index);
             v_ptr         = next;
 
             dec_available(capacity, thread);
          }
          available_root->next_ = nullptr;
+         info->stats_[c_index].n_available = 0;
       }
+      info->count_large_available_ = 0;
       CPPAD_ASSERT_UNKNOWN( available(thread) == 0 );
       if( inuse(thread) == 0 )
       {  // clear the information for this thread
@@ -1132,6 +1490,97 @@ to the system using :ref:`free_available<ta_free_available-name>` .
    {  bool set = true;
       set_get_hold_memory(set, value);
    }
+/* -----------------------------------------------------------------------
+{xrst_begin ta_large_memory}
+{xrst_spell
+   madvise
+   mmap
+}
+
+Control How Thread Alloc Handles Large Allocations
+##################################################
+
+Syntax
+******
+``thread_alloc::large_memory`` ( *max_cache* , *huge_page* )
+
+Purpose
+*******
+Large allocations, for example the Taylor coefficients and sparsity
+patterns for a big :ref:`ADFun-name` object, are not held in the
+:ref:`available<ta_available-name>` pool unless they fit in a separate,
+limited, cache for each thread.
+This keeps threads from holding onto very large amounts of memory
+that they may never use again.
+
+Large
+*****
+An allocation is large if its capacity is greater than or equal
+``CPPAD_LARGE_MIN_BYTES`` (16 megabytes).
+If the ``mmap`` system routine is available, it is used to
+obtain large allocations from the system
+(and ``munmap`` is used to return them).
+Otherwise, the system ``new`` operator is used.
+
+max_cache
+*********
+This argument has prototype
+
+   ``size_t`` *max_cache*
+
+It is the maximum number of bytes, in large allocations,
+that will be held in the available pool for each thread.
+When a large allocation is returned and this limit would be exceeded,
+the memory is returned to the system.
+This limit only applies when :ref:`hold_memory<ta_hold_memory-name>`
+is true.
+(Decreasing *max_cache* does not free memory that is already available;
+see :ref:`free_available<ta_free_available-name>` .)
+By default (when ``large_memory`` has not been called)
+*max_cache* is four times ``CPPAD_LARGE_MIN_BYTES`` .
+
+huge_page
+*********
+This argument has prototype
+
+   ``bool`` *huge_page*
+
+If it is true, and ``mmap`` is used for large allocations,
+transparent huge pages are requested (using ``madvise`` ) for
+the large allocations that are obtained from the system after this call.
+This can reduce translation lookaside buffer misses for large vectors.
+By default (when ``large_memory`` has not been called)
+*huge_page* is false.
+
+Restrictions
+************
+This routine cannot be called while in :ref:`parallel<ta_in_parallel-name>`
+execution mode.
+
+Example
+*******
+:ref:`thread_alloc.cpp-name`
+
+{xrst_end ta_large_memory}
+*/
+   /*!
+   Change the thread_alloc settings for large allocations.
+
+   \param max_cache [in]
+   New value for the maximum number of large available bytes held
+   for each thread.
+
+   \param huge_page [in]
+   New value for the huge page setting.
+   */
+   static void large_memory(size_t max_cache, bool huge_page)
+   {  CPPAD_ASSERT_KNOWN(
+         ! in_parallel(),
+         "thread_alloc::large_memory: called while in parallel mode"
+      );
+      large_info()->max_cache = max_cache;
+      large_info()->huge_page = huge_page;
+   }
 
 /* -----------------------------------------------------------------------
 {xrst_begin ta_inuse}
@@ -1179,7 +1628,7 @@ Example
 
    \param thread [in]
    Thread for which we are determining the amount of memory
-   (must be < CPPAD_MAX_NUM_THREADS).
+   (must be < CPPAD_THREAD_LIMIT).
    Durring parallel execution, this must be the thread
    that is currently executing.
 
@@ -1188,10 +1637,13 @@ Example
    */
    static size_t inuse(size_t thread)
    {
-      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT);
       CPPAD_ASSERT_UNKNOWN(
          thread == thread_num() || (! in_parallel())
       );
+      if( ! has_info(thread) )
+         return 0;
+      remote_drain(thread);
       thread_alloc_info* info = thread_info(thread);
       return info->count_inuse_;
    }
@@ -1243,14 +1695,166 @@ Example
    */
    static size_t available(size_t thread)
    {
-      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_THREAD_LIMIT);
       CPPAD_ASSERT_UNKNOWN(
          thread == thread_num() || (! in_parallel())
       );
+      if( ! has_info(thread) )
+         return 0;
+      remote_drain(thread);
       thread_alloc_info* info = thread_info(thread);
       return info->count_available_;
    }
 /* -----------------------------------------------------------------------
+{xrst_begin ta_stats}
+{xrst_spell
+   inuse
+}
+
+Allocation Statistics for a Thread
+##################################
+
+Syntax
+******
+| ``thread_alloc::stats`` ( *thread* , *snapshot* )
+| ``thread_alloc::stats_reset`` ( *thread* )
+
+Purpose
+*******
+The :ref:`inuse<ta_inuse-name>` and :ref:`available<ta_available-name>`
+routines only report totals for each thread.
+These routines report, and reset, counters for each thread and each
+capacity; i.e., each size class used by :ref:`ta_get_memory-name` .
+This can be used for capacity planning; e.g., see the
+:ref:`speed_main@Global Options@memory` option for the speed tests.
+
+CPPAD_THREAD_ALLOC_STATS
+************************
+The counters are only updated if the preprocessor symbol
+``CPPAD_THREAD_ALLOC_STATS`` is true; see
+:ref:`cmake@cppad_thread_alloc_stats` .
+Otherwise, all of the counters in *snapshot* are zero
+and there is no extra work during memory allocation.
+
+thread
+******
+This argument has prototype
+
+   ``size_t`` *thread*
+
+Either :ref:`thread_num<ta_thread_num-name>` must be the same as *thread* ,
+or the current execution mode must be sequential
+(not :ref:`parallel<ta_in_parallel-name>` ).
+
+snapshot
+********
+This argument has prototype
+
+   ``thread_alloc::stats_thread&`` *snapshot*
+
+The input value of its fields does not matter.
+Upon return, it contains the following statistics for the specified thread:
+
+number
+======
+The field *snapshot* . ``number`` has type ``size_t`` .
+It is the number of capacities that ``thread_alloc`` uses.
+
+peak_inuse
+==========
+The field *snapshot* . ``peak_inuse`` has type ``size_t`` .
+It is the maximum number of bytes in use by this thread since the
+statistics were last reset.
+
+capacity
+========
+For *c* = 0, ..., *snapshot* . ``number`` - 1 ,
+the field *snapshot* . ``capacity`` [ *c* ] has type
+``thread_alloc::stats_capacity`` and has the following
+``size_t`` fields:
+
+.. csv-table::
+   :widths: auto
+
+   **Field**,**Meaning**
+   ``capacity``,number of bytes in each allocation for this capacity
+   ``n_get``,number of allocations with this capacity
+   ``n_hit``,number of allocations that re-used available memory
+   ``n_return``,number of allocations that were returned
+   ``n_inuse``,number of allocations currently in use
+   ``n_peak``,maximum value of ``n_inuse``
+   ``n_available``,number of allocations currently available
+
+The number of bytes held, for future use, with this capacity is
+``n_available`` times ``capacity`` .
+
+stats_reset
+***********
+This sets all the counters for the specified thread to zero,
+except for ``n_inuse`` and ``n_available`` which always
+correspond to the current state; in addition,
+``n_peak`` is set to ``n_inuse`` and
+``peak_inuse`` is set to the current number of bytes in use.
+If :ref:`free_available<ta_free_available-name>` returns the extra memory
+for a thread, the statistics for that thread are also reset.
+
+Example
+*******
+:ref:`thread_alloc.cpp-name`
+
+{xrst_end ta_stats}
+*/
+   /*!
+   Get the allocation statistics for a thread.
+
+   \param thread [in]
+   is the thread we are getting the statistics for.
+   This must be the current thread or we must be in sequential mode.
+
+   \param snapshot [out]
+   is a copy of the statistics for this thread.
+   */
+   static void stats(size_t thread, stats_thread& snapshot)
+   {  CPPAD_ASSERT_KNOWN(
+         thread == thread_num() || (! in_parallel()),
+         "thread_alloc::stats: thread is not current thread "
+         "and in parallel mode"
+      );
+      remote_drain(thread);
+      thread_alloc_info* info = thread_info(thread);
+      size_t num_cap          = capacity_info()->number;
+      snapshot.number         = num_cap;
+      snapshot.peak_inuse     = info->peak_inuse_;
+      for(size_t c = 0; c < num_cap; ++c)
+      {  snapshot.capacity[c]          = info->stats_[c];
+         snapshot.capacity[c].capacity = capacity_info()->value[c];
+      }
+   }
+   /*!
+   Reset the allocation statistics for a thread.
+
+   \param thread [in]
+   is the thread we are resetting the statistics for.
+   This must be the current thread or we must be in sequential mode.
+   */
+   static void stats_reset(size_t thread)
+   {  CPPAD_ASSERT_KNOWN(
+         thread == thread_num() || (! in_parallel()),
+         "thread_alloc::stats_reset: thread is not current thread "
+         "and in parallel mode"
+      );
+      remote_drain(thread);
+      thread_alloc_info* info = thread_info(thread);
+      info->peak_inuse_       = info->count_inuse_;
+      for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
+      {  stats_capacity& stats = info->stats_[c];
+         stats.n_get       = 0;
+         stats.n_hit       = 0;
+         stats.n_return    = 0;
+         stats.n_peak      = stats.n_inuse;
+      }
+   }
+/* -----------------------------------------------------------------------
 {xrst_begin ta_create_array}
 {xrst_spell
    inuse
@@ -1513,7 +2117,7 @@ Example
          "free_all cannot be used while in parallel execution"
       );
       bool ok = true;
-      size_t thread = CPPAD_MAX_NUM_THREADS;
+      size_t thread = info_table().size();
       while(thread--)
       {  ok &= inuse(thread) == 0;
          free_available(thread);
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_det_lu.cpp}
@@ -25,6 +25,8 @@ Implementation
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern double global_optimize_seconds;
 
 bool link_det_lu(
    size_t                           size     ,
@@ -35,7 +37,10 @@ bool link_det_lu(
 
    // --------------------------------------------------------------------
    // check global options
-   const char* valid[] = { "memory", "optimize", "val_graph"};
+   const char* valid[] = {
+      "memory", "optimize", "atomic", "val_graph", "simplify",
+      "multiply_add", "weighted_sum", "optimize_time"
+   };
    size_t n_valid = sizeof(valid) / sizeof(valid[0]);
    typedef std::map<std::string, bool>::iterator iterator;
    //
@@ -54,6 +59,12 @@ bool link_det_lu(
       "no_conditional_skip no_compare_op no_print_for_op";
    if( global_option["val_graph"] )
       optimize_options += " val_graph";
+   if( global_option["simplify"] )
+      optimize_options += " simplify";
+   if( global_option["multiply_add"] )
+      optimize_options += " multiply_add_op";
+   if( global_option["weighted_sum"] )
+      optimize_options += " weighted_sum_op";
    // -----------------------------------------------------
    // setup
    typedef CppAD::AD<double>           ADScalar;
@@ -71,6 +82,11 @@ bool link_det_lu(
    CppAD::vector<double> w(1);
    w[0] = 1.;
 
+   // atomic function information
+   ADVector ay(2);
+   CppAD::atomic_lu<double> atom_lu("atom_lu");
+   size_t call_id = atom_lu.set_log_det(size);
+
    // do not even record comparison operators
    size_t abort_op_index = 0;
    bool record_compare   = false;
@@ -86,12 +102,20 @@ bool link_det_lu(
       Independent(A, abort_op_index, record_compare);
 
       // AD computation of the determinant
-      detA[0] = Det(A);
+      if( ! global_option["atomic"] )
+         detA[0] = Det(A);
+      else
+      {  atom_lu(call_id, A, ay);
+         detA[0] = ay[1] * exp( ay[0] );
+      }
 
       // create function object f : A -> detA
       f.Dependent(A, detA);
       if( global_option["optimize"] )
+      {  double start = CppAD::elapsed_seconds();
          f.optimize(optimize_options);
+         global_optimize_seconds += CppAD::elapsed_seconds() - start;
+      }
 
       // evaluate and return gradient using reverse mode
       f.Forward(0, matrix);
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_ode.cpp}
@@ -27,6 +27,8 @@ Implementation
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern double global_optimize_seconds;
 
 bool link_ode(
    size_t                     size       ,
@@ -38,7 +40,10 @@ bool link_ode(
 
    // --------------------------------------------------------------------
    // check global options
-   const char* valid[] = { "memory", "onetape", "optimize", "val_graph"};
+   const char* valid[] = {
+      "memory", "onetape", "optimize", "val_graph", "simplify", "multiply_add",
+      "weighted_sum", "optimize_time"
+   };
    size_t n_valid = sizeof(valid) / sizeof(valid[0]);
    typedef std::map<std::string, bool>::iterator iterator;
    //
@@ -57,6 +62,12 @@ bool link_ode(
       "no_conditional_skip no_compare_op no_print_for_op";
    if( global_option["val_graph"] )
       optimize_options += " val_graph";
+   if( global_option["simplify"] )
+      optimize_options += " simplify";
+   if( global_option["multiply_add"] )
+      optimize_options += " multiply_add_op";
+   if( global_option["weighted_sum"] )
+      optimize_options += " weighted_sum_op";
    // --------------------------------------------------------------------
    // setup
    assert( x.size() == size );
@@ -93,7 +104,10 @@ bool link_ode(
       f.Dependent(X, Y);
 
       if( global_option["optimize"] )
+      {  double start = CppAD::elapsed_seconds();
          f.optimize(optimize_options);
+         global_optimize_seconds += CppAD::elapsed_seconds() - start;
+      }
 
       // skip comparison operators
       f.compare_change_count(0);
@@ -116,7 +130,10 @@ bool link_ode(
       f.Dependent(X, Y);
 
       if( global_option["optimize"] )
+      {  double start = CppAD::elapsed_seconds();
          f.optimize(optimize_options);
+         global_optimize_seconds += CppAD::elapsed_seconds() - start;
+      }
 
       // skip comparison operators
       f.compare_change_count(0);
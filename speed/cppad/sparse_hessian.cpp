@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_sparse_hessian.cpp}
@@ -23,9 +23,12 @@ Implementation
 
 // Note that CppAD uses global_option["memory"] at the main program level
 # include <map>
+# include <algorithm>
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern double global_optimize_seconds;
 
 namespace {
    // typedefs
@@ -57,6 +60,12 @@ namespace {
          "no_conditional_skip no_compare_op no_print_for_op";
       if( global_option["val_graph"] )
          optimize_options += " val_graph";
+      if( global_option["simplify"] )
+         optimize_options += " simplify";
+      if( global_option["multiply_add"] )
+         optimize_options += " multiply_add_op";
+      if( global_option["weighted_sum"] )
+         optimize_options += " weighted_sum_op";
       //
       // order of derivative in sparse_hes_fun
       size_t order = 0;
@@ -78,7 +87,10 @@ namespace {
          fun.Dependent(a1x, a1y);
          //
          if( global_option["optimize"] )
+         {  double start = CppAD::elapsed_seconds();
             fun.optimize(optimize_options);
+            global_optimize_seconds += CppAD::elapsed_seconds() - start;
+         }
          //
          // skip comparison operators
          fun.compare_change_count(0);
@@ -113,7 +125,10 @@ namespace {
       fun.Dependent(a1x, a1z);
       //
       if( global_option["optimize"] )
+      {  double start = CppAD::elapsed_seconds();
          fun.optimize(optimize_options);
+         global_optimize_seconds += CppAD::elapsed_seconds() - start;
+      }
       //
       // skip comparison operators
       fun.compare_change_count(0);
@@ -212,7 +227,43 @@ namespace {
       CppAD::ADFun<double>&   fun      )
    {  size_t n_color;
       //
-      if( ! global_option["hes2jac"] )
+      if( global_option["edge_push"] )
+      {  // fun corresponds to f(x)
+         //
+         // only one function component
+         d_vector w(1);
+         w[0] = 1.0;
+         //
+         // compute entire hessian
+         sparse_matrix hes;
+         fun.sparse_hes_edge(x, w, hes);
+         //
+         // copy requested entries to subset
+         // (hes is in row major order)
+         const s_vector& hes_row( hes.row() );
+         const s_vector& hes_col( hes.col() );
+         const s_vector& row( subset.row() );
+         const s_vector& col( subset.col() );
+         size_t          n = subset.nr();
+         s_vector        start(n + 1);
+         for(size_t i = 0; i <= n; ++i)
+            start[i] = 0;
+         for(size_t k = 0; k < hes.nnz(); ++k)
+            ++start[ hes_row[k] + 1 ];
+         for(size_t i = 0; i < n; ++i)
+            start[i+1] += start[i];
+         for(size_t ell = 0; ell < subset.nnz(); ++ell)
+         {  const size_t* begin = hes_col.data() + start[ row[ell] ];
+            const size_t* end   = hes_col.data() + start[ row[ell] + 1 ];
+            const size_t* ptr   = std::lower_bound(begin, end, col[ell]);
+            if( ptr != end && *ptr == col[ell] )
+               subset.set(ell, hes.val()[ ptr - hes_col.data() ] );
+            else
+               subset.set(ell, 0.0);
+         }
+         n_color = 0;
+      }
+      else if( ! global_option["hes2jac"] )
       {  // fun corresponds to f(x)
          //
          // coloring method
@@ -279,7 +330,8 @@ bool link_sparse_hessian(
    // check global options
    const char* valid[] = {
       "memory", "onetape", "optimize", "hes2jac", "subgraph",
-      "boolsparsity", "revsparsity", "symmetric", "val_graph"
+      "boolsparsity", "revsparsity", "symmetric", "val_graph", "edge_push",
+      "simplify", "multiply_add", "weighted_sum", "optimize_time"
 # if CPPAD_HAS_COLPACK
       , "colpack"
 # else
@@ -308,6 +360,10 @@ bool link_sparse_hessian(
    {  if( ! global_option["hes2jac"] )
          return false;
    }
+   if( global_option["edge_push"] )
+   {  if( global_option["hes2jac"] )
+         return false;
+   }
 # if ! CPPAD_HAS_COLPACK
    if( global_option["colpack"] )
       return false;
@@ -343,7 +399,8 @@ bool link_sparse_hessian(
       create_fun(x, row, col, fun);
       //
       // calculate the sparsity pattern for Hessian of f(x)
-      calc_sparsity(sparsity, fun);
+      if( ! global_option["edge_push"] )
+         calc_sparsity(sparsity, fun);
       //
       // calculate the Hessian at this x
       jac_work.clear(); // wihtout work from previous calculation
@@ -360,7 +417,8 @@ bool link_sparse_hessian(
       create_fun(x, row, col, fun);
       //
       // calculate the sparsity pattern for Hessian of f(x)
-      calc_sparsity(sparsity, fun);
+      if( ! global_option["edge_push"] )
+         calc_sparsity(sparsity, fun);
       //
       while(repeat--)
       {  // choose a value for x
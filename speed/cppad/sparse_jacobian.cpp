@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_sparse_jacobian.cpp}
@@ -26,6 +26,8 @@ Implementation
 extern std::map<std::string, bool> global_option;
 // see comments in main program for this external
 extern size_t global_cppad_thread_alloc_inuse;
+// see comments in main program for this external
+extern double global_optimize_seconds;
 
 namespace {
    using CppAD::vector;
@@ -96,6 +98,12 @@ namespace {
          "no_conditional_skip no_compare_op no_print_for_op";
       if( global_option["val_graph"] )
          optimize_options += " val_graph";
+      if( global_option["simplify"] )
+         optimize_options += " simplify";
+      if( global_option["multiply_add"] )
+         optimize_options += " multiply_add_op";
+      if( global_option["weighted_sum"] )
+         optimize_options += " weighted_sum_op";
       //
       // default value for n_color
       n_color = 0;
@@ -127,7 +135,10 @@ namespace {
       f.Dependent(a_x, a_y);
       //
       if( global_option["optimize"] )
+      {  double start = CppAD::elapsed_seconds();
          f.optimize(optimize_options);
+         global_optimize_seconds += CppAD::elapsed_seconds() - start;
+      }
       //
       // coloring method
       std::string coloring = "cppad";
@@ -188,7 +199,8 @@ bool link_sparse_jacobian(
    // check global options
    const char* valid[] = {
       "memory", "onetape", "optimize", "subgraph",
-      "boolsparsity", "revsparsity", "subsparsity", "val_graph"
+      "boolsparsity", "revsparsity", "subsparsity", "val_graph", "simplify",
+      "multiply_add", "weighted_sum", "optimize_time"
 # if CPPAD_HAS_COLPACK
       , "colpack"
 # endif
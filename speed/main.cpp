@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cstring>
@@ -10,6 +10,7 @@
 # include <iostream>
 # include <iomanip>
 # include <map>
+# include <algorithm>
 # include <cppad/utility/vector.hpp>
 # include <cppad/speed/det_grad_33.hpp>
 # include <cppad/speed/det_33.hpp>
@@ -17,6 +18,8 @@
 # include <cppad/utility/poly.hpp>
 # include <cppad/utility/track_new_del.hpp>
 # include <cppad/utility/thread_alloc.hpp>
+# include <cppad/utility/elapsed_seconds.hpp>
+# include <cppad/local/val_graph/pass_time.hpp>
 
 # ifdef CPPAD_ADOLC_SPEED
 # define AD_PACKAGE "adolc"
@@ -196,6 +199,27 @@ If it is not present, CppAD will used standard memory allocation.
 Another package might use this option for a different
 memory allocation method.
 
+If this option is present and
+:ref:`cmake@cppad_thread_alloc_stats` is true,
+the :ref:`thread_alloc statistics<ta_stats-name>` are reset before
+each size for each speed test.
+The following extra output lines are printed for each speed test:
+
+| |tab| *package* _ *test* _ ``peak_inuse`` = [ *peak_1* , ..., *peak_n* ]
+| |tab| *package* _ *test* _ ``capacity`` = [ *capacity_1* , ... ]
+| |tab| *package* _ *test* _ ``n_get`` = [ *n_get_1* , ... ]
+| |tab| *package* _ *test* _ ``n_hit`` = [ *n_hit_1* , ... ]
+| |tab| *package* _ *test* _ ``n_peak`` = [ *n_peak_1* , ... ]
+
+The values *peak_1* , ..., *peak_n* are the maximum number of bytes
+in use during the test for the corresponding size.
+The other lines have one entry for each allocation capacity that was used.
+The values *n_get_1* , ... and *n_hit_1* , ...
+are the total number of allocations and the number that re-used
+available memory (summed over all the sizes).
+The values *n_peak_1* , ... are the maximum number of allocations,
+with the corresponding capacity, that were in use at the same time.
+
 optimize
 ========
 If this option is present,
@@ -211,13 +235,59 @@ If this option and optimize are present,
 CppAD will add the :code:`optimize@options@val_graph` option to
 the optimization of the operation sequence.
 
+simplify
+========
+If this option, val_graph, and optimize are present,
+CppAD will add the :code:`optimize@options@simplify` option to
+the optimization of the operation sequence.
+
+multiply_add
+============
+If this option and optimize are present,
+CppAD will add the :code:`optimize@options@multiply_add_op` option to
+the optimization of the operation sequence.
+
+weighted_sum
+============
+If this option and optimize are present,
+CppAD will add the :code:`optimize@options@weighted_sum_op` option to
+the optimization of the operation sequence.
+
+optimize_time
+=============
+If this option is present,
+the following extra output lines are printed for each speed test:
+
+| |tab| *package* _ *test* _ ``optimize_seconds`` = [ *opt_1* , ..., *opt_n* ]
+| |tab| *package* _ *test* _ ``evaluate_seconds`` = [ *eval_1* , ..., *eval_n* ]
+
+The values *opt_1* , ..., *opt_n* are the number of seconds,
+per repetition of the test, that were spent in
+:ref:`optimize-name` for the corresponding size.
+The values *eval_1* , ..., *eval_n* are the number of seconds,
+per repetition of the test, that were spent doing everything else;
+e.g., taping and evaluating derivatives.
+The sum of these two values is the inverse of the corresponding rate.
+So far, only the :ref:`speed_cppad-name` tests implement this option
+(the other packages do not have an optimize step).
+
+If the ``val_graph`` option is also present,
+the number of seconds per repetition spent in each of the value graph
+optimizer passes is also printed; e.g.,
+
+| |tab| *package* _ *test* _ ``fun2val_seconds`` = [ ... ]
+
+The passes are listed in the table of :ref:`val_pass_time-name` .
+
 atomic
 ======
 If this option is present,
 CppAD will use a user defined
 :ref:`atomic<atomic_two-name>` operation is used for the test.
 So far, CppAD has only implemented
-the :ref:`mat_mul<link_mat_mul-name>` test as an atomic operation.
+the :ref:`mat_mul<link_mat_mul-name>` test
+and the :ref:`det_lu<link_det_lu-name>` test
+(using :ref:`atomic_lu-name` ) as atomic operations.
 
 hes2jac
 =======
@@ -286,6 +356,18 @@ The CppAD
 :ref:`sparse_hessian<link_sparse_hessian-name>` test
 is implemented for this option.
 
+edge_push
+=========
+If this option is present, CppAD will use
+:ref:`sparse_hes_edge-name` to compute the Hessian.
+This computes the sparsity pattern and the values of the Hessian
+using one reverse sweep and does not use a coloring.
+In this case, the number of colors reported is zero.
+The CppAD
+:ref:`sparse_hessian<link_sparse_hessian-name>` test
+is implemented for this option
+(it returns false if ``hes2jac`` is also present).
+
 Correctness Results
 *******************
 One, but not both, of the following two output lines
@@ -384,6 +466,10 @@ std::map<std::string, bool> global_option;
 // current thread at end of the test.
 size_t global_cppad_thread_alloc_inuse = 0;
 //
+// This is the number of seconds that the current speed test has spent
+// in optimize. It is reset to zero before each size for each speed test.
+double global_optimize_seconds = 0.0;
+//
 // This is the value of seed in the main program command line.
 // It can be used by the sparse matrix routines to reset the random generator
 // so same sparsity pattern is obtained during source generation and usage.
@@ -394,6 +480,8 @@ namespace {
    using std::cout;
    using std::cerr;
    using std::endl;
+   using CppAD::local::val_graph::pass_time_t;
+   using CppAD::local::val_graph::pass_time;
    const char* option_list[] = {
       "memory",
       "onetape",
@@ -406,7 +494,12 @@ namespace {
       "subsparsity",
       "colpack",
       "symmetric",
-      "val_graph"
+      "edge_push",
+      "val_graph",
+      "simplify",
+      "multiply_add",
+      "weighted_sum",
+      "optimize_time"
    };
    size_t num_option = sizeof(option_list) / sizeof( option_list[0] );
    // ----------------------------------------------------------------
@@ -441,6 +534,17 @@ namespace {
       cout << " ]";
    }
 
+   void output(const CppAD::vector<double> &v)
+   {  size_t i= 0, n = v.size();
+      cout << "[ " << std::scientific << std::setprecision(3);
+      while(i < n)
+      {  cout << v[i++];
+         if( i < n )
+            cout << ", ";
+      }
+      cout << " ]";
+   }
+
    // ----------------------------------------------------------------
    // function that runs one correctness case
    static size_t Run_ok_count    = 0;
@@ -482,12 +586,61 @@ namespace {
       return ok;
    }
    // ----------------------------------------------------------------
+   // output the thread_alloc statistics for one speed case
+   void output_memory(
+      const std::string&                        case_name  ,
+      const CppAD::vector<size_t>&              peak_inuse ,
+      const CppAD::thread_alloc::stats_thread&  total      )
+   {  CppAD::vector<size_t> capacity, n_get, n_hit, n_peak;
+      for(size_t c = 0; c < total.number; ++c)
+      {  if( total.capacity[c].n_get > 0 )
+         {  capacity.push_back( total.capacity[c].capacity );
+            n_get.push_back( total.capacity[c].n_get );
+            n_hit.push_back( total.capacity[c].n_hit );
+            n_peak.push_back( total.capacity[c].n_peak );
+         }
+      }
+      std::string prefix = AD_PACKAGE + std::string("_") + case_name;
+      cout << prefix << "_peak_inuse = ";
+      output(peak_inuse);
+      cout << endl << prefix << "_capacity = ";
+      output(capacity);
+      cout << endl << prefix << "_n_get = ";
+      output(n_get);
+      cout << endl << prefix << "_n_hit = ";
+      output(n_hit);
+      cout << endl << prefix << "_n_peak = ";
+      output(n_peak);
+      cout << endl;
+   }
+   // ----------------------------------------------------------------
    // function that runs one speed case
    void run_speed(
       double time_case(double time_min,  size_t size)  ,
       const CppAD::vector<size_t>&        size_vec     ,
       const std::string&                  case_name    )
    {  double time_min = 1.;
+      //
+      // memory statistics
+      using CppAD::thread_alloc;
+      bool memory = global_option["memory"] && CPPAD_THREAD_ALLOC_STATS;
+      size_t thread = thread_alloc::thread_num();
+      CppAD::vector<size_t>     peak_inuse( size_vec.size() );
+      thread_alloc::stats_thread total, snapshot;
+      thread_alloc::stats(thread, total);
+      //
+      // optimize time statistics
+      bool optimize_time = global_option["optimize_time"];
+      bool val_graph     = optimize_time && global_option["val_graph"];
+      CppAD::vector<double> optimize_seconds( size_vec.size() );
+      CppAD::vector<double> evaluate_seconds( size_vec.size() );
+      CppAD::vector<pass_time_t> pass_seconds( size_vec.size() );
+      for(size_t c = 0; c < total.number; ++c)
+      {  total.capacity[c].n_get  = 0;
+         total.capacity[c].n_hit  = 0;
+         total.capacity[c].n_peak = 0;
+      }
+      //
       cout << case_name << "_size = ";
       output(size_vec);
       cout << endl;
@@ -500,7 +653,44 @@ namespace {
             cout << ", ";
          cout << std::flush;
          size_t size = size_vec[i];
+         if( memory )
+            thread_alloc::stats_reset(thread);
+         double start_seconds = 0.0;
+         if( optimize_time )
+         {  global_optimize_seconds = 0.0;
+            pass_time()             = pass_time_t();
+            start_seconds           = CppAD::elapsed_seconds();
+         }
          double time = time_case(time_min, size);
+         if( optimize_time )
+         {  // time_case repeats the test many times, so use the fraction
+            // of its total time that was spent optimizing.
+            double total_seconds = CppAD::elapsed_seconds() - start_seconds;
+            double scale         = time / total_seconds;
+            optimize_seconds[i]  = scale * global_optimize_seconds;
+            evaluate_seconds[i]  = time - optimize_seconds[i];
+            pass_time_t& pass    = pass_seconds[i];
+            pass                 = pass_time();
+            pass.fun2val        *= scale;
+            pass.renumber       *= scale;
+            pass.simplify       *= scale;
+            pass.fold_con       *= scale;
+            pass.summation      *= scale;
+            pass.dead_code      *= scale;
+            pass.compress       *= scale;
+            pass.val2fun        *= scale;
+         }
+         if( memory )
+         {  thread_alloc::stats(thread, snapshot);
+            peak_inuse[i] = snapshot.peak_inuse;
+            for(size_t c = 0; c < total.number; ++c)
+            {  thread_alloc::stats_capacity& sum = total.capacity[c];
+               thread_alloc::stats_capacity& one = snapshot.capacity[c];
+               sum.n_get  += one.n_get;
+               sum.n_hit  += one.n_hit;
+               sum.n_peak  = std::max(sum.n_peak, one.n_peak);
+            }
+         }
          double rate = 1. / time;
          if( rate >= 1000 )
             cout << std::setprecision(0) << rate;
@@ -511,6 +701,35 @@ namespace {
       }
       cout << " ]" << endl;
       //
+      if( memory )
+         output_memory(case_name, peak_inuse, total);
+      if( optimize_time )
+      {  std::string prefix = AD_PACKAGE + std::string("_") + case_name;
+         cout << prefix << "_optimize_seconds = ";
+         output(optimize_seconds);
+         cout << endl << prefix << "_evaluate_seconds = ";
+         output(evaluate_seconds);
+         cout << endl;
+      }
+      if( val_graph )
+      {  std::string prefix = AD_PACKAGE + std::string("_") + case_name;
+         CppAD::vector<double> seconds( size_vec.size() );
+         auto output_pass = [&](const char* name, double pass_time_t::* pass)
+         {  for(size_t i = 0; i < size_vec.size(); ++i)
+               seconds[i] = pass_seconds[i].*pass;
+            cout << prefix << "_" << name << "_seconds = ";
+            output(seconds);
+            cout << endl;
+         };
+         output_pass("fun2val",   &pass_time_t::fun2val);
+         output_pass("renumber",  &pass_time_t::renumber);
+         output_pass("simplify",  &pass_time_t::simplify);
+         output_pass("fold_con",  &pass_time_t::fold_con);
+         output_pass("summation", &pass_time_t::summation);
+         output_pass("dead_code", &pass_time_t::dead_code);
+         output_pass("compress",  &pass_time_t::compress);
+         output_pass("val2fun",   &pass_time_t::val2fun);
+      }
       return;
    }
 }
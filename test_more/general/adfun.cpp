@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -34,11 +34,11 @@ bool adfun_empty(void)
    size_t inuse_3  = CppAD::thread_alloc::inuse(thread);
    ok &= inuse_1 < inuse_3;
    //
-   // assigning to an empty function uses assignment to pod_vectors
-   // which just changes their length to zero
+   // assigning an empty function to g releases the recording in g
+   // (the recording in f is shared with g, not copied)
    g = f;
    size_t inuse_4  = CppAD::thread_alloc::inuse(thread);
-   ok &= inuse_3 == inuse_4;
+   ok &= inuse_4 < inuse_3;
    //
    // assigning to a temporary empty function to g
    // uses move semantics (hence frees all memory in g)
@@ -77,11 +77,52 @@ bool adfun_swap(void)
    return ok;
 }
 
+bool adfun_share(void)
+{  bool ok = true;
+   size_t thread  = CppAD::thread_alloc::thread_num();
+   //
+   // f
+   CPPAD_TESTVECTOR( CppAD::AD<double> ) ax(1), ay(1);
+   CppAD::Independent(ax);
+   ay[0] = ax[0];
+   for(size_t k = 0; k < 1000; ++k)
+      ay[0] = sin( ay[0] );
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // do not include Taylor coefficients in the copy
+   f.capacity_order(0);
+   //
+   // g: a copy of f
+   CppAD::ADFun<double> g;
+   size_t inuse_1  = CppAD::thread_alloc::inuse(thread);
+   g = f;
+   size_t inuse_2  = CppAD::thread_alloc::inuse(thread);
+   //
+   // the operation sequence is shared, not copied
+   ok &= g.size_op_seq() == f.size_op_seq();
+   ok &= inuse_2 - inuse_1 < f.size_op_seq() / 2;
+   //
+   // f and g can be used independently
+   CPPAD_TESTVECTOR(double) x(1), yf(1), yg(1);
+   x[0]  = 0.5;
+   yf    = f.Forward(0, x);
+   x[0]  = 1.5;
+   yg    = g.Forward(0, x);
+   double check = 0.5;
+   for(size_t k = 0; k < 1000; ++k)
+      check = std::sin(check);
+   ok &= yf[0] == check;
+   ok &= f.Forward(0, x)[0] == yg[0];
+   //
+   return ok;
+}
+
 } // END_EMPTY_NAMESPACE
 
 bool adfun(void)
 {  bool ok = true;
    ok     &= adfun_empty();
    ok     &= adfun_swap();
+   ok     &= adfun_share();
    return ok;
 }
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // CPPAD_HAS_* defines
@@ -111,6 +111,7 @@ extern bool parameter(void);
 extern bool print_for(void);
 extern bool rev_sparse_jac(void);
 extern bool reverse(void);
+extern bool sparse_coloring(void);
 extern bool sparse_hessian(void);
 extern bool sparse_jac_work(void);
 extern bool sparse_jacobian(void);
@@ -130,6 +131,7 @@ extern bool is_pod(void);
 extern bool json_lexer(void);
 extern bool json_parser(void);
 extern bool temp_file(void);
+extern bool thread_table(void);
 extern bool vector_set(void);
 
 // main program that runs all the tests
@@ -230,6 +232,7 @@ int main(void)
    Run( print_for,       "print_for"      );
    Run( rev_sparse_jac,  "rev_sparse_jac" );
    Run( reverse,         "reverse"        );
+   Run( sparse_coloring, "sparse_coloring");
    Run( sparse_hessian,  "sparse_hessian" );
    Run( sparse_jac_work, "sparse_jac_work");
    Run( sparse_jacobian, "sparse_jacobian");
@@ -263,6 +266,7 @@ int main(void)
    Run( json_lexer,     "json_lexer"      );
    Run( json_parser,    "json_parser"     );
    Run( temp_file,       "temp_file"      );
+   Run( thread_table,    "thread_table"   );
    Run( vector_set,      "vector_set"     );
    //
    // check for memory leak
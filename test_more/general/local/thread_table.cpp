@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/local/thread_table.hpp>
+
+bool thread_table(void)
+{  bool ok = true;
+   //
+   // table
+   CppAD::local::thread_table<size_t> table;
+   //
+   // elements are value initialized
+   ok &= table[0] == 0;
+   ok &= table.find(0) != nullptr;
+   ok &= *table.find(0) == 0;
+   //
+   // last thread
+   size_t last = CPPAD_THREAD_LIMIT - 1;
+   table[last] = last;
+   ok &= table.size() == CPPAD_THREAD_LIMIT || last < table.size();
+   //
+   // set the other elements
+   for(size_t thread = 0; thread < last; ++thread)
+      table[thread] = thread;
+   //
+   // check all the elements
+   for(size_t thread = 0; thread <= last; ++thread)
+   {  ok &= table[thread] == thread;
+      ok &= table.find(thread) == &table[thread];
+   }
+   //
+# if CPPAD_DYNAMIC_THREADS
+   // elements are only created when they are accessed
+   CppAD::local::thread_table<size_t*> lazy;
+   ok &= lazy.size() == 0;
+   ok &= lazy.find(2) == nullptr;
+   ok &= lazy[2] == nullptr;
+   ok &= lazy.find(2) != nullptr;
+   ok &= lazy.size() == 3;
+   ok &= lazy.find(3) == nullptr;
+# endif
+   //
+   return ok;
+}
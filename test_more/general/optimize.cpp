@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 // 2DO: Test that optimize.hpp use of atomic_base<Base>::rev_sparse_jac works.
 
@@ -148,7 +148,7 @@ namespace {
       return ok;
    }
    // ====================================================================
-   // test collision_limit
+   // test that there is no collision limit
    bool exceed_collision_limit(void)
    {  bool ok = true;
       using CppAD::vector;
@@ -176,12 +176,32 @@ namespace {
       // ADFun
       CppAD::ADFun<double> f(ax, ay);
 
+      // optimize a copy of the function using the default options
+      CppAD::ADFun<double> g;
+      g = f;
+      g.optimize();
+
       // optimize the function
+      // (the collision limit is no longer used)
       std::string options = "collision_limit=1";
       f.optimize(options);
 
-      // check that the limit was exceeded
-      ok &= f.exceed_collision_limit();
+      // check that the limit was not exceeded
+      ok &= ! f.exceed_collision_limit();
+
+      // check that the same identical expressions were found
+      ok &= 0 < f.optimize_match_count();
+      ok &= f.optimize_match_count() == g.optimize_match_count();
+      ok &= f.size_var() == g.size_var();
+
+      // check that the optimized function is correct
+      vector<double> x(n), y(1), check(1);
+      for(size_t j = 0; j < n; ++j)
+         x[j] = double(j) / double(n) + double(j * j) / 7.0;
+      y = f.Forward(0, x);
+      CppAD::det_by_minor<double> det(nr);
+      check[0] = det(x);
+      ok &= CppAD::NearEqual(y[0], check[0], 1e-10, 1e-10);
 
       return ok;
    }
@@ -2413,6 +2433,573 @@ namespace {
       }
       return ok;
    }
+   // -----------------------------------------------------------------------
+   // fused multiply add operators
+   bool multiply_add_op(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      typedef vector<size_t> s_vector;
+      typedef vector<double> d_vector;
+      //
+      // ax
+      size_t n = 3;
+      vector< AD<double> > ax(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      CppAD::Independent(ax);
+      //
+      // ay
+      size_t m = 7;
+      vector< AD<double> > ay(m);
+      // variable * variable + parameter
+      ay[0] = ax[0] * ax[1] + 2.0;
+      // repeated factor
+      ay[1] = ax[0] * ax[0] + ax[2];
+      // addend equal to a factor
+      ay[2] = ax[1] * ax[2] + ax[1];
+      // Horner's method with variable coefficients
+      AD<double> ap = ax[2];
+      ap    = ap * ax[0] + ax[1];
+      ap    = ap * ax[0] + ax[2];
+      ay[3] = ap * ax[0] + ax[0];
+      // two products, only one can be fused
+      // (the products in this test are different so they are not
+      // combined by the common subexpression part of the optimizer)
+      ay[4] = (ax[0] + 1.0) * ax[1] + ax[2] * ax[2];
+      // product that is used twice is not fused
+      AD<double> at = (ax[0] - 1.0) * ax[2];
+      ay[5] = (at + 1.0) * at;
+      // product that is a dependent variable is not fused
+      ay[6] = ax[1] * ax[1];
+      ay[6] = ay[6] + 3.0 * ay[6];
+      //
+      // f, g
+      CppAD::ADFun<double> f(ax, ay), g;
+      g = f;
+      f.optimize("no_conditional_skip");
+      g.optimize("no_conditional_skip multiply_add_op");
+      //
+      // ok
+      // fused: ay[0], ay[1], ay[2], three in ay[3], one in ay[4]
+      ok &= g.size_var() + 7 == f.size_var();
+      //
+      // x
+      d_vector x(n);
+      for(size_t j = 0; j < n; ++j)
+         x[j] = 0.5 + double(j);
+      //
+      // ok: zero order forward
+      d_vector yf = f.Forward(0, x);
+      d_vector yg = g.Forward(0, x);
+      for(size_t i = 0; i < m; ++i)
+         ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+      //
+      // ok: Hessian using second order reverse mode
+      d_vector w(m);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      d_vector hf = f.Hessian(x, w);
+      d_vector hg = g.Hessian(x, w);
+      for(size_t k = 0; k < n * n; ++k)
+         ok &= NearEqual(hf[k], hg[k], eps99, eps99);
+      //
+      // ok: forward mode using multiple directions
+      size_t r = 2;
+      d_vector x1(r * n);
+      for(size_t k = 0; k < r * n; ++k)
+         x1[k] = double(k % 3) - 1.0;
+      f.Forward(0, x);
+      g.Forward(0, x);
+      yf = f.Forward(1, r, x1);
+      yg = g.Forward(1, r, x1);
+      for(size_t k = 0; k < r * m; ++k)
+         ok &= NearEqual(yf[k], yg[k], eps99, eps99);
+      //
+      // ok: Jacobian and Hessian sparsity patterns
+      bool transpose = false;
+      bool dependency = false;
+      bool internal_bool = false;
+      CppAD::sparse_rc<s_vector> pattern_in(n, n, n), pattern_f, pattern_g;
+      for(size_t k = 0; k < n; ++k)
+         pattern_in.set(k, k, k);
+      f.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_f
+      );
+      g.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_g
+      );
+      ok &= pattern_f == pattern_g;
+      vector<bool> select_range(m), select_domain(n);
+      for(size_t i = 0; i < m; ++i)
+         select_range[i] = true;
+      for(size_t j = 0; j < n; ++j)
+         select_domain[j] = true;
+      f.rev_hes_sparsity(select_range, transpose, internal_bool, pattern_f);
+      g.rev_hes_sparsity(select_range, transpose, internal_bool, pattern_g);
+      ok &= pattern_f == pattern_g;
+      f.for_hes_sparsity(
+         select_domain, select_range, internal_bool, pattern_f
+      );
+      g.for_hes_sparsity(
+         select_domain, select_range, internal_bool, pattern_g
+      );
+      ok &= pattern_f == pattern_g;
+      //
+      // ok: Hessian using edge pushing
+      CppAD::sparse_rcv<s_vector, d_vector> hes_f, hes_g;
+      f.sparse_hes_edge(x, w, hes_f);
+      g.sparse_hes_edge(x, w, hes_g);
+      ok &= hes_f.nnz() == hes_g.nnz();
+      if( ok )
+      {  s_vector order_f = hes_f.row_major(), order_g = hes_g.row_major();
+         for(size_t k = 0; k < hes_f.nnz(); ++k)
+         {  size_t kf = order_f[k], kg = order_g[k];
+            ok &= hes_f.row()[kf] == hes_g.row()[kg];
+            ok &= hes_f.col()[kf] == hes_g.col()[kg];
+            ok &= NearEqual(hes_f.val()[kf], hes_g.val()[kg], eps99, eps99);
+         }
+      }
+      //
+      // ok: re-optimize a function that has fused operators
+      size_t size_var = g.size_var();
+      g.optimize("no_conditional_skip multiply_add_op");
+      ok &= g.size_var() == size_var;
+      yf = f.Forward(0, x);
+      yg = g.Forward(0, x);
+      for(size_t i = 0; i < m; ++i)
+         ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // weighted summation operator
+   bool weighted_sum_op(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      typedef vector<size_t> s_vector;
+      typedef vector<double> d_vector;
+      //
+      // ax, ap
+      size_t n = 4;
+      vector< AD<double> > ax(n), ap(2);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = double(j + 1);
+      ap[0] = 2.0;
+      ap[1] = 3.0;
+      CppAD::Independent(ax, ap);
+      //
+      // ay
+      size_t m = 4;
+      vector< AD<double> > ay(m);
+      // added and subtracted terms together with a variable and a constant
+      ay[0] = 2.0 * ax[0] + 3.0 * ax[1] - 4.0 * ax[2]
+            + ax[0] * ax[3] - ax[1] * ax[1] + ax[2] + 5.0;
+      // dynamic parameter weights and no other terms
+      ay[1] = ap[0] * ax[0] + ap[1] * ax[1] - ax[2] * ax[3];
+      // product that is used twice is not a term
+      AD<double> at = ax[0] * ax[1];
+      ay[2] = at + ax[1] * ax[2] + ax[0];
+      ay[3] = at;
+      //
+      // f, g, h
+      CppAD::ADFun<double> f(ax, ay), g, h;
+      g = f;
+      h = f;
+      f.optimize("no_conditional_skip");
+      g.optimize("no_conditional_skip weighted_sum_op");
+      //
+      // ok
+      // ay[0]: five products replaced by one weighted sum
+      // ay[1]: three products and a cumulative sum replaced by a weighted sum
+      // ay[2]: one product replaced by a weighted sum
+      ok &= g.size_var() + 7 == f.size_var();
+      //
+      // x, p
+      d_vector x(n), p(2);
+      for(size_t j = 0; j < n; ++j)
+         x[j] = 0.5 + double(j);
+      p[0] = 1.5;
+      p[1] = -2.0;
+      f.new_dynamic(p);
+      g.new_dynamic(p);
+      h.new_dynamic(p);
+      //
+      // ok: zero order forward
+      d_vector yf = f.Forward(0, x);
+      d_vector yg = g.Forward(0, x);
+      for(size_t i = 0; i < m; ++i)
+         ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+      //
+      // ok: Hessian using second order reverse mode
+      d_vector w(m);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = double(i + 1);
+      d_vector hf = f.Hessian(x, w);
+      d_vector hg = g.Hessian(x, w);
+      for(size_t k = 0; k < n * n; ++k)
+         ok &= NearEqual(hf[k], hg[k], eps99, eps99);
+      //
+      // ok: forward mode using multiple directions
+      size_t r = 2;
+      d_vector x1(r * n);
+      for(size_t k = 0; k < r * n; ++k)
+         x1[k] = double(k % 3) - 1.0;
+      f.Forward(0, x);
+      g.Forward(0, x);
+      yf = f.Forward(1, r, x1);
+      yg = g.Forward(1, r, x1);
+      for(size_t k = 0; k < r * m; ++k)
+         ok &= NearEqual(yf[k], yg[k], eps99, eps99);
+      //
+      // ok: Jacobian and Hessian sparsity patterns
+      bool transpose = false;
+      bool dependency = false;
+      bool internal_bool = false;
+      CppAD::sparse_rc<s_vector> pattern_in(n, n, n);
+      CppAD::sparse_rc<s_vector> pattern_f, pattern_g, pattern_h;
+      for(size_t k = 0; k < n; ++k)
+         pattern_in.set(k, k, k);
+      g.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_g
+      );
+      h.for_jac_sparsity(
+         pattern_in, transpose, dependency, internal_bool, pattern_h
+      );
+      ok &= pattern_g == pattern_h;
+      vector<bool> select_range(m), select_domain(n);
+      for(size_t i = 0; i < m; ++i)
+         select_range[i] = true;
+      for(size_t j = 0; j < n; ++j)
+         select_domain[j] = true;
+      g.rev_hes_sparsity(select_range, transpose, internal_bool, pattern_g);
+      h.rev_hes_sparsity(select_range, transpose, internal_bool, pattern_h);
+      ok &= pattern_g == pattern_h;
+      // f has cumulative sum operators
+      f.for_hes_sparsity(
+         select_domain, select_range, internal_bool, pattern_f
+      );
+      g.for_hes_sparsity(
+         select_domain, select_range, internal_bool, pattern_g
+      );
+      h.for_hes_sparsity(
+         select_domain, select_range, internal_bool, pattern_h
+      );
+      ok &= pattern_f == pattern_h;
+      ok &= pattern_g == pattern_h;
+      //
+      // ok: Hessian using edge pushing
+      CppAD::sparse_rcv<s_vector, d_vector> hes_f, hes_g;
+      f.sparse_hes_edge(x, w, hes_f);
+      g.sparse_hes_edge(x, w, hes_g);
+      ok &= hes_f.nnz() == hes_g.nnz();
+      if( ok )
+      {  s_vector order_f = hes_f.row_major(), order_g = hes_g.row_major();
+         for(size_t k = 0; k < hes_f.nnz(); ++k)
+         {  size_t kf = order_f[k], kg = order_g[k];
+            ok &= hes_f.row()[kf] == hes_g.row()[kg];
+            ok &= hes_f.col()[kf] == hes_g.col()[kg];
+            ok &= NearEqual(hes_f.val()[kf], hes_g.val()[kg], eps99, eps99);
+         }
+      }
+      //
+      // ok: re-optimize a function that has weighted sum operators
+      size_t size_var = g.size_var();
+      g.optimize("no_conditional_skip weighted_sum_op");
+      ok &= g.size_var() == size_var;
+      yf = f.Forward(0, x);
+      yg = g.Forward(0, x);
+      for(size_t i = 0; i < m; ++i)
+         ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+      //
+      // ok: reverse mode where a cumulative sum and a weighted sum are
+      // conditionally skipped
+      CppAD::Independent(ax);
+      AD<double> as = ax[0] + ax[1] + ax[2];
+      AD<double> au = as * as + 2.0 * ax[2] + ax[0] * ax[1] + 1.0;
+      vector< AD<double> > az(1);
+      az[0] = CppAD::CondExpLt(ax[0], ax[1], au, ax[3]);
+      f.Dependent(ax, az);
+      g = f;
+      f.optimize("weighted_sum_op");
+      for(size_t j = 0; j < n; ++j)
+         x[j] = double(n - j);
+      d_vector wz(1);
+      wz[0] = 1.0;
+      f.Forward(0, x);
+      g.Forward(0, x);
+      yf = f.Reverse(1, wz);
+      yg = g.Reverse(1, wz);
+      for(size_t j = 0; j < n; ++j)
+         ok &= NearEqual(yf[j], yg[j], eps99, eps99);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // incremental option
+   bool incremental_option(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // f
+      size_t n = 2;
+      vector< AD<double> > ax(n), ap(1), ay(1);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      ap[0] = 3.0;
+      CppAD::Independent(ax, ap);
+      AD<double> au = ap[0] * sin(ax[0]) + ap[0] * sin(ax[0]);
+      AD<double> av = ap[0] * cos(ax[1]);
+      ay[0] = CppAD::CondExpLt(ax[0], ax[1], au, av);
+      CppAD::ADFun<double> f(ax, ay);
+      //
+      // ok: incremental does a full optimization the first time
+      f.optimize("incremental no_conditional_skip");
+      size_t size_op = f.size_op();
+      ok &= 0 < f.optimize_match_count();
+      //
+      // ok: the options are not equivalent so f is optimized again and
+      // conditional skip operators are added
+      f.optimize("incremental");
+      ok &= size_op < f.size_op();
+      size_op = f.size_op();
+      //
+      // ok: nothing changed so the optimization is skipped
+      vector<double> p(1), x(n), y(1);
+      p[0] = 4.0;
+      f.new_dynamic(p);
+      f.optimize("incremental");
+      ok &= f.size_op() == size_op;
+      ok &= f.optimize_match_count() == 0;
+      //
+      // ok: the optimized function uses the new dynamic parameter value
+      for(size_t i = 0; i < 2; ++i)
+      {  x[0] = 1.0 + double(i);
+         x[1] = 1.5;
+         y    = f.Forward(0, x);
+         double check;
+         if( x[0] < x[1] )
+            check = 2.0 * p[0] * std::sin(x[0]);
+         else
+            check = p[0] * std::cos(x[1]);
+         ok &= NearEqual(y[0], check, eps99, eps99);
+      }
+      //
+      // ok: equivalent options (different order) also skip
+      f.optimize("no_compare_op incremental");
+      size_op = f.size_op();
+      f.optimize("incremental  no_compare_op ");
+      ok &= f.size_op() == size_op;
+      //
+      // ok: a new operation sequence is optimized
+      CppAD::Independent(ax, ap);
+      au    = ap[0] * sin(ax[0]) + ap[0] * sin(ax[0]);
+      ay[0] = au;
+      f.Dependent(ax, ay);
+      f.optimize("incremental no_compare_op");
+      ok &= 0 < f.optimize_match_count();
+      p[0] = 5.0;
+      f.new_dynamic(p);
+      y = f.Forward(0, x);
+      ok &= NearEqual(y[0], 2.0 * p[0] * std::sin(x[0]), eps99, eps99);
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // conditional_skip_cost, merged conditional skips, number_skip_op
+   bool conditional_skip_cost(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      size_t n = 2;
+      vector< AD<double> > ax(n), ay(1);
+      vector<double> x(n), y(1);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      //
+      // f: the cases are cheap
+      CppAD::Independent(ax);
+      ay[0] = CppAD::CondExpLt(ax[0], ax[1], ax[0] + ax[1], ax[0] - ax[1]);
+      CppAD::ADFun<double> f(ax, ay);
+      f.optimize("no_conditional_skip");
+      size_t size_op = f.size_op();
+      //
+      // ok: by default a conditional skip is generated
+      f.optimize();
+      ok &= f.size_op() == size_op + 1;
+      //
+      // ok: a conditional skip is not profitable
+      f.optimize("conditional_skip_cost=1");
+      ok &= f.size_op() == size_op;
+      //
+      // f: the true case is expensive
+      CppAD::Independent(ax);
+      AD<double> au = sin(ax[0]) * cos(ax[0]) + exp(ax[0]);
+      ay[0] = CppAD::CondExpLt(ax[0], ax[1], au, ax[0] - ax[1]);
+      f.Dependent(ax, ay);
+      f.optimize("no_conditional_skip");
+      size_op = f.size_op();
+      //
+      // ok: the conditional skip is profitable
+      f.optimize("conditional_skip_cost=1");
+      ok &= f.size_op() == size_op + 1;
+      ok &= f.number_skip_op() == 0;
+      //
+      // ok: the true case is skipped
+      x[0] = 3.0;
+      x[1] = 2.0;
+      y    = f.Forward(0, x);
+      ok  &= NearEqual(y[0], x[0] - x[1], eps99, eps99);
+      ok  &= f.number_skip_op() == 5;
+      //
+      // f: two conditional expressions with the same comparison
+      // and both true cases use sin(x[0])
+      vector< AD<double> > az(2);
+      CppAD::Independent(ax);
+      AD<double> as = sin(ax[0]);
+      AD<double> ac = cos(ax[1]);
+      az[0] = CppAD::CondExpLt(ax[0], ax[1], as, ac);
+      az[1] = CppAD::CondExpLt(ax[0], ax[1], as + ax[1], ac + ax[1]);
+      f.Dependent(ax, az);
+      f.optimize("no_conditional_skip");
+      size_op = f.size_op();
+      //
+      // ok: one conditional skip is used for both conditional expressions
+      f.optimize();
+      ok &= f.size_op() == size_op + 1;
+      //
+      // ok: sin(x[0]) and as + x[1] are skipped when the comparison is false,
+      // cos(x[1]) and ac + x[1] are skipped when it is true
+      vector<double> z(2);
+      for(size_t i = 0; i < 2; ++i)
+      {  x[0] = 1.0 + 2.0 * double(i);
+         x[1] = 2.0;
+         z    = f.Forward(0, x);
+         double check = std::cos(x[1]);
+         if( x[0] < x[1] )
+            check = std::sin(x[0]);
+         ok &= NearEqual(z[0], check, eps99, eps99);
+         ok &= NearEqual(z[1], check + x[1], eps99, eps99);
+         ok &= f.number_skip_op() == 2;
+      }
+      //
+      return ok;
+   }
+   // -----------------------------------------------------------------------
+   // freeze_dynamic
+   template <class Vector>
+   Vector freeze_dynamic_fun(const Vector& x, const Vector& p)
+   {  typedef typename Vector::value_type scalar;
+      //
+      // r: depends only on p[0]
+      scalar r = exp( p[0] );
+      //
+      // s: depends only on p[0] and is a conditional expression
+      scalar s = CppAD::CondExpGt(p[0], r, p[0], r);
+      //
+      // q: depends on p[0] and p[1]
+      scalar q = p[0] * p[1];
+      //
+      // y
+      Vector y(5);
+      y[0] = x[0] + x[1] + p[0] + p[1];
+      y[1] = CppAD::CondExpLt(p[0], scalar(3.0), sin(x[0]) * r, cos(x[1]));
+      y[2] = CppAD::CondExpLt(x[0], p[0], x[0] * s, x[1] * q);
+      y[3] = CppAD::CondExpLt(p[0], scalar(3.0), scalar(4.0), x[0] * x[1]);
+      y[4] = CppAD::CondExpLt(p[1], scalar(3.0), x[0] * q, x[1] * r);
+      return y;
+   }
+   bool freeze_dynamic(const std::string& options)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // f
+      size_t n = 2, m = 5;
+      vector< AD<double> > ax(n), ap(2), ay(m);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      ap[0] = 0.5;
+      ap[1] = 1.5;
+      CppAD::Independent(ax, ap);
+      ay = freeze_dynamic_fun(ax, ap);
+      CppAD::ADFun<double> f(ax, ay);
+      f.optimize(options);
+      //
+      // f: p[0] is frozen at 2.0
+      vector<double> p(2), x(n), y(m), check(m);
+      p[0] = 2.0;
+      p[1] = 1.5;
+      f.new_dynamic(p);
+      size_t size_dyn_par = f.size_dyn_par();
+      size_t size_var     = f.size_var();
+      vector<bool> frozen(2);
+      frozen[0] = true;
+      frozen[1] = false;
+      f.freeze_dynamic(frozen, options);
+      //
+      // ok: r and s are no longer dynamic, the false case of y[1]
+      // and the true case of y[3] are no longer variables
+      ok &= f.size_dyn_ind() == 2;
+      ok &= f.size_dyn_par() < size_dyn_par;
+      ok &= f.size_var() < size_var;
+      ok &= f.size_order() == 0;
+      //
+      // ok: zero order, p[0] is ignored by new_dynamic
+      vector<double> frozen_p(2);
+      frozen_p[0] = 2.0;
+      for(size_t k = 0; k < 2; ++k)
+      {  p[0]        = 5.0 * double(k);
+         p[1]        = 2.0 + 2.0 * double(k);
+         frozen_p[1] = p[1];
+         f.new_dynamic(p);
+         x[0]  = 1.5;
+         x[1]  = 2.5;
+         y     = f.Forward(0, x);
+         check = freeze_dynamic_fun(x, frozen_p);
+         for(size_t i = 0; i < m; ++i)
+            ok &= NearEqual(y[i], check[i], eps99, eps99);
+      }
+      //
+      // ok: first order forward and reverse
+      vector<double> dx(n), dy(m), w(m), dw(n);
+      dx[0] = 1.0;
+      dx[1] = 0.0;
+      dy    = f.Forward(1, dx);
+      ok   &= NearEqual(dy[0], 1.0, eps99, eps99);
+      ok   &= NearEqual(dy[1], std::cos(x[0]) * std::exp(2.0), eps99, eps99);
+      for(size_t i = 0; i < m; ++i)
+         w[i] = 0.0;
+      w[3] = 1.0;
+      dw   = f.Reverse(1, w);
+      ok  &= NearEqual(dw[0], 0.0, eps99, eps99);
+      ok  &= NearEqual(dw[1], 0.0, eps99, eps99);
+      //
+      // ok: freezing p[1] as well leaves no dependent dynamic parameters
+      frozen[1] = true;
+      f.freeze_dynamic(frozen, options);
+      ok &= f.size_dyn_par() == 2;
+      p[1] = 7.0;
+      f.new_dynamic(p);
+      y = f.Forward(0, x);
+      for(size_t i = 0; i < m; ++i)
+         ok &= NearEqual(y[i], check[i], eps99, eps99);
+      //
+      return ok;
+   }
 }
 
 bool optimize(void)
@@ -2557,6 +3144,12 @@ bool optimize(void)
 
    // not using conditional_skip or atomic functions
    ok &= only_check_variables_when_hash_codes_match();
+   ok &= multiply_add_op();
+   ok &= weighted_sum_op();
+   ok &= incremental_option();
+   ok &= conditional_skip_cost();
+   ok &= freeze_dynamic("");
+   ok &= freeze_dynamic("no_conditional_skip no_cumulative_sum_op");
    // -----------------------------------------------------------------------
    //
    CppAD::user_atomic<double>::clear();
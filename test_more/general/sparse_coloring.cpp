@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+Test the cppad coloring orders, the star and acyclic Hessian colorings,
+and the coloring quality lower bound.
+*/
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+typedef CPPAD_TESTVECTOR(double)              d_vector;
+typedef CPPAD_TESTVECTOR(size_t)              s_vector;
+typedef CppAD::sparse_rc<s_vector>            sparsity;
+typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+//
+// function with a Jacobian and Hessian that have a non-trivial pattern
+CppAD::ADFun<double> test_fun(size_t n)
+{  using CppAD::AD;
+   CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1) / double(n);
+   CppAD::Independent(ax);
+   //
+   // arrow head from x[0]
+   AD<double> sum = 0.0;
+   for(size_t j = 1; j < n; ++j)
+      sum += ax[0] * ax[j];
+   ay[0] = sum;
+   //
+   // banded terms and terms that connect every third variable
+   for(size_t i = 1; i < n; ++i)
+   {  ay[i]  = ax[i] * ax[i-1] * ax[i];
+      ay[i] += ax[i] * ax[ (3 * i) % n ];
+      if( i % 4 == 0 )
+         ay[i] += sin( ax[ (5 * i) % n ] ) * ax[ (i + 2) % n ];
+   }
+   return CppAD::ADFun<double>(ax, ay);
+}
+//
+// subset corresponding to a pattern
+sparse_matrix full_subset(const sparsity& pattern)
+{  return sparse_matrix(pattern);
+}
+//
+// lower triangle of a Hessian pattern
+sparse_matrix lower_subset(const sparsity& pattern)
+{  size_t n = pattern.nr();
+   size_t nnz = 0;
+   for(size_t k = 0; k < pattern.nnz(); ++k)
+      if( pattern.col()[k] <= pattern.row()[k] )
+         ++nnz;
+   sparsity lower(n, n, nnz);
+   size_t ell = 0;
+   for(size_t k = 0; k < pattern.nnz(); ++k)
+   {  size_t r = pattern.row()[k];
+      size_t c = pattern.col()[k];
+      if( c <= r )
+         lower.set(ell++, r, c);
+   }
+   return sparse_matrix(lower);
+}
+//
+// check a sparse result against a dense matrix with row major order
+bool check_subset(
+   size_t nc, const sparse_matrix& subset, const d_vector& dense)
+{  bool ok = true;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   for(size_t k = 0; k < subset.nnz(); ++k)
+   {  size_t r = subset.row()[k];
+      size_t c = subset.col()[k];
+      ok &= CppAD::NearEqual(subset.val()[k], dense[r * nc + c], eps99, eps99);
+   }
+   return ok;
+}
+//
+bool jacobian(void)
+{  bool ok = true;
+   size_t n = 13;
+   CppAD::ADFun<double> f = test_fun(n);
+   size_t m = f.Range();
+   //
+   // x, jac
+   d_vector x(n);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j + 2) / double(n);
+   d_vector jac = f.Jacobian(x);
+   //
+   // pattern
+   sparsity pattern_in(n, n, n), pattern;
+   for(size_t j = 0; j < n; ++j)
+      pattern_in.set(j, j, j);
+   f.for_jac_sparsity(pattern_in, false, false, false, pattern);
+   //
+   const char* coloring[] = {
+      "cppad",
+      "cppad.largest_first",
+      "cppad.smallest_last",
+      "cppad.incidence_degree"
+   };
+   size_t n_coloring = sizeof(coloring) / sizeof(coloring[0]);
+   for(size_t i_coloring = 0; i_coloring < n_coloring; ++i_coloring)
+   {  // forward
+      {  sparse_matrix subset = full_subset(pattern);
+         CppAD::sparse_jac_work work;
+         ok &= work.color_lower_bound == 0;
+         size_t group_max = 1;
+         size_t n_color   = f.sparse_jac_for(
+            group_max, x, subset, pattern, coloring[i_coloring], work
+         );
+         ok &= check_subset(n, subset, jac);
+         ok &= 0 < work.color_lower_bound;
+         ok &= work.color_lower_bound <= n_color;
+         ok &= n_color <= n;
+      }
+      // reverse
+      {  sparse_matrix subset = full_subset(pattern);
+         CppAD::sparse_jac_work work;
+         size_t n_color = f.sparse_jac_rev(
+            x, subset, pattern, coloring[i_coloring], work
+         );
+         ok &= check_subset(n, subset, jac);
+         ok &= 0 < work.color_lower_bound;
+         ok &= work.color_lower_bound <= n_color;
+         ok &= n_color <= m;
+         //
+         work.clear();
+         ok &= work.color_lower_bound == 0;
+      }
+   }
+   return ok;
+}
+//
+bool hessian(void)
+{  bool ok = true;
+   size_t n = 13;
+   CppAD::ADFun<double> f = test_fun(n);
+   size_t m = f.Range();
+   //
+   // x, w, hes
+   d_vector x(n), w(m);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j + 2) / double(n);
+   for(size_t i = 0; i < m; ++i)
+      w[i] = double(i + 1);
+   d_vector hes = f.Hessian(x, w);
+   //
+   // pattern
+   CPPAD_TESTVECTOR(bool) select_domain(n), select_range(m);
+   for(size_t j = 0; j < n; ++j)
+      select_domain[j] = true;
+   for(size_t i = 0; i < m; ++i)
+      select_range[i] = true;
+   sparsity pattern;
+   f.for_hes_sparsity(select_domain, select_range, false, pattern);
+   //
+   const char* coloring[] = {
+      "cppad.symmetric",
+      "cppad.general",
+      "cppad.general.largest_first",
+      "cppad.general.smallest_last",
+      "cppad.general.incidence_degree",
+      "cppad.star",
+      "cppad.acyclic"
+   };
+   size_t n_coloring = sizeof(coloring) / sizeof(coloring[0]);
+   size_t n_star = 0, n_acyclic = 0;
+   for(size_t i_coloring = 0; i_coloring < n_coloring; ++i_coloring)
+   for(size_t lower = 0; lower < 2; ++lower)
+   {  sparse_matrix subset = full_subset(pattern);
+      if( lower == 1 )
+         subset = lower_subset(pattern);
+      CppAD::sparse_hes_work work;
+      std::string name = coloring[i_coloring];
+      size_t n_sweep = f.sparse_hes(x, w, subset, pattern, name, work);
+      ok &= check_subset(n, subset, hes);
+      ok &= 0 < work.color_lower_bound;
+      ok &= work.color_lower_bound <= n_sweep;
+      ok &= n_sweep <= n;
+      if( name == "cppad.star" )
+         n_star = n_sweep;
+      if( name == "cppad.acyclic" )
+      {  n_acyclic = n_sweep;
+         ok &= work.subs_row.size() > 0;
+      }
+      //
+      // reuse work with a different x
+      d_vector x2(n);
+      for(size_t j = 0; j < n; ++j)
+         x2[j] = double(n - j) / double(n);
+      d_vector hes2 = f.Hessian(x2, w);
+      f.sparse_hes(x2, w, subset, pattern, name, work);
+      ok &= check_subset(n, subset, hes2);
+   }
+   // the arrow head requires n colors in the general case
+   // but not for a star or acyclic coloring
+   ok &= n_star < n;
+   ok &= n_acyclic < n;
+   //
+   return ok;
+}
+} // END_EMPTY_NAMESPACE
+
+bool sparse_coloring(void)
+{  bool ok = true;
+   ok &= jacobian();
+   ok &= hessian();
+   return ok;
+}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
+# include <cppad/local/val_graph/tape.hpp>
+/*
+{xrst_begin val_eval_plan_xam.cpp dev}
+
+Batched Evaluation Plan Example
+###############################
+{xrst_literal
+   // BEGIN_C++
+   // END_C++
+}
+
+{xrst_end val_eval_plan_xam.cpp}
+*/
+// BEGIN_C++
+namespace {
+   // check_plan
+   // check that eval_plan_t and tape.eval give the same result
+   bool check_plan(
+      const CppAD::local::val_graph::tape_t<double>& tape    ,
+      const CppAD::local::val_graph::Vector<double>& x_mat   ,
+      size_t                                         n_batch )
+   {  bool ok = true;
+      //
+      // eval_plan_t, Vector, addr_t
+      using CppAD::local::val_graph::eval_plan_t;
+      using CppAD::local::val_graph::Vector;
+      using CppAD::local::val_graph::addr_t;
+      //
+      // n_ind, n_val
+      size_t n_ind = size_t( tape.n_ind() );
+      size_t n_val = size_t( tape.n_val() );
+      //
+      // val_mat, compare_false
+      Vector<double> val_mat(n_val * n_batch);
+      Vector<size_t> compare_false(n_batch);
+      for(size_t b = 0; b < n_batch; ++b)
+      {  compare_false[b] = 0;
+         for(size_t j = 0; j < n_ind; ++j)
+            val_mat[j * n_batch + b] = x_mat[j * n_batch + b];
+      }
+      eval_plan_t<double> plan(tape);
+      plan.eval(n_batch, val_mat, compare_false);
+      //
+      // ok
+      bool trace = false;
+      Vector<double> val_vec(n_val);
+      for(size_t b = 0; b < n_batch; ++b)
+      {  for(size_t j = 0; j < n_ind; ++j)
+            val_vec[j] = x_mat[j * n_batch + b];
+         size_t compare_false_b = 0;
+         tape.eval(trace, val_vec, compare_false_b);
+         ok &= compare_false[b] == compare_false_b;
+         for(size_t i = 0; i < tape.dep_vec().size(); ++i)
+         {  size_t dep_index = size_t( tape.dep_vec()[i] );
+            ok &= val_mat[dep_index * n_batch + b] == val_vec[dep_index];
+         }
+      }
+      return ok;
+   }
+}
+bool eval_plan_xam(void)
+{  bool ok = true;
+   //
+   // tape_t, Vector, addr_t, op_enum_t, compare_lt_enum
+   using CppAD::local::val_graph::tape_t;
+   using CppAD::local::val_graph::Vector;
+   using CppAD::local::val_graph::addr_t;
+   using CppAD::local::val_graph::op_enum_t;
+   op_enum_t add_op_enum = CppAD::local::val_graph::add_op_enum;
+   op_enum_t mul_op_enum = CppAD::local::val_graph::mul_op_enum;
+   op_enum_t sub_op_enum = CppAD::local::val_graph::sub_op_enum;
+   op_enum_t exp_op_enum = CppAD::local::val_graph::exp_op_enum;
+   CppAD::local::val_graph::compare_enum_t compare_lt_enum =
+      CppAD::local::val_graph::compare_lt_enum;
+   //
+   // tape
+   tape_t<double> tape;
+   addr_t n_ind = 3;
+   tape.set_ind(n_ind);
+   //
+   // x0, x1, x2, zero, one, two
+   addr_t x0   = 0;
+   addr_t x1   = 1;
+   addr_t x2   = 2;
+   addr_t zero = tape.record_con_op(0.0);
+   addr_t one  = tape.record_con_op(1.0);
+   addr_t two  = tape.record_con_op(2.0);
+   //
+   // mul = x0 * x1, sub = x0 * x1 - x2, ex = exp(x0 * x1 - x2)
+   Vector<addr_t> op_arg(2);
+   op_arg[0] = x0;
+   op_arg[1] = x1;
+   addr_t mul = tape.record_op(mul_op_enum, op_arg);
+   op_arg[0] = mul;
+   op_arg[1] = x2;
+   addr_t sub = tape.record_op(sub_op_enum, op_arg);
+   op_arg.resize(1);
+   op_arg[0] = sub;
+   addr_t ex  = tape.record_op(exp_op_enum, op_arg);
+   //
+   // comp: x0 < x1
+   tape.record_comp_op(compare_lt_enum, x0, x1);
+   //
+   // cexp = x0 < x1 ? x0 * x1 : x2
+   addr_t cexp = tape.record_cexp_op(compare_lt_enum, x0, x1, mul, x2);
+   //
+   // vector = { one, two }, vector[ x2 ] = ex, load = vector[ zero ]
+   Vector<addr_t> initial = {one, two};
+   addr_t which_vector = tape.record_vec_op(initial);
+   tape.record_store_op(which_vector, x2, ex);
+   addr_t load = tape.record_load_op(which_vector, zero);
+   //
+   // sum = x0 + x1 + load - mul (uses values before and after the load)
+   op_arg.resize(2);
+   op_arg[0] = x0;
+   op_arg[1] = x1;
+   addr_t sum = tape.record_op(add_op_enum, op_arg);
+   op_arg[0] = sum;
+   op_arg[1] = load;
+   sum       = tape.record_op(add_op_enum, op_arg);
+   op_arg[0] = sum;
+   op_arg[1] = mul;
+   sum       = tape.record_op(sub_op_enum, op_arg);
+   //
+   // set_dep
+   Vector<addr_t> dep_vec = {ex, cexp, load, sum};
+   tape.set_dep( dep_vec );
+   //
+   // n_batch, x_mat
+   // x2 is zero (one) for even (odd) batch elements
+   size_t n_batch = 5;
+   Vector<double> x_mat(size_t(n_ind) * n_batch);
+   for(size_t b = 0; b < n_batch; ++b)
+   {  x_mat[0 * n_batch + b] = double(b) - 2.0;
+      x_mat[1 * n_batch + b] = 0.5;
+      x_mat[2 * n_batch + b] = double(b % 2);
+   }
+   //
+   // ok
+   ok &= check_plan(tape, x_mat, n_batch);
+   //
+   // ok
+   // replace the additions and subtractions by cumulative summations
+   tape.summation();
+   ok &= check_plan(tape, x_mat, n_batch);
+   //
+   return ok;
+}
+// END_C++
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
+# include <cppad/local/val_graph/tape.hpp>
+/*
+{xrst_begin val_renumber_thread_xam.cpp dev}
+
+Value Tape Re-Numbering Using Multiple Threads Example
+######################################################
+{xrst_literal
+   // BEGIN_C++
+   // END_C++
+}
+
+{xrst_end val_renumber_thread_xam.cpp}
+*/
+// BEGIN_C++
+namespace {
+   // record_tape
+   // Each level of this tape has more than 4000 operators and
+   // many of the operators are equivalent.
+   void record_tape(CppAD::local::val_graph::tape_t<double>& tape)
+   {  //
+      // Vector, addr_t, op_enum_t, compare_lt_enum
+      using CppAD::local::val_graph::Vector;
+      using CppAD::local::val_graph::addr_t;
+      using CppAD::local::val_graph::op_enum_t;
+      op_enum_t add_op_enum = CppAD::local::val_graph::add_op_enum;
+      op_enum_t mul_op_enum = CppAD::local::val_graph::mul_op_enum;
+      op_enum_t sub_op_enum = CppAD::local::val_graph::sub_op_enum;
+      CppAD::local::val_graph::compare_enum_t compare_lt_enum =
+         CppAD::local::val_graph::compare_lt_enum;
+      //
+      // n_ind, n_level
+      addr_t n_ind   = 4;
+      addr_t n_level = 5000;
+      tape.set_ind(n_ind);
+      //
+      // con
+      // level zero: constants with repeated values
+      Vector<addr_t> con(n_level);
+      for(addr_t i = 0; i < n_level; ++i)
+         con[i] = tape.record_con_op( double(i % 7) );
+      //
+      // first
+      // level one: x[j] + x[k], x[j] * x[k], and x[j] < x[k] for
+      // all pairs (j, k). Additions and multiplications are communative.
+      Vector<addr_t> first(n_level), op_arg(2);
+      for(addr_t i = 0; i < n_level; ++i)
+      {  op_arg[0] = i % n_ind;
+         op_arg[1] = (i / n_ind) % n_ind;
+         if( i % 3 == 0 )
+            first[i] = tape.record_op(add_op_enum, op_arg);
+         else
+            first[i] = tape.record_op(mul_op_enum, op_arg);
+         if( i % 5 == 0 )
+            tape.record_comp_op(compare_lt_enum, op_arg[0], op_arg[1]);
+      }
+      //
+      // second
+      // level two: first[i] - con[i]
+      Vector<addr_t> second(n_level);
+      for(addr_t i = 0; i < n_level; ++i)
+      {  op_arg[0] = first[i];
+         op_arg[1] = con[i];
+         second[i] = tape.record_op(sub_op_enum, op_arg);
+      }
+      //
+      // set_dep
+      tape.set_dep( second );
+   }
+}
+bool renumber_thread_xam(void)
+{  bool ok = true;
+   //
+   // tape_t, Vector, addr_t
+   using CppAD::local::val_graph::tape_t;
+   using CppAD::local::val_graph::Vector;
+   using CppAD::local::val_graph::addr_t;
+   //
+   // tape_one, tape_four
+   tape_t<double> tape_one, tape_four;
+   record_tape(tape_one);
+   record_tape(tape_four);
+   //
+   // val_vec, compare_false
+   bool trace = false;
+   Vector<double> val_vec( tape_one.n_val() );
+   for(addr_t i = 0; i < tape_one.n_ind(); ++i)
+      val_vec[i] = double(i + 1);
+   size_t compare_false = 0;
+   tape_one.eval(trace, val_vec, compare_false);
+   //
+   // y
+   Vector<addr_t> dep_vec = tape_one.dep_vec();
+   Vector<double> y( dep_vec.size() );
+   for(size_t i = 0; i < dep_vec.size(); ++i)
+      y[i] = val_vec[ dep_vec[i] ];
+   //
+   // renumber
+   tape_one.renumber();
+   tape_four.renumber(4);
+   //
+   // ok
+   // the tapes are the same when one and four threads are used
+   ok &= tape_one.arg_vec().size() == tape_four.arg_vec().size();
+   for(size_t i = 0; i < tape_one.arg_vec().size(); ++i)
+      ok &= tape_one.arg_vec()[i] == tape_four.arg_vec()[i];
+   ok &= tape_one.dep_vec().size() == tape_four.dep_vec().size();
+   for(size_t i = 0; i < tape_one.dep_vec().size(); ++i)
+      ok &= tape_one.dep_vec()[i] == tape_four.dep_vec()[i];
+   //
+   // ok
+   // there are 2 operators, 10 unordered pairs (j, k), and 7 constants,
+   // so only 2 * 10 * 7 of the level two results are unique.
+   dep_vec = tape_four.dep_vec();
+   Vector<bool> unique( tape_four.n_val() );
+   for(addr_t i = 0; i < tape_four.n_val(); ++i)
+      unique[i] = false;
+   size_t n_unique = 0;
+   for(size_t i = 0; i < dep_vec.size(); ++i)
+   {  if( ! unique[ dep_vec[i] ] )
+         ++n_unique;
+      unique[ dep_vec[i] ] = true;
+   }
+   ok &= n_unique == 2 * 10 * 7;
+   //
+   // ok
+   // the function values did not change
+   tape_four.eval(trace, val_vec, compare_false);
+   for(size_t i = 0; i < dep_vec.size(); ++i)
+      ok &= y[i] == val_vec[ dep_vec[i] ];
+   //
+   return ok;
+}
+// END_C++
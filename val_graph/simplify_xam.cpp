@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
+# include <cppad/local/val_graph/tape.hpp>
+# include <cppad/utility/near_equal.hpp>
+/*
+{xrst_begin val_simplify_xam.cpp dev}
+
+Value Tape Algebraic Simplification Example
+###########################################
+{xrst_literal
+   // BEGIN_C++
+   // END_C++
+}
+
+{xrst_end val_simplify_xam.cpp}
+*/
+// BEGIN_C++
+namespace {
+   // record_tape
+   // y[0] = ( x0 * 1 + 0 ) - ( x1 - x1 )
+   // y[1] = pow(x0, 3) / 4
+   // y[2] = exp( log(x1) ) - ( - ( - x0 ) )
+   void record_tape(CppAD::local::val_graph::tape_t<double>& tape)
+   {  //
+      // Vector, addr_t, op_enum_t
+      using CppAD::local::val_graph::Vector;
+      using CppAD::local::val_graph::addr_t;
+      using CppAD::local::val_graph::op_enum_t;
+      op_enum_t add_op_enum = CppAD::local::val_graph::add_op_enum;
+      op_enum_t div_op_enum = CppAD::local::val_graph::div_op_enum;
+      op_enum_t exp_op_enum = CppAD::local::val_graph::exp_op_enum;
+      op_enum_t log_op_enum = CppAD::local::val_graph::log_op_enum;
+      op_enum_t mul_op_enum = CppAD::local::val_graph::mul_op_enum;
+      op_enum_t neg_op_enum = CppAD::local::val_graph::neg_op_enum;
+      op_enum_t pow_op_enum = CppAD::local::val_graph::pow_op_enum;
+      op_enum_t sub_op_enum = CppAD::local::val_graph::sub_op_enum;
+      //
+      // x0, x1
+      tape.set_ind(2);
+      addr_t x0 = 0;
+      addr_t x1 = 1;
+      //
+      // zero, one, three, four
+      addr_t zero  = tape.record_con_op(0.0);
+      addr_t one   = tape.record_con_op(1.0);
+      addr_t three = tape.record_con_op(3.0);
+      addr_t four  = tape.record_con_op(4.0);
+      //
+      // y0
+      Vector<addr_t> op_arg(2);
+      op_arg[0]   = x0;
+      op_arg[1]   = one;
+      addr_t temp = tape.record_op(mul_op_enum, op_arg);
+      op_arg[0]   = temp;
+      op_arg[1]   = zero;
+      addr_t left = tape.record_op(add_op_enum, op_arg);
+      op_arg[0]   = x1;
+      op_arg[1]   = x1;
+      temp        = tape.record_op(sub_op_enum, op_arg);
+      op_arg[0]   = left;
+      op_arg[1]   = temp;
+      addr_t y0   = tape.record_op(sub_op_enum, op_arg);
+      //
+      // y1
+      op_arg[0]   = x0;
+      op_arg[1]   = three;
+      temp        = tape.record_op(pow_op_enum, op_arg);
+      op_arg[0]   = temp;
+      op_arg[1]   = four;
+      addr_t y1   = tape.record_op(div_op_enum, op_arg);
+      //
+      // y2
+      op_arg.resize(1);
+      op_arg[0]   = x1;
+      temp        = tape.record_op(log_op_enum, op_arg);
+      op_arg[0]   = temp;
+      left        = tape.record_op(exp_op_enum, op_arg);
+      op_arg[0]   = x0;
+      temp        = tape.record_op(neg_op_enum, op_arg);
+      op_arg[0]   = temp;
+      temp        = tape.record_op(neg_op_enum, op_arg);
+      op_arg.resize(2);
+      op_arg[0]   = left;
+      op_arg[1]   = temp;
+      addr_t y2   = tape.record_op(sub_op_enum, op_arg);
+      //
+      // set_dep
+      Vector<addr_t> dep_vec = { y0, y1, y2 };
+      tape.set_dep( dep_vec );
+   }
+   // n_live_op
+   // number of operators that are not constants and are used
+   size_t n_live_op(CppAD::local::val_graph::tape_t<double>& tape)
+   {  using CppAD::local::val_graph::addr_t;
+      tape.dead_code();
+      size_t count = 0;
+      for(addr_t i_op = 0; i_op < tape.n_op(); ++i_op)
+      {  CppAD::local::val_graph::op_enum_t op_enum =
+            tape.base_op_ptr(i_op)->op_enum();
+         if( op_enum != CppAD::local::val_graph::con_op_enum )
+            ++count;
+      }
+      return count;
+   }
+   // check_tape
+   // check that the tape computes the function above
+   bool check_tape(const CppAD::local::val_graph::tape_t<double>& tape)
+   {  bool ok = true;
+      using CppAD::local::val_graph::Vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // val_vec
+      bool   trace = false;
+      double x0    = 2.0;
+      double x1    = 3.0;
+      Vector<double> val_vec( tape.n_val() );
+      val_vec[0] = x0;
+      val_vec[1] = x1;
+      size_t compare_false = 0;
+      tape.eval(trace, val_vec, compare_false);
+      //
+      // ok
+      const Vector<CppAD::local::val_graph::addr_t>& dep_vec = tape.dep_vec();
+      ok &= CppAD::NearEqual(val_vec[ dep_vec[0] ], x0, eps99, eps99);
+      ok &= CppAD::NearEqual(
+         val_vec[ dep_vec[1] ], x0 * x0 * x0 / 4.0, eps99, eps99
+      );
+      ok &= CppAD::NearEqual(val_vec[ dep_vec[2] ], x1 - x0, eps99, eps99);
+      //
+      return ok;
+   }
+}
+bool simplify_xam(void)
+{  bool ok = true;
+   //
+   // tape_t
+   using CppAD::local::val_graph::tape_t;
+   //
+   // ok
+   // The original tape has 11 operators that are not constants.
+   tape_t<double> tape;
+   record_tape(tape);
+   ok &= check_tape(tape);
+   //
+   // ok
+   // The exact rules remove x0 * 1, + 0, and - ( - x0 ).
+   tape.renumber();
+   tape.simplify();
+   ok &= check_tape(tape);
+   ok &= n_live_op(tape) == 7;
+   //
+   // ok
+   // All the rules also remove x1 - x1, the outer subtraction for y0,
+   // exp( log(x1) ), and change pow(x0, 3) / 4 to ( x0 * x0 ) * x0 * 0.25 .
+   tape.set_option("simplify_all", "true");
+   tape.simplify();
+   ok &= check_tape(tape);
+   ok &= n_live_op(tape) == 4;
+   //
+   return ok;
+}
+// END_C++
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2023-23 Bradley M. Bell
+// SPDX-FileContributor: 2023-24 Bradley M. Bell
 # include <cppad/cppad.hpp>
 namespace { // BEIGN_EMPTY_NAMESPACE
 // ----------------------------------------------------------------------------
@@ -58,7 +58,8 @@ bool csum_op(void)
    ok &= y[0] == check;
    //
    // val_optimize, y, ok
-   f.val_optimize("val_graph no_conditional_skip");
+   // (this time use two threads to find equivalent operators)
+   f.val_optimize("val_graph no_conditional_skip num_thread=2");
    f.new_dynamic(p);
    y     = f.Forward(0, x);
    ok &= y[0] == check;
@@ -66,9 +67,58 @@ bool csum_op(void)
    return ok;
 }
 // ----------------------------------------------------------------------------
+// simplify
+bool simplify(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::vector;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // ax
+   size_t n = 2;
+   vector< AD<double> > ax(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1);
+   Independent(ax);
+   //
+   // f
+   vector< AD<double> > ay(2);
+   ay[0] = pow(ax[0], 3.0) / 4.0 + ( ax[1] - ax[1] );
+   ay[1] = exp( log( ax[1] ) ) * ax[0];
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // x, check
+   vector<double> x(n), y(2), check(2);
+   x[0]     = 2.0;
+   x[1]     = 3.0;
+   check[0] = x[0] * x[0] * x[0] / 4.0;
+   check[1] = x[1] * x[0];
+   //
+   // ok
+   // the exact simplifications do not apply to this function
+   size_t size_var = f.size_var();
+   f.val_optimize("val_graph no_conditional_skip simplify");
+   ok &= f.size_var() == size_var;
+   y   = f.Forward(0, x);
+   ok &= CppAD::NearEqual(y[0], check[0], eps99, eps99);
+   ok &= CppAD::NearEqual(y[1], check[1], eps99, eps99);
+   //
+   // ok
+   // pow( x[0], 3 ) / 4 + ( x[1] - x[1] ) -> ( x[0] * x[0] ) * x[0] * 0.25
+   // exp( log( x[1] ) ) * x[0]            -> x[1] * x[0]
+   f.val_optimize("val_graph no_conditional_skip simplify_all");
+   ok &= f.size_var() < size_var;
+   y   = f.Forward(0, x);
+   ok &= CppAD::NearEqual(y[0], check[0], eps99, eps99);
+   ok &= CppAD::NearEqual(y[1], check[1], eps99, eps99);
+   //
+   return ok;
+}
+// ----------------------------------------------------------------------------
 } // END_EMPTY_NAMESPACE
 bool test_val_optimize(void)
 {  bool ok = true;
    ok     &= csum_op();
+   ok     &= simplify();
    return ok;
 }
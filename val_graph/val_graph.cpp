@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 // CPPAD_HAS_* defines
 # include <cppad/configure.hpp>
@@ -28,10 +28,13 @@ extern bool csum_xam(void);
 extern bool cumulative_xam(void);
 extern bool dead_xam(void);
 extern bool dis_xam(void);
+extern bool eval_plan_xam(void);
 extern bool fold_con_xam(void);
 extern bool fun2val_xam(void);
 extern bool pri_xam(void);
+extern bool renumber_thread_xam(void);
 extern bool renumber_xam(void);
+extern bool simplify_xam(void);
 extern bool summation_xam(void);
 extern bool test_ad_double(void);
 extern bool test_fold(void);
@@ -65,10 +68,13 @@ int main(void)
    Run( cumulative_xam,      "cumulative_xam"      );
    Run( dead_xam,            "dead_xam"            );
    Run( dis_xam,             "dis_xam"             );
+   Run( eval_plan_xam,       "eval_plan_xam"       );
    Run( fold_con_xam,        "fold_con_xam"        );
    Run( fun2val_xam,         "fun2val_xam"         );
    Run( pri_xam,             "pri_xam"             );
+   Run( renumber_thread_xam, "renumber_thread_xam" );
    Run( renumber_xam,        "renumber_xam"        );
+   Run( simplify_xam,        "simplify_xam"        );
    Run( summation_xam,       "summation_xam"       );
    Run( test_ad_double,      "test_ad_double"      );
    Run( test_fold,           "test_fold"           );